@@ -5,6 +5,7 @@
 #include <Core/Assets/AssetFileHeader.h>
 #include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Utilities/Progress.h>
 #include <ToolsFoundation/Document/DocumentManager.h>
 
@@ -13,6 +14,25 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezLongOpWorker_BuildNavMesh, 1, ezRTTIDefaultAll
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+namespace
+{
+  // the builder and the geometry of the previous build of each navmesh, a rebuild then only needs to update the tiles with changed geometry
+  struct PreviousNavMeshBuild
+  {
+    ezRecastNavMeshBuilder m_Builder;
+    ezWorldGeoExtractionUtil::Geometry m_Geometry;
+  };
+
+  ezMutex s_PreviousBuildsMutex;
+  ezMap<ezString, ezUniquePtr<PreviousNavMeshBuild>> s_PreviousBuilds;
+} // namespace
+
+void ezLongOpWorker_BuildNavMesh::ClearPreviousBuilds()
+{
+  EZ_LOCK(s_PreviousBuildsMutex);
+  s_PreviousBuilds.Clear();
+}
+
 ezResult ezLongOpWorker_BuildNavMesh::InitializeExecution(ezStreamReader& config, const ezUuid& DocumentGuid)
 {
   ezEngineProcessDocumentContext* pDocContext = ezEngineProcessDocumentContext::GetDocumentContext(DocumentGuid);
@@ -38,13 +58,43 @@ ezResult ezLongOpWorker_BuildNavMesh::Execute(ezProgress& progress, ezStreamWrit
   pgRange.SetStepWeighting(0, 0.95f);
   pgRange.SetStepWeighting(1, 0.05f);
 
-  ezRecastNavMeshBuilder NavMeshBuilder;
   ezRecastNavMeshResourceDescriptor desc;
 
   if (!pgRange.BeginNextStep("Building NavMesh"))
     return EZ_FAILURE;
 
-  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress));
+  // taken out of the map while building, so that several navmeshes can be built at the same time
+  ezUniquePtr<PreviousNavMeshBuild> pBuild;
+  {
+    EZ_LOCK(s_PreviousBuildsMutex);
+
+    auto it = s_PreviousBuilds.Find(m_sOutputPath);
+    if (it.IsValid())
+    {
+      pBuild = std::move(it.Value());
+      s_PreviousBuilds.Remove(it);
+    }
+  }
+
+  if (pBuild == nullptr)
+  {
+    pBuild = EZ_DEFAULT_NEW(PreviousNavMeshBuild);
+    EZ_SUCCEED_OR_RETURN(pBuild->m_Builder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress));
+  }
+  else
+  {
+    ezDynamicArray<ezBoundingBox> changedBounds;
+    ezRecastNavMeshBuilder::ComputeChangedBounds(pBuild->m_Geometry, m_ExtractedWorldGeometry, changedBounds);
+
+    EZ_SUCCEED_OR_RETURN(pBuild->m_Builder.RebuildTiles(m_NavMeshConfig, m_ExtractedWorldGeometry, changedBounds, desc, progress));
+  }
+
+  pBuild->m_Geometry = std::move(m_ExtractedWorldGeometry);
+
+  {
+    EZ_LOCK(s_PreviousBuildsMutex);
+    s_PreviousBuilds[m_sOutputPath] = std::move(pBuild);
+  }
 
   if (!pgRange.BeginNextStep("Writing Result"))
     return EZ_FAILURE;
@@ -13,6 +13,9 @@ public:
   virtual ezResult InitializeExecution(ezStreamReader& config, const ezUuid& DocumentGuid) override;
   virtual ezResult Execute(ezProgress& progress, ezStreamWriter& proxydata) override;
 
+  /// \brief Discards the state that is kept between builds to only rebuild the changed navmesh tiles.
+  static void ClearPreviousBuilds();
+
   ezString m_sOutputPath;
   ezRecastConfig m_NavMeshConfig;
   ezWorldGeoExtractionUtil::Geometry m_ExtractedWorldGeometry;
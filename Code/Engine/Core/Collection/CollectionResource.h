@@ -68,6 +68,7 @@ public:
   /// \brief Puts every resource for which a resource type could be found into the preload queue of the ezResourceManager
   ///
   /// This has to be called manually (or triggered by an ezCollectionComponent).
+  /// Before that, the global event 'ezCollectionResource_BeforePreloadResources' is broadcast with an ezVariantArray of all resource IDs.
   void PreloadResources();
 
   /// \brief Returns true if loading is finished and
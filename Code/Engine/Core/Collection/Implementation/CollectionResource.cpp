@@ -2,6 +2,7 @@
 
 #include <Core/Assets/AssetFileHeader.h>
 #include <Core/Collection/CollectionResource.h>
+#include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Profiling/Profiling.h>
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezCollectionResource, 1, ezRTTIDefaultAllocator<ezCollectionResource>)
@@ -30,6 +31,19 @@ void ezCollectionResource::PreloadResources()
 
   m_hPreloadedResources.Reserve(m_Collection.m_Resources.GetCount());
 
+  // allows to fetch all files at once before they are loaded one by one, e.g. the fileserve client transfers them with a single request
+  {
+    ezVariantArray resourceIDs;
+    resourceIDs.Reserve(m_Collection.m_Resources.GetCount());
+
+    for (const auto& e : m_Collection.m_Resources)
+    {
+      resourceIDs.PushBack(e.m_sResourceID);
+    }
+
+    EZ_BROADCAST_EVENT(ezCollectionResource_BeforePreloadResources, resourceIDs);
+  }
+
   for (const auto& e : m_Collection.m_Resources)
   {
     ezTypelessResourceHandle hTypeless;
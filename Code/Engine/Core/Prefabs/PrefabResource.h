@@ -37,7 +37,12 @@ public:
   /// \brief Creates an instance of this prefab in the given world.
   void InstantiatePrefab(ezWorld& world, const ezTransform& rootTransform, ezGameObjectHandle hParent, ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
 
-  void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezHybridArray<ezGameObject*, 8>& createdChildObjects, const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const;
+  /// \brief Creates one instance of this prefab for every given root transform. See ezWorldReader::InstantiateMany() for details.
+  ///
+  /// The root objects of all instances are appended to out_CreatedRootObjects, instance after instance.
+  void InstantiatePrefabMany(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
+
+  void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, ezArrayPtr<ezGameObject* const> createdChildObjects, ezArrayPtr<ezGameObject* const> createdRootObjects) const;
 
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
@@ -53,7 +53,8 @@ void ezResourceManager::InternalPreloadResource(ezResource* pResource, bool bHig
 
     if (bHighestPriority && ezTaskSystem::GetCurrentThreadWorkerType() == ezWorkerThreadType::FileAccess)
     {
-      ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
+      // the data load task on this thread most likely waits for this resource, so it must not count against the limit
+      LaunchDataLoadTask();
     }
 
     RunWorkerTask(pResource);
@@ -100,97 +101,104 @@ void ezResourceManager::RunWorkerTask(ezResource* pResource)
 
   EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "");
 
-  SetupWorkerTasks();
+  const ezUInt32 uiMaxTasks = GetMaxParallelDataLoadTasks();
 
-  if (s_State->s_bAllowLaunchDataLoadTask && !s_State->s_LoadingQueue.IsEmpty())
+  // only launch as many tasks as there are queued resources that no launched task is going to pick up yet
+  while (s_State->s_uiNumRunningDataLoadTasks < uiMaxTasks && s_State->s_uiNumPendingDataLoadTasks < s_State->s_uiLoadingQueueCount)
   {
-    s_State->s_bAllowLaunchDataLoadTask = false;
-
-    for (ezUInt32 i = 0; i < s_State->s_WorkerTasksDataLoad.GetCount(); ++i)
-    {
-      if (s_State->s_WorkerTasksDataLoad[i].m_pTask->IsTaskFinished())
-      {
-        s_State->s_WorkerTasksDataLoad[i].m_GroupId =
-          ezTaskSystem::StartSingleTask(s_State->s_WorkerTasksDataLoad[i].m_pTask, ezTaskPriority::FileAccess);
-        return;
-      }
-    }
-
-    // could not find any unused task -> need to create a new one
-    {
-      ezStringBuilder s;
-      s.Format("Resource Data Loader {0}", s_State->s_WorkerTasksDataLoad.GetCount());
-      auto& data = s_State->s_WorkerTasksDataLoad.ExpandAndGetRef();
-      data.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerDataLoad);
-      data.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
-      data.m_GroupId = ezTaskSystem::StartSingleTask(data.m_pTask, ezTaskPriority::FileAccess);
-    }
+    LaunchDataLoadTask();
   }
 }
 
-void ezResourceManager::ReverseBubbleSortStep(ezDeque<LoadingInfo>& data)
+void ezResourceManager::LaunchDataLoadTask()
 {
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
+  if (s_State->s_bShutdown || s_State->s_uiLoadingQueueCount == 0)
+    return;
 
-  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+  EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "");
 
-  const ezUInt32 uiCount = data.GetCount();
+  SetupWorkerTasks();
 
-  for (ezUInt32 i = uiCount; i > 1; --i)
-  {
-    const ezUInt32 idx2 = i - 1;
-    const ezUInt32 idx1 = i - 2;
+  ++s_State->s_uiNumRunningDataLoadTasks;
+  ++s_State->s_uiNumPendingDataLoadTasks;
 
-    if (data[idx1].m_fPriority > data[idx1].m_fPriority)
+  for (ezUInt32 i = 0; i < s_State->s_WorkerTasksDataLoad.GetCount(); ++i)
+  {
+    if (s_State->s_WorkerTasksDataLoad[i].m_pTask->IsTaskFinished())
     {
-      ezMath::Swap(data[idx1], data[idx2]);
+      s_State->s_WorkerTasksDataLoad[i].m_GroupId =
+        ezTaskSystem::StartSingleTask(s_State->s_WorkerTasksDataLoad[i].m_pTask, ezTaskPriority::FileAccess);
+      return;
     }
   }
+
+  // could not find any unused task -> need to create a new one
+  {
+    ezStringBuilder s;
+    s.Format("Resource Data Loader {0}", s_State->s_WorkerTasksDataLoad.GetCount());
+    auto& data = s_State->s_WorkerTasksDataLoad.ExpandAndGetRef();
+    data.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerDataLoad);
+    data.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
+    data.m_GroupId = ezTaskSystem::StartSingleTask(data.m_pTask, ezTaskPriority::FileAccess);
+  }
+}
+
+static ezUInt32 GetLoadingQueueBucket(float fPriority)
+{
+  // the priority of a resource type is in steps of 10, see ezResource::GetLoadingPriority()
+  return ezMath::Min(static_cast<ezUInt32>(ezMath::Max(fPriority, 0.0f) / 10.0f), ezResourceManagerState::s_uiNumLoadingQueueBuckets - 1);
 }
 
 void ezResourceManager::UpdateLoadingDeadlines()
 {
-  if (s_State->s_LoadingQueue.IsEmpty())
+  if (s_State->s_uiLoadingQueueCount == 0)
     return;
 
   EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
 
   EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
 
-  const ezUInt32 uiCount = s_State->s_LoadingQueue.GetCount();
-  s_State->s_uiLastResourcePriorityUpdateIdx = ezMath::Min(s_State->s_uiLastResourcePriorityUpdateIdx, uiCount);
+  // re-evaluate the priority of a limited number of queued resources, continuing where the previous update stopped,
+  // and move those resources whose priority changed enough into their new bucket
+  ezUInt32 uiUpdateCount = ezMath::Min(50u, s_State->s_uiLoadingQueueCount);
+  ezUInt32& uiBucket = s_State->s_uiLastResourcePriorityUpdateBucket;
+  ezUInt32& uiIndex = s_State->s_uiLastResourcePriorityUpdateIdx;
 
-  ezUInt32 uiUpdateCount = ezMath::Min(50u, uiCount - s_State->s_uiLastResourcePriorityUpdateIdx);
+  ezHybridArray<LoadingInfo, 16> movedResources;
 
-  if (uiUpdateCount == 0)
-  {
-    s_State->s_uiLastResourcePriorityUpdateIdx = 0;
-    uiUpdateCount = ezMath::Min(50u, uiCount - s_State->s_uiLastResourcePriorityUpdateIdx);
-  }
+  const ezTime tNow = ezTime::Now();
 
-  if (uiUpdateCount > 0)
+  while (uiUpdateCount > 0)
   {
+    auto& queue = s_State->s_LoadingQueue[uiBucket];
+
+    if (uiIndex >= queue.GetCount())
     {
-      EZ_PROFILE_SCOPE("EvalLoadingDeadlines");
+      uiIndex = 0;
+      uiBucket = (uiBucket + 1) % ezResourceManagerState::s_uiNumLoadingQueueBuckets;
+      continue;
+    }
 
-      const ezTime tNow = ezTime::Now();
+    --uiUpdateCount;
 
-      for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_State->s_LoadingQueue[s_State->s_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_State->s_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+    auto& element = queue[uiIndex];
+    element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
 
+    if (GetLoadingQueueBucket(element.m_fPriority) != uiBucket)
     {
-      EZ_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_State->s_LoadingQueue);
+      movedResources.PushBack(element);
+      queue.RemoveAtAndCopy(uiIndex);
+    }
+    else
+    {
+      ++uiIndex;
     }
   }
+
+  for (const auto& element : movedResources)
+  {
+    s_State->s_LoadingQueue[GetLoadingQueueBucket(element.m_fPriority)].PushBack(element);
+  }
 }
 
 void ezResourceManager::PreloadResource(ezResource* pResource)
@@ -224,10 +232,16 @@ ezResult ezResourceManager::RemoveFromLoadingQueue(ezResource* pResource)
   LoadingInfo li;
   li.m_pResource = pResource;
 
-  if (s_State->s_LoadingQueue.RemoveAndSwap(li))
+  for (auto& queue : s_State->s_LoadingQueue)
   {
-    pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
-    return EZ_SUCCESS;
+    if (queue.RemoveAndCopy(li))
+    {
+      --s_State->s_uiLoadingQueueCount;
+      --GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_LoadingStats.m_uiQueueDepth;
+
+      pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      return EZ_SUCCESS;
+    }
   }
 
   return EZ_FAILURE;
@@ -242,18 +256,101 @@ void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPr
 
   LoadingInfo li;
   li.m_pResource = pResource;
+  li.m_QueuedTime = ezTime::Now();
 
   if (bHighestPriority)
   {
     pResource->SetPriority(ezResourcePriority::Critical);
     li.m_fPriority = 0.0f;
-    s_State->s_LoadingQueue.PushFront(li);
+    s_State->s_LoadingQueue[0].PushFront(li);
   }
   else
   {
     li.m_fPriority = pResource->GetLoadingPriority(s_State->s_LastFrameUpdate);
-    s_State->s_LoadingQueue.PushBack(li);
+    s_State->s_LoadingQueue[GetLoadingQueueBucket(li.m_fPriority)].PushBack(li);
+  }
+
+  ++s_State->s_uiLoadingQueueCount;
+  ++GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_LoadingStats.m_uiQueueDepth;
+}
+
+ezResult ezResourceManager::PopFromLoadingQueue(LoadingInfo& out_LoadingInfo)
+{
+  EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "Resource mutex must be locked");
+
+  if (s_State->s_uiLoadingQueueCount == 0)
+    return EZ_FAILURE;
+
+  for (auto& queue : s_State->s_LoadingQueue)
+  {
+    if (!queue.IsEmpty())
+    {
+      out_LoadingInfo = queue.PeekFront();
+      queue.PopFront();
+
+      --s_State->s_uiLoadingQueueCount;
+      --GetResourceTypeInfo(out_LoadingInfo.m_pResource->GetDynamicRTTI()).m_LoadingStats.m_uiQueueDepth;
+      return EZ_SUCCESS;
+    }
+  }
+
+  EZ_REPORT_FAILURE("Loading queue count is out of sync with the queue content");
+  return EZ_FAILURE;
+}
+
+bool ezResourceManager::IsInLoadingQueue(ezResource* pResource)
+{
+  EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "Resource mutex must be locked");
+
+  LoadingInfo li;
+  li.m_pResource = pResource;
+
+  for (const auto& queue : s_State->s_LoadingQueue)
+  {
+    if (queue.IndexOf(li) != ezInvalidIndex)
+      return true;
   }
+
+  return false;
+}
+
+void ezResourceManager::ResourceLoadingFinished(ezResource* pResource, ezTime queuedTime)
+{
+  EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "Resource mutex must be locked");
+
+  const ezTime latency = ezTime::Now() - queuedTime;
+
+  ResourceTypeLoadingStats& stats = GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_LoadingStats;
+  ++stats.m_uiNumLoads;
+  stats.m_TotalLoadLatency += latency;
+  stats.m_MaxLoadLatency = ezMath::Max(stats.m_MaxLoadLatency, latency);
+}
+
+void ezResourceManager::SetMaxParallelDataLoadTasks(ezUInt32 uiMaxTasks)
+{
+  EZ_LOCK(s_ResourceMutex);
+  s_State->s_uiMaxParallelDataLoadTasks = uiMaxTasks;
+
+  RunWorkerTask(nullptr);
+}
+
+ezUInt32 ezResourceManager::GetMaxParallelDataLoadTasks()
+{
+  if (s_State->s_uiMaxParallelDataLoadTasks > 0)
+    return s_State->s_uiMaxParallelDataLoadTasks;
+
+  return ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::FileAccess);
+}
+
+ezResourceManager::ResourceTypeLoadingStats ezResourceManager::GetResourceTypeLoadingStats(const ezRTTI* pResourceType)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  const ResourceTypeInfo* pTypeInfo = nullptr;
+  if (s_State->m_TypeInfo.TryGetValue(pResourceType, pTypeInfo))
+    return pTypeInfo->m_LoadingStats;
+
+  return ResourceTypeLoadingStats();
 }
 
 bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
@@ -285,10 +382,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_State->s_LoadingQueue.IndexOf(li) == ezInvalidIndex)
+    if (!IsInLoadingQueue(pResource))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
@@ -6,6 +6,7 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
 
 /// \todo Do not unload resources while they are acquired
 /// \todo Resource Type Memory Thresholds
@@ -498,6 +499,33 @@ void ezResourceManager::PerFrameUpdate()
     s_State->s_ResourcesToUnloadOnMainThread.Clear();
   }
 
+  {
+    EZ_LOCK(s_ResourceMutex);
+
+    UpdateLoadingDeadlines();
+
+    ezStats::SetStat("Resource Manager/Loading Queue", s_State->s_uiLoadingQueueCount);
+
+    ezStringBuilder sStatName;
+
+    for (auto itTypeInfo : s_State->m_TypeInfo)
+    {
+      const ResourceTypeLoadingStats& stats = itTypeInfo.Value().m_LoadingStats;
+
+      if (stats.m_uiNumLoads == 0 && stats.m_uiQueueDepth == 0)
+        continue;
+
+      sStatName.Format("Resource Manager/{0}/Loading Queue", itTypeInfo.Key()->GetTypeName());
+      ezStats::SetStat(sStatName, stats.m_uiQueueDepth);
+
+      if (stats.m_uiNumLoads > 0)
+      {
+        sStatName.Format("Resource Manager/{0}/Avg Load Latency (ms)", itTypeInfo.Key()->GetTypeName());
+        ezStats::SetStat(sStatName, stats.m_TotalLoadLatency.GetMilliseconds() / stats.m_uiNumLoads);
+      }
+    }
+  }
+
   if (s_State->m_AutoFreeUnusedTimeout.IsPositive())
   {
     FreeUnusedResources(s_State->m_AutoFreeUnusedTimeout, s_State->m_AutoFreeUnusedThreshold);
@@ -541,7 +569,8 @@ void ezResourceManager::OnCoreStartup()
   s_State = EZ_DEFAULT_NEW(ezResourceManagerState);
 
   EZ_LOCK(s_ResourceMutex);
-  s_State->s_bAllowLaunchDataLoadTask = true;
+  s_State->s_uiNumRunningDataLoadTasks = 0;
+  s_State->s_uiNumPendingDataLoadTasks = 0;
   s_State->s_bShutdown = false;
 
   ezPlugin::s_PluginEvents.AddEventHandler(PluginEventHandler);
@@ -558,8 +587,7 @@ void ezResourceManager::EngineAboutToShutdown()
       return;
     }
 
-    s_State->s_bAllowLaunchDataLoadTask = false; // prevent a new one from starting
-    s_State->s_bShutdown = true;
+    s_State->s_bShutdown = true; // prevent a new one from starting
   }
 
   for (ezUInt32 i = 0; i < s_State->s_WorkerTasksDataLoad.GetCount(); ++i)
@@ -575,12 +603,22 @@ void ezResourceManager::EngineAboutToShutdown()
   {
     EZ_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_State->s_LoadingQueue)
+    for (auto& queue : s_State->s_LoadingQueue)
     {
-      entry.m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      for (auto entry : queue)
+      {
+        entry.m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      }
+
+      queue.Clear();
     }
 
-    s_State->s_LoadingQueue.Clear();
+    s_State->s_uiLoadingQueueCount = 0;
+
+    for (auto itTypeInfo : s_State->m_TypeInfo)
+    {
+      itTypeInfo.Value().m_LoadingStats.m_uiQueueDepth = 0;
+    }
 
     // Since we just canceled all loading tasks above and cleared the loading queue,
     // some resources may still be flagged as 'loading', but can never get loaded.
@@ -605,7 +643,7 @@ bool ezResourceManager::IsAnyLoadingInProgress()
 {
   EZ_LOCK(s_ResourceMutex);
 
-  if (s_State->s_LoadingQueue.GetCount() > 0)
+  if (s_State->s_uiLoadingQueueCount > 0)
   {
     return true;
   }
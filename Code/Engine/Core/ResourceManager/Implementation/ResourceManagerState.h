@@ -7,6 +7,9 @@ EZ_CORE_INTERNAL_HEADER
 
 class ezResourceManagerState
 {
+public:
+  static constexpr ezUInt32 s_uiNumLoadingQueueBuckets = 16;
+
 private:
   friend class ezResource;
   friend class ezResourceManager;
@@ -50,18 +53,23 @@ private:
   bool s_bBroadcastExistsEvent = false;
   ezUInt32 s_uiForceNoFallbackAcquisition = 0;
 
-  // resources in this queue are waiting for a task to load them
-  ezDeque<ezResourceManager::LoadingInfo> s_LoadingQueue;
+  // resources in these queues are waiting for a task to load them
+  // each bucket holds resources of similar loading priority in FIFO order, lower buckets get loaded first
+  ezDeque<ezResourceManager::LoadingInfo> s_LoadingQueue[s_uiNumLoadingQueueBuckets];
+  ezUInt32 s_uiLoadingQueueCount = 0;
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> s_LoadedResources;
 
-  bool s_bAllowLaunchDataLoadTask = true;
+  ezUInt32 s_uiNumRunningDataLoadTasks = 0;
+  ezUInt32 s_uiNumPendingDataLoadTasks = 0; // launched, but did not take a resource from the loading queue yet
+  ezUInt32 s_uiMaxParallelDataLoadTasks = 0;
   bool s_bShutdown = false;
 
   ezHybridArray<TaskDataUpdateContent, 24> s_WorkerTasksUpdateContent;
   ezHybridArray<TaskDataDataLoad, 8> s_WorkerTasksDataLoad;
 
   ezTime s_LastFrameUpdate;
+  ezUInt32 s_uiLastResourcePriorityUpdateBucket = 0;
   ezUInt32 s_uiLastResourcePriorityUpdateIdx = 0;
 
   ezDynamicArray<ezResource*> s_LoadedResourceOfTypeTempContainer;
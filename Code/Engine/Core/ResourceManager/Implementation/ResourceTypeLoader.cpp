@@ -8,10 +8,43 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+/// \brief Reads the stream header (the absolute path of the file) from a small buffer and then continues with the file content,
+/// which is read directly from a memory mapped view of the file.
+class ezMappedFileResourceStreamReader : public ezStreamReader
+{
+public:
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+  {
+    const ezUInt64 uiHeaderBytes = m_HeaderReader.ReadBytes(pReadBuffer, uiBytesToRead);
+
+    if (uiHeaderBytes == uiBytesToRead)
+      return uiHeaderBytes;
+
+    void* pContentBuffer = nullptr;
+    if (pReadBuffer != nullptr)
+      pContentBuffer = ezMemoryUtils::AddByteOffset(pReadBuffer, static_cast<ptrdiff_t>(uiHeaderBytes));
+
+    return uiHeaderBytes + m_ContentReader.ReadBytes(pContentBuffer, uiBytesToRead - uiHeaderBytes);
+  }
+
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override
+  {
+    const ezUInt64 uiHeaderBytes = m_HeaderReader.SkipBytes(uiBytesToSkip);
+    return uiHeaderBytes + m_ContentReader.SkipBytes(uiBytesToSkip - uiHeaderBytes);
+  }
+
+  ezRawMemoryStreamReader m_HeaderReader;
+  ezRawMemoryStreamReader m_ContentReader;
+};
+
 struct FileResourceLoadData
 {
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+
+  // only used when the file content is memory mapped, the file must stay open until the resource is done reading from it
+  ezFileReader m_MappedFile;
+  ezMappedFileResourceStreamReader m_MappedReader;
 };
 
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
@@ -20,9 +53,14 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   ezResourceLoadData res;
 
-  ezFileReader File;
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+
+  ezFileReader& File = pData->m_MappedFile;
   if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
 
@@ -35,11 +73,29 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
-
   const ezUInt64 uiFileSize = File.GetFileSize();
+  const ezString128 sAbsolutePath = File.GetFilePathAbsolute();
+
+  if (const void* pMappedContent = (uiFileSize > 0) ? File.GetMappedContent() : nullptr)
+  {
+    // zero-copy path: only the absolute path is written into the blob, the file content is read directly from the mapped memory
+    const ezUInt64 uiHeaderCapacity = sAbsolutePath.GetElementCount() + 8; // +8 for the string overhead
+    pData->m_Storage.SetCountUninitialized(uiHeaderCapacity);
+
+    ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
+
+    ezRawMemoryStreamWriter w(pBlobPtr, uiHeaderCapacity);
+    w << sAbsolutePath;
+
+    pData->m_MappedReader.m_HeaderReader.Reset(pBlobPtr, w.GetNumWrittenBytes());
+    pData->m_MappedReader.m_ContentReader.Reset(pMappedContent, uiFileSize);
+    res.m_pDataStream = &pData->m_MappedReader;
+    res.m_pCustomLoaderData = pData;
+
+    return res;
+  }
 
-  const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
+  const ezUInt64 uiBlobCapacity = uiFileSize + sAbsolutePath.GetElementCount() + 8; // +8 for the string overhead
   pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
 
   ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
@@ -47,11 +103,12 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
   ezRawMemoryStreamWriter w(pBlobPtr, uiBlobCapacity);
 
   // write the absolute path to the read file into the memory stream
-  w << File.GetFilePathAbsolute();
+  w << sAbsolutePath;
 
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
   File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  File.Close();
 
   pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
   res.m_pDataStream = &pData->m_Reader;
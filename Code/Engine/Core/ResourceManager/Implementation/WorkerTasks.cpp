@@ -15,21 +15,22 @@ void ezResourceManagerWorkerDataLoad::Execute()
   ezResource* pResourceToLoad = nullptr;
   ezResourceTypeLoader* pLoader = nullptr;
   ezUniquePtr<ezResourceTypeLoader> pCustomLoader;
+  ezTime queuedTime;
 
   {
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
 
-    if (ezResourceManager::s_State->s_LoadingQueue.IsEmpty())
+    --ezResourceManager::s_State->s_uiNumPendingDataLoadTasks;
+
+    ezResourceManager::LoadingInfo li;
+    if (ezResourceManager::PopFromLoadingQueue(li).Failed())
     {
-      ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
+      --ezResourceManager::s_State->s_uiNumRunningDataLoadTasks;
       return;
     }
 
-    ezResourceManager::UpdateLoadingDeadlines();
-
-    auto it = ezResourceManager::s_State->s_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    ezResourceManager::s_State->s_LoadingQueue.PopFront();
+    pResourceToLoad = li.m_pResource;
+    queuedTime = li.m_QueuedTime;
 
     if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
     {
@@ -94,13 +95,14 @@ void ezResourceManagerWorkerDataLoad::Execute()
     pUpdateContentTask->m_pLoader = pLoader;
     pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
     pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
+    pUpdateContentTask->m_QueuedTime = queuedTime;
 
     // schedule the task to run, either on the main thread or on some other thread
     *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
       pUpdateContentTask, bResourceIsLoadedOnMainThread ? ezTaskPriority::SomeFrameMainThread : ezTaskPriority::LateNextFrame);
 
-    // restart the next loading task (this one is about to finish)
-    ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
+    // start the next loading task (this one is about to finish)
+    --ezResourceManager::s_State->s_uiNumRunningDataLoadTasks;
     ezResourceManager::RunWorkerTask(nullptr);
 
     pCustomLoader.Clear();
@@ -154,6 +156,8 @@ void ezResourceManagerWorkerUpdateContent::Execute()
     EZ_ASSERT_DEV(ezResourceManager::IsQueuedForLoading(m_pResourceToLoad), "Multi-threaded access detected");
     m_pResourceToLoad->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     m_pResourceToLoad->m_LastAcquire = ezResourceManager::GetLastFrameUpdate();
+
+    ezResourceManager::ResourceLoadingFinished(m_pResourceToLoad, m_QueuedTime);
   }
 
   m_pLoader = nullptr;
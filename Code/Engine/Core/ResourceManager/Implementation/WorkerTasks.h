@@ -30,6 +30,7 @@ public:
   ezResourceLoadData m_LoaderData;
   ezResource* m_pResourceToLoad = nullptr;
   ezResourceTypeLoader* m_pLoader = nullptr;
+  ezTime m_QueuedTime; ///< When the resource was put into the loading queue, used for the loading statistics.
   // this is only used to clean up a custom loader at the right time, if one is used
   // m_pLoader is always set, no need to go through m_pCustomLoader
   ezUniquePtr<ezResourceTypeLoader> m_pCustomLoader;
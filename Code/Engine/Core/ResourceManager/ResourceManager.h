@@ -101,6 +101,29 @@ public:
   /// \brief Returns the current loading state of the given resource.
   static ezResourceState GetLoadingState(const ezTypelessResourceHandle& hResource);
 
+  /// \brief Sets how many data load tasks may read resource data at the same time.
+  ///
+  /// Zero (the default) means that there is one data load task per file access thread, see ezTaskSystem::SetWorkerThreadCount().
+  /// More data load tasks than file access threads can never run in parallel.
+  static void SetMaxParallelDataLoadTasks(ezUInt32 uiMaxTasks);
+
+  /// \brief Returns how many data load tasks may read resource data at the same time.
+  static ezUInt32 GetMaxParallelDataLoadTasks();
+
+  /// \brief Loading statistics of a single resource type. See GetResourceTypeLoadingStats().
+  struct ResourceTypeLoadingStats
+  {
+    ezUInt32 m_uiQueueDepth = 0; ///< How many resources of this type are currently waiting in the loading queue.
+    ezUInt32 m_uiNumLoads = 0;   ///< How many resources of this type have been loaded (or updated) so far.
+    ezTime m_TotalLoadLatency;   ///< Sum of all load latencies, i.e. of the times from queuing a resource until its content was updated.
+    ezTime m_MaxLoadLatency;     ///< The longest load latency so far.
+  };
+
+  /// \brief Returns the loading statistics for the given resource type.
+  ///
+  /// The queue depth and the average load latency of every type are also published through ezStats in PerFrameUpdate().
+  static ResourceTypeLoadingStats GetResourceTypeLoadingStats(const ezRTTI* pResourceType);
+
   ///@}
   /// \name Reloading resources
   ///@{
@@ -424,6 +447,7 @@ private:
   {
     float m_fPriority = 0;
     ezResource* m_pResource = nullptr;
+    ezTime m_QueuedTime;
 
     EZ_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
     EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
@@ -436,8 +460,8 @@ private:
   static ResourceType* GetResource(const char* szResourceID, bool bIsReloadable);
   static ezResource* GetResource(const ezRTTI* pRtti, const char* szResourceID, bool bIsReloadable);
   static void RunWorkerTask(ezResource* pResource);
+  static void LaunchDataLoadTask();
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
   static bool ReloadResource(ezResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
@@ -448,6 +472,9 @@ private:
   EZ_ALWAYS_INLINE static bool IsQueuedForLoading(ezResource* pResource) { return pResource->m_Flags.IsSet(ezResourceFlags::IsQueuedForLoading); }
   [[nodiscard]] static ezResult RemoveFromLoadingQueue(ezResource* pResource);
   static void AddToLoadingQueue(ezResource* pResource, bool bHighPriority);
+  [[nodiscard]] static ezResult PopFromLoadingQueue(LoadingInfo& out_LoadingInfo);
+  static bool IsInLoadingQueue(ezResource* pResource);
+  static void ResourceLoadingFinished(ezResource* pResource, ezTime queuedTime);
 
   struct ResourceTypeInfo
   {
@@ -455,6 +482,8 @@ private:
     bool m_bAllowNestedAcquireCached = false;
 
     ezHybridArray<const ezRTTI*, 8> m_NestedTypes;
+
+    ResourceTypeLoadingStats m_LoadingStats;
   };
 
   static ResourceTypeInfo& GetResourceTypeInfo(const ezRTTI* pRtti);
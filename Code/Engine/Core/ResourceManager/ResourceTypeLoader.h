@@ -55,6 +55,8 @@ public:
 ///
 /// The loader will interpret the ezResource 'resource ID' as a path, read that full file into a memory stream.
 /// The file modification data is stored as well.
+/// If the data directory can provide the file content as mapped memory (see ezDataDirectoryReader::GetMappedContent()), e.g. for
+/// ordinary folders and uncompressed archive entries, the stream reads directly from that memory and no copy of the file is made.
 /// Resources that use this loader can update their data as if they were reading the file directly.
 class EZ_CORE_DLL ezResourceLoaderFromFile : public ezResourceTypeLoader
 {
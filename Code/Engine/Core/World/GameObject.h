@@ -525,6 +525,7 @@ private:
     void UpdateGlobalBounds(ezSpatialSystem* pSpatialSytem);
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& spatialSytem);
+    bool UpdateGlobalBoundsAndCheckSpatialData(bool& out_bWasAlwaysVisible);
 
     void UpdateVelocity(const ezSimdFloat& fInvDeltaSeconds);
 
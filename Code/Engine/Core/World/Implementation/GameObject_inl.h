@@ -559,18 +559,29 @@ EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBounds()
   m_globalBounds.m_BoxHalfExtents.SetW(m_localBounds.m_BoxHalfExtents.w());
 }
 
-EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& spatialSytem)
+EZ_FORCE_INLINE bool ezGameObject::TransformationData::UpdateGlobalBoundsAndCheckSpatialData(bool& out_bWasAlwaysVisible)
 {
   ezSimdBBoxSphere oldGlobalBounds = m_globalBounds;
 
   UpdateGlobalBounds();
 
-  ///\todo find a better place for this
   // Can't use ezSimdBBoxSphere::operator != because we want to include the w component of m_BoxHalfExtents
   if ((m_globalBounds.m_CenterAndRadius != oldGlobalBounds.m_CenterAndRadius || m_globalBounds.m_BoxHalfExtents != oldGlobalBounds.m_BoxHalfExtents)
         .AnySet<4>())
   {
-    bool bWasAlwaysVisible = oldGlobalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+    out_bWasAlwaysVisible = oldGlobalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+    return true;
+  }
+
+  return false;
+}
+
+EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& spatialSytem)
+{
+  ///\todo find a better place for this
+  bool bWasAlwaysVisible = false;
+  if (UpdateGlobalBoundsAndCheckSpatialData(bWasAlwaysVisible))
+  {
     bool bIsAlwaysVisible = m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
 
     UpdateSpatialData(spatialSytem, bWasAlwaysVisible, bIsAlwaysVisible);
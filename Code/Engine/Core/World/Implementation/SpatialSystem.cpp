@@ -188,6 +188,18 @@ void ezSpatialSystem::FindObjectsInBox(
 void ezSpatialSystem::FindVisibleObjects(
   const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats /*= nullptr*/) const
 {
+  FindVisibleObjects(ezMakeArrayPtr(&frustum, 1), uiCategoryBitmask, ezMakeArrayPtr(&out_Objects, 1), pStats);
+}
+
+void ezSpatialSystem::FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+  ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats /*= nullptr*/) const
+{
+  EZ_ASSERT_DEV(frustums.GetCount() == out_Objects.GetCount(), "Need exactly one output array per frustum");
+  EZ_ASSERT_DEV(frustums.GetCount() <= MaxNumFrustumsPerQuery, "Can't cull more than {} frustums at once", MaxNumFrustumsPerQuery);
+
+  if (frustums.IsEmpty())
+    return;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   ezStopwatch timer;
 
@@ -199,13 +211,16 @@ void ezSpatialSystem::FindVisibleObjects(
   }
 #endif
 
-  FindVisibleObjectsInternal(frustum, uiCategoryBitmask, out_Objects, pStats);
+  FindVisibleObjectsInternal(frustums, uiCategoryBitmask, out_Objects, pStats);
 
   for (auto pData : m_DataAlwaysVisible)
   {
     if ((pData->m_uiCategoryBitmask & uiCategoryBitmask) != 0)
     {
-      out_Objects.PushBack(pData->m_pObject);
+      for (auto& objects : out_Objects)
+      {
+        objects.PushBack(pData->m_pObject);
+      }
     }
   }
 
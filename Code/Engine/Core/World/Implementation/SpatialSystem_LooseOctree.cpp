@@ -0,0 +1,576 @@
+#include <CorePCH.h>
+
+#include <Core/World/Implementation/SpatialSystemFrustumCulling.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+
+namespace
+{
+  enum
+  {
+    ROOT_NODE_INDEX = 0,
+  };
+
+  EZ_ALWAYS_INLINE ezSimdBBox GetLooseNodeBox(const ezSimdVec4f& vCenterAndHalfExtents)
+  {
+    ezSimdBBox box;
+    box.SetCenterAndHalfExtents(vCenterAndHalfExtents, ezSimdVec4f(vCenterAndHalfExtents.w() * ezSimdFloat(2.0f)));
+    return box;
+  }
+
+  EZ_ALWAYS_INLINE ezSimdBSphere GetLooseNodeSphere(const ezSimdVec4f& vCenterAndHalfExtents)
+  {
+    // radius of the loose box is sqrt(3) * 2 * half extents
+    return ezSimdBSphere(vCenterAndHalfExtents, vCenterAndHalfExtents.w() * ezSimdFloat(3.4641016f));
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::SpatialUserData
+{
+  ezUInt32 m_uiNodeIndex = ezInvalidIndex;
+  ezUInt32 m_uiDataIndex = ezInvalidIndex;
+};
+
+ezSpatialSystem_LooseOctree::Node::Node(ezAllocatorBase* pAlignedAllocator, ezAllocatorBase* pAllocator)
+  : m_BoundingSpheres(pAlignedAllocator)
+  , m_CategoryBitmasks(pAllocator)
+  , m_DataPointers(pAllocator)
+{
+  for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_Children); ++i)
+  {
+    m_Children[i] = ezInvalidIndex;
+  }
+
+  m_uiParentIndex = ezInvalidIndex;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_LooseOctree, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+ezSpatialSystem_LooseOctree::ezSpatialSystem_LooseOctree(float fRootHalfExtents /*= 32768.0f*/, float fMinNodeHalfExtents /*= 32.0f*/)
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_fMinNodeHalfExtents(fMinNodeHalfExtents)
+  , m_Nodes(&m_AlignedAllocator)
+  , m_FreeNodes(&m_Allocator)
+{
+  EZ_CHECK_AT_COMPILETIME(sizeof(ezSpatialSystem_LooseOctree::SpatialUserData) <= sizeof(ezSpatialData::m_uiUserData));
+  EZ_ASSERT_DEV(fMinNodeHalfExtents > 0.0f && fMinNodeHalfExtents <= fRootHalfExtents, "Invalid node extents");
+
+  ezSimdVec4f vRootCenterAndHalfExtents = ezSimdVec4f::ZeroVector();
+  vRootCenterAndHalfExtents.SetW(fRootHalfExtents);
+
+  AllocateNode(ezInvalidIndex, vRootCenterAndHalfExtents);
+}
+
+ezSpatialSystem_LooseOctree::~ezSpatialSystem_LooseOctree() = default;
+
+ezResult ezSpatialSystem_LooseOctree::GetNodeBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_BoundingBox) const
+{
+  ezSpatialData* pData;
+  if (!m_DataTable.TryGetValue(hData.GetInternalID(), pData))
+    return EZ_FAILURE;
+
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  if (pUserData->m_uiNodeIndex != ezInvalidIndex)
+  {
+    out_BoundingBox = ezSimdConversion::ToBBox(GetLooseNodeBox(m_Nodes[pUserData->m_uiNodeIndex].m_vCenterAndHalfExtents));
+    return EZ_SUCCESS;
+  }
+
+  return EZ_FAILURE;
+}
+
+void ezSpatialSystem_LooseOctree::GetAllNodeBoxes(ezHybridArray<ezBoundingBox, 16>& out_BoundingBoxes, ezSpatialData::Category filterCategory) const
+{
+  const ezUInt32 uiCategoryBitmask = filterCategory == ezInvalidSpatialDataCategory ? 0xFFFFFFFF : filterCategory.GetBitmask();
+
+  ForEachNodeInBox(GetLooseNodeBox(m_Nodes[ROOT_NODE_INDEX].m_vCenterAndHalfExtents), uiCategoryBitmask, [&](const Node& node) {
+    if (!node.m_DataPointers.IsEmpty())
+    {
+      out_BoundingBoxes.ExpandAndGetRef() = ezSimdConversion::ToBBox(GetLooseNodeBox(node.m_vCenterAndHalfExtents));
+    }
+
+    return ezVisitorExecution::Continue;
+  });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInSphereInternal(
+  const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const
+{
+  ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+  ezSimdBBox simdBox;
+  simdBox.SetCenterAndHalfExtents(simdSphere.m_CenterAndRadius, simdSphere.m_CenterAndRadius.Get<ezSwizzle::WWWW>());
+
+  ForEachNodeInBox(simdBox, uiCategoryBitmask, [&](const Node& node) {
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (pStats != nullptr)
+    {
+      pStats->m_uiNumObjectsTested += numSpheres;
+    }
+#endif
+
+    for (ezUInt32 i = 0; i < numSpheres; ++i)
+    {
+      if ((node.m_CategoryBitmasks[i] & uiCategoryBitmask) == 0 || !simdSphere.Overlaps(node.m_BoundingSpheres[i]))
+        continue;
+
+      if (callback(node.m_DataPointers[i]->m_pObject) == ezVisitorExecution::Stop)
+        return ezVisitorExecution::Stop;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (pStats != nullptr)
+      {
+        pStats->m_uiNumObjectsPassed++;
+      }
+#endif
+    }
+
+    return ezVisitorExecution::Continue;
+  });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInBoxInternal(
+  const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const
+{
+  ezSimdBBox simdBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+
+  ForEachNodeInBox(simdBox, uiCategoryBitmask, [&](const Node& node) {
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (pStats != nullptr)
+    {
+      pStats->m_uiNumObjectsTested += numSpheres;
+    }
+#endif
+
+    for (ezUInt32 i = 0; i < numSpheres; ++i)
+    {
+      if ((node.m_CategoryBitmasks[i] & uiCategoryBitmask) == 0 || !simdBox.Overlaps(node.m_BoundingSpheres[i]))
+        continue;
+
+      const ezSpatialData* pData = node.m_DataPointers[i];
+      if (!simdBox.Overlaps(pData->m_Bounds.GetBox()))
+        continue;
+
+      if (callback(pData->m_pObject) == ezVisitorExecution::Stop)
+        return ezVisitorExecution::Stop;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (pStats != nullptr)
+      {
+        pStats->m_uiNumObjectsPassed++;
+      }
+#endif
+    }
+
+    return ezVisitorExecution::Continue;
+  });
+}
+
+void ezSpatialSystem_LooseOctree::FindVisibleObjectsInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+  ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats) const
+{
+  const ezUInt32 uiNumFrustums = frustums.GetCount();
+
+  ezHybridArray<ezInternal::SpatialSystemPlaneData, 4, ezAlignedAllocatorWrapper> planeData;
+  planeData.SetCountUninitialized(uiNumFrustums);
+
+  for (ezUInt32 f = 0; f < uiNumFrustums; ++f)
+  {
+    planeData[f].SetFromFrustum(frustums[f]);
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+#endif
+
+  // Every entry tracks the frustums the node is still visible in and the subset of those that contain the node entirely.
+  struct StackEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNodeIndex;
+    ezUInt32 m_uiVisibleFrustumBitmask;
+    ezUInt32 m_uiInsideFrustumBitmask;
+  };
+
+  ezHybridArray<StackEntry, 64> nodeStack;
+  nodeStack.PushBack({ROOT_NODE_INDEX, static_cast<ezUInt32>(EZ_BIT(uiNumFrustums) - 1), 0});
+
+  while (!nodeStack.IsEmpty())
+  {
+    const StackEntry entry = nodeStack.PeekBack();
+    nodeStack.PopBack();
+
+    const Node& node = m_Nodes[entry.m_uiNodeIndex];
+    if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+      continue;
+
+    ezUInt32 uiVisibleMask = entry.m_uiVisibleFrustumBitmask;
+    ezUInt32 uiInsideMask = entry.m_uiInsideFrustumBitmask;
+
+    // The root node also contains all objects outside of it, so it always needs to be visited.
+    if (entry.m_uiNodeIndex != ROOT_NODE_INDEX)
+    {
+      const ezSimdBSphere nodeSphere = GetLooseNodeSphere(node.m_vCenterAndHalfExtents);
+
+      ezUInt32 uiMaskToClassify = uiVisibleMask & ~uiInsideMask;
+      while (uiMaskToClassify > 0)
+      {
+        ezUInt32 f = ezMath::FirstBitLow(uiMaskToClassify);
+        uiMaskToClassify &= uiMaskToClassify - 1;
+
+        ezVolumePosition::Enum pos = ezInternal::SphereFrustumClassify(nodeSphere, planeData[f]);
+        if (pos == ezVolumePosition::Outside)
+        {
+          uiVisibleMask &= ~EZ_BIT(f);
+        }
+        else if (pos == ezVolumePosition::Inside)
+        {
+          uiInsideMask |= EZ_BIT(f);
+        }
+      }
+
+      if (uiVisibleMask == 0)
+        continue;
+    }
+
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+
+    ezUInt32 uiFrustumMask = uiVisibleMask;
+    while (uiFrustumMask > 0)
+    {
+      ezUInt32 f = ezMath::FirstBitLow(uiFrustumMask);
+      uiFrustumMask &= uiFrustumMask - 1;
+
+      auto& objects = out_Objects[f];
+
+      if ((uiInsideMask & EZ_BIT(f)) != 0)
+      {
+        for (ezUInt32 i = 0; i < numSpheres; ++i)
+        {
+          if ((node.m_CategoryBitmasks[i] & uiCategoryBitmask) != 0)
+          {
+            objects.PushBack(node.m_DataPointers[i]->m_pObject);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+            uiNumObjectsPassed++;
+#endif
+          }
+        }
+      }
+      else
+      {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+        uiNumObjectsTested += numSpheres;
+#endif
+
+        ezUInt32 i = 0;
+        for (; i + 1 < numSpheres; i += 2)
+        {
+          ezUInt32 mask = ezInternal::SphereFrustumIntersect(node.m_BoundingSpheres[i + 0], node.m_BoundingSpheres[i + 1], planeData[f]);
+          mask &= ((node.m_CategoryBitmasks[i + 0] & uiCategoryBitmask) != 0 ? 1 : 0) | ((node.m_CategoryBitmasks[i + 1] & uiCategoryBitmask) != 0 ? 2 : 0);
+
+          while (mask > 0)
+          {
+            ezUInt32 j = ezMath::FirstBitLow(mask);
+            mask &= mask - 1;
+
+            objects.PushBack(node.m_DataPointers[i + j]->m_pObject);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+            uiNumObjectsPassed++;
+#endif
+          }
+        }
+
+        if (i < numSpheres && (node.m_CategoryBitmasks[i] & uiCategoryBitmask) != 0 &&
+            ezInternal::SphereFrustumIntersect(node.m_BoundingSpheres[i], planeData[f]))
+        {
+          objects.PushBack(node.m_DataPointers[i]->m_pObject);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+          uiNumObjectsPassed++;
+#endif
+        }
+      }
+    }
+
+    for (ezUInt32 uiChildIndex : node.m_Children)
+    {
+      if (uiChildIndex != ezInvalidIndex)
+      {
+        nodeStack.PushBack({uiChildIndex, uiVisibleMask, uiInsideMask});
+      }
+    }
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (pStats != nullptr)
+  {
+    pStats->m_uiNumObjectsTested = uiNumObjectsTested;
+    pStats->m_uiNumObjectsPassed = uiNumObjectsPassed;
+  }
+#endif
+}
+
+void ezSpatialSystem_LooseOctree::SpatialDataAdded(ezSpatialData* pData)
+{
+  AddData(GetOrCreateNode(pData->m_Bounds), pData);
+}
+
+void ezSpatialSystem_LooseOctree::SpatialDataRemoved(ezSpatialData* pData)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  const ezUInt32 uiNodeIndex = pUserData->m_uiNodeIndex;
+  if (uiNodeIndex != ezInvalidIndex)
+  {
+    RemoveData(uiNodeIndex, pUserData->m_uiDataIndex);
+
+    pUserData->m_uiNodeIndex = ezInvalidIndex;
+    pUserData->m_uiDataIndex = ezInvalidIndex;
+
+    PruneEmptyNodes(uiNodeIndex);
+  }
+}
+
+void ezSpatialSystem_LooseOctree::SpatialDataChanged(ezSpatialData* pData, const ezSimdBBoxSphere& oldBounds, ezUInt32 uiOldCategoryBitmask)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  const ezUInt32 uiOldNodeIndex = pUserData->m_uiNodeIndex;
+
+  if (pData->m_uiCategoryBitmask != uiOldCategoryBitmask || uiOldNodeIndex == ezInvalidIndex)
+  {
+    SpatialDataRemoved(pData);
+
+    if (pData->m_uiCategoryBitmask != 0)
+    {
+      SpatialDataAdded(pData);
+    }
+
+    return;
+  }
+
+  const ezUInt32 uiNewNodeIndex = GetOrCreateNode(pData->m_Bounds);
+  if (uiNewNodeIndex == uiOldNodeIndex)
+  {
+    m_Nodes[uiOldNodeIndex].m_BoundingSpheres[pUserData->m_uiDataIndex] = pData->m_Bounds.GetSphere();
+  }
+  else
+  {
+    // Add to the new node first, otherwise pruning the old node could delete parts of the path to the new node.
+    const ezUInt32 uiOldDataIndex = pUserData->m_uiDataIndex;
+
+    AddData(uiNewNodeIndex, pData);
+    RemoveData(uiOldNodeIndex, uiOldDataIndex);
+    PruneEmptyNodes(uiOldNodeIndex);
+  }
+}
+
+void ezSpatialSystem_LooseOctree::FixSpatialDataPointer(ezSpatialData* pOldPtr, ezSpatialData* pNewPtr)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pNewPtr->m_uiUserData[0]);
+  if (pUserData->m_uiNodeIndex != ezInvalidIndex)
+  {
+    m_Nodes[pUserData->m_uiNodeIndex].m_DataPointers[pUserData->m_uiDataIndex] = pNewPtr;
+  }
+}
+
+ezUInt32 ezSpatialSystem_LooseOctree::AllocateNode(ezUInt32 uiParentIndex, const ezSimdVec4f& vCenterAndHalfExtents)
+{
+  ezUInt32 uiNodeIndex;
+  if (!m_FreeNodes.IsEmpty())
+  {
+    uiNodeIndex = m_FreeNodes.PeekBack();
+    m_FreeNodes.PopBack();
+  }
+  else
+  {
+    uiNodeIndex = m_Nodes.GetCount();
+    m_Nodes.PushBack(Node(&m_AlignedAllocator, &m_Allocator));
+  }
+
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_vCenterAndHalfExtents = vCenterAndHalfExtents;
+  node.m_uiParentIndex = uiParentIndex;
+
+  return uiNodeIndex;
+}
+
+void ezSpatialSystem_LooseOctree::FreeNode(ezUInt32 uiNodeIndex)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+  EZ_ASSERT_DEBUG(node.m_uiNumDataInSubtree == 0, "Implementation error");
+
+  for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(node.m_Children); ++i)
+  {
+    EZ_ASSERT_DEBUG(node.m_Children[i] == ezInvalidIndex, "Implementation error");
+  }
+
+  node.m_uiParentIndex = ezInvalidIndex;
+  node.m_uiCategoryBitmask = 0;
+  node.m_BoundingSpheres.Compact();
+  node.m_CategoryBitmasks.Compact();
+  node.m_DataPointers.Compact();
+
+  m_FreeNodes.PushBack(uiNodeIndex);
+}
+
+void ezSpatialSystem_LooseOctree::PruneEmptyNodes(ezUInt32 uiNodeIndex)
+{
+  // Every node except the root is guaranteed to contain data in its subtree, so empty nodes can't have children.
+  while (uiNodeIndex != ROOT_NODE_INDEX && m_Nodes[uiNodeIndex].m_uiNumDataInSubtree == 0)
+  {
+    const ezUInt32 uiParentIndex = m_Nodes[uiNodeIndex].m_uiParentIndex;
+
+    Node& parent = m_Nodes[uiParentIndex];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(parent.m_Children); ++i)
+    {
+      if (parent.m_Children[i] == uiNodeIndex)
+      {
+        parent.m_Children[i] = ezInvalidIndex;
+        break;
+      }
+    }
+
+    FreeNode(uiNodeIndex);
+    uiNodeIndex = uiParentIndex;
+  }
+
+  if (m_Nodes[ROOT_NODE_INDEX].m_uiNumDataInSubtree == 0)
+  {
+    m_Nodes[ROOT_NODE_INDEX].m_uiCategoryBitmask = 0;
+  }
+}
+
+ezUInt32 ezSpatialSystem_LooseOctree::GetOrCreateNode(const ezSimdBBoxSphere& bounds)
+{
+  const ezSimdVec4f vCenter = bounds.m_CenterAndRadius;
+  const ezSimdFloat fExtents = bounds.m_BoxHalfExtents.HorizontalMax<3>();
+
+  ezUInt32 uiNodeIndex = ROOT_NODE_INDEX;
+
+  {
+    const ezSimdVec4f vRootCenterAndHalfExtents = m_Nodes[ROOT_NODE_INDEX].m_vCenterAndHalfExtents;
+    const ezSimdFloat fRootHalfExtents = vRootCenterAndHalfExtents.w();
+
+    if (!((vCenter - vRootCenterAndHalfExtents).Abs() <= ezSimdVec4f(fRootHalfExtents)).AllSet<3>())
+      return ROOT_NODE_INDEX;
+  }
+
+  while (true)
+  {
+    const ezSimdVec4f vNodeCenterAndHalfExtents = m_Nodes[uiNodeIndex].m_vCenterAndHalfExtents;
+    const ezSimdFloat fChildHalfExtents = vNodeCenterAndHalfExtents.w() * ezSimdFloat(0.5f);
+
+    if (fChildHalfExtents < m_fMinNodeHalfExtents || fExtents > fChildHalfExtents)
+      return uiNodeIndex;
+
+    const ezSimdVec4b positive = vCenter >= vNodeCenterAndHalfExtents;
+    const ezUInt32 uiOctant = (positive.x() ? 1 : 0) | (positive.y() ? 2 : 0) | (positive.z() ? 4 : 0);
+
+    ezUInt32 uiChildIndex = m_Nodes[uiNodeIndex].m_Children[uiOctant];
+    if (uiChildIndex == ezInvalidIndex)
+    {
+      const ezSimdVec4f vOffset = ezSimdVec4f::Select(positive, ezSimdVec4f(fChildHalfExtents), -ezSimdVec4f(fChildHalfExtents));
+
+      ezSimdVec4f vChildCenterAndHalfExtents = vNodeCenterAndHalfExtents + vOffset;
+      vChildCenterAndHalfExtents.SetW(fChildHalfExtents);
+
+      // Careful: this might reallocate m_Nodes
+      uiChildIndex = AllocateNode(uiNodeIndex, vChildCenterAndHalfExtents);
+      m_Nodes[uiNodeIndex].m_Children[uiOctant] = uiChildIndex;
+    }
+
+    uiNodeIndex = uiChildIndex;
+  }
+}
+
+void ezSpatialSystem_LooseOctree::AddData(ezUInt32 uiNodeIndex, ezSpatialData* pData)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  pUserData->m_uiNodeIndex = uiNodeIndex;
+  pUserData->m_uiDataIndex = node.m_DataPointers.GetCount();
+
+  node.m_BoundingSpheres.PushBack(pData->m_Bounds.GetSphere());
+  node.m_CategoryBitmasks.PushBack(pData->m_uiCategoryBitmask);
+  node.m_DataPointers.PushBack(pData);
+
+  while (uiNodeIndex != ezInvalidIndex)
+  {
+    Node& currentNode = m_Nodes[uiNodeIndex];
+    currentNode.m_uiNumDataInSubtree++;
+    currentNode.m_uiCategoryBitmask |= pData->m_uiCategoryBitmask;
+
+    uiNodeIndex = currentNode.m_uiParentIndex;
+  }
+}
+
+void ezSpatialSystem_LooseOctree::RemoveData(ezUInt32 uiNodeIndex, ezUInt32 uiDataIndex)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+
+  if (uiDataIndex != node.m_DataPointers.GetCount() - 1)
+  {
+    ezSpatialData* pLastData = node.m_DataPointers.PeekBack();
+    auto pLastUserData = reinterpret_cast<SpatialUserData*>(&pLastData->m_uiUserData[0]);
+    pLastUserData->m_uiDataIndex = uiDataIndex;
+  }
+
+  node.m_BoundingSpheres.RemoveAtAndSwap(uiDataIndex);
+  node.m_CategoryBitmasks.RemoveAtAndSwap(uiDataIndex);
+  node.m_DataPointers.RemoveAtAndSwap(uiDataIndex);
+
+  while (uiNodeIndex != ezInvalidIndex)
+  {
+    Node& currentNode = m_Nodes[uiNodeIndex];
+    currentNode.m_uiNumDataInSubtree--;
+
+    uiNodeIndex = currentNode.m_uiParentIndex;
+  }
+}
+
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_LooseOctree::ForEachNodeInBox(const ezSimdBBox& box, ezUInt32 uiCategoryBitmask, Functor func) const
+{
+  ezHybridArray<ezUInt32, 64> nodeStack;
+  nodeStack.PushBack(ROOT_NODE_INDEX);
+
+  while (!nodeStack.IsEmpty())
+  {
+    const ezUInt32 uiNodeIndex = nodeStack.PeekBack();
+    nodeStack.PopBack();
+
+    const Node& node = m_Nodes[uiNodeIndex];
+    if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+      continue;
+
+    // The root node also contains all objects outside of it, so it always needs to be visited.
+    if (uiNodeIndex != ROOT_NODE_INDEX && !box.Overlaps(GetLooseNodeBox(node.m_vCenterAndHalfExtents)))
+      continue;
+
+    if (func(node) == ezVisitorExecution::Stop)
+      return;
+
+    for (ezUInt32 uiChildIndex : node.m_Children)
+    {
+      if (uiChildIndex != ezInvalidIndex)
+      {
+        nodeStack.PushBack(uiChildIndex);
+      }
+    }
+  }
+}
+
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_LooseOctree);
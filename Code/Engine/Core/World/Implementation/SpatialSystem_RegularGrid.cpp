@@ -1,8 +1,10 @@
 #include <CorePCH.h>
 
+#include <Core/World/Implementation/SpatialSystemFrustumCulling.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 namespace
 {
@@ -29,6 +31,15 @@ namespace
     return (sx << 42) | (sy << 21) | sz;
   }
 
+  EZ_ALWAYS_INLINE ezSimdVec4i GetCellIndexFromKey(ezUInt64 cellKey)
+  {
+    ezInt32 x = static_cast<ezInt32>((cellKey >> 42) & CELL_INDEX_MASK) - MAX_CELL_INDEX;
+    ezInt32 y = static_cast<ezInt32>((cellKey >> 21) & CELL_INDEX_MASK) - MAX_CELL_INDEX;
+    ezInt32 z = static_cast<ezInt32>(cellKey & CELL_INDEX_MASK) - MAX_CELL_INDEX;
+
+    return ezSimdVec4i(x, y, z);
+  }
+
   EZ_ALWAYS_INLINE ezSimdBBox ComputeCellBoundingBox(const ezSimdVec4i& cellIndex, const ezSimdVec4i& iCellSize)
   {
     ezSimdVec4i overlapSize = iCellSize >> 2;
@@ -39,86 +50,6 @@ namespace
 
     return ezSimdBBox(bmin, bmax);
   }
-
-  struct PlaneData
-  {
-    ezSimdVec4f m_x0x1x2x3;
-    ezSimdVec4f m_y0y1y2y3;
-    ezSimdVec4f m_z0z1z2z3;
-    ezSimdVec4f m_w0w1w2w3;
-
-    ezSimdVec4f m_x4x5x4x5;
-    ezSimdVec4f m_y4y5y4y5;
-    ezSimdVec4f m_z4z5z4z5;
-    ezSimdVec4f m_w4w5w4w5;
-  };
-
-  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
-  {
-    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
-    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
-    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
-    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
-
-    ezSimdVec4f dot_0123;
-    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
-
-    ezSimdVec4f dot_4545;
-    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
-
-    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
-    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
-    return (cmp_0123 || cmp_4545).NoneSet<4>();
-  }
-
-  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const PlaneData& planeData)
-  {
-    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotA_0123;
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotB_0123;
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
-    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
-    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
-    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
-
-    ezSimdVec4f dot_A45B45;
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
-    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
-
-    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
-  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -443,99 +374,136 @@ void ezSpatialSystem_RegularGrid::FindObjectsInBoxInternal(
     });
 }
 
-void ezSpatialSystem_RegularGrid::FindVisibleObjectsInternal(
-  const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats) const
+void ezSpatialSystem_RegularGrid::FindVisibleObjectsInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+  ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats) const
 {
-  ezVec3 cornerPoints[8];
-  frustum.ComputeCornerPoints(cornerPoints);
+  const ezUInt32 uiNumFrustums = frustums.GetCount();
 
-  ezSimdVec4f simdCornerPoints[8];
-  for (ezUInt32 i = 0; i < 8; ++i)
-  {
-    simdCornerPoints[i] = ezSimdConversion::ToVec3(cornerPoints[i]);
-  }
+  ezHybridArray<ezInternal::SpatialSystemPlaneData, 4, ezAlignedAllocatorWrapper> planeData;
+  planeData.SetCountUninitialized(uiNumFrustums);
 
   ezSimdBBox simdBox;
-  simdBox.SetFromPoints(simdCornerPoints, 8);
+  simdBox.SetInvalid();
 
-  PlaneData planeData;
+  for (ezUInt32 f = 0; f < uiNumFrustums; ++f)
   {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    ezSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    planeData.m_x0x1x2x3 = helperMat.m_col0;
-    planeData.m_y0y1y2y3 = helperMat.m_col1;
-    planeData.m_z0z1z2z3 = helperMat.m_col2;
-    planeData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    planeData.m_x4x5x4x5 = helperMat.m_col0;
-    planeData.m_y4y5y4y5 = helperMat.m_col1;
-    planeData.m_z4z5z4z5 = helperMat.m_col2;
-    planeData.m_w4w5w4w5 = helperMat.m_col3;
+    ezVec3 cornerPoints[8];
+    frustums[f].ComputeCornerPoints(cornerPoints);
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      simdBox.ExpandToInclude(ezSimdConversion::ToVec3(cornerPoints[i]));
+    }
+
+    planeData[f].SetFromFrustum(frustums[f]);
   }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  ezUInt32 uiNumObjectsTested = 0;
-  ezUInt32 uiNumObjectsPassed = 0;
-#endif
+  // Gather all cells that are visible in at least one frustum. This is cheap compared to testing the objects,
+  // so it is done serially and the object tests are distributed across tasks afterwards.
+  struct CellToCull
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const Cell* m_pCell;
+    ezUInt32 m_uiCategoryBitmask;
+    ezUInt32 m_uiFrustumBitmask;
+    ezUInt32 m_uiNumObjects;
+  };
+
+  ezHybridArray<CellToCull, 64> cellsToCull;
+  ezUInt32 uiTotalNumObjects = 0;
 
   ForEachCellInBox(
     simdBox, uiCategoryBitmask, [&](const ezSimdVec4i& cellIndex, ezUInt64 cellKey, const Cell& cell, ezUInt32 uiFilteredCategoryBitmask) {
       ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
-      if (!SphereFrustumIntersect(cellSphere, planeData))
+
+      ezUInt32 uiFrustumBitmask = 0;
+      for (ezUInt32 f = 0; f < uiNumFrustums; ++f)
+      {
+        if (ezInternal::SphereFrustumIntersect(cellSphere, planeData[f]))
+        {
+          uiFrustumBitmask |= EZ_BIT(f);
+        }
+      }
+
+      if (uiFrustumBitmask == 0)
         return;
 
+      ezUInt32 uiNumObjects = 0;
       ezUInt32 filteredMask = uiFilteredCategoryBitmask;
       while (filteredMask > 0)
       {
         ezUInt32 category = ezMath::FirstBitLow(filteredMask);
         filteredMask &= filteredMask - 1;
 
+        uiNumObjects += cell.m_BoundingSpheres[category].GetCount();
+      }
+
+      if (uiNumObjects == 0)
+        return;
+
+      auto& cellToCull = cellsToCull.ExpandAndGetRef();
+      cellToCull.m_pCell = &cell;
+      cellToCull.m_uiCategoryBitmask = uiFilteredCategoryBitmask;
+      cellToCull.m_uiFrustumBitmask = uiFrustumBitmask;
+      cellToCull.m_uiNumObjects = uiNumObjects;
+
+      uiTotalNumObjects += uiNumObjects;
+    });
+
+  // Tests all objects of the given cells against all frustums the cell is visible in. The objects are the outer loop
+  // so the bounding spheres are only loaded once per block even if several frustums are culled at the same time.
+  auto CullCells = [&planeData](ezArrayPtr<const CellToCull> cells, ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_CellObjects,
+                     ezUInt32& inout_uiNumObjectsTested, ezUInt32& inout_uiNumObjectsPassed) {
+    for (auto& cellToCull : cells)
+    {
+      const Cell& cell = *cellToCull.m_pCell;
+      const ezUInt32 uiNumCellFrustums = ezMath::CountBits(cellToCull.m_uiFrustumBitmask);
+
+      ezUInt32 filteredMask = cellToCull.m_uiCategoryBitmask;
+      while (filteredMask > 0)
+      {
+        ezUInt32 category = ezMath::FirstBitLow(filteredMask);
+        filteredMask &= filteredMask - 1;
+
         auto& boundingSpheres = cell.m_BoundingSpheres[category];
         auto& dataPointers = cell.m_DataPointers[category];
 
         const ezUInt32 numSpheres = boundingSpheres.GetCount();
+        inout_uiNumObjectsTested += numSpheres * uiNumCellFrustums;
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-        uiNumObjectsTested += numSpheres;
-#endif
         ezUInt32 currentIndex = 0;
 
         while (currentIndex < numSpheres)
         {
           if (numSpheres - currentIndex >= 32)
           {
-            ezUInt32 mask = 0;
-
-            for (ezUInt32 i = 0; i < 32; i += 2)
+            ezUInt32 frustumMask = cellToCull.m_uiFrustumBitmask;
+            while (frustumMask > 0)
             {
-              auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-              auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
+              ezUInt32 f = ezMath::FirstBitLow(frustumMask);
+              frustumMask &= frustumMask - 1;
 
-              mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
-            }
+              ezUInt32 mask = 0;
 
-            while (mask > 0)
-            {
-              ezUInt32 i = ezMath::FirstBitLow(mask);
-              mask &= mask - 1;
+              for (ezUInt32 i = 0; i < 32; i += 2)
+              {
+                auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
+                auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
 
-              ezSpatialData* pData = dataPointers[currentIndex + i];
-              out_Objects.PushBack(pData->m_pObject);
+                mask |= ezInternal::SphereFrustumIntersect(objectSphereA, objectSphereB, planeData[f]) << i;
+              }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-              uiNumObjectsPassed++;
-#endif
+              inout_uiNumObjectsPassed += ezMath::CountBits(mask);
+
+              while (mask > 0)
+              {
+                ezUInt32 i = ezMath::FirstBitLow(mask);
+                mask &= mask - 1;
+
+                ezSpatialData* pData = dataPointers[currentIndex + i];
+                out_CellObjects[f].PushBack(pData->m_pObject);
+              }
             }
 
             currentIndex += 32;
@@ -546,19 +514,97 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjectsInternal(
             ++currentIndex;
 
             auto& objectSphere = boundingSpheres[i];
-            if (!SphereFrustumIntersect(objectSphere, planeData))
-              continue;
 
-            ezSpatialData* pData = dataPointers[i];
-            out_Objects.PushBack(pData->m_pObject);
+            ezUInt32 frustumMask = cellToCull.m_uiFrustumBitmask;
+            while (frustumMask > 0)
+            {
+              ezUInt32 f = ezMath::FirstBitLow(frustumMask);
+              frustumMask &= frustumMask - 1;
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-            uiNumObjectsPassed++;
-#endif
+              if (!ezInternal::SphereFrustumIntersect(objectSphere, planeData[f]))
+                continue;
+
+              ezSpatialData* pData = dataPointers[i];
+              out_CellObjects[f].PushBack(pData->m_pObject);
+
+              inout_uiNumObjectsPassed++;
+            }
           }
         }
       }
-    });
+    }
+  };
+
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+
+  // Only go wide if every task gets a decent amount of work, otherwise the task overhead outweighs the gain.
+  constexpr ezUInt32 uiMinObjectsPerTask = 2048;
+  const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezUInt32 uiNumTasks = ezMath::Min(uiTotalNumObjects / uiMinObjectsPerTask, uiNumWorkers * 2, cellsToCull.GetCount());
+
+  if (uiNumTasks <= 1)
+  {
+    CullCells(cellsToCull, out_Objects, uiNumObjectsTested, uiNumObjectsPassed);
+  }
+  else
+  {
+    // Split the cells into contiguous ranges with roughly the same number of objects. Each task writes into its own
+    // output arrays which are appended in range order afterwards, so the result is the same as with serial culling.
+    struct TaskData
+    {
+      ezUInt32 m_uiFirstCell = 0;
+      ezUInt32 m_uiNumCells = 0;
+      ezUInt32 m_uiNumObjectsTested = 0;
+      ezUInt32 m_uiNumObjectsPassed = 0;
+      ezHybridArray<ezDynamicArray<const ezGameObject*>, 4> m_Objects;
+    };
+
+    ezHybridArray<TaskData, 16> taskData;
+    taskData.SetCount(uiNumTasks);
+
+    {
+      ezUInt32 uiCurrentTask = 0;
+      ezUInt32 uiNumObjectsSoFar = 0;
+
+      for (ezUInt32 i = 0; i < cellsToCull.GetCount(); ++i)
+      {
+        taskData[uiCurrentTask].m_uiNumCells++;
+        uiNumObjectsSoFar += cellsToCull[i].m_uiNumObjects;
+
+        if (uiCurrentTask + 1 < uiNumTasks && uiNumObjectsSoFar >= (ezUInt64(uiTotalNumObjects) * (uiCurrentTask + 1)) / uiNumTasks)
+        {
+          ++uiCurrentTask;
+          taskData[uiCurrentTask].m_uiFirstCell = i + 1;
+        }
+      }
+    }
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumTasks,
+      [&taskData, &cellsToCull, &CullCells, uiNumFrustums](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 t = uiStartIndex; t < uiEndIndex; ++t)
+        {
+          TaskData& data = taskData[t];
+          data.m_Objects.SetCount(uiNumFrustums);
+
+          CullCells(cellsToCull.GetArrayPtr().GetSubArray(data.m_uiFirstCell, data.m_uiNumCells), data.m_Objects, data.m_uiNumObjectsTested,
+            data.m_uiNumObjectsPassed);
+        }
+      },
+      "FindVisibleObjects");
+
+    for (auto& data : taskData)
+    {
+      for (ezUInt32 f = 0; f < uiNumFrustums; ++f)
+      {
+        out_Objects[f].PushBackRange(data.m_Objects[f]);
+      }
+
+      uiNumObjectsTested += data.m_uiNumObjectsTested;
+      uiNumObjectsPassed += data.m_uiNumObjectsPassed;
+    }
+  }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   if (pStats != nullptr)
@@ -692,30 +738,51 @@ EZ_FORCE_INLINE void ezSpatialSystem_RegularGrid::ForEachCellInBox(const ezSimdB
   const ezInt32 iDiffX = diff.x();
   const ezInt32 iDiffY = diff.y();
   const ezInt32 iDiffZ = diff.z();
-  const ezInt32 iNumIterations = iDiffX * iDiffY * iDiffZ;
+  const ezInt64 iNumIterations = ezInt64(iDiffX) * iDiffY * iDiffZ;
+
+  // Large boxes, e.g. from frustums with a far view distance or from several frustums at once, can cover way more cell indices
+  // than there are cells. In that case it is cheaper to iterate over the existing cells instead of looking up every index.
+  if (iNumIterations > m_Cells.GetCount())
+  {
+    for (auto it = m_Cells.GetIterator(); it.IsValid(); ++it)
+    {
+      const Cell& constCell = *it.Value();
+      ezUInt32 uiFilteredCategoryBitmask = constCell.m_uiCategoryBitmask & uiCategoryBitmask;
+      if (uiFilteredCategoryBitmask == 0)
+        continue;
 
-  for (ezInt32 i = 0; i < iNumIterations; ++i)
+      ezSimdVec4i cellIndex = GetCellIndexFromKey(it.Key());
+      if ((cellIndex >= minIndex && cellIndex <= maxIndex).AllSet<3>())
+      {
+        func(cellIndex, it.Key(), constCell, uiFilteredCategoryBitmask);
+      }
+    }
+  }
+  else
   {
-    ezInt32 index = i;
-    ezInt32 z = i / (iDiffX * iDiffY);
-    index -= z * iDiffX * iDiffY;
-    ezInt32 y = index / iDiffX;
-    ezInt32 x = index - (y * iDiffX);
+    for (ezInt32 i = 0; i < iNumIterations; ++i)
+    {
+      ezInt32 index = i;
+      ezInt32 z = i / (iDiffX * iDiffY);
+      index -= z * iDiffX * iDiffY;
+      ezInt32 y = index / iDiffX;
+      ezInt32 x = index - (y * iDiffX);
 
-    x += iMinX;
-    y += iMinY;
-    z += iMinZ;
+      x += iMinX;
+      y += iMinY;
+      z += iMinZ;
 
-    ezUInt64 cellKey = GetCellKey(x, y, z);
+      ezUInt64 cellKey = GetCellKey(x, y, z);
 
-    if (auto ppCell = m_Cells.GetValue(cellKey))
-    {
-      const Cell& constCell = *(*ppCell);
-      ezUInt32 uiFilteredCategoryBitmask = constCell.m_uiCategoryBitmask & uiCategoryBitmask;
-      if (uiFilteredCategoryBitmask != 0)
+      if (auto ppCell = m_Cells.GetValue(cellKey))
       {
-        ezSimdVec4i cellIndex(x, y, z);
-        func(cellIndex, cellKey, constCell, uiFilteredCategoryBitmask);
+        const Cell& constCell = *(*ppCell);
+        ezUInt32 uiFilteredCategoryBitmask = constCell.m_uiCategoryBitmask & uiCategoryBitmask;
+        if (uiFilteredCategoryBitmask != 0)
+        {
+          ezSimdVec4i cellIndex(x, y, z);
+          func(cellIndex, cellKey, constCell, uiFilteredCategoryBitmask);
+        }
       }
     }
   }
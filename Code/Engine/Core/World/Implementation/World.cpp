@@ -5,10 +5,13 @@
 #include <Core/Messages/HierarchyChangedMessages.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Utilities/Stats.h>
 
+ezCVarBool CVarParallelUpdateFunctions("world_ParallelUpdateFunctions", true, ezCVarFlags::Default, "Runs synchronous update functions that declare their data access concurrently");
+
 ezStaticArray<ezWorld*, ezWorld::GetMaxNumWorlds()> ezWorld::s_Worlds;
 
 static ezGameObjectHandle DefaultGameObjectReferenceResolver(const void* pData, ezComponentHandle hThis, const char* szProperty)
@@ -454,7 +457,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Pre-Async Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::NextFrame);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync);
   }
 
   // async phase
@@ -473,7 +476,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Post-Async Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::PostAsync);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync);
   }
 
   // delete dead objects and update the object hierarchy
@@ -500,7 +503,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Post-Transform Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::PostTransform);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform);
   }
 
   // Process again so new component can receive render messages, otherwise we introduce a frame delay.
@@ -867,8 +870,6 @@ void ezWorld::RegisterUpdateFunction(const ezComponentManagerBase::UpdateFunctio
 
   EZ_ASSERT_DEV(desc.m_Phase == ezComponentManagerBase::UpdateFunctionDesc::Phase::Async || desc.m_uiGranularity == 0,
     "Granularity must be 0 for synchronous update functions");
-  EZ_ASSERT_DEV(desc.m_Phase != ezComponentManagerBase::UpdateFunctionDesc::Phase::Async || desc.m_DependsOn.GetCount() == 0,
-    "Asynchronous update functions must not have dependencies");
   EZ_ASSERT_DEV(desc.m_Function.IsComparable(), "Delegates with captures are not allowed as ezWorld update functions.");
 
   m_Data.m_UpdateFunctionsToRegister.PushBack(desc);
@@ -919,31 +920,89 @@ void ezWorld::UpdateFromThread()
   Update();
 }
 
-void ezWorld::UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions)
+void ezWorld::UpdateSynchronous(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase)
 {
+  ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction> updateFunctions = m_Data.m_UpdateFunctions[phase];
+
   ezWorldModule::UpdateContext context;
   context.m_uiFirstComponentIndex = 0;
   context.m_uiComponentCount = ezInvalidIndex;
 
-  for (auto& updateFunction : updateFunctions)
+  const bool bParallel = CVarParallelUpdateFunctions;
+  bool bUsedGraph = false;
+  ezInternal::WorldData::CriticalPath criticalPath;
+
+  for (ezUInt32 i = 0; i < updateFunctions.GetCount();)
   {
-    if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
-      continue;
+    auto& updateFunction = updateFunctions[i];
+
+    // consecutive functions that declare their data access form one dependency graph, all others act as barriers
+    ezUInt32 uiEnd = i + 1;
+    if (bParallel && updateFunction.DeclaresAccess())
+    {
+      while (uiEnd < updateFunctions.GetCount() && updateFunctions[uiEnd].DeclaresAccess())
+      {
+        ++uiEnd;
+      }
+    }
 
+    if (uiEnd - i > 1)
     {
-      EZ_PROFILE_SCOPE(updateFunction.m_sFunctionName);
-      updateFunction.m_Function(context);
+      // remove write marker but keep the read marker, like in the async phase
+      m_Data.m_WriteThreadID = (ezThreadID)0;
+
+      UpdateFunctionGraph(updateFunctions.GetSubArray(i, uiEnd - i), false, criticalPath);
+      bUsedGraph = true;
+
+      // restore write marker
+      m_Data.m_WriteThreadID = ezThreadUtils::GetCurrentThreadID();
     }
+    else if (!updateFunction.m_bOnlyUpdateWhenSimulating || m_Data.m_bSimulateWorld)
+    {
+      const ezTime startTime = bParallel ? ezTime::Now() : ezTime::Zero();
+
+      {
+        EZ_PROFILE_SCOPE(updateFunction.m_sFunctionName);
+        updateFunction.m_Function(context);
+      }
+
+      if (bParallel)
+      {
+        const ezTime duration = ezTime::Now() - startTime;
+        criticalPath.m_Functions.PushBack(&updateFunction);
+        criticalPath.m_Durations.PushBack(duration);
+        criticalPath.m_TotalDuration += duration;
+      }
+    }
+
+    i = uiEnd;
+  }
+
+  if (bUsedGraph)
+  {
+    PublishCriticalPath(phase, criticalPath);
   }
 }
 
 void ezWorld::UpdateAsynchronous()
 {
-  ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
-
   ezDynamicArrayBase<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions =
     m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::Async];
 
+  // asynchronous functions only need individual task groups if there are constraints between them
+  for (auto& updateFunction : updateFunctions)
+  {
+    if (updateFunction.DeclaresAccess() || !updateFunction.m_DependsOn.IsEmpty())
+    {
+      ezInternal::WorldData::CriticalPath criticalPath;
+      UpdateFunctionGraph(updateFunctions, true, criticalPath);
+      PublishCriticalPath(ezComponentManagerBase::UpdateFunctionDesc::Phase::Async, criticalPath);
+      return;
+    }
+  }
+
+  ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
   ezUInt32 uiCurrentTaskIndex = 0;
 
   for (auto& updateFunction : updateFunctions)
@@ -951,38 +1010,174 @@ void ezWorld::UpdateAsynchronous()
     if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
       continue;
 
+    AddUpdateTasks(updateFunction, true, taskGroupId, uiCurrentTaskIndex);
+  }
+
+  ezTaskSystem::StartTaskGroup(taskGroupId);
+  ezTaskSystem::WaitForGroup(taskGroupId);
+}
+
+void ezWorld::AddUpdateTasks(const ezInternal::WorldData::RegisteredUpdateFunction& updateFunction, bool bAsync, ezTaskGroupID taskGroupId, ezUInt32& inout_uiCurrentTaskIndex)
+{
+  ezUInt32 uiTotalCount = 1;
+  ezUInt32 uiGranularity = 1;
+
+  if (bAsync)
+  {
     ezComponentManagerBase* pManager = static_cast<ezComponentManagerBase*>(updateFunction.m_Function.GetClassInstance());
 
-    const ezUInt32 uiTotalCount = pManager->GetComponentCount();
-    ezUInt32 uiStartIndex = 0;
-    ezUInt32 uiGranularity = (updateFunction.m_uiGranularity != 0) ? updateFunction.m_uiGranularity : uiTotalCount;
+    uiTotalCount = pManager->GetComponentCount();
+    uiGranularity = (updateFunction.m_uiGranularity != 0) ? updateFunction.m_uiGranularity : uiTotalCount;
+  }
+
+  ezUInt32 uiStartIndex = 0;
 
-    while (uiStartIndex < uiTotalCount)
+  while (uiStartIndex < uiTotalCount)
+  {
+    ezSharedPtr<ezInternal::WorldData::UpdateTask> pTask;
+    if (inout_uiCurrentTaskIndex < m_Data.m_UpdateTasks.GetCount())
+    {
+      pTask = m_Data.m_UpdateTasks[inout_uiCurrentTaskIndex];
+    }
+    else
     {
-      ezSharedPtr<ezInternal::WorldData::UpdateTask> pTask;
-      if (uiCurrentTaskIndex < m_Data.m_UpdateTasks.GetCount())
+      pTask = EZ_NEW(&m_Data.m_Allocator, ezInternal::WorldData::UpdateTask);
+      m_Data.m_UpdateTasks.PushBack(pTask);
+    }
+
+    pTask->ConfigureTask(updateFunction.m_sFunctionName, ezTaskNesting::Maybe);
+    pTask->m_Function = updateFunction.m_Function;
+    pTask->m_uiStartIndex = bAsync ? uiStartIndex : 0;
+    pTask->m_uiCount = (bAsync && uiStartIndex + uiGranularity < uiTotalCount) ? uiGranularity : ezInvalidIndex;
+    ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
+
+    ++inout_uiCurrentTaskIndex;
+    uiStartIndex += uiGranularity;
+  }
+}
+
+void ezWorld::UpdateFunctionGraph(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions, bool bAsync, ezInternal::WorldData::CriticalPath& inout_criticalPath)
+{
+  EZ_PROFILE_SCOPE("Update Function Graph");
+
+  const ezUInt32 uiNumFunctions = updateFunctions.GetCount();
+
+  ezHybridArray<ezTaskGroupID, 32> taskGroups;
+  ezHybridArray<ezUInt32, 33> firstTaskIndices;
+  ezHybridArray<ezTaskGroupDependency, 64> dependencies;
+  ezHybridArray<ezUInt32, 64> dependencyIndices; // index of the function the dependency points to, parallel to dependencies
+
+  ezUInt32 uiCurrentTaskIndex = 0;
+
+  for (ezUInt32 i = 0; i < uiNumFunctions; ++i)
+  {
+    const auto& updateFunction = updateFunctions[i];
+
+    ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+    taskGroups.PushBack(taskGroupId);
+    firstTaskIndices.PushBack(uiCurrentTaskIndex);
+
+    // skipped functions stay in the graph as empty groups, so the ordering of their dependencies is preserved
+    if (!updateFunction.m_bOnlyUpdateWhenSimulating || m_Data.m_bSimulateWorld)
+    {
+      AddUpdateTasks(updateFunction, bAsync, taskGroupId, uiCurrentTaskIndex);
+    }
+
+    // the registration order is a valid topological order, so dependencies can only point to earlier functions
+    for (ezUInt32 j = 0; j < i; ++j)
+    {
+      if (updateFunction.MustRunAfter(updateFunctions[j]))
       {
-        pTask = m_Data.m_UpdateTasks[uiCurrentTaskIndex];
+        auto& dependency = dependencies.ExpandAndGetRef();
+        dependency.m_TaskGroup = taskGroupId;
+        dependency.m_DependsOn = taskGroups[j];
+        dependencyIndices.PushBack(j);
       }
-      else
+    }
+  }
+
+  firstTaskIndices.PushBack(uiCurrentTaskIndex);
+
+  ezTaskSystem::AddTaskGroupDependencyBatch(dependencies);
+  ezTaskSystem::StartTaskGroupBatch(taskGroups);
+
+  for (const ezTaskGroupID& taskGroupId : taskGroups)
+  {
+    ezTaskSystem::WaitForGroup(taskGroupId);
+  }
+
+  // The critical path ends with the function that finished last.
+  // From there follow the dependencies back, always taking the one that finished last, since that is the one that was waited for.
+  auto GetTimes = [&](ezUInt32 uiFunction, ezTime& out_startTime, ezTime& out_endTime) -> bool {
+    if (firstTaskIndices[uiFunction] == firstTaskIndices[uiFunction + 1])
+      return false;
+
+    out_startTime = m_Data.m_UpdateTasks[firstTaskIndices[uiFunction]]->m_StartTime;
+    out_endTime = m_Data.m_UpdateTasks[firstTaskIndices[uiFunction]]->m_EndTime;
+    for (ezUInt32 t = firstTaskIndices[uiFunction] + 1; t < firstTaskIndices[uiFunction + 1]; ++t)
+    {
+      out_startTime = ezMath::Min(out_startTime, m_Data.m_UpdateTasks[t]->m_StartTime);
+      out_endTime = ezMath::Max(out_endTime, m_Data.m_UpdateTasks[t]->m_EndTime);
+    }
+    return true;
+  };
+
+  ezUInt32 uiCurrent = ezInvalidIndex;
+  ezTime startTime, endTime, lastEndTime;
+  for (ezUInt32 i = 0; i < uiNumFunctions; ++i)
+  {
+    if (GetTimes(i, startTime, endTime) && (uiCurrent == ezInvalidIndex || endTime > lastEndTime))
+    {
+      uiCurrent = i;
+      lastEndTime = endTime;
+    }
+  }
+
+  const ezUInt32 uiPathStart = inout_criticalPath.m_Functions.GetCount();
+  ezTime pathEndTime = lastEndTime;
+  ezTime pathStartTime = lastEndTime;
+
+  while (uiCurrent != ezInvalidIndex)
+  {
+    GetTimes(uiCurrent, startTime, endTime);
+    inout_criticalPath.m_Functions.Insert(&updateFunctions[uiCurrent], uiPathStart);
+    inout_criticalPath.m_Durations.Insert(endTime - startTime, uiPathStart);
+    pathStartTime = startTime;
+
+    const ezUInt32 uiFunction = uiCurrent;
+    uiCurrent = ezInvalidIndex;
+
+    for (ezUInt32 d = 0; d < dependencies.GetCount(); ++d)
+    {
+      if (dependencies[d].m_TaskGroup == taskGroups[uiFunction] && GetTimes(dependencyIndices[d], startTime, endTime) &&
+          (uiCurrent == ezInvalidIndex || endTime > lastEndTime))
       {
-        pTask = EZ_NEW(&m_Data.m_Allocator, ezInternal::WorldData::UpdateTask);
-        m_Data.m_UpdateTasks.PushBack(pTask);
+        uiCurrent = dependencyIndices[d];
+        lastEndTime = endTime;
       }
+    }
+  }
 
-      pTask->ConfigureTask(updateFunction.m_sFunctionName, ezTaskNesting::Maybe);
-      pTask->m_Function = updateFunction.m_Function;
-      pTask->m_uiStartIndex = uiStartIndex;
-      pTask->m_uiCount = (uiStartIndex + uiGranularity < uiTotalCount) ? uiGranularity : ezInvalidIndex;
-      ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
+  inout_criticalPath.m_TotalDuration += pathEndTime - pathStartTime;
+}
 
-      ++uiCurrentTaskIndex;
-      uiStartIndex += uiGranularity;
-    }
+void ezWorld::PublishCriticalPath(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase, const ezInternal::WorldData::CriticalPath& criticalPath)
+{
+  static const char* s_szPhaseNames[] = {"Pre-Async", "Async", "Post-Async", "Post-Transform"};
+  EZ_CHECK_AT_COMPILETIME(EZ_ARRAY_SIZE(s_szPhaseNames) == ezWorldModule::UpdateFunctionDesc::Phase::COUNT);
+
+  ezStringBuilder sStatName;
+  sStatName.Format("World Update/{0}/Critical Path/{1}", m_Data.m_sName, s_szPhaseNames[phase]);
+
+  ezStringBuilder sStatValue;
+  sStatValue.Format("{0} ms:", ezArgF(criticalPath.m_TotalDuration.GetMilliseconds(), 3));
+
+  for (ezUInt32 i = 0; i < criticalPath.m_Functions.GetCount(); ++i)
+  {
+    sStatValue.AppendFormat("{0} {1} ({2} ms)", i > 0 ? " >" : "", criticalPath.m_Functions[i]->m_sFunctionName, ezArgF(criticalPath.m_Durations[i].GetMilliseconds(), 3));
   }
 
-  ezTaskSystem::StartTaskGroup(taskGroupId);
-  ezTaskSystem::WaitForGroup(taskGroupId);
+  ezStats::SetStat(sStatName, sStatValue.GetData());
 }
 
 bool ezWorld::ProcessInitializationBatch(ezInternal::WorldData::InitBatch& batch, ezTime endTime)
@@ -3,6 +3,7 @@
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 
+#include <Foundation/Containers/StaticArray.h>
 #include <Foundation/Time/DefaultTimeStepSmoothing.h>
 
 namespace ezInternal
@@ -31,7 +32,30 @@ namespace ezInternal
     context.m_uiFirstComponentIndex = m_uiStartIndex;
     context.m_uiComponentCount = m_uiCount;
 
+    m_StartTime = ezTime::Now();
     m_Function(context);
+    m_EndTime = ezTime::Now();
+  }
+
+  bool WorldData::RegisteredUpdateFunction::MustRunAfter(const RegisteredUpdateFunction& earlier) const
+  {
+    if (m_DependsOn.Contains(earlier.m_sFunctionName))
+      return true;
+
+    // writes conflict with any access of the other function, reads only with writes
+    for (const ezRTTI* pType : m_WritesTo)
+    {
+      if (earlier.m_WritesTo.Contains(pType) || earlier.m_ReadsFrom.Contains(pType))
+        return true;
+    }
+
+    for (const ezRTTI* pType : m_ReadsFrom)
+    {
+      if (earlier.m_WritesTo.Contains(pType))
+        return true;
+    }
+
+    return false;
   }
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -304,17 +328,70 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
+  template <bool WITH_PARENT>
+  void WorldData::UpdateHierarchyLevelAndCollectSpatialData(Hierarchy::DataBlockArray& blocks, const ezSimdFloat& fInvDeltaSeconds)
+  {
+    ezParallelForParams parallelForParams;
+    parallelForParams.uiBinSize = 100;
+    parallelForParams.uiMaxTasksPerThread = 2;
+    parallelForParams.pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    ezTaskSystem::ParallelFor(
+      blocks.GetArrayPtr(),
+      [this, fInvDeltaSeconds](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice) {
+        // Collect the updates locally and only take the lock when the buffer is full or the slice is done.
+        ezStaticArray<SpatialDataUpdate, 256> localUpdates;
+
+        auto flushLocalUpdates = [&]() {
+          if (localUpdates.IsEmpty())
+            return;
+
+          EZ_LOCK(m_SpatialDataUpdatesMutex);
+          m_SpatialDataUpdates.PushBackRange(localUpdates);
+          localUpdates.Clear();
+        };
+
+        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
+        {
+          ezGameObject::TransformationData* pCurrentData = block.m_pData;
+          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
+
+          while (pCurrentData < pEndData)
+          {
+            bool bWasAlwaysVisible = false;
+            const bool bChanged = WITH_PARENT ? UpdateGlobalTransformWithParentAndCheckSpatialData(pCurrentData, fInvDeltaSeconds, bWasAlwaysVisible)
+                                              : UpdateGlobalTransformAndCheckSpatialData(pCurrentData, fInvDeltaSeconds, bWasAlwaysVisible);
+
+            if (bChanged)
+            {
+              if (localUpdates.GetCount() == localUpdates.GetCapacity())
+              {
+                flushLocalUpdates();
+              }
+
+              auto& update = localUpdates.ExpandAndGetRef();
+              update.m_pData = pCurrentData;
+              update.m_bWasAlwaysVisible = bWasAlwaysVisible;
+            }
+
+            ++pCurrentData;
+          }
+        }
+
+        flushLocalUpdates();
+      },
+      "World DataBlock Traversal Task", parallelForParams);
+  }
+
   void WorldData::UpdateGlobalTransforms(float fInvDeltaSeconds)
   {
     struct UserData
     {
       ezSimdFloat m_fInvDt;
-      ezSpatialSystem* m_pSpatialSystem;
     };
 
     UserData userData;
     userData.m_fInvDt = fInvDeltaSeconds;
-    userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
 
     struct RootLevel
     {
@@ -334,31 +411,12 @@ namespace ezInternal
       }
     };
 
-    struct RootLevelWithSpatialData
-    {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData)
-      {
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, static_cast<UserData*>(pUserData)->m_fInvDt, *static_cast<UserData*>(pUserData)->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
-      }
-    };
-
-    struct WithParentWithSpatialData
-    {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData)
-      {
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, static_cast<UserData*>(pUserData)->m_fInvDt, *static_cast<UserData*>(pUserData)->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
-      }
-    };
-
     Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
     if (!hierarchy.m_Data.IsEmpty())
     {
       auto dataPtr = hierarchy.m_Data.GetData();
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
+      // If we have no spatial system, we can simply perform a multi-threaded update.
       if (m_pSpatialSystem == nullptr)
       {
         TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
@@ -370,11 +428,24 @@ namespace ezInternal
       }
       else
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        // Otherwise transforms and bounds are still updated multi-threaded but the spatial system
+        // can't be modified concurrently. Thus the changed objects are collected and the spatial data is updated afterwards.
+        m_SpatialDataUpdates.Clear();
+
+        UpdateHierarchyLevelAndCollectSpatialData<false>(*dataPtr[0], userData.m_fInvDt);
 
         for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
+          UpdateHierarchyLevelAndCollectSpatialData<true>(*dataPtr[i], userData.m_fInvDt);
+        }
+
+        ezSpatialSystem& spatialSystem = *m_pSpatialSystem;
+        for (const SpatialDataUpdate& update : m_SpatialDataUpdates)
+        {
+          ezGameObject::TransformationData* pData = update.m_pData;
+          bool bIsAlwaysVisible = pData->m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+
+          pData->UpdateSpatialData(spatialSystem, update.m_bWasAlwaysVisible, bIsAlwaysVisible);
         }
       }
     }
@@ -136,11 +136,27 @@ namespace ezInternal
     static void UpdateGlobalTransform(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds);
     static void UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds);
 
-    static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem);
+    static bool UpdateGlobalTransformAndCheckSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, bool& out_bWasAlwaysVisible);
+    static bool UpdateGlobalTransformWithParentAndCheckSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, bool& out_bWasAlwaysVisible);
+
+    template <bool WITH_PARENT>
+    void UpdateHierarchyLevelAndCollectSpatialData(Hierarchy::DataBlockArray& blocks, const ezSimdFloat& fInvDeltaSeconds);
 
     void UpdateGlobalTransforms(float fInvDeltaSeconds);
 
+    // Spatial data updates can't be done concurrently, so the multi-threaded transform update collects them here
+    // and they are applied to the spatial system afterwards.
+    struct SpatialDataUpdate
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezGameObject::TransformationData* m_pData;
+      bool m_bWasAlwaysVisible;
+    };
+
+    ezMutex m_SpatialDataUpdatesMutex;
+    ezDynamicArray<SpatialDataUpdate, ezLocalAllocatorWrapper> m_SpatialDataUpdates;
+
     // game object lookups
     ezHashTable<ezUInt64, ezGameObjectId, ezHashHelper<ezUInt64>, ezLocalAllocatorWrapper> m_GlobalKeyToIdTable;
     ezHashTable<ezUInt64, ezHashedString, ezHashHelper<ezUInt64>, ezLocalAllocatorWrapper> m_IdToGlobalKeyTable;
@@ -178,9 +194,17 @@ namespace ezInternal
       float m_fPriority;
       ezUInt16 m_uiGranularity;
       bool m_bOnlyUpdateWhenSimulating;
+      ezHybridArray<ezHashedString, 4> m_DependsOn;
+      ezHybridArray<const ezRTTI*, 2> m_ReadsFrom;
+      ezHybridArray<const ezRTTI*, 2> m_WritesTo;
 
       void FillFromDesc(const ezWorldModule::UpdateFunctionDesc& desc);
       bool operator<(const RegisteredUpdateFunction& other) const;
+
+      bool DeclaresAccess() const;
+
+      /// \brief Returns true if this function has to run after the given function, which comes earlier in the same phase.
+      bool MustRunAfter(const RegisteredUpdateFunction& earlier) const;
     };
 
     struct UpdateTask final : public ezTask
@@ -190,6 +214,16 @@ namespace ezInternal
       ezWorldModule::UpdateFunction m_Function;
       ezUInt32 m_uiStartIndex;
       ezUInt32 m_uiCount;
+      ezTime m_StartTime;
+      ezTime m_EndTime;
+    };
+
+    /// \brief The chain of update functions that determined the duration of an update phase.
+    struct CriticalPath
+    {
+      ezHybridArray<const RegisteredUpdateFunction*, 16> m_Functions;
+      ezHybridArray<ezTime, 16> m_Durations;
+      ezTime m_TotalDuration;
     };
 
     ezDynamicArray<RegisteredUpdateFunction, ezLocalAllocatorWrapper> m_UpdateFunctions[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
@@ -76,21 +76,21 @@ namespace ezInternal
   }
 
   // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(
-    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem)
+  EZ_FORCE_INLINE bool WorldData::UpdateGlobalTransformAndCheckSpatialData(
+    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, bool& out_bWasAlwaysVisible)
   {
     pData->UpdateGlobalTransform();
     pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+    return pData->UpdateGlobalBoundsAndCheckSpatialData(out_bWasAlwaysVisible);
   }
 
   // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(
-    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem)
+  EZ_FORCE_INLINE bool WorldData::UpdateGlobalTransformWithParentAndCheckSpatialData(
+    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, bool& out_bWasAlwaysVisible)
   {
     pData->UpdateGlobalTransformWithParent();
     pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+    return pData->UpdateGlobalBoundsAndCheckSpatialData(out_bWasAlwaysVisible);
   }
 
   ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -174,6 +174,14 @@ namespace ezInternal
     m_fPriority = desc.m_fPriority;
     m_uiGranularity = desc.m_uiGranularity;
     m_bOnlyUpdateWhenSimulating = desc.m_bOnlyUpdateWhenSimulating;
+    m_DependsOn = desc.m_DependsOn;
+    m_ReadsFrom = desc.m_ReadsFrom;
+    m_WritesTo = desc.m_WritesTo;
+  }
+
+  EZ_ALWAYS_INLINE bool WorldData::RegisteredUpdateFunction::DeclaresAccess() const
+  {
+    return !m_ReadsFrom.IsEmpty() || !m_WritesTo.IsEmpty();
   }
 
   EZ_FORCE_INLINE bool WorldData::RegisteredUpdateFunction::operator<(const RegisteredUpdateFunction& other) const
@@ -61,14 +61,23 @@ public:
   void FindVisibleObjects(
     const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats = nullptr) const;
 
+  /// \brief Culls several frustums in one pass over the spatial data, e.g. all cascades of a directional shadow.
+  ///
+  /// out_Objects must have one array per frustum, the visible objects of frustums[i] are appended to out_Objects[i].
+  /// At most MaxNumFrustumsPerQuery frustums can be culled at once. The stats are accumulated over all frustums.
+  void FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats = nullptr) const;
+
+  static constexpr ezUInt32 MaxNumFrustumsPerQuery = 32;
+
   ///@}
 
 protected:
   virtual void FindObjectsInSphereInternal(
     const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const = 0;
   virtual void FindObjectsInBoxInternal(const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const = 0;
-  virtual void FindVisibleObjectsInternal(
-    const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats) const = 0;
+  virtual void FindVisibleObjectsInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats) const = 0;
 
   virtual void SpatialDataAdded(ezSpatialData* pData) = 0;
   virtual void SpatialDataRemoved(ezSpatialData* pData) = 0;
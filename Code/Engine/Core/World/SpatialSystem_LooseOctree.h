@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+
+/// \brief A spatial system that stores the spatial data in a loose octree.
+///
+/// Every object is stored in exactly one node, the smallest one whose half extents are still at least as large as the object's.
+/// Since the bounds of a node are 'loose', i.e. twice as large as the node itself, an object only has to have its center inside a node to fit.
+/// In contrast to ezSpatialSystem_RegularGrid the node size adapts to the object size, which makes the octree a better fit for levels
+/// that mix tiny objects with very large ones. Objects that are outside of the root node or larger than it are stored in the root node.
+///
+/// To use it, create an instance and pass it to the world via ezWorldDesc::m_pSpatialSystem.
+class EZ_CORE_DLL ezSpatialSystem_LooseOctree : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_LooseOctree, ezSpatialSystem);
+
+public:
+  /// \brief The root node is centered around the origin and has the given half extents.
+  /// Nodes are not subdivided any further once their half extents would drop below fMinNodeHalfExtents.
+  ezSpatialSystem_LooseOctree(float fRootHalfExtents = 32768.0f, float fMinNodeHalfExtents = 32.0f);
+  ~ezSpatialSystem_LooseOctree();
+
+  /// \brief Returns the loose bounding box of the node associated with the given spatial data. Useful for debug visualizations.
+  ezResult GetNodeBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_BoundingBox) const;
+
+  /// \brief Returns the loose bounding boxes of all nodes that contain data. Useful for debug visualizations.
+  void GetAllNodeBoxes(
+    ezHybridArray<ezBoundingBox, 16>& out_BoundingBoxes, ezSpatialData::Category filterCategory = ezInvalidSpatialDataCategory) const;
+
+private:
+  // ezSpatialSystem implementation
+  virtual void FindObjectsInSphereInternal(
+    const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats = nullptr) const override;
+  virtual void FindObjectsInBoxInternal(
+    const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats = nullptr) const override;
+
+  virtual void FindVisibleObjectsInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats = nullptr) const override;
+
+  virtual void SpatialDataAdded(ezSpatialData* pData) override;
+  virtual void SpatialDataRemoved(ezSpatialData* pData) override;
+  virtual void SpatialDataChanged(ezSpatialData* pData, const ezSimdBBoxSphere& oldBounds, ezUInt32 uiOldCategoryBitmask) override;
+  virtual void FixSpatialDataPointer(ezSpatialData* pOldPtr, ezSpatialData* pNewPtr) override;
+
+  struct SpatialUserData;
+
+  struct Node
+  {
+    Node(ezAllocatorBase* pAlignedAllocator, ezAllocatorBase* pAllocator);
+
+    ezSimdVec4f m_vCenterAndHalfExtents;
+    ezUInt32 m_Children[8];
+    ezUInt32 m_uiParentIndex;
+
+    ezUInt32 m_uiNumDataInSubtree = 0;
+    ezUInt32 m_uiCategoryBitmask = 0; ///< Conservative, only reset when the subtree becomes empty.
+
+    ezDynamicArray<ezSimdBSphere> m_BoundingSpheres;
+    ezDynamicArray<ezUInt32> m_CategoryBitmasks;
+    ezDynamicArray<ezSpatialData*> m_DataPointers;
+  };
+
+  ezUInt32 AllocateNode(ezUInt32 uiParentIndex, const ezSimdVec4f& vCenterAndHalfExtents);
+  void FreeNode(ezUInt32 uiNodeIndex);
+  void PruneEmptyNodes(ezUInt32 uiNodeIndex);
+
+  ezUInt32 GetOrCreateNode(const ezSimdBBoxSphere& bounds);
+  void AddData(ezUInt32 uiNodeIndex, ezSpatialData* pData);
+  void RemoveData(ezUInt32 uiNodeIndex, ezUInt32 uiDataIndex);
+
+  template <typename Functor>
+  void ForEachNodeInBox(const ezSimdBBox& box, ezUInt32 uiCategoryBitmask, Functor func) const;
+
+  ezProxyAllocator m_AlignedAllocator;
+  ezSimdFloat m_fMinNodeHalfExtents;
+
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<ezUInt32> m_FreeNodes;
+};
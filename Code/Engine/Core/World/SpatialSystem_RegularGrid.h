@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/SwissHashTable.h>
 #include <Foundation/SimdMath/SimdVec4i.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -26,8 +27,8 @@ private:
   virtual void FindObjectsInBoxInternal(
     const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats = nullptr) const override;
 
-  virtual void FindVisibleObjectsInternal(const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects,
-    QueryStats* pStats = nullptr) const override;
+  virtual void FindVisibleObjectsInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats = nullptr) const override;
 
   virtual void SpatialDataAdded(ezSpatialData* pData) override;
   virtual void SpatialDataRemoved(ezSpatialData* pData) override;
@@ -43,7 +44,7 @@ private:
   struct Cell;
   struct CellKeyHashHelper;
 
-  ezHashTable<ezUInt64, ezUniquePtr<Cell>, CellKeyHashHelper, ezLocalAllocatorWrapper> m_Cells;
+  ezSwissHashTable<ezUInt64, ezUniquePtr<Cell>, CellKeyHashHelper, ezLocalAllocatorWrapper> m_Cells;
   ezUniquePtr<Cell> m_pOverflowCell;
 
   template <typename Functor>
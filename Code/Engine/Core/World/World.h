@@ -18,6 +18,14 @@ class ezEventMessageHandlerComponent;
 /// * Actual deletion of dead objects and components are done now.
 /// * Transform update: The global transformation of dynamic objects is updated.
 /// * Post-transform phase: Another synchronous phase like the pre-async phase after the transformation has been updated.
+///
+/// Update functions can declare which component and world module types they read and write (see ezWorldModule::UpdateFunctionDesc).
+/// Consecutive synchronous functions that declare their access are then run concurrently on the task system, as long as their
+/// accesses and dependencies don't conflict. Functions without declarations act as barriers and run on the updating thread as before.
+/// While declaring functions run concurrently, the world is only marked for reading, like in the async phase.
+/// In the async phase, declared accesses and dependencies are turned into ordering constraints between the functions.
+/// The cvar 'world_ParallelUpdateFunctions' switches the synchronous phases back to strictly sequential execution.
+/// The critical path of each phase is published as a stat under 'World Update/<world name>/Critical Path'.
 class EZ_CORE_DLL ezWorld final
 {
 public:
@@ -367,8 +375,12 @@ private:
   void AddComponentToInitialize(ezComponentHandle hComponent);
 
   void UpdateFromThread();
-  void UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions);
+  void UpdateSynchronous(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase);
   void UpdateAsynchronous();
+  void AddUpdateTasks(const ezInternal::WorldData::RegisteredUpdateFunction& updateFunction, bool bAsync, ezTaskGroupID taskGroupId, ezUInt32& inout_uiCurrentTaskIndex);
+  void UpdateFunctionGraph(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions, bool bAsync,
+    ezInternal::WorldData::CriticalPath& inout_criticalPath);
+  void PublishCriticalPath(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase, const ezInternal::WorldData::CriticalPath& criticalPath);
 
   // returns if the batch was completely initialized
   bool ProcessInitializationBatch(ezInternal::WorldData::InitBatch& batch, ezTime endTime);
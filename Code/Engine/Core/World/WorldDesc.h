@@ -19,7 +19,7 @@ struct ezWorldDesc
   ezHashedString m_sName;
   ezUInt64 m_uiRandomNumberGeneratorSeed = 0;
 
-  ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;
+  ezUniquePtr<ezSpatialSystem> m_pSpatialSystem; ///< the spatial system to use, e.g. ezSpatialSystem_RegularGrid or ezSpatialSystem_LooseOctree
   bool m_bAutoCreateSpatialSystem = true; ///< automatically create a default spatial system if none is set
 
   ezSharedPtr<ezCoordinateSystemProvider> m_pCoordinateSystemProvider;
@@ -67,13 +67,16 @@ protected:
     ezHashedString m_sFunctionName; ///< Name of the function. Use the EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC macro to create a description
                                     ///< with the correct name.
     ezHybridArray<ezHashedString, 4> m_DependsOn; ///< Array of other functions on which this function depends on. This function will be
-                                                  ///< called after all its dependencies have been called.
+                                                  ///< called after all its dependencies of the same phase have been called.
     ezEnum<Phase> m_Phase; ///< The update phase in which this update function should be called. See ezWorld for a description on the
                            ///< different phases.
     bool m_bOnlyUpdateWhenSimulating = false; ///< The update function is only called when the world simulation is enabled.
     ezUInt16 m_uiGranularity = 0;             ///< The granularity in which batch updates should happen during the asynchronous phase. Has to be 0 for
                                               ///< synchronous functions.
     float m_fPriority = 0.0f; ///< Higher priority (higher number) means that this function is called earlier than a function with lower priority.
+    ezHybridArray<const ezRTTI*, 2> m_ReadsFrom; ///< Component or world module types whose data this function reads. Declaring any access allows
+                                                 ///< the world to run this function concurrently to others it doesn't conflict with. See ezWorld.
+    ezHybridArray<const ezRTTI*, 2> m_WritesTo;  ///< Component or world module types whose data this function modifies.
   };
 
   /// \brief Registers the given update function at the world.
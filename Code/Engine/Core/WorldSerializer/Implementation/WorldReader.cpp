@@ -74,7 +74,7 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& stream)
   ReadComponentDataToMemStream();
   m_pStringDedupReadContext->SetActive(false);
 
-  return EZ_SUCCESS;
+  return DecodeComponentCreationData();
 }
 
 ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateWorld(ezWorld& world, const ezUInt16* pOverrideTeamID, ezTime maxStepTime, ezProgress* pProgress)
@@ -88,12 +88,159 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(world, true, rootTransform, hParent, out_CreatedRootObjects, out_CreatedChildObjects, pOverrideTeamID, bForceDynamic, maxStepTime, pProgress);
 }
 
+void ezWorldReader::InstantiateMany(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects,
+  ezDynamicArray<ezGameObject*>* out_CreatedChildObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiateMany");
+
+  const ezUInt32 uiNumInstances = rootTransforms.GetCount();
+  if (uiNumInstances == 0)
+    return;
+
+  m_pWorld = &world;
+
+  EZ_LOCK(world.GetWriteMarker());
+
+  const ezUInt32 uiNumRootObjects = m_RootObjectsToCreate.GetCount();
+  const ezUInt32 uiNumChildObjects = m_ChildObjectsToCreate.GetCount();
+  const ezUInt32 uiNumHandlesPerInstance = uiNumRootObjects + uiNumChildObjects + 1;
+
+  m_IndexToGameObjectHandle.Clear();
+  m_IndexToGameObjectHandle.Reserve(uiNumHandlesPerInstance * uiNumInstances);
+
+  if (out_CreatedRootObjects)
+  {
+    out_CreatedRootObjects->Reserve(out_CreatedRootObjects->GetCount() + uiNumRootObjects * uiNumInstances);
+  }
+
+  if (out_CreatedChildObjects)
+  {
+    out_CreatedChildObjects->Reserve(out_CreatedChildObjects->GetCount() + uiNumChildObjects * uiNumInstances);
+  }
+
+  // Game objects are created instance by instance, since child objects look up their parent in the handle table section of their own instance
+  for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+  {
+    const ezUInt32 uiHandleOffset = m_IndexToGameObjectHandle.GetCount();
+    m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
+
+    for (ezUInt32 i = 0; i < uiNumRootObjects + uiNumChildObjects; ++i)
+    {
+      const bool bIsRootObject = i < uiNumRootObjects;
+      const GameObjectToCreate& godesc = bIsRootObject ? m_RootObjectsToCreate[i] : m_ChildObjectsToCreate[i - uiNumRootObjects];
+
+      ezGameObjectDesc desc = godesc.m_Desc; // make a copy
+      desc.m_hParent = (bIsRootObject && !hParent.IsInvalidated()) ? hParent : m_IndexToGameObjectHandle[uiHandleOffset + godesc.m_uiParentHandleIdx];
+      desc.m_bDynamic |= bForceDynamic;
+
+      if (pOverrideTeamID != nullptr)
+      {
+        desc.m_uiTeamID = *pOverrideTeamID;
+      }
+
+      if (bIsRootObject)
+      {
+        ezTransform tChild(desc.m_LocalPosition, desc.m_LocalRotation, desc.m_LocalScaling);
+        ezTransform tFinal;
+        tFinal.SetGlobalTransform(rootTransforms[uiInstance], tChild);
+
+        desc.m_LocalPosition = tFinal.m_vPosition;
+        desc.m_LocalRotation = tFinal.m_qRotation;
+        desc.m_LocalScaling = tFinal.m_vScale;
+      }
+
+      ezGameObject* pObject = nullptr;
+      m_IndexToGameObjectHandle.PushBack(world.CreateObject(desc, pObject));
+
+      if (!godesc.m_sGlobalKey.IsEmpty())
+      {
+        pObject->SetGlobalKey(godesc.m_sGlobalKey);
+      }
+
+      ezDynamicArray<ezGameObject*>* pCreatedObjects = bIsRootObject ? out_CreatedRootObjects : out_CreatedChildObjects;
+      if (pCreatedObjects)
+      {
+        pCreatedObjects->PushBack(pObject);
+      }
+    }
+  }
+
+  // Components are created type by type for all instances, so every manager is only looked up once
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_ComponentIndexToHandle.Clear();
+
+    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+      continue;
+
+    ezComponentManagerBase* pManager = world.GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+    EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
+
+    compTypeInfo.m_ComponentIndexToHandle.Reserve((compTypeInfo.m_uiNumComponents + 1) * uiNumInstances);
+
+    for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+    {
+      compTypeInfo.m_ComponentIndexToHandle.PushBack(ezComponentHandle());
+
+      for (const ComponentToCreate& compToCreate : compTypeInfo.m_ComponentsToCreate)
+      {
+        compTypeInfo.m_ComponentIndexToHandle.PushBack(CreateComponent(pManager, compToCreate, uiInstance * uiNumHandlesPerInstance));
+      }
+    }
+  }
+
+  // The serialized data of each type is replayed from the same position in the data stream for every instance
+  {
+    ezMemoryStreamReader reader(&m_ComponentDataStream);
+
+    ezStreamReader* pPrevStream = m_pStream;
+    m_pStream = &reader;
+    m_pStringDedupReadContext->SetActive(true);
+
+    EZ_SCOPE_EXIT(m_pStream = pPrevStream; m_pStringDedupReadContext->SetActive(false); m_uiGameObjectHandleOffset = 0; m_uiInstanceIndex = 0;);
+
+    for (auto& compTypeInfo : m_ComponentTypes)
+    {
+      if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+        continue;
+
+      for (m_uiInstanceIndex = 0; m_uiInstanceIndex < uiNumInstances; ++m_uiInstanceIndex)
+      {
+        m_uiGameObjectHandleOffset = m_uiInstanceIndex * uiNumHandlesPerInstance;
+        reader.SetReadPosition(compTypeInfo.m_uiDataStreamOffset);
+
+        const ezUInt32 uiComponentHandleOffset = m_uiInstanceIndex * (compTypeInfo.m_uiNumComponents + 1);
+        for (ezUInt32 i = 1; i <= compTypeInfo.m_uiNumComponents; ++i)
+        {
+          ezComponent* pComponent = nullptr;
+          if (world.TryGetComponent(compTypeInfo.m_ComponentIndexToHandle[uiComponentHandleOffset + i], pComponent))
+          {
+            pComponent->DeserializeComponent(*this);
+          }
+        }
+      }
+    }
+  }
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    for (const ezComponentHandle& hComponent : compTypeInfo.m_ComponentIndexToHandle)
+    {
+      ezComponent* pComponent = nullptr;
+      if (world.TryGetComponent(hComponent, pComponent))
+      {
+        pComponent->GetOwningManager()->InitializeComponent(pComponent);
+      }
+    }
+  }
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
   *m_pStream >> idx;
 
-  return m_IndexToGameObjectHandle[idx];
+  return m_IndexToGameObjectHandle[m_uiGameObjectHandleOffset + idx];
 }
 
 void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
@@ -108,10 +255,11 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
 
   if (uiTypeIndex < m_ComponentTypes.GetCount())
   {
-    auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
-    if (uiIndex < indexToHandle.GetCount())
+    const auto& compTypeInfo = m_ComponentTypes[uiTypeIndex];
+    const ezUInt32 uiHandleIdx = m_uiInstanceIndex * (compTypeInfo.m_uiNumComponents + 1) + uiIndex;
+    if (uiIndex <= compTypeInfo.m_uiNumComponents && uiHandleIdx < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
-      out_hComponent = indexToHandle[uiIndex];
+      out_hComponent = compTypeInfo.m_ComponentIndexToHandle[uiHandleIdx];
     }
   }
 }
@@ -238,6 +386,11 @@ void ezWorldReader::ReadComponentDataToMemStream()
       }
       else
       {
+        if (!bReadNumComponents)
+        {
+          compTypeInfo.m_uiDataStreamOffset = m_ComponentDataStream.GetStorageSize();
+        }
+
         if (bReadNumComponents)
         {
           *m_pStream >> compTypeInfo.m_uiNumComponents;
@@ -269,6 +422,65 @@ void ezWorldReader::ReadComponentDataToMemStream()
   }
 }
 
+ezResult ezWorldReader::DecodeComponentCreationData()
+{
+  const ezUInt32 uiNumObjects = m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount();
+
+  ezMemoryStreamReader reader(&m_ComponentCreationStream);
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    // components of unknown types are not part of the creation stream
+    if (compTypeInfo.m_pRtti == nullptr)
+      continue;
+
+    compTypeInfo.m_ComponentsToCreate.SetCountUninitialized(compTypeInfo.m_uiNumComponents);
+
+    for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+    {
+      ComponentToCreate& compToCreate = compTypeInfo.m_ComponentsToCreate[i];
+
+      ezUInt32 uiComponentIdx = 0;
+      reader >> compToCreate.m_uiOwnerHandleIdx;
+      reader >> uiComponentIdx;
+      reader >> compToCreate.m_bActive;
+      reader >> compToCreate.m_uiUserFlags;
+
+      if (uiComponentIdx != i + 1 || compToCreate.m_uiOwnerHandleIdx == 0 || compToCreate.m_uiOwnerHandleIdx > uiNumObjects)
+      {
+        ezLog::Error("Invalid creation data for components of type '{0}'.", compTypeInfo.m_pRtti->GetTypeName());
+        return EZ_FAILURE;
+      }
+    }
+  }
+
+  // everything that is needed from the creation stream is decoded now
+  m_ComponentCreationStream.Clear();
+  m_ComponentCreationStream.Compact();
+
+  return EZ_SUCCESS;
+}
+
+ezComponentHandle ezWorldReader::CreateComponent(ezComponentManagerBase* pManager, const ComponentToCreate& compToCreate, ezUInt32 uiGameObjectHandleOffset)
+{
+  ezGameObject* pOwnerObject = nullptr;
+  m_pWorld->TryGetObject(m_IndexToGameObjectHandle[uiGameObjectHandleOffset + compToCreate.m_uiOwnerHandleIdx], pOwnerObject);
+
+  EZ_ASSERT_DEBUG(pOwnerObject != nullptr, "Owner object must be not null");
+
+  ezComponent* pComponent = nullptr;
+  auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
+
+  pComponent->SetActiveFlag(compToCreate.m_bActive);
+
+  for (ezUInt8 j = 0; j < 8; ++j)
+  {
+    pComponent->SetUserFlag(j, (compToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
+  }
+
+  return hComponent;
+}
+
 void ezWorldReader::ClearHandles()
 {
   m_IndexToGameObjectHandle.Clear();
@@ -375,25 +587,14 @@ bool ezWorldReader::InstantiationContext::Step()
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_pCreatedChildObjects, endTime))
       return false;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize() > 0)
-    {
-      m_WorldReader.m_pStringDedupReadContext->SetActive(true);
-
-      ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
-      m_WorldReader.m_pStream = &m_CurrentReader;
-
-      EZ_SCOPE_EXIT(m_WorldReader.m_pStream = pPrevReader; m_WorldReader.m_pStringDedupReadContext->SetActive(false););
-
-      if (!CreateComponents(endTime))
-        return false;
-    }
+    if (!CreateComponents(endTime))
+      return false;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
     m_Phase = Phase::DeserializeComponents;
@@ -522,8 +723,6 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
 
-  ezStreamReader& s = *m_WorldReader.m_pStream;
-
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
@@ -537,34 +736,7 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
-      const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
-
-      ezUInt32 uiComponentIdx = 0;
-      s >> uiComponentIdx;
-
-      bool bActive = true;
-      s >> bActive;
-
-      ezUInt8 userFlags = 0;
-      s >> userFlags;
-
-      ezGameObject* pOwnerObject = nullptr;
-      m_WorldReader.m_pWorld->TryGetObject(hOwner, pOwnerObject);
-
-      EZ_ASSERT_DEBUG(pOwnerObject != nullptr, "Owner object must be not null");
-
-      ezComponent* pComponent = nullptr;
-      auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
-
-      pComponent->SetActiveFlag(bActive);
-
-      for (ezUInt8 j = 0; j < 8; ++j)
-      {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
-      }
-
-      EZ_ASSERT_DEBUG(uiComponentIdx == compTypeInfo.m_ComponentIndexToHandle.GetCount(), "Component index doesn't match");
-      compTypeInfo.m_ComponentIndexToHandle.PushBack(hComponent);
+      compTypeInfo.m_ComponentIndexToHandle.PushBack(m_WorldReader.CreateComponent(pManager, compTypeInfo.m_ComponentsToCreate[m_uiCurrentIndex], 0));
 
       ++m_uiCurrentIndex;
       ++m_uiCurrentNumComponentsProcessed;
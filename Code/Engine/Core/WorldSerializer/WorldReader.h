@@ -80,6 +80,20 @@ public:
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
     const ezUInt16* pOverrideTeamID, bool bForceDynamic, ezTime maxStepTime = ezTime::Zero(), ezProgress* pProgress = nullptr);
 
+  /// \brief Creates one instance of the world for every given root transform.
+  ///
+  /// This produces the same objects as calling InstantiatePrefab() once per transform, but it is considerably cheaper when spawning
+  /// many copies of the same prefab at once. The object hierarchy and component creation data is only decoded once in ReadWorldDescription(),
+  /// components are created and deserialized type by type for all instances, so each component manager is only looked up once
+  /// and the serialized component data of each type is replayed from the same cached blob.
+  ///
+  /// The created root and child objects of all instances are appended to the given arrays, instance after instance.
+  /// Each instance contributes GetRootObjectCount() root and GetChildObjectCount() child objects.
+  ///
+  /// Instantiation always happens immediately, there is no time-sliced version of this function.
+  void InstantiateMany(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects,
+    ezDynamicArray<ezGameObject*>* out_CreatedChildObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const { return *m_pStream; }
 
@@ -123,10 +137,21 @@ private:
     ezUInt32 m_uiParentHandleIdx;
   };
 
+  struct ComponentToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOwnerHandleIdx;
+    ezUInt8 m_uiUserFlags;
+    bool m_bActive;
+  };
+
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
   void ReadComponentDataToMemStream();
+  ezResult DecodeComponentCreationData();
   void ClearHandles();
+  ezComponentHandle CreateComponent(ezComponentManagerBase* pManager, const ComponentToCreate& compToCreate, ezUInt32 uiGameObjectHandleOffset);
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, ezGameObjectHandle hParent,
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
     const ezUInt16* pOverrideTeamID, bool bForceDynamic, ezTime maxStepTime, ezProgress* pProgress);
@@ -144,7 +169,9 @@ private:
   {
     const ezRTTI* m_pRtti = nullptr;
     ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
+    ezDynamicArray<ComponentToCreate> m_ComponentsToCreate; // decoded once from the component creation stream
     ezUInt32 m_uiNumComponents = 0;
+    ezUInt32 m_uiDataStreamOffset = 0; // start of the serialized data of this type in m_ComponentDataStream
   };
 
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
@@ -153,6 +180,11 @@ private:
   ezMemoryStreamStorage m_ComponentDataStream;
   ezUInt64 m_uiTotalNumComponents = 0;
 
+  // Offsets into the handle tables while InstantiateMany() deserializes components of one instance.
+  // Every instance uses its own section of the tables, each starting with an invalid handle at relative index 0.
+  ezUInt32 m_uiGameObjectHandleOffset = 0;
+  ezUInt32 m_uiInstanceIndex = 0;
+
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
   class InstantiationContext : public InstantiationContextBase
@@ -23,6 +23,70 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& arrayPtr, const Comparer& comparer)
   InsertionSort(arrayPtr, 0, arrayPtr.GetCount() - 1, comparer);
 }
 
+template <typename T, typename KeyFunc>
+void ezSorting::RadixSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> tempStorage, const KeyFunc& keyFunc)
+{
+  using KeyType = typename std::decay<decltype(keyFunc(arrayPtr[0]))>::type;
+  static_assert(std::is_unsigned<KeyType>::value && (sizeof(KeyType) == 4 || sizeof(KeyType) == 8), "Key has to be ezUInt32 or ezUInt64");
+
+  constexpr ezUInt32 uiNumPasses = sizeof(KeyType);
+
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+  if (uiCount <= 1)
+    return;
+
+  EZ_ASSERT_DEV(tempStorage.GetCount() >= uiCount, "Temp storage is too small. Needs at least {} elements but has only {}", uiCount,
+    tempStorage.GetCount());
+
+  // Build the histograms of all passes at once, so the input only needs to be read one additional time.
+  ezUInt32 histograms[uiNumPasses][256] = {};
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    const KeyType key = keyFunc(arrayPtr[i]);
+
+    for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+    {
+      ++histograms[uiPass][(key >> (uiPass * 8)) & 0xFF];
+    }
+  }
+
+  T* pSource = arrayPtr.GetPtr();
+  T* pTarget = tempStorage.GetPtr();
+
+  for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+  {
+    const ezUInt32 uiShift = uiPass * 8;
+    ezUInt32* pHistogram = histograms[uiPass];
+
+    // All keys have the same byte, nothing to do in this pass.
+    if (pHistogram[(keyFunc(pSource[0]) >> uiShift) & 0xFF] == uiCount)
+      continue;
+
+    // Turn the histogram into the start offsets of each bucket
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 i = 0; i < 256; ++i)
+    {
+      const ezUInt32 uiBucketCount = pHistogram[i];
+      pHistogram[i] = uiOffset;
+      uiOffset += uiBucketCount;
+    }
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const ezUInt32 uiBucket = (keyFunc(pSource[i]) >> uiShift) & 0xFF;
+      pTarget[pHistogram[uiBucket]++] = pSource[i];
+    }
+
+    ezMath::Swap(pSource, pTarget);
+  }
+
+  if (pSource != arrayPtr.GetPtr())
+  {
+    ezMemoryUtils::Copy(arrayPtr.GetPtr(), pSource, uiCount);
+  }
+}
+
 
 template <typename Container, typename Comparer>
 void ezSorting::QuickSort(Container& container, ezUInt32 uiStartIndex, ezUInt32 uiEndIndex, const Comparer& comparer)
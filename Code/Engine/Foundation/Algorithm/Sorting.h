@@ -27,6 +27,17 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+
+  /// \brief Sorts the elements in the array by an unsigned integer key using a LSD radix sort (stable, not in-place).
+  ///
+  /// keyFunc has to return the key of an element as ezUInt32 or ezUInt64. The elements are only copied around, the key is never
+  /// compared, so this is a good fit for large arrays of small structs that carry their key with them.
+  /// tempStorage must have room for at least as many elements as arrayPtr, its content is undefined afterwards.
+  /// Passes in which all keys share the same byte are skipped, which makes keys that only use a few bits cheap to sort.
+  /// Since the sort is stable, sorting by a secondary key first and by the primary key afterwards results in lexicographic order.
+  template <typename T, typename KeyFunc>
+  static void RadixSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> tempStorage, const KeyFunc& keyFunc); // [tested]
+
 private:
   enum
   {
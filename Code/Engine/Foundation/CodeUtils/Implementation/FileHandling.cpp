@@ -36,6 +36,11 @@ const ezTokenizer* ezTokenizedFileCache::Tokenize(const ezString& sFileName, ezA
 {
   EZ_LOCK(m_Mutex);
 
+  // another preprocessor may have tokenized the same file since it called Lookup() and might already be reading the tokens
+  auto it = m_Cache.Find(sFileName);
+  if (it.IsValid())
+    return &it.Value().m_Tokens;
+
   auto& data = m_Cache[sFileName];
 
   data.m_Timestamp = FileTimeStamp;
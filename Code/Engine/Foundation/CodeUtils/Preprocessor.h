@@ -12,6 +12,9 @@
 
 /// \brief This object caches files in a tokenized state. It can be shared among ezPreprocessor instances to improve performance when
 /// they access the same files.
+///
+/// The cache is thread-safe, so preprocessors that run in parallel may share one instance. Once a file is cached, its tokens are never
+/// modified anymore, so they can be read without holding a lock. Remove() and Clear() must not be called while any preprocessor is working.
 class EZ_FOUNDATION_DLL ezTokenizedFileCache
 {
 public:
@@ -34,6 +37,8 @@ public:
   ///
   //// The file content is tokenized first and all #line directives are evaluated, to update the line number and file origin for each token.
   /// Any errors are written to the given log.
+  ///
+  /// If the file has been cached in the meantime (e.g. by another thread), the existing data is kept and returned instead.
   const ezTokenizer* Tokenize(const ezString& sFileName, ezArrayPtr<const ezUInt8> FileContent, const ezTimestamp& FileTimeStamp, ezLogInterface* pLog);
 
 private:
@@ -165,6 +170,9 @@ public:
   /// Files #included in "" will be appended as relative paths to the path of the file they appeared in.
   void SetFileLocatorFunction(FileLocatorCB LocateAbsFileCB);
 
+  /// \brief The file locator that is used when no other one is set. Can be called by custom file locators that only want to extend its behavior.
+  static ezResult DefaultFileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath);
+
   /// \brief Adds a #define to the preprocessor, even before any file is processed.
   ///
   /// This allows to have global macros that are always defined for all processed files, such as the current platform etc.
@@ -257,7 +265,6 @@ private:
 
 private: // *** File Handling ***
   ezResult OpenFile(const char* szFile, const ezTokenizer** pTokenizer);
-  static ezResult DefaultFileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath);
   static ezResult DefaultFileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification);
 
   FileOpenCB m_FileOpenCallback;
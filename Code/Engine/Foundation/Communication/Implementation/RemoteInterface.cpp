@@ -1,6 +1,8 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/RemoteInterface.h>
+#include <Foundation/Types/Uuid.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
 ezRemoteInterface::~ezRemoteInterface()
@@ -24,7 +26,13 @@ ezResult ezRemoteInterface::CreateConnection(ezUInt32 uiConnectionToken, ezRemot
   if (m_uiApplicationID == 0)
   {
     // create a 'unique' ID to identify this application
-    m_uiApplicationID = (ezUInt32)ezTime::Now().GetSeconds();
+    // the time alone is not enough, several instances may connect within the same second, e.g. from the same process
+    ezUuid guid;
+    guid.CreateNewUuid();
+    m_uiApplicationID = ezHashingUtils::xxHash32(&guid, sizeof(ezUuid));
+
+    if (m_uiApplicationID == 0)
+      m_uiApplicationID = 1;
   }
 
   if (InternalCreateConnection(mode, szServerAddress).Failed())
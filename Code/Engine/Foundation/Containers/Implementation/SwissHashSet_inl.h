@@ -0,0 +1,578 @@
+// ***** Const Iterator *****
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ConstIterator::ConstIterator(const ezSwissHashSetBase<K, H>& hashSet)
+  : m_hashSet(&hashSet)
+{
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashSet->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashSet->m_uiCapacity;
+    return;
+  }
+
+  m_uiStartIndex = ezInternal::SwissTableControl::GetIterationStart(m_hashSet->m_pControlBytes, m_hashSet->m_uiCapacity);
+  m_uiCurrentIndex =
+    ezInternal::SwissTableControl::FindFullSlot(m_hashSet->m_pControlBytes, m_hashSet->m_uiCapacity, m_uiStartIndex, m_hashSet->m_uiCapacity);
+}
+
+template <typename K, typename H>
+inline void ezSwissHashSetBase<K, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentIndex = m_hashSet->m_uiCapacity;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentIndex < m_hashSet->m_uiCapacity;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::ConstIterator::operator==(const typename ezSwissHashSetBase<K, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashSet->m_pEntries == rhs.m_hashSet->m_pEntries;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::ConstIterator::operator!=(const typename ezSwissHashSetBase<K, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE const K& ezSwissHashSetBase<K, H>::ConstIterator::Key() const
+{
+  return m_hashSet->m_pEntries[m_uiCurrentIndex];
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::ConstIterator::Next()
+{
+  if (!IsValid())
+    return;
+
+  const ezUInt32 uiCapacity = m_hashSet->m_uiCapacity;
+
+  // only look at the slots up to the one where the iteration started
+  const ezUInt32 uiNextIndex = (m_uiCurrentIndex + 1) & (uiCapacity - 1);
+  const ezUInt32 uiNumSlotsLeft = (m_uiStartIndex - uiNextIndex) & (uiCapacity - 1);
+
+  m_uiCurrentIndex = ezInternal::SwissTableControl::FindFullSlot(m_hashSet->m_pControlBytes, uiCapacity, uiNextIndex, uiNumSlotsLeft);
+
+  // if no slot was found, we reached the end of all elements in the container
+  if (m_uiCurrentIndex == ezInvalidIndex)
+  {
+    m_uiCurrentIndex = uiCapacity;
+  }
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE void ezSwissHashSetBase<K, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** ezSwissHashSetBase *****
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ezSwissHashSetBase(ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ezSwissHashSetBase(const ezSwissHashSetBase<K, H>& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ezSwissHashSetBase(ezSwissHashSetBase<K, H>&& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::~ezSwissHashSetBase()
+{
+  Clear();
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+  m_uiCapacity = 0;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::operator=(const ezSwissHashSetBase<K, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  // the keys are known to be unique, so they can be inserted into the first empty slot directly
+  for (ezUInt32 i = 0; i < rhs.m_uiCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(rhs.m_pControlBytes, i))
+    {
+      const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(rhs.m_pEntries[i]));
+      const ezUInt32 uiIndex = ezInternal::SwissTableControl::FindEmptySlot(
+        m_pControlBytes, m_uiCapacity, ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity));
+
+      ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex], rhs.m_pEntries[i], 1);
+      MarkEntryAsValid(uiIndex, uiMixedHash);
+    }
+  }
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::operator=(ezSwissHashSetBase<K, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    for (ezUInt32 i = 0; i < rhs.m_uiCapacity; ++i)
+    {
+      if (ezInternal::SwissTableControl::IsFull(rhs.m_pControlBytes, i))
+      {
+        Insert(std::move(rhs.m_pEntries[i]));
+      }
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControlBytes = rhs.m_pControlBytes;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControlBytes = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+  }
+}
+
+template <typename K, typename H>
+bool ezSwissHashSetBase<K, H>::operator==(const ezSwissHashSetBase<K, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(m_pControlBytes, i))
+    {
+      if (!rhs.Contains(m_pEntries[i]))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::operator!=(const ezSwissHashSetBase<K, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE void ezSwissHashSetBase<K, H>::Reserve(ezUInt32 uiCapacity)
+{
+  if (uiCapacity <= ezInternal::SwissTableControl::GetMaxLoad(m_uiCapacity))
+    return;
+
+  SetCapacity(ezInternal::SwissTableControl::ComputeCapacity(uiCapacity));
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+    m_uiCapacity = 0;
+  }
+  else
+  {
+    const ezUInt32 uiNewCapacity = ezInternal::SwissTableControl::ComputeCapacity(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashSetBase<K, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Clear()
+{
+  if (m_uiCount == 0)
+    return;
+
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(m_pControlBytes, i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i], 1);
+    }
+  }
+
+  ezInternal::SwissTableControl::ClearAll(m_pControlBytes, m_uiCapacity);
+  m_uiCount = 0;
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+bool ezSwissHashSetBase<K, H>::Insert(CompatibleKeyType&& key)
+{
+  Reserve(m_uiCount + 1);
+
+  const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(key));
+
+  ezUInt32 uiInsertIndex;
+  if (FindEntry(uiMixedHash, key, uiInsertIndex) != ezInvalidIndex)
+    return true;
+
+  // This will either move or copy, depending on the type of key.
+  ezMemoryUtils::CopyOrMoveConstruct<K>(&m_pEntries[uiInsertIndex], std::forward<CompatibleKeyType>(key));
+  MarkEntryAsValid(uiInsertIndex, uiMixedHash);
+
+  return false;
+}
+
+template <typename K, typename H>
+bool ezSwissHashSetBase<K, H>::Remove(const K& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename H>
+typename ezSwissHashSetBase<K, H>::ConstIterator ezSwissHashSetBase<K, H>::Remove(const typename ezSwissHashSetBase<K, H>::ConstIterator& pos)
+{
+  ConstIterator it = pos;
+  RemoveInternal(pos.m_uiCurrentIndex);
+
+  // if another entry was shifted into the removed slot, it has not been visited yet, so the iterator stays where it is
+  if (!ezInternal::SwissTableControl::IsFull(m_pControlBytes, it.m_uiCurrentIndex))
+  {
+    ++it;
+  }
+
+  return it;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex], 1);
+
+  // shift all following entries of the probe sequence backwards, which are allowed to move, so that no tombstone is needed
+  ezUInt32 uiHole = uiIndex;
+  for (ezUInt32 i = (uiIndex + 1) & (m_uiCapacity - 1); ezInternal::SwissTableControl::IsFull(m_pControlBytes, i);
+       i = (i + 1) & (m_uiCapacity - 1))
+  {
+    const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(m_pEntries[i]));
+    const ezUInt32 uiHomeSlot = ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity);
+
+    if (ezInternal::SwissTableControl::CanShiftInto(uiHole, i, uiHomeSlot, m_uiCapacity))
+    {
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiHole], &m_pEntries[i], 1);
+      ezInternal::SwissTableControl::SetCtrl(m_pControlBytes, m_uiCapacity, uiHole, m_pControlBytes[i]);
+
+      uiHole = i;
+    }
+  }
+
+  ezInternal::SwissTableControl::SetCtrl(m_pControlBytes, m_uiCapacity, uiHole, ezInternal::SwissTableGroup::EmptyCtrl);
+  --m_uiCount;
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE bool ezSwissHashSetBase<K, H>::Contains(const K& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename H>
+bool ezSwissHashSetBase<K, H>::ContainsSet(const ezSwissHashSetBase<K, H>& operand) const
+{
+  for (const K& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Union(const ezSwissHashSetBase<K, H>& operand)
+{
+  Reserve(GetCount() + operand.GetCount());
+  for (const auto& key : operand)
+  {
+    Insert(key);
+  }
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Difference(const ezSwissHashSetBase<K, H>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Remove(key);
+  }
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Intersection(const ezSwissHashSetBase<K, H>& operand)
+{
+  for (auto it = GetIterator(); it.IsValid();)
+  {
+    if (!operand.Contains(it.Key()))
+      it = Remove(it);
+    else
+      ++it;
+  }
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE typename ezSwissHashSetBase<K, H>::ConstIterator ezSwissHashSetBase<K, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE typename ezSwissHashSetBase<K, H>::ConstIterator ezSwissHashSetBase<K, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezSwissHashSetBase<K, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename H>
+ezUInt64 ezSwissHashSetBase<K, H>::GetHeapMemoryUsage() const
+{
+  if (m_uiCapacity == 0)
+    return 0;
+
+  return ((ezUInt64)m_uiCapacity * sizeof(K)) + ezInternal::SwissTableControl::GetNumControlBytes(m_uiCapacity);
+}
+
+// private methods
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity), "uiCapacity must be a power of two to avoid modulo during lookup.");
+  EZ_ASSERT_DEV(m_uiCount <= ezInternal::SwissTableControl::GetMaxLoad(uiCapacity), "uiCapacity is too small for the current number of entries.");
+
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+  m_uiCapacity = uiCapacity;
+
+  K* pOldEntries = m_pEntries;
+  ezUInt8* pOldControlBytes = m_pControlBytes;
+
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, K, m_uiCapacity);
+  m_pControlBytes = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt8, ezInternal::SwissTableControl::GetNumControlBytes(m_uiCapacity));
+  ezInternal::SwissTableControl::ClearAll(m_pControlBytes, m_uiCapacity);
+
+  m_uiCount = 0;
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(pOldControlBytes, i))
+    {
+      const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(pOldEntries[i]));
+      const ezUInt32 uiIndex = ezInternal::SwissTableControl::FindEmptySlot(
+        m_pControlBytes, m_uiCapacity, ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity));
+
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex], &pOldEntries[i], 1);
+      MarkEntryAsValid(uiIndex, uiMixedHash);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldControlBytes);
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashSetBase<K, H>::FindEntry(const K& key) const
+{
+  ezUInt32 uiInsertIndex;
+  return FindEntry(ezInternal::SwissTableControl::MixHash(H::Hash(key)), key, uiInsertIndex);
+}
+
+template <typename K, typename H>
+inline ezUInt32 ezSwissHashSetBase<K, H>::FindEntry(ezUInt32 uiMixedHash, const K& key, ezUInt32& out_uiInsertIndex) const
+{
+  out_uiInsertIndex = ezInvalidIndex;
+
+  if (m_uiCapacity == 0)
+    return ezInvalidIndex;
+
+  const ezUInt8 uiH2 = ezInternal::SwissTableControl::GetH2(uiMixedHash);
+  ezUInt32 uiGroupIndex = ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity);
+
+  while (true)
+  {
+    const ezInternal::SwissTableGroup group(m_pControlBytes + uiGroupIndex);
+    const ezUInt32 uiEmpty = group.MatchEmpty();
+    ezUInt32 uiMatch = group.Match(uiH2);
+
+    // the probe sequence ends at the first empty slot, matches after it belong to other keys
+    if (uiEmpty != 0)
+      uiMatch &= (uiEmpty & (0u - uiEmpty)) - 1;
+
+    while (uiMatch != 0)
+    {
+      const ezUInt32 uiIndex = (uiGroupIndex + ezMath::CountTrailingZeros(uiMatch)) & (m_uiCapacity - 1);
+      if (H::Equal(m_pEntries[uiIndex], key))
+        return uiIndex;
+
+      uiMatch &= uiMatch - 1;
+    }
+
+    if (uiEmpty != 0)
+    {
+      out_uiInsertIndex = (uiGroupIndex + ezMath::CountTrailingZeros(uiEmpty)) & (m_uiCapacity - 1);
+      return ezInvalidIndex;
+    }
+
+    uiGroupIndex = (uiGroupIndex + ezInternal::SwissTableGroup::Size) & (m_uiCapacity - 1);
+  }
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE void ezSwissHashSetBase<K, H>::MarkEntryAsValid(ezUInt32 uiIndex, ezUInt32 uiMixedHash)
+{
+  ezInternal::SwissTableControl::SetCtrl(m_pControlBytes, m_uiCapacity, uiIndex, ezInternal::SwissTableControl::GetH2(uiMixedHash));
+  ++m_uiCount;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Swap(ezSwissHashSetBase<K, H>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControlBytes, other.m_pControlBytes);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet()
+  : ezSwissHashSetBase<K, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(ezAllocatorBase* pAllocator)
+  : ezSwissHashSetBase<K, H>(pAllocator)
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(const ezSwissHashSet<K, H, A>& other)
+  : ezSwissHashSetBase<K, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(const ezSwissHashSetBase<K, H>& other)
+  : ezSwissHashSetBase<K, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(ezSwissHashSet<K, H, A>&& other)
+  : ezSwissHashSetBase<K, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(ezSwissHashSetBase<K, H>&& other)
+  : ezSwissHashSetBase<K, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(const ezSwissHashSet<K, H, A>& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(rhs);
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(const ezSwissHashSetBase<K, H>& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(rhs);
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(ezSwissHashSet<K, H, A>&& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(ezSwissHashSetBase<K, H>&& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(std::move(rhs));
+}
@@ -0,0 +1,746 @@
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ConstIterator::ConstIterator(const ezSwissHashTableBase<K, V, H>& hashTable)
+  : m_hashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+    return;
+  }
+
+  m_uiStartIndex = ezInternal::SwissTableControl::GetIterationStart(m_hashTable->m_pControlBytes, m_hashTable->m_uiCapacity);
+  m_uiCurrentIndex = ezInternal::SwissTableControl::FindFullSlot(
+    m_hashTable->m_pControlBytes, m_hashTable->m_uiCapacity, m_uiStartIndex, m_hashTable->m_uiCapacity);
+}
+
+template <typename K, typename V, typename H>
+inline void ezSwissHashTableBase<K, V, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentIndex < m_hashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::ConstIterator::operator==(
+  const typename ezSwissHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashTable->m_pEntries == rhs.m_hashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashTableBase<K, V, H>::ConstIterator::operator!=(
+  const typename ezSwissHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const K& ezSwissHashTableBase<K, V, H>::ConstIterator::Key() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const V& ezSwissHashTableBase<K, V, H>::ConstIterator::Value() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::ConstIterator::Next()
+{
+  if (!IsValid())
+    return;
+
+  const ezUInt32 uiCapacity = m_hashTable->m_uiCapacity;
+
+  if (m_uiStartIndex == ezInvalidIndex)
+  {
+    m_uiStartIndex = ezInternal::SwissTableControl::GetIterationStart(m_hashTable->m_pControlBytes, uiCapacity);
+  }
+
+  // only look at the slots up to the one where the iteration started
+  const ezUInt32 uiNextIndex = (m_uiCurrentIndex + 1) & (uiCapacity - 1);
+  const ezUInt32 uiNumSlotsLeft = (m_uiStartIndex - uiNextIndex) & (uiCapacity - 1);
+
+  m_uiCurrentIndex = ezInternal::SwissTableControl::FindFullSlot(m_hashTable->m_pControlBytes, uiCapacity, uiNextIndex, uiNumSlotsLeft);
+
+  // if no slot was found, we reached the end of all elements in the container
+  if (m_uiCurrentIndex == ezInvalidIndex)
+  {
+    m_uiCurrentIndex = uiCapacity;
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezSwissHashTableBase<K, V, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::Iterator::Iterator(const ezSwissHashTableBase<K, V, H>& hashTable)
+  : ConstIterator(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::Iterator::Iterator(const typename ezSwissHashTableBase<K, V, H>::Iterator& rhs)
+  : ConstIterator(*rhs.m_hashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiStartIndex = rhs.m_uiStartIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezSwissHashTableBase<K, V, H>::Iterator::operator=(const Iterator& rhs) // [tested]
+{
+  this->m_hashTable = rhs.m_hashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiStartIndex = rhs.m_uiStartIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezSwissHashTableBase<K, V, H>::Iterator::Value()
+{
+  return this->m_hashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+
+// ***** ezSwissHashTableBase *****
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ezSwissHashTableBase(ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ezSwissHashTableBase(const ezSwissHashTableBase<K, V, H>& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ezSwissHashTableBase(ezSwissHashTableBase<K, V, H>&& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::~ezSwissHashTableBase()
+{
+  Clear();
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+  m_uiCapacity = 0;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::operator=(const ezSwissHashTableBase<K, V, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  // the keys are known to be unique, so they can be inserted into the first empty slot directly
+  for (ezUInt32 i = 0; i < rhs.m_uiCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(rhs.m_pControlBytes, i))
+    {
+      const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(rhs.m_pEntries[i].key));
+      const ezUInt32 uiIndex = ezInternal::SwissTableControl::FindEmptySlot(
+        m_pControlBytes, m_uiCapacity, ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity));
+
+      ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, rhs.m_pEntries[i].key, 1);
+      ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].value, rhs.m_pEntries[i].value, 1);
+      MarkEntryAsValid(uiIndex, uiMixedHash);
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::operator=(ezSwissHashTableBase<K, V, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    for (ezUInt32 i = 0; i < rhs.m_uiCapacity; ++i)
+    {
+      if (ezInternal::SwissTableControl::IsFull(rhs.m_pControlBytes, i))
+      {
+        Insert(std::move(rhs.m_pEntries[i].key), std::move(rhs.m_pEntries[i].value));
+      }
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControlBytes = rhs.m_pControlBytes;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControlBytes = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezSwissHashTableBase<K, V, H>::operator==(const ezSwissHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(m_pControlBytes, i))
+    {
+      const V* pRhsValue = nullptr;
+      if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+        return false;
+
+      if (m_pEntries[i].value != *pRhsValue)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashTableBase<K, V, H>::operator!=(const ezSwissHashTableBase<K, V, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE void ezSwissHashTableBase<K, V, H>::Reserve(ezUInt32 uiCapacity)
+{
+  if (uiCapacity <= ezInternal::SwissTableControl::GetMaxLoad(m_uiCapacity))
+    return;
+
+  SetCapacity(ezInternal::SwissTableControl::ComputeCapacity(uiCapacity));
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+    m_uiCapacity = 0;
+  }
+  else
+  {
+    const ezUInt32 uiNewCapacity = ezInternal::SwissTableControl::ComputeCapacity(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::Clear()
+{
+  if (m_uiCount == 0)
+    return;
+
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(m_pControlBytes, i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+      ezMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+    }
+  }
+
+  ezInternal::SwissTableControl::ClearAll(m_pControlBytes, m_uiCapacity);
+  m_uiCount = 0;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool ezSwissHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_oldValue /*= nullptr*/)
+{
+  Reserve(m_uiCount + 1);
+
+  const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(key));
+
+  ezUInt32 uiInsertIndex;
+  const ezUInt32 uiIndex = FindEntry(uiMixedHash, key, uiInsertIndex);
+
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  // Both constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiInsertIndex].key, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiInsertIndex].value, std::forward<CompatibleValueType>(value));
+
+  MarkEntryAsValid(uiInsertIndex, uiMixedHash);
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezSwissHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_oldValue /*= nullptr*/)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::Remove(
+  const typename ezSwissHashTableBase<K, V, H>::Iterator& pos)
+{
+  Iterator it = pos;
+
+  // the start index has to be known before removing, see GetIterationStart()
+  if (it.m_uiStartIndex == ezInvalidIndex)
+  {
+    it.m_uiStartIndex = ezInternal::SwissTableControl::GetIterationStart(m_pControlBytes, m_uiCapacity);
+  }
+
+  RemoveInternal(pos.m_uiCurrentIndex);
+
+  // if another entry was shifted into the removed slot, it has not been visited yet, so the iterator stays where it is
+  if (!ezInternal::SwissTableControl::IsFull(m_pControlBytes, it.m_uiCurrentIndex))
+  {
+    ++it;
+  }
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  // shift all following entries of the probe sequence backwards, which are allowed to move, so that no tombstone is needed
+  ezUInt32 uiHole = uiIndex;
+  for (ezUInt32 i = (uiIndex + 1) & (m_uiCapacity - 1); ezInternal::SwissTableControl::IsFull(m_pControlBytes, i);
+       i = (i + 1) & (m_uiCapacity - 1))
+  {
+    const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(m_pEntries[i].key));
+    const ezUInt32 uiHomeSlot = ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity);
+
+    if (ezInternal::SwissTableControl::CanShiftInto(uiHole, i, uiHomeSlot, m_uiCapacity))
+    {
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiHole].key, &m_pEntries[i].key, 1);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiHole].value, &m_pEntries[i].value, 1);
+      ezInternal::SwissTableControl::SetCtrl(m_pControlBytes, m_uiCapacity, uiHole, m_pControlBytes[i]);
+
+      uiHole = i;
+    }
+  }
+
+  ezInternal::SwissTableControl::SetCtrl(m_pControlBytes, m_uiCapacity, uiHole, ezInternal::SwissTableGroup::EmptyCtrl);
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezSwissHashTableBase<K, V, H>::ConstIterator ezSwissHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  Iterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* ezSwissHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* ezSwissHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+inline V& ezSwissHashTableBase<K, V, H>::operator[](const K& key)
+{
+  const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(key));
+
+  ezUInt32 uiInsertIndex;
+  ezUInt32 uiIndex = FindEntry(uiMixedHash, key, uiInsertIndex);
+
+  if (uiIndex == ezInvalidIndex)
+  {
+    if (m_uiCount + 1 > ezInternal::SwissTableControl::GetMaxLoad(m_uiCapacity))
+    {
+      Reserve(m_uiCount + 1);
+
+      // search for suitable insertion index again, table has been resized
+      uiInsertIndex = ezInternal::SwissTableControl::FindEmptySlot(
+        m_pControlBytes, m_uiCapacity, ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity));
+    }
+
+    // new entry
+    uiIndex = uiInsertIndex;
+    ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, key, 1);
+    ezMemoryUtils::DefaultConstruct(&m_pEntries[uiIndex].value, 1);
+    MarkEntryAsValid(uiIndex, uiMixedHash);
+  }
+
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::ConstIterator ezSwissHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::ConstIterator ezSwissHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezSwissHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezUInt64 ezSwissHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  if (m_uiCapacity == 0)
+    return 0;
+
+  return ((ezUInt64)m_uiCapacity * sizeof(Entry)) + ezInternal::SwissTableControl::GetNumControlBytes(m_uiCapacity);
+}
+
+// private methods
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity), "uiCapacity must be a power of two to avoid modulo during lookup.");
+  EZ_ASSERT_DEV(m_uiCount <= ezInternal::SwissTableControl::GetMaxLoad(uiCapacity), "uiCapacity is too small for the current number of entries.");
+
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+  m_uiCapacity = uiCapacity;
+
+  Entry* pOldEntries = m_pEntries;
+  ezUInt8* pOldControlBytes = m_pControlBytes;
+
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, Entry, m_uiCapacity);
+  m_pControlBytes = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt8, ezInternal::SwissTableControl::GetNumControlBytes(m_uiCapacity));
+  ezInternal::SwissTableControl::ClearAll(m_pControlBytes, m_uiCapacity);
+
+  m_uiCount = 0;
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if (ezInternal::SwissTableControl::IsFull(pOldControlBytes, i))
+    {
+      const ezUInt32 uiMixedHash = ezInternal::SwissTableControl::MixHash(H::Hash(pOldEntries[i].key));
+      const ezUInt32 uiIndex = ezInternal::SwissTableControl::FindEmptySlot(
+        m_pControlBytes, m_uiCapacity, ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity));
+
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &pOldEntries[i].key, 1);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &pOldEntries[i].value, 1);
+      MarkEntryAsValid(uiIndex, uiMixedHash);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldControlBytes);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiInsertIndex;
+  return FindEntry(ezInternal::SwissTableControl::MixHash(H::Hash(key)), key, uiInsertIndex);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezSwissHashTableBase<K, V, H>::FindEntry(ezUInt32 uiMixedHash, const CompatibleKeyType& key, ezUInt32& out_uiInsertIndex) const
+{
+  out_uiInsertIndex = ezInvalidIndex;
+
+  if (m_uiCapacity == 0)
+    return ezInvalidIndex;
+
+  const ezUInt8 uiH2 = ezInternal::SwissTableControl::GetH2(uiMixedHash);
+  ezUInt32 uiGroupIndex = ezInternal::SwissTableControl::GetHomeSlot(uiMixedHash, m_uiCapacity);
+
+  while (true)
+  {
+    const ezInternal::SwissTableGroup group(m_pControlBytes + uiGroupIndex);
+    const ezUInt32 uiEmpty = group.MatchEmpty();
+    ezUInt32 uiMatch = group.Match(uiH2);
+
+    // the probe sequence ends at the first empty slot, matches after it belong to other keys
+    if (uiEmpty != 0)
+      uiMatch &= (uiEmpty & (0u - uiEmpty)) - 1;
+
+    while (uiMatch != 0)
+    {
+      const ezUInt32 uiIndex = (uiGroupIndex + ezMath::CountTrailingZeros(uiMatch)) & (m_uiCapacity - 1);
+      if (H::Equal(m_pEntries[uiIndex].key, key))
+        return uiIndex;
+
+      uiMatch &= uiMatch - 1;
+    }
+
+    if (uiEmpty != 0)
+    {
+      out_uiInsertIndex = (uiGroupIndex + ezMath::CountTrailingZeros(uiEmpty)) & (m_uiCapacity - 1);
+      return ezInvalidIndex;
+    }
+
+    uiGroupIndex = (uiGroupIndex + ezInternal::SwissTableGroup::Size) & (m_uiCapacity - 1);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE void ezSwissHashTableBase<K, V, H>::MarkEntryAsValid(ezUInt32 uiIndex, ezUInt32 uiMixedHash)
+{
+  ezInternal::SwissTableControl::SetCtrl(m_pControlBytes, m_uiCapacity, uiIndex, ezInternal::SwissTableControl::GetH2(uiMixedHash));
+  ++m_uiCount;
+}
+
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable()
+  : ezSwissHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(ezAllocatorBase* pAllocator)
+  : ezSwissHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(const ezSwissHashTable<K, V, H, A>& other)
+  : ezSwissHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(const ezSwissHashTableBase<K, V, H>& other)
+  : ezSwissHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(ezSwissHashTable<K, V, H, A>&& other)
+  : ezSwissHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(ezSwissHashTableBase<K, V, H>&& other)
+  : ezSwissHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(const ezSwissHashTable<K, V, H, A>& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(const ezSwissHashTableBase<K, V, H>& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(ezSwissHashTable<K, V, H, A>&& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(ezSwissHashTableBase<K, V, H>&& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void ezSwissHashTableBase<KeyType, ValueType, Hasher>::Swap(ezSwissHashTableBase<KeyType, ValueType, Hasher>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControlBytes, other.m_pControlBytes);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/MemoryUtils.h>
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  include <emmintrin.h>
+#endif
+
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef ezInvalidIndex
+#  define ezInvalidIndex 0xFFFFFFFF
+#endif
+
+namespace ezInternal
+{
+  /// \brief A group of 16 consecutive control bytes of ezSwissHashTable or ezSwissHashSet that are matched at once.
+  ///
+  /// Every slot of the table has one control byte. An empty slot has the highest bit set, a used slot stores the lowest 7 bits of
+  /// the hash of its key. All Match functions return a bitmask in which bit i corresponds to the i-th control byte of the group.
+  struct SwissTableGroup
+  {
+    enum
+    {
+      Size = 16,
+      EmptyCtrl = 0x80,
+    };
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+
+    EZ_ALWAYS_INLINE explicit SwissTableGroup(const ezUInt8* pCtrl) { m_Ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl)); }
+
+    EZ_ALWAYS_INLINE ezUInt32 Match(ezUInt8 uiH2) const
+    {
+      return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Ctrl, _mm_set1_epi8(static_cast<char>(uiH2)))));
+    }
+
+    EZ_ALWAYS_INLINE ezUInt32 MatchEmpty() const { return static_cast<ezUInt32>(_mm_movemask_epi8(m_Ctrl)); }
+
+    __m128i m_Ctrl;
+
+#else
+
+    EZ_ALWAYS_INLINE explicit SwissTableGroup(const ezUInt8* pCtrl) { ezMemoryUtils::Copy(m_Ctrl, pCtrl, Size); }
+
+    EZ_FORCE_INLINE ezUInt32 Match(ezUInt8 uiH2) const
+    {
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < Size; ++i)
+      {
+        uiMask |= (m_Ctrl[i] == uiH2 ? 1u : 0u) << i;
+      }
+      return uiMask;
+    }
+
+    EZ_FORCE_INLINE ezUInt32 MatchEmpty() const
+    {
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < Size; ++i)
+      {
+        uiMask |= static_cast<ezUInt32>(m_Ctrl[i] >> 7) << i;
+      }
+      return uiMask;
+    }
+
+    ezUInt8 m_Ctrl[Size];
+
+#endif
+
+    EZ_ALWAYS_INLINE ezUInt32 MatchFull() const { return ~MatchEmpty() & 0xFFFFu; }
+  };
+
+  /// \brief Shared helper functions for the control bytes of ezSwissHashTable and ezSwissHashSet.
+  ///
+  /// The tables use linear probing on slot granularity, but always look at a whole group of control bytes at once.
+  /// The first 15 control bytes are replicated after the last one, so that a group can be loaded at any slot without wrapping around.
+  /// Entries are removed with backward shifting, so there are never any tombstones and a probe sequence ends at the first empty slot.
+  struct SwissTableControl
+  {
+    /// \brief Number of control bytes that need to be allocated for the given capacity.
+    EZ_ALWAYS_INLINE static ezUInt32 GetNumControlBytes(ezUInt32 uiCapacity) { return uiCapacity + SwissTableGroup::Size - 1; }
+
+    /// \brief Mixes the bits of the user provided hash, so that hash functions with weak lower or upper bits still work well.
+    EZ_ALWAYS_INLINE static ezUInt32 MixHash(ezUInt32 uiHash)
+    {
+      uiHash ^= uiHash >> 16;
+      uiHash *= 0x85ebca6bu;
+      uiHash ^= uiHash >> 13;
+      uiHash *= 0xc2b2ae35u;
+      uiHash ^= uiHash >> 16;
+      return uiHash;
+    }
+
+    /// \brief The slot at which the probe sequence for the given (mixed) hash starts.
+    EZ_ALWAYS_INLINE static ezUInt32 GetHomeSlot(ezUInt32 uiMixedHash, ezUInt32 uiCapacity) { return (uiMixedHash >> 7) & (uiCapacity - 1); }
+
+    /// \brief The 7 bit fingerprint that is stored in the control byte.
+    EZ_ALWAYS_INLINE static ezUInt8 GetH2(ezUInt32 uiMixedHash) { return static_cast<ezUInt8>(uiMixedHash & 0x7F); }
+
+    EZ_ALWAYS_INLINE static bool IsFull(const ezUInt8* pCtrl, ezUInt32 uiIndex) { return (pCtrl[uiIndex] & SwissTableGroup::EmptyCtrl) == 0; }
+
+    EZ_FORCE_INLINE static void SetCtrl(ezUInt8* pCtrl, ezUInt32 uiCapacity, ezUInt32 uiIndex, ezUInt8 uiValue)
+    {
+      pCtrl[uiIndex] = uiValue;
+
+      if (uiIndex < SwissTableGroup::Size - 1)
+        pCtrl[uiCapacity + uiIndex] = uiValue;
+    }
+
+    static void ClearAll(ezUInt8* pCtrl, ezUInt32 uiCapacity)
+    {
+      ezMemoryUtils::PatternFill(pCtrl, SwissTableGroup::EmptyCtrl, GetNumControlBytes(uiCapacity));
+    }
+
+    /// \brief Returns the first empty slot at or after uiIndex. The table must not be full.
+    static ezUInt32 FindEmptySlot(const ezUInt8* pCtrl, ezUInt32 uiCapacity, ezUInt32 uiIndex)
+    {
+      while (true)
+      {
+        const ezUInt32 uiEmpty = SwissTableGroup(pCtrl + uiIndex).MatchEmpty();
+        if (uiEmpty != 0)
+          return (uiIndex + ezMath::CountTrailingZeros(uiEmpty)) & (uiCapacity - 1);
+
+        uiIndex = (uiIndex + SwissTableGroup::Size) & (uiCapacity - 1);
+      }
+    }
+
+    /// \brief Returns the first used slot in the range of uiNumSlots slots starting at uiIndex, or ezInvalidIndex if there is none.
+    static ezUInt32 FindFullSlot(const ezUInt8* pCtrl, ezUInt32 uiCapacity, ezUInt32 uiIndex, ezUInt32 uiNumSlots)
+    {
+      while (uiNumSlots > 0)
+      {
+        const ezUInt32 uiNumToCheck = ezMath::Min<ezUInt32>(uiNumSlots, SwissTableGroup::Size);
+        const ezUInt32 uiFull = SwissTableGroup(pCtrl + uiIndex).MatchFull() & ((1u << uiNumToCheck) - 1);
+        if (uiFull != 0)
+          return (uiIndex + ezMath::CountTrailingZeros(uiFull)) & (uiCapacity - 1);
+
+        uiIndex = (uiIndex + uiNumToCheck) & (uiCapacity - 1);
+        uiNumSlots -= uiNumToCheck;
+      }
+
+      return ezInvalidIndex;
+    }
+
+    /// \brief Returns the slot at which iteration has to start, that is the slot after the first empty one.
+    ///
+    /// Removing an entry only shifts entries of the same probe sequence backwards, and no probe sequence crosses an empty slot.
+    /// Therefore, when iterating from here, removing the current entry never moves an entry that was already visited
+    /// to a slot that is yet to be visited.
+    EZ_FORCE_INLINE static ezUInt32 GetIterationStart(const ezUInt8* pCtrl, ezUInt32 uiCapacity)
+    {
+      return (FindEmptySlot(pCtrl, uiCapacity, 0) + 1) & (uiCapacity - 1);
+    }
+
+    /// \brief Whether the entry at uiIndex with the given home slot may be moved into the empty slot uiHole during backward shifting.
+    EZ_ALWAYS_INLINE static bool CanShiftInto(ezUInt32 uiHole, ezUInt32 uiIndex, ezUInt32 uiHomeSlot, ezUInt32 uiCapacity)
+    {
+      // the entry may not be moved before its home slot, i.e. the home slot must not lie in (uiHole, uiIndex]
+      return ((uiIndex - uiHomeSlot) & (uiCapacity - 1)) >= ((uiIndex - uiHole) & (uiCapacity - 1));
+    }
+
+    /// \brief Computes the capacity that is needed to store the given number of entries with a maximum load of 75%.
+    static ezUInt32 ComputeCapacity(ezUInt32 uiNumEntries)
+    {
+      const ezUInt64 uiNum64 = static_cast<ezUInt64>(uiNumEntries);
+      ezUInt64 uiCapacity64 = (uiNum64 + 2) / 3 * 4;
+
+      uiCapacity64 = ezMath::Min<ezUInt64>(uiCapacity64, 0x80000000llu); // the largest power-of-two in 32 bit
+
+      const ezUInt32 uiCapacity32 = static_cast<ezUInt32>(uiCapacity64 & 0xFFFFFFFF);
+      EZ_ASSERT_DEBUG(uiNumEntries <= uiCapacity32 / 4 * 3, "ezSwissHashSet/Table do not support more than 1.5 billion entries.");
+
+      return ezMath::Max<ezUInt32>(ezMath::PowerOfTwo_Ceil(uiCapacity32), SwissTableGroup::Size);
+    }
+
+    EZ_ALWAYS_INLINE static ezUInt32 GetMaxLoad(ezUInt32 uiCapacity) { return uiCapacity / 4 * 3; }
+  };
+} // namespace ezInternal
@@ -8,6 +8,7 @@ ezProcessingStream::ezProcessingStream(const char* szName, ezProcessingStream::D
   , m_uiAlignment(uiAlignment)
   , m_uiNumElements(0)
   , m_uiTypeSize(GetDataTypeSize(Type))
+  , m_uiComponentArrayStride(0)
   , m_Type(Type)
   , m_Name()
 {
@@ -31,15 +32,23 @@ void ezProcessingStream::SetSize(ezUInt64 uiNumElements)
     return;
   }
 
+  ezUInt64 uiNumBytes = uiNumElements * GetDataTypeSize(m_Type);
+
+  if (IsSoA())
+  {
+    // each component array is padded to the SIMD width and starts at the stream alignment
+    m_uiComponentArrayStride = ezMemoryUtils::AlignSize<ezUInt64>(ezMemoryUtils::AlignSize<ezUInt64>(uiNumElements, SoAPadding) * m_uiTypeSize, ezMath::Max<ezUInt64>(m_uiAlignment, 1));
+    uiNumBytes = m_uiComponentArrayStride * GetNumComponentArrays();
+  }
+
   /// \todo Allow to reuse memory from a pool ?
   if (m_uiAlignment > 0)
   {
-    m_pData =
-      ezFoundation::GetAlignedAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), static_cast<size_t>(m_uiAlignment));
+    m_pData = ezFoundation::GetAlignedAllocator()->Allocate(static_cast<size_t>(uiNumBytes), static_cast<size_t>(m_uiAlignment));
   }
   else
   {
-    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), 0);
+    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumBytes), 0);
   }
 
   EZ_ASSERT_DEV(m_pData != nullptr, "Allocating {0} elements of {1} bytes each, with {2} bytes alignment, failed", uiNumElements,
@@ -61,7 +70,9 @@ void ezProcessingStream::FreeData()
     }
   }
 
+  m_pData = nullptr;
   m_uiNumElements = 0;
+  m_uiComponentArrayStride = 0;
 }
 
 size_t ezProcessingStream::GetDataTypeSize(DataType Type)
@@ -77,6 +88,7 @@ size_t ezProcessingStream::GetDataTypeSize(DataType Type)
       return 2;
 
     case DataType::Float:
+    case DataType::Float3SoA:
     case DataType::Int:
     case DataType::Short2:
     // case DataType::Byte4:
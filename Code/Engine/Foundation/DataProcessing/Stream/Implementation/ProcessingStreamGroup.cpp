@@ -224,10 +224,15 @@ void ezProcessingStreamGroup::RunPendingDeletions()
     {
       const ezUInt64 uiStreamElementStride = pStream->GetElementStride();
       const ezUInt64 uiStreamElementSize = pStream->GetElementSize();
-      const void* pSourceData = ezMemoryUtils::AddByteOffset(pStream->GetData(), static_cast<ptrdiff_t>(uiLastActiveElementIndex * uiStreamElementStride));
-      void* pTargetData = ezMemoryUtils::AddByteOffset(pStream->GetWritableData(), static_cast<ptrdiff_t>(uiElementToRemove * uiStreamElementStride));
 
-      ezMemoryUtils::Copy<ezUInt8>(static_cast<ezUInt8*>(pTargetData), static_cast<const ezUInt8*>(pSourceData), static_cast<size_t>(uiStreamElementSize));
+      for (ezUInt32 uiComponentArray = 0; uiComponentArray < pStream->GetNumComponentArrays(); ++uiComponentArray)
+      {
+        const ezUInt64 uiArrayOffset = uiComponentArray * pStream->GetComponentArrayStride();
+        const void* pSourceData = ezMemoryUtils::AddByteOffset(pStream->GetData(), static_cast<ptrdiff_t>(uiArrayOffset + uiLastActiveElementIndex * uiStreamElementStride));
+        void* pTargetData = ezMemoryUtils::AddByteOffset(pStream->GetWritableData(), static_cast<ptrdiff_t>(uiArrayOffset + uiElementToRemove * uiStreamElementStride));
+
+        ezMemoryUtils::Copy<ezUInt8>(static_cast<ezUInt8*>(pTargetData), static_cast<const ezUInt8*>(pSourceData), static_cast<size_t>(uiStreamElementSize));
+      }
     }
 
     // And decrease the size since we swapped the last element to the location of the element we just removed
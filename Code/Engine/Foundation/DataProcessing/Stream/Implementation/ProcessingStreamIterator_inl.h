@@ -7,6 +7,7 @@ ezProcessingStreamIterator<Type>::ezProcessingStreamIterator(const ezProcessingS
 {
   EZ_ASSERT_DEV(pStream != nullptr, "Stream pointer may not be null!");
   EZ_ASSERT_DEV(pStream->GetElementSize() == sizeof(Type), "Data size missmatch");
+  EZ_ASSERT_DEV(!pStream->IsSoA(), "SoA streams can't be iterated element-wise, use ezProcessingStreamSoA3f instead");
 
   m_uiElementStride = pStream->GetElementStride();
 
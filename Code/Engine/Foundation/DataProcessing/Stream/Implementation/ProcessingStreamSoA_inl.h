@@ -0,0 +1,38 @@
+
+inline ezProcessingStreamSoA3f::ezProcessingStreamSoA3f(const ezProcessingStream* pStream)
+{
+  EZ_ASSERT_DEV(pStream != nullptr, "Stream pointer may not be null!");
+  EZ_ASSERT_DEV(pStream->GetDataType() == ezProcessingStream::DataType::Float3SoA, "Stream '{0}' is not a Float3SoA stream", pStream->GetName().GetData());
+
+  const ptrdiff_t iArrayStride = static_cast<ptrdiff_t>(pStream->GetComponentArrayStride());
+
+  m_pX = pStream->GetWritableData<float>();
+  m_pY = static_cast<float*>(ezMemoryUtils::AddByteOffset(m_pX, iArrayStride));
+  m_pZ = static_cast<float*>(ezMemoryUtils::AddByteOffset(m_pX, iArrayStride * 2));
+}
+
+EZ_ALWAYS_INLINE ezVec3 ezProcessingStreamSoA3f::Get(ezUInt64 uiIndex) const
+{
+  return ezVec3(m_pX[uiIndex], m_pY[uiIndex], m_pZ[uiIndex]);
+}
+
+EZ_ALWAYS_INLINE void ezProcessingStreamSoA3f::Set(ezUInt64 uiIndex, const ezVec3& vValue) const
+{
+  m_pX[uiIndex] = vValue.x;
+  m_pY[uiIndex] = vValue.y;
+  m_pZ[uiIndex] = vValue.z;
+}
+
+EZ_ALWAYS_INLINE void ezProcessingStreamSoA3f::Load(ezUInt64 uiIndex, ezSimdVec4f& out_x, ezSimdVec4f& out_y, ezSimdVec4f& out_z) const
+{
+  out_x.Load<4>(m_pX + uiIndex);
+  out_y.Load<4>(m_pY + uiIndex);
+  out_z.Load<4>(m_pZ + uiIndex);
+}
+
+EZ_ALWAYS_INLINE void ezProcessingStreamSoA3f::Store(ezUInt64 uiIndex, const ezSimdVec4f& x, const ezSimdVec4f& y, const ezSimdVec4f& z) const
+{
+  x.Store<4>(m_pX + uiIndex);
+  y.Store<4>(m_pY + uiIndex);
+  z.Store<4>(m_pZ + uiIndex);
+}
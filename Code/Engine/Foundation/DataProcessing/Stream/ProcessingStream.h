@@ -39,9 +39,14 @@ public:
     Int,
     Int2,
     Int3,
-    Int4
+    Int4,
+
+    Float3SoA, // 3x float, stored as separate x, y and z arrays, see ezProcessingStreamSoA3f
   };
 
+  /// \brief The number of elements each component array of an SoA stream is padded to, so that SIMD loops never need a scalar tail.
+  static constexpr ezUInt32 SoAPadding = 4;
+
   /// \brief Returns a const pointer to the data casted to the type T, note that no type check is done!
   template <typename T>
   const T* GetData() const
@@ -71,7 +76,7 @@ public:
   /// \brief Returns the data type of the stream.
   DataType GetDataType() const { return m_Type; }
 
-  /// \brief Returns the size of one stream element.
+  /// \brief Returns the size of one stream element. For SoA streams this is the size of a single component.
   ezUInt64 GetElementSize() const { return m_uiTypeSize; }
 
   /// \brief Returns the stride between two elements of the stream.
@@ -81,6 +86,16 @@ public:
     return m_uiTypeSize;
   }
 
+  /// \brief Returns true if the components of the elements are stored in separate arrays (structure of arrays).
+  bool IsSoA() const { return m_Type == DataType::Float3SoA; }
+
+  /// \brief Returns how many separate component arrays the stream consists of, 1 for all non-SoA streams.
+  ezUInt32 GetNumComponentArrays() const { return IsSoA() ? 3 : 1; }
+
+  /// \brief Returns the byte offset between two component arrays of an SoA stream, 0 for all other streams.
+  ezUInt64 GetComponentArrayStride() const { return m_uiComponentArrayStride; }
+
+  /// \brief Returns the size of one element, for SoA types that is the size of one component.
   static size_t GetDataTypeSize(DataType Type);
 
 protected:
@@ -100,6 +115,8 @@ protected:
 
   ezUInt64 m_uiTypeSize;
 
+  ezUInt64 m_uiComponentArrayStride;
+
   DataType m_Type;
 
   ezHashedString m_Name;
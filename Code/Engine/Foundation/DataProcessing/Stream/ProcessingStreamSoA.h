@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+
+/// \brief Helper class to access the data of an ezProcessingStream::DataType::Float3SoA stream.
+///
+/// The x, y and z components are stored in three separate float arrays. Each array is padded to a multiple of
+/// ezProcessingStream::SoAPadding elements, so Load() and Store() can always work on full groups of four elements,
+/// even if the number of active elements is not a multiple of four. The values in the padding are undefined.
+class ezProcessingStreamSoA3f
+{
+public:
+  /// \brief Creates an accessor without any data, must be assigned before use.
+  ezProcessingStreamSoA3f() = default;
+
+  /// \brief Creates an accessor for the given Float3SoA stream.
+  explicit ezProcessingStreamSoA3f(const ezProcessingStream* pStream);
+
+  /// \brief Returns the array with the x components of all elements.
+  float* GetX() const { return m_pX; }
+
+  /// \brief Returns the array with the y components of all elements.
+  float* GetY() const { return m_pY; }
+
+  /// \brief Returns the array with the z components of all elements.
+  float* GetZ() const { return m_pZ; }
+
+  /// \brief Returns the element at the given index.
+  ezVec3 Get(ezUInt64 uiIndex) const;
+
+  /// \brief Writes the element at the given index.
+  void Set(ezUInt64 uiIndex, const ezVec3& vValue) const;
+
+  /// \brief Loads the four elements starting at uiIndex, one SIMD register per component.
+  void Load(ezUInt64 uiIndex, ezSimdVec4f& out_x, ezSimdVec4f& out_y, ezSimdVec4f& out_z) const;
+
+  /// \brief Stores four elements starting at uiIndex, one SIMD register per component.
+  void Store(ezUInt64 uiIndex, const ezSimdVec4f& x, const ezSimdVec4f& y, const ezSimdVec4f& z) const;
+
+  /// \brief Returns the number of elements that have to be processed to cover uiNumElements with full groups of four.
+  static ezUInt64 GetPaddedCount(ezUInt64 uiNumElements) { return ezMemoryUtils::AlignSize<ezUInt64>(uiNumElements, ezProcessingStream::SoAPadding); }
+
+private:
+  float* m_pX = nullptr;
+  float* m_pY = nullptr;
+  float* m_pZ = nullptr;
+};
+
+#include <Foundation/DataProcessing/Stream/Implementation/ProcessingStreamSoA_inl.h>
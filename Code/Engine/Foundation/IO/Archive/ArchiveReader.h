@@ -30,6 +30,9 @@ public:
   /// \brief Sets up \a memReader for reading the raw (potentially compressed) data that is stored for the given entry in the archive.
   void ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& memReader) const;
 
+  /// \brief Returns a pointer to the raw (potentially compressed) data that is stored for the given entry in the memory mapped archive.
+  const void* GetEntryRawData(ezUInt32 uiEntryIdx) const;
+
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
@@ -69,6 +69,9 @@ namespace ezDataDirectory
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
 
+    /// \brief Returns the entry data inside the memory mapped archive. Only available for entries that are stored uncompressed.
+    virtual const void* GetMappedContent() override;
+
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
@@ -77,6 +80,7 @@ namespace ezDataDirectory
 
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
+    const void* m_pMappedContent = nullptr; ///< Only set for uncompressed entries.
     ezRawMemoryStreamReader m_MemStreamReader;
   };
 
@@ -121,6 +121,11 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
   ezArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, memReader);
 }
 
+const void* ezArchiveReader::GetEntryRawData(ezUInt32 uiEntryIdx) const
+{
+  return ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(m_ArchiveTOC.m_Entries[uiEntryIdx].m_uiDataStartOffset));
+}
+
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
   return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
@@ -115,6 +115,11 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(const char*
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
 
+  if (pEntry->m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+    pReader->m_pMappedContent = m_ArchiveReader.GetEntryRawData(uiEntryIndex);
+  else
+    pReader->m_pMappedContent = nullptr;
+
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
     EZ_DEFAULT_DELETE(pReader);
@@ -272,6 +277,11 @@ ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
   return m_uiUncompressedSize;
 }
 
+const void* ezDataDirectory::ArchiveReaderUncompressed::GetMappedContent()
+{
+  return m_pMappedContent;
+}
+
 ezResult ezDataDirectory::ArchiveReaderUncompressed::InternalOpen(ezFileShareMode::Enum FileShareMode)
 {
   EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
@@ -4,6 +4,7 @@
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/IO/OSFile.h>
 
 namespace ezDataDirectory
@@ -86,6 +87,9 @@ namespace ezDataDirectory
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
 
+    /// \brief Maps the file into memory on first use, if the platform supports memory mapped files.
+    virtual const void* GetMappedContent() override;
+
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
@@ -94,6 +98,7 @@ namespace ezDataDirectory
 
     bool m_bIsInUse;
     ezOSFile m_File;
+    ezMemoryMappedFile m_MappedFile;
   };
 
   /// \brief Handles writing to ordinary files.
@@ -163,6 +163,12 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief Returns a pointer to the entire (uncompressed) file content, if the data directory can provide it without copying,
+  /// e.g. through a memory mapped file. The returned memory is GetFileSize() bytes large and stays valid until the reader is closed.
+  ///
+  /// The default implementation returns nullptr, in which case the file can only be accessed through Read().
+  virtual const void* GetMappedContent() { return nullptr; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
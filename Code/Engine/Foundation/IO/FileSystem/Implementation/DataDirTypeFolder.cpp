@@ -32,12 +32,35 @@ namespace ezDataDirectory
     return m_File.Open(sPath.GetData(), ezFileOpenMode::Read, FileShareMode);
   }
 
-  void FolderReader::InternalClose() { m_File.Close(); }
+  void FolderReader::InternalClose()
+  {
+    m_MappedFile.Close();
+    m_File.Close();
+  }
 
   ezUInt64 FolderReader::Read(void* pBuffer, ezUInt64 uiBytes) { return m_File.Read(pBuffer, uiBytes); }
 
   ezUInt64 FolderReader::GetFileSize() const { return m_File.GetFileSize(); }
 
+  const void* FolderReader::GetMappedContent()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    if (m_MappedFile.GetMode() == ezMemoryMappedFile::Mode::None)
+    {
+      // empty files cannot be mapped
+      if (m_File.GetFileSize() == 0)
+        return nullptr;
+
+      if (m_MappedFile.Open(m_File.GetOpenFileName(), ezMemoryMappedFile::Mode::ReadOnly).Failed())
+        return nullptr;
+    }
+
+    return m_MappedFile.GetReadPointer();
+#else
+    return nullptr;
+#endif
+  }
+
   ezResult FolderWriter::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
     ezStringBuilder sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
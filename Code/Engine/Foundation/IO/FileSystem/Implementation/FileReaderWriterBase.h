@@ -36,6 +36,12 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns a pointer to the entire file content, if the data directory can map it into memory, otherwise nullptr.
+  ///
+  /// The memory is independent of the current read position and stays valid until the file is closed.
+  /// \sa ezDataDirectoryReader::GetMappedContent()
+  const void* GetMappedContent() { return m_pDataDirReader->GetMappedContent(); }
+
 protected:
   ezDataDirectoryReader* GetFileReader(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
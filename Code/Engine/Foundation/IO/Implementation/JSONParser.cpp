@@ -8,23 +8,28 @@ ezJSONParser::ezJSONParser()
 {
   m_uiCurByte = '\0';
   m_uiNextByte = '\0';
-  m_pInput = nullptr;
   m_bSkippingMode = false;
   m_pLogInterface = nullptr;
-  m_uiCurLine = 1;
-  m_uiCurColumn = 0;
 }
 
 void ezJSONParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset)
+{
+  m_Input.SetStream(stream, uiFirstLineOffset);
+  StartInput();
+}
+
+void ezJSONParser::SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  m_Input.SetBuffer(data, uiFirstLineOffset);
+  StartInput();
+}
+
+void ezJSONParser::StartInput()
 {
   m_StateStack.Clear();
   m_uiCurByte = '\0';
   m_TempString.Clear();
   m_bSkippingMode = false;
-  m_uiCurLine = 1 + uiFirstLineOffset;
-  m_uiCurColumn = 0;
-
-  m_pInput = &stream;
 
   m_uiNextByte = ' ';
   ReadCharacter(true);
@@ -100,11 +105,11 @@ void ezJSONParser::ParsingError(const char* szMessage, bool bFatal)
   }
 
   if (bFatal)
-    ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", m_uiCurLine, m_uiCurColumn, szMessage);
+    ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", m_Input.GetLine(), m_Input.GetColumn(), szMessage);
   else
     ezLog::Warning(m_pLogInterface, szMessage);
 
-  OnParsingError(szMessage, bFatal, m_uiCurLine, m_uiCurColumn);
+  OnParsingError(szMessage, bFatal, m_Input.GetLine(), m_Input.GetColumn());
 }
 
 void ezJSONParser::SkipObject()
@@ -459,15 +464,7 @@ void ezJSONParser::ContinueSeparator()
 
 void ezJSONParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
-
-  if (m_uiNextByte == '\n')
-  {
-    ++m_uiCurLine;
-    m_uiCurColumn = 0;
-  }
-  else
-    ++m_uiCurColumn;
+  m_uiNextByte = m_Input.ReadByte();
 }
 
 bool ezJSONParser::ReadCharacter(bool bSkipComments)
@@ -517,10 +514,14 @@ bool ezJSONParser::ReadCharacter(bool bSkipComments)
 
 void ezJSONParser::SkipWhitespace()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsValid(), "Input Stream is not set up.");
 
   do
   {
+    // skip the rest of a longer run of whitespace at once, the lookahead byte still gets processed as usual
+    if (ezStringUtils::IsWhiteSpace(m_uiNextByte))
+      m_Input.SkipBufferedWhitespace();
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(true))
@@ -530,7 +531,7 @@ void ezJSONParser::SkipWhitespace()
 
 void ezJSONParser::SkipString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsValid(), "Input Stream is not set up.");
 
   m_TempString.Clear();
   m_TempString.PushBack('\0');
@@ -541,6 +542,16 @@ void ezJSONParser::SkipString()
   {
     bEscapeSequence = (m_uiCurByte == '\\');
 
+    if (!bEscapeSequence && ezInternal::TextParserInput::IsPlainStringCharacter(m_uiNextByte))
+    {
+      // skip all characters up to the next special one at once
+      m_Input.ReadBufferedStringRun();
+
+      m_uiCurByte = m_uiNextByte;
+      ReadNextByte();
+      continue;
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(false))
@@ -554,7 +565,7 @@ void ezJSONParser::SkipString()
 
 void ezJSONParser::ReadString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsValid(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -564,6 +575,17 @@ void ezJSONParser::ReadString()
   {
     bEscapeSequence = (m_uiCurByte == '\\');
 
+    if (!bEscapeSequence && ezInternal::TextParserInput::IsPlainStringCharacter(m_uiNextByte))
+    {
+      // copy all characters up to the next special one at once
+      m_TempString.PushBack(m_uiNextByte);
+      m_TempString.PushBackRange(m_Input.ReadBufferedStringRun());
+
+      m_uiCurByte = m_uiNextByte;
+      ReadNextByte();
+      continue;
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(false))
@@ -678,7 +700,7 @@ void ezJSONParser::ReadString()
 
 void ezJSONParser::ReadWord()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsValid(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -697,13 +719,16 @@ void ezJSONParser::ReadWord()
 
 double ezJSONParser::ReadNumber()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsValid(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
+  ezInternal::TextParserNumber number;
+
   do
   {
     m_TempString.PushBack(m_uiCurByte);
+    number.AddCharacter(m_uiCurByte);
 
     m_uiCurByte = '\0';
 
@@ -715,6 +740,9 @@ double ezJSONParser::ReadNumber()
   m_TempString.PushBack('\0');
 
   double fResult = 0;
+  if (number.GetValue(fResult))
+    return fResult;
+
   if (ezConversionUtils::StringToFloat((const char*)&m_TempString[0], fResult) == EZ_FAILURE)
   {
     ezStringBuilder s;
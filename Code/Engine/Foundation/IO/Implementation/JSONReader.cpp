@@ -9,13 +9,30 @@ ezJSONReader::ezJSONReader()
 }
 
 ezResult ezJSONReader::Parse(ezStreamReader& InputStream, ezUInt32 uiFirstLineOffset)
+{
+  ResetState();
+  SetInputStream(InputStream, uiFirstLineOffset);
+
+  return ParseInput();
+}
+
+ezResult ezJSONReader::Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  ResetState();
+  SetInputBuffer(data, uiFirstLineOffset);
+
+  return ParseInput();
+}
+
+void ezJSONReader::ResetState()
 {
   m_bParsingError = false;
   m_Stack.Clear();
   m_sLastName.Clear();
+}
 
-  SetInputStream(InputStream, uiFirstLineOffset);
-
+ezResult ezJSONReader::ParseInput()
+{
   while (!m_bParsingError && ContinueParsing())
   {
   }
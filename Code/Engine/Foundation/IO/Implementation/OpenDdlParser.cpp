@@ -40,11 +40,21 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
 {
   EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
 
-  m_pInput = &stream;
+  m_Input.SetStream(stream, uiFirstLineOffset);
+  StartInput();
+}
+
+void ezOpenDdlParser::SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
 
+  m_Input.SetBuffer(data, uiFirstLineOffset);
+  StartInput();
+}
+
+void ezOpenDdlParser::StartInput()
+{
   m_bSkippingMode = false;
-  m_uiCurLine = 1 + uiFirstLineOffset;
-  m_uiCurColumn = 0;
   m_uiCurByte = '\0';
   m_uiNumCachedPrimitives = 0;
 
@@ -168,11 +178,11 @@ void ezOpenDdlParser::StopParsing()
 void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 {
   if (bFatal)
-    ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", m_uiCurLine, m_uiCurColumn, szMessage);
+    ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", m_Input.GetLine(), m_Input.GetColumn(), szMessage);
   else
     ezLog::Warning(m_pLogInterface, szMessage);
 
-  OnParsingError(szMessage, bFatal, m_uiCurLine, m_uiCurColumn);
+  OnParsingError(szMessage, bFatal, m_Input.GetLine(), m_Input.GetColumn());
 
   if (bFatal)
   {
@@ -185,15 +195,7 @@ void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
-
-  if (m_uiNextByte == '\n')
-  {
-    ++m_uiCurLine;
-    m_uiCurColumn = 0;
-  }
-  else
-    ++m_uiCurColumn;
+  m_uiNextByte = m_Input.ReadByte();
 }
 
 bool ezOpenDdlParser::ReadCharacter()
@@ -255,6 +257,10 @@ void ezOpenDdlParser::SkipWhitespace()
 {
   do
   {
+    // skip the rest of a longer run of whitespace at once, the lookahead byte still gets processed as usual
+    if (ezStringUtils::IsWhiteSpace(m_uiNextByte))
+      m_Input.SkipBufferedWhitespace();
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacterSkipComments())
@@ -597,6 +603,27 @@ void ezOpenDdlParser::ReadString()
   {
     const bool bEscapeSequence = (m_uiCurByte == '\\');
 
+    if (!bEscapeSequence && ezInternal::TextParserInput::IsPlainStringCharacter(m_uiNextByte))
+    {
+      // copy all characters up to the next special one at once
+      const ezArrayPtr<const ezUInt8> run = m_Input.ReadBufferedStringRun();
+
+      while (m_uiTempStringLength + run.GetCount() + 3 >= m_TempString.GetCount())
+      {
+        m_TempString.SetCountUninitialized(m_TempString.GetCount() * 2);
+      }
+
+      m_TempString[m_uiTempStringLength] = m_uiNextByte;
+      ++m_uiTempStringLength;
+
+      ezMemoryUtils::Copy(&m_TempString[m_uiTempStringLength], run.GetPtr(), run.GetCount());
+      m_uiTempStringLength += run.GetCount();
+
+      m_uiCurByte = m_uiNextByte;
+      ReadNextByte();
+      continue;
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter())
@@ -835,6 +862,16 @@ void ezOpenDdlParser::SkipString()
   {
     bEscapeSequence = (m_uiCurByte == '\\');
 
+    if (!bEscapeSequence && ezInternal::TextParserInput::IsPlainStringCharacter(m_uiNextByte))
+    {
+      // skip all characters up to the next special one at once
+      m_Input.ReadBufferedStringRun();
+
+      m_uiCurByte = m_uiNextByte;
+      ReadNextByte();
+      continue;
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter())
@@ -1104,9 +1141,10 @@ void ezOpenDdlParser::ContinueFloat()
   else if ((m_uiCurByte >= '0' && m_uiCurByte <= '9') || m_uiCurByte == '.')
   {
     // Decimal literal
-    ReadDecimalFloat();
+    ezInternal::TextParserNumber number;
+    ReadDecimalFloat(number);
 
-    if (ezConversionUtils::StringToFloat((const char*)&m_TempString[0], dValue) == EZ_FAILURE)
+    if (!number.GetValue(dValue) && ezConversionUtils::StringToFloat((const char*)&m_TempString[0], dValue) == EZ_FAILURE)
     {
       ezStringBuilder s;
       s.Format("Reading number failed: Could not convert '{0}' to a floating point value.", (const char*)&m_TempString[0]);
@@ -1149,7 +1187,7 @@ void ezOpenDdlParser::ContinueFloat()
   }
 }
 
-void ezOpenDdlParser::ReadDecimalFloat()
+void ezOpenDdlParser::ReadDecimalFloat(ezInternal::TextParserNumber& out_Number)
 {
   m_uiTempStringLength = 0;
 
@@ -1158,6 +1196,8 @@ void ezOpenDdlParser::ReadDecimalFloat()
     m_TempString[m_uiTempStringLength] = m_uiCurByte;
     ++m_uiTempStringLength;
 
+    out_Number.AddCharacter(m_uiCurByte);
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacterSkipComments())
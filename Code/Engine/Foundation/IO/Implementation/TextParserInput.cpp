@@ -0,0 +1,236 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/Implementation/TextParserInput.h>
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  include <emmintrin.h>
+#endif
+
+namespace ezInternal
+{
+  enum
+  {
+    TextParserChunkSize = 16 * 1024,
+  };
+
+  void TextParserInput::SetStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset)
+  {
+    if (m_Buffer.IsEmpty())
+      m_Buffer.SetCountUninitialized(TextParserChunkSize);
+
+    m_bValid = true;
+    m_pStream = &stream;
+    m_pCur = nullptr;
+    m_pEnd = nullptr;
+    m_uiLine = 1 + uiFirstLineOffset;
+    m_uiColumn = 0;
+  }
+
+  void TextParserInput::SetBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+  {
+    m_bValid = true;
+    m_pStream = nullptr;
+    m_pCur = data.GetPtr();
+    m_pEnd = data.GetPtr() + data.GetCount();
+    m_uiLine = 1 + uiFirstLineOffset;
+    m_uiColumn = 0;
+  }
+
+  bool TextParserInput::Refill()
+  {
+    if (m_pStream == nullptr)
+      return false;
+
+    const ezUInt64 uiNumRead = m_pStream->ReadBytes(m_Buffer.GetData(), m_Buffer.GetCount());
+
+    m_pCur = m_Buffer.GetData();
+    m_pEnd = m_pCur + uiNumRead;
+
+    return uiNumRead > 0;
+  }
+
+  void TextParserInput::SkipBufferedWhitespace()
+  {
+    const ezUInt8* pCur = m_pCur;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+    const __m128i vZero = _mm_setzero_si128();
+    const __m128i vSpace = _mm_set1_epi8(' ');
+    const __m128i vLineBreak = _mm_set1_epi8('\n');
+
+    while (m_pEnd - pCur >= 16)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+
+      // same as ezStringUtils::IsWhiteSpace(), all bytes from 1 to 32
+      const __m128i vWhitespace = _mm_andnot_si128(_mm_cmpeq_epi8(v, vZero), _mm_cmpeq_epi8(_mm_min_epu8(v, vSpace), v));
+
+      const ezUInt32 uiOther = ~static_cast<ezUInt32>(_mm_movemask_epi8(vWhitespace)) & 0xFFFFu;
+      const ezUInt32 uiNumSkipped = uiOther != 0 ? ezMath::CountTrailingZeros(uiOther) : 16;
+      const ezUInt32 uiLineBreaks = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vLineBreak))) & ((1u << uiNumSkipped) - 1);
+
+      if (uiLineBreaks != 0)
+      {
+        m_uiLine += ezMath::CountBits(uiLineBreaks);
+        m_uiColumn = uiNumSkipped - 1 - ezMath::FirstBitHigh(uiLineBreaks);
+      }
+      else
+      {
+        m_uiColumn += uiNumSkipped;
+      }
+
+      pCur += uiNumSkipped;
+
+      if (uiOther != 0)
+      {
+        m_pCur = pCur;
+        return;
+      }
+    }
+#endif
+
+    // same as ezStringUtils::IsWhiteSpace()
+    while (pCur != m_pEnd && *pCur >= 1 && *pCur <= 32)
+    {
+      if (*pCur == '\n')
+      {
+        ++m_uiLine;
+        m_uiColumn = 0;
+      }
+      else
+        ++m_uiColumn;
+
+      ++pCur;
+    }
+
+    m_pCur = pCur;
+  }
+
+  ezArrayPtr<const ezUInt8> TextParserInput::ReadBufferedStringRun()
+  {
+    const ezUInt8* pStart = m_pCur;
+    const ezUInt8* pCur = m_pCur;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+    const __m128i vQuote = _mm_set1_epi8('\"');
+    const __m128i vBackslash = _mm_set1_epi8('\\');
+    const __m128i vLineBreak = _mm_set1_epi8('\n');
+    const __m128i vZero = _mm_setzero_si128();
+
+    while (m_pEnd - pCur >= 16)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+      const __m128i vSpecial =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, vQuote), _mm_cmpeq_epi8(v, vBackslash)), _mm_or_si128(_mm_cmpeq_epi8(v, vLineBreak), _mm_cmpeq_epi8(v, vZero)));
+
+      const ezUInt32 uiSpecial = static_cast<ezUInt32>(_mm_movemask_epi8(vSpecial));
+
+      if (uiSpecial != 0)
+      {
+        pCur += ezMath::CountTrailingZeros(uiSpecial);
+        break;
+      }
+
+      pCur += 16;
+    }
+#endif
+
+    while (pCur != m_pEnd && IsPlainStringCharacter(*pCur))
+    {
+      ++pCur;
+    }
+
+    const ezUInt32 uiCount = static_cast<ezUInt32>(pCur - pStart);
+
+    m_uiColumn += uiCount;
+    m_pCur = pCur;
+
+    return ezArrayPtr<const ezUInt8>(pStart, uiCount);
+  }
+
+  void TextParserNumber::AddNonDigit(ezUInt8 c)
+  {
+    switch (c)
+    {
+      case '.':
+        if (m_Part != Part::Integer)
+          m_bValid = false;
+
+        m_Part = Part::Fraction;
+        return;
+
+      case 'e':
+      case 'E':
+        if (m_Part == Part::Exponent || !m_bHasDigits)
+          m_bValid = false;
+
+        m_Part = Part::Exponent;
+        return;
+
+      case '+':
+      case '-':
+        if (m_Part == Part::Exponent)
+        {
+          if (m_bHasExponentSign || m_bHasExponentDigits)
+            m_bValid = false;
+
+          m_bHasExponentSign = true;
+          m_bNegativeExponent = (c == '-');
+        }
+        else
+        {
+          if (m_bHasSign || m_bHasDigits || m_Part != Part::Integer)
+            m_bValid = false;
+
+          m_bHasSign = true;
+          m_bNegative = (c == '-');
+        }
+        return;
+
+      case '_':
+        // allowed for readability, same as in ezConversionUtils::StringToFloat()
+        return;
+
+      default:
+        m_bValid = false;
+        return;
+    }
+  }
+
+  bool TextParserNumber::GetValue(double& out_fValue) const
+  {
+    // all powers of ten up to 10^22 are exactly representable as a double
+    static constexpr double s_PowersOf10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    if (!m_bValid || !m_bHasDigits || (m_Part == Part::Exponent && !m_bHasExponentDigits))
+      return false;
+
+    // larger mantissas are not exactly representable
+    if (m_uiMantissa > (1ull << 53))
+      return false;
+
+    double fValue = static_cast<double>(m_uiMantissa);
+
+    if (m_uiMantissa != 0)
+    {
+      const ezInt32 iExponent = m_iMantissaExponent + (m_bNegativeExponent ? -static_cast<ezInt32>(m_uiExponent) : static_cast<ezInt32>(m_uiExponent));
+
+      if (iExponent < -22 || iExponent > 22)
+        return false;
+
+      // both operands are exact, so the result is correctly rounded
+      if (iExponent < 0)
+        fValue /= s_PowersOf10[-iExponent];
+      else
+        fValue *= s_PowersOf10[iExponent];
+    }
+
+    out_fValue = m_bNegative ? -fValue : fValue;
+    return true;
+  }
+} // namespace ezInternal
+
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_TextParserInput);
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+namespace ezInternal
+{
+  /// \brief The input of ezJSONParser and ezOpenDdlParser.
+  ///
+  /// The parsers look at their input one byte at a time. Instead of calling ezStreamReader::ReadBytes() for every single byte, the stream is
+  /// read in large chunks. Alternatively a contiguous buffer, e.g. a memory mapped file, is parsed in place without copying it at all.
+  /// Runs of whitespace and of plain string characters are skipped 16 bytes at a time.
+  /// The line and column of the last byte that was read are tracked for error messages.
+  class EZ_FOUNDATION_DLL TextParserInput
+  {
+  public:
+    /// \brief Reads from the given stream in large chunks.
+    void SetStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset);
+
+    /// \brief Reads directly from the given memory, which has to stay valid until parsing has finished.
+    void SetBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset);
+
+    /// \brief Whether SetStream() or SetBuffer() has been called.
+    bool IsValid() const { return m_bValid; }
+
+    /// \brief Returns the next byte, or '\0' at the end of the input.
+    EZ_ALWAYS_INLINE ezUInt8 ReadByte()
+    {
+      if (m_pCur == m_pEnd && !Refill())
+      {
+        ++m_uiColumn;
+        return '\0';
+      }
+
+      const ezUInt8 uiByte = *m_pCur++;
+
+      if (uiByte == '\n')
+      {
+        ++m_uiLine;
+        m_uiColumn = 0;
+      }
+      else
+        ++m_uiColumn;
+
+      return uiByte;
+    }
+
+    /// \brief Skips the whitespace at the read position, as far as it is already buffered. Does not read any new data from the stream.
+    void SkipBufferedWhitespace();
+
+    /// \brief Returns and consumes the buffered bytes at the read position for which IsPlainStringCharacter() is true.
+    ///
+    /// The returned memory stays valid until the next call to ReadByte().
+    ezArrayPtr<const ezUInt8> ReadBufferedStringRun();
+
+    /// \brief Returns true for all characters that the parsers copy into strings unchanged. Line breaks are excluded so that they can be counted.
+    EZ_ALWAYS_INLINE static bool IsPlainStringCharacter(ezUInt8 uiByte)
+    {
+      return uiByte != '\"' && uiByte != '\\' && uiByte != '\n' && uiByte != '\0';
+    }
+
+    ezUInt32 GetLine() const { return m_uiLine; }
+    ezUInt32 GetColumn() const { return m_uiColumn; }
+
+  private:
+    bool Refill();
+
+    bool m_bValid = false;
+    ezStreamReader* m_pStream = nullptr;
+    const ezUInt8* m_pCur = nullptr;
+    const ezUInt8* m_pEnd = nullptr;
+    ezUInt32 m_uiLine = 1;
+    ezUInt32 m_uiColumn = 0;
+    ezDynamicArray<ezUInt8> m_Buffer;
+  };
+
+  /// \brief Converts a decimal number to a double while the parsers read it character by character.
+  ///
+  /// Numbers whose significant digits fit into 53 bits and whose decimal exponent is at most 22 are converted exactly with a single
+  /// multiplication or division, without another pass over the text. For everything else, and for malformed numbers, GetValue() fails and
+  /// the parsers fall back to ezConversionUtils::StringToFloat().
+  class EZ_FOUNDATION_DLL TextParserNumber
+  {
+  public:
+    /// \brief Passes the next character of the number, e.g. a digit, a sign, a decimal point or an exponent.
+    EZ_ALWAYS_INLINE void AddCharacter(ezUInt8 c)
+    {
+      if (c < '0' || c > '9')
+      {
+        AddNonDigit(c);
+        return;
+      }
+
+      const ezUInt32 uiDigit = static_cast<ezUInt32>(c - '0');
+
+      if (m_Part == Part::Exponent)
+      {
+        m_bHasExponentDigits = true;
+
+        // anything this large is out of range anyway
+        if (m_uiExponent < 10000)
+          m_uiExponent = m_uiExponent * 10 + uiDigit;
+
+        return;
+      }
+
+      m_bHasDigits = true;
+
+      if (m_uiNumSignificantDigits == MaxSignificantDigits)
+      {
+        m_bValid = false;
+        return;
+      }
+
+      // leading zeros are not significant
+      if (m_uiMantissa != 0 || uiDigit != 0)
+      {
+        m_uiMantissa = m_uiMantissa * 10 + uiDigit;
+        ++m_uiNumSignificantDigits;
+      }
+
+      if (m_Part == Part::Fraction)
+        --m_iMantissaExponent;
+    }
+
+    /// \brief Returns the exact value of the number, or false if it has to be converted with ezConversionUtils::StringToFloat() instead.
+    bool GetValue(double& out_fValue) const;
+
+  private:
+    enum class Part : ezUInt8
+    {
+      Integer,
+      Fraction,
+      Exponent,
+    };
+
+    enum
+    {
+      MaxSignificantDigits = 19,
+    };
+
+    void AddNonDigit(ezUInt8 c);
+
+    ezUInt64 m_uiMantissa = 0;
+    ezInt32 m_iMantissaExponent = 0;
+    ezUInt32 m_uiNumSignificantDigits = 0;
+    ezUInt32 m_uiExponent = 0;
+    Part m_Part = Part::Integer;
+    bool m_bValid = true;
+    bool m_bNegative = false;
+    bool m_bHasSign = false;
+    bool m_bHasDigits = false;
+    bool m_bNegativeExponent = false;
+    bool m_bHasExponentSign = false;
+    bool m_bHasExponentDigits = false;
+  };
+} // namespace ezInternal
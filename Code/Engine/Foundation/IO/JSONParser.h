@@ -2,6 +2,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/IO/Implementation/TextParserInput.h>
 #include <Foundation/IO/Stream.h>
 
 class ezLogInterface;
@@ -22,8 +23,15 @@ public:
 
 protected:
   /// \brief Resets the parser to the start state and configures it to read from the given stream.
+  ///
+  /// The stream is read in large chunks, so it may be read further than the end of the JSON document.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Resets the parser to the start state and configures it to parse the given memory in place, e.g. a memory mapped file.
+  ///
+  /// The memory has to stay valid until parsing has finished. This is the fastest way to parse large documents.
+  void SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Does one parsing step.
   ///
   /// While this function returns true, the document has not been parsed completely.
@@ -133,13 +141,12 @@ private:
   void ReadNextByte();
 
   void SkipStack(State s);
+  void StartInput();
 
   ezUInt8 m_uiCurByte;
   ezUInt8 m_uiNextByte;
-  ezUInt32 m_uiCurLine;
-  ezUInt32 m_uiCurColumn;
 
-  ezStreamReader* m_pInput;
+  ezInternal::TextParserInput m_Input;
   ezHybridArray<JSONState, 32> m_StateStack;
   ezHybridArray<ezUInt8, 4096> m_TempString;
 
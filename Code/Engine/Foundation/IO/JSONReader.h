@@ -19,6 +19,11 @@ public:
   /// error occurred.
   ezResult Parse(ezStreamReader& pInput, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Same as above, but parses the given memory in place, e.g. a memory mapped file, instead of reading from a stream.
+  ///
+  /// This is the fastest way to parse large documents. The memory only has to stay valid during this call.
+  ezResult Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Returns the top-level object of the JSON document.
   const ezVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -53,6 +58,9 @@ private:
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
 protected:
+  void ResetState();
+  ezResult ParseInput();
+
   enum class ElementMode : ezInt8
   {
     Array,
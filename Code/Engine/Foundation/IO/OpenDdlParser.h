@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/IO/Implementation/TextParserInput.h>
 #include <Foundation/IO/Stream.h>
 
 class ezLogInterface;
@@ -52,8 +53,15 @@ protected:
   void SetCacheSize(ezUInt32 uiSizeInKB);
 
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
+  ///
+  /// The stream is read in large chunks, so it may be read further than the end of the DDL document.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
+  /// \brief Configures the parser to parse the given memory in place, e.g. a memory mapped file. This can only be called once on a parser instance.
+  ///
+  /// The memory has to stay valid until parsing has finished. This is the fastest way to parse large documents.
+  void SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
   ///
   /// This function returns false when the end of the document has been reached, or a fatal parsing error has been reported.
@@ -177,19 +185,19 @@ private:
   void ContinueInt();
   void ContinueFloat();
 
-  void ReadDecimalFloat();
+  void ReadDecimalFloat(ezInternal::TextParserNumber& out_Number);
   void ReadHexString();
 
+  void StartInput();
+
   ezHybridArray<DdlState, 32> m_StateStack;
-  ezStreamReader* m_pInput;
+  ezInternal::TextParserInput m_Input;
   ezDynamicArray<ezUInt8> m_Cache;
 
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
 
   ezUInt8 m_uiCurByte;
   ezUInt8 m_uiNextByte;
-  ezUInt32 m_uiCurLine;
-  ezUInt32 m_uiCurColumn;
   bool m_bSkippingMode;
   bool m_bHadFatalParsingError;
   ezUInt8 m_szIdentifierType[s_uiMaxIdentifierLength];
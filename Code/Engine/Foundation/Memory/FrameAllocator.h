@@ -21,11 +21,89 @@ private:
   StackAllocatorType* m_pOtherAllocator;
 };
 
+/// \brief A bump pointer allocator that is only ever used by a single thread, so it needs no synchronization.
+///
+/// Individual deallocations don't free any memory. All memory is reclaimed at once by Reset(), which also calls the destructors
+/// of all objects that were created with EZ_NEW and not deleted yet. The memory chunks are kept for the next frame.
+class EZ_FOUNDATION_DLL ezFrameAllocatorLane : public ezAllocatorBase
+{
+public:
+  ezFrameAllocatorLane(const char* szName, ezAllocatorBase* pParent);
+  ~ezFrameAllocatorLane();
+
+  // ezAllocatorBase implementation
+  virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc = nullptr) override;
+  virtual void Deallocate(void* ptr) override;
+  virtual size_t AllocatedSize(const void* ptr) override { return 0; }
+  virtual ezAllocatorId GetId() const override { return m_Id; }
+  virtual Stats GetStats() const override;
+
+  /// \brief Frees all allocations. Must not be called while the owning thread still allocates.
+  void Reset();
+
+  /// \brief Number of bytes that were allocated since the last Reset.
+  ezUInt64 GetCurrentUsage() const { return m_uiCurrentUsage; }
+
+  /// \brief The highest number of bytes that were allocated between two calls to Reset.
+  ezUInt64 GetPeakUsage() const { return ezMath::Max(m_uiPeakUsage, m_uiCurrentUsage); }
+
+private:
+  struct Chunk;
+  struct AllocationHeader;
+
+  void* AllocateFromNextChunk(size_t uiSize, size_t uiAlign);
+
+  ezAllocatorBase* m_pParent;
+  ezAllocatorId m_Id;
+
+  Chunk* m_pFirstChunk = nullptr;
+  Chunk* m_pCurrentChunk = nullptr;
+  ezUInt8* m_pNextAllocation = nullptr;
+  ezUInt8* m_pChunkEnd = nullptr;
+
+  AllocationHeader* m_pDestructibleAllocations = nullptr;
+
+  ezUInt64 m_uiNumAllocations = 0;
+  ezUInt64 m_uiCurrentUsage = 0;
+  ezUInt64 m_uiPeakUsage = 0;
+  ezUInt64 m_uiReservedMemory = 0;
+};
+
+/// \brief Provides memory that is only valid for the current and the next frame.
+///
+/// GetCurrentAllocator() returns a shared allocator that may be used from any thread, but it takes a lock for every allocation.
+/// GetThreadAllocator() returns an allocator that only belongs to the calling thread and thus doesn't need any synchronization.
+/// This should be preferred in tasks. Neither allocator may be used by tasks that are still running while Swap() is called.
 class EZ_FOUNDATION_DLL ezFrameAllocator
 {
 public:
+  enum
+  {
+    MaxThreadLanes = 64,
+  };
+
+  struct LaneStats
+  {
+    ezUInt64 m_uiCurrentUsage = 0; ///< bytes allocated in the current frame
+    ezUInt64 m_uiPeakUsage = 0;    ///< the maximum number of bytes that were allocated in one frame
+  };
+
+  /// \brief Returns the shared frame allocator which can be used from all threads.
   EZ_ALWAYS_INLINE static ezAllocatorBase* GetCurrentAllocator() { return s_pAllocator->GetCurrentAllocator(); }
 
+  /// \brief Returns the frame allocator lane of the calling thread.
+  ///
+  /// The returned allocator must only be used on the calling thread. Memory allocated from it can be read by other threads, though.
+  /// If all lanes are already taken by other threads, the shared allocator is returned.
+  /// The lane is given back when the thread exits and may then be handed out to another thread.
+  static ezAllocatorBase* GetThreadAllocator();
+
+  /// \brief Returns the number of thread lanes that have been created so far. Lanes of exited threads are reused, so this doesn't grow with every thread.
+  static ezUInt32 GetNumThreadLanes();
+
+  /// \brief Returns usage stats of the given thread lane.
+  static LaneStats GetThreadLaneStats(ezUInt32 uiLaneIndex);
+
   static void Swap();
   static void Reset();
 
@@ -35,5 +113,11 @@ private:
   static void Startup();
   static void Shutdown();
 
+  static ezAllocatorBase* CreateThreadLane();
+
   static ezDoubleBufferedStackAllocator* s_pAllocator;
+
+  static ezFrameAllocatorLane* s_ThreadLanes[MaxThreadLanes][2];
+  static ezInt32 s_iNumThreadLanes;
+  static ezUInt32 s_uiCurrentLaneBuffer;
 };
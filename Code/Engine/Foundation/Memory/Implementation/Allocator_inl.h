@@ -73,18 +73,23 @@ void* ezInternal::ezAllocatorImpl<A, TrackingFlags>::Allocate(size_t uiSize, siz
 
   EZ_ASSERT_DEBUG(ezMath::IsPowerOf2((ezUInt32)uiAlign), "Alignment must be power of two");
 
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) == 0)
+  {
+    void* ptr = m_allocator.Allocate(uiSize, uiAlign);
+    EZ_ASSERT_DEV(ptr != nullptr, "Could not allocate {0} bytes. Out of memory?", uiSize);
+    return ptr;
+  }
+
+  // only measure the allocation time when it is actually tracked
   ezTime fAllocationTime = ezTime::Now();
 
   void* ptr = m_allocator.Allocate(uiSize, uiAlign);
   EZ_ASSERT_DEV(ptr != nullptr, "Could not allocate {0} bytes. Out of memory?", uiSize);
 
-  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
-  {
-    ezBitflags<ezMemoryTrackingFlags> flags;
-    flags.SetValue(TrackingFlags);
+  ezBitflags<ezMemoryTrackingFlags> flags;
+  flags.SetValue(TrackingFlags);
 
-    ezMemoryTracker::AddAllocation(this->m_Id, flags, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
-  }
+  ezMemoryTracker::AddAllocation(this->m_Id, flags, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
 
   return ptr;
 }
@@ -154,16 +159,18 @@ void* ezInternal::ezAllocatorMixinReallocate<A, TrackingFlags, true>::Reallocate
     ezMemoryTracker::RemoveAllocation(this->m_Id, ptr);
   }
 
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) == 0)
+  {
+    return this->m_allocator.Reallocate(ptr, uiCurrentSize, uiNewSize, uiAlign);
+  }
+
   ezTime fAllocationTime = ezTime::Now();
 
   void* pNewMem = this->m_allocator.Reallocate(ptr, uiCurrentSize, uiNewSize, uiAlign);
 
-  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
-  {
-    ezBitflags<ezMemoryTrackingFlags> flags;
-    flags.SetValue(TrackingFlags);
+  ezBitflags<ezMemoryTrackingFlags> flags;
+  flags.SetValue(TrackingFlags);
 
-    ezMemoryTracker::AddAllocation(this->m_Id, flags, pNewMem, uiNewSize, uiAlign, ezTime::Now() - fAllocationTime);
-  }
+  ezMemoryTracker::AddAllocation(this->m_Id, flags, pNewMem, uiNewSize, uiAlign, ezTime::Now() - fAllocationTime);
   return pNewMem;
 }
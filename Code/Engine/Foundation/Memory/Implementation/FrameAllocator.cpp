@@ -4,6 +4,9 @@
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
 
 ezDoubleBufferedStackAllocator::ezDoubleBufferedStackAllocator(const char* szName, ezAllocatorBase* pParent)
 {
@@ -37,6 +40,175 @@ void ezDoubleBufferedStackAllocator::Reset()
   m_pOtherAllocator->Reset();
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+struct ezFrameAllocatorLane::Chunk
+{
+  Chunk* m_pNext;
+  size_t m_uiSize;
+};
+
+struct ezFrameAllocatorLane::AllocationHeader
+{
+  ezMemoryUtils::DestructorFunction m_Func;
+  AllocationHeader* m_pNextDestructible;
+};
+
+namespace
+{
+  enum
+  {
+    Alignment = 16,
+    MinChunkSize = 64 * 1024,
+
+    // the headers are padded, so that the data after them stays aligned
+    ChunkHeaderSize = 16,
+    AllocationHeaderSize = 16,
+  };
+} // namespace
+
+ezFrameAllocatorLane::ezFrameAllocatorLane(const char* szName, ezAllocatorBase* pParent)
+  : m_pParent(pParent)
+{
+  EZ_CHECK_AT_COMPILETIME(sizeof(Chunk) <= ChunkHeaderSize);
+  EZ_CHECK_AT_COMPILETIME(sizeof(AllocationHeader) <= AllocationHeaderSize);
+
+  m_Id = ezMemoryTracker::RegisterAllocator(szName, ezMemoryTrackingFlags::RegisterAllocator, pParent->GetId());
+}
+
+ezFrameAllocatorLane::~ezFrameAllocatorLane()
+{
+  Reset();
+
+  while (m_pFirstChunk != nullptr)
+  {
+    Chunk* pChunk = m_pFirstChunk;
+    m_pFirstChunk = pChunk->m_pNext;
+    m_pParent->Deallocate(pChunk);
+  }
+
+  ezMemoryTracker::DeregisterAllocator(m_Id);
+}
+
+void* ezFrameAllocatorLane::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+{
+  uiAlign = ezMath::Max<size_t>(uiAlign, Alignment);
+
+  // every allocation is preceded by a header, so that deallocated objects are not destructed again on Reset
+  ezUInt8* pData = nullptr;
+  if (m_pNextAllocation != nullptr)
+  {
+    pData = ezMemoryUtils::Align(m_pNextAllocation + AllocationHeaderSize + uiAlign - 1, uiAlign);
+  }
+
+  if (pData == nullptr || pData + uiSize > m_pChunkEnd)
+  {
+    pData = static_cast<ezUInt8*>(AllocateFromNextChunk(uiSize, uiAlign));
+  }
+
+  const ezUInt64 uiUsedSize = (pData + uiSize) - m_pNextAllocation;
+  m_pNextAllocation = pData + uiSize;
+  m_uiCurrentUsage += uiUsedSize;
+  ++m_uiNumAllocations;
+
+  AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(pData - AllocationHeaderSize);
+  pHeader->m_Func = destructorFunc;
+  pHeader->m_pNextDestructible = nullptr;
+
+  if (destructorFunc != nullptr)
+  {
+    pHeader->m_pNextDestructible = m_pDestructibleAllocations;
+    m_pDestructibleAllocations = pHeader;
+  }
+
+  return pData;
+}
+
+void ezFrameAllocatorLane::Deallocate(void* ptr)
+{
+  // Individual deallocation is not supported, but the destructor must not be called again on Reset.
+  if (ptr != nullptr)
+  {
+    reinterpret_cast<AllocationHeader*>(static_cast<ezUInt8*>(ptr) - AllocationHeaderSize)->m_Func = nullptr;
+  }
+}
+
+ezAllocatorBase::Stats ezFrameAllocatorLane::GetStats() const
+{
+  Stats stats;
+  stats.m_uiNumAllocations = m_uiNumAllocations;
+  stats.m_uiAllocationSize = m_uiReservedMemory;
+  return stats;
+}
+
+void ezFrameAllocatorLane::Reset()
+{
+  // destruct in reverse order of allocation
+  for (AllocationHeader* pHeader = m_pDestructibleAllocations; pHeader != nullptr; pHeader = pHeader->m_pNextDestructible)
+  {
+    if (pHeader->m_Func != nullptr)
+    {
+      pHeader->m_Func(reinterpret_cast<ezUInt8*>(pHeader) + AllocationHeaderSize);
+    }
+  }
+
+  m_pDestructibleAllocations = nullptr;
+
+  m_uiPeakUsage = ezMath::Max(m_uiPeakUsage, m_uiCurrentUsage);
+  m_uiCurrentUsage = 0;
+  m_uiNumAllocations = 0;
+
+  m_pCurrentChunk = m_pFirstChunk;
+  m_pNextAllocation = m_pFirstChunk != nullptr ? reinterpret_cast<ezUInt8*>(m_pFirstChunk) + ChunkHeaderSize : nullptr;
+  m_pChunkEnd = m_pFirstChunk != nullptr ? reinterpret_cast<ezUInt8*>(m_pFirstChunk) + m_pFirstChunk->m_uiSize : nullptr;
+
+  ezMemoryTracker::SetAllocatorStats(m_Id, GetStats());
+}
+
+void* ezFrameAllocatorLane::AllocateFromNextChunk(size_t uiSize, size_t uiAlign)
+{
+  const size_t uiRequiredSize = ChunkHeaderSize + AllocationHeaderSize + uiAlign + uiSize;
+
+  // use the next existing chunk that is large enough, otherwise insert a new one after the current chunk
+  Chunk* pPrevChunk = m_pCurrentChunk;
+  Chunk* pChunk = m_pCurrentChunk != nullptr ? m_pCurrentChunk->m_pNext : m_pFirstChunk;
+
+  while (pChunk != nullptr && pChunk->m_uiSize < uiRequiredSize)
+  {
+    pPrevChunk = pChunk;
+    pChunk = pChunk->m_pNext;
+  }
+
+  if (pChunk == nullptr)
+  {
+    size_t uiChunkSize = ezMath::Max<size_t>(MinChunkSize, m_pCurrentChunk != nullptr ? m_pCurrentChunk->m_uiSize * 2 : 0);
+    uiChunkSize = ezMath::Max(uiChunkSize, uiRequiredSize);
+
+    pChunk = static_cast<Chunk*>(m_pParent->Allocate(uiChunkSize, Alignment));
+    pChunk->m_uiSize = uiChunkSize;
+    pChunk->m_pNext = nullptr;
+
+    if (pPrevChunk != nullptr)
+    {
+      pChunk->m_pNext = pPrevChunk->m_pNext;
+      pPrevChunk->m_pNext = pChunk;
+    }
+    else
+    {
+      m_pFirstChunk = pChunk;
+    }
+
+    m_uiReservedMemory += uiChunkSize;
+  }
+
+  m_pCurrentChunk = pChunk;
+  m_pNextAllocation = reinterpret_cast<ezUInt8*>(pChunk) + ChunkHeaderSize;
+  m_pChunkEnd = reinterpret_cast<ezUInt8*>(pChunk) + pChunk->m_uiSize;
+
+  return ezMemoryUtils::Align(m_pNextAllocation + AllocationHeaderSize + uiAlign - 1, uiAlign);
+}
+
+//////////////////////////////////////////////////////////////////////////
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FrameAllocator)
@@ -55,6 +227,125 @@ EZ_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
 ezDoubleBufferedStackAllocator* ezFrameAllocator::s_pAllocator;
+ezFrameAllocatorLane* ezFrameAllocator::s_ThreadLanes[MaxThreadLanes][2];
+ezInt32 ezFrameAllocator::s_iNumThreadLanes = 0;
+ezUInt32 ezFrameAllocator::s_uiCurrentLaneBuffer = 0;
+
+namespace
+{
+  // gives the lane back when the thread exits, so that short-lived threads don't use up all lanes
+  struct ThreadLaneInfo
+  {
+    ~ThreadLaneInfo();
+
+    ezUInt32 m_uiGeneration = 0;
+    ezInt32 m_iLaneIndex = -1;
+  };
+
+  // the generation is increased on every startup, so that threads don't use lanes of a previous run
+  thread_local ThreadLaneInfo tl_ThreadLaneInfo;
+  ezUInt32 s_uiThreadLaneGeneration = 0;
+
+  // lanes of exited threads, they are handed out again before new lanes are created
+  ezInt32 s_FreeThreadLanes[ezFrameAllocator::MaxThreadLanes];
+  ezUInt32 s_uiNumFreeThreadLanes = 0;
+
+  ezMutex& GetThreadLanesMutex()
+  {
+    static ezMutex s_Mutex;
+    return s_Mutex;
+  }
+
+  ThreadLaneInfo::~ThreadLaneInfo()
+  {
+    if (m_iLaneIndex < 0)
+      return;
+
+    EZ_LOCK(GetThreadLanesMutex());
+
+    // the lanes were already destroyed by a shutdown
+    if (m_uiGeneration != s_uiThreadLaneGeneration)
+      return;
+
+    // the memory of the lane stays valid until the next swap, even if another thread takes over the lane right away
+    s_FreeThreadLanes[s_uiNumFreeThreadLanes++] = m_iLaneIndex;
+    m_iLaneIndex = -1;
+  }
+} // namespace
+
+// static
+ezAllocatorBase* ezFrameAllocator::GetThreadAllocator()
+{
+  const ThreadLaneInfo& info = tl_ThreadLaneInfo;
+  if (info.m_uiGeneration != s_uiThreadLaneGeneration)
+  {
+    return CreateThreadLane();
+  }
+
+  if (info.m_iLaneIndex < 0)
+  {
+    return GetCurrentAllocator();
+  }
+
+  return s_ThreadLanes[info.m_iLaneIndex][s_uiCurrentLaneBuffer];
+}
+
+// static
+ezUInt32 ezFrameAllocator::GetNumThreadLanes()
+{
+  return ezMath::Min<ezUInt32>(ezAtomicUtils::Read(s_iNumThreadLanes), MaxThreadLanes);
+}
+
+// static
+ezFrameAllocator::LaneStats ezFrameAllocator::GetThreadLaneStats(ezUInt32 uiLaneIndex)
+{
+  EZ_ASSERT_DEV(uiLaneIndex < MaxThreadLanes, "Invalid lane index {0}", uiLaneIndex);
+
+  LaneStats stats;
+
+  ezFrameAllocatorLane* pCurrentLane = s_ThreadLanes[uiLaneIndex][s_uiCurrentLaneBuffer];
+  ezFrameAllocatorLane* pOtherLane = s_ThreadLanes[uiLaneIndex][s_uiCurrentLaneBuffer ^ 1];
+
+  if (pCurrentLane != nullptr && pOtherLane != nullptr)
+  {
+    stats.m_uiCurrentUsage = pCurrentLane->GetCurrentUsage();
+    stats.m_uiPeakUsage = ezMath::Max(pCurrentLane->GetPeakUsage(), pOtherLane->GetPeakUsage());
+  }
+
+  return stats;
+}
+
+// static
+ezAllocatorBase* ezFrameAllocator::CreateThreadLane()
+{
+  ThreadLaneInfo& info = tl_ThreadLaneInfo;
+  info.m_uiGeneration = s_uiThreadLaneGeneration;
+  info.m_iLaneIndex = -1;
+
+  EZ_LOCK(GetThreadLanesMutex());
+
+  if (s_uiNumFreeThreadLanes > 0)
+  {
+    info.m_iLaneIndex = s_FreeThreadLanes[--s_uiNumFreeThreadLanes];
+    return s_ThreadLanes[info.m_iLaneIndex][s_uiCurrentLaneBuffer];
+  }
+
+  const ezInt32 iLaneIndex = ezAtomicUtils::Increment(s_iNumThreadLanes) - 1;
+  if (iLaneIndex >= MaxThreadLanes)
+  {
+    return GetCurrentAllocator();
+  }
+
+  ezStringBuilder sName;
+  for (ezUInt32 i = 0; i < 2; ++i)
+  {
+    sName.Format("FrameAllocatorLane{0}_{1}", iLaneIndex, i);
+    s_ThreadLanes[iLaneIndex][i] = EZ_DEFAULT_NEW(ezFrameAllocatorLane, sName, ezFoundation::GetAlignedAllocator());
+  }
+
+  info.m_iLaneIndex = iLaneIndex;
+  return s_ThreadLanes[iLaneIndex][s_uiCurrentLaneBuffer];
+}
 
 // static
 void ezFrameAllocator::Swap()
@@ -62,6 +353,16 @@ void ezFrameAllocator::Swap()
   EZ_PROFILE_SCOPE("FrameAllocator.Swap");
 
   s_pAllocator->Swap();
+
+  s_uiCurrentLaneBuffer ^= 1;
+
+  for (ezUInt32 i = 0; i < GetNumThreadLanes(); ++i)
+  {
+    if (ezFrameAllocatorLane* pLane = s_ThreadLanes[i][s_uiCurrentLaneBuffer])
+    {
+      pLane->Reset();
+    }
+  }
 }
 
 // static
@@ -71,18 +372,47 @@ void ezFrameAllocator::Reset()
   {
     s_pAllocator->Reset();
   }
+
+  for (ezUInt32 i = 0; i < GetNumThreadLanes(); ++i)
+  {
+    for (ezFrameAllocatorLane* pLane : s_ThreadLanes[i])
+    {
+      if (pLane != nullptr)
+      {
+        pLane->Reset();
+      }
+    }
+  }
 }
 
 // static
 void ezFrameAllocator::Startup()
 {
   s_pAllocator = EZ_DEFAULT_NEW(ezDoubleBufferedStackAllocator, "FrameAllocator", ezFoundation::GetAlignedAllocator());
+
+  EZ_LOCK(GetThreadLanesMutex());
+  ++s_uiThreadLaneGeneration;
+  s_uiNumFreeThreadLanes = 0;
 }
 
 // static
 void ezFrameAllocator::Shutdown()
 {
   EZ_DEFAULT_DELETE(s_pAllocator);
+
+  EZ_LOCK(GetThreadLanesMutex());
+
+  for (ezUInt32 i = 0; i < GetNumThreadLanes(); ++i)
+  {
+    for (ezFrameAllocatorLane*& pLane : s_ThreadLanes[i])
+    {
+      EZ_DEFAULT_DELETE(pLane);
+    }
+  }
+
+  s_iNumThreadLanes = 0;
+  s_uiNumFreeThreadLanes = 0;
+  s_uiCurrentLaneBuffer = 0;
 }
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_FrameAllocator);
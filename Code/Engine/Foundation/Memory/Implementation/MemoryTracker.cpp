@@ -7,6 +7,7 @@
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicUtils.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -27,6 +28,24 @@ namespace
   };
 
 
+  enum
+  {
+    NumShardBits = 6,
+    NumShards = 1 << NumShardBits,
+  };
+
+  typedef ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> AllocationTable;
+
+  // the counters of one allocator in one shard, protected by the mutex of that shard
+  struct ShardStats
+  {
+    ezInt64 m_iNumAllocations = 0;
+    ezInt64 m_iNumDeallocations = 0;
+    ezInt64 m_iAllocationSize = 0;
+    ezInt64 m_iPerFrameAllocationSize = 0;
+    ezInt64 m_iPerFrameAllocationTimeNs = 0;
+  };
+
   struct AllocatorData
   {
     EZ_ALWAYS_INLINE AllocatorData() {}
@@ -36,25 +55,98 @@ namespace
 
     ezAllocatorId m_ParentId;
 
-    ezAllocatorBase::Stats m_Stats;
+    // sum of the shard stats, returned by reference from GetAllocatorStats
+    mutable ezAllocatorBase::Stats m_Stats;
+
+    // one table and one set of counters per shard, each one is protected by the mutex of its shard,
+    // so that threads which allocate from the same allocator don't all write to the same counters
+    AllocationTable m_Allocations[NumShards];
+    ShardStats m_ShardStats[NumShards];
+
+    ezUInt32 GetNumLiveAllocations() const
+    {
+      ezUInt32 uiCount = 0;
+      for (const AllocationTable& allocations : m_Allocations)
+      {
+        uiCount += allocations.GetCount();
+      }
+      return uiCount;
+    }
+  };
 
-    ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+  // each shard sits on its own cache line, so that threads working on different shards don't slow each other down
+  struct EZ_ALIGN(Shard, 64)
+  {
+    ezMutex m_Mutex;
   };
 
   struct TrackerData
   {
-    EZ_ALWAYS_INLINE void Lock() { m_Mutex.Lock(); }
-    EZ_ALWAYS_INLINE void Unlock() { m_Mutex.Unlock(); }
+    // locks the allocator table and all shards, needed to add or remove allocators or to look at all allocations at once
+    void Lock()
+    {
+      m_Mutex.Lock();
+      for (Shard& shard : m_Shards)
+      {
+        shard.m_Mutex.Lock();
+      }
+    }
 
+    void Unlock()
+    {
+      for (ezUInt32 i = NumShards; i > 0; --i)
+      {
+        m_Shards[i - 1].m_Mutex.Unlock();
+      }
+      m_Mutex.Unlock();
+    }
+
+    // the allocator table may be read while holding either this mutex or one of the shard mutexes
     ezMutex m_Mutex;
 
     typedef ezIdTable<ezAllocatorId, AllocatorData, TrackerDataAllocatorWrapper> AllocatorTable;
     AllocatorTable m_AllocatorData;
 
     ezAllocatorId m_StaticAllocatorId;
+
+    Shard m_Shards[NumShards];
   };
 
   static TrackerData* s_pTrackerData;
+
+  const ezAllocatorBase::Stats& UpdateStats(const AllocatorData& data)
+  {
+    ShardStats sum;
+    for (ezUInt32 uiShardIndex = 0; uiShardIndex < NumShards; ++uiShardIndex)
+    {
+      EZ_LOCK(s_pTrackerData->m_Shards[uiShardIndex].m_Mutex);
+
+      const ShardStats& shardStats = data.m_ShardStats[uiShardIndex];
+      sum.m_iNumAllocations += shardStats.m_iNumAllocations;
+      sum.m_iNumDeallocations += shardStats.m_iNumDeallocations;
+      sum.m_iAllocationSize += shardStats.m_iAllocationSize;
+      sum.m_iPerFrameAllocationSize += shardStats.m_iPerFrameAllocationSize;
+      sum.m_iPerFrameAllocationTimeNs += shardStats.m_iPerFrameAllocationTimeNs;
+    }
+
+    data.m_Stats.m_uiNumAllocations = sum.m_iNumAllocations;
+    data.m_Stats.m_uiNumDeallocations = sum.m_iNumDeallocations;
+    data.m_Stats.m_uiAllocationSize = sum.m_iAllocationSize;
+    data.m_Stats.m_uiPerFrameAllocationSize = sum.m_iPerFrameAllocationSize;
+    data.m_Stats.m_PerFrameAllocationTime = ezTime::Nanoseconds((double)sum.m_iPerFrameAllocationTimeNs);
+    return data.m_Stats;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetShardIndex(const void* ptr)
+  {
+    // the lowest bits of an allocation address are mostly zero due to alignment, so mix all bits into the top ones
+    const ezUInt64 uiPtr = static_cast<ezUInt64>(reinterpret_cast<size_t>(ptr) >> 4);
+    return static_cast<ezUInt32>((uiPtr * 0x9E3779B97F4A7C15ull) >> (64 - NumShardBits));
+  }
+
+  static ezInt32 s_iStackTraceSampleRate = 1;
+  thread_local ezUInt32 tl_uiStackTraceSampleCounter = 0;
+
   static bool s_bIsInitialized = false;
   static bool s_bIsInitializing = false;
 
@@ -121,7 +213,7 @@ ezAllocatorId ezMemoryTracker::Iterator::ParentId() const
 
 const ezAllocatorBase::Stats& ezMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  return UpdateStats(CAST_ITER(m_pData)->Value());
 }
 
 void ezMemoryTracker::Iterator::Next()
@@ -171,12 +263,15 @@ void ezMemoryTracker::DeregisterAllocator(ezAllocatorId allocatorId)
 
   const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
 
-  ezUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
+  ezUInt32 uiLiveAllocations = data.GetNumLiveAllocations();
   if (uiLiveAllocations != 0)
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    for (const AllocationTable& allocations : data.m_Allocations)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      for (auto it = allocations.GetIterator(); it.IsValid(); ++it)
+      {
+        DumpLeak(it.Value(), data.m_sName.GetData());
+      }
     }
 
     EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
@@ -194,28 +289,36 @@ void ezMemoryTracker::AddAllocation(
   ezArrayPtr<void*> stackTrace;
   if (flags.IsSet(ezMemoryTrackingFlags::EnableStackTrace))
   {
-    void* pBuffer[64];
-    ezArrayPtr<void*> tempTrace(pBuffer);
-    const ezUInt32 uiNumTraces = ezStackTracer::GetStackTrace(tempTrace);
+    const ezUInt32 uiSampleRate = static_cast<ezUInt32>(s_iStackTraceSampleRate);
+    if (uiSampleRate <= 1 || ++tl_uiStackTraceSampleCounter % uiSampleRate == 0)
+    {
+      void* pBuffer[64];
+      ezArrayPtr<void*> tempTrace(pBuffer);
+      const ezUInt32 uiNumTraces = ezStackTracer::GetStackTrace(tempTrace);
 
-    stackTrace = EZ_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
-    ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
+      stackTrace = EZ_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
+      ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
+    }
   }
 
+  const ezUInt32 uiShardIndex = GetShardIndex(ptr);
+
   {
-    EZ_LOCK(*s_pTrackerData);
+    EZ_LOCK(s_pTrackerData->m_Shards[uiShardIndex].m_Mutex);
 
     AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-    data.m_Stats.m_uiNumAllocations++;
-    data.m_Stats.m_uiAllocationSize += uiSize;
-    data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
-    data.m_Stats.m_PerFrameAllocationTime += allocationTime;
-
     EZ_ASSERT_DEBUG(data.m_Flags == flags, "Given flags have to be identical to allocator flags");
-    auto pInfo = &data.m_Allocations[ptr];
+
+    auto pInfo = &data.m_Allocations[uiShardIndex][ptr];
     pInfo->m_uiSize = uiSize;
     pInfo->m_uiAlignment = (ezUInt16)uiAlign;
     pInfo->SetStackTrace(stackTrace);
+
+    ShardStats& shardStats = data.m_ShardStats[uiShardIndex];
+    ++shardStats.m_iNumAllocations;
+    shardStats.m_iAllocationSize += uiSize;
+    shardStats.m_iPerFrameAllocationSize += uiSize;
+    shardStats.m_iPerFrameAllocationTimeNs += static_cast<ezInt64>(allocationTime.GetNanoseconds());
   }
 }
 
@@ -224,16 +327,19 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pt
 {
   ezArrayPtr<void*> stackTrace;
 
+  const ezUInt32 uiShardIndex = GetShardIndex(ptr);
+
   {
-    EZ_LOCK(*s_pTrackerData);
+    EZ_LOCK(s_pTrackerData->m_Shards[uiShardIndex].m_Mutex);
 
     AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
 
     AllocationInfo info;
-    if (data.m_Allocations.Remove(ptr, &info))
+    if (data.m_Allocations[uiShardIndex].Remove(ptr, &info))
     {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+      ShardStats& shardStats = data.m_ShardStats[uiShardIndex];
+      ++shardStats.m_iNumDeallocations;
+      shardStats.m_iAllocationSize -= info.m_uiSize;
 
       stackTrace = info.GetStackTrace();
     }
@@ -249,17 +355,30 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pt
 // static
 void ezMemoryTracker::RemoveAllAllocations(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
-  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  for (ezUInt32 uiShardIndex = 0; uiShardIndex < NumShards; ++uiShardIndex)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    EZ_LOCK(s_pTrackerData->m_Shards[uiShardIndex].m_Mutex);
 
-    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    AllocationTable& allocations = data.m_Allocations[uiShardIndex];
+    if (allocations.IsEmpty())
+      continue;
+
+    ezInt64 iAllocationSize = 0;
+    for (auto it = allocations.GetIterator(); it.IsValid(); ++it)
+    {
+      auto& info = it.Value();
+      iAllocationSize += info.m_uiSize;
+
+      EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    }
+
+    ShardStats& shardStats = data.m_ShardStats[uiShardIndex];
+    shardStats.m_iNumDeallocations += allocations.GetCount();
+    shardStats.m_iAllocationSize -= iAllocationSize;
+
+    allocations.Clear();
   }
-  data.m_Allocations.Clear();
 }
 
 // static
@@ -267,7 +386,20 @@ void ezMemoryTracker::SetAllocatorStats(ezAllocatorId allocatorId, const ezAlloc
 {
   EZ_LOCK(*s_pTrackerData);
 
-  s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+
+  // the totals go into the first shard, the others start from zero again
+  for (ShardStats& shardStats : data.m_ShardStats)
+  {
+    shardStats = ShardStats();
+  }
+
+  ShardStats& shardStats = data.m_ShardStats[0];
+  shardStats.m_iNumAllocations = static_cast<ezInt64>(stats.m_uiNumAllocations);
+  shardStats.m_iNumDeallocations = static_cast<ezInt64>(stats.m_uiNumDeallocations);
+  shardStats.m_iAllocationSize = static_cast<ezInt64>(stats.m_uiAllocationSize);
+  shardStats.m_iPerFrameAllocationSize = static_cast<ezInt64>(stats.m_uiPerFrameAllocationSize);
+  shardStats.m_iPerFrameAllocationTimeNs = static_cast<ezInt64>(stats.m_PerFrameAllocationTime.GetNanoseconds());
 }
 
 // static
@@ -277,16 +409,30 @@ void ezMemoryTracker::ResetPerFrameAllocatorStats()
 
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    AllocatorData& data = it.Value();
-    data.m_Stats.m_uiPerFrameAllocationSize = 0;
-    data.m_Stats.m_PerFrameAllocationTime.SetZero();
+    for (ShardStats& shardStats : it.Value().m_ShardStats)
+    {
+      shardStats.m_iPerFrameAllocationSize = 0;
+      shardStats.m_iPerFrameAllocationTimeNs = 0;
+    }
   }
 }
 
+// static
+void ezMemoryTracker::SetStackTraceSampleRate(ezUInt32 uiSampleRate)
+{
+  ezAtomicUtils::Set(s_iStackTraceSampleRate, static_cast<ezInt32>(ezMath::Max(uiSampleRate, 1u)));
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetStackTraceSampleRate()
+{
+  return static_cast<ezUInt32>(ezAtomicUtils::Read(s_iStackTraceSampleRate));
+}
+
 // static
 const char* ezMemoryTracker::GetAllocatorName(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
+  EZ_LOCK(s_pTrackerData->m_Mutex);
 
   return s_pTrackerData->m_AllocatorData[allocatorId].m_sName.GetData();
 }
@@ -294,15 +440,15 @@ const char* ezMemoryTracker::GetAllocatorName(ezAllocatorId allocatorId)
 // static
 const ezAllocatorBase::Stats& ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
+  EZ_LOCK(s_pTrackerData->m_Mutex);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+  return UpdateStats(s_pTrackerData->m_AllocatorData[allocatorId]);
 }
 
 // static
 ezAllocatorId ezMemoryTracker::GetAllocatorParentId(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
+  EZ_LOCK(s_pTrackerData->m_Mutex);
 
   return s_pTrackerData->m_AllocatorData[allocatorId].m_ParentId;
 }
@@ -310,11 +456,13 @@ ezAllocatorId ezMemoryTracker::GetAllocatorParentId(ezAllocatorId allocatorId)
 // static
 const ezMemoryTracker::AllocationInfo& ezMemoryTracker::GetAllocationInfo(ezAllocatorId allocatorId, const void* ptr)
 {
-  EZ_LOCK(*s_pTrackerData);
+  const ezUInt32 uiShardIndex = GetShardIndex(ptr);
+
+  EZ_LOCK(s_pTrackerData->m_Shards[uiShardIndex].m_Mutex);
 
   const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
   const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(ptr, info))
+  if (data.m_Allocations[uiShardIndex].TryGetValue(ptr, info))
   {
     return *info;
   }
@@ -351,14 +499,17 @@ void ezMemoryTracker::DumpMemoryLeaks()
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
     const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    for (const AllocationTable& allocations : data.m_Allocations)
     {
-      LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
-      leak.m_pParentLeak = nullptr;
+      for (auto it2 = allocations.GetIterator(); it2.IsValid(); ++it2)
+      {
+        LeakInfo leak;
+        leak.m_AllocatorId = it.Id();
+        leak.m_uiSize = it2.Value().m_uiSize;
+        leak.m_pParentLeak = nullptr;
 
-      leakTable.Insert(it2.Key(), leak);
+        leakTable.Insert(it2.Key(), leak);
+      }
     }
   }
 
@@ -404,7 +555,7 @@ void ezMemoryTracker::DumpMemoryLeaks()
 
       const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
       ezMemoryTracker::AllocationInfo info;
-      data.m_Allocations.TryGetValue(ptr, info);
+      data.m_Allocations[GetShardIndex(ptr)].TryGetValue(ptr, info);
 
       DumpLeak(info, data.m_sName.GetData());
 
@@ -40,6 +40,10 @@ struct ezMemoryTrackingFlags
 #define EZ_STATIC_ALLOCATOR_NAME "Statics"
 
 /// \brief Memory tracker which keeps track of all allocations and constructions
+///
+/// Tracked allocations are distributed over a fixed number of shards by their address, each with its own lock, so allocations
+/// on different threads rarely have to wait for each other. The stats of each allocator are kept per shard as well and are
+/// summed up when they are queried.
 class EZ_FOUNDATION_DLL ezMemoryTracker
 {
 public:
@@ -109,6 +113,14 @@ public:
 
   static void ResetPerFrameAllocatorStats();
 
+  /// \brief Only records a stack trace for every n-th allocation of each thread, for allocators that have EnableStackTrace set.
+  ///
+  /// Capturing stack traces is by far the most expensive part of allocation tracking. Sampling them keeps leak tracking cheap
+  /// enough to leave it enabled in long running sessions, at the cost of some leaks being reported without a stack trace.
+  /// A sample rate of 1 (the default) records a stack trace for every allocation.
+  static void SetStackTraceSampleRate(ezUInt32 uiSampleRate);
+  static ezUInt32 GetStackTraceSampleRate();
+
   static const char* GetAllocatorName(ezAllocatorId allocatorId);
   static const ezAllocatorBase::Stats& GetAllocatorStats(ezAllocatorId allocatorId);
   static ezAllocatorId GetAllocatorParentId(ezAllocatorId allocatorId);
@@ -0,0 +1,484 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Memory/Policies/ThreadCachingAllocation.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace ezMemoryPolicies
+{
+  namespace
+  {
+    enum
+    {
+      HeapHeaderSize = 16,
+      BatchBytes = 16 * 1024,
+      MinBatchCount = 4,
+      MaxBatchCount = 64,
+    };
+
+    struct ThreadCacheSlot
+    {
+      ezInt64 m_iInstanceId;
+      void* m_pCache;
+    };
+
+    struct HeapHeader
+    {
+      ezThreadCachingAllocation* m_pOwner;
+    };
+
+    // gives the caches back when the thread exits, it is only constructed once the thread creates its first cache
+    struct ThreadExitRelease
+    {
+      ~ThreadExitRelease();
+
+      bool m_bActive = false;
+    };
+
+    // instance IDs are never reused, so slots of destroyed allocators can never be mistaken for a new allocator at the same address
+    thread_local ThreadCacheSlot tl_ThreadCacheSlots[ezThreadCachingAllocation::MaxThreadCachesPerThread];
+    thread_local bool tl_bThreadExiting = false;
+    thread_local ThreadExitRelease tl_ThreadExitRelease;
+    ezInt64 s_iNextInstanceId = 0;
+
+    // all living allocators, so that a thread can find out whether the allocator of a cache slot still exists
+    ezThreadCachingAllocation* s_pFirstInstance = nullptr;
+
+    ezMutex& GetInstancesMutex()
+    {
+      static ezMutex s_Mutex;
+      return s_Mutex;
+    }
+
+    ThreadExitRelease::~ThreadExitRelease()
+    {
+      tl_bThreadExiting = true;
+      ezThreadCachingAllocation::ReleaseThreadCachesOfThisThread();
+    }
+
+    EZ_ALWAYS_INLINE void*& NextBlock(void* pBlock) { return *static_cast<void**>(pBlock); }
+
+    /// \brief Number of blocks that are moved between a thread cache and the central list at once.
+    EZ_ALWAYS_INLINE ezUInt32 GetBatchCount(ezUInt32 uiSizeClass)
+    {
+      return ezMath::Clamp<ezUInt32>(BatchBytes / ezThreadCachingAllocation::GetSizeClassBlockSize(uiSizeClass), MinBatchCount, MaxBatchCount);
+    }
+
+    ThreadCacheSlot* FindFreeSlot()
+    {
+      for (ThreadCacheSlot& slot : tl_ThreadCacheSlots)
+      {
+        if (slot.m_iInstanceId == 0)
+          return &slot;
+      }
+
+      return nullptr;
+    }
+  } // namespace
+
+  struct ezThreadCachingAllocation::SpanHeader
+  {
+    ezThreadCachingAllocation* m_pOwner;
+    ezUInt32 m_uiSizeClass;
+  };
+
+  struct ezThreadCachingAllocation::ThreadCache
+  {
+    struct FreeList
+    {
+      void* m_pHead;
+      ezUInt32 m_uiCount;
+    };
+
+    ThreadCache* m_pNext;
+    FreeList m_Lists[NumSizeClasses];
+  };
+
+  ezThreadCachingAllocation::ezThreadCachingAllocation(ezAllocatorBase* pParent)
+    : m_HeapAllocation(pParent)
+  {
+    EZ_CHECK_AT_COMPILETIME(sizeof(SpanHeader) <= SpanHeaderSize);
+    EZ_CHECK_AT_COMPILETIME(sizeof(HeapHeader) <= HeapHeaderSize);
+
+    m_iInstanceId = ezAtomicUtils::Increment(s_iNextInstanceId);
+
+    EZ_LOCK(GetInstancesMutex());
+    m_pNextInstance = s_pFirstInstance;
+    s_pFirstInstance = this;
+  }
+
+  ezThreadCachingAllocation::~ezThreadCachingAllocation()
+  {
+    // once removed, exiting threads won't touch the caches of this allocator anymore
+    {
+      EZ_LOCK(GetInstancesMutex());
+
+      ezThreadCachingAllocation** ppInstance = &s_pFirstInstance;
+      while (*ppInstance != this)
+      {
+        ppInstance = &(*ppInstance)->m_pNextInstance;
+      }
+
+      *ppInstance = m_pNextInstance;
+    }
+
+    // the slots of other threads are reclaimed by those threads, once they need them
+    for (ThreadCacheSlot& slot : tl_ThreadCacheSlots)
+    {
+      if (slot.m_iInstanceId == m_iInstanceId)
+      {
+        slot.m_iInstanceId = 0;
+        slot.m_pCache = nullptr;
+      }
+    }
+
+    while (m_pThreadCaches != nullptr)
+    {
+      ThreadCache* pCache = m_pThreadCaches;
+      m_pThreadCaches = pCache->m_pNext;
+      m_HeapAllocation.Deallocate(pCache);
+    }
+
+    for (ezInt32 i = 0; i < m_iNumSpanRegions; ++i)
+    {
+      ezPageAllocator::DeallocatePage(m_SpanRegions[i].m_pAllocation);
+    }
+  }
+
+  ezUInt32 ezThreadCachingAllocation::GetSizeClass(size_t uiSize)
+  {
+    EZ_ASSERT_DEBUG(uiSize > 0 && uiSize <= MaxSmallSize, "Invalid size for a size class");
+
+    const ezUInt32 uiSize32 = static_cast<ezUInt32>(uiSize);
+
+    // 16 byte steps up to 128 bytes, then 4 steps per power of two
+    if (uiSize32 <= 128)
+      return (uiSize32 + 15) / 16 - 1;
+
+    const ezUInt32 uiLog2 = ezMath::FirstBitHigh(uiSize32 - 1);
+    return 8 + (uiLog2 - 7) * 4 + ((uiSize32 - 1) >> (uiLog2 - 2)) - 4;
+  }
+
+  ezUInt32 ezThreadCachingAllocation::GetSizeClassBlockSize(ezUInt32 uiSizeClass)
+  {
+    if (uiSizeClass < 8)
+      return (uiSizeClass + 1) * 16;
+
+    const ezUInt32 uiLog2 = 7 + (uiSizeClass - 8) / 4;
+    return ((uiSizeClass - 8) % 4 + 5) << (uiLog2 - 2);
+  }
+
+  void ezThreadCachingAllocation::ReleaseThreadCachesOfThisThread()
+  {
+    EZ_LOCK(GetInstancesMutex());
+
+    for (ThreadCacheSlot& slot : tl_ThreadCacheSlots)
+    {
+      if (slot.m_iInstanceId == 0)
+        continue;
+
+      if (ezThreadCachingAllocation* pInstance = FindInstance(slot.m_iInstanceId))
+      {
+        pInstance->ReleaseThreadCache(static_cast<ThreadCache*>(slot.m_pCache));
+      }
+
+      slot.m_iInstanceId = 0;
+      slot.m_pCache = nullptr;
+    }
+  }
+
+  ezThreadCachingAllocation* ezThreadCachingAllocation::FindInstance(ezInt64 iInstanceId)
+  {
+    for (ezThreadCachingAllocation* pInstance = s_pFirstInstance; pInstance != nullptr; pInstance = pInstance->m_pNextInstance)
+    {
+      if (pInstance->m_iInstanceId == iInstanceId)
+        return pInstance;
+    }
+
+    return nullptr;
+  }
+
+  EZ_FORCE_INLINE ezThreadCachingAllocation::ThreadCache* ezThreadCachingAllocation::GetThreadCache()
+  {
+    for (const ThreadCacheSlot& slot : tl_ThreadCacheSlots)
+    {
+      if (slot.m_iInstanceId == m_iInstanceId)
+        return static_cast<ThreadCache*>(slot.m_pCache);
+    }
+
+    return CreateThreadCache();
+  }
+
+  ezThreadCachingAllocation::ThreadCache* ezThreadCachingAllocation::CreateThreadCache()
+  {
+    // the caches have already been released, everything that is still freed on this thread goes to the central lists
+    if (tl_bThreadExiting)
+      return nullptr;
+
+    ThreadCacheSlot* pSlot = FindFreeSlot();
+
+    if (pSlot == nullptr)
+    {
+      // allocators that were destroyed on other threads still occupy their slots
+      EZ_LOCK(GetInstancesMutex());
+
+      for (ThreadCacheSlot& slot : tl_ThreadCacheSlots)
+      {
+        if (FindInstance(slot.m_iInstanceId) == nullptr)
+        {
+          slot.m_iInstanceId = 0;
+          slot.m_pCache = nullptr;
+        }
+      }
+
+      pSlot = FindFreeSlot();
+    }
+
+    // this thread uses too many of these allocators, fall back to the central lists
+    if (pSlot == nullptr)
+      return nullptr;
+
+    tl_ThreadExitRelease.m_bActive = true;
+
+    ThreadCache* pCache = static_cast<ThreadCache*>(m_HeapAllocation.Allocate(sizeof(ThreadCache), EZ_ALIGNMENT_OF(ThreadCache)));
+    ezMemoryUtils::ZeroFill(pCache, 1);
+
+    {
+      EZ_LOCK(m_Mutex);
+      pCache->m_pNext = m_pThreadCaches;
+      m_pThreadCaches = pCache;
+    }
+
+    pSlot->m_iInstanceId = m_iInstanceId;
+    pSlot->m_pCache = pCache;
+    return pCache;
+  }
+
+  void ezThreadCachingAllocation::ReleaseThreadCache(ThreadCache* pCache)
+  {
+    for (ezUInt32 uiSizeClass = 0; uiSizeClass < NumSizeClasses; ++uiSizeClass)
+    {
+      ThreadCache::FreeList& list = pCache->m_Lists[uiSizeClass];
+      if (list.m_pHead == nullptr)
+        continue;
+
+      void* pLast = list.m_pHead;
+      while (NextBlock(pLast) != nullptr)
+      {
+        pLast = NextBlock(pLast);
+      }
+
+      ReturnToCentral(uiSizeClass, list.m_pHead, pLast);
+    }
+
+    {
+      EZ_LOCK(m_Mutex);
+
+      ThreadCache** ppCache = &m_pThreadCaches;
+      while (*ppCache != pCache)
+      {
+        ppCache = &(*ppCache)->m_pNext;
+      }
+
+      *ppCache = pCache->m_pNext;
+    }
+
+    m_HeapAllocation.Deallocate(pCache);
+  }
+
+  void* ezThreadCachingAllocation::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    EZ_ASSERT_DEBUG(
+      uiAlign <= 16, "This allocator does not guarantee alignments larger than 16. Use an aligned allocator to allocate the desired data type.");
+
+    if (uiSize > MaxSmallSize)
+      return AllocateFromHeap(uiSize);
+
+    const ezUInt32 uiSizeClass = GetSizeClass(uiSize);
+
+    ThreadCache* pCache = GetThreadCache();
+    if (pCache == nullptr)
+    {
+      ezUInt32 uiNumBlocks = 0;
+      void* pBlock = AllocateFromCentral(uiSizeClass, 1, uiNumBlocks);
+      return pBlock != nullptr ? pBlock : AllocateFromHeap(uiSize);
+    }
+
+    ThreadCache::FreeList& list = pCache->m_Lists[uiSizeClass];
+    if (list.m_pHead == nullptr)
+    {
+      list.m_pHead = AllocateFromCentral(uiSizeClass, GetBatchCount(uiSizeClass), list.m_uiCount);
+
+      if (list.m_pHead == nullptr)
+        return AllocateFromHeap(uiSize);
+    }
+
+    void* pBlock = list.m_pHead;
+    list.m_pHead = NextBlock(pBlock);
+    --list.m_uiCount;
+
+    return pBlock;
+  }
+
+  void ezThreadCachingAllocation::Deallocate(void* ptr)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (!IsInSpanRegion(ptr))
+    {
+      HeapHeader* pHeader = static_cast<HeapHeader*>(ezMemoryUtils::AddByteOffset(ptr, -HeapHeaderSize));
+      EZ_ASSERT_DEBUG(pHeader->m_pOwner == this, "Memory was not allocated by this allocator");
+
+      m_HeapAllocation.Deallocate(pHeader);
+      return;
+    }
+
+    SpanHeader* pSpan = reinterpret_cast<SpanHeader*>(reinterpret_cast<size_t>(ptr) & ~static_cast<size_t>(SpanSize - 1));
+    EZ_ASSERT_DEBUG(pSpan->m_pOwner == this, "Memory was not allocated by this allocator");
+
+    const ezUInt32 uiSizeClass = pSpan->m_uiSizeClass;
+
+    ThreadCache* pCache = GetThreadCache();
+    if (pCache == nullptr)
+    {
+      NextBlock(ptr) = nullptr;
+      ReturnToCentral(uiSizeClass, ptr, ptr);
+      return;
+    }
+
+    ThreadCache::FreeList& list = pCache->m_Lists[uiSizeClass];
+    NextBlock(ptr) = list.m_pHead;
+    list.m_pHead = ptr;
+    ++list.m_uiCount;
+
+    // blocks that were allocated on other threads would pile up here, so give a batch back once the cache holds too many
+    const ezUInt32 uiBatchCount = GetBatchCount(uiSizeClass);
+    if (list.m_uiCount > 2 * uiBatchCount)
+    {
+      void* pFirst = list.m_pHead;
+      void* pLast = pFirst;
+      for (ezUInt32 i = 1; i < uiBatchCount; ++i)
+      {
+        pLast = NextBlock(pLast);
+      }
+
+      list.m_pHead = NextBlock(pLast);
+      list.m_uiCount -= uiBatchCount;
+      NextBlock(pLast) = nullptr;
+
+      ReturnToCentral(uiSizeClass, pFirst, pLast);
+    }
+  }
+
+  void* ezThreadCachingAllocation::AllocateFromHeap(size_t uiSize)
+  {
+    HeapHeader* pHeader = static_cast<HeapHeader*>(m_HeapAllocation.Allocate(uiSize + HeapHeaderSize, 16));
+    pHeader->m_pOwner = this;
+
+    return ezMemoryUtils::AddByteOffset(pHeader, HeapHeaderSize);
+  }
+
+  EZ_FORCE_INLINE bool ezThreadCachingAllocation::IsInSpanRegion(const void* ptr) const
+  {
+    const ezUInt8* pByte = static_cast<const ezUInt8*>(ptr);
+
+    // the newest regions are the largest ones
+    for (ezInt32 i = ezAtomicUtils::Read(m_iNumSpanRegions) - 1; i >= 0; --i)
+    {
+      if (pByte >= m_SpanRegions[i].m_pFirstSpan && pByte < m_SpanRegions[i].m_pEnd)
+        return true;
+    }
+
+    return false;
+  }
+
+  ezThreadCachingAllocation::SpanHeader* ezThreadCachingAllocation::AllocateSpan()
+  {
+    EZ_LOCK(m_Mutex);
+
+    if (m_iNumSpanRegions == 0 || m_pNextSpan == m_SpanRegions[m_iNumSpanRegions - 1].m_pEnd)
+    {
+      if (m_iNumSpanRegions == MaxSpanRegions)
+        return nullptr;
+
+      const size_t uiRegionSize = ezMath::Min<size_t>(static_cast<size_t>(MinSpanRegionSize) << m_iNumSpanRegions, MaxSpanRegionSize);
+
+      // the pages are not necessarily aligned to the span size, so reserve one more span to be able to align the first one
+      SpanRegion& region = m_SpanRegions[m_iNumSpanRegions];
+      region.m_pAllocation = ezPageAllocator::AllocatePage(uiRegionSize + SpanSize);
+      region.m_pFirstSpan = reinterpret_cast<ezUInt8*>(ezMemoryUtils::AlignSize<size_t>(reinterpret_cast<size_t>(region.m_pAllocation), SpanSize));
+      region.m_pEnd = region.m_pFirstSpan + uiRegionSize;
+
+      m_pNextSpan = region.m_pFirstSpan;
+
+      // publishes the region to IsInSpanRegion
+      ezAtomicUtils::Increment(m_iNumSpanRegions);
+    }
+
+    SpanHeader* pSpan = reinterpret_cast<SpanHeader*>(m_pNextSpan);
+    m_pNextSpan += SpanSize;
+
+    return pSpan;
+  }
+
+  void* ezThreadCachingAllocation::AllocateFromCentral(ezUInt32 uiSizeClass, ezUInt32 uiMaxBlocks, ezUInt32& out_uiNumBlocks)
+  {
+    CentralList& central = m_CentralLists[uiSizeClass];
+    EZ_LOCK(central.m_Mutex);
+
+    if (central.m_pFreeList == nullptr)
+    {
+      SpanHeader* pSpan = AllocateSpan();
+      if (pSpan == nullptr)
+      {
+        out_uiNumBlocks = 0;
+        return nullptr;
+      }
+
+      pSpan->m_pOwner = this;
+      pSpan->m_uiSizeClass = uiSizeClass;
+
+      // link all blocks of the new span into the central list, in address order
+      const ezUInt32 uiBlockSize = GetSizeClassBlockSize(uiSizeClass);
+      const ezUInt32 uiNumBlocks = (SpanSize - SpanHeaderSize) / uiBlockSize;
+
+      ezUInt8* pFirstBlock = reinterpret_cast<ezUInt8*>(pSpan) + SpanHeaderSize;
+      for (ezUInt32 i = 0; i < uiNumBlocks - 1; ++i)
+      {
+        NextBlock(pFirstBlock + i * uiBlockSize) = pFirstBlock + (i + 1) * uiBlockSize;
+      }
+      NextBlock(pFirstBlock + (uiNumBlocks - 1) * uiBlockSize) = nullptr;
+
+      central.m_pFreeList = pFirstBlock;
+    }
+
+    void* pFirst = central.m_pFreeList;
+    void* pLast = pFirst;
+    ezUInt32 uiNumBlocks = 1;
+
+    while (uiNumBlocks < uiMaxBlocks && NextBlock(pLast) != nullptr)
+    {
+      pLast = NextBlock(pLast);
+      ++uiNumBlocks;
+    }
+
+    central.m_pFreeList = NextBlock(pLast);
+    NextBlock(pLast) = nullptr;
+
+    out_uiNumBlocks = uiNumBlocks;
+    return pFirst;
+  }
+
+  void ezThreadCachingAllocation::ReturnToCentral(ezUInt32 uiSizeClass, void* pFirst, void* pLast)
+  {
+    CentralList& central = m_CentralLists[uiSizeClass];
+    EZ_LOCK(central.m_Mutex);
+
+    NextBlock(pLast) = central.m_pFreeList;
+    central.m_pFreeList = pFirst;
+  }
+} // namespace ezMemoryPolicies
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Policies_ThreadCachingAllocation);
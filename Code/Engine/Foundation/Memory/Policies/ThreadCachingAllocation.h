@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Foundation/Memory/Policies/AlignedHeapAllocation.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace ezMemoryPolicies
+{
+  /// \brief Heap allocation policy that serves small allocations from size class slabs through per-thread caches.
+  ///
+  /// Allocations up to MaxSmallSize bytes are rounded up to one of NumSizeClasses size classes. Blocks of one size class are carved
+  /// from spans of SpanSize bytes, which are aligned to their size, so the span header (and thus the size class) of any block can be
+  /// found by masking its address. Every thread has its own cache of free blocks per size class, so most allocations and
+  /// deallocations do not need any synchronization. Deallocations always go into the cache of the deallocating thread, regardless
+  /// of which thread allocated the block. When a thread cache runs empty or grows too large, a whole batch of blocks is moved
+  /// from or to the shared central list of the size class at once, which is the only place that takes a lock.
+  /// When a thread exits, its caches are given back to the central lists.
+  ///
+  /// The spans are carved from regions that are reserved with ezPageAllocator. Each region is twice as large as the previous one,
+  /// up to MaxSpanRegionSize. Memory of small blocks is kept in the spans until the allocator is destroyed.
+  /// Larger allocations, and all allocations once MaxSpanRegions regions are in use, come from the system heap with a small header.
+  ///
+  /// Like ezHeapAllocation, this policy does not guarantee alignments larger than 16 bytes.
+  ///
+  /// \see ezAllocator
+  class EZ_FOUNDATION_DLL ezThreadCachingAllocation
+  {
+  public:
+    enum
+    {
+      SpanSize = 64 * 1024,
+      SpanHeaderSize = 64,
+      MaxSmallSize = 8 * 1024,
+      NumSizeClasses = 32,
+      MaxThreadCachesPerThread = 8,
+      MinSpanRegionSize = 16 * SpanSize,
+      MaxSpanRegionSize = 1024 * SpanSize,
+      MaxSpanRegions = 64,
+    };
+
+    ezThreadCachingAllocation(ezAllocatorBase* pParent);
+    ~ezThreadCachingAllocation();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void Deallocate(void* ptr);
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return nullptr; }
+
+    /// \brief Returns the size class index that is used for allocations of the given size, which must not be larger than MaxSmallSize.
+    static ezUInt32 GetSizeClass(size_t uiSize);
+
+    /// \brief Returns the size of the blocks of the given size class.
+    static ezUInt32 GetSizeClassBlockSize(ezUInt32 uiSizeClass);
+
+    /// \brief Gives the cached blocks of the calling thread back to all allocators, which makes them available to other threads.
+    ///
+    /// This is called automatically when a thread exits, but can also be called when a thread won't allocate for a long time.
+    static void ReleaseThreadCachesOfThisThread();
+
+  private:
+    struct SpanHeader;
+    struct ThreadCache;
+
+    struct SpanRegion
+    {
+      void* m_pAllocation;
+      ezUInt8* m_pFirstSpan;
+      ezUInt8* m_pEnd;
+    };
+
+    struct CentralList
+    {
+      ezMutex m_Mutex;
+      void* m_pFreeList = nullptr;
+    };
+
+    static ezThreadCachingAllocation* FindInstance(ezInt64 iInstanceId);
+
+    ThreadCache* GetThreadCache();
+    ThreadCache* CreateThreadCache();
+    void ReleaseThreadCache(ThreadCache* pCache);
+
+    void* AllocateFromHeap(size_t uiSize);
+    bool IsInSpanRegion(const void* ptr) const;
+
+    /// \brief Returns a new span from the current region, or nullptr if no more regions can be reserved.
+    SpanHeader* AllocateSpan();
+
+    /// \brief Removes up to uiMaxBlocks blocks from the central list and returns them as a linked list. Allocates a new span if necessary.
+    ///
+    /// Returns nullptr, if no new span could be allocated.
+    void* AllocateFromCentral(ezUInt32 uiSizeClass, ezUInt32 uiMaxBlocks, ezUInt32& out_uiNumBlocks);
+
+    /// \brief Puts the linked list of blocks from pFirst to pLast back into the central list.
+    void ReturnToCentral(ezUInt32 uiSizeClass, void* pFirst, void* pLast);
+
+    ezAlignedHeapAllocation m_HeapAllocation;
+
+    ezInt64 m_iInstanceId;
+    ezThreadCachingAllocation* m_pNextInstance = nullptr;
+
+    ezMutex m_Mutex;
+    ThreadCache* m_pThreadCaches = nullptr;
+
+    // regions are only ever added while the allocator exists, so they can be searched without a lock up to m_iNumSpanRegions
+    SpanRegion m_SpanRegions[MaxSpanRegions];
+    ezInt32 m_iNumSpanRegions = 0;
+    ezUInt8* m_pNextSpan = nullptr;
+
+    CentralList m_CentralLists[NumSizeClasses];
+  };
+} // namespace ezMemoryPolicies
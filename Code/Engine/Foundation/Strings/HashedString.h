@@ -14,7 +14,8 @@ class ezTempHashedString;
 /// (it's a pointer comparison).\n
 /// Copying ezHashedString objects around and assigning between them is very fast as well.\n
 /// \n
-/// Assigning from some other string type is rather slow though, as it requires thread synchronization.\n
+/// Assigning from some other string type is slower, as the string has to be hashed and looked up in the central storage.
+/// Looking up a string that is already stored does not take any lock though, only adding a new string requires thread synchronization.\n
 /// You can also get access to the actual string data via GetString().\n
 /// \n
 /// You should use ezHashedString whenever the size of the encapsulating object is important and when changes to the string itself
@@ -44,6 +45,7 @@ public:
   /// the storage, as it might be reused later again.
   /// This function will clean up all unused strings. It should typically not be necessary to call this function at all, unless lots of
   /// strings get stored in ezHashedString that are not really used throughout the applications life time.
+  /// It has to wait for concurrent lookups on other threads to finish, so it should not be called frequently.
   ///
   /// Returns the number of unused strings that were removed.
   static ezUInt32 ClearUnusedStrings();
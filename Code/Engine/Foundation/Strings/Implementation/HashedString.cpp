@@ -2,18 +2,220 @@
 
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicUtils.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadUtils.h>
 
-struct HashedStringData
+// The string storage is split into shards, selected by the lowest bits of the hash, to reduce contention on the mutexes.
+// Every shard additionally has an insert-only, open addressing lookup table, which references all strings of its map.
+// Looking up a string that already exists only probes that table and increments the ref count, it never takes the mutex.
+// The mutex is only needed to add new strings, to grow the table and to remove unused strings.
+//
+// Removing strings (ClearUnusedStrings) builds and publishes a new table without the unused strings and then waits until all
+// lookups that might still see the old table are finished, before the map entries and the old tables are actually deleted.
+// For that every lookup registers itself in one of two reader counters. Which one is used is toggled by the writer, so that new lookups
+// can't keep the writer waiting forever.
+
+namespace
 {
-  ezMutex m_Mutex;
-  ezHashedString::StringStorage m_Storage;
-  ezHashedString::HashedType m_Empty;
-};
+  enum
+  {
+    NumShardsBits = 6,
+    NumShards = 1 << NumShardsBits,
+    MinTableSize = 16,
+  };
+
+  struct LookupTable
+  {
+    ezUInt32 m_uiMask = 0;
+    ezUInt32 m_uiCount = 0;
+    void* volatile* m_pSlots = nullptr;
+  };
+
+  struct HashedStringShard
+  {
+    ezMutex m_Mutex;
+    ezHashedString::StringStorage m_Storage;
+
+    LookupTable* volatile m_pTable = nullptr;
+    ezDynamicArray<LookupTable*, ezStaticAllocatorWrapper> m_RetiredTables;
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    volatile ezInt32 m_iReaderEpoch = 0;
+    volatile ezInt32 m_iActiveReaders[2] = {};
+#endif
+  };
+
+  struct HashedStringData
+  {
+    HashedStringShard m_Shards[NumShards];
+    ezHashedString::HashedType m_Empty;
+  };
+} // namespace
 
 static HashedStringData* s_pHSData;
 
+EZ_CHECK_AT_COMPILETIME_MSG(sizeof(ezHashedString::HashedType) == sizeof(void*), "The lookup tables store HashedType as a pointer.");
+
+static EZ_ALWAYS_INLINE void* ToSlot(const ezHashedString::HashedType& it)
+{
+  void* pSlot;
+  ezMemoryUtils::RawByteCopy(&pSlot, &it, sizeof(void*));
+  return pSlot;
+}
+
+static EZ_ALWAYS_INLINE ezHashedString::HashedType FromSlot(void* pSlot)
+{
+  ezHashedString::HashedType it;
+  ezMemoryUtils::RawByteCopy(&it, &pSlot, sizeof(void*));
+  return it;
+}
+
+static EZ_ALWAYS_INLINE HashedStringShard& GetShard(ezUInt64 uiHash)
+{
+  return s_pHSData->m_Shards[uiHash & (NumShards - 1)];
+}
+
+static EZ_ALWAYS_INLINE ezUInt32 GetFirstSlot(ezUInt64 uiHash, ezUInt32 uiMask)
+{
+  // the lowest bits are already used to select the shard
+  return static_cast<ezUInt32>(uiHash >> NumShardsBits) & uiMask;
+}
+
+static LookupTable* CreateLookupTable(ezUInt32 uiSize)
+{
+  ezAllocatorBase* pAllocator = ezStaticAllocatorWrapper::GetAllocator();
+
+  LookupTable* pTable = EZ_NEW(pAllocator, LookupTable);
+  pTable->m_uiMask = uiSize - 1;
+
+  void** pSlots = EZ_NEW_RAW_BUFFER(pAllocator, void*, uiSize);
+  ezMemoryUtils::ZeroFill(pSlots, uiSize);
+  pTable->m_pSlots = pSlots;
+
+  return pTable;
+}
+
+static void DestroyLookupTable(LookupTable* pTable)
+{
+  ezAllocatorBase* pAllocator = ezStaticAllocatorWrapper::GetAllocator();
+
+  void** pSlots = const_cast<void**>(pTable->m_pSlots);
+  EZ_DELETE_RAW_BUFFER(pAllocator, pSlots);
+  EZ_DELETE(pAllocator, pTable);
+}
+
+/// \brief Must only be called while the shard is locked. The table must have a free slot.
+static void InsertIntoLookupTable(LookupTable* pTable, const ezHashedString::HashedType& it)
+{
+  ezUInt32 uiSlot = GetFirstSlot(it.Key(), pTable->m_uiMask);
+
+  while (pTable->m_pSlots[uiSlot] != nullptr)
+  {
+    uiSlot = (uiSlot + 1) & pTable->m_uiMask;
+  }
+
+  // full barrier, the entry has to be completely set up before a lookup on another thread can find it
+  ezAtomicUtils::TestAndSet(const_cast<void**>(&pTable->m_pSlots[uiSlot]), nullptr, ToSlot(it));
+  ++pTable->m_uiCount;
+}
+
+/// \brief Makes the table visible to lookups on other threads. Must only be called while the shard is locked.
+static void PublishLookupTable(HashedStringShard& shard, LookupTable* pTable)
+{
+  LookupTable* pOldTable = shard.m_pTable;
+  ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(const_cast<LookupTable**>(&shard.m_pTable)), pOldTable, pTable);
+
+  if (pOldTable != nullptr)
+  {
+    // lookups on other threads might still use the old table, it is only deleted once that is guaranteed not to be the case anymore
+    shard.m_RetiredTables.PushBack(pOldTable);
+  }
+}
+
+/// \brief Must only be called while the shard is locked. Makes sure the table is at most half full after inserting one more string.
+static LookupTable* ReserveLookupTable(HashedStringShard& shard)
+{
+  LookupTable* pTable = shard.m_pTable;
+
+  if (pTable != nullptr && (pTable->m_uiCount + 1) * 2 <= pTable->m_uiMask + 1)
+    return pTable;
+
+  ezUInt32 uiNewSize = MinTableSize;
+  while (uiNewSize < (shard.m_Storage.GetCount() + 1) * 2)
+  {
+    uiNewSize *= 2;
+  }
+
+  LookupTable* pNewTable = CreateLookupTable(uiNewSize);
+  for (auto it = shard.m_Storage.GetIterator(); it.IsValid(); ++it)
+  {
+    InsertIntoLookupTable(pNewTable, it);
+  }
+
+  PublishLookupTable(shard, pNewTable);
+  return pNewTable;
+}
+
+/// \brief Looks up an existing string without taking the shard's mutex and increases its refcount.
+static bool TryFindHashedString(HashedStringShard& shard, ezStringView szString, ezUInt64 uiHash, ezHashedString::HashedType& out_Result)
+{
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+  // register this lookup, so that ClearUnusedStrings does not delete anything that this thread might still access
+  ezInt32 iEpoch = shard.m_iReaderEpoch;
+  while (true)
+  {
+    ezAtomicUtils::Increment(shard.m_iActiveReaders[iEpoch & 1]);
+
+    const ezInt32 iCurrentEpoch = shard.m_iReaderEpoch;
+    if (iCurrentEpoch == iEpoch)
+      break;
+
+    // the writer toggled the counters in between, it might not wait for the one we registered in
+    ezAtomicUtils::Decrement(shard.m_iActiveReaders[iEpoch & 1]);
+    iEpoch = iCurrentEpoch;
+  }
+#endif
+
+  bool bFound = false;
+
+  if (const LookupTable* pTable = shard.m_pTable)
+  {
+    ezUInt32 uiSlot = GetFirstSlot(uiHash, pTable->m_uiMask);
+
+    while (void* pSlot = pTable->m_pSlots[uiSlot])
+    {
+      ezHashedString::HashedType it = FromSlot(pSlot);
+
+      if (it.Key() == uiHash)
+      {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+        // let the locked code path report the hash collision
+        if (it.Value().m_sString != szString)
+          break;
+#endif
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+        it.Value().m_iRefCount.Increment();
+#endif
+
+        out_Result = it;
+        bFound = true;
+        break;
+      }
+
+      uiSlot = (uiSlot + 1) & pTable->m_uiMask;
+    }
+  }
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+  ezAtomicUtils::Decrement(shard.m_iActiveReaders[iEpoch & 1]);
+#endif
+
+  return bFound;
+}
+
 EZ_MSVC_ANALYSIS_WARNING_PUSH
 EZ_MSVC_ANALYSIS_WARNING_DISABLE(6011) // Disable warning for null pointer dereference as InitHashedString() will ensure that s_pHSData is set
 
@@ -23,11 +225,17 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView szString
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  EZ_LOCK(s_pHSData->m_Mutex);
+  HashedStringShard& shard = GetShard(uiHash);
+
+  HashedType ret;
+  if (TryFindHashedString(shard, szString, uiHash, ret))
+    return ret;
+
+  EZ_LOCK(shard.m_Mutex);
 
   // try to find the existing string
   bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  ret = shard.m_Storage.FindOrAdd(uiHash, &bExisted);
 
   // if it already exists, just increase the refcount
   if (bExisted)
@@ -51,6 +259,14 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView szString
     d.m_iRefCount = 1;
 #endif
     d.m_sString = szString;
+
+    LookupTable* pTable = ReserveLookupTable(shard);
+
+    // if the table was just rebuilt, it already contains the new string
+    if (pTable->m_uiCount < shard.m_Storage.GetCount())
+    {
+      InsertIntoLookupTable(pTable, ret);
+    }
   }
 
   return ret;
@@ -79,19 +295,65 @@ void ezHashedString::InitHashedString()
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
 ezUInt32 ezHashedString::ClearUnusedStrings()
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
-
   ezUInt32 uiDeleted = 0;
+  ezDynamicArray<HashedType> unusedStrings;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (ezUInt32 uiShard = 0; uiShard < NumShards; ++uiShard)
   {
-    if (it.Value().m_iRefCount == 0)
+    HashedStringShard& shard = s_pHSData->m_Shards[uiShard];
+    EZ_LOCK(shard.m_Mutex);
+
+    if (shard.m_pTable == nullptr)
+      continue;
+
+    unusedStrings.Clear();
+
+    // build a table that only contains the strings that are still in use, lookups on other threads can't find the other ones anymore
+    LookupTable* pNewTable = CreateLookupTable(shard.m_pTable->m_uiMask + 1);
+    for (auto it = shard.m_Storage.GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Value().m_iRefCount == 0)
+        unusedStrings.PushBack(it);
+      else
+        InsertIntoLookupTable(pNewTable, it);
+    }
+
+    if (unusedStrings.IsEmpty() && shard.m_RetiredTables.IsEmpty())
+    {
+      DestroyLookupTable(pNewTable);
+      continue;
+    }
+
+    PublishLookupTable(shard, pNewTable);
+
+    // toggle the reader counters and wait until all lookups that might have seen the old table are finished
+    const ezInt32 iOldEpoch = shard.m_iReaderEpoch;
+    ezAtomicUtils::Set(shard.m_iReaderEpoch, iOldEpoch + 1);
+
+    while (ezAtomicUtils::Read(shard.m_iActiveReaders[iOldEpoch & 1]) != 0)
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    for (HashedType it : unusedStrings)
+    {
+      // a lookup on another thread might have found the string in the old table and started using it again
+      if (it.Value().m_iRefCount == 0)
+      {
+        shard.m_Storage.Remove(it);
+        ++uiDeleted;
+      }
+      else
+      {
+        InsertIntoLookupTable(pNewTable, it);
+      }
+    }
+
+    for (LookupTable* pTable : shard.m_RetiredTables)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      DestroyLookupTable(pTable);
     }
-    else
-      ++it;
+    shard.m_RetiredTables.Clear();
   }
 
   return uiDeleted;
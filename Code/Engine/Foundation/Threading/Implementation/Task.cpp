@@ -29,13 +29,51 @@ void ezTask::SetMultiplicity(ezUInt32 uiMultiplicity)
   m_bUsesMultiplicity = m_uiMultiplicity > 0;
 }
 
-void ezTask::Run(ezUInt32 uiInvocation)
+ezUInt32 ezTask::BeginSchedule(ezUInt32 uiNumInvocations)
 {
-  // actually this should not be possible to happen
-  if (m_iRemainingRuns == 0 || m_bCancelExecution)
+  const ezUInt32 uiScheduleCounter = static_cast<ezUInt32>(static_cast<ezUInt64>(m_iScheduleState) >> 32) + 1;
+  m_iScheduleState = static_cast<ezInt64>((static_cast<ezUInt64>(uiScheduleCounter) << 32) | uiNumInvocations);
+  return uiScheduleCounter;
+}
+
+bool ezTask::ClaimInvocation(ezUInt32 uiScheduleCounter)
+{
+  while (true)
+  {
+    const ezInt64 iState = m_iScheduleState;
+
+    const ezUInt64 uiState = static_cast<ezUInt64>(iState);
+    if (static_cast<ezUInt32>(uiState >> 32) != uiScheduleCounter || static_cast<ezUInt32>(uiState) == 0)
+      return false;
+
+    if (m_iScheduleState.TestAndSet(iState, iState - 1))
+      return true;
+  }
+}
+
+ezUInt32 ezTask::ClaimRemainingInvocations()
+{
+  while (true)
+  {
+    const ezInt64 iState = m_iScheduleState;
+
+    const ezUInt64 uiState = static_cast<ezUInt64>(iState);
+    const ezUInt32 uiUnclaimed = static_cast<ezUInt32>(uiState);
+
+    if (uiUnclaimed == 0)
+      return 0;
+
+    if (m_iScheduleState.TestAndSet(iState, static_cast<ezInt64>(uiState & 0xFFFFFFFF00000000ull)))
+      return uiUnclaimed;
+  }
+}
+
+bool ezTask::Run(ezUInt32 uiInvocation)
+{
+  // invocations that were claimed right before the task got canceled still count as finished
+  if (m_bCancelExecution)
   {
-    m_iRemainingRuns = 0;
-    return;
+    return m_iRemainingRuns.Decrement() == 0;
   }
 
   {
@@ -56,7 +94,7 @@ void ezTask::Run(ezUInt32 uiInvocation)
     }
   }
 
-  m_iRemainingRuns.Decrement();
+  return m_iRemainingRuns.Decrement() == 0;
 }
 
 
@@ -81,12 +81,27 @@ private:
 
   void Reset();
 
-  /// \brief Called by ezTaskSystem to execute the task. Calls 'Execute' internally.
-  void Run(ezUInt32 uiInvocation);
+  /// \brief Called by ezTaskSystem to execute the task. Calls 'Execute' internally. Returns true, if this was the last remaining run.
+  bool Run(ezUInt32 uiInvocation);
 
-  /// \brief Decremented when a task is finished, set to zero when canceled.
+  /// \brief Called when the task gets queued for execution with the given number of invocations. Returns the new schedule counter.
+  ezUInt32 BeginSchedule(ezUInt32 uiNumInvocations);
+
+  /// \brief Tries to claim one queued invocation. Fails if the invocation has been canceled or the task has been rescheduled since.
+  bool ClaimInvocation(ezUInt32 uiScheduleCounter);
+
+  /// \brief Claims all invocations that have not been picked up by a worker yet and returns how many that were.
+  ezUInt32 ClaimRemainingInvocations();
+
+  /// \brief Decremented when a task is finished, reduced by the number of canceled invocations when canceled.
   ezAtomicInteger32 m_iRemainingRuns;
 
+  /// \brief The upper 32 bits store how often the task was scheduled, the lower 32 bits how many queued invocations were not claimed yet.
+  ///
+  /// The queues of the ezTaskSystem cannot remove arbitrary elements. Instead, canceling a task claims all of its queued invocations at once
+  /// and the queue entries that are picked up later are simply discarded.
+  ezAtomicInteger64 m_iScheduleState;
+
   /// \brief Set to true when the task is SUPPOSED to cancel. Whether the task is able to do that, depends on its implementation.
   bool m_bCancelExecution = false;
 
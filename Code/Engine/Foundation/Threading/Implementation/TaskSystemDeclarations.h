@@ -25,7 +25,7 @@ class ezAllocatorBase;
 /// Once 'ezTaskSystem::FinishFrameTasks' is called, all those tasks will be moved into the 'XYZThisFrame' categories.\n
 /// For tasks that run over a longer period (e.g. path searches, procedural data creation), use 'LongRunning'.
 /// Only use 'LongRunningHighPriority' for tasks that occur rarely, otherwise 'LongRunning' tasks might not get processed, at all.\n
-/// For tasks that need to access files, prefer to use 'FileAccess', this way all file accesses get executed sequentially.\n
+/// For tasks that need to access files, prefer to use 'FileAccess', this way all file accesses get executed sequentially (by default).\n
 /// Use 'FileAccessHighPriority' to get very important file accesses done sooner. For example writing out a save-game should finish
 /// quickly.\n For tasks that need to execute on the main thread (e.g. uploading GPU resources) use 'ThisFrameMainThread' or
 /// 'SomeFrameMainThread' depending on how urgent it is. 'SomeFrameMainThread' tasks might get delayed for quite a while, depending on the
@@ -58,10 +58,12 @@ struct ezTaskPriority
     LongRunningHighPriority,  ///< Tasks that might take a while, but should be preferred over 'LongRunning' tasks. Use this priority only
                               ///< rarely, otherwise 'LongRunning' tasks might never get executed.
     LongRunning,              ///< Use this priority for tasks that might run for a while.
-    FileAccessHighPriority,   ///< For tasks that require file access (e.g. resource loading). They run on one dedicated thread, such that
-                              ///< file accesses are done sequentially and never in parallel.
-    FileAccess,               ///< For tasks that require file access (e.g. resource loading). They run on one dedicated thread, such that file accesses
-                              ///< are done sequentially and never in parallel.
+    FileAccessHighPriority,   ///< For tasks that require file access (e.g. resource loading). By default they run on one dedicated thread,
+                              ///< such that file accesses are done sequentially and never in parallel.
+                              ///< See ezTaskSystem::SetWorkerThreadCount().
+    FileAccess,               ///< For tasks that require file access (e.g. resource loading). By default they run on one dedicated thread,
+                              ///< such that file accesses are done sequentially and never in parallel.
+                              ///< See ezTaskSystem::SetWorkerThreadCount().
     ThisFrameMainThread,      ///< Tasks that need to be executed this frame, but in the main thread. This is mostly intended for resource
                               ///< creation.
     SomeFrameMainThread,      ///< Tasks that have no hard deadline but need to be executed in the main thread. This is mostly intended for
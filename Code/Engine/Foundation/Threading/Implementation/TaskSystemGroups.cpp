@@ -165,18 +165,19 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
     {
       auto& pTask = pGroup->m_Tasks[task];
 
-      for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
+      const ezUInt32 uiNumInvocations = ezMath::Max(1u, pTask->m_uiMultiplicity);
+      const ezUInt32 uiScheduleCounter = pTask->BeginSchedule(uiNumInvocations);
+      pTask->m_bTaskIsScheduled = true;
+
+      for (ezUInt32 mult = 0; mult < uiNumInvocations; ++mult)
       {
         TaskData td;
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
         td.m_uiInvocation = mult;
+        td.m_uiScheduleCounter = uiScheduleCounter;
 
-        if (bHighPriority)
-          s_State->m_Tasks[pGroup->m_Priority].PushFront(td);
-        else
-          s_State->m_Tasks[pGroup->m_Priority].PushBack(td);
+        EnqueueTask(pGroup->m_Priority, std::move(td), bHighPriority);
       }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 class ezTaskSystemThreadState
@@ -23,12 +24,27 @@ class ezTaskSystemState
 private:
   friend class ezTaskSystem;
 
+  // Tasks that were scheduled by threads without a local deque (e.g. the main thread) or that did not fit into one.
+  struct InjectionQueue
+  {
+    ezMutex m_Mutex;
+    ezDeque<ezTaskSystem::TaskData> m_Tasks;
+  };
+
   // The target frame time used by FinishFrameTasks()
   ezTime m_TargetFrameTime = ezTime::Seconds(1.0 / 40.0); // => 25 ms
 
   // The deque can grow without relocating existing data, therefore the ezTaskGroupID's can store pointers directly to the data
   ezDeque<ezTaskGroup> m_TaskGroups;
 
-  // The lists of all scheduled tasks, for each priority.
-  ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+  // The injection queues for each priority.
+  InjectionQueue m_InjectionQueues[ezTaskPriority::ENUM_COUNT];
+
+  // Tasks that a thread which helps out while waiting (see ezTaskSystem::HelpExecutingTasks()) has dequeued, but was not allowed to run.
+  // Only threads without that restriction take tasks from here, so the helping threads never look at the same task twice.
+  InjectionQueue m_DeferredQueues[ezTaskPriority::ENUM_COUNT];
+
+  // The number of queued tasks for each priority, summed up over the injection queue, the deferred queue and all worker deques.
+  // Allows to skip empty priorities without looking at every single queue.
+  ezAtomicInteger32 m_iQueuedTasks[ezTaskPriority::ENUM_COUNT];
 };
@@ -26,14 +26,20 @@ ezTaskGroupID ezTaskSystem::StartSingleTask(
   return Group;
 }
 
-void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup* pGroup)
+void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup* pGroup, ezUInt32 uiNumInvocations /*= 1*/)
 {
-  if (pTask && pTask->m_OnTaskFinished.IsValid() && pTask->m_iRemainingRuns == 0)
+  if (pTask && pTask->m_OnTaskFinished.IsValid())
   {
     pTask->m_OnTaskFinished(pTask);
   }
 
-  if (pGroup->m_iNumRemainingTasks.Decrement() == 0)
+  bool bGroupFinished = false;
+  for (ezUInt32 i = 0; i < uiNumInvocations; ++i)
+  {
+    bGroupFinished = (pGroup->m_iNumRemainingTasks.Decrement() == 0);
+  }
+
+  if (bGroupFinished)
   {
     // If this was the last task that had to be finished from this group, make sure all dependent groups are started
 
@@ -78,6 +84,109 @@ void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup
   }
 }
 
+void ezTaskSystem::EnqueueTask(ezUInt32 uiPriority, TaskData&& td, bool bHighPriority)
+{
+  // count first, such that a worker that goes idle afterwards is guaranteed to see this task (see GetNextTask)
+  s_State->m_iQueuedTasks[uiPriority].Increment();
+
+  if (tl_TaskWorkerInfo.m_pWorkerThread != nullptr)
+  {
+    if (ezTaskWorkStealingDeque* pQueue = tl_TaskWorkerInfo.m_pWorkerThread->GetLocalQueue(uiPriority))
+    {
+      // the local deque is LIFO for its owner, so tasks pushed last (e.g. high priority dependencies) are picked up first
+      if (pQueue->PushBottom(std::move(td)))
+        return;
+    }
+  }
+
+  auto& injection = s_State->m_InjectionQueues[uiPriority];
+  EZ_LOCK(injection.m_Mutex);
+
+  if (bHighPriority)
+    injection.m_Tasks.PushFront(std::move(td));
+  else
+    injection.m_Tasks.PushBack(std::move(td));
+}
+
+bool ezTaskSystem::DequeueTask(ezUInt32 uiPriority, TaskData& out_td, bool bIncludeDeferred)
+{
+  if (s_State->m_iQueuedTasks[uiPriority] <= 0)
+    return false;
+
+  bool bFound = false;
+
+  // 1. our own deque, the tasks in there are most likely still in the cache
+  if (tl_TaskWorkerInfo.m_pWorkerThread != nullptr)
+  {
+    if (ezTaskWorkStealingDeque* pQueue = tl_TaskWorkerInfo.m_pWorkerThread->GetLocalQueue(uiPriority))
+    {
+      bFound = pQueue->PopBottom(out_td);
+    }
+  }
+
+  // 2. tasks that waiting threads have set aside, these have been queued for a while already
+  if (!bFound && bIncludeDeferred)
+  {
+    auto& deferred = s_State->m_DeferredQueues[uiPriority];
+    EZ_LOCK(deferred.m_Mutex);
+
+    if (!deferred.m_Tasks.IsEmpty())
+    {
+      out_td = std::move(deferred.m_Tasks.PeekFront());
+      deferred.m_Tasks.PopFront();
+      bFound = true;
+    }
+  }
+
+  // 3. the injection queue, this is where tasks from the main thread end up
+  if (!bFound)
+  {
+    auto& injection = s_State->m_InjectionQueues[uiPriority];
+    EZ_LOCK(injection.m_Mutex);
+
+    if (!injection.m_Tasks.IsEmpty())
+    {
+      out_td = std::move(injection.m_Tasks.PeekFront());
+      injection.m_Tasks.PopFront();
+      bFound = true;
+    }
+  }
+
+  // 4. steal from the other worker threads, start at a different victim each time to spread the contention
+  if (!bFound)
+  {
+    const ezWorkerThreadType::Enum victimType = GetWorkerThreadTypeForPriority(static_cast<ezTaskPriority::Enum>(uiPriority));
+
+    if (victimType != ezWorkerThreadType::MainThread)
+    {
+      static thread_local ezUInt32 tl_uiNextVictim = 0;
+
+      const ezUInt32 uiNumVictims = s_ThreadState->m_iAllocatedWorkers[victimType];
+      const ezUInt32 uiFirstVictim = tl_uiNextVictim++;
+
+      for (ezUInt32 i = 0; i < uiNumVictims && !bFound; ++i)
+      {
+        ezTaskWorkerThread* pVictim = s_ThreadState->m_Workers[victimType][(uiFirstVictim + i) % uiNumVictims];
+
+        if (pVictim == tl_TaskWorkerInfo.m_pWorkerThread)
+          continue;
+
+        if (ezTaskWorkStealingDeque* pQueue = pVictim->GetLocalQueue(uiPriority))
+        {
+          bFound = pQueue->Steal(out_td);
+        }
+      }
+    }
+  }
+
+  if (bFound)
+  {
+    s_State->m_iQueuedTasks[uiPriority].Decrement();
+  }
+
+  return bFound;
+}
+
 ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
   const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState)
 {
@@ -86,29 +195,75 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  EZ_LOCK(s_TaskSystemMutex);
-
-  // go through all the task lists that this thread is willing to work on
-  for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+  while (true)
   {
-    for (auto it = s_State->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+    // go through all the task queues that this thread is willing to work on
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
     {
-      if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+      // the queues cannot skip elements, so tasks that this thread may not run are moved into the deferred queue
+      // threads that help out while waiting never take tasks from there, so every task is looked at by them at most once
+      ezUInt32 uiNumDeferred = 0;
+
+      TaskData td;
+      bool bFound = false;
+      while (DequeueTask(prio, td, !bOnlyTasksThatNeverWait))
       {
-        TaskData td = *it;
+        if (bOnlyTasksThatNeverWait && (td.m_pTask->m_NestingMode != ezTaskNesting::Never) && td.m_pBelongsToGroup != WaitingForGroup.m_pTaskGroup)
+        {
+          // count first, same as in EnqueueTask()
+          s_State->m_iQueuedTasks[prio].Increment();
 
-        s_State->m_Tasks[prio].Remove(it);
-        return td;
+          auto& deferred = s_State->m_DeferredQueues[prio];
+          EZ_LOCK(deferred.m_Mutex);
+          deferred.m_Tasks.PushBack(std::move(td));
+
+          ++uiNumDeferred;
+          continue;
+        }
+
+        // entries of canceled invocations are just dropped, the task has been marked as finished by CancelTask already
+        if (td.m_pTask->ClaimInvocation(td.m_uiScheduleCounter))
+        {
+          bFound = true;
+          break;
+        }
       }
+
+      // this thread is busy waiting, so make sure someone else picks up the tasks that it had to set aside
+      if (uiNumDeferred > 0)
+      {
+        const ezWorkerThreadType::Enum workerType = GetWorkerThreadTypeForPriority(static_cast<ezTaskPriority::Enum>(prio));
+
+        if (workerType != ezWorkerThreadType::MainThread)
+        {
+          WakeUpThreads(workerType, uiNumDeferred);
+        }
+      }
+
+      if (bFound)
+        return td;
     }
-  }
 
-  if (pWorkerState)
-  {
+    if (pWorkerState == nullptr)
+      return TaskData();
+
     EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
-  }
 
-  return TaskData();
+    // a task may have been queued after we looked at its queue, but before we went idle
+    // in that case the scheduling thread saw this thread as active and might not have woken up anyone
+    bool bTasksAvailable = false;
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+    {
+      bTasksAvailable |= s_State->m_iQueuedTasks[prio] > 0;
+    }
+
+    if (!bTasksAvailable)
+      return TaskData();
+
+    // try to become active again, if that fails, someone else already woke us up and the wake up signal is raised
+    if (pWorkerState->CompareAndSwap((int)ezTaskWorkerState::Idle, (int)ezTaskWorkerState::Active) != (int)ezTaskWorkerState::Idle)
+      return TaskData();
+  }
 }
 
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -129,12 +284,12 @@ bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriorit
 
   tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != ezTaskNesting::Never;
   tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
-  td.m_pTask->Run(td.m_uiInvocation);
+  const bool bTaskFinished = td.m_pTask->Run(td.m_uiInvocation);
   tl_TaskWorkerInfo.m_bAllowNestedTasks = true;
   tl_TaskWorkerInfo.m_szTaskName = nullptr;
 
   // notify the group, that a task is finished, which might trigger other tasks to be executed
-  TaskHasFinished(td.m_pTask, td.m_pBelongsToGroup);
+  TaskHasFinished(bTaskFinished ? td.m_pTask : nullptr, td.m_pBelongsToGroup);
 
   return true;
 }
@@ -164,32 +319,27 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
       pTask->m_iRemainingRuns = 0;
       return EZ_SUCCESS;
     }
+  }
 
-    // check if the task has already been scheduled for execution
-    // if so, remove it from the work queue
-    {
-      for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
-      {
-        auto it = s_State->m_Tasks[i].GetIterator();
-
-        while (it.IsValid())
-        {
-          if (it->m_pTask == pTask)
-          {
-            s_State->m_Tasks[i].Remove(it);
+  // the task has already been scheduled for execution
+  // claim all invocations that no worker has picked up yet, their queue entries will be discarded when they get dequeued
+  const ezUInt32 uiCanceledInvocations = pTask->ClaimRemainingInvocations();
 
-            // we set the task to finished, even though it was not executed
-            pTask->m_iRemainingRuns = 0;
+  if (uiCanceledInvocations > 0)
+  {
+    // we set the invocations to finished, even though they were not executed
+    bool bTaskFinished = false;
+    for (ezUInt32 i = 0; i < uiCanceledInvocations; ++i)
+    {
+      bTaskFinished = (pTask->m_iRemainingRuns.Decrement() == 0);
+    }
 
-            // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
-            TaskHasFinished(it->m_pTask, it->m_pBelongsToGroup);
-            return EZ_SUCCESS;
-          }
+    // tell the system that these invocations are 'finished', to ensure the group's dependencies will get scheduled
+    TaskHasFinished(bTaskFinished ? pTask : nullptr, pTask->m_BelongsToGroup.m_pTaskGroup, uiCanceledInvocations);
 
-          ++it;
-        }
-      }
-    }
+    // if no invocation is running anymore, we successfully prevented the execution
+    if (pTask->IsTaskFinished())
+      return EZ_SUCCESS;
   }
 
   // if we made it here, the task was already running
@@ -217,56 +367,39 @@ bool ezTaskSystem::HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup)
 
 void ezTaskSystem::ReprioritizeFrameTasks()
 {
+  // Moves all tasks from one priority into the injection queue of another one.
+  // Tasks that are picked up by other threads while we do this are fine, they just get executed a bit earlier.
+  auto MoveTasks = [](ezUInt32 uiFromPriority, ezUInt32 uiToPriority) {
+    TaskData td;
+    while (DequeueTask(uiFromPriority, td, true))
+    {
+      s_State->m_iQueuedTasks[uiToPriority].Increment();
+
+      auto& injection = s_State->m_InjectionQueues[uiToPriority];
+      EZ_LOCK(injection.m_Mutex);
+      injection.m_Tasks.PushBack(std::move(td));
+    }
+  };
+
   // There should usually be no 'this frame tasks' left at this time
   // however, while we waited to enter the lock, such tasks might have appeared
   // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
   for (ezUInt32 i = (ezUInt32)ezTaskPriority::ThisFrame; i <= (ezUInt32)ezTaskPriority::LateThisFrame; ++i)
   {
-    auto it = s_State->m_Tasks[i].GetIterator();
-
-    // move all 'this frame' tasks into the 'early this frame' queue
-    while (it.IsValid())
-    {
-      s_State->m_Tasks[ezTaskPriority::EarlyThisFrame].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_State->m_Tasks[i].Clear();
+    MoveTasks(i, ezTaskPriority::EarlyThisFrame);
   }
 
+  // move all 'next frame' tasks into the 'this frame' queues
   for (ezUInt32 i = (ezUInt32)ezTaskPriority::EarlyNextFrame; i <= (ezUInt32)ezTaskPriority::LateNextFrame; ++i)
   {
-    auto it = s_State->m_Tasks[i].GetIterator();
-
-    // move all 'next frame' tasks into the 'this frame' queues
-    while (it.IsValid())
-    {
-      s_State->m_Tasks[i - 3].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_State->m_Tasks[i].Clear();
+    MoveTasks(i, i - 3);
   }
 
+  // move all 'in N frames' tasks into the 'in N-1 frames' queues
+  // moves 'In2Frames' into 'LateNextFrame'
   for (ezUInt32 i = (ezUInt32)ezTaskPriority::In2Frames; i <= (ezUInt32)ezTaskPriority::In9Frames; ++i)
   {
-    auto it = s_State->m_Tasks[i].GetIterator();
-
-    // move all 'in N frames' tasks into the 'in N-1 frames' queues
-    // moves 'In2Frames' into 'LateNextFrame'
-    while (it.IsValid())
-    {
-      s_State->m_Tasks[i - 1].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_State->m_Tasks[i].Clear();
+    MoveTasks(i, i - 1);
   }
 }
 
@@ -307,8 +440,7 @@ void ezTaskSystem::ExecuteSomeFrameTasks(ezTime smoothFrameTime)
   ezUInt32 uiNumTasksTodo = 0;
 
   {
-    EZ_LOCK(s_TaskSystemMutex);
-    uiNumTasksTodo = s_State->m_Tasks[ezTaskPriority::SomeFrameMainThread].GetCount();
+    uiNumTasksTodo = ezMath::Max(0, (ezInt32)s_State->m_iQueuedTasks[ezTaskPriority::SomeFrameMainThread]);
   }
 
   if (uiNumTasksTodo == 0)
@@ -16,7 +16,7 @@ ezUInt32 ezTaskSystem::GetNumAllocatedWorkerThreads(ezWorkerThreadType::Enum typ
   return s_ThreadState->m_iAllocatedWorkers[type];
 }
 
-void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
+void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks, ezInt32 iFileAccessTasks)
 {
   ezSystemInformation info = ezSystemInformation::Get();
 
@@ -33,15 +33,19 @@ void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
   if (iLongTasks <= 0)
     iLongTasks = ezMath::Clamp<ezInt32>(iCpuCores - 2, 2, 8);
 
-  // plus there is always one additional 'file access' thread
-  // and the main thread, of course
+  // by default there is one 'file access' thread, such that file accesses are done sequentially
+  // plus the main thread, of course
+  if (iFileAccessTasks <= 0)
+    iFileAccessTasks = 1;
 
   ezUInt32 uiShortTasks = static_cast<ezUInt32>(ezMath::Max<ezInt32>(iShortTasks, 1));
   ezUInt32 uiLongTasks = static_cast<ezUInt32>(ezMath::Max<ezInt32>(iLongTasks, 1));
+  ezUInt32 uiFileAccessTasks = static_cast<ezUInt32>(ezMath::Clamp<ezInt32>(iFileAccessTasks, 1, 128));
 
   // if nothing has changed, do nothing
   if (s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks] == uiShortTasks &&
-      s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] == uiLongTasks)
+      s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] == uiLongTasks &&
+      s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] == uiFileAccessTasks)
     return;
 
   StopWorkerThreads();
@@ -53,7 +57,7 @@ void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
 
   s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks] = uiShortTasks;
   s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] = uiLongTasks;
-  s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] = 1;
+  s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] = uiFileAccessTasks;
 
   AllocateThreads(ezWorkerThreadType::ShortTasks, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks]);
   AllocateThreads(ezWorkerThreadType::LongTasks, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks]);
@@ -92,8 +96,25 @@ void ezTaskSystem::StopWorkerThreads()
 
     for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
     {
-      s_ThreadState->m_Workers[type][i]->Join();
-      EZ_DEFAULT_DELETE(s_ThreadState->m_Workers[type][i]);
+      ezTaskWorkerThread* pWorker = s_ThreadState->m_Workers[type][i];
+      pWorker->Join();
+
+      // tasks that are still queued on this thread stay in the system, the next worker threads will execute them
+      for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+      {
+        if (ezTaskWorkStealingDeque* pQueue = pWorker->GetLocalQueue(prio))
+        {
+          TaskData td;
+          while (pQueue->Steal(td))
+          {
+            auto& injection = s_State->m_InjectionQueues[prio];
+            EZ_LOCK(injection.m_Mutex);
+            injection.m_Tasks.PushBack(std::move(td));
+          }
+        }
+      }
+
+      EZ_DEFAULT_DELETE(pWorker);
     }
 
     s_ThreadState->m_iAllocatedWorkers[type] = 0;
@@ -192,7 +213,12 @@ double ezTaskSystem::GetThreadUtilization(ezWorkerThreadType::Enum Type, ezUInt3
 
 void ezTaskSystem::DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority)
 {
-  switch (tl_TaskWorkerInfo.m_WorkerType)
+  DetermineTasksToExecuteOnThreadType(tl_TaskWorkerInfo.m_WorkerType, out_FirstPriority, out_LastPriority);
+}
+
+void ezTaskSystem::DetermineTasksToExecuteOnThreadType(ezWorkerThreadType::Enum type, ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority)
+{
+  switch (type)
   {
     case ezWorkerThreadType::MainThread:
     {
@@ -238,5 +264,25 @@ void ezTaskSystem::DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_Fir
   }
 }
 
+ezWorkerThreadType::Enum ezTaskSystem::GetWorkerThreadTypeForPriority(ezTaskPriority::Enum priority)
+{
+  switch (priority)
+  {
+    case ezTaskPriority::LongRunningHighPriority:
+    case ezTaskPriority::LongRunning:
+      return ezWorkerThreadType::LongTasks;
+
+    case ezTaskPriority::FileAccessHighPriority:
+    case ezTaskPriority::FileAccess:
+      return ezWorkerThreadType::FileAccess;
+
+    case ezTaskPriority::ThisFrameMainThread:
+    case ezTaskPriority::SomeFrameMainThread:
+      return ezWorkerThreadType::MainThread;
+
+    default:
+      return ezWorkerThreadType::ShortTasks;
+  }
+}
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystemThreads);
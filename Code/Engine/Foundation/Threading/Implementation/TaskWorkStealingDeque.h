@@ -0,0 +1,124 @@
+#pragma once
+
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \internal Fixed size, lock-free work-stealing deque (Chase-Lev) for scheduled tasks.
+///
+/// Only the owning worker thread may call PushBottom() and PopBottom(). All other threads may call Steal() at any time.
+/// The elements are moved in and out of the deque bitwise (ezTaskSystem::TaskData is memory relocatable),
+/// which means a thread that successfully pops or steals an element takes over the reference held by the deque.
+/// A steal that loses the race against another thread only ever reads a copy of the bytes and discards it without touching the reference.
+class ezTaskWorkStealingDeque
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingDeque);
+
+public:
+  enum
+  {
+    Capacity = 128,
+    CapacityMask = Capacity - 1,
+  };
+
+  ezTaskWorkStealingDeque() = default;
+
+  ~ezTaskWorkStealingDeque()
+  {
+    ezTaskSystem::TaskData td;
+    while (PopBottom(td))
+    {
+    }
+  }
+
+  /// \brief Adds the task to the bottom of the deque. Returns false, if the deque is full. Only allowed on the owning thread.
+  bool PushBottom(ezTaskSystem::TaskData&& td)
+  {
+    const ezInt64 b = m_iBottom;
+    const ezInt64 t = m_iTop;
+
+    if (b - t >= Capacity)
+      return false;
+
+    ezMemoryUtils::RawByteCopy(&m_Slots[b & CapacityMask], &td, sizeof(ezTaskSystem::TaskData));
+    new (&td) ezTaskSystem::TaskData(); // the reference now belongs to the deque
+
+    // publishing the new bottom is a full barrier, so the slot is written before anyone can steal it
+    m_iBottom.Set(b + 1);
+    return true;
+  }
+
+  /// \brief Takes the most recently pushed task (LIFO). Only allowed on the owning thread.
+  bool PopBottom(ezTaskSystem::TaskData& out_td)
+  {
+    const ezInt64 b = m_iBottom - 1;
+    m_iBottom.Set(b);
+
+    const ezInt64 t = m_iTop;
+
+    if (t > b)
+    {
+      // deque was empty
+      m_iBottom.Set(b + 1);
+      return false;
+    }
+
+    Slot slot = m_Slots[b & CapacityMask];
+
+    if (t == b)
+    {
+      // last element, compete with the stealers
+      const bool bWon = m_iTop.TestAndSet(t, t + 1);
+      m_iBottom.Set(b + 1);
+
+      if (!bWon)
+        return false;
+    }
+
+    TakeOver(slot, out_td);
+    return true;
+  }
+
+  /// \brief Takes the oldest task (FIFO). May be called from any thread. Only returns false, if the deque is empty.
+  bool Steal(ezTaskSystem::TaskData& out_td)
+  {
+    while (true)
+    {
+      const ezInt64 t = m_iTop;
+      const ezInt64 b = m_iBottom;
+
+      if (t >= b)
+        return false;
+
+      Slot slot = m_Slots[t & CapacityMask];
+
+      if (m_iTop.TestAndSet(t, t + 1))
+      {
+        TakeOver(slot, out_td);
+        return true;
+      }
+
+      // someone else took the element, try the next one
+    }
+  }
+
+  /// \brief Returns whether the deque contains any elements. The result is only a snapshot and may be outdated already.
+  bool IsEmpty() const { return m_iTop >= m_iBottom; }
+
+private:
+  struct Slot
+  {
+    alignas(ezTaskSystem::TaskData) ezUInt8 m_Data[sizeof(ezTaskSystem::TaskData)];
+  };
+
+  static void TakeOver(const Slot& slot, ezTaskSystem::TaskData& out_td)
+  {
+    out_td.~TaskData();
+    ezMemoryUtils::RawByteCopy(&out_td, &slot, sizeof(ezTaskSystem::TaskData));
+  }
+
+  // stealers modify m_iTop, the owner modifies m_iBottom, keep them on separate cache lines
+  ezAtomicInteger64 m_iTop;
+  ezUInt8 m_Padding0[64 - sizeof(ezAtomicInteger64)];
+  ezAtomicInteger64 m_iBottom;
+  ezUInt8 m_Padding1[64 - sizeof(ezAtomicInteger64)];
+  Slot m_Slots[Capacity];
+};
@@ -18,9 +18,15 @@ ezTaskWorkerThread::ezTaskWorkerThread(ezWorkerThreadType::Enum ThreadType, ezUI
 {
   m_WorkerType = ThreadType;
   m_uiWorkerThreadNumber = uiThreadNumber & 0xFFFF;
+
+  ezTaskSystem::DetermineTasksToExecuteOnThreadType(m_WorkerType, m_FirstPriority, m_LastPriority);
+  m_LocalQueues = EZ_DEFAULT_NEW_ARRAY(ezTaskWorkStealingDeque, m_LastPriority - m_FirstPriority + 1);
 }
 
-ezTaskWorkerThread::~ezTaskWorkerThread() = default;
+ezTaskWorkerThread::~ezTaskWorkerThread()
+{
+  EZ_DEFAULT_DELETE_ARRAY(m_LocalQueues);
+}
 
 ezResult ezTaskWorkerThread::DeactivateWorker()
 {
@@ -48,6 +54,7 @@ ezUInt32 ezTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_WorkerType = m_WorkerType;
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_WorkerState;
+  tl_TaskWorkerInfo.m_pWorkerThread = this;
 
   const bool bIsReserve = m_uiWorkerThreadNumber >= ezTaskSystem::s_ThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
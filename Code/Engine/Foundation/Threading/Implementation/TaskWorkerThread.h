@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkStealingDeque.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -33,6 +34,28 @@ private:
 
   ///@}
 
+  /// \name Local Task Queues
+  ///@{
+
+public:
+  /// \brief Returns the work-stealing deque for the given task priority or nullptr, if this thread does not execute tasks of that priority.
+  ezTaskWorkStealingDeque* GetLocalQueue(ezUInt32 uiPriority)
+  {
+    if (uiPriority < (ezUInt32)m_FirstPriority || uiPriority > (ezUInt32)m_LastPriority)
+      return nullptr;
+
+    return &m_LocalQueues[uiPriority - m_FirstPriority];
+  }
+
+private:
+  ezTaskPriority::Enum m_FirstPriority;
+  ezTaskPriority::Enum m_LastPriority;
+
+  // One deque per priority that this thread executes. Only this thread pushes and pops at the bottom, all others may steal.
+  ezArrayPtr<ezTaskWorkStealingDeque> m_LocalQueues;
+
+  ///@}
+
   /// \name Thread Utilization
   ///@{
 
@@ -85,6 +108,7 @@ struct ezTaskWorkerInfo
   bool m_bAllowNestedTasks = true;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkerThread* m_pWorkerThread = nullptr;
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
@@ -21,6 +21,11 @@
 ///
 /// Note that it is crucial to call 'FinishFrameTasks' once per frame, otherwise tasks that need to be executed on the
 /// main thread are never executed.
+///
+/// Internally every worker thread owns one lock-free work-stealing deque per task priority that it executes. Tasks that get scheduled
+/// on a worker thread are pushed into its own deque, all other tasks go into a per-priority injection queue. A thread that looks for work
+/// first takes the most recent task from its own deque, then looks into the injection queue and finally steals the oldest task from
+/// another worker. Therefore picking up and finishing tasks does not require any global lock.
 class EZ_FOUNDATION_DLL ezTaskSystem
 {
 public:
@@ -76,22 +81,39 @@ public:
 
   struct TaskData
   {
+    EZ_DECLARE_MEM_RELOCATABLE_TYPE();
+
     ezSharedPtr<ezTask> m_pTask;
     ezTaskGroup* m_pBelongsToGroup = nullptr;
     ezUInt32 m_uiInvocation = 0;
+    ezUInt32 m_uiScheduleCounter = 0; ///< Identifies the ezTask::m_iScheduleState to claim the invocation from.
   };
 
 private:
   /// \brief Searches for a task of priority between \a FirstPriority and \a LastPriority (inclusive).
+  ///
+  /// The calling worker first looks into its own deque, then into the priority's deferred and injection queues and finally tries to steal
+  /// from the other workers. Tasks that \a bOnlyTasksThatNeverWait rules out are moved into the deferred queue and another worker is woken up. The returned invocation has already been claimed, i.e. it is guaranteed to not have been canceled.
   static TaskData GetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
+  /// \brief Tries to take one queued task of exactly the given priority from any of the queues. Does not claim the invocation.
+  ///
+  /// The deferred queue only holds tasks that some waiting thread was not allowed to run, it is skipped unless \a bIncludeDeferred is set.
+  static bool DequeueTask(ezUInt32 uiPriority, TaskData& out_td, bool bIncludeDeferred);
+
+  /// \brief Puts a task into the queue for its priority. Uses the local deque of the calling worker thread, if possible.
+  static void EnqueueTask(ezUInt32 uiPriority, TaskData&& td, bool bHighPriority);
+
   /// \brief Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
   /// \brief Called whenever a task has been finished/canceled. Makes sure that groups are marked as finished when all tasks are done.
-  static void TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup* pGroup);
+  ///
+  /// \a pTask must only be passed in, if its last remaining invocation has just been finished, otherwise pass nullptr.
+  /// \a uiNumInvocations is the number of invocations of the task that have been finished (or canceled) at once.
+  static void TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup* pGroup, ezUInt32 uiNumInvocations = 1);
 
   /// \brief Moves all 'next frame' tasks into the 'this frame' queues.
   static void ReprioritizeFrameTasks();
@@ -185,15 +207,19 @@ public:
   /// \brief Sets the number of threads to use for the different task categories.
   ///
   /// \a uiShortTasks and \a uiLongTasks must be at least 1 and should not exceed the number of available CPU cores.
-  /// There will always be exactly one additional thread for file access tasks (ezTaskPriority::FileAccess).
+  /// Additionally there are \a iFileAccessTasks threads for file access tasks (ezTaskPriority::FileAccess). By default this is one
+  /// thread, such that all file accesses are done sequentially. Since these threads mostly wait for I/O, using more of them allows to keep
+  /// several reads in flight, which fast drives (e.g. NVMe SSDs) benefit from. Only do this, if none of your file access tasks rely on
+  /// being executed sequentially.
   ///
-  /// If \a uiShortTasks or \a uiLongTasks is smaller than 1, a default number of threads will be used for that type of work.
+  /// If \a uiShortTasks, \a uiLongTasks or \a iFileAccessTasks is smaller than 1, a default number of threads will be used for that
+  /// type of work.
   /// This number of threads depends on the number of available CPU cores.
   /// If SetWorkThreadCount is never called, at all, the first time any task is started the number of worker threads is set to
   /// this default configuration.
   /// Unless you have a good idea how to set up the number of worker threads to make good use of the available cores,
   /// it is a good idea to just use the default settings.
-  static void SetWorkerThreadCount(ezInt32 iShortTasks = -1, ezInt32 iLongTasks = -1); // [tested]
+  static void SetWorkerThreadCount(ezInt32 iShortTasks = -1, ezInt32 iLongTasks = -1, ezInt32 iFileAccessTasks = -1); // [tested]
 
   /// \brief Returns the maximum number of threads that should work on the given type of task at the same time.
   static ezUInt32 GetWorkerThreadCount(ezWorkerThreadType::Enum type);
@@ -229,6 +255,12 @@ private:
   /// \brief Uses a thread local variable to know the current thread type and to decide the range of task priorities that it may execute
   static void DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority);
 
+  /// \brief Returns the range of task priorities that threads of the given type execute.
+  static void DetermineTasksToExecuteOnThreadType(ezWorkerThreadType::Enum type, ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority);
+
+  /// \brief Returns the type of worker thread that is responsible for executing tasks of the given priority.
+  static ezWorkerThreadType::Enum GetWorkerThreadTypeForPriority(ezTaskPriority::Enum priority);
+
 private:
   static ezUniquePtr<ezTaskSystemThreadState> s_ThreadState;
 
@@ -303,7 +335,7 @@ private:
   static void Shutdown();
 
 private:
-  /// One mutex to rule them all.
+  /// Protects the task groups. Picking up and finishing tasks does not require this lock.
   static ezMutex s_TaskSystemMutex;
 
   static ezUniquePtr<ezTaskSystemState> s_State;
@@ -79,4 +79,8 @@
 //#undef EZ_USE_GUARDED_ALLOCATIONS
 //#define EZ_USE_GUARDED_ALLOCATIONS EZ_ON
 
+// Uncomment to use the thread caching small object allocator (ezThreadCachingAllocator) as the default heap allocator.
+//#undef EZ_USE_THREAD_CACHING_ALLOCATIONS
+//#define EZ_USE_THREAD_CACHING_ALLOCATIONS EZ_ON
+
 #endif
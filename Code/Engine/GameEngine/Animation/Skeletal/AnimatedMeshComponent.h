@@ -25,12 +25,6 @@ protected:
   virtual void OnActivated() override;
   virtual void OnDeactivated() override;
 
-  //////////////////////////////////////////////////////////////////////////
-  // ezMeshComponentBase
-
-protected:
-  virtual ezMeshRenderData* CreateRenderData() const override;
-
   //////////////////////////////////////////////////////////////////////////
   // ezAnimatedMeshComponent
 
@@ -9,7 +9,39 @@
 using ezSkeletonResourceHandle = ezTypedResourceHandle<class ezSkeletonResource>;
 using ezAnimGraphResourceHandle = ezTypedResourceHandle<class ezAnimGraphResource>;
 
-using ezAnimationControllerComponentManager = ezComponentManagerSimple<class ezAnimationControllerComponent, ezComponentUpdateType::WhenSimulating, ezBlockStorageType::FreeList>;
+class EZ_GAMEENGINE_DLL ezAnimationControllerComponentManager : public ezComponentManager<class ezAnimationControllerComponent, ezBlockStorageType::FreeList>
+{
+  using SUPER = ezComponentManager<class ezAnimationControllerComponent, ezBlockStorageType::FreeList>;
+
+public:
+  ezAnimationControllerComponentManager(ezWorld* pWorld);
+  ~ezAnimationControllerComponentManager();
+
+  virtual void Initialize() override;
+
+  /// \brief The controller input that drives the animation graphs, it is read once per frame on the update thread.
+  struct InputState
+  {
+    float m_fLeft = 0.0f;
+    float m_fRight = 0.0f;
+    float m_fForwards = 0.0f;
+    float m_fBackwards = 0.0f;
+    float m_fRotateLeft = 0.0f;
+    float m_fRotateRight = 0.0f;
+    float m_fA = 0.0f;
+    float m_fB = 0.0f;
+    float m_fX = 0.0f;
+    float m_fY = 0.0f;
+  };
+
+private:
+  void ReadInput(const ezWorldModule::UpdateContext& context);
+  void EvaluateAnimations(const ezWorldModule::UpdateContext& context);
+  void SendAnimationResults(const ezWorldModule::UpdateContext& context);
+
+  InputState m_Input;
+  ezDynamicArray<ezAnimationControllerComponent*> m_ComponentsToUpdate;
+};
 
 class EZ_GAMEENGINE_DLL ezAnimationControllerComponent : public ezComponent
 {
@@ -36,7 +68,8 @@ public:
   const char* GetAnimationControllerFile() const;      // [ property ]
 
 protected:
-  void Update();
+  void Evaluate(const ezAnimationControllerComponentManager::InputState& input);
+  void SendResults(const ezAnimationControllerComponentManager::InputState& input);
 
   ezAnimGraphResourceHandle m_hAnimationController;
   ezAnimGraph m_AnimationGraph;
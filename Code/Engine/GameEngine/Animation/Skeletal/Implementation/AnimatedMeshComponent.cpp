@@ -103,11 +103,13 @@ void ezAnimatedMeshComponent::InitializeAnimationPose()
       job.Run();
     }
 
-    ezMsgAnimationPoseUpdated msg;
-    msg.m_ModelTransforms = pPoseMatrices;
-    msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
+    m_SkinningSpacePose.Configure(pMesh->m_Bones, skeleton);
 
-    OnAnimationPoseUpdated(msg);
+    ezArrayPtr<ezMat4> pSkinningMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_SkinningSpacePose.GetTransformCount());
+    m_SkinningSpacePose.MapModelSpacePoseToSkinningSpace(pPoseMatrices, pSkinningMatrices);
+
+    // Create the buffer for the skinning matrices
+    CreateSkinningTransformBuffer(pSkinningMatrices);
   }
 
   // for (auto itBone : pMesh->m_Bones)
@@ -135,33 +137,24 @@ void ezAnimatedMeshComponent::InitializeAnimationPose()
   //    uiParentJointIdx = skeleton.GetJointByIndex(uiParentJointIdx).GetParentIndex();
   //  }
   //}
-
-  // Create the buffer for the skinning matrices
-  CreateSkinningTransformBuffer(m_SkinningSpacePose.m_Transforms);
-}
-
-ezMeshRenderData* ezAnimatedMeshComponent::CreateRenderData() const
-{
-  if (!m_SkinningSpacePose.IsEmpty())
-  {
-    // this copy is necessary for the multi-threaded renderer to not access m_SkinningSpacePose while we update it
-    ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_SkinningSpacePose.GetTransformCount());
-    pRenderMatrices.CopyFrom(m_SkinningSpacePose.m_Transforms);
-
-    m_SkinningMatrices = pRenderMatrices;
-  }
-
-  return SUPER::CreateRenderData();
 }
 
 void ezAnimatedMeshComponent::OnAnimationPoseUpdated(ezMsgAnimationPoseUpdated& msg)
 {
-  if (!m_hSkeleton.IsValid() || !m_hMesh.IsValid())
+  if (m_hSkinningTransformsBuffer.IsInvalidated())
     return;
 
-  ezResourceLock<ezMeshResource> pMesh(m_hMesh, ezResourceAcquireMode::BlockTillLoaded);
+  if (m_SkinningSpacePose.GetSkeleton() != msg.m_pSkeleton)
+  {
+    ezResourceLock<ezMeshResource> pMesh(m_hMesh, ezResourceAcquireMode::BlockTillLoaded);
+    if (pMesh.GetAcquireResult() != ezResourceAcquireResult::Final)
+      return;
+
+    m_SkinningSpacePose.Configure(pMesh->m_Bones, *msg.m_pSkeleton);
+  }
 
-  m_SkinningSpacePose.MapModelSpacePoseToSkinningSpace(pMesh->m_Bones, *msg.m_pSkeleton, msg.m_ModelTransforms);
+  // the skinning matrices are written straight into the memory that is passed to the renderer
+  m_SkinningSpacePose.MapModelSpacePoseToSkinningSpace(msg.m_ModelTransforms, GetSkinningMatricesForWriting());
 }
 
 void ezAnimatedMeshComponent::OnQueryAnimationSkeleton(ezMsgQueryAnimationSkeleton& msg)
@@ -4,11 +4,108 @@
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <GameEngine/Animation/Skeletal/AnimationControllerComponent.h>
 #include <Physics/CharacterControllerComponent.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraphResource.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
 
+ezAnimationControllerComponentManager::ezAnimationControllerComponentManager(ezWorld* pWorld)
+  : SUPER(pWorld)
+{
+}
+
+ezAnimationControllerComponentManager::~ezAnimationControllerComponentManager() = default;
+
+void ezAnimationControllerComponentManager::Initialize()
+{
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::ReadInput, this);
+    desc.m_Phase = UpdateFunctionDesc::Phase::PreAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::EvaluateAnimations, this);
+    desc.m_Phase = UpdateFunctionDesc::Phase::Async;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::SendAnimationResults, this);
+    desc.m_Phase = UpdateFunctionDesc::Phase::PostAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    // the root motion has to arrive before the character controllers are updated in the same phase
+    desc.m_fPriority = 1000.0f;
+
+    this->RegisterUpdateFunction(desc);
+  }
+}
+
+void ezAnimationControllerComponentManager::ReadInput(const ezWorldModule::UpdateContext& context)
+{
+  // the input manager is not thread-safe, so it must not be accessed while the animations are evaluated
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_NegX, &m_Input.m_fLeft);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_PosX, &m_Input.m_fRight);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_PosY, &m_Input.m_fForwards);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_NegY, &m_Input.m_fBackwards);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_RightStick_NegX, &m_Input.m_fRotateLeft);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_RightStick_PosX, &m_Input.m_fRotateRight);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonA, &m_Input.m_fA);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonB, &m_Input.m_fB);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonX, &m_Input.m_fX);
+  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonY, &m_Input.m_fY);
+}
+
+void ezAnimationControllerComponentManager::EvaluateAnimations(const ezWorldModule::UpdateContext& context)
+{
+  m_ComponentsToUpdate.Clear();
+
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      m_ComponentsToUpdate.PushBack(pComponent);
+    }
+  }
+
+  // the update granularity of the world works on whole storage blocks, which is too coarse for few but expensive components
+  ezParallelForParams params;
+  params.uiBinSize = 2;
+
+  const InputState& input = m_Input;
+
+  ezTaskSystem::ParallelFor<ezAnimationControllerComponent*>(
+    m_ComponentsToUpdate.GetArrayPtr(),
+    [&input](ezArrayPtr<ezAnimationControllerComponent*> components) {
+      for (ezAnimationControllerComponent* pComponent : components)
+      {
+        pComponent->Evaluate(input);
+      }
+    },
+    "EvaluateAnimationControllers", params);
+}
+
+void ezAnimationControllerComponentManager::SendAnimationResults(const ezWorldModule::UpdateContext& context)
+{
+  for (ezAnimationControllerComponent* pComponent : m_ComponentsToUpdate)
+  {
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->SendResults(m_Input);
+    }
+  }
+
+  m_ComponentsToUpdate.Clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezAnimationControllerComponent, 1, ezComponentMode::Static);
 {
@@ -110,58 +207,36 @@ void ezAnimationControllerComponent::OnSimulationStarted()
   m_AnimationGraph.m_Blackboard.RegisterEntry(hs, 0.0f);
 }
 
-void ezAnimationControllerComponent::Update()
+void ezAnimationControllerComponent::Evaluate(const ezAnimationControllerComponentManager::InputState& input)
 {
-  float fValue;
-  bool bActive = false;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_NegX, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("Left", fValue);
-  bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_PosX, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("Right", fValue);
-  bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_NegY, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("Backwards", fValue);
-  bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_PosY, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("Forwards", fValue);
-  bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonA, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("A", fValue);
-  bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonB, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("B", fValue);
-  bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonX, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("X", fValue);
-  // bActive |= fValue != 0;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonY, &fValue);
-  m_AnimationGraph.m_Blackboard.SetEntryValue("Y", fValue);
-  bActive |= fValue != 0;
-
-  m_AnimationGraph.m_Blackboard.SetEntryValue("Idle", bActive ? 0.0f : 1.0f);
+  auto& blackboard = m_AnimationGraph.m_Blackboard;
+  blackboard.SetEntryValue("Left", input.m_fLeft);
+  blackboard.SetEntryValue("Right", input.m_fRight);
+  blackboard.SetEntryValue("Backwards", input.m_fBackwards);
+  blackboard.SetEntryValue("Forwards", input.m_fForwards);
+  blackboard.SetEntryValue("A", input.m_fA);
+  blackboard.SetEntryValue("B", input.m_fB);
+  blackboard.SetEntryValue("X", input.m_fX);
+  blackboard.SetEntryValue("Y", input.m_fY);
+
+  // button X does not count as activity
+  const bool bActive = input.m_fLeft != 0 || input.m_fRight != 0 || input.m_fBackwards != 0 || input.m_fForwards != 0 || input.m_fA != 0 ||
+                       input.m_fB != 0 || input.m_fY != 0;
+
+  blackboard.SetEntryValue("Idle", bActive ? 0.0f : 1.0f);
 
   m_AnimationGraph.Update(GetWorld()->GetClock().GetTimeDiff());
+}
+
+void ezAnimationControllerComponent::SendResults(const ezAnimationControllerComponentManager::InputState& input)
+{
   m_AnimationGraph.SendResultTo(GetOwner());
 
   const ezTime tDiff = GetWorld()->GetClock().GetTimeDiff();
   const ezTime tInv = 1.0 / tDiff;
   const ezVec3 vRootMotion = tInv.AsFloatInSeconds() * m_AnimationGraph.GetRootMotion();
 
-  float fRotate = 0;
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_RightStick_NegX, &fValue);
-  fRotate -= fValue;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_RightStick_PosX, &fValue);
-  fRotate += fValue;
+  const float fRotate = input.m_fRotateRight - input.m_fRotateLeft;
 
   auto pOwner = GetOwner();
 
@@ -2,6 +2,8 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <GameEngine/Animation/Skeletal/SimpleAnimationComponent.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
@@ -14,6 +16,77 @@ using namespace ozz;
 using namespace ozz::animation;
 using namespace ozz::math;
 
+ezSimpleAnimationComponentManager::ezSimpleAnimationComponentManager(ezWorld* pWorld)
+  : SUPER(pWorld)
+{
+}
+
+ezSimpleAnimationComponentManager::~ezSimpleAnimationComponentManager() = default;
+
+void ezSimpleAnimationComponentManager::Initialize()
+{
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezSimpleAnimationComponentManager::EvaluateAnimations, this);
+    desc.m_Phase = UpdateFunctionDesc::Phase::Async;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezSimpleAnimationComponentManager::SendAnimationPoses, this);
+    desc.m_Phase = UpdateFunctionDesc::Phase::PostAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    // send the new poses before other components react to them
+    desc.m_fPriority = 1000.0f;
+
+    this->RegisterUpdateFunction(desc);
+  }
+}
+
+void ezSimpleAnimationComponentManager::EvaluateAnimations(const ezWorldModule::UpdateContext& context)
+{
+  m_ComponentsToUpdate.Clear();
+
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      m_ComponentsToUpdate.PushBack(pComponent);
+    }
+  }
+
+  // the update granularity of the world works on whole storage blocks, which is too coarse for few but expensive components
+  ezParallelForParams params;
+  params.uiBinSize = 4;
+
+  ezTaskSystem::ParallelFor<ezSimpleAnimationComponent*>(
+    m_ComponentsToUpdate.GetArrayPtr(),
+    [](ezArrayPtr<ezSimpleAnimationComponent*> components) {
+      for (ezSimpleAnimationComponent* pComponent : components)
+      {
+        pComponent->Evaluate();
+      }
+    },
+    "EvaluateSimpleAnimations", params);
+}
+
+void ezSimpleAnimationComponentManager::SendAnimationPoses(const ezWorldModule::UpdateContext& context)
+{
+  for (ezSimpleAnimationComponent* pComponent : m_ComponentsToUpdate)
+  {
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->SendPose();
+    }
+  }
+
+  m_ComponentsToUpdate.Clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezSimpleAnimationComponent, 1, ezComponentMode::Static);
 {
@@ -106,8 +179,10 @@ void ezSimpleAnimationComponent::SetNormalizedPlaybackPosition(float fPosition)
   SetUserFlag(1, true);
 }
 
-void ezSimpleAnimationComponent::Update()
+void ezSimpleAnimationComponent::Evaluate()
 {
+  m_ModelTransforms.Clear();
+
   if (!m_hSkeleton.IsValid() || !m_hAnimationClip.IsValid())
     return;
 
@@ -138,12 +213,18 @@ void ezSimpleAnimationComponent::Update()
   if (uiNumSkeletonJoints != uiNumAnimatedJoints)
     return;
 
-  ezArrayPtr<ezMat4> pPoseMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, uiNumSkeletonJoints);
+  // this runs on worker threads, so all temporary data comes from the frame allocator of the current thread
+  ezAllocatorBase* pAllocator = ezFrameAllocator::GetThreadAllocator();
+
+  ezArrayPtr<ezMat4> pPoseMatrices = EZ_NEW_ARRAY(pAllocator, ezMat4, uiNumSkeletonJoints);
+
+  const ezUInt32 uiNumSoaJoints = pOzzSkeleton->num_soa_joints();
+  SoaTransform* pLocalTransforms = EZ_NEW_RAW_BUFFER(pAllocator, SoaTransform, uiNumSoaJoints);
+  const span<SoaTransform> localTransforms(pLocalTransforms, pLocalTransforms + uiNumSoaJoints);
 
   if (m_ozzSamplingCache.max_tracks() != uiNumAnimatedJoints)
   {
     m_ozzSamplingCache.Resize(uiNumAnimatedJoints);
-    m_ozzLocalTransforms.resize(pOzzSkeleton->num_soa_joints());
   }
 
   {
@@ -151,26 +232,38 @@ void ezSimpleAnimationComponent::Update()
     job.animation = pOzzAnimation;
     job.cache = &m_ozzSamplingCache;
     job.ratio = m_fNormalizedPlaybackPosition;
-    job.output = make_span(m_ozzLocalTransforms);
+    job.output = localTransforms;
     job.Run();
   }
 
   {
     ozz::animation::LocalToModelJob job;
-    job.input = make_span(m_ozzLocalTransforms);
+    job.input = localTransforms;
     job.output = span<ozz::math::Float4x4>(reinterpret_cast<ozz::math::Float4x4*>(pPoseMatrices.GetPtr()), reinterpret_cast<ozz::math::Float4x4*>(pPoseMatrices.GetEndPtr()));
     job.skeleton = pOzzSkeleton;
     job.Run();
   }
 
-  // inform child nodes/components that a new pose is available
+  m_ModelTransforms = pPoseMatrices;
+}
+
+void ezSimpleAnimationComponent::SendPose()
+{
+  if (m_ModelTransforms.IsEmpty())
+    return;
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+  if (pSkeleton.GetAcquireResult() == ezResourceAcquireResult::Final)
   {
+    // inform child nodes/components that a new pose is available
     ezMsgAnimationPoseUpdated msg;
     msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
-    msg.m_ModelTransforms = pPoseMatrices;
+    msg.m_ModelTransforms = m_ModelTransforms;
 
     GetOwner()->SendMessageRecursive(msg);
   }
+
+  m_ModelTransforms.Clear();
 }
 
 bool ezSimpleAnimationComponent::UpdatePlaybackTime(ezTime tDiff)
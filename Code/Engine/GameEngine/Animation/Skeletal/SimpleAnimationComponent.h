@@ -13,7 +13,22 @@
 using ezAnimationClipResourceHandle = ezTypedResourceHandle<class ezAnimationClipResource>;
 using ezSkeletonResourceHandle = ezTypedResourceHandle<class ezSkeletonResource>;
 
-using ezSimpleAnimationComponentManager = ezComponentManagerSimple<class ezSimpleAnimationComponent, ezComponentUpdateType::WhenSimulating, ezBlockStorageType::FreeList>;
+class EZ_GAMEENGINE_DLL ezSimpleAnimationComponentManager : public ezComponentManager<class ezSimpleAnimationComponent, ezBlockStorageType::FreeList>
+{
+  using SUPER = ezComponentManager<class ezSimpleAnimationComponent, ezBlockStorageType::FreeList>;
+
+public:
+  ezSimpleAnimationComponentManager(ezWorld* pWorld);
+  ~ezSimpleAnimationComponentManager();
+
+  virtual void Initialize() override;
+
+private:
+  void EvaluateAnimations(const ezWorldModule::UpdateContext& context);
+  void SendAnimationPoses(const ezWorldModule::UpdateContext& context);
+
+  ezDynamicArray<ezSimpleAnimationComponent*> m_ComponentsToUpdate;
+};
 
 class EZ_GAMEENGINE_DLL ezSimpleAnimationComponent : public ezComponent
 {
@@ -49,7 +64,8 @@ public:
   float GetNormalizedPlaybackPosition() const { return m_fNormalizedPlaybackPosition; }
 
 protected:
-  void Update();
+  void Evaluate();
+  void SendPose();
   bool UpdatePlaybackTime(ezTime tDiff);
 
   float m_fNormalizedPlaybackPosition = 0.0f;
@@ -58,5 +74,5 @@ protected:
   ezSkeletonResourceHandle m_hSkeleton;
 
   ozz::animation::SamplingCache m_ozzSamplingCache;
-  ozz::vector<ozz::math::SoaTransform> m_ozzLocalTransforms; // TODO: could be frame allocated
+  ezArrayPtr<const ezMat4> m_ModelTransforms; ///< The pose computed by Evaluate(), allocated from the frame allocator.
 };
@@ -42,7 +42,13 @@ public:
   ezAnimGraph();
   ~ezAnimGraph();
 
+  /// \brief Steps all nodes, blends their results and computes the model space pose.
+  ///
+  /// Only the graph itself is modified, so different graphs may be updated in parallel.
+  /// Temporary data is allocated from the frame allocator of the calling thread.
   void Update(ezTime tDiff);
+
+  /// \brief Sends the pose of the last Update() to the given object and its children via ezMsgAnimationPoseUpdated.
   void SendResultTo(ezGameObject* pObject);
   const ezVec3& GetRootMotion() const { return m_vRootMotion; }
 
@@ -75,7 +81,6 @@ public:
 
 private:
   ezDynamicArray<ozz::animation::BlendingJob::Layer> m_ozzBlendLayers;
-  ozz::vector<ozz::math::SoaTransform> m_ozzLocalTransforms;
   ezDynamicArray<ezMat4, ezAlignedAllocatorWrapper> m_ModelSpaceTransforms;
 
   ezDeque<ezAnimGraphBlendWeights> m_BlendWeights;
@@ -87,7 +92,5 @@ private:
   ezDeque<ezAnimGraphSamplingCache> m_SamplingCaches;
   ezHybridArray<ezAnimGraphSamplingCache*, 8> m_SamplingCachesFreeList;
 
-  bool m_bFinalized = false;
   ezVec3 m_vRootMotion = ezVec3::ZeroVector();
-  void Finalize(const ezSkeletonResource* pSkeleton);
 };
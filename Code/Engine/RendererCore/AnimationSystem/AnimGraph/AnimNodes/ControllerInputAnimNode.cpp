@@ -1,6 +1,6 @@
 #include <RendererCorePCH.h>
 
-#include <Core/Input/InputManager.h>
+#include <RendererCore/AnimationSystem/AnimGraph/AnimGraph.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimNodes/ControllerInputAnimNode.h>
 
 // clang-format off
@@ -60,31 +60,25 @@ ezResult ezControllerInputAnimNode::DeserializeNode(ezStreamReader& stream)
   return EZ_SUCCESS;
 }
 
-void ezControllerInputAnimNode::Step(ezAnimGraph* pOwner, ezTime tDiff, const ezSkeletonResource* pSkeleton)
+static bool IsBlackboardEntryActive(const ezBlackboard& blackboard, const ezTempHashedString& name)
 {
-  float fValue = 0.0f;
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_NegX, &fValue);
-  m_StickLeft.SetTriggered(*pOwner, fValue > 0);
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_PosX, &fValue);
-  m_StickRight.SetTriggered(*pOwner, fValue > 0);
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_NegY, &fValue);
-  m_StickDown.SetTriggered(*pOwner, fValue > 0);
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_LeftStick_PosY, &fValue);
-  m_StickUp.SetTriggered(*pOwner, fValue > 0);
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonA, &fValue);
-  m_ButtonA.SetTriggered(*pOwner, fValue > 0);
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonB, &fValue);
-  m_ButtonB.SetTriggered(*pOwner, fValue > 0);
-
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonX, &fValue);
-  m_ButtonX.SetTriggered(*pOwner, fValue > 0);
+  const ezVariant value = blackboard.GetEntryValue(name);
+  return value.IsValid() && value.IsNumber() && value.ConvertTo<float>() > 0;
+}
 
-  ezInputManager::GetInputSlotState(ezInputSlot_Controller0_ButtonY, &fValue);
-  m_ButtonY.SetTriggered(*pOwner, fValue > 0);
+void ezControllerInputAnimNode::Step(ezAnimGraph* pOwner, ezTime tDiff, const ezSkeletonResource* pSkeleton)
+{
+  // graphs are evaluated on worker threads, where the input manager must not be accessed
+  // the owner of the graph writes the controller input into these blackboard entries instead, see ezAnimationControllerComponent
+  const ezBlackboard& blackboard = pOwner->m_Blackboard;
+
+  m_StickLeft.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "Left"));
+  m_StickRight.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "Right"));
+  m_StickDown.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "Backwards"));
+  m_StickUp.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "Forwards"));
+
+  m_ButtonA.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "A"));
+  m_ButtonB.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "B"));
+  m_ButtonX.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "X"));
+  m_ButtonY.SetTriggered(*pOwner, IsBlackboardEntryActive(blackboard, "Y"));
 }
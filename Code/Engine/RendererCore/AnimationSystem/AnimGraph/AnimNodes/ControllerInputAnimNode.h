@@ -2,6 +2,9 @@
 
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraphNode.h>
 
+/// \brief Triggers its outputs from the controller input in the blackboard entries 'Left', 'Right', 'Forwards', 'Backwards', 'A', 'B', 'X' and 'Y'.
+///
+/// The input manager is not accessed directly, as graphs are evaluated on worker threads.
 class EZ_RENDERERCORE_DLL ezControllerInputAnimNode : public ezAnimGraphNode
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezControllerInputAnimNode, ezAnimGraphNode);
@@ -1,6 +1,7 @@
 #include <RendererCorePCH.h>
 
 #include <Core/World/GameObject.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraph.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
 #include <ozz/animation/runtime/animation.h>
@@ -31,35 +32,27 @@ void ezAnimGraph::Update(ezTime tDiff)
     pNode->Step(this, tDiff, pSkeleton.GetPointer());
   }
 
-  {
-    m_ozzLocalTransforms.resize(pOzzSkeleton->num_soa_joints());
+  const ezUInt32 uiNumSoaJoints = pOzzSkeleton->num_soa_joints();
+
+  // the blended local pose is only needed until the model space pose is computed, so it lives in the frame memory of this thread
+  ozz::math::SoaTransform* pLocalTransforms = EZ_NEW_RAW_BUFFER(ezFrameAllocator::GetThreadAllocator(), ozz::math::SoaTransform, uiNumSoaJoints);
+  const ozz::span<ozz::math::SoaTransform> localTransforms(pLocalTransforms, pLocalTransforms + uiNumSoaJoints);
 
+  {
     ozz::animation::BlendingJob job;
     job.threshold = 0.1f;
     job.layers = ozz::span<const ozz::animation::BlendingJob::Layer>(begin(m_ozzBlendLayers), end(m_ozzBlendLayers));
     job.bind_pose = pOzzSkeleton->joint_bind_poses();
-    job.output = make_span(m_ozzLocalTransforms);
+    job.output = localTransforms;
     EZ_ASSERT_DEBUG(job.Validate(), "");
     job.Run();
   }
 
-  m_bFinalized = false;
-}
-
-void ezAnimGraph::Finalize(const ezSkeletonResource* pSkeleton)
-{
-  if (m_bFinalized)
-    return;
-
-  m_bFinalized = true;
-
-  const ozz::animation::Skeleton* pOzzSkeleton = &pSkeleton->GetDescriptor().m_Skeleton.GetOzzSkeleton();
-
   {
     m_ModelSpaceTransforms.SetCountUninitialized(pOzzSkeleton->num_joints());
 
     ozz::animation::LocalToModelJob job;
-    job.input = make_span(m_ozzLocalTransforms);
+    job.input = localTransforms;
     job.output = ozz::span<ozz::math::Float4x4>(reinterpret_cast<ozz::math::Float4x4*>(begin(m_ModelSpaceTransforms)), reinterpret_cast<ozz::math::Float4x4*>(end(m_ModelSpaceTransforms)));
     job.skeleton = pOzzSkeleton;
     EZ_ASSERT_DEBUG(job.Validate(), "");
@@ -69,15 +62,13 @@ void ezAnimGraph::Finalize(const ezSkeletonResource* pSkeleton)
 
 void ezAnimGraph::SendResultTo(ezGameObject* pObject)
 {
-  if (!m_hSkeleton.IsValid())
+  if (!m_hSkeleton.IsValid() || m_ModelSpaceTransforms.IsEmpty())
     return;
 
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
   if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
     return;
 
-  Finalize(pSkeleton.GetPointer());
-
   ezMsgAnimationPoseUpdated msg;
   msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
   msg.m_ModelTransforms = m_ModelSpaceTransforms;
@@ -5,10 +5,15 @@
 #include <Foundation/Containers/Bitfield.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Transform.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
 #include <RendererCore/Meshes/MeshResourceDescriptor.h>
 
 class ezSkeleton;
 
+/// \brief Maps model space poses of a skeleton to the skinning matrices of a mesh.
+///
+/// The mapping from the mesh bones to the skeleton joints is only computed once in Configure(),
+/// so that mapping a pose is a tight loop of SIMD matrix multiplications.
 class EZ_RENDERERCORE_DLL ezSkinningSpaceAnimationPose
 {
 public:
@@ -17,14 +22,28 @@ public:
 
   void Clear();
 
-  bool IsEmpty() const { return m_Transforms.IsEmpty(); }
+  bool IsEmpty() const { return m_Bones.IsEmpty(); }
 
-  void Configure(ezUInt32 uiNumTransforms);
+  /// \brief Sets up the mapping for the given mesh bones and skeleton. Bones without a matching joint get the identity matrix.
+  void Configure(const ezHashTable<ezHashedString, ezMeshResourceDescriptor::BoneData>& bones, const ezSkeleton& skeleton);
 
-  ezUInt32 GetTransformCount() const { return m_Transforms.GetCount(); }
+  /// \brief Returns the skeleton that was passed to Configure().
+  const ezSkeleton* GetSkeleton() const { return m_pSkeleton; }
 
-  void MapModelSpacePoseToSkinningSpace(const ezHashTable<ezHashedString, ezMeshResourceDescriptor::BoneData>& bones, const ezSkeleton& skeleton, ezArrayPtr<const ezMat4> modelSpaceTransforms);
+  ezUInt32 GetTransformCount() const { return m_Bones.GetCount(); }
 
-  // TODO: would be nicer to use ezTransform or ezShaderTransform for this data
-  ezDynamicArray<ezMat4, ezAlignedAllocatorWrapper> m_Transforms;
+  /// \brief Computes the skinning matrices of all bones from the model space pose of the configured skeleton.
+  ///
+  /// out_SkinningTransforms must have room for GetTransformCount() matrices.
+  void MapModelSpacePoseToSkinningSpace(ezArrayPtr<const ezMat4> modelSpaceTransforms, ezArrayPtr<ezMat4> out_SkinningTransforms) const;
+
+private:
+  struct Bone
+  {
+    ezSimdMat4f m_InverseBindPose;
+    ezUInt16 m_uiJointIndex = ezInvalidJointIndex;
+  };
+
+  const ezSkeleton* m_pSkeleton = nullptr;
+  ezDynamicArray<Bone, ezAlignedAllocatorWrapper> m_Bones; ///< indexed by the bone index of the mesh
 };
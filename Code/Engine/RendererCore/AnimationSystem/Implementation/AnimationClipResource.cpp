@@ -1,6 +1,7 @@
 #include <RendererCorePCH.h>
 
 #include <Core/Assets/AssetFileHeader.h>
+#include <Foundation/Threading/Mutex.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
@@ -103,6 +104,7 @@ struct ezAnimationClipResourceDescriptor::OzzImpl
     ozz::unique_ptr<ozz::animation::Animation> m_pAnim;
   };
 
+  ezMutex m_MappedOzzAnimationsMutex; ///< The animations are evaluated on several threads, which all may need to create the mapping
   ezMap<const ezSkeletonResource*, CachedAnim> m_MappedOzzAnimations;
 };
 
@@ -244,6 +246,8 @@ EZ_FORCE_INLINE void ez2ozz(const ezQuat& in, ozz::math::Quaternion& out)
 
 const ozz::animation::Animation& ezAnimationClipResourceDescriptor::GetMappedOzzAnimation(const ezSkeletonResource& skeleton) const
 {
+  EZ_LOCK(m_OzzImpl->m_MappedOzzAnimationsMutex);
+
   auto it = m_OzzImpl->m_MappedOzzAnimations.Find(&skeleton);
   if (it.IsValid())
   {
@@ -1,5 +1,6 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
 #include <RendererCore/Debug/DebugRenderer.h>
@@ -19,29 +20,44 @@ ezSkinningSpaceAnimationPose::~ezSkinningSpaceAnimationPose() = default;
 
 void ezSkinningSpaceAnimationPose::Clear()
 {
-  m_Transforms.Clear();
-  m_Transforms.Compact();
+  m_pSkeleton = nullptr;
+  m_Bones.Clear();
+  m_Bones.Compact();
 }
 
-void ezSkinningSpaceAnimationPose::Configure(ezUInt32 uiNumTransforms)
+void ezSkinningSpaceAnimationPose::Configure(const ezHashTable<ezHashedString, ezMeshResourceDescriptor::BoneData>& bones, const ezSkeleton& skeleton)
 {
-  m_Transforms.SetCountUninitialized(uiNumTransforms);
+  m_pSkeleton = &skeleton;
+  m_Bones.SetCount(bones.GetCount());
+
+  for (auto itBone : bones)
+  {
+    Bone& bone = m_Bones[itBone.Value().m_uiBoneIndex];
+    bone.m_InverseBindPose = ezSimdConversion::ToMat4(itBone.Value().m_GlobalInverseBindPoseMatrix);
+    bone.m_uiJointIndex = skeleton.FindJointByName(itBone.Key());
+  }
 }
 
-void ezSkinningSpaceAnimationPose::MapModelSpacePoseToSkinningSpace(const ezHashTable<ezHashedString, ezMeshResourceDescriptor::BoneData>& bones, const ezSkeleton& skeleton, ezArrayPtr<const ezMat4> modelSpaceTransforms)
+void ezSkinningSpaceAnimationPose::MapModelSpacePoseToSkinningSpace(ezArrayPtr<const ezMat4> modelSpaceTransforms, ezArrayPtr<ezMat4> out_SkinningTransforms) const
 {
-  Configure(bones.GetCount());
+  EZ_ASSERT_DEBUG(out_SkinningTransforms.GetCount() >= m_Bones.GetCount(), "Not enough space for the skinning matrices");
 
-  for (auto itBone : bones)
+  const ezUInt32 uiNumJoints = modelSpaceTransforms.GetCount();
+  const ezUInt32 uiNumBones = m_Bones.GetCount();
+
+  for (ezUInt32 i = 0; i < uiNumBones; ++i)
   {
-    const ezUInt16 uiJointIdx = skeleton.FindJointByName(itBone.Key());
+    const Bone& bone = m_Bones[i];
 
-    if (uiJointIdx == ezInvalidJointIndex)
+    if (bone.m_uiJointIndex >= uiNumJoints)
+    {
+      out_SkinningTransforms[i].SetIdentity();
       continue;
+    }
 
-    m_Transforms[itBone.Value().m_uiBoneIndex] = modelSpaceTransforms[uiJointIdx] * itBone.Value().m_GlobalInverseBindPoseMatrix;
+    const ezSimdMat4f skinningTransform = ezSimdConversion::ToMat4(modelSpaceTransforms[bone.m_uiJointIndex]) * bone.m_InverseBindPose;
+    skinningTransform.GetAsArray(out_SkinningTransforms[i].m_fElementsCM, ezMatrixLayout::ColumnMajor);
   }
 }
 
-
 EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_AnimationPose);
@@ -436,11 +436,14 @@ ezUInt32 ezShadowPool::AddDirectionalLight(const ezDirectionalLightComponent* pD
 
   float fNearPlaneOffset = pDirLight->GetNearPlaneOffset();
 
+  ezView* cascadeViews[4] = {};
+
   for (ezUInt32 i = 0; i < uiNumCascades; ++i)
   {
     ezView* pView = nullptr;
     ShadowView& shadowView = s_pData->GetShadowView(pView);
     pData->m_Views[i] = shadowView.m_hView;
+    cascadeViews[i] = pView;
 
     // Setup view
     {
@@ -499,8 +502,14 @@ ezUInt32 ezShadowPool::AddDirectionalLight(const ezDirectionalLightComponent* pD
 
       camera.MoveLocally(0.0f, offset.x, offset.y);
     }
+  }
+
+  // all cascades are culled in one pass before their extraction starts
+  ezRenderWorld::CullViews(ezMakeArrayPtr(cascadeViews, uiNumCascades));
 
-    ezRenderWorld::AddViewToRender(shadowView.m_hView);
+  for (ezUInt32 i = 0; i < uiNumCascades; ++i)
+  {
+    ezRenderWorld::AddViewToRender(pData->m_Views[i]);
   }
 
   return pData->m_uiPackedDataOffset;
@@ -553,11 +562,14 @@ ezUInt32 ezShadowPool::AddPointLight(const ezPointLightComponent* pPointLight, f
   float fNearPlane = 0.1f; ///\todo expose somewhere
   float fFarPlane = pPointLight->GetEffectiveRange();
 
+  ezView* faceViews[6] = {};
+
   for (ezUInt32 i = 0; i < 6; ++i)
   {
     ezView* pView = nullptr;
     ShadowView& shadowView = s_pData->GetShadowView(pView);
     pData->m_Views[i] = shadowView.m_hView;
+    faceViews[i] = pView;
 
     // Setup view
     {
@@ -573,8 +585,14 @@ ezUInt32 ezShadowPool::AddPointLight(const ezPointLightComponent* pPointLight, f
       camera.LookAt(vPosition, vPosition + vForward, vUp);
       camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, fFov, fNearPlane, fFarPlane);
     }
+  }
+
+  // all faces are culled in one pass before their extraction starts
+  ezRenderWorld::CullViews(ezMakeArrayPtr(faceViews));
 
-    ezRenderWorld::AddViewToRender(shadowView.m_hView);
+  for (ezUInt32 i = 0; i < 6; ++i)
+  {
+    ezRenderWorld::AddViewToRender(pData->m_Views[i]);
   }
 
   return pData->m_uiPackedDataOffset;
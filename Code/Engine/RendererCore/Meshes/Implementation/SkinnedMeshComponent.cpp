@@ -3,6 +3,7 @@
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <RendererCore/Meshes/SkinnedMeshComponent.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Device/Device.h>
 
 // clang-format off
@@ -55,6 +56,14 @@ void ezSkinnedMeshComponent::OnDeactivated()
     m_hSkinningTransformsBuffer.Invalidate();
   }
 
+  for (auto& buffer : m_SkinningMatrices)
+  {
+    buffer.Clear();
+    buffer.Compact();
+  }
+
+  m_uiSkinningMatricesFrame = ezInvalidIndex;
+
   SUPER::OnDeactivated();
 }
 
@@ -62,10 +71,16 @@ ezMeshRenderData* ezSkinnedMeshComponent::CreateRenderData() const
 {
   auto pRenderData = ezCreateRenderDataForThisFrame<ezSkinnedMeshRenderData>(GetOwner());
 
-  if (!m_SkinningMatrices.IsEmpty())
+  if (!m_hSkinningTransformsBuffer.IsInvalidated())
   {
     pRenderData->m_hSkinningMatrices = m_hSkinningTransformsBuffer;
-    pRenderData->m_pNewSkinningMatricesData = m_SkinningMatrices.ToByteArray();
+
+    // only upload if something changed, otherwise the GPU buffer is still up to date
+    // this is called for every view that sees the mesh, possibly in parallel, so nothing may be modified here
+    if (m_uiSkinningMatricesFrame == ezRenderWorld::GetFrameCounter())
+    {
+      pRenderData->m_pNewSkinningMatricesData = m_SkinningMatrices[m_uiSkinningMatricesIndex].GetArrayPtr().ToByteArray();
+    }
   }
 
   return pRenderData;
@@ -83,14 +98,33 @@ void ezSkinnedMeshComponent::CreateSkinningTransformBuffer(ezArrayPtr<const ezMa
   BufferDesc.m_ResourceAccess.m_bImmutable = false;
 
   m_hSkinningTransformsBuffer = ezGALDevice::GetDefaultDevice()->CreateBuffer(BufferDesc, skinningMatrices.ToByteArray());
+
+  // the buffer already contains the initial matrices, so nothing has to be uploaded until they change
+  for (auto& buffer : m_SkinningMatrices)
+  {
+    buffer.SetCountUninitialized(skinningMatrices.GetCount());
+  }
 }
 
 void ezSkinnedMeshComponent::UpdateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices)
 {
-  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, skinningMatrices.GetCount());
-  pRenderMatrices.CopyFrom(skinningMatrices);
+  EZ_ASSERT_DEBUG(skinningMatrices.GetCount() == m_SkinningMatrices[0].GetCount(), "The number of skinning matrices must not change");
+
+  GetSkinningMatricesForWriting().CopyFrom(skinningMatrices);
+}
+
+ezArrayPtr<ezMat4> ezSkinnedMeshComponent::GetSkinningMatricesForWriting()
+{
+  const ezUInt64 uiFrameCounter = ezRenderWorld::GetFrameCounter();
+
+  // the renderer may still read the buffer of the previous frame, so switch to the other one once per frame
+  if (m_uiSkinningMatricesFrame != uiFrameCounter)
+  {
+    m_uiSkinningMatricesIndex ^= 1;
+    m_uiSkinningMatricesFrame = uiFrameCounter;
+  }
 
-  m_SkinningMatrices = pRenderMatrices;
+  return m_SkinningMatrices[m_uiSkinningMatricesIndex];
 }
 
 
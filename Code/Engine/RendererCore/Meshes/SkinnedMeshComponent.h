@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Memory/AllocatorWrapper.h>
 #include <RendererCore/Meshes/MeshComponentBase.h>
 
 class EZ_RENDERERCORE_DLL ezSkinnedMeshRenderData : public ezMeshRenderData
@@ -47,6 +48,15 @@ protected:
   void CreateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices);
   void UpdateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices);
 
+  /// \brief Returns the memory into which new skinning matrices can be written directly. All matrices have to be written.
+  ///
+  /// The matrices are double buffered, the returned memory is never the one that the renderer may still read from.
+  /// The new matrices are passed to the renderer with the render data of this frame, without any further copy.
+  /// Must be called during the world update, not during extraction.
+  ezArrayPtr<ezMat4> GetSkinningMatricesForWriting();
+
   ezGALBufferHandle m_hSkinningTransformsBuffer;
-  mutable ezArrayPtr<const ezMat4> m_SkinningMatrices;
+  ezDynamicArray<ezMat4, ezAlignedAllocatorWrapper> m_SkinningMatrices[2];
+  ezUInt64 m_uiSkinningMatricesFrame = ezInvalidIndex; ///< The frame in which the matrices were last written.
+  ezUInt8 m_uiSkinningMatricesIndex = 0;               ///< The buffer that was last written and that is passed to the renderer.
 };
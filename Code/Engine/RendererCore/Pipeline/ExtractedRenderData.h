@@ -34,6 +34,11 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Appends the render data of all categories of other. Frame data is not taken over.
+  ///
+  /// The sorting keys are not recomputed, so other needs to use the same camera.
+  void AppendRenderData(const ezExtractedRenderData& other);
+
   void SortAndBatch();
 
   void Clear();
@@ -50,6 +55,12 @@ public:
 private:
   const ezRenderData* GetFrameData(const ezRTTI* pRtti) const;
 
+  enum
+  {
+    RADIX_SORT_THRESHOLD = 256,     ///< Categories with less render data are sorted with a quick sort instead.
+    PARALLEL_SORT_THRESHOLD = 4096, ///< Categories with at least this many render data are sorted and batched in parallel.
+  };
+
   struct DataPerCategory
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class EZ_RENDERERCORE_DLL ezExtractor : public ezReflectedClass
@@ -27,7 +29,8 @@ protected:
   /// \brief returns true if the given object should be filtered by view tags.
   bool FilterByViewTags(const ezView& view, const ezGameObject* pObject) const;
 
-  /// \brief extracts the render data for the given object.
+  /// \brief extracts the render data for the given object. Can be called from multiple threads at once as long as each thread uses
+  /// its own msg and extractedRenderData.
   void ExtractRenderData(
     const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const;
 
@@ -42,8 +45,8 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumCachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumUncachedRenderData;
 #endif
 };
 
@@ -55,8 +58,16 @@ class EZ_RENDERERCORE_DLL ezVisibleObjectsExtractor : public ezExtractor
 public:
   ezVisibleObjectsExtractor(const char* szName = "VisibleObjectsExtractor");
 
+  /// \brief Extracts the render data of all visible objects. Large numbers of visible objects are split into ranges which are
+  /// extracted in parallel, each into its own ezExtractedRenderData. These are appended to extractedRenderData in order afterwards.
+  /// The render data of each range is allocated from the frame allocator lane of the thread that extracts it.
   virtual void Extract(
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData) override;
+
+private:
+  void ExtractRange(const ezView& view, ezArrayPtr<const ezGameObject* const> visibleObjects, ezExtractedRenderData& extractedRenderData);
+
+  ezDynamicArray<ezExtractedRenderData> m_ExtractedRenderDataPerRange;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractor : public ezExtractor
@@ -1,6 +1,8 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Algorithm/Sorting.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
 ezExtractedRenderData::ezExtractedRenderData() {}
@@ -12,6 +14,7 @@ void ezExtractedRenderData::AddRenderData(const ezRenderData* pRenderData, ezRen
   auto& sortableRenderData = m_DataPerCategory[category.m_uiValue].m_SortableRenderData.ExpandAndGetRef();
   sortableRenderData.m_pRenderData = pRenderData;
   sortableRenderData.m_uiSortingKey = pRenderData->GetCategorySortingKey(category, m_Camera);
+  sortableRenderData.m_uiBatchId = pRenderData->m_uiBatchId;
 }
 
 void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
@@ -19,6 +22,16 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void ezExtractedRenderData::AppendRenderData(const ezExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 i = 0; i < other.m_DataPerCategory.GetCount(); ++i)
+  {
+    m_DataPerCategory[i].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[i].m_SortableRenderData);
+  }
+}
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
@@ -29,25 +42,35 @@ void ezExtractedRenderData::SortAndBatch()
     {
       if (a.m_uiSortingKey == b.m_uiSortingKey)
       {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+        return a.m_uiBatchId < b.m_uiBatchId;
       }
 
       return a.m_uiSortingKey < b.m_uiSortingKey;
     }
   };
 
-  for (auto& dataPerCategory : m_DataPerCategory)
-  {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
-      continue;
-
+  auto SortAndBatchCategory = [](DataPerCategory& dataPerCategory) {
     auto& data = dataPerCategory.m_SortableRenderData;
 
     // Sort
-    data.Sort(RenderDataComparer());
+    if (data.GetCount() < RADIX_SORT_THRESHOLD)
+    {
+      data.Sort(RenderDataComparer());
+    }
+    else
+    {
+      ezDynamicArray<ezRenderDataBatch::SortableRenderData> tempStorage;
+      tempStorage.SetCountUninitialized(data.GetCount());
+
+      // The radix sort is stable, so sorting by batch id first results in the same order as the comparer above.
+      ezSorting::RadixSort(
+        data.GetArrayPtr(), tempStorage.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d) { return d.m_uiBatchId; });
+      ezSorting::RadixSort(
+        data.GetArrayPtr(), tempStorage.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d) { return d.m_uiSortingKey; });
+    }
 
     // Find batches
-    ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
+    ezUInt32 uiCurrentBatchId = data[0].m_uiBatchId;
     ezUInt32 uiCurrentBatchStartIndex = 0;
     const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
 
@@ -55,18 +78,50 @@ void ezExtractedRenderData::SortAndBatch()
     {
       auto pRenderData = data[i].m_pRenderData;
 
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+      if (data[i].m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
       {
         dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
 
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
+        uiCurrentBatchId = data[i].m_uiBatchId;
         uiCurrentBatchStartIndex = i;
         pCurrentBatchType = pRenderData->GetDynamicRTTI();
       }
     }
 
     dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+  };
+
+  // Large categories are processed in parallel, the small ones are not worth the task overhead.
+  ezHybridArray<DataPerCategory*, 16> largeCategories;
+
+  for (auto& dataPerCategory : m_DataPerCategory)
+  {
+    if (dataPerCategory.m_SortableRenderData.IsEmpty())
+      continue;
+
+    if (dataPerCategory.m_SortableRenderData.GetCount() >= PARALLEL_SORT_THRESHOLD)
+    {
+      largeCategories.PushBack(&dataPerCategory);
+    }
+    else
+    {
+      SortAndBatchCategory(dataPerCategory);
+    }
   }
+
+  ezParallelForParams params;
+  // every large category is expensive enough to be a task of its own
+  params.uiBinSize = 1;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, largeCategories.GetCount(),
+    [&largeCategories, &SortAndBatchCategory](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        SortAndBatchCategory(*largeCategories[i]);
+      }
+    },
+    "SortAndBatch", params);
 }
 
 void ezExtractedRenderData::Clear()
@@ -1,8 +1,10 @@
 #include <RendererCorePCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -31,17 +33,21 @@ namespace
     if (CVarVisSpatialData && CVarVisObjectName.GetValue().IsEmpty() && !CVarVisObjectSelection)
     {
       const ezSpatialSystem& spatialSystem = *view.GetWorld()->GetSpatialSystem();
+      ezSpatialData::Category filterCategory = ezSpatialData::FindCategory(CVarVisSpatialCategory.GetValue());
+
+      ezHybridArray<ezBoundingBox, 16> boxes;
       if (auto pSpatialSystemGrid = ezDynamicCast<const ezSpatialSystem_RegularGrid*>(&spatialSystem))
       {
-        ezSpatialData::Category filterCategory = ezSpatialData::FindCategory(CVarVisSpatialCategory.GetValue());
-
-        ezHybridArray<ezBoundingBox, 16> boxes;
         pSpatialSystemGrid->GetAllCellBoxes(boxes, filterCategory);
+      }
+      else if (auto pSpatialSystemOctree = ezDynamicCast<const ezSpatialSystem_LooseOctree*>(&spatialSystem))
+      {
+        pSpatialSystemOctree->GetAllNodeBoxes(boxes, filterCategory);
+      }
 
-        for (auto& box : boxes)
-        {
-          ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
-        }
+      for (auto& box : boxes)
+      {
+        ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
       }
     }
   }
@@ -81,6 +87,14 @@ namespace
           ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
         }
       }
+      else if (auto pSpatialSystemOctree = ezDynamicCast<const ezSpatialSystem_LooseOctree*>(&spatialSystem))
+      {
+        ezBoundingBox box;
+        if (pSpatialSystemOctree->GetNodeBoxForSpatialData(pObject->GetSpatialData(), box).Succeeded())
+        {
+          ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
+        }
+      }
     }
   }
 #endif
@@ -161,7 +175,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    m_uiNumUncachedRenderData.Add(msg.m_ExtractedRenderData.GetCount());
 #endif
   };
 
@@ -197,7 +211,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != ezInvalidRenderDataCategory ? msg.m_OverrideCategory : ezRenderData::Category(cacheEntry.m_uiCategory));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          m_uiNumCachedRenderData.Increment();
 #endif
         }
         ++uiCacheIndex;
@@ -220,7 +234,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
         // Only cache render data if all parts should be cached otherwise the cache is incomplete and we won't call SendMessage again
         if (msg.m_uiNumCacheIfStatic > 0 && msg.m_ExtractedRenderData.GetCount() == msg.m_uiNumCacheIfStatic)
         {
-          ezHybridArray<ezInternal::RenderDataCacheEntry, 16> newCacheEntries(ezFrameAllocator::GetCurrentAllocator());
+          ezHybridArray<ezInternal::RenderDataCacheEntry, 16> newCacheEntries(ezFrameAllocator::GetThreadAllocator());
 
           for (ezUInt32 uiPartIndex = 0; uiPartIndex < msg.m_ExtractedRenderData.GetCount(); ++uiPartIndex)
           {
@@ -281,9 +295,6 @@ ezVisibleObjectsExtractor::ezVisibleObjectsExtractor(const char* szName)
 void ezVisibleObjectsExtractor::Extract(
   const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -293,21 +304,50 @@ void ezVisibleObjectsExtractor::Extract(
   m_uiNumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  // Only go wide if every range gets a decent amount of objects, otherwise the task overhead outweighs the gain.
+  const ezUInt32 uiMinObjectsPerRange = 256;
+  const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+  const ezUInt32 uiNumRanges = ezMath::Min(uiNumObjects / uiMinObjectsPerRange, uiNumWorkers * 2);
+
+  if (uiNumRanges <= 1)
   {
-    ExtractRenderData(view, pObject, msg, extractedRenderData);
+    ExtractRange(view, visibleObjects, extractedRenderData);
+  }
+  else
+  {
+    if (m_ExtractedRenderDataPerRange.GetCount() < uiNumRanges)
+    {
+      m_ExtractedRenderDataPerRange.SetCount(uiNumRanges);
+    }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+    for (ezUInt32 i = 0; i < uiNumRanges; ++i)
     {
-      if ((CVarVisObjectName.GetValue().IsEmpty() ||
-            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
-          !CVarVisObjectSelection)
-      {
-        VisualizeObject(view, pObject);
-      }
+      m_ExtractedRenderDataPerRange[i].SetCamera(extractedRenderData.GetCamera());
+    }
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumRanges,
+      [this, &view, &visibleObjects, uiNumRanges](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        const ezUInt64 uiNumObjects = visibleObjects.GetCount();
+
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          const ezUInt32 uiFirstObject = static_cast<ezUInt32>(uiNumObjects * i / uiNumRanges);
+          const ezUInt32 uiEndObject = static_cast<ezUInt32>(uiNumObjects * (i + 1) / uiNumRanges);
+
+          auto objects = visibleObjects.GetArrayPtr().GetSubArray(uiFirstObject, uiEndObject - uiFirstObject);
+          ExtractRange(view, objects, m_ExtractedRenderDataPerRange[i]);
+        }
+      },
+      "ExtractRenderData");
+
+    // Merge in range order so the result is the same as with serial extraction
+    for (ezUInt32 i = 0; i < uiNumRanges; ++i)
+    {
+      extractedRenderData.AppendRenderData(m_ExtractedRenderDataPerRange[i]);
+      m_ExtractedRenderDataPerRange[i].Clear();
     }
-#endif
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -321,15 +361,39 @@ void ezVisibleObjectsExtractor::Extract(
 
     ezDebugRenderer::Draw2DText(hView, "Extraction Stats", ezVec2I32(10, 200), ezColor::LimeGreen);
 
-    sb.Format("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.Format("Num Cached Render Data: {0}", (ezInt32)m_uiNumCachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 220), ezColor::LimeGreen);
 
-    sb.Format("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.Format("Num Uncached Render Data: {0}", (ezInt32)m_uiNumUncachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 240), ezColor::LimeGreen);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::ExtractRange(
+  const ezView& view, ezArrayPtr<const ezGameObject* const> visibleObjects, ezExtractedRenderData& extractedRenderData)
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : visibleObjects)
+  {
+    ExtractRenderData(view, pObject, msg, extractedRenderData);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+    {
+      if ((CVarVisObjectName.GetValue().IsEmpty() ||
+            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
+          !CVarVisObjectSelection)
+      {
+        VisualizeObject(view, pObject);
+      }
+    }
+#endif
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSelectedObjectsExtractor, 1, ezRTTINoAllocator)
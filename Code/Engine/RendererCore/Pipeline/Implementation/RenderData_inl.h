@@ -59,7 +59,8 @@ static T* ezCreateRenderDataForThisFrame(const ezGameObject* pOwner)
 {
   EZ_CHECK_AT_COMPILETIME(EZ_IS_DERIVED_FROM_STATIC(ezRenderData, T));
 
-  T* pRenderData = EZ_NEW(ezFrameAllocator::GetCurrentAllocator(), T);
+  // render data is extracted on many threads at once, the lane of the calling thread avoids contention on the shared frame allocator
+  T* pRenderData = EZ_NEW(ezFrameAllocator::GetThreadAllocator(), T);
 
   if (pOwner != nullptr)
   {
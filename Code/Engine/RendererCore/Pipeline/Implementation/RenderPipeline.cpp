@@ -24,6 +24,7 @@ ezRenderPipeline::ezRenderPipeline()
 {
   m_CurrentExtractThread = (ezThreadID)0;
   m_CurrentRenderThread = (ezThreadID)0;
+  m_uiLastCullingFrame = -1;
   m_uiLastExtractionFrame = -1;
   m_uiLastRenderFrame = -1;
 
@@ -857,8 +858,17 @@ void ezRenderPipeline::ExtractData(const ezView& view)
 
   m_uiLastExtractionFrame = ezRenderWorld::GetFrameCounter();
 
-  // Determine visible objects
-  FindVisibleObjects(view);
+  // Determine visible objects, unless the view was already culled together with other views by ezRenderWorld::CullViews
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // the culling stats and debug output are only generated when a main view is culled on its own
+  const bool bIsMainView = (view.GetCameraUsageHint() == ezCameraUsageHint::MainView || view.GetCameraUsageHint() == ezCameraUsageHint::EditorView);
+  if (m_uiLastCullingFrame != ezRenderWorld::GetFrameCounter() || (bIsMainView && (CVarCullingStats || s_DebugCulling)))
+#else
+  if (m_uiLastCullingFrame != ezRenderWorld::GetFrameCounter())
+#endif
+  {
+    FindVisibleObjects(view);
+  }
 
   // Extract and sort data
   auto& data = m_Data[ezRenderWorld::GetDataIndexForExtraction()];
@@ -82,6 +82,8 @@ private:
 };
 
 /// \brief Creates render data that is only valid for this frame. The data is automatically deleted after the frame has been rendered.
+///
+/// The data is allocated from the frame allocator lane of the calling thread, see ezFrameAllocator::GetThreadAllocator().
 template <typename T>
 static T* ezCreateRenderDataForThisFrame(const ezGameObject* pOwner);
 
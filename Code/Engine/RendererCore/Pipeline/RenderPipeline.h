@@ -100,6 +100,7 @@ private: // Member data
 #endif
 
   ezHashedString m_sName;
+  ezUInt64 m_uiLastCullingFrame;
   ezUInt64 m_uiLastExtractionFrame;
   ezUInt64 m_uiLastRenderFrame;
 
@@ -431,6 +431,63 @@ void ezRenderWorld::AddViewToRender(const ezViewHandle& hView)
   }
 }
 
+void ezRenderWorld::CullViews(ezArrayPtr<ezView*> views)
+{
+  EZ_PROFILE_SCOPE("Visibility Culling");
+
+  const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask() | ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+  ezHybridArray<bool, 8> culled;
+  culled.SetCount(views.GetCount());
+
+  ezHybridArray<ezView*, 8> worldViews;
+  ezHybridArray<ezFrustum, 8> frustums;
+  ezHybridArray<ezDynamicArray<const ezGameObject*>, 8> visibleObjects;
+
+  for (ezUInt32 i = 0; i < views.GetCount(); ++i)
+  {
+    if (culled[i] || !views[i]->IsValid())
+      continue;
+
+    ezWorld* pWorld = views[i]->GetWorld();
+
+    worldViews.Clear();
+    for (ezUInt32 j = i; j < views.GetCount() && worldViews.GetCount() < ezSpatialSystem::MaxNumFrustumsPerQuery; ++j)
+    {
+      if (!culled[j] && views[j]->IsValid() && views[j]->GetWorld() == pWorld)
+      {
+        worldViews.PushBack(views[j]);
+        culled[j] = true;
+      }
+    }
+
+    frustums.SetCount(worldViews.GetCount());
+    visibleObjects.SetCount(worldViews.GetCount());
+
+    for (ezUInt32 v = 0; v < worldViews.GetCount(); ++v)
+    {
+      worldViews[v]->ComputeCullingFrustum(frustums[v]);
+
+      // reuse the memory of the pipeline's array
+      visibleObjects[v].Swap(worldViews[v]->m_pRenderPipeline->m_visibleObjects);
+      visibleObjects[v].Clear();
+    }
+
+    {
+      EZ_LOCK(pWorld->GetReadMarker());
+
+      pWorld->GetSpatialSystem()->FindVisibleObjects(frustums, uiCategoryBitmask, visibleObjects);
+    }
+
+    for (ezUInt32 v = 0; v < worldViews.GetCount(); ++v)
+    {
+      ezRenderPipeline* pPipeline = worldViews[v]->m_pRenderPipeline.Borrow();
+      pPipeline->m_visibleObjects.Swap(visibleObjects[v]);
+      pPipeline->m_uiLastCullingFrame = s_uiFrameCounter;
+    }
+  }
+}
+
 void ezRenderWorld::ExtractMainViews()
 {
   EZ_ASSERT_DEV(!s_bInExtract, "ExtractMainViews must not be called from multiple threads.");
@@ -442,6 +499,26 @@ void ezRenderWorld::ExtractMainViews()
   extractionEvent.m_uiFrameCounter = s_uiFrameCounter;
   s_ExtractionEvent.Broadcast(extractionEvent);
 
+  // main views that show the same world are culled in one pass
+  {
+    ezHybridArray<ezView*, 8> mainViews;
+
+    {
+      EZ_LOCK(s_ViewsMutex);
+
+      for (ezUInt32 i = 0; i < s_MainViews.GetCount(); ++i)
+      {
+        ezView* pView = nullptr;
+        if (s_Views.TryGetValue(s_MainViews[i], pView) && pView->IsValid())
+        {
+          mainViews.PushBack(pView);
+        }
+      }
+    }
+
+    CullViews(mainViews);
+  }
+
   if (CVarMultithreadedRendering)
   {
     s_ExtractTasks.Clear();
@@ -61,6 +61,11 @@ public:
 
   static void AddViewToRender(const ezViewHandle& hView);
 
+  /// \brief Culls the given views with one pass over the spatial system of each world, e.g. all cascades of a directional light.
+  ///
+  /// The render pipelines of these views skip their own culling when the views are extracted in the same frame.
+  static void CullViews(ezArrayPtr<ezView*> views);
+
   static void ExtractMainViews();
 
   static void Render(ezRenderContext* pRenderContext);
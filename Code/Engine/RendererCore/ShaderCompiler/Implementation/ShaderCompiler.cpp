@@ -3,6 +3,8 @@
 #include <Foundation/IO/FileSystem/DeferredFileWriter.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/LogEntry.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererCore/ShaderCompiler/ShaderParser.h>
@@ -40,7 +42,7 @@ namespace
     return false;
   }
 
-  static void GenerateDefines(const char* szPlatform, const ezArrayPtr<ezPermutationVar>& permutationVars, ezHybridArray<ezString, 32>& out_Defines)
+  static void GenerateDefines(const char* szPlatform, ezArrayPtr<const ezPermutationVar> permutationVars, ezHybridArray<ezString, 32>& out_Defines)
   {
     ezStringBuilder sTemp;
 
@@ -89,9 +91,73 @@ namespace
     }
   }
 
+  static void ForwardLogEntries(ezArrayPtr<const ezLogEntry> entries, ezLogInterface* pLog)
+  {
+    for (const ezLogEntry& entry : entries)
+    {
+      switch (entry.m_Type.GetValue())
+      {
+        case ezLogMsgType::ErrorMsg:
+          ezLog::Error(pLog, "{0}", entry.m_sMsg);
+          break;
+        case ezLogMsgType::SeriousWarningMsg:
+          ezLog::SeriousWarning(pLog, "{0}", entry.m_sMsg);
+          break;
+        case ezLogMsgType::WarningMsg:
+          ezLog::Warning(pLog, "{0}", entry.m_sMsg);
+          break;
+        case ezLogMsgType::SuccessMsg:
+          ezLog::Success(pLog, "{0}", entry.m_sMsg);
+          break;
+        case ezLogMsgType::InfoMsg:
+          ezLog::Info(pLog, "{0}", entry.m_sMsg);
+          break;
+        case ezLogMsgType::DevMsg:
+          ezLog::Dev(pLog, "{0}", entry.m_sMsg);
+          break;
+        case ezLogMsgType::DebugMsg:
+          ezLog::Debug(pLog, "{0}", entry.m_sMsg);
+          break;
+        default:
+          // log blocks that were opened during preprocessing are not forwarded
+          break;
+      }
+    }
+  }
+
+  /// \brief A single unique stage source and what compiling it produced.
+  struct StageCompileJob
+  {
+    ezShaderProgramCompiler::ezShaderProgramData m_Data;
+    ezDynamicArray<ezLogEntry> m_LogEntries;
+    bool m_bNeedsCompilation = false;
+    ezResult m_Result = EZ_FAILURE;
+  };
+
+  static void CompileStage(ezShaderProgramCompiler* pCompiler, StageCompileJob& job)
+  {
+    if (!job.m_bNeedsCompilation)
+      return;
+
+    // this may run on a worker thread, the messages are forwarded to the actual log afterwards
+    ezLogEntryDelegate logger([&job](ezLogEntry& entry) { job.m_LogEntries.PushBack(std::move(entry)); });
+    ezLogSystemScope logScope(&logger);
+
+    job.m_Result = pCompiler->Compile(job.m_Data, ezLog::GetThreadLocalLogSystem());
+  }
+
   static const char* s_szStageDefines[ezGALShaderStage::ENUM_COUNT] = {"VERTEX_SHADER", "HULL_SHADER", "DOMAIN_SHADER", "GEOMETRY_SHADER", "PIXEL_SHADER", "COMPUTE_SHADER"};
 } // namespace
 
+struct ezShaderCompiler::PermutationData
+{
+  ezShaderPermutationBinary m_Binary;
+  ezStringBuilder m_sProcessed[ezGALShaderStage::ENUM_COUNT];
+  ezSet<ezString> m_IncludeFiles;
+  ezDynamicArray<ezLogEntry> m_LogEntries;
+  ezResult m_Result = EZ_FAILURE;
+};
+
 ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification)
 {
   if (ezStringUtils::IsEqual(szAbsoluteFile, "ShaderRenderState"))
@@ -129,8 +195,6 @@ ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<e
     }
   }
 
-  m_IncludeFiles.Insert(szAbsoluteFile);
-
   ezFileReader r;
   if (r.Open(szAbsoluteFile).Failed())
   {
@@ -157,6 +221,98 @@ ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<e
 }
 
 ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFile, const ezArrayPtr<const ezPermutationVar>& permutationVars, ezLogInterface* pLog, const char* szPlatform)
+{
+  ezPermutationGenerator permutations;
+  for (const ezPermutationVar& var : permutationVars)
+  {
+    permutations.AddPermutation(var.m_sName, var.m_sValue);
+  }
+
+  return CompileShaderPermutationsForPlatforms(szFile, permutations, pLog, szPlatform);
+}
+
+ezResult ezShaderCompiler::CompileShaderPermutationsForPlatforms(const char* szFile, const ezPermutationGenerator& permutations, ezLogInterface* pLog, const char* szPlatform)
+{
+  m_Stats = Stats();
+
+  EZ_SUCCEED_OR_RETURN(ParseShaderFile(szFile));
+
+  ezDynamicArray<ezHybridArray<ezPermutationVar, 16>> usedPermutations;
+  {
+    ezHybridArray<ezPermutationVar, 16> permutationVars;
+    ezHashSet<ezUInt32> knownPermutations;
+
+    const ezUInt32 uiNumPermutations = permutations.GetPermutationCount();
+    for (ezUInt32 uiPermutation = 0; uiPermutation < uiNumPermutations; ++uiPermutation)
+    {
+      permutations.GetPermutation(uiPermutation, permutationVars);
+
+      ezHybridArray<ezPermutationVar, 16> usedPermutationVars;
+      for (const ezHashedString& usedPermutationVar : m_ShaderData.m_UsedPermutationVars)
+      {
+        ezUInt32 uiIndex = ezInvalidIndex;
+        for (ezUInt32 i = 0; i < permutationVars.GetCount(); ++i)
+        {
+          if (permutationVars[i].m_sName == usedPermutationVar)
+          {
+            uiIndex = i;
+            break;
+          }
+        }
+
+        if (uiIndex != ezInvalidIndex)
+        {
+          usedPermutationVars.PushBack(permutationVars[uiIndex]);
+        }
+        else
+        {
+          // the same variables are missing in every permutation
+          if (uiPermutation == 0)
+          {
+            ezLog::Error("No value given for permutation var '{0}'. Assuming default value of zero.", usedPermutationVar);
+          }
+
+          ezPermutationVar& finalVar = usedPermutationVars.ExpandAndGetRef();
+          finalVar.m_sName = usedPermutationVar;
+          finalVar.m_sValue.Assign("0");
+        }
+      }
+
+      // variables that the shader does not use result in the same permutation multiple times
+      if (knownPermutations.Insert(ezShaderHelper::CalculateHash(usedPermutationVars)))
+        continue;
+
+      usedPermutations.PushBack(usedPermutationVars);
+    }
+  }
+
+  // try out every compiler that we can find
+  ezRTTI* pRtti = ezRTTI::GetFirstInstance();
+  while (pRtti)
+  {
+    ezRTTIAllocator* pAllocator = pRtti->GetAllocator();
+    if (pRtti->IsDerivedFrom<ezShaderProgramCompiler>() && pAllocator->CanAllocate())
+    {
+      ezShaderProgramCompiler* pCompiler = pAllocator->Allocate<ezShaderProgramCompiler>();
+
+      const ezResult ret = RunShaderCompiler(szFile, szPlatform, pCompiler, usedPermutations, pLog);
+      pAllocator->Deallocate(pCompiler);
+
+      if (ret.Failed())
+        return ret;
+    }
+
+    pRtti = pRtti->GetNextInstance();
+  }
+
+  ezLog::Dev(pLog, "'{0}': {1} permutations, {2} of {3} stage sources compiled, preprocessing {4}ms, compilation {5}ms", szFile, m_Stats.m_uiNumPermutations,
+    m_Stats.m_uiNumCompiledStages, m_Stats.m_uiNumStageSources, ezArgF(m_Stats.m_PreprocessingTime.GetMilliseconds(), 1),
+    ezArgF(m_Stats.m_CompilationTime.GetMilliseconds(), 1));
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezShaderCompiler::ParseShaderFile(const char* szFile)
 {
   ezStringBuilder sFileContent, sTemp;
 
@@ -177,34 +333,7 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
 
   m_ShaderData.m_Platforms = sTemp;
 
-  ezHybridArray<ezHashedString, 16> usedPermutations;
-  ezShaderParser::ParsePermutationSection(Sections.GetSectionContent(ezShaderHelper::ezShaderSections::PERMUTATIONS, uiFirstLine), usedPermutations, m_ShaderData.m_FixedPermVars);
-
-  for (const ezHashedString& usedPermutationVar : usedPermutations)
-  {
-    ezUInt32 uiIndex = ezInvalidIndex;
-    for (ezUInt32 i = 0; i < permutationVars.GetCount(); ++i)
-    {
-      if (permutationVars[i].m_sName == usedPermutationVar)
-      {
-        uiIndex = i;
-        break;
-      }
-    }
-
-    if (uiIndex != ezInvalidIndex)
-    {
-      m_ShaderData.m_Permutations.PushBack(permutationVars[uiIndex]);
-    }
-    else
-    {
-      ezLog::Error("No value given for permutation var '{0}'. Assuming default value of zero.", usedPermutationVar);
-
-      ezPermutationVar& finalVar = m_ShaderData.m_Permutations.ExpandAndGetRef();
-      finalVar.m_sName = usedPermutationVar;
-      finalVar.m_sValue.Assign("0");
-    }
-  }
+  ezShaderParser::ParsePermutationSection(Sections.GetSectionContent(ezShaderHelper::ezShaderSections::PERMUTATIONS, uiFirstLine), m_ShaderData.m_UsedPermutationVars, m_ShaderData.m_FixedPermVars);
 
   m_ShaderData.m_StateSource = Sections.GetSectionContent(ezShaderHelper::ezShaderSections::RENDERSTATE, uiFirstLine);
 
@@ -257,37 +386,25 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
   m_StageSourceFile[ezGALShaderStage::ComputeShader] = tmp;
   m_StageSourceFile[ezGALShaderStage::ComputeShader].ChangeFileExtension("cs");
 
-  // try out every compiler that we can find
-  ezRTTI* pRtti = ezRTTI::GetFirstInstance();
-  while (pRtti)
+  // the sections of the previous shader may still be cached, the include files are kept since they are shared by most shaders
+  m_FileCache.Remove("ShaderRenderState");
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
   {
-    ezRTTIAllocator* pAllocator = pRtti->GetAllocator();
-    if (pRtti->IsDerivedFrom<ezShaderProgramCompiler>() && pAllocator->CanAllocate())
-    {
-      ezShaderProgramCompiler* pCompiler = pAllocator->Allocate<ezShaderProgramCompiler>();
-
-      const ezResult ret = RunShaderCompiler(szFile, szPlatform, pCompiler, pLog);
-      pAllocator->Deallocate(pCompiler);
-
-      if (ret.Failed())
-        return ret;
-    }
-
-    pRtti = pRtti->GetNextInstance();
+    m_FileCache.Remove(m_StageSourceFile[stage]);
   }
 
   return EZ_SUCCESS;
 }
 
-ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezLogInterface* pLog)
+ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezArrayPtr<const ezHybridArray<ezPermutationVar, 16>> permutations, ezLogInterface* pLog)
 {
   EZ_LOG_BLOCK(pLog, "Compiling Shader", szFile);
 
-  ezStringBuilder sProcessed[ezGALShaderStage::ENUM_COUNT];
-
   ezHybridArray<ezString, 4> Platforms;
   pCompiler->GetSupportedPlatforms(Platforms);
 
+  ezResult result = EZ_SUCCESS;
+
   for (ezUInt32 p = 0; p < Platforms.GetCount(); ++p)
   {
     if (!PlatformEnabled(szPlatform, Platforms[p].GetData()))
@@ -299,189 +416,333 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
 
     EZ_LOG_BLOCK(pLog, "Platform", Platforms[p].GetData());
 
-    ezShaderProgramCompiler::ezShaderProgramData spd;
-    spd.m_szSourceFile = szFile;
-    spd.m_szPlatform = Platforms[p].GetData();
+    ezBitflags<ezShaderCompilerFlags> flags;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
     // 'DEBUG' is a platform tag that enables additional compiler flags
     if (PlatformEnabled(m_ShaderData.m_Platforms, "DEBUG"))
     {
       ezLog::Warning("Shader specifies the 'DEBUG' platform, which enables the debug shader compiler flag.");
-      spd.m_Flags.Add(ezShaderCompilerFlags::Debug);
+      flags.Add(ezShaderCompilerFlags::Debug);
     }
 #endif
 
-    m_IncludeFiles.Clear();
+    ezDynamicArray<PermutationData> permutationData;
+    permutationData.SetCount(permutations.GetCount());
+
+    for (ezUInt32 i = 0; i < permutations.GetCount(); ++i)
+    {
+      permutationData[i].m_Binary.m_PermutationVars = permutations[i];
+    }
+
+    m_Stats.m_uiNumPermutations += permutations.GetCount();
+
+    // Preprocess all permutations in parallel, they share the tokenized include files through m_FileCache
+    {
+      const ezTime tStart = ezTime::Now();
+      const char* szCurrentPlatform = Platforms[p].GetData();
+
+      ezParallelForParams params;
+      params.uiBinSize = 2; // a single permutation, e.g. when compiling at runtime, is preprocessed directly on this thread
+
+      ezTaskSystem::ParallelForIndexed(
+        0, permutationData.GetCount(),
+        [this, szCurrentPlatform, &permutationData](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+          for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+          {
+            PreprocessPermutation(szCurrentPlatform, permutationData[i]);
+          }
+        },
+        "Preprocess Shader Permutations", params);
+
+      m_Stats.m_PreprocessingTime += ezTime::Now() - tStart;
+    }
 
-    ezHybridArray<ezString, 32> defines;
-    GenerateDefines(Platforms[p].GetData(), m_ShaderData.m_Permutations, defines);
-    GenerateDefines(Platforms[p].GetData(), m_ShaderData.m_FixedPermVars, defines);
+    const ezTime tCompilationStart = ezTime::Now();
 
-    ezShaderPermutationBinary shaderPermutationBinary;
+    // Identical stage sources are only compiled once, the key is the stage and the source hash
+    ezHashTable<ezUInt64, ezUInt32> stageSourceToJob;
+    ezDynamicArray<StageCompileJob> compileJobs;
 
-    // Generate Shader State Source
+    for (ezUInt32 uiPermutation = 0; uiPermutation < permutationData.GetCount(); ++uiPermutation)
     {
-      EZ_LOG_BLOCK(pLog, "Preprocessing Shader State Source");
+      PermutationData& data = permutationData[uiPermutation];
 
-      ezPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
-      pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
-      pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
-      pp.SetPassThroughPragma(false);
-      pp.SetPassThroughLine(false);
+      // the messages are forwarded in a deterministic order, independent of which thread did the preprocessing
+      ForwardLogEntries(data.m_LogEntries, pLog);
 
-      for (auto& define : defines)
+      if (data.m_Result.Failed())
       {
-        EZ_SUCCEED_OR_RETURN(pp.AddCustomDefine(define));
+        result = EZ_FAILURE;
+        continue;
       }
 
-      bool bFoundUndefinedVars = false;
-      pp.m_ProcessingEvents.AddEventHandler([&bFoundUndefinedVars](const ezPreprocessor::ProcessingEvent& e) {
-        if (e.m_Type == ezPreprocessor::ProcessingEvent::EvaluateUnknown)
+      for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+      {
+        const ezUInt32 uiSourceHash = data.m_Binary.m_uiShaderStageHashes[stage];
+
+        if (uiSourceHash == 0)
+          continue;
+
+        ++m_Stats.m_uiNumStageSources;
+
+        const ezUInt64 uiKey = (static_cast<ezUInt64>(stage) << 32) | uiSourceHash;
+
+        if (stageSourceToJob.Contains(uiKey))
+          continue;
+
+        stageSourceToJob.Insert(uiKey, compileJobs.GetCount());
+
+        StageCompileJob& job = compileJobs.ExpandAndGetRef();
+        job.m_Data.m_szSourceFile = szFile;
+        job.m_Data.m_szPlatform = Platforms[p].GetData();
+        job.m_Data.m_Flags = flags;
+        job.m_Data.m_szShaderSource[stage] = data.m_sProcessed[stage];
+        job.m_Data.m_StageBinary[stage].m_Stage = (ezGALShaderStage::Enum)stage;
+        job.m_Data.m_StageBinary[stage].m_uiSourceHash = uiSourceHash;
+
+        ezShaderStageBinary* pBinary = ezShaderStageBinary::LoadStageBinary((ezGALShaderStage::Enum)stage, uiSourceHash);
+
+        if (pBinary)
         {
-          bFoundUndefinedVars = true;
+          job.m_Data.m_StageBinary[stage] = *pBinary;
+          job.m_Data.m_bWriteToDisk[stage] = pBinary->GetByteCode().IsEmpty();
+        }
 
-          ezLog::Error("Undefined variable is evaluated: '{0}' (File: '{1}', Line: {2}", e.m_pToken->m_DataView, e.m_pToken->m_File, e.m_pToken->m_uiLine);
+        if (job.m_Data.m_StageBinary[stage].GetByteCode().IsEmpty())
+        {
+          job.m_bNeedsCompilation = true;
+          ++m_Stats.m_uiNumCompiledStages;
+        }
+        else
+        {
+          job.m_Result = EZ_SUCCESS;
         }
-      });
+      }
+    }
 
-      ezStringBuilder sOutput;
-      if (pp.Process("ShaderRenderState", sOutput, false).Failed() || bFoundUndefinedVars)
+    // Each job only contains a single stage, so compilers that support it compile all unique stage sources in parallel
+    if (pCompiler->IsThreadSafe())
+    {
+      ezTaskSystem::ParallelForIndexed(
+        0, compileJobs.GetCount(),
+        [pCompiler, &compileJobs](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+          for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+          {
+            CompileStage(pCompiler, compileJobs[i]);
+          }
+        },
+        "Compile Shader Stages");
+    }
+    else
+    {
+      for (StageCompileJob& job : compileJobs)
       {
-        ezLog::Error(pLog, "Preprocessing the Shader State block failed");
-        return EZ_FAILURE;
+        CompileStage(pCompiler, job);
       }
-      else
+    }
+
+    for (StageCompileJob& job : compileJobs)
+    {
+      ForwardLogEntries(job.m_LogEntries, pLog);
+
+      // if compilation failed, the stage binary for the source hash will simply not exist and therefore cannot be loaded
+      if (job.m_Result.Failed())
+      {
+        WriteFailedShaderSource(job.m_Data, pLog);
+        continue;
+      }
+
+      for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
       {
-        if (shaderPermutationBinary.m_StateDescriptor.Load(sOutput).Failed())
+        if (job.m_Data.m_StageBinary[stage].m_uiSourceHash != 0 && job.m_Data.m_bWriteToDisk[stage])
         {
-          ezLog::Error(pLog, "Failed to interpret the shader state block");
-          return EZ_FAILURE;
+          if (job.m_Data.m_StageBinary[stage].WriteStageBinary(pLog).Failed())
+          {
+            ezLog::Error(pLog, "Writing stage {0} binary failed", stage);
+            job.m_Result = EZ_FAILURE;
+          }
         }
       }
     }
 
-    for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+    for (ezUInt32 uiPermutation = 0; uiPermutation < permutationData.GetCount(); ++uiPermutation)
     {
-      spd.m_StageBinary[stage].m_Stage = (ezGALShaderStage::Enum)stage;
-      spd.m_StageBinary[stage].m_uiSourceHash = 0;
+      PermutationData& data = permutationData[uiPermutation];
 
-      if (m_ShaderData.m_ShaderStageSource[stage].IsEmpty())
+      if (data.m_Result.Failed())
         continue;
 
-      bool bFoundUndefinedVars = false;
-
-      ezPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
-      pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
-      pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
-      pp.SetPassThroughPragma(true);
-      pp.SetPassThroughUnknownCmdsCB(ezMakeDelegate(&ezShaderCompiler::PassThroughUnknownCommandCB, this));
-      pp.SetPassThroughLine(false);
-      pp.m_ProcessingEvents.AddEventHandler([&bFoundUndefinedVars](const ezPreprocessor::ProcessingEvent& e) {
-        if (e.m_Type == ezPreprocessor::ProcessingEvent::EvaluateUnknown)
-        {
-          bFoundUndefinedVars = true;
+      // a permutation only fails if one of its own stages failed, the stages it shares with other permutations are still written
+      for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+      {
+        const ezUInt32 uiSourceHash = data.m_Binary.m_uiShaderStageHashes[stage];
 
-          ezLog::Error("Undefined variable is evaluated: '{0}' (File: '{1}', Line: {2}", e.m_pToken->m_DataView, e.m_pToken->m_File, e.m_pToken->m_uiLine);
+        if (uiSourceHash == 0)
+          continue;
+
+        const ezUInt64 uiKey = (static_cast<ezUInt64>(stage) << 32) | uiSourceHash;
+
+        if (compileJobs[*stageSourceToJob.GetValue(uiKey)].m_Result.Failed())
+        {
+          data.m_Result = EZ_FAILURE;
         }
-      });
+      }
 
-      EZ_SUCCEED_OR_RETURN(pp.AddCustomDefine(s_szStageDefines[stage]));
-      for (auto& define : defines)
+      if (data.m_Result.Failed())
       {
-        EZ_SUCCEED_OR_RETURN(pp.AddCustomDefine(define));
+        result = EZ_FAILURE;
+        continue;
       }
 
-      ezUInt32 uiSourceStringLen = 0;
-      if (pp.Process(m_StageSourceFile[stage], sProcessed[stage], true, true, true).Failed() || bFoundUndefinedVars)
-      {
-        sProcessed[stage].Clear();
-        spd.m_szShaderSource[stage] = m_StageSourceFile[stage];
-        uiSourceStringLen = m_StageSourceFile[stage].GetElementCount();
+      ezStringBuilder sTemp = ezShaderManager::GetCacheDirectory();
+      sTemp.AppendPath(Platforms[p].GetData());
+      sTemp.AppendPath(szFile);
+      sTemp.ChangeFileExtension("");
+      if (sTemp.EndsWith("."))
+        sTemp.Shrink(0, 1);
 
-        ezLog::Error(pLog, "Shader preprocessing failed");
-        return EZ_FAILURE;
-      }
-      else
+      const ezUInt32 uiPermutationHash = ezShaderHelper::CalculateHash(data.m_Binary.m_PermutationVars);
+      sTemp.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
+
+      data.m_Binary.m_DependencyFile.Clear();
+      data.m_Binary.m_DependencyFile.AddFileDependency(szFile);
+
+      for (auto it = data.m_IncludeFiles.GetIterator(); it.IsValid(); ++it)
       {
-        spd.m_szShaderSource[stage] = sProcessed[stage];
-        uiSourceStringLen = sProcessed[stage].GetElementCount();
+        data.m_Binary.m_DependencyFile.AddFileDependency(it.Key());
       }
 
-      spd.m_StageBinary[stage].m_uiSourceHash = ezHashingUtils::xxHash32(spd.m_szShaderSource[stage], uiSourceStringLen);
+      ezDeferredFileWriter PermutationFileOut;
+      PermutationFileOut.SetOutput(sTemp.GetData());
+      EZ_SUCCEED_OR_RETURN(data.m_Binary.Write(PermutationFileOut));
 
-      if (spd.m_StageBinary[stage].m_uiSourceHash != 0)
+      if (PermutationFileOut.Close().Failed())
       {
-        ezShaderStageBinary* pBinary = ezShaderStageBinary::LoadStageBinary((ezGALShaderStage::Enum)stage, spd.m_StageBinary[stage].m_uiSourceHash);
-
-        if (pBinary)
-        {
-          spd.m_StageBinary[stage] = *pBinary;
-          spd.m_bWriteToDisk[stage] = pBinary->GetByteCode().IsEmpty();
-        }
+        ezLog::Error(pLog, "Could not open file for writing: '{0}'", sTemp);
+        data.m_Result = EZ_FAILURE;
+        result = EZ_FAILURE;
       }
     }
 
-    // copy the source hashes
-    for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+    m_Stats.m_CompilationTime += ezTime::Now() - tCompilationStart;
+  }
+
+  return result;
+}
+
+void ezShaderCompiler::PreprocessPermutation(const char* szPlatform, PermutationData& data)
+{
+  // this runs on a worker thread, the messages are forwarded to the actual log afterwards
+  ezLogEntryDelegate logger([&data](ezLogEntry& entry) { data.m_LogEntries.PushBack(std::move(entry)); });
+  ezLogSystemScope logScope(&logger);
+
+  ezHybridArray<ezString, 32> defines;
+  GenerateDefines(szPlatform, data.m_Binary.m_PermutationVars, defines);
+  GenerateDefines(szPlatform, m_ShaderData.m_FixedPermVars, defines);
+
+  // the file cache only calls FileOpen for files that are not cached yet, so the includes are recorded when they are located
+  auto locateFile = [&data](const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath) -> ezResult {
+    EZ_SUCCEED_OR_RETURN(ezPreprocessor::DefaultFileLocator(szCurAbsoluteFile, szIncludeFile, IncType, out_sAbsoluteFilePath));
+
+    if (IncType != ezPreprocessor::MainFile)
     {
-      shaderPermutationBinary.m_uiShaderStageHashes[stage] = spd.m_StageBinary[stage].m_uiSourceHash;
+      data.m_IncludeFiles.Insert(out_sAbsoluteFilePath);
     }
 
-    // if compilation failed, the stage binary for the source hash will simply not exist and therefore cannot be loaded
-    // the .ezPermutation file should be updated, however, to store the new source hash to the broken shader
-    if (pCompiler->Compile(spd, ezLog::GetThreadLocalLogSystem()).Failed())
+    return EZ_SUCCESS;
+  };
+
+  // Generate Shader State Source
+  {
+    EZ_LOG_BLOCK("Preprocessing Shader State Source");
+
+    ezPreprocessor pp;
+    pp.SetCustomFileCache(&m_FileCache);
+    pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
+    pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
+    pp.SetFileLocatorFunction(locateFile);
+    pp.SetPassThroughPragma(false);
+    pp.SetPassThroughLine(false);
+
+    for (auto& define : defines)
     {
-      WriteFailedShaderSource(spd, pLog);
-      return EZ_FAILURE;
+      if (pp.AddCustomDefine(define).Failed())
+        return;
     }
 
-    for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+    bool bFoundUndefinedVars = false;
+    pp.m_ProcessingEvents.AddEventHandler([&bFoundUndefinedVars](const ezPreprocessor::ProcessingEvent& e) {
+      if (e.m_Type == ezPreprocessor::ProcessingEvent::EvaluateUnknown)
+      {
+        bFoundUndefinedVars = true;
+
+        ezLog::Error("Undefined variable is evaluated: '{0}' (File: '{1}', Line: {2}", e.m_pToken->m_DataView, e.m_pToken->m_File, e.m_pToken->m_uiLine);
+      }
+    });
+
+    ezStringBuilder sOutput;
+    if (pp.Process("ShaderRenderState", sOutput, false).Failed() || bFoundUndefinedVars)
+    {
+      ezLog::Error("Preprocessing the Shader State block failed");
+      return;
+    }
+    else
     {
-      if (spd.m_StageBinary[stage].m_uiSourceHash != 0 && spd.m_bWriteToDisk[stage])
+      if (data.m_Binary.m_StateDescriptor.Load(sOutput).Failed())
       {
-        if (spd.m_StageBinary[stage].WriteStageBinary(pLog).Failed())
-        {
-          ezLog::Error(pLog, "Writing stage {0} binary failed", stage);
-          return EZ_FAILURE;
-        }
+        ezLog::Error("Failed to interpret the shader state block");
+        return;
       }
     }
+  }
 
-    ezStringBuilder sTemp = ezShaderManager::GetCacheDirectory();
-    sTemp.AppendPath(Platforms[p].GetData());
-    sTemp.AppendPath(szFile);
-    sTemp.ChangeFileExtension("");
-    if (sTemp.EndsWith("."))
-      sTemp.Shrink(0, 1);
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    if (m_ShaderData.m_ShaderStageSource[stage].IsEmpty())
+      continue;
+
+    bool bFoundUndefinedVars = false;
+
+    ezPreprocessor pp;
+    pp.SetCustomFileCache(&m_FileCache);
+    pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
+    pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
+    pp.SetFileLocatorFunction(locateFile);
+    pp.SetPassThroughPragma(true);
+    pp.SetPassThroughUnknownCmdsCB(ezMakeDelegate(&ezShaderCompiler::PassThroughUnknownCommandCB, this));
+    pp.SetPassThroughLine(false);
+    pp.m_ProcessingEvents.AddEventHandler([&bFoundUndefinedVars](const ezPreprocessor::ProcessingEvent& e) {
+      if (e.m_Type == ezPreprocessor::ProcessingEvent::EvaluateUnknown)
+      {
+        bFoundUndefinedVars = true;
 
-    const ezUInt32 uiPermutationHash = ezShaderHelper::CalculateHash(m_ShaderData.m_Permutations);
-    sTemp.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
+        ezLog::Error("Undefined variable is evaluated: '{0}' (File: '{1}', Line: {2}", e.m_pToken->m_DataView, e.m_pToken->m_File, e.m_pToken->m_uiLine);
+      }
+    });
 
-    shaderPermutationBinary.m_DependencyFile.Clear();
-    shaderPermutationBinary.m_DependencyFile.AddFileDependency(szFile);
+    if (pp.AddCustomDefine(s_szStageDefines[stage]).Failed())
+      return;
 
-    for (auto it = m_IncludeFiles.GetIterator(); it.IsValid(); ++it)
+    for (auto& define : defines)
     {
-      shaderPermutationBinary.m_DependencyFile.AddFileDependency(it.Key());
+      if (pp.AddCustomDefine(define).Failed())
+        return;
     }
 
-    shaderPermutationBinary.m_PermutationVars = m_ShaderData.m_Permutations;
-
-    ezDeferredFileWriter PermutationFileOut;
-    PermutationFileOut.SetOutput(sTemp.GetData());
-    EZ_SUCCEED_OR_RETURN(shaderPermutationBinary.Write(PermutationFileOut));
-
-    if (PermutationFileOut.Close().Failed())
+    ezStringBuilder& sProcessed = data.m_sProcessed[stage];
+    if (pp.Process(m_StageSourceFile[stage], sProcessed, true, true, true).Failed() || bFoundUndefinedVars)
     {
-      ezLog::Error(pLog, "Could not open file for writing: '{0}'", sTemp);
-      return EZ_FAILURE;
+      sProcessed.Clear();
+
+      ezLog::Error("Shader preprocessing failed");
+      return;
     }
+
+    data.m_Binary.m_uiShaderStageHashes[stage] = ezHashingUtils::xxHash32(sProcessed.GetData(), sProcessed.GetElementCount());
   }
 
-  return EZ_SUCCESS;
+  data.m_Result = EZ_SUCCESS;
 }
 
 
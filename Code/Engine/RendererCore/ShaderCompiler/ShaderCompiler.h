@@ -5,6 +5,7 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Time/Time.h>
 #include <Foundation/Types/Bitflags.h>
 #include <RendererCore/Declarations.h>
 #include <RendererCore/Shader/Implementation/Helper.h>
@@ -59,16 +60,49 @@ public:
   virtual void GetSupportedPlatforms(ezHybridArray<ezString, 4>& Platforms) = 0;
 
   virtual ezResult Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog) = 0;
+
+  /// \brief Whether Compile() may be called from several threads at the same time.
+  ///
+  /// If so, ezShaderCompiler compiles all unique stage sources of a shader in parallel on the task system.
+  virtual bool IsThreadSafe() const { return false; }
 };
 
 class EZ_RENDERERCORE_DLL ezShaderCompiler
 {
 public:
+  /// \brief Describes the work that the last call to CompileShaderPermutationForPlatforms() or CompileShaderPermutationsForPlatforms() did.
+  struct Stats
+  {
+    ezUInt32 m_uiNumPermutations = 0;    ///< How many permutations were preprocessed, summed up over all platforms.
+    ezUInt32 m_uiNumStageSources = 0;    ///< How many non-empty shader stage sources the preprocessing generated.
+    ezUInt32 m_uiNumCompiledStages = 0;  ///< How many unique stage sources were passed to the platform compilers.
+    ezTime m_PreprocessingTime;
+    ezTime m_CompilationTime;
+  };
+
   ezResult CompileShaderPermutationForPlatforms(
     const char* szFile, const ezArrayPtr<const ezPermutationVar>& permutationVars, ezLogInterface* pLog, const char* szPlatform = "ALL");
 
+  /// \brief Compiles all permutations of the given shader that \a permutations describes.
+  ///
+  /// The permutations are preprocessed in parallel on the task system and all preprocessors share one file cache.
+  /// Stage sources that are identical after preprocessing are only passed to the platform compiler once,
+  /// and they are compiled in parallel if the platform compiler is thread-safe.
+  /// A permutation only fails if one of its own stages fails to compile.
+  /// The file cache is kept alive as long as the ezShaderCompiler instance, so it is beneficial to reuse the same instance for many shaders.
+  ezResult CompileShaderPermutationsForPlatforms(const char* szFile, const ezPermutationGenerator& permutations, ezLogInterface* pLog, const char* szPlatform = "ALL");
+
+  /// \brief Returns what the last compilation did and how long it took.
+  const Stats& GetStats() const { return m_Stats; }
+
 private:
-  ezResult RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezLogInterface* pLog);
+  struct PermutationData;
+
+  ezResult ParseShaderFile(const char* szFile);
+
+  ezResult RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezArrayPtr<const ezHybridArray<ezPermutationVar, 16>> permutations, ezLogInterface* pLog);
+
+  void PreprocessPermutation(const char* szPlatform, PermutationData& data);
 
   void WriteFailedShaderSource(ezShaderProgramCompiler::ezShaderProgramData& spd, ezLogInterface* pLog);
 
@@ -77,7 +111,7 @@ private:
   struct ezShaderData
   {
     ezString m_Platforms;
-    ezHybridArray<ezPermutationVar, 16> m_Permutations;
+    ezHybridArray<ezHashedString, 16> m_UsedPermutationVars;
     ezHybridArray<ezPermutationVar, 16> m_FixedPermVars;
     ezString m_StateSource;
     ezString m_ShaderStageSource[ezGALShaderStage::ENUM_COUNT];
@@ -90,5 +124,5 @@ private:
   ezTokenizedFileCache m_FileCache;
   ezShaderData m_ShaderData;
 
-  ezSet<ezString> m_IncludeFiles;
+  Stats m_Stats;
 };
@@ -54,20 +54,32 @@ static const char* GetProfileName(const char* szPlatform, ezGALShaderStage::Enum
   return "";
 }
 
+ezShaderCompilerDXC::ezShaderCompilerDXC()
+{
+  // DXC is created once up front and not lazily in Compile()
+  Initialize().IgnoreResult();
+}
+
 ezResult ezShaderCompilerDXC::Initialize()
 {
-  if (s_pDxcUtils != nullptr)
-    return EZ_SUCCESS;
+  // the instances are shared by all compilers, the function-local static makes the creation thread-safe
+  static ezResult s_Result = []() -> ezResult {
+    if (FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&s_pDxcUtils))) || FAILED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&s_pDxcCompiler))))
+      return EZ_FAILURE;
 
-  DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&s_pDxcUtils));
-  DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&s_pDxcCompiler));
+    return EZ_SUCCESS;
+  }();
 
-  return EZ_SUCCESS;
+  return s_Result;
 }
 
 ezResult ezShaderCompilerDXC::Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog)
 {
-  EZ_SUCCEED_OR_RETURN(Initialize());
+  if (s_pDxcCompiler == nullptr)
+  {
+    ezLog::Error(pLog, "The DXC shader compiler could not be created.");
+    return EZ_FAILURE;
+  }
 
   for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
   {
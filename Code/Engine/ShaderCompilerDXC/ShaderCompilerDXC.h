@@ -10,6 +10,8 @@ class EZ_SHADERCOMPILERDXC_DLL ezShaderCompilerDXC : public ezShaderProgramCompi
   EZ_ADD_DYNAMIC_REFLECTION(ezShaderCompilerDXC, ezShaderProgramCompiler);
 
 public:
+  ezShaderCompilerDXC();
+
   virtual void GetSupportedPlatforms(ezHybridArray<ezString, 4>& Platforms) override { Platforms.PushBack("VULKAN"); }
 
   virtual ezResult Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog) override;
@@ -21,5 +23,5 @@ private:
   ezResult FillSRVResourceBinding(ezShaderStageBinary& shaderBinary, ezShaderResourceBinding& binding, const SpvReflectDescriptorBinding& info);
   ezResult FillUAVResourceBinding(ezShaderStageBinary& shaderBinary, ezShaderResourceBinding& binding, const SpvReflectDescriptorBinding& info);
 
-  ezResult Initialize();
+  static ezResult Initialize();
 };
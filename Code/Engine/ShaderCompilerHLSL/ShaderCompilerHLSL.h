@@ -20,6 +20,9 @@ public:
 
   virtual ezResult Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog) override;
 
+  /// \brief D3DCompile has no shared state, so the stages can be compiled in parallel.
+  virtual bool IsThreadSafe() const override { return true; }
+
 private:
   void ReflectShaderStage(ezShaderProgramData& inout_Data, ezGALShaderStage::Enum Stage);
   ezShaderConstantBufferLayout* ReflectConstantBufferLayout(ezShaderStageBinary& pStageBinary, ID3D11ShaderReflectionConstantBuffer* pConstantBufferReflection);
@@ -0,0 +1,1688 @@
+#include <TexturePCH.h>
+
+#include <Foundation/Math/Color16f.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/SimdMath/SimdVec4i.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Texture/Image/Conversions/BlockCompressConversions.h>
+#include <Texture/Image/Conversions/DXTConversions.h>
+#include <Texture/Image/Conversions/PixelConversions.h>
+#include <Texture/Image/ImageConversion.h>
+
+namespace
+{
+  enum
+  {
+    NumBlockPixels = 16,
+    MaxPaletteEntries = 16,
+    NumPartitionShapesBC6 = 32,
+    NumPartitionShapesBC7 = 64,
+    NumShapeCandidates = 4,
+  };
+
+  static const ezUInt32 s_bc67Weights2[4] = {0, 21, 43, 64};
+  static const ezUInt32 s_bc67Weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+  static const ezUInt32 s_bc67Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  const ezUInt32* GetWeightsBC67(ezUInt32 uiIndexBits)
+  {
+    return uiIndexBits == 2 ? s_bc67Weights2 : (uiIndexBits == 3 ? s_bc67Weights3 : s_bc67Weights4);
+  }
+
+  /// \brief The interpolation weights of BC6H and BC7 as factors between 0 and 1, for fitting the endpoints.
+  struct IndexFactorsBC67
+  {
+    IndexFactorsBC67()
+    {
+      for (ezUInt32 uiIndexBits = 2; uiIndexBits <= 4; ++uiIndexBits)
+      {
+        for (ezUInt32 i = 0; i < (1u << uiIndexBits); ++i)
+        {
+          m_Factors[uiIndexBits - 2][i] = GetWeightsBC67(uiIndexBits)[i] / 64.0f;
+        }
+      }
+    }
+
+    float m_Factors[3][16];
+  };
+
+  const float* GetIndexFactorsBC67(ezUInt32 uiIndexBits)
+  {
+    static IndexFactorsBC67 s_Factors;
+    return s_Factors.m_Factors[uiIndexBits - 2];
+  }
+
+  /// \brief The pixels of one block, once as an array for fitting the endpoints and once as SIMD vectors of 4 pixels each for the index search.
+  template <ezUInt32 N>
+  struct BlockData
+  {
+    float m_Pixels[NumBlockPixels][N];
+
+    /// Pixels with a weight of zero don't take part in fitting the endpoints and their errors are ignored.
+    /// This is also used to restrict the fitting to one subset of a partitioned block.
+    float m_Weights[NumBlockPixels];
+
+    ezSimdVec4f m_ChannelsSoA[N][4];
+    ezSimdVec4f m_WeightsSoA[4];
+
+    void UpdateSoA()
+    {
+      for (ezUInt32 g = 0; g < 4; ++g)
+      {
+        for (ezUInt32 c = 0; c < N; ++c)
+        {
+          m_ChannelsSoA[c][g].Set(m_Pixels[g * 4 + 0][c], m_Pixels[g * 4 + 1][c], m_Pixels[g * 4 + 2][c], m_Pixels[g * 4 + 3][c]);
+        }
+      }
+
+      UpdateWeightsSoA();
+    }
+
+    void UpdateWeightsSoA()
+    {
+      for (ezUInt32 g = 0; g < 4; ++g)
+      {
+        m_WeightsSoA[g].Set(m_Weights[g * 4 + 0], m_Weights[g * 4 + 1], m_Weights[g * 4 + 2], m_Weights[g * 4 + 3]);
+      }
+    }
+
+    void SetSubsetWeights(const ezUInt8* pPartition, ezUInt32 uiSubset)
+    {
+      for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+      {
+        m_Weights[i] = pPartition[i] == uiSubset ? 1.0f : 0.0f;
+      }
+    }
+  };
+
+  /// \brief Finds the closest palette entry for every pixel and returns the weighted sum of squared errors.
+  ///
+  /// Works on 4 pixels at once, each SIMD lane handles one pixel.
+  template <ezUInt32 N>
+  float FindBestIndices(const BlockData<N>& block, const float (&palette)[MaxPaletteEntries][N], ezUInt32 uiNumEntries, ezUInt8* out_pIndices)
+  {
+    ezSimdVec4f paletteSoA[MaxPaletteEntries][N];
+    for (ezUInt32 e = 0; e < uiNumEntries; ++e)
+    {
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        paletteSoA[e][c].Set(palette[e][c]);
+      }
+    }
+
+    ezSimdVec4f totalError = ezSimdVec4f::ZeroVector();
+
+    for (ezUInt32 g = 0; g < 4; ++g)
+    {
+      ezSimdVec4f bestError(ezMath::MaxValue<float>());
+      ezSimdVec4f bestIndex = ezSimdVec4f::ZeroVector();
+
+      for (ezUInt32 e = 0; e < uiNumEntries; ++e)
+      {
+        ezSimdVec4f error = ezSimdVec4f::ZeroVector();
+        for (ezUInt32 c = 0; c < N; ++c)
+        {
+          const ezSimdVec4f diff = block.m_ChannelsSoA[c][g] - paletteSoA[e][c];
+          error = ezSimdVec4f::MulAdd(diff, diff, error);
+        }
+
+        const ezSimdVec4b isBetter = error < bestError;
+        bestError = ezSimdVec4f::Select(isBetter, error, bestError);
+        bestIndex = ezSimdVec4f::Select(isBetter, ezSimdVec4f(static_cast<float>(e)), bestIndex);
+      }
+
+      totalError = ezSimdVec4f::MulAdd(bestError, block.m_WeightsSoA[g], totalError);
+
+      const ezSimdVec4i indices = ezSimdVec4i::Truncate(bestIndex);
+      out_pIndices[g * 4 + 0] = static_cast<ezUInt8>(indices.x());
+      out_pIndices[g * 4 + 1] = static_cast<ezUInt8>(indices.y());
+      out_pIndices[g * 4 + 2] = static_cast<ezUInt8>(indices.z());
+      out_pIndices[g * 4 + 3] = static_cast<ezUInt8>(indices.w());
+    }
+
+    return totalError.HorizontalSum<4>();
+  }
+
+  /// \brief Computes initial endpoints from the extent of the weighted pixels along their principal axis.
+  ///
+  /// Optionally returns the squared distance of the pixels to that axis, which is a cheap estimate of how well the pixels can be represented
+  /// by the endpoints.
+  template <ezUInt32 N>
+  void FindEndpoints(const BlockData<N>& block, float (&out_e0)[N], float (&out_e1)[N], float* out_pResidual = nullptr)
+  {
+    float mean[N] = {};
+    float fTotalWeight = 0.0f;
+
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        mean[c] += block.m_Pixels[i][c] * block.m_Weights[i];
+      }
+      fTotalWeight += block.m_Weights[i];
+    }
+
+    if (fTotalWeight <= 0.0f)
+    {
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        out_e0[c] = 0.0f;
+        out_e1[c] = 0.0f;
+      }
+
+      if (out_pResidual)
+        *out_pResidual = 0.0f;
+      return;
+    }
+
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      mean[c] /= fTotalWeight;
+    }
+
+    float covariance[N][N] = {};
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      for (ezUInt32 c0 = 0; c0 < N; ++c0)
+      {
+        const float d0 = (block.m_Pixels[i][c0] - mean[c0]) * block.m_Weights[i];
+        for (ezUInt32 c1 = 0; c1 < N; ++c1)
+        {
+          covariance[c0][c1] += d0 * (block.m_Pixels[i][c1] - mean[c1]);
+        }
+      }
+    }
+
+    // power iteration, starting with the row of the channel with the largest variance
+    ezUInt32 uiLargestChannel = 0;
+    float fTotalVariance = 0.0f;
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      fTotalVariance += covariance[c][c];
+      if (covariance[c][c] > covariance[uiLargestChannel][uiLargestChannel])
+        uiLargestChannel = c;
+    }
+
+    float axis[N];
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      axis[c] = covariance[uiLargestChannel][c];
+    }
+
+    for (ezUInt32 iteration = 0; iteration < 8; ++iteration)
+    {
+      float newAxis[N] = {};
+      float fMaxComponent = 0.0f;
+      for (ezUInt32 c0 = 0; c0 < N; ++c0)
+      {
+        for (ezUInt32 c1 = 0; c1 < N; ++c1)
+        {
+          newAxis[c0] += covariance[c0][c1] * axis[c1];
+        }
+        fMaxComponent = ezMath::Max(fMaxComponent, ezMath::Abs(newAxis[c0]));
+      }
+
+      if (fMaxComponent <= ezMath::SmallEpsilon<float>())
+        break;
+
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        axis[c] = newAxis[c] / fMaxComponent;
+      }
+    }
+
+    float fAxisLengthSquared = 0.0f;
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      fAxisLengthSquared += axis[c] * axis[c];
+    }
+
+    float fMinT = 0.0f;
+    float fMaxT = 0.0f;
+    float fAxisVariance = 0.0f;
+
+    if (fAxisLengthSquared > ezMath::SmallEpsilon<float>())
+    {
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        axis[c] /= ezMath::Sqrt(fAxisLengthSquared);
+      }
+
+      fMinT = ezMath::MaxValue<float>();
+      fMaxT = -ezMath::MaxValue<float>();
+
+      for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+      {
+        if (block.m_Weights[i] <= 0.0f)
+          continue;
+
+        float t = 0.0f;
+        for (ezUInt32 c = 0; c < N; ++c)
+        {
+          t += (block.m_Pixels[i][c] - mean[c]) * axis[c];
+        }
+
+        fMinT = ezMath::Min(fMinT, t);
+        fMaxT = ezMath::Max(fMaxT, t);
+        fAxisVariance += t * t * block.m_Weights[i];
+      }
+    }
+
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      out_e0[c] = mean[c] + fMinT * axis[c];
+      out_e1[c] = mean[c] + fMaxT * axis[c];
+    }
+
+    if (out_pResidual)
+    {
+      *out_pResidual = ezMath::Max(fTotalVariance - fAxisVariance, 0.0f);
+    }
+  }
+
+  /// \brief Computes the endpoints that minimize the squared error for the given indices.
+  ///
+  /// pFactors maps each index to its interpolation factor between the first and the second endpoint.
+  template <ezUInt32 N>
+  bool RefineEndpoints(const BlockData<N>& block, const ezUInt8* pIndices, const float* pFactors, float (&out_e0)[N], float (&out_e1)[N])
+  {
+    float a = 0.0f, b = 0.0f, d = 0.0f;
+    float rhs0[N] = {};
+    float rhs1[N] = {};
+
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      const float w = block.m_Weights[i];
+      const float t = pFactors[pIndices[i]];
+      const float s = 1.0f - t;
+
+      a += w * s * s;
+      b += w * s * t;
+      d += w * t * t;
+
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        rhs0[c] += w * s * block.m_Pixels[i][c];
+        rhs1[c] += w * t * block.m_Pixels[i][c];
+      }
+    }
+
+    const float fDeterminant = a * d - b * b;
+    if (ezMath::Abs(fDeterminant) <= ezMath::SmallEpsilon<float>())
+      return false;
+
+    const float fInvDeterminant = 1.0f / fDeterminant;
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      out_e0[c] = (d * rhs0[c] - b * rhs1[c]) * fInvDeterminant;
+      out_e1[c] = (a * rhs1[c] - b * rhs0[c]) * fInvDeterminant;
+    }
+
+    return true;
+  }
+
+  template <ezUInt32 N>
+  void ClampEndpoints(float (&e0)[N], float (&e1)[N], float fMaxValue)
+  {
+    for (ezUInt32 c = 0; c < N; ++c)
+    {
+      e0[c] = ezMath::Clamp(e0[c], 0.0f, fMaxValue);
+      e1[c] = ezMath::Clamp(e1[c], 0.0f, fMaxValue);
+    }
+  }
+
+  template <ezUInt32 N>
+  bool IsSingleColor(const BlockData<N>& block)
+  {
+    const float* pFirst = nullptr;
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      if (block.m_Weights[i] <= 0.0f)
+        continue;
+
+      if (pFirst == nullptr)
+      {
+        pFirst = block.m_Pixels[i];
+        continue;
+      }
+
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        if (block.m_Pixels[i][c] != pFirst[c])
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /// \brief Returns the partition shapes with the smallest estimated error, best first.
+  template <ezUInt32 N>
+  void FindShapeCandidates(BlockData<N> block, ezUInt32 uiNumShapes, ezUInt32 (&out_shapes)[NumShapeCandidates])
+  {
+    float errors[NumShapeCandidates];
+    for (ezUInt32 i = 0; i < NumShapeCandidates; ++i)
+    {
+      errors[i] = ezMath::MaxValue<float>();
+      out_shapes[i] = 0;
+    }
+
+    for (ezUInt32 uiShape = 0; uiShape < uiNumShapes; ++uiShape)
+    {
+      const ezUInt8* pPartition = ezGetPartitionShapeBC67(2, uiShape);
+
+      float fError = 0.0f;
+      for (ezUInt32 uiSubset = 0; uiSubset < 2; ++uiSubset)
+      {
+        block.SetSubsetWeights(pPartition, uiSubset);
+
+        float e0[N], e1[N], fResidual;
+        FindEndpoints(block, e0, e1, &fResidual);
+        fError += fResidual;
+      }
+
+      // insertion into the sorted candidate list
+      for (ezUInt32 i = 0; i < NumShapeCandidates; ++i)
+      {
+        if (fError < errors[i])
+        {
+          for (ezUInt32 j = NumShapeCandidates - 1; j > i; --j)
+          {
+            errors[j] = errors[j - 1];
+            out_shapes[j] = out_shapes[j - 1];
+          }
+
+          errors[i] = fError;
+          out_shapes[i] = uiShape;
+          break;
+        }
+      }
+    }
+  }
+
+  /// \brief Writes values into a block, starting at the least significant bit of the first byte.
+  struct BlockBitWriter
+  {
+    BlockBitWriter(ezUInt8* pData, ezUInt32 uiNumBytes)
+      : m_pData(pData)
+    {
+      ezMemoryUtils::ZeroFill(pData, uiNumBytes);
+    }
+
+    void Write(ezUInt32 uiValue, ezUInt32 uiNumBits)
+    {
+      for (ezUInt32 i = 0; i < uiNumBits; ++i, ++m_uiBit)
+      {
+        if ((uiValue >> i) & 1)
+        {
+          m_pData[m_uiBit >> 3] |= static_cast<ezUInt8>(1 << (m_uiBit & 7));
+        }
+      }
+    }
+
+    ezUInt8* m_pData;
+    ezUInt32 m_uiBit = 0;
+  };
+
+  /// \brief Swaps the endpoints of subsets whose anchor index has the most significant bit set, which can't be stored.
+  ///
+  /// Returns for each subset whether it was flipped, the caller then has to swap the endpoints.
+  void FixAnchorIndices(ezUInt32 uiNumSubsets, ezUInt32 uiShape, ezUInt32 uiIndexBits, ezUInt8* pIndices, bool (&out_flipped)[2])
+  {
+    const ezUInt8* pPartition = ezGetPartitionShapeBC67(uiNumSubsets, uiShape);
+    const ezUInt8 uiMaxIndex = static_cast<ezUInt8>((1u << uiIndexBits) - 1);
+
+    for (ezUInt32 uiSubset = 0; uiSubset < uiNumSubsets; ++uiSubset)
+    {
+      const ezUInt32 uiAnchor = ezGetAnchorIndexBC67(uiNumSubsets, uiShape, uiSubset);
+      out_flipped[uiSubset] = pIndices[uiAnchor] > (uiMaxIndex >> 1);
+
+      if (out_flipped[uiSubset])
+      {
+        for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+        {
+          if (pPartition[i] == uiSubset)
+            pIndices[i] = uiMaxIndex - pIndices[i];
+        }
+      }
+    }
+  }
+
+  void WriteIndicesBC67(BlockBitWriter& writer, ezUInt32 uiNumSubsets, ezUInt32 uiShape, ezUInt32 uiIndexBits, const ezUInt8* pIndices)
+  {
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      bool bIsAnchor = i == 0;
+      for (ezUInt32 uiSubset = 1; uiSubset < uiNumSubsets; ++uiSubset)
+      {
+        bIsAnchor |= ezGetAnchorIndexBC67(uiNumSubsets, uiShape, uiSubset) == i;
+      }
+
+      writer.Write(pIndices[i], bIsAnchor ? uiIndexBits - 1 : uiIndexBits);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // BC1
+
+  /// \brief Best pair of endpoint values for reproducing a single 8 bit value with the 2/3 interpolated color.
+  struct SingleColorTablesBC1
+  {
+    SingleColorTablesBC1()
+    {
+      // use the decoder's expansion, so that the tables match exactly what will be decoded
+      for (ezUInt32 uiBits = 5; uiBits <= 6; ++uiBits)
+      {
+        const ezUInt32 uiNumValues = 1u << uiBits;
+        ezUInt8(&table)[256][2] = uiBits == 5 ? m_Table5 : m_Table6;
+
+        for (ezUInt32 v = 0; v < 256; ++v)
+        {
+          ezUInt32 uiBestError = 0xFFFFFFFF;
+          for (ezUInt32 hi = 0; hi < uiNumValues; ++hi)
+          {
+            for (ezUInt32 lo = 0; lo < uiNumValues; ++lo)
+            {
+              const ezInt32 iInterpolated = (2 * Expand(hi, uiBits) + Expand(lo, uiBits) + 1) / 3;
+              const ezUInt32 uiError = ezMath::Abs(iInterpolated - static_cast<ezInt32>(v));
+              if (uiError < uiBestError)
+              {
+                uiBestError = uiError;
+                table[v][0] = static_cast<ezUInt8>(hi);
+                table[v][1] = static_cast<ezUInt8>(lo);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    static ezInt32 Expand(ezUInt32 uiValue, ezUInt32 uiBits)
+    {
+      // green has 6 bits, red and blue have 5
+      return uiBits == 6 ? ezDecompressB5G6R5(static_cast<ezUInt16>(uiValue << 5)).g : ezDecompressB5G6R5(static_cast<ezUInt16>(uiValue)).b;
+    }
+
+    ezUInt8 m_Table5[256][2];
+    ezUInt8 m_Table6[256][2];
+  };
+
+  const SingleColorTablesBC1& GetSingleColorTablesBC1()
+  {
+    static SingleColorTablesBC1 s_Tables;
+    return s_Tables;
+  }
+
+  ezUInt16 QuantizeB5G6R5(const float (&color)[3])
+  {
+    const ezUInt32 r = static_cast<ezUInt32>(ezMath::Clamp(color[0] * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f));
+    const ezUInt32 g = static_cast<ezUInt32>(ezMath::Clamp(color[1] * (63.0f / 255.0f) + 0.5f, 0.0f, 63.0f));
+    const ezUInt32 b = static_cast<ezUInt32>(ezMath::Clamp(color[2] * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f));
+    return static_cast<ezUInt16>((r << 11) | (g << 5) | b);
+  }
+
+  /// \brief Builds the palette exactly like ezDecompressBlockBC1 does and returns the number of usable entries.
+  ezUInt32 BuildPaletteBC1(ezUInt16 uiColor0, ezUInt16 uiColor1, bool bFourColorMode, float (&out_palette)[MaxPaletteEntries][3])
+  {
+    const ezColorBaseUB c0 = ezDecompressB5G6R5(uiColor0);
+    const ezColorBaseUB c1 = ezDecompressB5G6R5(uiColor1);
+
+    const ezInt32 col0[3] = {c0.r, c0.g, c0.b};
+    const ezInt32 col1[3] = {c1.r, c1.g, c1.b};
+
+    for (ezUInt32 c = 0; c < 3; ++c)
+    {
+      out_palette[0][c] = static_cast<float>(col0[c]);
+      out_palette[1][c] = static_cast<float>(col1[c]);
+
+      if (bFourColorMode)
+      {
+        out_palette[2][c] = static_cast<float>((2 * col0[c] + col1[c] + 1) / 3);
+        out_palette[3][c] = static_cast<float>((col0[c] + 2 * col1[c] + 1) / 3);
+      }
+      else
+      {
+        out_palette[2][c] = static_cast<float>((col0[c] + col1[c]) / 2);
+      }
+    }
+
+    return bFourColorMode ? 4 : 3;
+  }
+
+  void WriteBlockBC1(ezUInt16 uiColor0, ezUInt16 uiColor1, const ezUInt8* pIndices, ezUInt8* pTarget)
+  {
+    ezUInt32 uiIndexBits = 0;
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      uiIndexBits |= static_cast<ezUInt32>(pIndices[i]) << (2 * i);
+    }
+
+    pTarget[0] = static_cast<ezUInt8>(uiColor0);
+    pTarget[1] = static_cast<ezUInt8>(uiColor0 >> 8);
+    pTarget[2] = static_cast<ezUInt8>(uiColor1);
+    pTarget[3] = static_cast<ezUInt8>(uiColor1 >> 8);
+    pTarget[4] = static_cast<ezUInt8>(uiIndexBits);
+    pTarget[5] = static_cast<ezUInt8>(uiIndexBits >> 8);
+    pTarget[6] = static_cast<ezUInt8>(uiIndexBits >> 16);
+    pTarget[7] = static_cast<ezUInt8>(uiIndexBits >> 24);
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // BC4 (used for the alpha channel of BC3)
+
+  ezUInt32 FindBestIndicesBC4(const ezUInt8* pValues, ezUInt32 a0, ezUInt32 a1, ezUInt8* out_pIndices)
+  {
+    ezUInt32 palette[8];
+    ezUnpackPaletteBC4(a0, a1, palette);
+
+    ezUInt32 uiTotalError = 0;
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      ezUInt32 uiBestError = 0xFFFFFFFF;
+      for (ezUInt32 e = 0; e < 8; ++e)
+      {
+        const ezInt32 iDiff = static_cast<ezInt32>(palette[e]) - static_cast<ezInt32>(pValues[i]);
+        const ezUInt32 uiError = static_cast<ezUInt32>(iDiff * iDiff);
+        if (uiError < uiBestError)
+        {
+          uiBestError = uiError;
+          out_pIndices[i] = static_cast<ezUInt8>(e);
+        }
+      }
+
+      uiTotalError += uiBestError;
+    }
+
+    return uiTotalError;
+  }
+
+  void CompressBlockBC4(const ezUInt8* pValues, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality)
+  {
+    ezUInt32 uiMin = 255, uiMax = 0;
+    ezUInt32 uiMinInner = 255, uiMaxInner = 0;
+
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      uiMin = ezMath::Min<ezUInt32>(uiMin, pValues[i]);
+      uiMax = ezMath::Max<ezUInt32>(uiMax, pValues[i]);
+
+      if (pValues[i] != 0 && pValues[i] != 255)
+      {
+        uiMinInner = ezMath::Min<ezUInt32>(uiMinInner, pValues[i]);
+        uiMaxInner = ezMath::Max<ezUInt32>(uiMaxInner, pValues[i]);
+      }
+    }
+
+    ezUInt32 uiBestA0 = uiMax;
+    ezUInt32 uiBestA1 = uiMin;
+    ezUInt8 bestIndices[NumBlockPixels];
+    ezUInt32 uiBestError = FindBestIndicesBC4(pValues, uiBestA0, uiBestA1, bestIndices);
+
+    if (quality == ezBlockCompressionQuality::High && uiBestError > 0)
+    {
+      ezUInt8 indices[NumBlockPixels];
+
+      auto TryEndpoints = [&](ezUInt32 a0, ezUInt32 a1) {
+        const ezUInt32 uiError = FindBestIndicesBC4(pValues, a0, a1, indices);
+        if (uiError < uiBestError)
+        {
+          uiBestError = uiError;
+          uiBestA0 = a0;
+          uiBestA1 = a1;
+          ezMemoryUtils::Copy(bestIndices, indices, NumBlockPixels);
+        }
+      };
+
+      // the 8 value mode with a slightly smaller range
+      for (ezUInt32 uiInsetMax = 0; uiInsetMax < 4; ++uiInsetMax)
+      {
+        for (ezUInt32 uiInsetMin = 0; uiInsetMin < 4; ++uiInsetMin)
+        {
+          if (uiMax >= uiMin + uiInsetMin + uiInsetMax + 1)
+          {
+            TryEndpoints(uiMax - uiInsetMax, uiMin + uiInsetMin);
+          }
+        }
+      }
+
+      // the 6 value mode, which has exact 0 and 255 entries
+      if (uiMinInner <= uiMaxInner)
+      {
+        TryEndpoints(uiMinInner, uiMaxInner);
+      }
+    }
+
+    pTarget[0] = static_cast<ezUInt8>(uiBestA0);
+    pTarget[1] = static_cast<ezUInt8>(uiBestA1);
+
+    ezUInt64 uiIndexBits = 0;
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      uiIndexBits |= static_cast<ezUInt64>(bestIndices[i]) << (3 * i);
+    }
+
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      pTarget[2 + i] = static_cast<ezUInt8>(uiIndexBits >> (8 * i));
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // BC6H
+
+  /// \brief Unquantizes an unsigned endpoint the same way the decoder does.
+  ezInt32 UnquantizeBC6(ezInt32 iValue, ezUInt32 uiBits)
+  {
+    if (iValue == 0)
+      return 0;
+    if (iValue == (1 << uiBits) - 1)
+      return 0xFFFF;
+    return ((iValue << 16) + 0x8000) >> uiBits;
+  }
+
+  ezInt32 QuantizeBC6(float fValue, ezUInt32 uiBits)
+  {
+    const ezInt32 iMaxValue = (1 << uiBits) - 1;
+    const ezInt32 iValue = ezMath::Clamp(static_cast<ezInt32>((fValue * (1 << uiBits) - 32768.0f) / 65536.0f + 0.5f), 0, iMaxValue);
+
+    // the first and the last value don't follow the regular spacing
+    ezInt32 iBestValue = iValue;
+    float fBestError = ezMath::Abs(static_cast<float>(UnquantizeBC6(iValue, uiBits)) - fValue);
+    for (ezInt32 iCandidate = ezMath::Max(iValue - 1, 0); iCandidate <= ezMath::Min(iValue + 1, iMaxValue); ++iCandidate)
+    {
+      const float fError = ezMath::Abs(static_cast<float>(UnquantizeBC6(iCandidate, uiBits)) - fValue);
+      if (fError < fBestError)
+      {
+        fBestError = fError;
+        iBestValue = iCandidate;
+      }
+    }
+
+    return iBestValue;
+  }
+
+  /// \brief Finds the endpoints and indices of the pixels with a non-zero weight for untransformed endpoints with the given precision.
+  float FitSubsetBC6(const BlockData<3>& block, ezUInt32 uiEndpointBits, ezUInt32 uiIndexBits, ezBlockCompressionQuality::Enum quality,
+    ezInt32 (&out_endpoints)[2][3], ezUInt8* out_pIndices)
+  {
+    float e0[3], e1[3];
+    FindEndpoints(block, e0, e1);
+
+    const ezUInt32* pWeights = GetWeightsBC67(uiIndexBits);
+    const ezUInt32 uiNumEntries = 1u << uiIndexBits;
+
+    float fBestError = ezMath::MaxValue<float>();
+    float palette[MaxPaletteEntries][3];
+    ezUInt8 indices[NumBlockPixels];
+
+    const ezUInt32 uiNumIterations = quality == ezBlockCompressionQuality::High ? 2 : 0;
+    for (ezUInt32 iteration = 0; iteration <= uiNumIterations; ++iteration)
+    {
+      ClampEndpoints(e0, e1, 65535.0f);
+
+      ezInt32 endpoints[2][3];
+      for (ezUInt32 c = 0; c < 3; ++c)
+      {
+        endpoints[0][c] = QuantizeBC6(e0[c], uiEndpointBits);
+        endpoints[1][c] = QuantizeBC6(e1[c], uiEndpointBits);
+      }
+
+      for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+      {
+        const ezInt32 w = static_cast<ezInt32>(pWeights[i]);
+        for (ezUInt32 c = 0; c < 3; ++c)
+        {
+          const ezInt32 iEndpoint0 = UnquantizeBC6(endpoints[0][c], uiEndpointBits);
+          const ezInt32 iEndpoint1 = UnquantizeBC6(endpoints[1][c], uiEndpointBits);
+          palette[i][c] = static_cast<float>((iEndpoint0 * (64 - w) + iEndpoint1 * w + 32) >> 6);
+        }
+      }
+
+      const float fError = FindBestIndices(block, palette, uiNumEntries, indices);
+      if (fError >= fBestError)
+        break;
+
+      fBestError = fError;
+      ezMemoryUtils::Copy(&out_endpoints[0][0], &endpoints[0][0], 6);
+      ezMemoryUtils::Copy(out_pIndices, indices, NumBlockPixels);
+
+      if (fError == 0.0f || !RefineEndpoints(block, out_pIndices, GetIndexFactorsBC67(uiIndexBits), e0, e1))
+        break;
+    }
+
+    return fBestError;
+  }
+
+  struct EndpointBitsBC6
+  {
+    ezUInt8 m_uiSubset;
+    ezUInt8 m_uiEndpoint;
+    ezUInt8 m_uiChannel;
+    ezUInt8 m_uiFirstBit;
+    ezUInt8 m_uiNumBits;
+  };
+
+  // mode 10 stores the endpoint bits in this order, see the descriptor table of the decoder
+  static const EndpointBitsBC6 s_bc6Mode10Layout[] = {
+    {0, 0, 0, 0, 6}, {1, 1, 1, 4, 1}, {1, 1, 2, 0, 2}, {1, 0, 2, 4, 1}, {0, 0, 1, 0, 6}, {1, 0, 1, 5, 1}, {1, 0, 2, 5, 1}, {1, 1, 2, 2, 1},
+    {1, 0, 1, 4, 1}, {0, 0, 2, 0, 6}, {1, 1, 1, 5, 1}, {1, 1, 2, 3, 1}, {1, 1, 2, 5, 1}, {1, 1, 2, 4, 1}, {0, 1, 0, 0, 6}, {1, 0, 1, 0, 4},
+    {0, 1, 1, 0, 6}, {1, 1, 1, 0, 4}, {0, 1, 2, 0, 6}, {1, 0, 2, 0, 4}, {1, 0, 0, 0, 6}, {1, 1, 0, 0, 6}};
+
+  //////////////////////////////////////////////////////////////////////////
+  // BC7
+
+  struct PBitModeBC7
+  {
+    enum Enum
+    {
+      None,
+      Shared, ///< One p-bit per subset.
+      Unique, ///< One p-bit per endpoint.
+    };
+  };
+
+  struct ModeInfoBC7
+  {
+    ezUInt8 m_uiMode;
+    ezUInt8 m_uiNumSubsets;
+    ezUInt8 m_uiColorBits;
+    ezUInt8 m_uiAlphaBits; ///< Zero if the mode has no alpha, which then decodes as fully opaque.
+    PBitModeBC7::Enum m_PBits;
+    ezUInt8 m_uiIndexBits;
+    ezUInt8 m_uiAlphaIndexBits; ///< Zero if alpha uses the color indices.
+  };
+
+  static const ModeInfoBC7 s_bc7Mode1 = {1, 2, 6, 0, PBitModeBC7::Shared, 3, 0};
+  static const ModeInfoBC7 s_bc7Mode5 = {5, 1, 7, 8, PBitModeBC7::None, 2, 2};
+  static const ModeInfoBC7 s_bc7Mode6 = {6, 1, 7, 7, PBitModeBC7::Unique, 4, 0};
+  static const ModeInfoBC7 s_bc7Mode7 = {7, 2, 5, 5, PBitModeBC7::Unique, 2, 0};
+
+  /// \brief Expands a quantized endpoint channel to 8 bits the same way the decoder does.
+  ezInt32 UnquantizeBC7(ezUInt32 uiValue, ezUInt32 uiPBit, ezUInt32 uiBits, bool bHasPBit)
+  {
+    const ezUInt32 uiTotalBits = uiBits + (bHasPBit ? 1 : 0);
+    const ezUInt32 v = bHasPBit ? ((uiValue << 1) | uiPBit) : uiValue;
+    return static_cast<ezInt32>((v << (8 - uiTotalBits)) | (v >> (2 * uiTotalBits - 8)));
+  }
+
+  ezUInt8 QuantizeBC7(float fValue, ezUInt32 uiPBit, ezUInt32 uiBits, bool bHasPBit)
+  {
+    const ezInt32 iMaxValue = (1 << uiBits) - 1;
+    const ezUInt32 uiTotalBits = uiBits + (bHasPBit ? 1 : 0);
+    const float fScaled = fValue * ((1 << uiTotalBits) - 1) / 255.0f;
+    const float fGuess = bHasPBit ? (fScaled - uiPBit) * 0.5f : fScaled;
+    const ezInt32 iGuess = ezMath::Clamp(static_cast<ezInt32>(fGuess + 0.5f), 0, iMaxValue);
+
+    // the bit replication of the expansion isn't exactly linear, so check the neighbors as well
+    ezInt32 iBestValue = iGuess;
+    float fBestError = ezMath::MaxValue<float>();
+    for (ezInt32 iCandidate = ezMath::Max(iGuess - 1, 0); iCandidate <= ezMath::Min(iGuess + 1, iMaxValue); ++iCandidate)
+    {
+      const float fError = ezMath::Abs(static_cast<float>(UnquantizeBC7(iCandidate, uiPBit, uiBits, bHasPBit)) - fValue);
+      if (fError < fBestError)
+      {
+        fBestError = fError;
+        iBestValue = iCandidate;
+      }
+    }
+
+    return static_cast<ezUInt8>(iBestValue);
+  }
+
+  template <ezUInt32 N>
+  struct EndpointsBC7
+  {
+    ezUInt8 m_Values[2][N];
+    ezUInt8 m_PBits[2];
+  };
+
+  /// \brief Finds the quantized endpoints, p-bits and indices of the pixels with a non-zero weight.
+  ///
+  /// puiBits holds the precision of each channel, without the p-bit.
+  template <ezUInt32 N>
+  float FitSubsetBC7(const BlockData<N>& block, const ezUInt8* puiBits, PBitModeBC7::Enum pBits, ezUInt32 uiIndexBits,
+    ezBlockCompressionQuality::Enum quality, EndpointsBC7<N>& out_endpoints, ezUInt8* out_pIndices)
+  {
+    float e[2][N];
+    FindEndpoints(block, e[0], e[1]);
+
+    const bool bHasPBit = pBits != PBitModeBC7::None;
+    const ezUInt32* pWeights = GetWeightsBC67(uiIndexBits);
+    const ezUInt32 uiNumEntries = 1u << uiIndexBits;
+
+    float fBestError = ezMath::MaxValue<float>();
+    float palette[MaxPaletteEntries][N];
+    ezUInt8 indices[NumBlockPixels];
+
+    const ezUInt32 uiNumIterations = quality == ezBlockCompressionQuality::High ? 2 : 0;
+    for (ezUInt32 iteration = 0; iteration <= uiNumIterations; ++iteration)
+    {
+      ClampEndpoints(e[0], e[1], 255.0f);
+
+      // quantize each endpoint with both p-bit values
+      ezUInt8 quantized[2][2][N];
+      float quantizationError[2][2] = {};
+      for (ezUInt32 uiEndpoint = 0; uiEndpoint < 2; ++uiEndpoint)
+      {
+        for (ezUInt32 uiPBit = 0; uiPBit < (bHasPBit ? 2u : 1u); ++uiPBit)
+        {
+          for (ezUInt32 c = 0; c < N; ++c)
+          {
+            quantized[uiEndpoint][uiPBit][c] = QuantizeBC7(e[uiEndpoint][c], uiPBit, puiBits[c], bHasPBit);
+
+            const float fDiff = UnquantizeBC7(quantized[uiEndpoint][uiPBit][c], uiPBit, puiBits[c], bHasPBit) - e[uiEndpoint][c];
+            quantizationError[uiEndpoint][uiPBit] += fDiff * fDiff;
+          }
+        }
+      }
+
+      // the fast mode only uses the p-bits that quantize the endpoints best, the high quality mode tries all combinations
+      ezUInt32 pBitCombinations[4][2];
+      ezUInt32 uiNumCombinations = 0;
+
+      if (pBits == PBitModeBC7::None)
+      {
+        pBitCombinations[uiNumCombinations][0] = 0;
+        pBitCombinations[uiNumCombinations++][1] = 0;
+      }
+      else if (pBits == PBitModeBC7::Shared)
+      {
+        if (quality == ezBlockCompressionQuality::Fast)
+        {
+          const ezUInt32 uiPBit = quantizationError[0][1] + quantizationError[1][1] < quantizationError[0][0] + quantizationError[1][0] ? 1 : 0;
+          pBitCombinations[uiNumCombinations][0] = uiPBit;
+          pBitCombinations[uiNumCombinations++][1] = uiPBit;
+        }
+        else
+        {
+          for (ezUInt32 uiPBit = 0; uiPBit < 2; ++uiPBit)
+          {
+            pBitCombinations[uiNumCombinations][0] = uiPBit;
+            pBitCombinations[uiNumCombinations++][1] = uiPBit;
+          }
+        }
+      }
+      else
+      {
+        if (quality == ezBlockCompressionQuality::Fast)
+        {
+          pBitCombinations[uiNumCombinations][0] = quantizationError[0][1] < quantizationError[0][0] ? 1 : 0;
+          pBitCombinations[uiNumCombinations++][1] = quantizationError[1][1] < quantizationError[1][0] ? 1 : 0;
+        }
+        else
+        {
+          for (ezUInt32 uiPBit0 = 0; uiPBit0 < 2; ++uiPBit0)
+          {
+            for (ezUInt32 uiPBit1 = 0; uiPBit1 < 2; ++uiPBit1)
+            {
+              pBitCombinations[uiNumCombinations][0] = uiPBit0;
+              pBitCombinations[uiNumCombinations++][1] = uiPBit1;
+            }
+          }
+        }
+      }
+
+      bool bImproved = false;
+      for (ezUInt32 uiCombination = 0; uiCombination < uiNumCombinations; ++uiCombination)
+      {
+        const ezUInt32 uiPBit0 = pBitCombinations[uiCombination][0];
+        const ezUInt32 uiPBit1 = pBitCombinations[uiCombination][1];
+
+        for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+        {
+          const ezInt32 w = static_cast<ezInt32>(pWeights[i]);
+          for (ezUInt32 c = 0; c < N; ++c)
+          {
+            const ezInt32 iEndpoint0 = UnquantizeBC7(quantized[0][uiPBit0][c], uiPBit0, puiBits[c], bHasPBit);
+            const ezInt32 iEndpoint1 = UnquantizeBC7(quantized[1][uiPBit1][c], uiPBit1, puiBits[c], bHasPBit);
+            palette[i][c] = static_cast<float>((iEndpoint0 * (64 - w) + iEndpoint1 * w + 32) >> 6);
+          }
+        }
+
+        const float fError = FindBestIndices(block, palette, uiNumEntries, indices);
+        if (fError < fBestError)
+        {
+          fBestError = fError;
+          ezMemoryUtils::Copy(out_endpoints.m_Values[0], quantized[0][uiPBit0], N);
+          ezMemoryUtils::Copy(out_endpoints.m_Values[1], quantized[1][uiPBit1], N);
+          out_endpoints.m_PBits[0] = static_cast<ezUInt8>(uiPBit0);
+          out_endpoints.m_PBits[1] = static_cast<ezUInt8>(uiPBit1);
+          ezMemoryUtils::Copy(out_pIndices, indices, NumBlockPixels);
+          bImproved = true;
+        }
+      }
+
+      if (!bImproved || fBestError == 0.0f || !RefineEndpoints(block, out_pIndices, GetIndexFactorsBC67(uiIndexBits), e[0], e[1]))
+        break;
+    }
+
+    return fBestError;
+  }
+
+  /// \brief A block encoded in one of the BC7 modes, before the anchor indices are fixed up.
+  struct EncodingBC7
+  {
+    const ModeInfoBC7* m_pMode = nullptr;
+    ezUInt32 m_uiShape = 0;
+    ezUInt8 m_Endpoints[2][2][4] = {}; // subset, endpoint, channel
+    ezUInt8 m_PBits[2][2] = {};        // subset, endpoint
+    ezUInt8 m_Indices[NumBlockPixels] = {};
+    ezUInt8 m_AlphaIndices[NumBlockPixels] = {};
+    float m_fError = ezMath::MaxValue<float>();
+  };
+
+  template <ezUInt32 N>
+  void StoreSubsetBC7(const EndpointsBC7<N>& endpoints, const ezUInt8* pIndices, const ezUInt8* pPartition, ezUInt32 uiSubset, EncodingBC7& inout_encoding)
+  {
+    for (ezUInt32 uiEndpoint = 0; uiEndpoint < 2; ++uiEndpoint)
+    {
+      for (ezUInt32 c = 0; c < N; ++c)
+      {
+        inout_encoding.m_Endpoints[uiSubset][uiEndpoint][c] = endpoints.m_Values[uiEndpoint][c];
+      }
+      inout_encoding.m_PBits[uiSubset][uiEndpoint] = endpoints.m_PBits[uiEndpoint];
+    }
+
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      if (pPartition[i] == uiSubset)
+        inout_encoding.m_Indices[i] = pIndices[i];
+    }
+  }
+
+  /// \brief Encodes the block with one of the single subset modes where alpha uses the color indices.
+  void EncodeSingleSubsetBC7(const BlockData<4>& block, const ModeInfoBC7& mode, ezBlockCompressionQuality::Enum quality, EncodingBC7& out_encoding)
+  {
+    const ezUInt8 bits[4] = {mode.m_uiColorBits, mode.m_uiColorBits, mode.m_uiColorBits, mode.m_uiAlphaBits};
+
+    EndpointsBC7<4> endpoints;
+    ezUInt8 indices[NumBlockPixels];
+
+    out_encoding.m_pMode = &mode;
+    out_encoding.m_fError = FitSubsetBC7(block, bits, mode.m_PBits, mode.m_uiIndexBits, quality, endpoints, indices);
+    StoreSubsetBC7(endpoints, indices, ezGetPartitionShapeBC67(1, 0), 0, out_encoding);
+  }
+
+  /// \brief Encodes the block with mode 5, which fits color and alpha independently.
+  void EncodeSeparateAlphaBC7(const BlockData<4>& block, ezBlockCompressionQuality::Enum quality, EncodingBC7& out_encoding)
+  {
+    const ModeInfoBC7& mode = s_bc7Mode5;
+
+    BlockData<3> colorBlock;
+    BlockData<1> alphaBlock;
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      for (ezUInt32 c = 0; c < 3; ++c)
+      {
+        colorBlock.m_Pixels[i][c] = block.m_Pixels[i][c];
+      }
+      alphaBlock.m_Pixels[i][0] = block.m_Pixels[i][3];
+      colorBlock.m_Weights[i] = 1.0f;
+      alphaBlock.m_Weights[i] = 1.0f;
+    }
+    colorBlock.UpdateSoA();
+    alphaBlock.UpdateSoA();
+
+    const ezUInt8 colorBits[3] = {mode.m_uiColorBits, mode.m_uiColorBits, mode.m_uiColorBits};
+    EndpointsBC7<3> colorEndpoints;
+    out_encoding.m_fError = FitSubsetBC7(colorBlock, colorBits, mode.m_PBits, mode.m_uiIndexBits, quality, colorEndpoints, out_encoding.m_Indices);
+
+    const ezUInt8 alphaBits[1] = {mode.m_uiAlphaBits};
+    EndpointsBC7<1> alphaEndpoints;
+    out_encoding.m_fError += FitSubsetBC7(alphaBlock, alphaBits, mode.m_PBits, mode.m_uiAlphaIndexBits, quality, alphaEndpoints, out_encoding.m_AlphaIndices);
+
+    out_encoding.m_pMode = &mode;
+    for (ezUInt32 uiEndpoint = 0; uiEndpoint < 2; ++uiEndpoint)
+    {
+      for (ezUInt32 c = 0; c < 3; ++c)
+      {
+        out_encoding.m_Endpoints[0][uiEndpoint][c] = colorEndpoints.m_Values[uiEndpoint][c];
+      }
+      out_encoding.m_Endpoints[0][uiEndpoint][3] = alphaEndpoints.m_Values[uiEndpoint][0];
+    }
+  }
+
+  /// \brief Encodes the block with one of the two subset modes, trying the partition shapes that promise the smallest error.
+  template <ezUInt32 N>
+  void EncodeTwoSubsetsBC7(const BlockData<N>& block, const ModeInfoBC7& mode, ezBlockCompressionQuality::Enum quality, EncodingBC7& out_encoding)
+  {
+    ezUInt32 shapes[NumShapeCandidates];
+    FindShapeCandidates(block, NumPartitionShapesBC7, shapes);
+
+    const ezUInt8 bits[4] = {mode.m_uiColorBits, mode.m_uiColorBits, mode.m_uiColorBits, mode.m_uiAlphaBits};
+
+    BlockData<N> subsetBlock = block;
+    EndpointsBC7<N> endpoints;
+    ezUInt8 indices[NumBlockPixels];
+
+    for (ezUInt32 uiShape : shapes)
+    {
+      const ezUInt8* pPartition = ezGetPartitionShapeBC67(2, uiShape);
+
+      EncodingBC7 encoding;
+      encoding.m_pMode = &mode;
+      encoding.m_uiShape = uiShape;
+      encoding.m_fError = 0.0f;
+
+      for (ezUInt32 uiSubset = 0; uiSubset < 2; ++uiSubset)
+      {
+        subsetBlock.SetSubsetWeights(pPartition, uiSubset);
+        subsetBlock.UpdateWeightsSoA();
+
+        encoding.m_fError += FitSubsetBC7(subsetBlock, bits, mode.m_PBits, mode.m_uiIndexBits, quality, endpoints, indices);
+        StoreSubsetBC7(endpoints, indices, pPartition, uiSubset, encoding);
+      }
+
+      if (encoding.m_fError < out_encoding.m_fError)
+      {
+        out_encoding = encoding;
+      }
+    }
+  }
+
+  void WriteBlockBC7(EncodingBC7 encoding, ezUInt8* pTarget)
+  {
+    const ModeInfoBC7& mode = *encoding.m_pMode;
+
+    // with separate alpha indices, the endpoints of color and alpha are swapped independently
+    const ezUInt32 uiNumSwappedChannels = mode.m_uiAlphaIndexBits == 0 ? 4 : 3;
+
+    bool flipped[2];
+    FixAnchorIndices(mode.m_uiNumSubsets, encoding.m_uiShape, mode.m_uiIndexBits, encoding.m_Indices, flipped);
+
+    for (ezUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+    {
+      if (!flipped[uiSubset])
+        continue;
+
+      for (ezUInt32 c = 0; c < uiNumSwappedChannels; ++c)
+      {
+        ezMath::Swap(encoding.m_Endpoints[uiSubset][0][c], encoding.m_Endpoints[uiSubset][1][c]);
+      }
+      ezMath::Swap(encoding.m_PBits[uiSubset][0], encoding.m_PBits[uiSubset][1]);
+    }
+
+    if (mode.m_uiAlphaIndexBits != 0)
+    {
+      FixAnchorIndices(1, 0, mode.m_uiAlphaIndexBits, encoding.m_AlphaIndices, flipped);
+      if (flipped[0])
+      {
+        ezMath::Swap(encoding.m_Endpoints[0][0][3], encoding.m_Endpoints[0][1][3]);
+      }
+    }
+
+    BlockBitWriter writer(pTarget, 16);
+    writer.Write(1u << mode.m_uiMode, mode.m_uiMode + 1);
+
+    if (mode.m_uiNumSubsets > 1)
+    {
+      writer.Write(encoding.m_uiShape, 6);
+    }
+
+    if (mode.m_uiAlphaIndexBits != 0)
+    {
+      // no channel rotation
+      writer.Write(0, 2);
+    }
+
+    for (ezUInt32 c = 0; c < 3; ++c)
+    {
+      for (ezUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+      {
+        writer.Write(encoding.m_Endpoints[uiSubset][0][c], mode.m_uiColorBits);
+        writer.Write(encoding.m_Endpoints[uiSubset][1][c], mode.m_uiColorBits);
+      }
+    }
+
+    if (mode.m_uiAlphaBits != 0)
+    {
+      for (ezUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+      {
+        writer.Write(encoding.m_Endpoints[uiSubset][0][3], mode.m_uiAlphaBits);
+        writer.Write(encoding.m_Endpoints[uiSubset][1][3], mode.m_uiAlphaBits);
+      }
+    }
+
+    for (ezUInt32 uiSubset = 0; uiSubset < mode.m_uiNumSubsets; ++uiSubset)
+    {
+      if (mode.m_PBits == PBitModeBC7::Unique)
+      {
+        writer.Write(encoding.m_PBits[uiSubset][0], 1);
+        writer.Write(encoding.m_PBits[uiSubset][1], 1);
+      }
+      else if (mode.m_PBits == PBitModeBC7::Shared)
+      {
+        writer.Write(encoding.m_PBits[uiSubset][0], 1);
+      }
+    }
+
+    WriteIndicesBC67(writer, mode.m_uiNumSubsets, encoding.m_uiShape, mode.m_uiIndexBits, encoding.m_Indices);
+
+    if (mode.m_uiAlphaIndexBits != 0)
+    {
+      WriteIndicesBC67(writer, 1, 0, mode.m_uiAlphaIndexBits, encoding.m_AlphaIndices);
+    }
+
+    EZ_ASSERT_DEBUG(writer.m_uiBit == 128, "Invalid BC7 block size");
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Conversion steps
+
+  // native compression is preferred where DirectXTex isn't available, but DirectXTex on a hardware device is preferred over it
+  ezImageConversionEntry MakeNativeEntry(ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat)
+  {
+    ezImageConversionEntry entry(sourceFormat, targetFormat, ezImageConversionFlags::Default);
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+    entry.m_additionalPenalty = 1.0f;
+#endif
+    return entry;
+  }
+
+  struct BlockRowsData
+  {
+    const ezUInt8* m_pSource;
+    ezUInt8* m_pTarget;
+    ezUInt64 m_uiSourceRowPitch;
+    ezUInt32 m_uiSourceBytesPerPixel;
+    ezUInt32 m_uiTargetBytesPerBlock;
+    ezUInt32 m_uiNumBlocksX;
+  };
+
+  /// \brief Calls compressBlock for every block, with the block rows spread over multiple tasks.
+  template <typename CompressBlock>
+  void CompressBlockRows(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, const CompressBlock& compressBlock)
+  {
+    BlockRowsData data;
+    data.m_pSource = source.GetPtr();
+    data.m_pTarget = target.GetPtr();
+    data.m_uiSourceRowPitch = ezImageFormat::GetRowPitch(sourceFormat, 4 * numBlocksX);
+    data.m_uiSourceBytesPerPixel = ezImageFormat::GetBitsPerPixel(sourceFormat) / 8;
+    data.m_uiTargetBytesPerBlock = ezImageFormat::GetBitsPerBlock(targetFormat) / 8;
+    data.m_uiNumBlocksX = numBlocksX;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, numBlocksY,
+      [&data, &compressBlock](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 blockY = uiStartIndex; blockY < uiEndIndex; ++blockY)
+        {
+          for (ezUInt32 blockX = 0; blockX < data.m_uiNumBlocksX; ++blockX)
+          {
+            const ezUInt8* pSource = data.m_pSource + 4 * blockY * data.m_uiSourceRowPitch + 4 * blockX * data.m_uiSourceBytesPerPixel;
+            ezUInt8* pTarget = data.m_pTarget + (blockY * data.m_uiNumBlocksX + blockX) * data.m_uiTargetBytesPerBlock;
+
+            compressBlock(pSource, data.m_uiSourceRowPitch, pTarget);
+          }
+        }
+      },
+      "CompressBlocks");
+  }
+
+  template <typename T>
+  void GatherBlock(const ezUInt8* pSource, ezUInt64 uiRowPitch, T* out_pBlock)
+  {
+    for (ezUInt32 y = 0; y < 4; ++y)
+    {
+      ezMemoryUtils::Copy(out_pBlock + 4 * y, reinterpret_cast<const T*>(pSource + y * uiRowPitch), 4);
+    }
+  }
+} // namespace
+
+void ezCompressBlockBC1(const ezColorBaseUB* pSource, ezUInt8* pTarget, bool bForceFourColorMode, ezBlockCompressionQuality::Enum quality)
+{
+  bool bHasTransparency = false;
+  if (!bForceFourColorMode)
+  {
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      bHasTransparency |= pSource[i].a < 255;
+    }
+  }
+
+  BlockData<3> block;
+  for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+  {
+    block.m_Pixels[i][0] = pSource[i].r;
+    block.m_Pixels[i][1] = pSource[i].g;
+    block.m_Pixels[i][2] = pSource[i].b;
+    block.m_Weights[i] = (bHasTransparency && pSource[i].a < 255) ? 0.0f : 1.0f;
+  }
+
+  ezUInt8 bestIndices[NumBlockPixels] = {};
+  ezUInt16 uiBestColor0 = 0;
+  ezUInt16 uiBestColor1 = 0;
+
+  // in the three color mode the last index is transparent, otherwise there are two interpolated colors
+  const bool bFourColorMode = !bHasTransparency;
+  static const float s_FourColorFactors[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+  static const float s_ThreeColorFactors[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+
+  bool bAnyOpaque = false;
+  for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+  {
+    bAnyOpaque |= block.m_Weights[i] > 0.0f;
+  }
+
+  if (!bAnyOpaque)
+  {
+    ezMemoryUtils::PatternFill(bestIndices, static_cast<ezUInt8>(3), NumBlockPixels);
+    WriteBlockBC1(0, 0, bestIndices, pTarget);
+    return;
+  }
+
+  if (bFourColorMode && IsSingleColor(block))
+  {
+    // reproduce the color with the 2/3 interpolated entry, which gets much closer than rounding the endpoints
+    const SingleColorTablesBC1& tables = GetSingleColorTablesBC1();
+    const ezColorBaseUB color = pSource[0];
+
+    uiBestColor0 = static_cast<ezUInt16>((tables.m_Table5[color.r][0] << 11) | (tables.m_Table6[color.g][0] << 5) | tables.m_Table5[color.b][0]);
+    uiBestColor1 = static_cast<ezUInt16>((tables.m_Table5[color.r][1] << 11) | (tables.m_Table6[color.g][1] << 5) | tables.m_Table5[color.b][1]);
+    ezMemoryUtils::PatternFill(bestIndices, static_cast<ezUInt8>(uiBestColor0 == uiBestColor1 ? 0 : 2), NumBlockPixels);
+  }
+  else
+  {
+    block.UpdateSoA();
+
+    float e0[3], e1[3];
+    FindEndpoints(block, e0, e1);
+
+    float palette[MaxPaletteEntries][3];
+    ezUInt8 indices[NumBlockPixels];
+    float fBestError = ezMath::MaxValue<float>();
+
+    const ezUInt32 uiNumIterations = quality == ezBlockCompressionQuality::High ? 3 : 0;
+    for (ezUInt32 iteration = 0; iteration <= uiNumIterations; ++iteration)
+    {
+      ClampEndpoints(e0, e1, 255.0f);
+
+      const ezUInt16 uiColor0 = QuantizeB5G6R5(e0);
+      const ezUInt16 uiColor1 = QuantizeB5G6R5(e1);
+
+      const ezUInt32 uiNumEntries = BuildPaletteBC1(uiColor0, uiColor1, bFourColorMode, palette);
+      const float fError = FindBestIndices(block, palette, uiNumEntries, indices);
+
+      if (fError >= fBestError)
+        break;
+
+      fBestError = fError;
+      uiBestColor0 = uiColor0;
+      uiBestColor1 = uiColor1;
+      ezMemoryUtils::Copy(bestIndices, indices, NumBlockPixels);
+
+      if (fError == 0.0f || !RefineEndpoints(block, bestIndices, bFourColorMode ? s_FourColorFactors : s_ThreeColorFactors, e0, e1))
+        break;
+    }
+  }
+
+  if (bHasTransparency)
+  {
+    // the three color mode requires color0 <= color1
+    if (uiBestColor0 > uiBestColor1)
+    {
+      ezMath::Swap(uiBestColor0, uiBestColor1);
+      for (ezUInt8& index : bestIndices)
+      {
+        index = index < 2 ? index ^ 1 : index;
+      }
+    }
+
+    for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+    {
+      if (block.m_Weights[i] <= 0.0f)
+        bestIndices[i] = 3;
+    }
+  }
+  else if (!bForceFourColorMode)
+  {
+    // the four color mode requires color0 > color1, with equal colors all pixels use color0, which is in both modes the same
+    if (uiBestColor0 < uiBestColor1)
+    {
+      ezMath::Swap(uiBestColor0, uiBestColor1);
+      for (ezUInt8& index : bestIndices)
+      {
+        index ^= 1;
+      }
+    }
+    else if (uiBestColor0 == uiBestColor1)
+    {
+      ezMemoryUtils::ZeroFill(bestIndices, NumBlockPixels);
+    }
+  }
+
+  WriteBlockBC1(uiBestColor0, uiBestColor1, bestIndices, pTarget);
+}
+
+void ezCompressBlockBC3(const ezColorBaseUB* pSource, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality)
+{
+  ezUInt8 alpha[NumBlockPixels];
+  for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+  {
+    alpha[i] = pSource[i].a;
+  }
+
+  CompressBlockBC4(alpha, pTarget, quality);
+  ezCompressBlockBC1(pSource, pTarget + 8, true, quality);
+}
+
+void ezCompressBlockBC6(const ezColorLinear16f* pSource, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality)
+{
+  // Work on the half float bit patterns, scaled such that they match the unquantized endpoint range of the decoder.
+  // This space is roughly logarithmic, so errors in dark areas count as much as errors in bright areas.
+  BlockData<3> block;
+  for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+  {
+    const ezFloat16* pChannels = pSource[i].GetData();
+    for (ezUInt32 c = 0; c < 3; ++c)
+    {
+      ezUInt16 uiHalf = pChannels[c].GetRawData();
+
+      if (uiHalf & 0x8000) // negative values, unsigned BC6H can't represent them
+        uiHalf = 0;
+      else if (uiHalf == 0x7C00) // infinity
+        uiHalf = 0x7BFF;
+      else if (uiHalf > 0x7C00) // NaN
+        uiHalf = 0;
+
+      block.m_Pixels[i][c] = uiHalf * (64.0f / 31.0f);
+    }
+
+    block.m_Weights[i] = 1.0f;
+  }
+
+  block.UpdateSoA();
+
+  // mode 11: one region, untransformed 10 bit endpoints, 4 bit indices
+  ezInt32 endpoints[2][3];
+  ezUInt8 indices[NumBlockPixels];
+  const float fSingleRegionError = FitSubsetBC6(block, 10, 4, quality, endpoints, indices);
+
+  if (quality == ezBlockCompressionQuality::High && fSingleRegionError > 0.0f)
+  {
+    // mode 10: two regions, untransformed 6 bit endpoints, 3 bit indices
+    ezUInt32 shapes[NumShapeCandidates];
+    FindShapeCandidates(block, NumPartitionShapesBC6, shapes);
+
+    float fBestError = fSingleRegionError;
+    ezUInt32 uiBestShape = 0xFFFFFFFF;
+    ezInt32 bestEndpoints[2][2][3];
+    ezUInt8 bestIndices[NumBlockPixels];
+
+    BlockData<3> subsetBlock = block;
+    for (ezUInt32 uiShape : shapes)
+    {
+      const ezUInt8* pPartition = ezGetPartitionShapeBC67(2, uiShape);
+
+      ezInt32 shapeEndpoints[2][2][3];
+      ezUInt8 shapeIndices[NumBlockPixels];
+      float fError = 0.0f;
+
+      for (ezUInt32 uiSubset = 0; uiSubset < 2; ++uiSubset)
+      {
+        subsetBlock.SetSubsetWeights(pPartition, uiSubset);
+        subsetBlock.UpdateWeightsSoA();
+
+        ezUInt8 subsetIndices[NumBlockPixels];
+        fError += FitSubsetBC6(subsetBlock, 6, 3, quality, shapeEndpoints[uiSubset], subsetIndices);
+
+        for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+        {
+          if (pPartition[i] == uiSubset)
+            shapeIndices[i] = subsetIndices[i];
+        }
+      }
+
+      if (fError < fBestError)
+      {
+        fBestError = fError;
+        uiBestShape = uiShape;
+        ezMemoryUtils::Copy(&bestEndpoints[0][0][0], &shapeEndpoints[0][0][0], 12);
+        ezMemoryUtils::Copy(bestIndices, shapeIndices, NumBlockPixels);
+      }
+    }
+
+    if (uiBestShape != 0xFFFFFFFF)
+    {
+      bool flipped[2];
+      FixAnchorIndices(2, uiBestShape, 3, bestIndices, flipped);
+
+      for (ezUInt32 uiSubset = 0; uiSubset < 2; ++uiSubset)
+      {
+        if (!flipped[uiSubset])
+          continue;
+
+        for (ezUInt32 c = 0; c < 3; ++c)
+        {
+          ezMath::Swap(bestEndpoints[uiSubset][0][c], bestEndpoints[uiSubset][1][c]);
+        }
+      }
+
+      BlockBitWriter writer(pTarget, 16);
+      writer.Write(0x1E, 5);
+
+      for (const EndpointBitsBC6& bits : s_bc6Mode10Layout)
+      {
+        writer.Write(bestEndpoints[bits.m_uiSubset][bits.m_uiEndpoint][bits.m_uiChannel] >> bits.m_uiFirstBit, bits.m_uiNumBits);
+      }
+
+      writer.Write(uiBestShape, 5);
+      WriteIndicesBC67(writer, 2, uiBestShape, 3, bestIndices);
+      return;
+    }
+  }
+
+  bool flipped[2];
+  FixAnchorIndices(1, 0, 4, indices, flipped);
+
+  if (flipped[0])
+  {
+    for (ezUInt32 c = 0; c < 3; ++c)
+    {
+      ezMath::Swap(endpoints[0][c], endpoints[1][c]);
+    }
+  }
+
+  BlockBitWriter writer(pTarget, 16);
+  writer.Write(0x03, 5);
+
+  for (ezUInt32 e = 0; e < 2; ++e)
+  {
+    for (ezUInt32 c = 0; c < 3; ++c)
+    {
+      writer.Write(endpoints[e][c], 10);
+    }
+  }
+
+  WriteIndicesBC67(writer, 1, 0, 4, indices);
+}
+
+void ezCompressBlockBC7(const ezColorBaseUB* pSource, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality)
+{
+  bool bIsOpaque = true;
+
+  BlockData<4> block;
+  for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+  {
+    block.m_Pixels[i][0] = pSource[i].r;
+    block.m_Pixels[i][1] = pSource[i].g;
+    block.m_Pixels[i][2] = pSource[i].b;
+    block.m_Pixels[i][3] = pSource[i].a;
+    block.m_Weights[i] = 1.0f;
+
+    bIsOpaque &= pSource[i].a == 255;
+  }
+
+  block.UpdateSoA();
+
+  // mode 6 handles smooth blocks well and is the only mode used in the fast mode
+  EncodingBC7 bestEncoding;
+  EncodeSingleSubsetBC7(block, s_bc7Mode6, quality, bestEncoding);
+
+  if (quality == ezBlockCompressionQuality::High && bestEncoding.m_fError > 0.0f)
+  {
+    EncodingBC7 encoding;
+
+    // mode 5 for alpha that doesn't correlate with the color
+    if (!bIsOpaque)
+    {
+      EncodeSeparateAlphaBC7(block, quality, encoding);
+      if (encoding.m_fError < bestEncoding.m_fError)
+        bestEncoding = encoding;
+    }
+
+    // two subsets for blocks with edges, mode 1 has more precision but no alpha
+    encoding = EncodingBC7();
+    if (bIsOpaque)
+    {
+      BlockData<3> colorBlock;
+      for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+      {
+        for (ezUInt32 c = 0; c < 3; ++c)
+        {
+          colorBlock.m_Pixels[i][c] = block.m_Pixels[i][c];
+        }
+        colorBlock.m_Weights[i] = 1.0f;
+      }
+      colorBlock.UpdateSoA();
+
+      EncodeTwoSubsetsBC7(colorBlock, s_bc7Mode1, quality, encoding);
+    }
+    else
+    {
+      EncodeTwoSubsetsBC7(block, s_bc7Mode7, quality, encoding);
+    }
+
+    if (encoding.m_fError < bestEncoding.m_fError)
+      bestEncoding = encoding;
+  }
+
+  WriteBlockBC7(bestEncoding, pTarget);
+}
+
+class ezImageConversion_CompressBC1 : public ezImageConversionStepCompressBlocks
+{
+public:
+  virtual ezArrayPtr<const ezImageConversionEntry> GetSupportedConversions() const override
+  {
+    static ezImageConversionEntry supportedConversions[] = {
+      MakeNativeEntry(ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC1_UNORM),
+      MakeNativeEntry(ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::BC1_UNORM_SRGB),
+    };
+    return supportedConversions;
+  }
+
+  virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const override
+  {
+    CompressBlockRows(source, target, numBlocksX, numBlocksY, sourceFormat, targetFormat, [quality](const ezUInt8* pSource, ezUInt64 uiRowPitch, ezUInt8* pTarget) {
+      ezColorBaseUB block[NumBlockPixels];
+      GatherBlock(pSource, uiRowPitch, block);
+      ezCompressBlockBC1(block, pTarget, false, quality);
+    });
+
+    return EZ_SUCCESS;
+  }
+};
+
+class ezImageConversion_CompressBC3 : public ezImageConversionStepCompressBlocks
+{
+public:
+  virtual ezArrayPtr<const ezImageConversionEntry> GetSupportedConversions() const override
+  {
+    static ezImageConversionEntry supportedConversions[] = {
+      MakeNativeEntry(ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC3_UNORM),
+      MakeNativeEntry(ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::BC3_UNORM_SRGB),
+    };
+    return supportedConversions;
+  }
+
+  virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const override
+  {
+    CompressBlockRows(source, target, numBlocksX, numBlocksY, sourceFormat, targetFormat, [quality](const ezUInt8* pSource, ezUInt64 uiRowPitch, ezUInt8* pTarget) {
+      ezColorBaseUB block[NumBlockPixels];
+      GatherBlock(pSource, uiRowPitch, block);
+      ezCompressBlockBC3(block, pTarget, quality);
+    });
+
+    return EZ_SUCCESS;
+  }
+};
+
+class ezImageConversion_CompressBC6H : public ezImageConversionStepCompressBlocks
+{
+public:
+  virtual ezArrayPtr<const ezImageConversionEntry> GetSupportedConversions() const override
+  {
+    static ezImageConversionEntry supportedConversions[] = {
+      MakeNativeEntry(ezImageFormat::R16G16B16A16_FLOAT, ezImageFormat::BC6H_UF16),
+      MakeNativeEntry(ezImageFormat::R32G32B32A32_FLOAT, ezImageFormat::BC6H_UF16),
+    };
+    return supportedConversions;
+  }
+
+  virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const override
+  {
+    if (sourceFormat == ezImageFormat::R16G16B16A16_FLOAT)
+    {
+      CompressBlockRows(source, target, numBlocksX, numBlocksY, sourceFormat, targetFormat, [quality](const ezUInt8* pSource, ezUInt64 uiRowPitch, ezUInt8* pTarget) {
+        ezColorLinear16f block[NumBlockPixels];
+        GatherBlock(pSource, uiRowPitch, block);
+        ezCompressBlockBC6(block, pTarget, quality);
+      });
+    }
+    else
+    {
+      CompressBlockRows(source, target, numBlocksX, numBlocksY, sourceFormat, targetFormat, [quality](const ezUInt8* pSource, ezUInt64 uiRowPitch, ezUInt8* pTarget) {
+        ezColor sourceBlock[NumBlockPixels];
+        GatherBlock(pSource, uiRowPitch, sourceBlock);
+
+        ezColorLinear16f block[NumBlockPixels];
+        for (ezUInt32 i = 0; i < NumBlockPixels; ++i)
+        {
+          // clamp before the conversion, so that large values don't turn into infinity
+          const float fMaxHalf = 65504.0f;
+          block[i] = ezColor(ezMath::Min(sourceBlock[i].r, fMaxHalf), ezMath::Min(sourceBlock[i].g, fMaxHalf), ezMath::Min(sourceBlock[i].b, fMaxHalf), 1.0f);
+        }
+
+        ezCompressBlockBC6(block, pTarget, quality);
+      });
+    }
+
+    return EZ_SUCCESS;
+  }
+};
+
+class ezImageConversion_CompressBC7 : public ezImageConversionStepCompressBlocks
+{
+public:
+  virtual ezArrayPtr<const ezImageConversionEntry> GetSupportedConversions() const override
+  {
+    static ezImageConversionEntry supportedConversions[] = {
+      MakeNativeEntry(ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC7_UNORM),
+      MakeNativeEntry(ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::BC7_UNORM_SRGB),
+    };
+    return supportedConversions;
+  }
+
+  virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const override
+  {
+    CompressBlockRows(source, target, numBlocksX, numBlocksY, sourceFormat, targetFormat, [quality](const ezUInt8* pSource, ezUInt64 uiRowPitch, ezUInt8* pTarget) {
+      ezColorBaseUB block[NumBlockPixels];
+      GatherBlock(pSource, uiRowPitch, block);
+      ezCompressBlockBC7(block, pTarget, quality);
+    });
+
+    return EZ_SUCCESS;
+  }
+};
+
+static ezImageConversion_CompressBC1 s_conversion_compressBC1;
+static ezImageConversion_CompressBC3 s_conversion_compressBC3;
+static ezImageConversion_CompressBC6H s_conversion_compressBC6H;
+static ezImageConversion_CompressBC7 s_conversion_compressBC7;
+
+EZ_STATICLINK_FILE(Texture, Texture_Image_Conversions_BlockCompressConversions);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Texture/Image/Image.h>
+
+class ezColorLinear16f;
+
+/// \brief Compresses 16 pixels into one BC1 block. Pixels that are not fully opaque are encoded as transparent, unless bForceFourColorMode is set.
+EZ_TEXTURE_DLL void ezCompressBlockBC1(const ezColorBaseUB* pSource, ezUInt8* pTarget, bool bForceFourColorMode, ezBlockCompressionQuality::Enum quality);
+
+/// \brief Compresses 16 pixels into one BC3 block.
+EZ_TEXTURE_DLL void ezCompressBlockBC3(const ezColorBaseUB* pSource, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality);
+
+/// \brief Compresses 16 pixels into one unsigned BC6H block. Negative values and NaNs are stored as zero, infinity as the largest half value.
+///
+/// The fast mode only uses mode 11, the high quality mode also tries the two region mode 10.
+EZ_TEXTURE_DLL void ezCompressBlockBC6(const ezColorLinear16f* pSource, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality);
+
+/// \brief Compresses 16 pixels into one BC7 block. The fast mode only uses mode 6, the high quality mode also tries modes 1, 5 and 7.
+EZ_TEXTURE_DLL void ezCompressBlockBC7(const ezColorBaseUB* pSource, ezUInt8* pTarget, ezBlockCompressionQuality::Enum quality);
@@ -2630,6 +2630,18 @@ EZ_TEXTURE_DLL void ezDecompressBlockBC7(const ezUInt8* pSource, ezColorBaseUB*
   }
 } // namespace
 
+const ezUInt8* ezGetPartitionShapeBC67(ezUInt32 uiNumSubsets, ezUInt32 uiShape)
+{
+  EZ_ASSERT_DEBUG(uiNumSubsets >= 1 && uiNumSubsets <= 3 && uiShape < 64, "Invalid partition shape");
+  return s_bc67PartitionTable[uiNumSubsets - 1][uiShape];
+}
+
+ezUInt32 ezGetAnchorIndexBC67(ezUInt32 uiNumSubsets, ezUInt32 uiShape, ezUInt32 uiSubset)
+{
+  EZ_ASSERT_DEBUG(uiNumSubsets >= 1 && uiNumSubsets <= 3 && uiShape < 64 && uiSubset < uiNumSubsets, "Invalid partition subset");
+  return s_bc67FixUp[uiNumSubsets - 1][uiShape][uiSubset];
+}
+
 class ezImageConversion_BC1_RGBA : public ezImageConversionStepDecompressBlocks
 {
 public:
@@ -2937,7 +2949,7 @@ class ezImageConversion_CompressBC4 : public ezImageConversionStepCompressBlocks
   }
 
   virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
-    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat) const override
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const override
   {
     ezUInt32 stride = ezImageFormat::GetBitsPerPixel(sourceFormat) / 8;
     ezUInt64 rowPitch = ezImageFormat::GetRowPitch(sourceFormat, 4 * numBlocksX);
@@ -2994,7 +3006,7 @@ class ezImageConversion_CompressBC5 : public ezImageConversionStepCompressBlocks
   }
 
   virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
-    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat) const override
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const override
   {
     ezUInt32 stride = ezImageFormat::GetBitsPerPixel(sourceFormat) / 8;
     ezUInt64 rowPitch = ezImageFormat::GetRowPitch(sourceFormat, 4 * numBlocksX);
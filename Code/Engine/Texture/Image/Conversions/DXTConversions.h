@@ -10,3 +10,9 @@ EZ_TEXTURE_DLL void ezDecompressBlockBC6(const ezUInt8* pSource, ezColorLinear16
 EZ_TEXTURE_DLL void ezDecompressBlockBC7(const ezUInt8* pSource, ezColorBaseUB* pTarget);
 
 EZ_TEXTURE_DLL void ezUnpackPaletteBC4(ezUInt32 a0, ezUInt32 a1, ezUInt32* alphas);
+
+/// \brief Returns the subset of each of the 16 pixels for one of the 64 BC6H / BC7 partition shapes with the given number of subsets.
+EZ_TEXTURE_DLL const ezUInt8* ezGetPartitionShapeBC67(ezUInt32 uiNumSubsets, ezUInt32 uiShape);
+
+/// \brief Returns the pixel whose index in the given subset is stored with one bit less, because its most significant bit is implicitly zero.
+EZ_TEXTURE_DLL ezUInt32 ezGetAnchorIndexBC67(ezUInt32 uiNumSubsets, ezUInt32 uiShape, ezUInt32 uiSubset);
@@ -151,7 +151,7 @@ public:
   ezResult LoadFrom(const char* szFileName, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem());
 
   /// \brief Convenience function to convert the image to the given format.
-  ezResult Convert(ezImageFormat::Enum targetFormat);
+  ezResult Convert(ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality = ezBlockCompressionQuality::Default);
 
   /// \brief Returns a view to the entire data contained in this image.
   template <typename T>
@@ -72,7 +72,7 @@ class EZ_TEXTURE_DLL ezImageConversionStepCompressBlocks : public ezImageConvers
 public:
   /// \brief Compresses the given number of blocks.
   virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
-    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat) const = 0;
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality) const = 0;
 };
 
 
@@ -118,10 +118,14 @@ public:
     ezHybridArray<ConversionPathNode, 16>& path_out, ezUInt32& numScratchBuffers_out);
 
   /// \brief  Converts the source image into a target image with the given format. Source and target may be the same.
-  static ezResult Convert(const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat);
+  ///
+  /// The quality is passed to the block compressors, if the target format is compressed.
+  static ezResult Convert(const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat,
+    ezBlockCompressionQuality::Enum quality = ezBlockCompressionQuality::Default);
 
   /// \brief Converts the source image into a target image using a precomputed conversion path.
-  static ezResult Convert(const ezImageView& source, ezImage& target, ezArrayPtr<ConversionPathNode> path, ezUInt32 numScratchBuffers);
+  static ezResult Convert(const ezImageView& source, ezImage& target, ezArrayPtr<ConversionPathNode> path, ezUInt32 numScratchBuffers,
+    ezBlockCompressionQuality::Enum quality = ezBlockCompressionQuality::Default);
 
   /// \brief Converts the raw source data into a target data buffer with the given format. Source and target may be the same.
   static ezResult ConvertRaw(
@@ -135,13 +139,14 @@ private:
   ezImageConversion();
   ezImageConversion(const ezImageConversion&);
 
-  static ezResult ConvertSingleStep(const ezImageConversionStep* pStep, const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat);
+  static ezResult ConvertSingleStep(const ezImageConversionStep* pStep, const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat,
+    ezBlockCompressionQuality::Enum quality);
 
   static ezResult ConvertSingleStepDecompress(const ezImageView& source, ezImage& target, ezImageFormat::Enum sourceFormat,
     ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep);
 
   static ezResult ConvertSingleStepCompress(const ezImageView& source, ezImage& target, ezImageFormat::Enum sourceFormat,
-    ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep);
+    ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep, ezBlockCompressionQuality::Enum quality);
 
   static void RebuildConversionTable();
 };
@@ -52,3 +52,21 @@ struct EZ_TEXTURE_DLL ezTextureFilterSetting
 };
 
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_TEXTURE_DLL, ezTextureFilterSetting);
+
+//////////////////////////////////////////////////////////////////////////
+// ezBlockCompressionQuality
+//////////////////////////////////////////////////////////////////////////
+
+/// \brief Quality levels of the built-in block compressors. Compressors that don't have different levels ignore it.
+struct ezBlockCompressionQuality
+{
+  using StorageType = ezUInt8;
+
+  enum Enum
+  {
+    Fast, ///< Endpoints are taken from the extent of the block along its principal axis, with a single index search.
+    High, ///< Additionally refines the endpoints by least squares fitting and tries more endpoint quantization variants.
+
+    Default = High
+  };
+};
@@ -272,9 +272,9 @@ ezResult ezImage::LoadFrom(const char* szFileName, ezLogInterface* pLog)
   return EZ_FAILURE;
 }
 
-ezResult ezImage::Convert(ezImageFormat::Enum targetFormat)
+ezResult ezImage::Convert(ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality)
 {
-  return ezImageConversion::Convert(*this, *this, targetFormat);
+  return ezImageConversion::Convert(*this, *this, targetFormat, quality);
 }
 
 ezImageView ezImageView::GetSubImageView(ezUInt32 uiMipLevel /*= 0*/, ezUInt32 uiFace /*= 0*/, ezUInt32 uiArrayIndex /*= 0*/) const
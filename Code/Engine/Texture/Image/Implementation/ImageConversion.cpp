@@ -361,7 +361,8 @@ void ezImageConversion::RebuildConversionTable()
   s_conversionTableValid = true;
 }
 
-ezResult ezImageConversion::Convert(const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat)
+ezResult ezImageConversion::Convert(
+  const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality)
 {
   ezImageFormat::Enum sourceFormat = source.GetImageFormat();
 
@@ -383,10 +384,11 @@ ezResult ezImageConversion::Convert(const ezImageView& source, ezImage& target,
     return EZ_FAILURE;
   }
 
-  return Convert(source, target, path, numScratchBuffers);
+  return Convert(source, target, path, numScratchBuffers, quality);
 }
 
-ezResult ezImageConversion::Convert(const ezImageView& source, ezImage& target, ezArrayPtr<ConversionPathNode> path, ezUInt32 numScratchBuffers)
+ezResult ezImageConversion::Convert(const ezImageView& source, ezImage& target, ezArrayPtr<ConversionPathNode> path, ezUInt32 numScratchBuffers,
+  ezBlockCompressionQuality::Enum quality)
 {
   EZ_ASSERT_DEV(path.GetCount() > 0, "Invalid conversion path");
   EZ_ASSERT_DEV(path[0].m_sourceFormat == source.GetImageFormat(), "Invalid conversion path");
@@ -402,7 +404,7 @@ ezResult ezImageConversion::Convert(const ezImageView& source, ezImage& target,
 
     ezImage* pTarget = targetIndex == 0 ? &target : &intermediates[targetIndex - 1];
 
-    if (ConvertSingleStep(path[i].m_step, *pSource, *pTarget, path[i].m_targetFormat).Failed())
+    if (ConvertSingleStep(path[i].m_step, *pSource, *pTarget, path[i].m_targetFormat, quality).Failed())
     {
       return EZ_FAILURE;
     }
@@ -499,8 +501,8 @@ ezResult ezImageConversion::ConvertRaw(
   return EZ_SUCCESS;
 }
 
-ezResult ezImageConversion::ConvertSingleStep(
-  const ezImageConversionStep* pStep, const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat)
+ezResult ezImageConversion::ConvertSingleStep(const ezImageConversionStep* pStep, const ezImageView& source, ezImage& target,
+  ezImageFormat::Enum targetFormat, ezBlockCompressionQuality::Enum quality)
 {
   if (!pStep)
   {
@@ -525,7 +527,7 @@ ezResult ezImageConversion::ConvertSingleStep(
     }
     else
     {
-      return ConvertSingleStepCompress(source, target, sourceFormat, targetFormat, pStep);
+      return ConvertSingleStepCompress(source, target, sourceFormat, targetFormat, pStep, quality);
     }
   }
   else
@@ -597,8 +599,8 @@ ezResult ezImageConversion::ConvertSingleStepDecompress(
   return EZ_SUCCESS;
 }
 
-ezResult ezImageConversion::ConvertSingleStepCompress(
-  const ezImageView& source, ezImage& target, ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep)
+ezResult ezImageConversion::ConvertSingleStepCompress(const ezImageView& source, ezImage& target, ezImageFormat::Enum sourceFormat,
+  ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep, ezBlockCompressionQuality::Enum quality)
 {
   for (ezUInt32 arrayIndex = 0; arrayIndex < source.GetNumArrayIndices(); arrayIndex++)
   {
@@ -644,7 +646,7 @@ ezResult ezImageConversion::ConvertSingleStepCompress(
           }
 
           ezResult result = static_cast<const ezImageConversionStepCompressBlocks*>(pStep)->CompressBlocks(paddedSlice.GetByteBlobPtr(),
-            target.GetSliceView(mipLevel, face, arrayIndex, slice).GetByteBlobPtr(), numBlocksX, numBlocksY, sourceFormat, targetFormat);
+            target.GetSliceView(mipLevel, face, arrayIndex, slice).GetByteBlobPtr(), numBlocksX, numBlocksY, sourceFormat, targetFormat, quality);
 
           if (result.Failed())
           {
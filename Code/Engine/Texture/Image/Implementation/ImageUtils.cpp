@@ -3,6 +3,7 @@
 #include <Texture/Image/ImageUtils.h>
 
 #include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/Image/ImageEnums.h>
 #include <Texture/Image/ImageFilter.h>
@@ -635,6 +636,140 @@ inline static void FilterLine(
   }
 }
 
+/// \brief Adds up whole rows of pixels, each multiplied with one weight. Rows that are nullptr are outside of the image and use the border color.
+///
+/// Used for the vertical and the depth pass, so that all memory accesses go along the rows instead of striding through the image.
+static void FilterRows(ezUInt32 numPixels, ezArrayPtr<const ezSimdVec4f* const> sourceRows, ezArrayPtr<const ezSimdVec4f> weights, const ezSimdVec4f& borderColor, ezSimdVec4f* __restrict target)
+{
+  ezSimdVec4f borderTotal = ezSimdVec4f::ZeroVector();
+  for (ezUInt32 weightIdx = 0; weightIdx < weights.GetCount(); ++weightIdx)
+  {
+    if (sourceRows[weightIdx] == nullptr)
+    {
+      borderTotal = ezSimdVec4f::MulAdd(borderColor, weights[weightIdx], borderTotal);
+    }
+  }
+
+  bool isFirstRow = true;
+  for (ezUInt32 weightIdx = 0; weightIdx < weights.GetCount(); ++weightIdx)
+  {
+    const ezSimdVec4f* __restrict source = sourceRows[weightIdx];
+    if (source == nullptr)
+      continue;
+
+    const ezSimdVec4f weight = weights[weightIdx];
+
+    if (isFirstRow)
+    {
+      for (ezUInt32 x = 0; x < numPixels; ++x)
+      {
+        target[x] = ezSimdVec4f::MulAdd(source[x], weight, borderTotal);
+      }
+      isFirstRow = false;
+    }
+    else
+    {
+      for (ezUInt32 x = 0; x < numPixels; ++x)
+      {
+        target[x] = ezSimdVec4f::MulAdd(source[x], weight, target[x]);
+      }
+    }
+  }
+
+  if (isFirstRow)
+  {
+    for (ezUInt32 x = 0; x < numPixels; ++x)
+    {
+      target[x] = borderTotal;
+    }
+  }
+}
+
+/// \brief Splits rows of the given width over multiple tasks, small images are processed on the calling thread.
+static ezParallelForParams GetRowsParallelForParams(ezUInt32 rowWidth)
+{
+  ezParallelForParams params;
+  params.uiBinSize = ezMath::Max(1u, 16384u / ezMath::Max(1u, rowWidth));
+  return params;
+}
+
+namespace
+{
+  struct ScalePassData
+  {
+    const ezImageView* m_source;
+    ezImage* m_target;
+    const ezImageFilterWeights* m_weights;
+    ezArrayPtr<const ezInt32> m_firstSampleIndices;
+    ezImageAddressMode::Enum m_addressMode;
+    ezSimdVec4f m_borderColor;
+
+    // dimensions of the target of the pass
+    ezUInt32 m_width;
+    ezUInt32 m_height;
+    ezUInt32 m_depth;
+    ezUInt32 m_numFaces;
+
+    // number of samples along the filtered axis in the source of the pass
+    ezUInt32 m_numSourceSamples;
+  };
+
+  /// \brief Maps a flat row index to the row's coordinates in the target of a pass.
+  struct ScalePassRow
+  {
+    ScalePassRow(const ScalePassData& data, ezUInt32 rowIndex)
+    {
+      m_y = rowIndex % data.m_height;
+      rowIndex /= data.m_height;
+      m_z = rowIndex % data.m_depth;
+      rowIndex /= data.m_depth;
+      m_face = rowIndex % data.m_numFaces;
+      m_arrayIndex = rowIndex / data.m_numFaces;
+    }
+
+    ezUInt32 m_y;
+    ezUInt32 m_z;
+    ezUInt32 m_face;
+    ezUInt32 m_arrayIndex;
+  };
+
+  /// \brief Filters the rows of the source in the vertical (bDepth == false) or depth direction.
+  void FilterRowsOfPass(const ScalePassData& data, ezUInt32 startRow, ezUInt32 endRow, bool bDepth)
+  {
+    const ezUInt32 numWeights = data.m_weights->GetNumWeights();
+
+    ezHybridArray<const ezSimdVec4f*, 32> sourceRows;
+    ezHybridArray<ezSimdVec4f, 32> weights;
+    sourceRows.SetCountUninitialized(numWeights);
+    weights.SetCountUninitialized(numWeights);
+
+    for (ezUInt32 rowIndex = startRow; rowIndex < endRow; ++rowIndex)
+    {
+      const ScalePassRow row(data, rowIndex);
+      const ezUInt32 dstSample = bDepth ? row.m_z : row.m_y;
+      const ezInt32 firstSourceIdx = data.m_firstSampleIndices[dstSample];
+
+      for (ezUInt32 weightIdx = 0; weightIdx < numWeights; ++weightIdx)
+      {
+        bool useBorderColor = false;
+        const ezUInt32 sourceIdx = ezImageUtils::GetSampleIndex(data.m_numSourceSamples, firstSourceIdx + static_cast<ezInt32>(weightIdx), data.m_addressMode, useBorderColor);
+
+        if (useBorderColor)
+          sourceRows[weightIdx] = nullptr;
+        else if (bDepth)
+          sourceRows[weightIdx] = data.m_source->GetPixelPointer<ezSimdVec4f>(0, row.m_face, row.m_arrayIndex, 0, row.m_y, sourceIdx);
+        else
+          sourceRows[weightIdx] = data.m_source->GetPixelPointer<ezSimdVec4f>(0, row.m_face, row.m_arrayIndex, 0, sourceIdx, row.m_z);
+
+        weights[weightIdx] = ezSimdVec4f(data.m_weights->GetWeight(dstSample, weightIdx));
+      }
+
+      ezSimdVec4f* target = data.m_target->GetPixelPointer<ezSimdVec4f>(0, row.m_face, row.m_arrayIndex, 0, row.m_y, row.m_z);
+      FilterRows(data.m_width, sourceRows, weights, data.m_borderColor, target);
+    }
+  }
+} // namespace
+
 static void DownScaleFastLine(ezUInt32 pixelStride, const ezUInt8* src, ezUInt8* dest, ezUInt32 lengthIn, ezUInt32 strideIn, ezUInt32 lengthOut, ezUInt32 strideOut)
 {
   const ezUInt32 downScaleFactor = lengthIn / lengthOut;
@@ -916,21 +1051,32 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& target, ezUIn
     stepHeader.SetWidth(width);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
-      {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
+    ScalePassData data;
+    data.m_source = stepSource;
+    data.m_target = stepTarget;
+    data.m_weights = &weights;
+    data.m_firstSampleIndices = firstSampleIndices;
+    data.m_addressMode = addressModeU;
+    data.m_borderColor = ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+    data.m_width = width;
+    data.m_height = originalHeight;
+    data.m_depth = originalDepth;
+    data.m_numFaces = numFaces;
+    data.m_numSourceSamples = originalWidth;
+
+    // every row is filtered independently
+    ezTaskSystem::ParallelForIndexed(
+      0, numArrayElements * numFaces * originalDepth * originalHeight,
+      [&data](ezUInt32 startRow, ezUInt32 endRow) {
+        for (ezUInt32 rowIndex = startRow; rowIndex < endRow; ++rowIndex)
         {
-          for (ezUInt32 y = 0; y < originalHeight; ++y)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
+          const ScalePassRow row(data, rowIndex);
+          const ezSimdVec4f* filterSource = data.m_source->GetPixelPointer<ezSimdVec4f>(0, row.m_face, row.m_arrayIndex, 0, row.m_y, row.m_z);
+          ezSimdVec4f* filterTarget = data.m_target->GetPixelPointer<ezSimdVec4f>(0, row.m_face, row.m_arrayIndex, 0, row.m_y, row.m_z);
+          FilterLine(data.m_numSourceSamples, filterSource, filterTarget, 1, *data.m_weights, data.m_firstSampleIndices, data.m_addressMode, data.m_borderColor);
         }
-      }
-    }
+      },
+      "ScaleImageHorizontal", GetRowsParallelForParams(originalWidth));
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -959,21 +1105,23 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& target, ezUIn
     stepHeader.SetHeight(height);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
-      {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 x = 0; x < width; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            FilterLine(originalHeight, filterSource, filterTarget, width, weights, firstSampleIndices, addressModeV, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+    ScalePassData data;
+    data.m_source = stepSource;
+    data.m_target = stepTarget;
+    data.m_weights = &weights;
+    data.m_firstSampleIndices = firstSampleIndices;
+    data.m_addressMode = addressModeV;
+    data.m_borderColor = ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+    data.m_width = width;
+    data.m_height = height;
+    data.m_depth = originalDepth;
+    data.m_numFaces = numFaces;
+    data.m_numSourceSamples = originalHeight;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, numArrayElements * numFaces * originalDepth * height,
+      [&data](ezUInt32 startRow, ezUInt32 endRow) { FilterRowsOfPass(data, startRow, endRow, false); }, "ScaleImageVertical",
+      GetRowsParallelForParams(width));
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1002,21 +1150,23 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& target, ezUIn
     stepHeader.SetDepth(depth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
-      {
-        for (ezUInt32 y = 0; y < height; ++y)
-        {
-          for (ezUInt32 x = 0; x < width; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            FilterLine(originalHeight, filterSource, filterTarget, width * height, weights, firstSampleIndices, addressModeW, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+    ScalePassData data;
+    data.m_source = stepSource;
+    data.m_target = stepTarget;
+    data.m_weights = &weights;
+    data.m_firstSampleIndices = firstSampleIndices;
+    data.m_addressMode = addressModeW;
+    data.m_borderColor = ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+    data.m_width = width;
+    data.m_height = height;
+    data.m_depth = depth;
+    data.m_numFaces = numFaces;
+    data.m_numSourceSamples = originalDepth;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, numArrayElements * numFaces * depth * height,
+      [&data](ezUInt32 startRow, ezUInt32 endRow) { FilterRowsOfPass(data, startRow, endRow, true); }, "ScaleImageDepth",
+      GetRowsParallelForParams(width));
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1141,22 +1291,29 @@ void ezImageUtils::RenormalizeNormalMap(ezImage& image)
 {
   EZ_ASSERT_DEV(image.GetImageFormat() == ezImageFormat::R32G32B32A32_FLOAT, "This algorithm currently expects a RGBA 32 Float as input");
 
-  ezSimdVec4f* start = image.GetBlobPtr<ezSimdVec4f>().GetPtr();
-  ezSimdVec4f* const end = image.GetBlobPtr<ezSimdVec4f>().GetEndPtr();
+  auto pixels = image.GetBlobPtr<ezSimdVec4f>();
 
-  ezSimdVec4f two(2.0f);
+  ezParallelForParams params;
+  params.uiBinSize = 16384;
 
-  ezSimdVec4f minusOne(-1.0f);
+  ezTaskSystem::ParallelFor(
+    ezArrayPtr<ezSimdVec4f>(pixels.GetPtr(), static_cast<ezUInt32>(pixels.GetCount())),
+    [](ezArrayPtr<ezSimdVec4f> slice) {
+      ezSimdVec4f two(2.0f);
 
-  ezSimdVec4f half(0.5f);
+      ezSimdVec4f minusOne(-1.0f);
 
-  for (; start < end; start++)
-  {
-    ezSimdVec4f normal;
-    normal = ezSimdVec4f::MulAdd(*start, two, minusOne);
-    normal.Normalize<3>();
-    *start = ezSimdVec4f::MulAdd(half, normal, half);
-  }
+      ezSimdVec4f half(0.5f);
+
+      for (ezSimdVec4f& pixel : slice)
+      {
+        ezSimdVec4f normal;
+        normal = ezSimdVec4f::MulAdd(pixel, two, minusOne);
+        normal.Normalize<3>();
+        pixel = ezSimdVec4f::MulAdd(half, normal, half);
+      }
+    },
+    "RenormalizeNormalMap", params);
 }
 
 void ezImageUtils::AdjustRoughness(ezImage& roughnessMap, const ezImageView& normalMap)
@@ -91,7 +91,7 @@ ezResult ezTexConvProcessor::Process()
 
     EZ_SUCCEED_OR_RETURN(PremultiplyAlpha(assembledImg));
 
-    EZ_SUCCEED_OR_RETURN(GenerateOutput(std::move(assembledImg), m_OutputImage, OutputImageFormat));
+    EZ_SUCCEED_OR_RETURN(GenerateOutput(std::move(assembledImg), m_OutputImage, OutputImageFormat, m_Descriptor.m_CompressionQuality));
 
     EZ_SUCCEED_OR_RETURN(GenerateThumbnailOutput(m_OutputImage, m_ThumbnailOutputImage, m_Descriptor.m_uiThumbnailOutputResolution));
 
@@ -182,11 +182,11 @@ ezResult ezTexConvProcessor::DetectNumChannels(ezArrayPtr<const ezTexConvSliceCh
   return EZ_SUCCESS;
 }
 
-ezResult ezTexConvProcessor::GenerateOutput(ezImage&& src, ezImage& dst, ezEnum<ezImageFormat> format)
+ezResult ezTexConvProcessor::GenerateOutput(ezImage&& src, ezImage& dst, ezEnum<ezImageFormat> format, ezBlockCompressionQuality::Enum quality)
 {
   dst.ResetAndMove(std::move(src));
 
-  if (dst.Convert(format).Failed())
+  if (dst.Convert(format, quality).Failed())
   {
     ezLog::Error("Failed to convert result image to output format '{}'", ezImageFormat::GetName(format));
     return EZ_FAILURE;
@@ -340,7 +340,7 @@ ezResult ezTexConvProcessor::CreateAtlasLayerTexture(const ezTextureAtlasCreatio
 
   EZ_SUCCEED_OR_RETURN(ChooseOutputFormat(OutputImageFormat, atlasDesc.m_Layers[layer].m_Usage, atlasDesc.m_Layers[layer].m_uiNumChannels));
 
-  EZ_SUCCEED_OR_RETURN(GenerateOutput(std::move(atlasImg), dstImg, OutputImageFormat));
+  EZ_SUCCEED_OR_RETURN(GenerateOutput(std::move(atlasImg), dstImg, OutputImageFormat, m_Descriptor.m_CompressionQuality));
 
   return EZ_SUCCESS;
 }
@@ -52,6 +52,7 @@ public:
   // Format / Compression
   ezEnum<ezTexConvUsage> m_Usage;
   ezEnum<ezTexConvCompressionMode> m_CompressionMode;
+  ezEnum<ezBlockCompressionQuality> m_CompressionQuality;
 
   // resolution clamp and downscale
   ezUInt32 m_uiMinResolution = 16;
@@ -1,7 +1,6 @@
 #include <FileservePluginPCH.h>
 
 #include <FileservePlugin/Client/FileserveClient.h>
-#include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
@@ -44,7 +43,7 @@ ezFileserveClient::ezFileserveClient()
       AddServerAddressToTry(sAddress);
     }
   }
-
+
   if (ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-fs_off"))
     s_bEnableFileserve = false;
 
@@ -71,9 +70,12 @@ void ezFileserveClient::ClearState()
 {
   m_bDownloading = false;
   m_bWaitingForUploadFinished = false;
+  m_uiServerProtocolVersion = 0;
   m_CurFileRequestGuid = ezUuid();
   m_sCurFileRequest.Clear();
   m_Download.Clear();
+  m_PrefetchFiles.Clear();
+  m_uiPrefetchBytesToAcknowledge = 0;
 }
 
 ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
@@ -126,7 +128,29 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
       ezLog::Success("Connected to ezFileserver '{0}", m_sServerConnectionAddress);
       m_Network->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserveClient::NetworkMsgHandler, this));
 
-      m_Network->Send('FSRV', 'HELO'); // be friendly
+      // the server answers with its own protocol version, servers from before the protocol was versioned don't answer at all
+      ezRemoteMessage hello('FSRV', 'HELO');
+      hello.GetWriter() << (ezUInt16)ezFileserveTransfer::ProtocolVersion;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, hello);
+
+      const ezTime tStart = ezTime::Now();
+      while (m_uiServerProtocolVersion == 0 && m_Network->IsConnectedToServer() && ezTime::Now() - tStart < timeout)
+      {
+        m_Network->UpdateRemoteInterface();
+        m_Network->ExecuteAllMessageHandlers();
+      }
+
+      if (m_uiServerProtocolVersion != ezFileserveTransfer::ProtocolVersion)
+      {
+        if (m_uiServerProtocolVersion == 0)
+          ezLog::Error("ezFileserver '{0}' did not answer the handshake, it probably uses an older protocol version", m_sServerConnectionAddress);
+        else
+          ezLog::Error("ezFileserver '{0}' uses protocol version {1}, but the client uses version {2}", m_sServerConnectionAddress,
+            m_uiServerProtocolVersion, (ezUInt16)ezFileserveTransfer::ProtocolVersion);
+
+        m_Network->ShutdownConnection();
+        return EZ_FAILURE;
+      }
     }
 
     m_bFailedToConnect = false;
@@ -213,12 +237,11 @@ void ezFileserveClient::UploadFile(ezUInt16 uiDataDirID, const char* szFile, con
 
   ezUInt32 uiNextByte = 0;
 
-  // send the file over in multiple packages of 1KB each
-  // send at least one package, even for empty files
+  // send the file over in multiple packages
 
   while (uiNextByte < fileContent.GetCount())
   {
-    const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(1024, fileContent.GetCount() - uiNextByte);
+    const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(ezFileserveTransfer::ChunkSize, fileContent.GetCount() - uiNextByte);
 
     ezRemoteMessage msg;
     msg.GetWriter() << uploadGuid;
@@ -336,6 +359,12 @@ void ezFileserveClient::GetFullDataDirCachePath(const char* szDataDir, ezStringB
 void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
 {
   EZ_LOCK(m_Mutex);
+  if (msg.GetMessageID() == 'HELO')
+  {
+    msg.GetReader() >> m_uiServerProtocolVersion;
+    return;
+  }
+
   if (msg.GetMessageID() == 'DWNL')
   {
     HandleFileTransferMsg(msg);
@@ -348,6 +377,18 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PRFF')
+  {
+    HandlePrefetchFileMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PRFA')
+  {
+    HandlePrefetchFinishedMsg(msg);
+    return;
+  }
+
   static bool s_bReloadResources = false;
 
   if (msg.GetMessageID() == 'RLDR')
@@ -450,14 +491,14 @@ void ezFileserveClient::HandleFileTransferMsg(ezRemoteMessage& msg)
     }
   }
 
-  ezUInt16 uiChunkSize = 0;
+  ezUInt32 uiChunkSize = 0;
   msg.GetReader() >> uiChunkSize;
 
-  ezUInt32 uiFileSize = 0;
-  msg.GetReader() >> uiFileSize;
+  ezUInt32 uiTransferSize = 0;
+  msg.GetReader() >> uiTransferSize;
 
   // make sure we don't need to reallocate
-  m_Download.Reserve(uiFileSize);
+  m_Download.Reserve(uiTransferSize);
 
   if (uiChunkSize > 0)
   {
@@ -471,7 +512,6 @@ void ezFileserveClient::HandleFileTransferMsg(ezRemoteMessage& msg)
 void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 {
   EZ_LOCK(m_Mutex);
-  EZ_SCOPE_EXIT(m_bDownloading = false);
 
   {
     ezUuid fileRequestGuid;
@@ -484,6 +524,8 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
     }
   }
 
+  EZ_SCOPE_EXIT(m_bDownloading = false);
+
   ezFileserveFileState fileState;
   {
     ezInt8 iFileStatus = 0;
@@ -500,13 +542,119 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
+  ezUInt8 uiCompression = 0;
+  msg.GetReader() >> uiCompression;
+
+  ApplyFileState(m_sCurFileRequest, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir, (ezFileserveCompression)uiCompression);
+}
+
+void ezFileserveClient::HandlePrefetchFileMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  {
+    ezUuid prefetchGuid;
+    msg.GetReader() >> prefetchGuid;
+
+    if (prefetchGuid != m_CurFileRequestGuid)
+      return;
+  }
+
+  ezUInt32 uiFileIndex = 0;
+  ezInt8 iFileStatus = 0;
+  ezInt64 iFileTimeStamp = 0;
+  ezUInt64 uiFileHash = 0;
+  ezUInt16 uiFoundInDataDir = 0;
+  ezUInt8 uiCompression = 0;
+
+  msg.GetReader() >> uiFileIndex;
+  msg.GetReader() >> iFileStatus;
+  msg.GetReader() >> iFileTimeStamp;
+  msg.GetReader() >> uiFileHash;
+  msg.GetReader() >> uiFoundInDataDir;
+  msg.GetReader() >> uiCompression;
+
+  m_uiPrefetchBytesToAcknowledge += m_Download.GetCount();
+
+  if (uiFileIndex < m_PrefetchFiles.GetCount())
+  {
+    ApplyFileState(m_PrefetchFiles[uiFileIndex], (ezFileserveFileState)iFileStatus, iFileTimeStamp, uiFileHash, uiFoundInDataDir, (ezFileserveCompression)uiCompression);
+  }
+
+  // the data of the next file follows directly
+  m_Download.Clear();
+
+  // the server only sends a limited amount of data ahead, tell it how much has arrived
+  if (m_uiPrefetchBytesToAcknowledge >= ezFileserveTransfer::PrefetchWindowSize / 4)
+  {
+    ezRemoteMessage ack('FSRV', 'PRFK');
+    ack.GetWriter() << m_CurFileRequestGuid;
+    ack.GetWriter() << m_uiPrefetchBytesToAcknowledge;
+
+    m_Network->Send(ezRemoteTransmitMode::Reliable, ack);
+
+    m_uiPrefetchBytesToAcknowledge = 0;
+  }
+}
+
+void ezFileserveClient::HandlePrefetchFinishedMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  {
+    ezUuid prefetchGuid;
+    msg.GetReader() >> prefetchGuid;
+
+    if (prefetchGuid != m_CurFileRequestGuid)
+      return;
+  }
+
+  EZ_SCOPE_EXIT(m_bDownloading = false);
+
+  // all files that were not transferred, because they are up to date or don't exist
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+  {
+    ezUInt32 uiFileIndex = 0;
+    ezInt8 iFileStatus = 0;
+    ezInt64 iFileTimeStamp = 0;
+    ezUInt64 uiFileHash = 0;
+    ezUInt16 uiFoundInDataDir = 0;
+
+    msg.GetReader() >> uiFileIndex;
+    msg.GetReader() >> iFileStatus;
+    msg.GetReader() >> iFileTimeStamp;
+    msg.GetReader() >> uiFileHash;
+    msg.GetReader() >> uiFoundInDataDir;
+
+    if (uiFileIndex < m_PrefetchFiles.GetCount())
+    {
+      ApplyFileState(m_PrefetchFiles[uiFileIndex], (ezFileserveFileState)iFileStatus, iFileTimeStamp, uiFileHash, uiFoundInDataDir, ezFileserveCompression::None);
+    }
+  }
+}
+
+void ezFileserveClient::ApplyFileState(const char* szFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash,
+  ezUInt16 uiFoundInDataDir, ezFileserveCompression compression)
+{
+  EZ_LOCK(m_Mutex);
+
+  if (fileState == ezFileserveFileState::Different && ezFileserveTransfer::DecompressContent(compression, m_Download).Failed())
+  {
+    // keep the old cache status, so that the file is requested again
+    ezLog::Error("Failed to decompress the fileserve download of '{0}'", szFile);
+    return;
+  }
+
   if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[szFile] = 0; // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[szFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
@@ -516,9 +664,9 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[szFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[szFile];
     ref.m_FileHash = uiFileHash;
     ref.m_TimeStamp = iFileTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
@@ -530,7 +678,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, &sCachedFile, &sCachedMetaFile);
+  BuildPathInCache(szFile, sMountPoint, &sCachedFile, &sCachedMetaFile);
 
   if (fileState == ezFileserveFileState::NonExistant)
   {
@@ -675,6 +823,86 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
 }
 
+ezResult ezFileserveClient::PrefetchFiles(ezArrayPtr<const ezString> files)
+{
+  EZ_LOCK(m_Mutex);
+  if (m_bDownloading)
+  {
+    ezLog::Warning("Trying to prefetch files over fileserve while another file is already downloading. Prefetch is ignored.");
+    return EZ_FAILURE;
+  }
+
+  if (m_Network == nullptr || !m_Network->IsConnectedToServer())
+    return EZ_FAILURE;
+
+  m_Download.Clear();
+  m_PrefetchFiles.Clear();
+  m_PrefetchFiles.Reserve(files.GetCount());
+  m_uiPrefetchBytesToAcknowledge = 0;
+  m_CurFileRequestGuid.CreateNewUuid();
+
+  ezHybridArray<ezUInt16, 64> useDataDirCache;
+
+  ezStringBuilder sFile;
+  for (const ezString& sPathOrAssetGuid : files)
+  {
+    ezFileSystem::ResolveAssetRedirection(sPathOrAssetGuid, sFile);
+
+    // same restrictions as when a file is opened through a fileserve data directory
+    if (sFile.IsEmpty() || ezPathUtils::IsAbsolutePath(sFile) || ezConversionUtils::IsStringUuid(sFile))
+      continue;
+
+    bool bCachedYet = false;
+    auto itFileDataDir = m_FileDataDir.FindOrAdd(sFile, &bCachedYet);
+    if (!bCachedYet)
+    {
+      FillFileStatusCache(sFile);
+    }
+
+    const ezUInt16 uiUseDataDirCache = itFileDataDir.Value();
+    const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiUseDataDirCache].m_CacheStatus[sFile];
+
+    // was just checked, DownloadFile() won't ask the server either
+    if (m_CurrentTime - CacheStatus.m_LastCheck < ezTime::Seconds(5.0f))
+      continue;
+
+    m_PrefetchFiles.PushBack(sFile);
+    useDataDirCache.PushBack(uiUseDataDirCache);
+  }
+
+  if (m_PrefetchFiles.IsEmpty())
+    return EZ_SUCCESS;
+
+  ezRemoteMessage msg('FSRV', 'PREF');
+  msg.GetWriter() << m_CurFileRequestGuid;
+  msg.GetWriter() << m_PrefetchFiles.GetCount();
+
+  for (ezUInt32 i = 0; i < m_PrefetchFiles.GetCount(); ++i)
+  {
+    const FileCacheStatus& CacheStatus = m_MountedDataDirs[useDataDirCache[i]].m_CacheStatus[m_PrefetchFiles[i]];
+
+    msg.GetWriter() << useDataDirCache[i];
+    msg.GetWriter() << m_PrefetchFiles[i];
+    msg.GetWriter() << CacheStatus.m_TimeStamp;
+    msg.GetWriter() << CacheStatus.m_FileHash;
+  }
+
+  m_bDownloading = true;
+  m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+
+  while (m_bDownloading && m_Network->IsConnectedToServer())
+  {
+    m_Network->UpdateRemoteInterface();
+    m_Network->ExecuteAllMessageHandlers();
+  }
+
+  m_bDownloading = false;
+  m_PrefetchFiles.Clear();
+  m_Download.Clear();
+
+  return EZ_SUCCESS;
+}
+
 void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const
 {
   EZ_LOCK(m_Mutex);
@@ -892,6 +1120,26 @@ EZ_ON_GLOBAL_EVENT(GameApp_UpdatePlugins)
   }
 }
 
+EZ_ON_GLOBAL_EVENT(ezCollectionResource_BeforePreloadResources)
+{
+  ezFileserveClient* pClient = ezFileserveClient::GetSingleton();
+  if (pClient == nullptr || !param0.IsA<ezVariantArray>())
+    return;
+
+  const ezVariantArray& resourceIDs = param0.Get<ezVariantArray>();
+
+  ezDynamicArray<ezString> files;
+  files.Reserve(resourceIDs.GetCount());
+
+  for (const ezVariant& resourceID : resourceIDs)
+  {
+    files.PushBack(resourceID.ConvertTo<ezString>());
+  }
+
+  // if this fails, the files are still downloaded one by one when the resources get loaded
+  pClient->PrefetchFiles(files).IgnoreResult();
+}
+
 
 
 EZ_STATICLINK_FILE(FileservePlugin, FileservePlugin_Client_FileserveClient);
@@ -2,6 +2,7 @@
 
 #include <FileservePlugin/FileservePluginDLL.h>
 
+#include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Configuration/Singleton.h>
 #include <Foundation/Types/UniquePtr.h>
@@ -60,6 +61,9 @@ public:
   /// Also achieved through the command line argument "-fs_off"
   static void DisabledFileserveClient() { s_bEnableFileserve = false; }
 
+  /// \brief Re-enables the file serving functionality after it was disabled, e.g. to run a client and an ezFileserver in the same process for testing.
+  static void EnableFileserveClient() { s_bEnableFileserve = true; }
+
   /// \brief Returns the address through which the Fileserve client tried to connect with the server last.
   const char* GetServerConnectionAddress() { return m_sServerConnectionAddress; }
 
@@ -79,6 +83,17 @@ public:
   /// \brief Adds an address that should be tried for connecting with the server.
   void AddServerAddressToTry(const char* szAddress);
 
+  /// \brief Transfers all the given files into the local cache with a single request, instead of one round trip per file.
+  ///
+  /// The files are paths relative to the mounted data directories, or anything that the data directories can redirect, e.g. asset GUIDs.
+  /// Each file is looked up in all mounted data directories, the same way as when it is opened through ezFileSystem.
+  /// This can be used to pull everything that a level needs into the cache at once, e.g. all resources listed in an ezCollectionResource.
+  /// The server streams the files back to back and compresses them where possible. Files that are already up to date in the cache
+  /// are not transferred again, the server acknowledges all of them with a single message.
+  /// Returns once all files have been processed. Afterwards opening these files does not require another request, as long as their
+  /// cache status is recent enough.
+  ezResult PrefetchFiles(ezArrayPtr<const ezString> files);
+
 private:
   friend class ezDataDirectory::FileserveType;
 
@@ -111,6 +126,10 @@ private:
   void NetworkMsgHandler(ezRemoteMessage& msg);
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFileMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFinishedMsg(ezRemoteMessage& msg);
+  void ApplyFileState(const char* szFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir,
+    ezFileserveCompression compression);
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
   void WriteDownloadToDisk(ezStringBuilder sCachedFile);
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir, ezStringBuilder* out_pFullPath);
@@ -130,10 +149,13 @@ private:
   bool m_bDownloading = false;
   bool m_bFailedToConnect = false;
   bool m_bWaitingForUploadFinished = false;
+  ezUInt16 m_uiServerProtocolVersion = 0; ///< Zero until the server answered 'HELO'.
   ezUuid m_CurFileRequestGuid;
   ezStringBuilder m_sCurFileRequest;
   ezUniquePtr<ezRemoteInterface> m_Network;
   ezDynamicArray<ezUInt8> m_Download;
+  ezDynamicArray<ezString> m_PrefetchFiles;
+  ezUInt32 m_uiPrefetchBytesToAcknowledge = 0;
   ezTime m_CurrentTime;
   ezHybridArray<ezString, 4> m_TryServerAddresses;
 
@@ -1,7 +1,8 @@
 #include <FileservePluginPCH.h>
 
 #include <FileservePlugin/Fileserver/ClientContext.h>
-#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Utilities/Compression.h>
 
 ezFileserveFileState ezFileserveClientContext::GetFileStatus(ezUInt16& inout_uiDataDirID, const char* szRequestedFile, FileStatus& inout_Status,
   ezDynamicArray<ezUInt8>& out_FileContent, bool bForceThisDataDir) const
@@ -38,9 +39,11 @@ ezFileserveFileState ezFileserveClientContext::GetFileStatus(ezUInt16& inout_uiD
     inout_Status.m_iTimestamp = iNewTimestamp;
 
     // read the entire file
+    // this goes straight to disk instead of through ezFileSystem, so that a client in the same process may wait for the server while it holds the
+    // file system lock
     {
-      ezFileReader file;
-      if (file.Open(sAbsPath).Failed())
+      ezOSFile file;
+      if (file.Open(sAbsPath, ezFileOpenMode::Read).Failed())
         continue;
 
       ezUInt64 uiNewHash = 1;
@@ -48,7 +51,9 @@ ezFileserveFileState ezFileserveClientContext::GetFileStatus(ezUInt16& inout_uiD
 
       if (!out_FileContent.IsEmpty())
       {
-        file.ReadBytes(out_FileContent.GetData(), out_FileContent.GetCount());
+        if (file.Read(out_FileContent.GetData(), out_FileContent.GetCount()) != out_FileContent.GetCount())
+          continue;
+
         uiNewHash = ezHashingUtils::xxHash64(out_FileContent.GetData(), (size_t)out_FileContent.GetCount(), uiNewHash);
 
         // if the file is empty, the hash will be zero, which could lead to an incorrect assumption that the hash is the same
@@ -76,6 +81,44 @@ ezFileserveFileState ezFileserveClientContext::GetFileStatus(ezUInt16& inout_uiD
   return ezFileserveFileState::NonExistant;
 }
 
+ezFileserveCompression ezFileserveTransfer::CompressContent(ezArrayPtr<const ezUInt8> content, ezDynamicArray<ezUInt8>& out_Compressed)
+{
+  out_Compressed.Clear();
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (content.GetCount() >= MinCompressionSize && ezCompressionUtils::Compress(content, ezCompressionMethod::ZStd, out_Compressed).Succeeded())
+  {
+    // already compressed data (e.g. textures or sounds) is not worth the decompression on the client
+    if (out_Compressed.GetCount() < content.GetCount() - content.GetCount() / 16)
+      return ezFileserveCompression::ZStd;
+
+    out_Compressed.Clear();
+  }
+#endif
+
+  return ezFileserveCompression::None;
+}
+
+ezResult ezFileserveTransfer::DecompressContent(ezFileserveCompression compression, ezDynamicArray<ezUInt8>& inout_Content)
+{
+  switch (compression)
+  {
+    case ezFileserveCompression::None:
+      return EZ_SUCCESS;
+
+    case ezFileserveCompression::ZStd:
+    {
+      ezDynamicArray<ezUInt8> decompressed;
+      EZ_SUCCEED_OR_RETURN(ezCompressionUtils::Decompress(inout_Content, ezCompressionMethod::ZStd, decompressed));
+      inout_Content.Swap(decompressed);
+      return EZ_SUCCESS;
+    }
+  }
+
+  ezLog::Error("Unknown fileserve compression {0}", (ezUInt32)compression);
+  return EZ_FAILURE;
+}
+
 
 
 EZ_STATICLINK_FILE(FileservePlugin, FileservePlugin_Fileserver_ClientContext);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <FileservePlugin/FileservePluginDLL.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Strings/String.h>
 
@@ -14,6 +15,33 @@ enum class ezFileserveFileState
   Different = 5,
 };
 
+/// \brief How the content of a file is encoded, when it is sent from the server to the client.
+enum class ezFileserveCompression : ezUInt8
+{
+  None = 0,
+  ZStd = 1,
+};
+
+/// \brief Settings and helpers that ezFileserver and ezFileserveClient share for transferring file content.
+namespace ezFileserveTransfer
+{
+  enum
+  {
+    ProtocolVersion = 2,                  ///< Sent with 'HELO'. The server ignores clients with a different version, as the message layout differs.
+    ChunkSize = 64 * 1024,                ///< The maximum number of bytes of a file that are sent in a single message.
+    PrefetchWindowSize = 4 * 1024 * 1024, ///< How many bytes the server sends during a prefetch, before the client has to acknowledge them.
+    MinCompressionSize = 512,             ///< Smaller files are always sent uncompressed.
+  };
+
+  /// \brief Compresses the file content into out_Compressed, if that makes the transfer smaller.
+  ///
+  /// Returns ezFileserveCompression::None if the content should be sent as is, in which case out_Compressed is left empty.
+  EZ_FILESERVEPLUGIN_DLL ezFileserveCompression CompressContent(ezArrayPtr<const ezUInt8> content, ezDynamicArray<ezUInt8>& out_Compressed);
+
+  /// \brief Restores the original file content from what was received with the given compression.
+  EZ_FILESERVEPLUGIN_DLL ezResult DecompressContent(ezFileserveCompression compression, ezDynamicArray<ezUInt8>& inout_Content);
+} // namespace ezFileserveTransfer
+
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClientContext
 {
 public:
@@ -37,6 +65,7 @@ public:
     ezDynamicArray<ezUInt8>& out_FileContent, bool bForceThisDataDir) const;
 
   bool m_bLostConnection = false;
+  ezUInt16 m_uiProtocolVersion = 0; ///< The version the client sent with 'HELO', see ezFileserveTransfer::ProtocolVersion.
   ezUInt32 m_uiApplicationID = 0;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
 };
@@ -43,6 +43,7 @@ void ezFileserver::StopServer()
 
   m_Network->ShutdownConnection();
   m_Network.Clear();
+  m_PrefetchRequests.Clear();
 
   ezFileserverEvent e;
   e.m_Type = ezFileserverEvent::Type::ServerStopped;
@@ -55,7 +56,10 @@ bool ezFileserver::UpdateServer()
     return false;
 
   m_Network->UpdateRemoteInterface();
-  return m_Network->ExecuteAllMessageHandlers() > 0;
+  const bool bHandledMessages = m_Network->ExecuteAllMessageHandlers() > 0;
+  const bool bSentFiles = ContinuePrefetching();
+
+  return bHandledMessages || bSentFiles;
 }
 
 bool ezFileserver::IsServerRunning() const
@@ -83,7 +87,10 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
   auto& client = DetermineClient(msg);
 
   if (msg.GetMessageID() == 'HELO')
+  {
+    HandleHelloMsg(client, msg);
     return;
+  }
 
   if (msg.GetMessageID() == 'RUTR')
   {
@@ -96,12 +103,30 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (client.m_uiProtocolVersion != ezFileserveTransfer::ProtocolVersion)
+  {
+    // the message layout differs, the error was already reported during the handshake
+    return;
+  }
+
   if (msg.GetMessageID() == 'READ')
   {
     HandleFileRequest(client, msg);
     return;
   }
 
+  if (msg.GetMessageID() == 'PREF')
+  {
+    HandlePrefetchRequest(client, msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PRFK')
+  {
+    HandlePrefetchAcknowledged(msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -192,6 +217,24 @@ ezFileserveClientContext& ezFileserver::DetermineClient(ezRemoteMessage& msg)
   return client;
 }
 
+void ezFileserver::HandleHelloMsg(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  // clients from before the protocol was versioned send no version at all
+  client.m_uiProtocolVersion = 0;
+  msg.GetReader() >> client.m_uiProtocolVersion;
+
+  if (client.m_uiProtocolVersion != ezFileserveTransfer::ProtocolVersion)
+  {
+    ezLog::Error("Fileserve client {0} uses protocol version {1}, but the server uses version {2}. The client is ignored.", client.m_uiApplicationID,
+      client.m_uiProtocolVersion, (ezUInt16)ezFileserveTransfer::ProtocolVersion);
+  }
+
+  // the client waits for this answer and compares the version itself
+  ezRemoteMessage ret('FSRV', 'HELO');
+  ret.GetWriter() << (ezUInt16)ezFileserveTransfer::ProtocolVersion;
+  m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+}
+
 void ezFileserver::HandleMountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezStringBuilder sDataDir, sRootName, sMountPoint, sRedir;
@@ -268,12 +311,32 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   msg.GetReader() >> status.m_iTimestamp;
   msg.GetReader() >> status.m_uiHash;
 
+  ezFileserveCompression compression = ezFileserveCompression::None;
+  const ezFileserveFileState filestate = SendFile(client, downloadGuid, uiDataDirID, sRequestedFile, status, bForceThisDataDir, compression);
+
+  // final answer to client
+  {
+    ezRemoteMessage ret('FSRV', 'DWNF');
+    ret.GetWriter() << downloadGuid;
+    ret.GetWriter() << (ezInt8)filestate;
+    ret.GetWriter() << status.m_iTimestamp;
+    ret.GetWriter() << status.m_uiHash;
+    ret.GetWriter() << uiDataDirID;
+    ret.GetWriter() << (ezUInt8)compression;
+
+    m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+  }
+}
+
+ezFileserveFileState ezFileserver::SendFile(ezFileserveClientContext& client, const ezUuid& downloadGuid, ezUInt16& inout_uiDataDirID, const char* szFile,
+  ezFileserveClientContext::FileStatus& inout_Status, bool bForceThisDataDir, ezFileserveCompression& out_Compression)
+{
   ezFileserverEvent e;
   e.m_uiClientID = client.m_uiApplicationID;
-  e.m_szPath = sRequestedFile;
+  e.m_szPath = szFile;
   e.m_uiSentTotal = 0;
 
-  const ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, bForceThisDataDir);
+  const ezFileserveFileState filestate = client.GetFileStatus(inout_uiDataDirID, szFile, inout_Status, m_SendToClient, bForceThisDataDir);
 
   {
     e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
@@ -282,56 +345,169 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
     m_Events.Broadcast(e);
   }
 
+  out_Compression = ezFileserveCompression::None;
+
   if (filestate == ezFileserveFileState::Different)
   {
-    ezUInt32 uiNextByte = 0;
+    out_Compression = ezFileserveTransfer::CompressContent(m_SendToClient, m_CompressedSendToClient);
+
+    const ezDynamicArray<ezUInt8>& transfer = (out_Compression == ezFileserveCompression::None) ? m_SendToClient : m_CompressedSendToClient;
     const ezUInt32 uiFileSize = m_SendToClient.GetCount();
+    const ezUInt32 uiTransferSize = transfer.GetCount();
+    ezUInt32 uiNextByte = 0;
 
-    // send the file over in multiple packages of 1KB each
+    // send the file over in multiple packages
     // send at least one package, even for empty files
     do
     {
-      const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(1024, m_SendToClient.GetCount() - uiNextByte);
+      const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(ezFileserveTransfer::ChunkSize, uiTransferSize - uiNextByte);
 
       ezRemoteMessage ret;
       ret.GetWriter() << downloadGuid;
       ret.GetWriter() << uiChunkSize;
-      ret.GetWriter() << uiFileSize;
+      ret.GetWriter() << uiTransferSize;
 
-      if (!m_SendToClient.IsEmpty())
-        ret.GetWriter().WriteBytes(&m_SendToClient[uiNextByte], uiChunkSize).IgnoreResult();
+      if (uiChunkSize > 0)
+        ret.GetWriter().WriteBytes(&transfer[uiNextByte], uiChunkSize).IgnoreResult();
 
       ret.SetMessageID('FSRV', 'DWNL');
       m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
 
       uiNextByte += uiChunkSize;
 
-      // reuse previous values
+      // reuse previous values, the progress is reported in uncompressed bytes
       {
         e.m_Type = ezFileserverEvent::Type::FileDownloading;
-        e.m_uiSentTotal = uiNextByte;
+        e.m_uiSentTotal = (ezUInt32)((ezUInt64)uiFileSize * uiNextByte / ezMath::Max<ezUInt32>(uiTransferSize, 1));
         m_Events.Broadcast(e);
       }
-    } while (uiNextByte < m_SendToClient.GetCount());
+    } while (uiNextByte < uiTransferSize);
   }
 
-  // final answer to client
+  // reuse previous values
   {
-    ezRemoteMessage ret('FSRV', 'DWNF');
-    ret.GetWriter() << downloadGuid;
-    ret.GetWriter() << (ezInt8)filestate;
-    ret.GetWriter() << status.m_iTimestamp;
-    ret.GetWriter() << status.m_uiHash;
-    ret.GetWriter() << uiDataDirID;
+    e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
+    m_Events.Broadcast(e);
+  }
 
-    m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+  return filestate;
+}
+
+void ezFileserver::HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  PrefetchRequest& request = m_PrefetchRequests.ExpandAndGetRef();
+  request.m_uiClientID = client.m_uiApplicationID;
+
+  msg.GetReader() >> request.m_Guid;
+
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  request.m_Files.SetCount(uiNumFiles);
+
+  for (PrefetchFile& file : request.m_Files)
+  {
+    msg.GetReader() >> file.m_uiDataDirID;
+    msg.GetReader() >> file.m_sFile;
+    msg.GetReader() >> file.m_Status.m_iTimestamp;
+    msg.GetReader() >> file.m_Status.m_uiHash;
   }
+}
 
-  // reuse previous values
+void ezFileserver::HandlePrefetchAcknowledged(ezRemoteMessage& msg)
+{
+  ezUuid prefetchGuid;
+  msg.GetReader() >> prefetchGuid;
+
+  ezUInt32 uiReceivedBytes = 0;
+  msg.GetReader() >> uiReceivedBytes;
+
+  for (PrefetchRequest& request : m_PrefetchRequests)
   {
-    e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
-    m_Events.Broadcast(e);
+    if (request.m_Guid == prefetchGuid)
+    {
+      request.m_uiBytesInFlight -= ezMath::Min(uiReceivedBytes, request.m_uiBytesInFlight);
+      return;
+    }
+  }
+}
+
+bool ezFileserver::ContinuePrefetching()
+{
+  bool bSentData = false;
+
+  for (ezUInt32 uiRequest = 0; uiRequest < m_PrefetchRequests.GetCount();)
+  {
+    PrefetchRequest& request = m_PrefetchRequests[uiRequest];
+
+    ezFileserveClientContext* pClient = m_Clients.GetValue(request.m_uiClientID);
+    if (pClient == nullptr || pClient->m_bLostConnection)
+    {
+      m_PrefetchRequests.RemoveAtAndCopy(uiRequest);
+      continue;
+    }
+
+    // the client acknowledges the data that it has received, so that the amount of queued up network data stays bounded
+    while (request.m_uiNextFile < request.m_Files.GetCount() && request.m_uiBytesInFlight < ezFileserveTransfer::PrefetchWindowSize)
+    {
+      const ezUInt32 uiFileIndex = request.m_uiNextFile++;
+      PrefetchFile& file = request.m_Files[uiFileIndex];
+
+      ezFileserveCompression compression = ezFileserveCompression::None;
+      file.m_State = SendFile(*pClient, request.m_Guid, file.m_uiDataDirID, file.m_sFile, file.m_Status, false, compression);
+
+      if (file.m_State != ezFileserveFileState::Different)
+      {
+        request.m_UnchangedFiles.PushBack(uiFileIndex);
+        continue;
+      }
+
+      request.m_uiBytesInFlight += (compression == ezFileserveCompression::None) ? m_SendToClient.GetCount() : m_CompressedSendToClient.GetCount();
+
+      ezRemoteMessage ret('FSRV', 'PRFF');
+      ret.GetWriter() << request.m_Guid;
+      ret.GetWriter() << uiFileIndex;
+      ret.GetWriter() << (ezInt8)file.m_State;
+      ret.GetWriter() << file.m_Status.m_iTimestamp;
+      ret.GetWriter() << file.m_Status.m_uiHash;
+      ret.GetWriter() << file.m_uiDataDirID;
+      ret.GetWriter() << (ezUInt8)compression;
+
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+      bSentData = true;
+    }
+
+    if (request.m_uiNextFile < request.m_Files.GetCount())
+    {
+      ++uiRequest;
+      continue;
+    }
+
+    // all files that did not need to be transferred are acknowledged at once, which also tells the client that the prefetch is done
+    {
+      ezRemoteMessage ret('FSRV', 'PRFA');
+      ret.GetWriter() << request.m_Guid;
+      ret.GetWriter() << request.m_UnchangedFiles.GetCount();
+
+      for (ezUInt32 uiFileIndex : request.m_UnchangedFiles)
+      {
+        const PrefetchFile& file = request.m_Files[uiFileIndex];
+
+        ret.GetWriter() << uiFileIndex;
+        ret.GetWriter() << (ezInt8)file.m_State;
+        ret.GetWriter() << file.m_Status.m_iTimestamp;
+        ret.GetWriter() << file.m_Status.m_uiHash;
+        ret.GetWriter() << file.m_uiDataDirID;
+      }
+
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
+    m_PrefetchRequests.RemoveAtAndCopy(uiRequest);
+    bSentData = true;
   }
+
+  return bSentData;
 }
 
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
@@ -389,7 +565,7 @@ void ezFileserver::HandleUploadFileTransfer(ezFileserveClientContext& client, ez
   if (transferGuid != m_FileUploadGuid)
     return;
 
-  ezUInt16 uiChunkSize = 0;
+  ezUInt32 uiChunkSize = 0;
   msg.GetReader() >> uiChunkSize;
 
   const ezUInt32 uiStartPos = m_SentFromClient.GetCount();
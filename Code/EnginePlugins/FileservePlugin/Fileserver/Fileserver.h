@@ -93,6 +93,7 @@ private:
   void NetworkEventHandler(const ezRemoteEvent& e);
   ezFileserveClientContext& DetermineClient(ezRemoteMessage& msg);
   void NetworkMsgHandler(ezRemoteMessage& msg);
+  void HandleHelloMsg(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleMountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUnmountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
@@ -100,10 +101,36 @@ private:
   void HandleUploadFileHeader(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileTransfer(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileFinished(ezFileserveClientContext& client, ezRemoteMessage& msg);
+  void HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
+  void HandlePrefetchAcknowledged(ezRemoteMessage& msg);
+  ezFileserveFileState SendFile(ezFileserveClientContext& client, const ezUuid& downloadGuid, ezUInt16& inout_uiDataDirID, const char* szFile,
+    ezFileserveClientContext::FileStatus& inout_Status, bool bForceThisDataDir, ezFileserveCompression& out_Compression);
+  bool ContinuePrefetching();
+
+  struct PrefetchFile
+  {
+    ezString m_sFile;
+    ezUInt16 m_uiDataDirID = 0;
+    ezFileserveFileState m_State = ezFileserveFileState::None;
+    ezFileserveClientContext::FileStatus m_Status;
+  };
+
+  /// \brief A batch of files that a client requested at once. The files are sent over multiple updates, to limit how much data is in flight.
+  struct PrefetchRequest
+  {
+    ezUuid m_Guid;
+    ezUInt32 m_uiClientID = 0;
+    ezUInt32 m_uiNextFile = 0;
+    ezUInt32 m_uiBytesInFlight = 0;
+    ezDynamicArray<PrefetchFile> m_Files;
+    ezDynamicArray<ezUInt32> m_UnchangedFiles; // indices of all files that don't need to be transferred, these are acknowledged in one message at the end
+  };
 
   ezHashTable<ezUInt32, ezFileserveClientContext> m_Clients;
   ezUniquePtr<ezRemoteInterface> m_Network;
+  ezDynamicArray<PrefetchRequest> m_PrefetchRequests;
   ezDynamicArray<ezUInt8> m_SendToClient;   // ie. 'downloads' from server to client
+  ezDynamicArray<ezUInt8> m_CompressedSendToClient;
   ezDynamicArray<ezUInt8> m_SentFromClient; // ie. 'uploads' from client to server
   ezStringBuilder m_sCurFileUpload;
   ezUuid m_FileUploadGuid;
@@ -1,6 +1,7 @@
 #include <ParticlePluginPCH.h>
 
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_ColorGradient.h>
@@ -109,7 +110,7 @@ void ezParticleBehavior_ColorGradient::CreateRequiredStreams()
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, false);
   }
 }
 
@@ -211,16 +212,14 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+    const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
 
     // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
-
-    while (!itVelocity.HasReachedEnd())
+    for (ezUInt64 i = m_uiFirstToUpdate; i < uiNumElements; i += m_uiCurrentUpdateInterval)
     {
       // if (itLifeTime.Current().y > 0)
       {
-        const float fSpeed = itVelocity.Current().GetLength();
+        const float fSpeed = velocity.Get(i).GetLength();
         const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
 
         ezColor rgba;
@@ -235,7 +234,6 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
       // skip the next n items
       // this is to reduce the number of particles that need to be fully evaluated,
       // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
       itColor.Advance(m_uiCurrentUpdateInterval);
     }
   }
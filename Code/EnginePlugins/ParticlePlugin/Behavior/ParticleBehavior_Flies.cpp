@@ -1,7 +1,7 @@
 #include <ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
 #include <Foundation/Time/Clock.h>
@@ -87,7 +87,7 @@ void ezParticleBehaviorFactory_Flies::Load(ezStreamReader& stream)
 void ezParticleBehavior_Flies::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, false);
 
   m_TimeToChangeDir.SetZero();
 }
@@ -107,18 +107,18 @@ void ezParticleBehavior_Flies::Process(ezUInt64 uiNumElements)
   const ezVec3 vEmitterPos = GetOwnerSystem()->GetTransform().m_vPosition;
   const float fMaxDistanceToEmitterSquared = ezMath::Square(m_fMaxEmitterDistance);
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  const ezVec4* pPosition = m_pStreamPosition->GetData<ezVec4>();
+  const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
 
   ezQuat qRot;
 
-  while (!itPosition.HasReachedEnd())
+  for (ezUInt64 i = 0; i < uiNumElements; ++i)
   {
     // if (pLifeArray[i] == pMaxLifeArray[i])
 
-    const ezVec3 vPartToEm = vEmitterPos - itPosition.Current().GetAsVec3();
+    const ezVec3 vPartToEm = vEmitterPos - pPosition[i].GetAsVec3();
     const float fDist = vPartToEm.GetLengthSquared();
-    const ezVec3 vVelocity = itVelocity.Current();
+    const ezVec3 vVelocity = velocity.Get(i);
     ezVec3 vDir = vVelocity;
     vDir.NormalizeIfNotZero().IgnoreResult();
 
@@ -130,14 +130,11 @@ void ezParticleBehavior_Flies::Process(ezUInt64 uiNumElements)
 
       qRot.SetFromAxisAndAngle(vPivot, m_MaxSteeringAngle);
 
-      itVelocity.Current() = qRot * vVelocity;
+      velocity.Set(i, qRot * vVelocity);
     }
     else
     {
-      itVelocity.Current() = ezVec3::CreateRandomDeviation(GetRNG(), m_MaxSteeringAngle, vDir) * m_fSpeed;
+      velocity.Set(i, ezVec3::CreateRandomDeviation(GetRNG(), m_MaxSteeringAngle, vDir) * m_fSpeed);
     }
-
-    itPosition.Advance();
-    itVelocity.Advance();
   }
 }
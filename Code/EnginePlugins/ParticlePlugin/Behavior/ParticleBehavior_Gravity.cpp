@@ -3,7 +3,7 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
@@ -70,25 +70,32 @@ void ezParticleBehaviorFactory_Gravity::QueryFinalizerDependencies(ezSet<const e
 
 void ezParticleBehavior_Gravity::CreateRequiredStreams()
 {
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, false);
 }
 
-void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
+void ezParticleBehavior_Gravity::BeginKernel(ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Gravity");
-
   const ezVec3 vGravity = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity() : ezVec3(0.0f, 0.0f, -10.0f);
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
-  const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
+  m_vAddGravity = vGravity * m_fGravityFactor * tDiff;
+}
+
+void ezParticleBehavior_Gravity::ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  const ezSimdVec4f vAddX(m_vAddGravity.x);
+  const ezSimdVec4f vAddY(m_vAddGravity.y);
+  const ezSimdVec4f vAddZ(m_vAddGravity.z);
 
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
+  const ezUInt64 uiEnd = uiStartIndex + ezProcessingStreamSoA3f::GetPaddedCount(uiNumElements);
 
-    itVelocity.Advance();
+  for (ezUInt64 i = uiStartIndex; i < uiEnd; i += 4)
+  {
+    ezSimdVec4f x, y, z;
+    velocity.Load(i, x, y, z);
+    velocity.Store(i, x + vAddX, y + vAddY, z + vAddZ);
   }
 }
 
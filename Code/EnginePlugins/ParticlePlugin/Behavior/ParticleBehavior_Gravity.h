@@ -32,15 +32,19 @@ public:
   float m_fGravityFactor;
 
   virtual void CreateRequiredStreams() override;
+  virtual bool HasKernel() const override { return true; }
 
 protected:
   friend class ezParticleBehaviorFactory_Gravity;
 
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void BeginKernel(ezUInt64 uiNumElements) override;
+  virtual void ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
   ezPhysicsWorldModuleInterface* m_pPhysicsModule;
 
   ezProcessingStream* m_pStreamVelocity;
+
+  ezVec3 m_vAddGravity;
 };
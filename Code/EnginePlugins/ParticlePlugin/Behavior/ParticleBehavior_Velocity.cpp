@@ -5,6 +5,7 @@
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
@@ -102,13 +103,11 @@ void ezParticleBehaviorFactory_Velocity::QueryFinalizerDependencies(ezSet<const
 void ezParticleBehavior_Velocity::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, false);
 }
 
-void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
+void ezParticleBehavior_Velocity::BeginKernel(ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Velocity");
-
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 vDown = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity().GetNormalized() : ezVec3(0.0f, 0.0f, -1.0f);
   const ezVec3 vRise = vDown * tDiff * -m_fRiseSpeed;
@@ -119,24 +118,35 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
     vWind = m_pWindModule->GetWindAt(GetOwnerSystem()->GetTransform().m_vPosition) * m_fWindInfluence * tDiff;
   }
 
-  const ezVec3 vAddPos0 = vRise + vWind;
+  m_vAddPosition = vRise + vWind;
+
+  const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
+  m_fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+}
 
+void ezParticleBehavior_Velocity::ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
   ezSimdVec4f vAddPos;
-  vAddPos.Load<3>(&vAddPos0.x);
+  vAddPos.Load<3>(&m_vAddPosition.x);
 
-  const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
-  const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+  const ezSimdFloat fFrictionFactor(m_fFrictionFactor);
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
 
   while (!itPosition.HasReachedEnd())
   {
     itPosition.Current() += vAddPos;
-    itVelocity.Current() *= fFrictionFactor;
-
     itPosition.Advance();
-    itVelocity.Advance();
+  }
+
+  const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
+  const ezUInt64 uiEnd = uiStartIndex + ezProcessingStreamSoA3f::GetPaddedCount(uiNumElements);
+
+  for (ezUInt64 i = uiStartIndex; i < uiEnd; i += 4)
+  {
+    ezSimdVec4f x, y, z;
+    velocity.Load(i, x, y, z);
+    velocity.Store(i, x * fFrictionFactor, y * fFrictionFactor, z * fFrictionFactor);
   }
 }
 
@@ -33,6 +33,7 @@ class EZ_PARTICLEPLUGIN_DLL ezParticleBehavior_Velocity final : public ezParticl
 
 public:
   virtual void CreateRequiredStreams() override;
+  virtual bool HasKernel() const override { return true; }
 
   float m_fRiseSpeed = 0;
   float m_fFriction = 0;
@@ -41,7 +42,8 @@ public:
 protected:
   friend class ezParticleBehaviorFactory_Velocity;
 
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void BeginKernel(ezUInt64 uiNumElements) override;
+  virtual void ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
@@ -51,4 +53,7 @@ protected:
 
   ezProcessingStream* m_pStreamPosition;
   ezProcessingStream* m_pStreamVelocity;
+
+  ezVec3 m_vAddPosition;
+  float m_fFrictionFactor = 1.0f;
 };
@@ -15,6 +15,7 @@ class ezParticleEventReactionFactory;
 class ezParticleEventReaction;
 class ezParticleEmitter;
 class ezParticleInitializer;
+class ezParticleModule;
 class ezParticleBehavior;
 class ezParticleType;
 class ezProcessingStreamGroup;
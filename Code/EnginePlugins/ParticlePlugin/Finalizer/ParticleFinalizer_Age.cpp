@@ -2,6 +2,7 @@
 
 #include <Core/World/World.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
@@ -65,7 +66,7 @@ void ezParticleFinalizer_Age::CreateRequiredStreams()
   if (!m_sOnDeathEvent.IsEmpty())
   {
     CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, false);
   }
 }
 
@@ -103,15 +104,13 @@ void ezParticleFinalizer_Age::InitializeElements(ezUInt64 uiStartIndex, ezUInt64
   }
 }
 
-void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
+void ezParticleFinalizer_Age::ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Age");
-
   ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetWritableData<ezFloat16Vec2>();
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  for (ezUInt32 i = 0; i < uiNumElements; ++i)
+  for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
   {
     pLifeTime[i].x = pLifeTime[i].x - tDiff;
 
@@ -128,12 +127,12 @@ void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
 void ezParticleFinalizer_Age::OnParticleDeath(const ezStreamGroupElementRemovedEvent& e)
 {
   const ezVec4* pPosition = m_pStreamPosition->GetData<ezVec4>();
-  const ezVec3* pVelocity = m_pStreamVelocity->GetData<ezVec3>();
+  const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
 
   ezParticleEvent pe;
   pe.m_EventType = m_sOnDeathEvent;
   pe.m_vPosition = pPosition[e.m_uiElementIndex].GetAsVec3();
-  pe.m_vDirection = pVelocity[e.m_uiElementIndex];
+  pe.m_vDirection = velocity.Get(e.m_uiElementIndex);
   pe.m_vNormal.SetZero();
 
   GetOwnerEffect()->AddParticleEvent(pe);
@@ -30,6 +30,7 @@ public:
   ~ezParticleFinalizer_Age();
 
   virtual void CreateRequiredStreams() override;
+  virtual bool HasKernel() const override { return true; }
 
   ezVarianceTypeTime m_LifeTime;
   ezTempHashedString m_sOnDeathEvent;
@@ -39,7 +40,7 @@ protected:
   friend class ezParticleFinalizerFactory_Age;
 
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
   void OnParticleDeath(const ezStreamGroupElementRemovedEvent& e);
 
   bool m_bHasOnDeathEventHandler = false;
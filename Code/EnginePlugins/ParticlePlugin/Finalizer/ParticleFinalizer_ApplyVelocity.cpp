@@ -1,9 +1,10 @@
 #include <ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Math/Declarations.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
 
 // clang-format off
@@ -37,25 +38,43 @@ ezParticleFinalizer_ApplyVelocity::~ezParticleFinalizer_ApplyVelocity() {}
 void ezParticleFinalizer_ApplyVelocity::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, false);
 }
 
-void ezParticleFinalizer_ApplyVelocity::Process(ezUInt64 uiNumElements)
+void ezParticleFinalizer_ApplyVelocity::ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: ApplyVelocity");
+  const ezSimdFloat tDiff((float)m_TimeDiff.GetSeconds());
 
-  const float tDiff = (float)m_TimeDiff.GetSeconds();
+  ezSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<ezSimdVec4f>();
+  const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  const ezUInt64 uiEnd = uiStartIndex + uiNumElements;
+  const ezUInt64 uiEndFullGroups = uiStartIndex + (uiNumElements / 4) * 4;
 
-  while (!itPosition.HasReachedEnd())
+  ezUInt64 i = uiStartIndex;
+
+  for (; i < uiEndFullGroups; i += 4)
+  {
+    ezSimdVec4f x, y, z;
+    velocity.Load(i, x, y, z);
+
+    // transpose the velocities of four particles into one vector per particle, with zero in w
+    ezSimdMat4f velocities;
+    velocities.SetRows(x * tDiff, y * tDiff, z * tDiff, ezSimdVec4f::ZeroVector());
+
+    pPosition[i + 0] += velocities.m_col0;
+    pPosition[i + 1] += velocities.m_col1;
+    pPosition[i + 2] += velocities.m_col2;
+    pPosition[i + 3] += velocities.m_col3;
+  }
+
+  for (; i < uiEnd; ++i)
   {
-    ezVec3& pos = reinterpret_cast<ezVec3&>(itPosition.Current());
+    const ezVec3 vVelocity = velocity.Get(i);
 
-    pos += itVelocity.Current() * tDiff;
+    ezSimdVec4f vel;
+    vel.Load<3>(&vVelocity.x);
 
-    itPosition.Advance();
-    itVelocity.Advance();
+    pPosition[i] += vel * tDiff;
   }
 }
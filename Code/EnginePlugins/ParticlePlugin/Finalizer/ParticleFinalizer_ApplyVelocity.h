@@ -23,9 +23,10 @@ public:
   ~ezParticleFinalizer_ApplyVelocity();
 
   virtual void CreateRequiredStreams() override;
+  virtual bool HasKernel() const override { return true; }
 
 protected:
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   ezProcessingStream* m_pStreamPosition = nullptr;
   ezProcessingStream* m_pStreamVelocity = nullptr;
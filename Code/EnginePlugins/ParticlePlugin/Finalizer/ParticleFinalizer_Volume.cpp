@@ -45,29 +45,39 @@ void ezParticleFinalizer_Volume::QueryOptionalStreams()
   m_pStreamSize = GetOwnerSystem()->QueryStream("Size", ezProcessingStream::DataType::Half);
 }
 
-void ezParticleFinalizer_Volume::Process(ezUInt64 uiNumElements)
+void ezParticleFinalizer_Volume::BeginKernel(ezUInt64 uiNumElements)
 {
-  if (uiNumElements == 0)
-    return;
-
-  EZ_PROFILE_SCOPE("PFX: Volume");
-
-  const ezSimdVec4f* pPosition = m_pStreamPosition->GetData<ezSimdVec4f>();
+  m_fMaxSize = 0.0f;
+  m_bHasParticles = uiNumElements > 0;
+}
 
-  ezSimdBBoxSphere volume;
-  volume.SetFromPoints(pPosition, static_cast<ezUInt32>(uiNumElements));
+void ezParticleFinalizer_Volume::ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  const ezSimdVec4f* pPosition = m_pStreamPosition->GetData<ezSimdVec4f>() + uiStartIndex;
 
-  float fMaxSize = 0;
+  // chunks are processed in order, so the first one initializes the volume
+  if (uiStartIndex == 0)
+  {
+    m_Volume.SetFromPoints(pPosition, static_cast<ezUInt32>(uiNumElements));
+  }
+  else
+  {
+    ezSimdBBoxSphere chunkVolume;
+    chunkVolume.SetFromPoints(pPosition, static_cast<ezUInt32>(uiNumElements));
+    m_Volume.ExpandToInclude(chunkVolume);
+  }
 
   if (m_pStreamSize != nullptr)
   {
-    const ezFloat16* pSize = m_pStreamSize->GetData<ezFloat16>();
+    const ezFloat16* pSize = m_pStreamSize->GetData<ezFloat16>() + uiStartIndex;
 
     ezSimdVec4f vMax;
     vMax.SetZero();
 
     constexpr ezUInt32 uiElementsPerLoop = 4;
-    for (ezUInt64 i = 0; i < uiNumElements; i += uiElementsPerLoop)
+    const ezUInt64 uiNumFullLoops = (uiNumElements / uiElementsPerLoop) * uiElementsPerLoop;
+
+    for (ezUInt64 i = 0; i < uiNumFullLoops; i += uiElementsPerLoop)
     {
       const float x = pSize[i + 0];
       const float y = pSize[i + 1];
@@ -77,13 +87,19 @@ void ezParticleFinalizer_Volume::Process(ezUInt64 uiNumElements)
       vMax = vMax.CompMax(ezSimdVec4f(x, y, z, w));
     }
 
-    for (ezUInt64 i = (uiNumElements / uiElementsPerLoop) * uiElementsPerLoop; i < uiNumElements; ++i)
+    for (ezUInt64 i = uiNumFullLoops; i < uiNumElements; ++i)
     {
-      fMaxSize = ezMath::Max(fMaxSize, (float)pSize[i]);
+      m_fMaxSize = ezMath::Max(m_fMaxSize, (float)pSize[i]);
     }
 
-    fMaxSize = ezMath::Max(fMaxSize, (float)vMax.HorizontalMax<4>());
+    m_fMaxSize = ezMath::Max(m_fMaxSize, (float)vMax.HorizontalMax<4>());
   }
+}
+
+void ezParticleFinalizer_Volume::EndKernel()
+{
+  if (!m_bHasParticles)
+    return;
 
-  GetOwnerSystem()->SetBoundingVolume(ezSimdConversion::ToBBoxSphere(volume), fMaxSize);
+  GetOwnerSystem()->SetBoundingVolume(ezSimdConversion::ToBBoxSphere(m_Volume), m_fMaxSize);
 }
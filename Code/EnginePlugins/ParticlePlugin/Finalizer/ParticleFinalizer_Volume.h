@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/SimdMath/SimdBBoxSphere.h>
 #include <Foundation/Types/VarianceTypes.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer.h>
 
@@ -28,10 +29,18 @@ public:
 
   virtual void CreateRequiredStreams() override;
   virtual void QueryOptionalStreams() override;
+  virtual bool HasKernel() const override { return true; }
 
 protected:
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void BeginKernel(ezUInt64 uiNumElements) override;
+  virtual void ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
+  virtual void EndKernel() override;
 
   ezProcessingStream* m_pStreamPosition = nullptr;
   const ezProcessingStream* m_pStreamSize = nullptr;
+
+  // accumulated over all chunks of one update
+  ezSimdBBoxSphere m_Volume;
+  float m_fMaxSize = 0.0f;
+  bool m_bHasParticles = false;
 };
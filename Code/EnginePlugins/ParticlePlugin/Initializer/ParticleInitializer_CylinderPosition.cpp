@@ -1,6 +1,7 @@
 #include <ParticlePluginPCH.h>
 
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Math/Random.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
@@ -149,7 +150,7 @@ void ezParticleInitializer_CylinderPosition::CreateRequiredStreams()
 
   if (m_bSetVelocity)
   {
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, true);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, true);
   }
 }
 
@@ -160,7 +161,12 @@ void ezParticleInitializer_CylinderPosition::InitializeElements(ezUInt64 uiStart
   const ezVec3 startVel = GetOwnerSystem()->GetParticleStartVelocity();
 
   ezVec4* pPosition = m_pStreamPosition->GetWritableData<ezVec4>();
-  ezVec3* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<ezVec3>() : nullptr;
+
+  ezProcessingStreamSoA3f velocity;
+  if (m_bSetVelocity)
+  {
+    velocity = ezProcessingStreamSoA3f(m_pStreamVelocity);
+  }
 
   ezRandom& rng = GetRNG();
 
@@ -205,7 +211,7 @@ void ezParticleInitializer_CylinderPosition::InitializeElements(ezUInt64 uiStart
     {
       const float fSpeed = (float)rng.DoubleVariance(m_Speed.m_Value, m_Speed.m_fVariance);
 
-      pVelocity[i] = startVel + trans.m_qRotation * normalPos * fSpeed;
+      velocity.Set(i, startVel + trans.m_qRotation * normalPos * fSpeed);
     }
 
     pPosition[i] = (trans * pos).GetAsVec4(0);
@@ -1,6 +1,7 @@
 #include <ParticlePluginPCH.h>
 
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Math/Random.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
@@ -77,7 +78,7 @@ void ezParticleInitializerFactory_VelocityCone::QueryFinalizerDependencies(ezSet
 
 void ezParticleInitializer_VelocityCone::CreateRequiredStreams()
 {
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, true);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float3SoA, &m_pStreamVelocity, true);
 }
 
 void ezParticleInitializer_VelocityCone::InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
@@ -86,7 +87,7 @@ void ezParticleInitializer_VelocityCone::InitializeElements(ezUInt64 uiStartInde
 
   const ezVec3 startVel = GetOwnerSystem()->GetParticleStartVelocity();
 
-  ezVec3* pVelocity = m_pStreamVelocity->GetWritableData<ezVec3>();
+  const ezProcessingStreamSoA3f velocity(m_pStreamVelocity);
 
   ezRandom& rng = GetRNG();
 
@@ -113,7 +114,7 @@ void ezParticleInitializer_VelocityCone::InitializeElements(ezUInt64 uiStartInde
 
     const float fSpeed = (float)rng.DoubleVariance(m_Speed.m_Value, m_Speed.m_fVariance);
 
-    pVelocity[i] = startVel + GetOwnerSystem()->GetTransform().m_qRotation * dir * fSpeed;
+    velocity.Set(i, startVel + GetOwnerSystem()->GetTransform().m_qRotation * dir * fSpeed);
   }
 }
 
@@ -1,8 +1,27 @@
 #include <ParticlePluginPCH.h>
 
 #include <ParticlePlugin/Module/ParticleModule.h>
+#include <ParticlePlugin/System/ParticleSystemInstance.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParticleModule, 1, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
+
+void ezParticleModule::Process(ezUInt64 uiNumElements)
+{
+  EZ_ASSERT_DEBUG(HasKernel(), "Particle module '{0}' has neither a kernel nor overrides Process()", GetDynamicRTTI()->GetTypeName());
+
+  if (m_uiKernelPass != ezInvalidIndex)
+  {
+    m_pOwnerSystem->ProcessKernelPass(m_uiKernelPass, uiNumElements);
+    return;
+  }
+
+  // the kernel itself must not profile anything, it is called once per chunk when the pass is fused
+  EZ_PROFILE_SCOPE(GetDynamicRTTI()->GetTypeName());
+
+  BeginKernel(uiNumElements);
+  ProcessKernel(0, uiNumElements);
+  EndKernel();
+}
@@ -38,6 +38,12 @@ public:
   /// \brief Override this to cache world module pointers for later (through ezParticleWorldModule::GetCachedWorldModule()).
   virtual void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) {}
 
+  /// \brief Returns true if the module implements its per-particle update through BeginKernel(), ProcessKernel() and EndKernel().
+  ///
+  /// Kernels of modules that run directly after each other are fused by the owner ezParticleSystemInstance into a single pass,
+  /// which processes the particles in small chunks, so that each chunk stays in the cache while all kernels work on it.
+  virtual bool HasKernel() const { return false; }
+
 protected:
   /// \brief Called by Reset()
   virtual void OnReset() {}
@@ -53,9 +59,22 @@ protected:
     return EZ_SUCCESS;
   }
 
+  /// \brief Runs the kernel over all elements. For modules without a kernel this must be overridden.
+  virtual void Process(ezUInt64 uiNumElements) override;
+
+  /// \brief Called once per update before ProcessKernel(), to set up everything that is the same for all particles.
+  virtual void BeginKernel(ezUInt64 uiNumElements) {}
+
+  /// \brief Updates the given range of particles. uiStartIndex is always a multiple of ezProcessingStream::SoAPadding.
+  virtual void ProcessKernel(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) {}
+
+  /// \brief Called once per update after ProcessKernel() has been called for all particles.
+  virtual void EndKernel() {}
+
   ezRandom& GetRNG() const { return GetOwnerEffect()->GetRNG(); }
 
 private:
   ezParticleSystemInstance* m_pOwnerSystem;
   ezParticleStreamBinding m_StreamBinding;
+  ezUInt32 m_uiKernelPass = ezInvalidIndex; // index of the fused pass in the owner system, if the kernel is part of one
 };
@@ -73,11 +73,14 @@ void ezParticleStream::InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumE
   const ezUInt64 uiElementSize = m_pStream->GetElementSize();
   const ezUInt64 uiElementStride = m_pStream->GetElementStride();
 
-  for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+  for (ezUInt32 uiComponentArray = 0; uiComponentArray < m_pStream->GetNumComponentArrays(); ++uiComponentArray)
   {
-    ezMemoryUtils::ZeroFill<ezUInt8>(
-      static_cast<ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pStream->GetWritableData(), static_cast<ptrdiff_t>(i * uiElementStride))),
-      static_cast<size_t>(uiElementSize));
+    void* pArrayData = ezMemoryUtils::AddByteOffset(m_pStream->GetWritableData(), static_cast<ptrdiff_t>(uiComponentArray * m_pStream->GetComponentArrayStride()));
+
+    for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+    {
+      ezMemoryUtils::ZeroFill<ezUInt8>(static_cast<ezUInt8*>(ezMemoryUtils::AddByteOffset(pArrayData, static_cast<ptrdiff_t>(i * uiElementStride))), static_cast<size_t>(uiElementSize));
+    }
   }
 }
 
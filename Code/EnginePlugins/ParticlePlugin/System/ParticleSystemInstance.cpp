@@ -11,6 +11,7 @@
 #include <ParticlePlugin/Emitter/ParticleEmitter.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer.h>
 #include <ParticlePlugin/Initializer/ParticleInitializer.h>
+#include <ParticlePlugin/Module/ParticleModule.h>
 #include <ParticlePlugin/Streams/ParticleStream.h>
 #include <ParticlePlugin/System/ParticleSystemDescriptor.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
@@ -159,6 +160,103 @@ void ezParticleSystemInstance::Finalize()
   {
     pType->OnFinalize();
   }
+
+  SetupKernelPasses();
+}
+
+void ezParticleSystemInstance::SetupKernelPasses()
+{
+  // only behaviors, finalizers and types do any work in Process()
+  ezHybridArray<ezParticleModule*, 16> modules;
+
+  for (ezParticleModule* pModule : m_Behaviors)
+    modules.PushBack(pModule);
+  for (ezParticleModule* pModule : m_Finalizers)
+    modules.PushBack(pModule);
+  for (ezParticleModule* pModule : m_Types)
+    modules.PushBack(pModule);
+
+  for (ezParticleModule* pModule : modules)
+  {
+    pModule->m_uiKernelPass = ezInvalidIndex;
+  }
+
+  // the stream group executes modules with the same priority in no particular order,
+  // so kernels are sorted before the other modules with the same priority to get longer runs of kernels
+  struct ModuleComparer
+  {
+    EZ_ALWAYS_INLINE bool Less(const ezParticleModule* a, const ezParticleModule* b) const
+    {
+      if (a->m_fPriority != b->m_fPriority)
+        return a->m_fPriority < b->m_fPriority;
+
+      return a->HasKernel() && !b->HasKernel();
+    }
+  };
+
+  modules.Sort(ModuleComparer());
+
+  m_KernelPasses.Clear();
+
+  for (ezUInt32 uiFirst = 0; uiFirst < modules.GetCount();)
+  {
+    ezUInt32 uiEnd = uiFirst;
+    while (uiEnd < modules.GetCount() && modules[uiEnd]->HasKernel())
+    {
+      ++uiEnd;
+    }
+
+    // a single kernel is cheaper to run directly
+    if (uiEnd - uiFirst >= 2)
+    {
+      KernelPass& pass = m_KernelPasses.ExpandAndGetRef();
+
+      for (ezUInt32 i = uiFirst; i < uiEnd; ++i)
+      {
+        modules[i]->m_uiKernelPass = m_KernelPasses.GetCount() - 1;
+        pass.m_Modules.PushBack(modules[i]);
+      }
+    }
+
+    uiFirst = ezMath::Max(uiEnd, uiFirst + 1);
+  }
+}
+
+void ezParticleSystemInstance::ProcessKernelPass(ezUInt32 uiPass, ezUInt64 uiNumElements)
+{
+  KernelPass& pass = m_KernelPasses[uiPass];
+
+  // all modules of the pass call this, only the first one does the work
+  if (pass.m_bProcessed)
+    return;
+
+  pass.m_bProcessed = true;
+
+  EZ_PROFILE_SCOPE("PFX: Fused Kernels");
+
+  for (ezParticleModule* pModule : pass.m_Modules)
+  {
+    pModule->BeginKernel(uiNumElements);
+  }
+
+  // small enough that the data of all streams of one chunk stays in the L1 cache
+  constexpr ezUInt64 uiChunkSize = 256;
+  static_assert(uiChunkSize % ezProcessingStream::SoAPadding == 0, "Chunks have to start at a multiple of the SoA padding");
+
+  for (ezUInt64 uiStart = 0; uiStart < uiNumElements; uiStart += uiChunkSize)
+  {
+    const ezUInt64 uiCount = ezMath::Min(uiChunkSize, uiNumElements - uiStart);
+
+    for (ezParticleModule* pModule : pass.m_Modules)
+    {
+      pModule->ProcessKernel(uiStart, uiCount);
+    }
+  }
+
+  for (ezParticleModule* pModule : pass.m_Modules)
+  {
+    pModule->EndKernel();
+  }
 }
 
 void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDescriptor* pTemplate)
@@ -361,6 +459,7 @@ void ezParticleSystemInstance::Destruct()
   m_Behaviors.Clear();
   m_Finalizers.Clear();
   m_Types.Clear();
+  m_KernelPasses.Clear();
 
   m_StreamInfo.Clear();
 }
@@ -446,6 +545,11 @@ ezParticleSystemState::Enum ezParticleSystemInstance::Update(const ezTime& tDiff
     }
   }
 
+  for (KernelPass& pass : m_KernelPasses)
+  {
+    pass.m_bProcessed = false;
+  }
+
   {
     EZ_PROFILE_SCOPE("PFX: System Process");
     m_StreamGroup.Process();
@@ -74,6 +74,8 @@ public:
   float GetSpawnCountMultiplier() const { return m_fSpawnCountMultiplier; }
 
 private:
+  friend class ezParticleModule;
+
   bool IsEmitterConfigEqual(const ezParticleSystemDescriptor* pTemplate) const;
   bool IsInitializerConfigEqual(const ezParticleSystemDescriptor* pTemplate) const;
   bool IsBehaviorConfigEqual(const ezParticleSystemDescriptor* pTemplate) const;
@@ -82,6 +84,12 @@ private:
 
   void CreateStreamZeroInitializers();
 
+  /// \brief Groups the kernels of all behaviors and finalizers that run directly after each other into fused passes.
+  void SetupKernelPasses();
+
+  /// \brief Runs all kernels of the given pass chunk by chunk. Called by the first module of the pass that gets processed.
+  void ProcessKernelPass(ezUInt32 uiPass, ezUInt64 uiNumElements);
+
   ezHybridArray<ezParticleEmitter*, 2> m_Emitters;
   ezHybridArray<ezParticleInitializer*, 6> m_Initializers;
   ezHybridArray<ezParticleBehavior*, 6> m_Behaviors;
@@ -108,6 +116,14 @@ private:
 
   ezHybridArray<StreamInfo, 16> m_StreamInfo;
 
+  struct KernelPass
+  {
+    ezHybridArray<ezParticleModule*, 8> m_Modules;
+    bool m_bProcessed = false;
+  };
+
+  ezHybridArray<KernelPass, 2> m_KernelPasses;
+
   // culling data
   ezBoundingBoxSphere m_BoundingVolume;
 };
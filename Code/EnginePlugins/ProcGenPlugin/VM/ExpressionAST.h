@@ -42,6 +42,11 @@ public:
       LastBinary,
 
       // Ternary
+      FirstTernary,
+      MultiplyAdd, ///< First * Second + Third
+      Clamp,       ///< Clamps First to [Second, Third]. Second and Third must be constants.
+      LastTernary,
+
       Select,
 
       // Constant
@@ -60,6 +65,7 @@ public:
 
     static bool IsUnary(Enum nodeType);
     static bool IsBinary(Enum nodeType);
+    static bool IsTernary(Enum nodeType);
     static bool IsConstant(Enum nodeType);
     static bool IsInput(Enum nodeType);
     static bool IsOutput(Enum nodeType);
@@ -83,6 +89,13 @@ public:
     Node* m_pRightOperand = nullptr;
   };
 
+  struct TernaryOperator : public Node
+  {
+    Node* m_pFirstOperand = nullptr;
+    Node* m_pSecondOperand = nullptr;
+    Node* m_pThirdOperand = nullptr;
+  };
+
   struct Select : public Node
   {
     Node* m_pCondition = nullptr;
@@ -118,6 +131,7 @@ public:
 
   UnaryOperator* CreateUnaryOperator(NodeType::Enum type, Node* pOperand);
   BinaryOperator* CreateBinaryOperator(NodeType::Enum type, Node* pLeftOperand, Node* pRightOperand);
+  TernaryOperator* CreateTernaryOperator(NodeType::Enum type, Node* pFirstOperand, Node* pSecondOperand, Node* pThirdOperand);
   Select* CreateSelect(Node* pCondition, Node* pTrueOperand, Node* pFalseOperand);
   Constant* CreateConstant(const ezVariant& value);
   Input* CreateInput(const ezHashedString& sName);
@@ -56,6 +56,18 @@ public:
 
       Call,
 
+      // Ternary, generated by the compiler for common operation sequences
+      FirstTernary,
+
+      MulAdd_RRR,
+      MulAdd_CRR,
+      MulAdd_RRC,
+      MulAdd_CRC,
+
+      Clamp_RCC,
+
+      LastTernary,
+
       Count
     };
   };
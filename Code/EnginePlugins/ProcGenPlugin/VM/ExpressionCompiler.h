@@ -10,14 +10,34 @@ public:
   ezExpressionCompiler();
   ~ezExpressionCompiler();
 
-  ezResult Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode);
+  /// \brief Compiles the AST into byte code. Constant folding, subexpression elimination and fusing modify the AST and can be skipped with bOptimize.
+  ezResult Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode, bool bOptimize = true);
 
 private:
+  ezResult TransformAST(ezExpressionAST& ast);
   ezResult BuildNodeInstructions(const ezExpressionAST& ast);
   ezResult UpdateRegisterLifetime(const ezExpressionAST& ast);
   ezResult AssignRegisters();
   ezResult GenerateByteCode(const ezExpressionAST& ast, ezExpressionByteCode& out_byteCode);
 
+  ezExpressionAST::Node* FoldNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode);
+  ezExpressionAST::Node* FuseNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode);
+  ezExpressionAST::Node* DeduplicateNode(ezExpressionAST::Node* pNode);
+
+  typedef ezExpressionAST::Node* (ezExpressionCompiler::*TransformFunc)(ezExpressionAST& ast, ezExpressionAST::Node* pNode);
+  ezResult TransformNodes(ezExpressionAST& ast, TransformFunc func);
+
+  struct NodeStructureHasher
+  {
+    static ezUInt32 Hash(const ezExpressionAST::Node* pNode);
+    static bool Equal(const ezExpressionAST::Node* pNodeA, const ezExpressionAST::Node* pNodeB);
+  };
+
+  ezHybridArray<ezExpressionAST::Node*, 64> m_TransformStack;
+  ezHashTable<const ezExpressionAST::Node*, ezExpressionAST::Node*> m_TransformedNodes;
+  ezHashTable<const ezExpressionAST::Node*, ezExpressionAST::Node*, NodeStructureHasher> m_UniqueNodes;
+  ezHashTable<const ezExpressionAST::Node*, ezUInt32> m_NodeUseCount;
+
   ezHybridArray<const ezExpressionAST::Node*, 64> m_NodeStack;
   ezHybridArray<const ezExpressionAST::Node*, 64> m_NodeInstructions;
   ezHashTable<const ezExpressionAST::Node*, ezUInt32> m_NodeToRegisterIndex;
@@ -15,6 +15,12 @@ bool ezExpressionAST::NodeType::IsBinary(Enum nodeType)
   return nodeType > FirstBinary && nodeType < LastBinary;
 }
 
+// static
+bool ezExpressionAST::NodeType::IsTernary(Enum nodeType)
+{
+  return nodeType > FirstTernary && nodeType < LastTernary;
+}
+
 // static
 bool ezExpressionAST::NodeType::IsConstant(Enum nodeType)
 {
@@ -44,7 +50,7 @@ namespace
     "", "Add", "Subtract", "Multiply", "Divide", "Min", "Max", "",
 
     // Ternary
-    "Select",
+    "", "MultiplyAdd", "Clamp", "", "Select",
 
     // Constant
     "FloatConstant",
@@ -96,6 +102,17 @@ ezExpressionAST::BinaryOperator* ezExpressionAST::CreateBinaryOperator(NodeType:
   return pBinaryOperator;
 }
 
+ezExpressionAST::TernaryOperator* ezExpressionAST::CreateTernaryOperator(NodeType::Enum type, Node* pFirstOperand, Node* pSecondOperand, Node* pThirdOperand)
+{
+  auto pTernaryOperator = EZ_NEW(&m_Allocator, TernaryOperator);
+  pTernaryOperator->m_Type = type;
+  pTernaryOperator->m_pFirstOperand = pFirstOperand;
+  pTernaryOperator->m_pSecondOperand = pSecondOperand;
+  pTernaryOperator->m_pThirdOperand = pThirdOperand;
+
+  return pTernaryOperator;
+}
+
 ezExpressionAST::Constant* ezExpressionAST::CreateConstant(const ezVariant& value)
 {
   EZ_ASSERT_DEV(value.IsA<float>(), "value needs to be float");
@@ -149,6 +166,11 @@ ezArrayPtr<ezExpressionAST::Node*> ezExpressionAST::GetChildren(Node* pNode)
     auto& pChildren = static_cast<BinaryOperator*>(pNode)->m_pLeftOperand;
     return ezMakeArrayPtr(&pChildren, 2);
   }
+  else if (NodeType::IsTernary(nodeType))
+  {
+    auto& pChildren = static_cast<TernaryOperator*>(pNode)->m_pFirstOperand;
+    return ezMakeArrayPtr(&pChildren, 3);
+  }
   else if (NodeType::IsOutput(nodeType))
   {
     auto& pChild = static_cast<Output*>(pNode)->m_pExpression;
@@ -177,6 +199,11 @@ ezArrayPtr<const ezExpressionAST::Node*> ezExpressionAST::GetChildren(const Node
     auto& pChildren = static_cast<const BinaryOperator*>(pNode)->m_pLeftOperand;
     return ezMakeArrayPtr((const Node**)&pChildren, 2);
   }
+  else if (NodeType::IsTernary(nodeType))
+  {
+    auto& pChildren = static_cast<const TernaryOperator*>(pNode)->m_pFirstOperand;
+    return ezMakeArrayPtr((const Node**)&pChildren, 3);
+  }
   else if (NodeType::IsOutput(nodeType))
   {
     auto& pChild = static_cast<const Output*>(pNode)->m_pExpression;
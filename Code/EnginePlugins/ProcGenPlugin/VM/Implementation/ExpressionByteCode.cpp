@@ -58,6 +58,18 @@ namespace
     "",
 
     "Call",
+
+    // Ternary
+    "",
+
+    "MulAdd_RRR",
+    "MulAdd_CRR",
+    "MulAdd_RRC",
+    "MulAdd_CRC",
+
+    "Clamp_RCC",
+
+    "",
   };
 
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_ARRAY_SIZE(s_szOpCodeNames) == ezExpressionByteCode::OpCode::Count, "OpCode name array size does not match OpCode type count");
@@ -65,7 +77,30 @@ namespace
   static bool FirstArgIsConstant(ezExpressionByteCode::OpCode::Enum opCode)
   {
     return opCode == ezExpressionByteCode::OpCode::Mov_C || opCode == ezExpressionByteCode::OpCode::Add_CR || opCode == ezExpressionByteCode::OpCode::Sub_CR || opCode == ezExpressionByteCode::OpCode::Mul_CR || opCode == ezExpressionByteCode::OpCode::Div_CR ||
-           opCode == ezExpressionByteCode::OpCode::Min_CR || opCode == ezExpressionByteCode::OpCode::Max_CR;
+           opCode == ezExpressionByteCode::OpCode::Min_CR || opCode == ezExpressionByteCode::OpCode::Max_CR || opCode == ezExpressionByteCode::OpCode::MulAdd_CRR ||
+           opCode == ezExpressionByteCode::OpCode::MulAdd_CRC;
+  }
+
+  static bool SecondArgIsConstant(ezExpressionByteCode::OpCode::Enum opCode)
+  {
+    return opCode == ezExpressionByteCode::OpCode::Clamp_RCC;
+  }
+
+  static bool ThirdArgIsConstant(ezExpressionByteCode::OpCode::Enum opCode)
+  {
+    return opCode == ezExpressionByteCode::OpCode::MulAdd_RRC || opCode == ezExpressionByteCode::OpCode::MulAdd_CRC || opCode == ezExpressionByteCode::OpCode::Clamp_RCC;
+  }
+
+  static void AppendArg(ezStringBuilder& out_sDisassembly, ezUInt32 uiArg, bool bIsConstant)
+  {
+    if (bIsConstant)
+    {
+      out_sDisassembly.AppendFormat(" {0}", ezArgF(*reinterpret_cast<float*>(&uiArg), 6));
+    }
+    else
+    {
+      out_sDisassembly.AppendFormat(" r{0}", uiArg);
+    }
   }
 } // namespace
 
@@ -141,6 +176,19 @@ void ezExpressionByteCode::Disassemble(ezStringBuilder& out_sDisassembly) const
         out_sDisassembly.AppendFormat("{0} r{1} r{2} r{3}\n", szOpCode, r, a, b);
       }
     }
+    else if (opCode > OpCode::FirstTernary && opCode < OpCode::LastTernary)
+    {
+      ezUInt32 r = GetRegisterIndex(pByteCode, 1);
+      ezUInt32 a = GetRegisterIndex(pByteCode, 1);
+      ezUInt32 b = GetRegisterIndex(pByteCode, 1);
+      ezUInt32 c = GetRegisterIndex(pByteCode, 1);
+
+      out_sDisassembly.AppendFormat("{0} r{1}", szOpCode, r);
+      AppendArg(out_sDisassembly, a, FirstArgIsConstant(opCode));
+      AppendArg(out_sDisassembly, b, SecondArgIsConstant(opCode));
+      AppendArg(out_sDisassembly, c, ThirdArgIsConstant(opCode));
+      out_sDisassembly.Append("\n");
+    }
     else if (opCode == OpCode::Call)
     {
       ezUInt32 uiIndex = GetFunctionIndex(pByteCode);
@@ -45,13 +45,148 @@ namespace
         return ezExpressionByteCode::OpCode::FirstUnary;
     }
   }
+
+  static float GetConstantValue(const ezExpressionAST::Node* pNode)
+  {
+    EZ_ASSERT_DEV(pNode->m_Type == ezExpressionAST::NodeType::FloatConstant, "Only floats are supported");
+    return static_cast<const ezExpressionAST::Constant*>(pNode)->m_Value.Get<float>();
+  }
+
+  static ezUInt32 GetConstantValueBits(const ezExpressionAST::Node* pNode)
+  {
+    float fValue = GetConstantValue(pNode);
+    return *reinterpret_cast<ezUInt32*>(&fValue);
+  }
+
+  static bool IsInlinedConstant(const ezExpressionAST::Node* pNode, ezUInt32 uiOperandIndex)
+  {
+    const ezExpressionAST::Node* pOperand = ezExpressionAST::GetChildren(pNode)[uiOperandIndex];
+    if (pOperand == nullptr || !ezExpressionAST::NodeType::IsConstant(pOperand->m_Type))
+      return false;
+
+    // These are the operands that have an instruction variant that takes a constant in place,
+    // see the _C variants of the op codes in ezExpressionByteCode.
+    ezExpressionAST::NodeType::Enum nodeType = pNode->m_Type;
+    if (ezExpressionAST::NodeType::IsBinary(nodeType))
+      return uiOperandIndex == 0;
+    if (nodeType == ezExpressionAST::NodeType::MultiplyAdd)
+      return uiOperandIndex != 1;
+    if (nodeType == ezExpressionAST::NodeType::Clamp)
+      return uiOperandIndex != 0;
+
+    return false;
+  }
+
+  static float EvaluateUnaryOperator(ezExpressionAST::NodeType::Enum nodeType, float x)
+  {
+    switch (nodeType)
+    {
+      case ezExpressionAST::NodeType::Negate:
+        return -x;
+      case ezExpressionAST::NodeType::Absolute:
+        return ezMath::Abs(x);
+      case ezExpressionAST::NodeType::Sqrt:
+        return ezMath::Sqrt(x);
+      case ezExpressionAST::NodeType::Sin:
+        return ezMath::Sin(ezAngle::Radian(x));
+      case ezExpressionAST::NodeType::Cos:
+        return ezMath::Cos(ezAngle::Radian(x));
+      case ezExpressionAST::NodeType::Tan:
+        return ezMath::Tan(ezAngle::Radian(x));
+      case ezExpressionAST::NodeType::ASin:
+        return ezMath::ASin(x).GetRadian();
+      case ezExpressionAST::NodeType::ACos:
+        return ezMath::ACos(x).GetRadian();
+      case ezExpressionAST::NodeType::ATan:
+        return ezMath::ATan(x).GetRadian();
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        return 0.0f;
+    }
+  }
+
+  static float EvaluateBinaryOperator(ezExpressionAST::NodeType::Enum nodeType, float a, float b)
+  {
+    switch (nodeType)
+    {
+      case ezExpressionAST::NodeType::Add:
+        return a + b;
+      case ezExpressionAST::NodeType::Subtract:
+        return a - b;
+      case ezExpressionAST::NodeType::Multiply:
+        return a * b;
+      case ezExpressionAST::NodeType::Divide:
+        return a / b;
+      case ezExpressionAST::NodeType::Min:
+        return ezMath::Min(a, b);
+      case ezExpressionAST::NodeType::Max:
+        return ezMath::Max(a, b);
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        return 0.0f;
+    }
+  }
 } // namespace
 
+// static
+ezUInt32 ezExpressionCompiler::NodeStructureHasher::Hash(const ezExpressionAST::Node* pNode)
+{
+  ezUInt32 uiHash = pNode->m_Type.GetValue();
+
+  ezExpressionAST::NodeType::Enum nodeType = pNode->m_Type;
+  if (ezExpressionAST::NodeType::IsConstant(nodeType))
+  {
+    ezUInt32 uiValue = GetConstantValueBits(pNode);
+    uiHash = ezHashingUtils::xxHash32(&uiValue, sizeof(uiValue), uiHash);
+  }
+  else if (ezExpressionAST::NodeType::IsInput(nodeType))
+  {
+    ezUInt64 uiNameHash = static_cast<const ezExpressionAST::Input*>(pNode)->m_sName.GetHash();
+    uiHash = ezHashingUtils::xxHash32(&uiNameHash, sizeof(uiNameHash), uiHash);
+  }
+  else if (nodeType == ezExpressionAST::NodeType::FunctionCall)
+  {
+    ezUInt64 uiNameHash = static_cast<const ezExpressionAST::FunctionCall*>(pNode)->m_sName.GetHash();
+    uiHash = ezHashingUtils::xxHash32(&uiNameHash, sizeof(uiNameHash), uiHash);
+  }
+
+  // Children are already unique at this point so comparing their pointers is sufficient
+  auto children = ezExpressionAST::GetChildren(pNode);
+  return ezHashingUtils::xxHash32(children.GetPtr(), children.GetCount() * sizeof(const ezExpressionAST::Node*), uiHash);
+}
+
+// static
+bool ezExpressionCompiler::NodeStructureHasher::Equal(const ezExpressionAST::Node* pNodeA, const ezExpressionAST::Node* pNodeB)
+{
+  if (pNodeA->m_Type != pNodeB->m_Type)
+    return false;
+
+  ezExpressionAST::NodeType::Enum nodeType = pNodeA->m_Type;
+  if (ezExpressionAST::NodeType::IsConstant(nodeType))
+  {
+    return GetConstantValueBits(pNodeA) == GetConstantValueBits(pNodeB);
+  }
+  else if (ezExpressionAST::NodeType::IsInput(nodeType))
+  {
+    return static_cast<const ezExpressionAST::Input*>(pNodeA)->m_sName == static_cast<const ezExpressionAST::Input*>(pNodeB)->m_sName;
+  }
+  else if (nodeType == ezExpressionAST::NodeType::FunctionCall)
+  {
+    if (static_cast<const ezExpressionAST::FunctionCall*>(pNodeA)->m_sName != static_cast<const ezExpressionAST::FunctionCall*>(pNodeB)->m_sName)
+      return false;
+  }
+
+  return ezExpressionAST::GetChildren(pNodeA) == ezExpressionAST::GetChildren(pNodeB);
+}
+
 ezExpressionCompiler::ezExpressionCompiler() = default;
 ezExpressionCompiler::~ezExpressionCompiler() = default;
 
-ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode)
+ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode, bool bOptimize /*= true*/)
 {
+  if (bOptimize && TransformAST(ast).Failed())
+    return EZ_FAILURE;
+
   if (BuildNodeInstructions(ast).Failed())
     return EZ_FAILURE;
 
@@ -67,6 +202,272 @@ ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCod
   return EZ_SUCCESS;
 }
 
+ezResult ezExpressionCompiler::TransformAST(ezExpressionAST& ast)
+{
+  // Constant folding, canonicalization and common subexpression elimination in one bottom up pass.
+  m_UniqueNodes.Clear();
+  if (TransformNodes(ast, &ezExpressionCompiler::FoldNode).Failed())
+    return EZ_FAILURE;
+
+  // Count the users of each node, an operation can only be fused into its user if that is the only one.
+  m_NodeUseCount.Clear();
+  for (const ezExpressionAST::Node* pOutputNode : ast.m_OutputNodes)
+  {
+    if (pOutputNode == nullptr)
+      continue;
+
+    EZ_ASSERT_DEV(m_NodeStack.IsEmpty(), "Implementation error");
+
+    m_NodeStack.PushBack(pOutputNode);
+
+    while (!m_NodeStack.IsEmpty())
+    {
+      auto pCurrentNode = m_NodeStack.PeekBack();
+      m_NodeStack.PopBack();
+
+      auto children = ezExpressionAST::GetChildren(pCurrentNode);
+      for (auto pChild : children)
+      {
+        ezUInt32& uiUseCount = m_NodeUseCount[pChild];
+        if (uiUseCount == 0)
+        {
+          m_NodeStack.PushBack(pChild);
+        }
+
+        ++uiUseCount;
+      }
+    }
+  }
+
+  // Nodes that became unreachable from the outputs are never visited again in BuildNodeInstructions,
+  // so this also takes care of dead code elimination.
+  return TransformNodes(ast, &ezExpressionCompiler::FuseNode);
+}
+
+ezResult ezExpressionCompiler::TransformNodes(ezExpressionAST& ast, TransformFunc func)
+{
+  m_TransformStack.Clear();
+  m_TransformedNodes.Clear();
+
+  for (ezExpressionAST::Output* pOutputNode : ast.m_OutputNodes)
+  {
+    if (pOutputNode == nullptr)
+      continue;
+
+    m_TransformStack.PushBack(pOutputNode->m_pExpression);
+
+    // Post order traversal, the children of a node are replaced by their transformed version before the node itself is transformed.
+    while (!m_TransformStack.IsEmpty())
+    {
+      auto pCurrentNode = m_TransformStack.PeekBack();
+
+      if (pCurrentNode == nullptr)
+      {
+        return EZ_FAILURE;
+      }
+
+      if (m_TransformedNodes.Contains(pCurrentNode))
+      {
+        m_TransformStack.PopBack();
+        continue;
+      }
+
+      bool bChildrenTransformed = true;
+
+      auto children = ezExpressionAST::GetChildren(pCurrentNode);
+      for (auto pChild : children)
+      {
+        if (pChild == nullptr || !m_TransformedNodes.Contains(pChild))
+        {
+          m_TransformStack.PushBack(pChild);
+          bChildrenTransformed = false;
+        }
+      }
+
+      if (bChildrenTransformed)
+      {
+        m_TransformStack.PopBack();
+
+        for (auto& pChild : children)
+        {
+          pChild = m_TransformedNodes[pChild];
+        }
+
+        m_TransformedNodes.Insert(pCurrentNode, (this->*func)(ast, pCurrentNode));
+      }
+    }
+
+    pOutputNode->m_pExpression = m_TransformedNodes[pOutputNode->m_pExpression];
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezExpressionAST::Node* ezExpressionCompiler::FoldNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode)
+{
+  ezExpressionAST::NodeType::Enum nodeType = pNode->m_Type;
+
+  if (ezExpressionAST::NodeType::IsUnary(nodeType))
+  {
+    auto pUnary = static_cast<ezExpressionAST::UnaryOperator*>(pNode);
+    if (ezExpressionAST::NodeType::IsConstant(pUnary->m_pOperand->m_Type))
+    {
+      float fValue = EvaluateUnaryOperator(nodeType, GetConstantValue(pUnary->m_pOperand));
+      return DeduplicateNode(ast.CreateConstant(fValue));
+    }
+
+    if (nodeType == ezExpressionAST::NodeType::Negate)
+    {
+      // There is no negate instruction, 0 - x is a single Sub_CR instruction.
+      auto pZero = DeduplicateNode(ast.CreateConstant(0.0f));
+      pNode = ast.CreateBinaryOperator(ezExpressionAST::NodeType::Subtract, pZero, pUnary->m_pOperand);
+    }
+  }
+  else if (ezExpressionAST::NodeType::IsBinary(nodeType))
+  {
+    auto pBinary = static_cast<ezExpressionAST::BinaryOperator*>(pNode);
+    const bool bLeftIsConstant = ezExpressionAST::NodeType::IsConstant(pBinary->m_pLeftOperand->m_Type);
+    const bool bRightIsConstant = ezExpressionAST::NodeType::IsConstant(pBinary->m_pRightOperand->m_Type);
+
+    if (bLeftIsConstant && bRightIsConstant)
+    {
+      float fValue = EvaluateBinaryOperator(nodeType, GetConstantValue(pBinary->m_pLeftOperand), GetConstantValue(pBinary->m_pRightOperand));
+      return DeduplicateNode(ast.CreateConstant(fValue));
+    }
+
+    if (bRightIsConstant)
+    {
+      // Move constants to the left side so the instruction can take them in place instead of needing a separate mov instruction.
+      float fRightValue = GetConstantValue(pBinary->m_pRightOperand);
+
+      if (nodeType == ezExpressionAST::NodeType::Subtract)
+      {
+        auto pConstant = DeduplicateNode(ast.CreateConstant(-fRightValue));
+        pBinary = ast.CreateBinaryOperator(ezExpressionAST::NodeType::Add, pConstant, pBinary->m_pLeftOperand);
+      }
+      else if (nodeType == ezExpressionAST::NodeType::Divide)
+      {
+        if (fRightValue != 0.0f)
+        {
+          auto pConstant = DeduplicateNode(ast.CreateConstant(1.0f / fRightValue));
+          pBinary = ast.CreateBinaryOperator(ezExpressionAST::NodeType::Multiply, pConstant, pBinary->m_pLeftOperand);
+        }
+      }
+      else
+      {
+        // All other binary operators are commutative
+        pBinary = ast.CreateBinaryOperator(nodeType, pBinary->m_pRightOperand, pBinary->m_pLeftOperand);
+      }
+
+      nodeType = pBinary->m_Type;
+    }
+
+    // Remove operations that don't change the value
+    if (ezExpressionAST::NodeType::IsConstant(pBinary->m_pLeftOperand->m_Type))
+    {
+      float fLeftValue = GetConstantValue(pBinary->m_pLeftOperand);
+
+      if ((nodeType == ezExpressionAST::NodeType::Add && fLeftValue == 0.0f) || (nodeType == ezExpressionAST::NodeType::Multiply && fLeftValue == 1.0f))
+      {
+        return pBinary->m_pRightOperand;
+      }
+    }
+
+    pNode = pBinary;
+  }
+
+  return DeduplicateNode(pNode);
+}
+
+ezExpressionAST::Node* ezExpressionCompiler::FuseNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode)
+{
+  auto IsSingleUse = [&](const ezExpressionAST::Node* pOperand, ezExpressionAST::NodeType::Enum operandType) {
+    ezUInt32 uiUseCount = 0;
+    return pOperand->m_Type == operandType && m_NodeUseCount.TryGetValue(pOperand, uiUseCount) && uiUseCount == 1;
+  };
+
+  ezExpressionAST::NodeType::Enum nodeType = pNode->m_Type;
+
+  if (nodeType == ezExpressionAST::NodeType::Add)
+  {
+    // a * b + c => MulAdd, constants are on the left side so the multiplication is usually the right operand
+    auto pAdd = static_cast<ezExpressionAST::BinaryOperator*>(pNode);
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      ezExpressionAST::Node* pMulOperand = i == 0 ? pAdd->m_pRightOperand : pAdd->m_pLeftOperand;
+      ezExpressionAST::Node* pAddOperand = i == 0 ? pAdd->m_pLeftOperand : pAdd->m_pRightOperand;
+
+      if (IsSingleUse(pMulOperand, ezExpressionAST::NodeType::Multiply))
+      {
+        auto pMul = static_cast<ezExpressionAST::BinaryOperator*>(pMulOperand);
+        return ast.CreateTernaryOperator(ezExpressionAST::NodeType::MultiplyAdd, pMul->m_pLeftOperand, pMul->m_pRightOperand, pAddOperand);
+      }
+    }
+  }
+  else if (nodeType == ezExpressionAST::NodeType::Multiply)
+  {
+    // k1 * (k2 + x) => MulAdd(k1, x, k1 * k2) and k1 * (k2 - x) => MulAdd(-k1, x, k1 * k2), typical for remapping a value to another range.
+    // This changes the rounding slightly compared to the separate operations.
+    auto pMul = static_cast<ezExpressionAST::BinaryOperator*>(pNode);
+    ezExpressionAST::Node* pInner = pMul->m_pRightOperand;
+
+    if (ezExpressionAST::NodeType::IsConstant(pMul->m_pLeftOperand->m_Type) &&
+        (IsSingleUse(pInner, ezExpressionAST::NodeType::Add) || IsSingleUse(pInner, ezExpressionAST::NodeType::Subtract)))
+    {
+      auto pInnerBinary = static_cast<ezExpressionAST::BinaryOperator*>(pInner);
+      if (ezExpressionAST::NodeType::IsConstant(pInnerBinary->m_pLeftOperand->m_Type))
+      {
+        const float fScale = GetConstantValue(pMul->m_pLeftOperand);
+        const float fOffset = fScale * GetConstantValue(pInnerBinary->m_pLeftOperand);
+        const bool bNegate = pInner->m_Type == ezExpressionAST::NodeType::Subtract;
+
+        auto pScale = DeduplicateNode(ast.CreateConstant(bNegate ? -fScale : fScale));
+        auto pOffset = DeduplicateNode(ast.CreateConstant(fOffset));
+        return ast.CreateTernaryOperator(ezExpressionAST::NodeType::MultiplyAdd, pScale, pInnerBinary->m_pRightOperand, pOffset);
+      }
+    }
+  }
+  else if (nodeType == ezExpressionAST::NodeType::Min || nodeType == ezExpressionAST::NodeType::Max)
+  {
+    // Min(hi, Max(lo, x)) and Max(lo, Min(hi, x)) with constant bounds => Clamp
+    auto pOuter = static_cast<ezExpressionAST::BinaryOperator*>(pNode);
+    const ezExpressionAST::NodeType::Enum innerType = nodeType == ezExpressionAST::NodeType::Min ? ezExpressionAST::NodeType::Max : ezExpressionAST::NodeType::Min;
+
+    if (ezExpressionAST::NodeType::IsConstant(pOuter->m_pLeftOperand->m_Type) && IsSingleUse(pOuter->m_pRightOperand, innerType))
+    {
+      auto pInner = static_cast<ezExpressionAST::BinaryOperator*>(pOuter->m_pRightOperand);
+      if (ezExpressionAST::NodeType::IsConstant(pInner->m_pLeftOperand->m_Type))
+      {
+        ezExpressionAST::Node* pMin = nodeType == ezExpressionAST::NodeType::Min ? pInner->m_pLeftOperand : pOuter->m_pLeftOperand;
+        ezExpressionAST::Node* pMax = nodeType == ezExpressionAST::NodeType::Min ? pOuter->m_pLeftOperand : pInner->m_pLeftOperand;
+
+        // Only equivalent if the range is not empty
+        if (GetConstantValue(pMin) <= GetConstantValue(pMax))
+        {
+          return ast.CreateTernaryOperator(ezExpressionAST::NodeType::Clamp, pInner->m_pRightOperand, pMin, pMax);
+        }
+      }
+    }
+  }
+
+  return pNode;
+}
+
+ezExpressionAST::Node* ezExpressionCompiler::DeduplicateNode(ezExpressionAST::Node* pNode)
+{
+  // Select has no children accessor and can't be compared structurally. Function calls are deduplicated as well,
+  // since all expression functions only depend on their arguments and the global data.
+  if (pNode->m_Type == ezExpressionAST::NodeType::Select)
+    return pNode;
+
+  ezExpressionAST::Node* pUniqueNode = nullptr;
+  if (m_UniqueNodes.TryGetValue(pNode, pUniqueNode))
+    return pUniqueNode;
+
+  m_UniqueNodes.Insert(pNode, pNode);
+  return pNode;
+}
+
 ezResult ezExpressionCompiler::BuildNodeInstructions(const ezExpressionAST& ast)
 {
   m_NodeStack.Clear();
@@ -94,25 +495,13 @@ ezResult ezExpressionCompiler::BuildNodeInstructions(const ezExpressionAST& ast)
 
       m_NodeStack.PushBack(pCurrentNode);
 
-      if (ezExpressionAST::NodeType::IsBinary(pCurrentNode->m_Type))
+      auto children = ezExpressionAST::GetChildren(pCurrentNode);
+      for (ezUInt32 i = 0; i < children.GetCount(); ++i)
       {
-        // Do not push the left operand if it is a constant, we don't want a separate mov instruction for it
-        // since all binary operators can take a constant as left operand in place.
-        auto pBinary = static_cast<const ezExpressionAST::BinaryOperator*>(pCurrentNode);
-        bool bLeftIsConstant = ezExpressionAST::NodeType::IsConstant(pBinary->m_pLeftOperand->m_Type);
-        if (!bLeftIsConstant)
+        // Do not push constants that the instruction can take in place, we don't want a separate mov instruction for them.
+        if (!IsInlinedConstant(pCurrentNode, i))
         {
-          m_NodeInstructions.PushBack(pBinary->m_pLeftOperand);
-        }
-
-        m_NodeInstructions.PushBack(pBinary->m_pRightOperand);
-      }
-      else
-      {
-        auto children = ezExpressionAST::GetChildren(pCurrentNode);
-        for (auto pChild : children)
-        {
-          m_NodeInstructions.PushBack(pChild);
+          m_NodeInstructions.PushBack(children[i]);
         }
       }
     }
@@ -160,8 +549,12 @@ ezResult ezExpressionCompiler::UpdateRegisterLifetime(const ezExpressionAST& ast
     auto pCurrentNode = m_NodeInstructions[uiInstructionIndex];
 
     auto children = ezExpressionAST::GetChildren(pCurrentNode);
-    for (auto pChild : children)
+    for (ezUInt32 i = 0; i < children.GetCount(); ++i)
     {
+      if (IsInlinedConstant(pCurrentNode, i))
+        continue;
+
+      auto pChild = children[i];
       ezUInt32 uiRegisterIndex = ezInvalidIndex;
       if (m_NodeToRegisterIndex.TryGetValue(pChild, uiRegisterIndex))
       {
@@ -194,6 +587,10 @@ ezResult ezExpressionCompiler::AssignRegisters()
 
   for (auto& liveInterval : m_LiveIntervals)
   {
+    // Outputs don't write to a register
+    if (ezExpressionAST::NodeType::IsOutput(liveInterval.m_pNode->m_Type))
+      continue;
+
     // Expire old intervals
     for (ezUInt32 uiActiveIndex = activeIntervals.GetCount(); uiActiveIndex-- > 0;)
     {
@@ -241,10 +638,13 @@ ezResult ezExpressionCompiler::GenerateByteCode(const ezExpressionAST& ast, ezEx
 
   for (auto pCurrentNode : m_NodeInstructions)
   {
-    ezUInt32 uiTargetRegister = m_NodeToRegisterIndex[pCurrentNode];
-    uiMaxRegisterIndex = ezMath::Max(uiMaxRegisterIndex, uiTargetRegister);
-
     ezExpressionAST::NodeType::Enum nodeType = pCurrentNode->m_Type;
+
+    ezUInt32 uiTargetRegister = m_NodeToRegisterIndex[pCurrentNode];
+    if (!ezExpressionAST::NodeType::IsOutput(nodeType))
+    {
+      uiMaxRegisterIndex = ezMath::Max(uiMaxRegisterIndex, uiTargetRegister);
+    }
     if (ezExpressionAST::NodeType::IsUnary(nodeType))
     {
       auto pUnary = static_cast<const ezExpressionAST::UnaryOperator*>(pCurrentNode);
@@ -256,7 +656,7 @@ ezResult ezExpressionCompiler::GenerateByteCode(const ezExpressionAST& ast, ezEx
     else if (ezExpressionAST::NodeType::IsBinary(nodeType))
     {
       auto pBinary = static_cast<const ezExpressionAST::BinaryOperator*>(pCurrentNode);
-      bool bLeftIsConstant = ezExpressionAST::NodeType::IsConstant(pBinary->m_pLeftOperand->m_Type);
+      bool bLeftIsConstant = IsInlinedConstant(pCurrentNode, 0);
       ezExpressionByteCode::OpCode::Enum opCode = NodeTypeToOpCode(nodeType);
       ezUInt32 uiConstantValue = 0;
 
@@ -265,8 +665,7 @@ ezResult ezExpressionCompiler::GenerateByteCode(const ezExpressionAST& ast, ezEx
         // Op code for constant register combination is always +1 of regular op code.
         opCode = static_cast<ezExpressionByteCode::OpCode::Enum>(opCode + 1);
 
-        auto pConstant = static_cast<const ezExpressionAST::Constant*>(pBinary->m_pLeftOperand);
-        uiConstantValue = *reinterpret_cast<const ezUInt32*>(&pConstant->m_Value.Get<float>());
+        uiConstantValue = GetConstantValueBits(pBinary->m_pLeftOperand);
       }
 
       byteCode.PushBack(opCode);
@@ -274,6 +673,31 @@ ezResult ezExpressionCompiler::GenerateByteCode(const ezExpressionAST& ast, ezEx
       byteCode.PushBack(bLeftIsConstant ? uiConstantValue : m_NodeToRegisterIndex[pBinary->m_pLeftOperand]);
       byteCode.PushBack(m_NodeToRegisterIndex[pBinary->m_pRightOperand]);
     }
+    else if (ezExpressionAST::NodeType::IsTernary(nodeType))
+    {
+      auto operands = ezExpressionAST::GetChildren(pCurrentNode);
+      ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::OpCode::MulAdd_RRR;
+
+      if (nodeType == ezExpressionAST::NodeType::MultiplyAdd)
+      {
+        // The variants with constants follow MulAdd_RRR in the order CRR, RRC, CRC.
+        ezUInt32 uiVariant = (IsInlinedConstant(pCurrentNode, 0) ? 1 : 0) + (IsInlinedConstant(pCurrentNode, 2) ? 2 : 0);
+        opCode = static_cast<ezExpressionByteCode::OpCode::Enum>(opCode + uiVariant);
+      }
+      else
+      {
+        EZ_ASSERT_DEV(nodeType == ezExpressionAST::NodeType::Clamp, "Unknown ternary operator");
+        EZ_ASSERT_DEV(IsInlinedConstant(pCurrentNode, 1) && IsInlinedConstant(pCurrentNode, 2), "Clamp bounds must be constants");
+        opCode = ezExpressionByteCode::OpCode::Clamp_RCC;
+      }
+
+      byteCode.PushBack(opCode);
+      byteCode.PushBack(uiTargetRegister);
+      for (ezUInt32 i = 0; i < 3; ++i)
+      {
+        byteCode.PushBack(IsInlinedConstant(pCurrentNode, i) ? GetConstantValueBits(operands[i]) : m_NodeToRegisterIndex[operands[i]]);
+      }
+    }
     else if (ezExpressionAST::NodeType::IsConstant(nodeType))
     {
       EZ_ASSERT_DEV(nodeType == ezExpressionAST::NodeType::FloatConstant, "Only floats are supported");
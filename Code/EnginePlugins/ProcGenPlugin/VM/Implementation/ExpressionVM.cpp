@@ -6,6 +6,9 @@
 
 namespace
 {
+  // 1024 instances per batch, which keeps the temp registers of typical expressions within the L2 cache
+  static constexpr ezUInt32 s_uiMaxNumRegistersPerBatch = 256;
+
   //#define DEBUG_VM
 
 #ifdef DEBUG_VM
@@ -24,9 +27,10 @@ namespace
 
     while (r != re)
     {
-      *r = func(*x);
-      ++r;
-      ++x;
+      r[0] = func(x[0]);
+      r[1] = func(x[1]);
+      r += 2;
+      x += 2;
     }
   }
 
@@ -40,8 +44,9 @@ namespace
 
     while (r != re)
     {
-      *r = func(x);
-      ++r;
+      r[0] = func(x);
+      r[1] = func(x);
+      r += 2;
     }
   }
 
@@ -56,10 +61,11 @@ namespace
 
     while (r != re)
     {
-      *r = func(*a, *b);
-      ++r;
-      ++a;
-      ++b;
+      r[0] = func(a[0], b[0]);
+      r[1] = func(a[1], b[1]);
+      r += 2;
+      a += 2;
+      b += 2;
     }
   }
 
@@ -74,16 +80,57 @@ namespace
 
     while (r != re)
     {
-      *r = func(a, *b);
-      ++r;
-      ++b;
+      r[0] = func(a, b[0]);
+      r[1] = func(a, b[1]);
+      r += 2;
+      b += 2;
+    }
+  }
+
+  struct VMRegisterOperand
+  {
+    VM_INLINE VMRegisterOperand(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters)
+      : m_pRegister(pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters))
+    {
+    }
+
+    VM_INLINE const ezSimdVec4f& operator[](ezUInt32 uiIndex) const { return m_pRegister[uiIndex]; }
+
+    const ezSimdVec4f* m_pRegister;
+  };
+
+  struct VMConstantOperand
+  {
+    VM_INLINE VMConstantOperand(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters)
+      : m_Constant(ezExpressionByteCode::GetConstant(pByteCode))
+    {
+    }
+
+    VM_INLINE const ezSimdVec4f& operator[](ezUInt32 uiIndex) const { return m_Constant; }
+
+    ezSimdVec4f m_Constant;
+  };
+
+  template <typename A, typename B, typename C, typename Func>
+  VM_INLINE void VMOperation3(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
+  {
+    ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
+
+    A a(pByteCode, pRegisters, uiNumRegisters);
+    B b(pByteCode, pRegisters, uiNumRegisters);
+    C c(pByteCode, pRegisters, uiNumRegisters);
+
+    for (ezUInt32 i = 0; i < uiNumRegisters; i += 2)
+    {
+      r[i] = func(a[i], b[i], c[i]);
+      r[i + 1] = func(a[i + 1], b[i + 1], c[i + 1]);
     }
   }
 
   VM_INLINE float ReadInputData(const ezUInt8* pData) { return *reinterpret_cast<const float*>(pData); }
 
   void VMLoadInput(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters,
-    ezArrayPtr<const ezExpression::Stream> inputs, ezArrayPtr<ezUInt32> inputMapping)
+    ezArrayPtr<const ezExpression::Stream> inputs, ezArrayPtr<ezUInt32> inputMapping, ezUInt32 uiFirstInstance)
   {
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
     ezSimdVec4f* re = r + uiNumRegisters;
@@ -94,6 +141,7 @@ namespace
     ezUInt32 uiByteStride = input.m_uiByteStride;
     const ezUInt8* pInputData = input.m_Data.GetPtr();
     const ezUInt8* pInputDataEnd = pInputData + input.m_Data.GetCount() - uiByteStride;
+    pInputData += uiFirstInstance * uiByteStride;
 
     while (r != re)
     {
@@ -114,7 +162,7 @@ namespace
   VM_INLINE void StoreOutputData(ezUInt8* pData, float fData) { *reinterpret_cast<float*>(pData) = fData; }
 
   void VMStoreOutput(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters,
-    ezArrayPtr<ezExpression::Stream> outputs, ezArrayPtr<ezUInt32> outputMapping)
+    ezArrayPtr<ezExpression::Stream> outputs, ezArrayPtr<ezUInt32> outputMapping, ezUInt32 uiFirstInstance)
   {
     ezUInt32 uiOutputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode, 1);
     uiOutputIndex = outputMapping[uiOutputIndex];
@@ -122,6 +170,7 @@ namespace
     ezUInt32 uiByteStride = output.m_uiByteStride;
     ezUInt8* pOutputData = output.m_Data.GetPtr();
     ezUInt8* pOutputDataEnd = pOutputData + output.m_Data.GetCount() - uiByteStride;
+    pOutputData += uiFirstInstance * uiByteStride;
 
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
     ezSimdVec4f* re = r + uiNumRegisters;
@@ -340,136 +389,169 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
     }
   }
 
-  const ezUInt32 uiNumRegisters = (uiNumInstances + 3) / 4;
-  const ezUInt32 uiLastInstanceIndex = uiNumInstances - 1;
+  // Two registers are processed per loop iteration, so the register count is always even.
+  const ezUInt32 uiTotalNumRegisters = ((uiNumInstances + 7) / 8) * 2;
+  const ezUInt32 uiMaxNumRegisters = ezMath::Min(uiTotalNumRegisters, s_uiMaxNumRegistersPerBatch);
 
-  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * uiNumRegisters;
-  m_Registers.SetCountUninitialized(uiTotalNumRegisters);
+  m_Registers.SetCountUninitialized(byteCode.GetNumTempRegisters() * uiMaxNumRegisters);
 
   ezSimdVec4f* pRegisters = m_Registers.GetData();
 
-  // Execute bytecode
-  const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCode();
-  const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
-
-  while (pByteCode < pByteCodeEnd)
+  // Execute bytecode in batches so all temp registers of a batch stay in the cache
+  for (ezUInt32 uiFirstRegister = 0; uiFirstRegister < uiTotalNumRegisters; uiFirstRegister += uiMaxNumRegisters)
   {
-    ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+    const ezUInt32 uiNumRegisters = ezMath::Min(uiMaxNumRegisters, uiTotalNumRegisters - uiFirstRegister);
+    const ezUInt32 uiFirstInstance = uiFirstRegister * 4;
+
+    const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCode();
+    const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
 
-    switch (opCode)
+    while (pByteCode < pByteCodeEnd)
     {
-        // unary
-      case ezExpressionByteCode::OpCode::Abs_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.Abs(); });
-        break;
+      ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
 
-      case ezExpressionByteCode::OpCode::Sqrt_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.GetSqrt(); });
-        break;
+      switch (opCode)
+      {
+          // unary
+        case ezExpressionByteCode::OpCode::Abs_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.Abs(); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sin_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Sin(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Sqrt_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.GetSqrt(); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Cos_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Cos(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Sin_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Sin(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Tan_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Tan(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Cos_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Cos(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::ASin_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ASin(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Tan_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Tan(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::ACos_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ACos(x); });
-        break;
+        case ezExpressionByteCode::OpCode::ASin_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ASin(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::ATan_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ATan(x); });
-        break;
+        case ezExpressionByteCode::OpCode::ACos_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ACos(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
-        break;
+        case ezExpressionByteCode::OpCode::ATan_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ATan(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_C:
-        VMOperation1_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
-        break;
+        case ezExpressionByteCode::OpCode::Mov_R:
+          VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_I:
-        VMLoadInput(pByteCode, pRegisters, uiNumRegisters, inputs, m_InputMapping);
-        break;
+        case ezExpressionByteCode::OpCode::Mov_C:
+          VMOperation1_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_O:
-        VMStoreOutput(pByteCode, pRegisters, uiNumRegisters, outputs, m_OutputMapping);
-        break;
+        case ezExpressionByteCode::OpCode::Mov_I:
+          VMLoadInput(pByteCode, pRegisters, uiNumRegisters, inputs, m_InputMapping, uiFirstInstance);
+          break;
 
-        // binary
-      case ezExpressionByteCode::OpCode::Add_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
-        break;
+        case ezExpressionByteCode::OpCode::Mov_O:
+          VMStoreOutput(pByteCode, pRegisters, uiNumRegisters, outputs, m_OutputMapping, uiFirstInstance);
+          break;
 
-      case ezExpressionByteCode::OpCode::Add_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
-        break;
+          // binary
+        case ezExpressionByteCode::OpCode::Add_RR:
+          VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sub_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
-        break;
+        case ezExpressionByteCode::OpCode::Add_CR:
+          VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sub_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
-        break;
+        case ezExpressionByteCode::OpCode::Sub_RR:
+          VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mul_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Sub_CR:
+          VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mul_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Mul_RR:
+          VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Div_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Mul_CR:
+          VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Div_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Div_RR:
+          VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Min_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Div_CR:
+          VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Min_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Min_RR:
+          VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Max_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Min_CR:
+          VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Max_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Max_RR:
+          VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
+          break;
 
-        // call
-      case ezExpressionByteCode::OpCode::Call:
-      {
-        ezUInt32 uiFunctionIndex = ezExpressionByteCode::GetFunctionIndex(pByteCode);
-        uiFunctionIndex = m_FunctionMapping[uiFunctionIndex];
-        auto& func = m_Functions[uiFunctionIndex].m_Func;
+        case ezExpressionByteCode::OpCode::Max_CR:
+          VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
+          break;
 
-        VMCall(pByteCode, pRegisters, uiNumRegisters, globalData, func);
-      }
-      break;
+          // ternary
+        case ezExpressionByteCode::OpCode::MulAdd_RRR:
+          VMOperation3<VMRegisterOperand, VMRegisterOperand, VMRegisterOperand>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return ezSimdVec4f::MulAdd(a, b, c); });
+          break;
 
-      default:
-        EZ_ASSERT_NOT_IMPLEMENTED;
-        return EZ_FAILURE;
+        case ezExpressionByteCode::OpCode::MulAdd_CRR:
+          VMOperation3<VMConstantOperand, VMRegisterOperand, VMRegisterOperand>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return ezSimdVec4f::MulAdd(a, b, c); });
+          break;
+
+        case ezExpressionByteCode::OpCode::MulAdd_RRC:
+          VMOperation3<VMRegisterOperand, VMRegisterOperand, VMConstantOperand>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return ezSimdVec4f::MulAdd(a, b, c); });
+          break;
+
+        case ezExpressionByteCode::OpCode::MulAdd_CRC:
+          VMOperation3<VMConstantOperand, VMRegisterOperand, VMConstantOperand>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return ezSimdVec4f::MulAdd(a, b, c); });
+          break;
+
+        case ezExpressionByteCode::OpCode::Clamp_RCC:
+          // Same operation order as the Min(hi, Max(lo, x)) sequence it replaces
+          VMOperation3<VMRegisterOperand, VMConstantOperand, VMConstantOperand>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& x, const ezSimdVec4f& lo, const ezSimdVec4f& hi) { return hi.CompMin(lo.CompMax(x)); });
+          break;
+
+          // call
+        case ezExpressionByteCode::OpCode::Call:
+        {
+          ezUInt32 uiFunctionIndex = ezExpressionByteCode::GetFunctionIndex(pByteCode);
+          uiFunctionIndex = m_FunctionMapping[uiFunctionIndex];
+          auto& func = m_Functions[uiFunctionIndex].m_Func;
+
+          VMCall(pByteCode, pRegisters, uiNumRegisters, globalData, func);
+        }
+        break;
+
+        default:
+          EZ_ASSERT_NOT_IMPLEMENTED;
+          return EZ_FAILURE;
+      }
     }
   }
 
@@ -60,6 +60,7 @@ ezResult ezRcAgentComponent::InitializeRecast()
   m_pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
   m_pCorridor = EZ_DEFAULT_NEW(dtPathCorridor);
 
+  // path searches are done by the world module, this query only needs nodes for local searches along the corridor
   /// \todo Hard-coded limits
   m_pQuery->init(pNavMesh, 512);
   m_pCorridor->init(256);
@@ -84,6 +85,8 @@ void ezRcAgentComponent::UninitializeRecast()
 
 void ezRcAgentComponent::ClearTargetPosition()
 {
+  CancelPathRequest();
+
   m_iNumNextSteps = 0;
   m_iFirstNextStep = 0;
   m_PathCorridor.Clear();
@@ -140,71 +143,55 @@ ezResult ezRcAgentComponent::FindNavMeshPolyAt(const ezVec3& vPosition, dtPolyRe
   return EZ_SUCCESS;
 }
 
-ezResult ezRcAgentComponent::ComputePathCorridor(dtPolyRef startPoly, dtPolyRef endPoly, bool& bFoundPartialPath)
+ezResult ezRcAgentComponent::ComputePathToTarget()
 {
-  bFoundPartialPath = false;
-
-  ezRcPos rcStart = m_vCurrentPositionOnNavmesh;
-  ezRcPos rcEnd = m_vTargetPosition;
-
-  ezInt32 iPathCorridorLength = 0;
-
-  // make enough room
-  m_PathCorridor.SetCountUninitialized(256);
-  if (dtStatusFailed(m_pQuery->findPath(startPoly, endPoly, rcStart, rcEnd, &m_QueryFilter, m_PathCorridor.GetData(), &iPathCorridorLength, (int)m_PathCorridor.GetCount())) || iPathCorridorLength <= 0)
-  {
-    m_PathCorridor.Clear();
-    return EZ_FAILURE;
-  }
-
-  // reduce to actual length
-  m_PathCorridor.SetCountUninitialized(iPathCorridorLength);
+  ezRecastWorldModule* pRecastModule = static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule();
 
-  if (m_PathCorridor[iPathCorridorLength - 1] != endPoly)
+  if (m_PathRequestId.IsInvalidated())
   {
-    // if this is the case, the target position cannot be reached, but we can walk close to it
-    bFoundPartialPath = true;
-  }
+    const ezVec3 vStartPos = GetOwner()->GetGlobalPosition();
 
-  m_pCorridor->reset(startPoly, rcStart);
-  m_pCorridor->setCorridor(rcEnd, m_PathCorridor.GetData(), iPathCorridorLength);
+    dtPolyRef startPoly;
+    if (FindNavMeshPolyAt(vStartPos, startPoly, &m_vCurrentPositionOnNavmesh).Failed())
+    {
+      m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
-  return EZ_SUCCESS;
-}
+      ezAgentSteeringEvent e;
+      e.m_pComponent = this;
+      e.m_Type = ezAgentSteeringEvent::ErrorOutsideNavArea;
+      m_SteeringEvents.Broadcast(e);
+      return EZ_FAILURE;
+    }
 
-ezResult ezRcAgentComponent::ComputePathToTarget()
-{
-  const ezVec3 vStartPos = GetOwner()->GetGlobalPosition();
+    dtPolyRef endPoly;
+    if (FindNavMeshPolyAt(m_vTargetPosition, endPoly).Failed())
+    {
+      m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
-  dtPolyRef startPoly;
-  if (FindNavMeshPolyAt(vStartPos, startPoly, &m_vCurrentPositionOnNavmesh).Failed())
-  {
-    m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
+      ezAgentSteeringEvent e;
+      e.m_pComponent = this;
+      e.m_Type = ezAgentSteeringEvent::ErrorInvalidTargetPosition;
+      m_SteeringEvents.Broadcast(e);
+      return EZ_FAILURE;
+    }
 
-    ezAgentSteeringEvent e;
-    e.m_pComponent = this;
-    e.m_Type = ezAgentSteeringEvent::ErrorOutsideNavArea;
-    m_SteeringEvents.Broadcast(e);
-    return EZ_FAILURE;
+    m_PathStartPoly = startPoly;
+    m_vPathStartPosition = m_vCurrentPositionOnNavmesh;
+    m_PathRequestId = pRecastModule->RequestPath(startPoly, endPoly, m_vPathStartPosition, m_vTargetPosition);
   }
 
-  dtPolyRef endPoly;
-  if (FindNavMeshPolyAt(m_vTargetPosition, endPoly).Failed())
-  {
-    m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
+  bool bFoundPartialPath = false;
+  const ezRecastPathRequestState::Enum requestState = pRecastModule->RetrievePathRequestResult(m_PathRequestId, m_PathCorridor, bFoundPartialPath);
 
-    ezAgentSteeringEvent e;
-    e.m_pComponent = this;
-    e.m_Type = ezAgentSteeringEvent::ErrorInvalidTargetPosition;
-    m_SteeringEvents.Broadcast(e);
+  // the search is done over the next frames, until then we stay in the waiting state
+  if (requestState == ezRecastPathRequestState::Pending)
     return EZ_FAILURE;
-  }
 
-  /// \todo Optimize case when endPoly is same as previously ?
+  m_PathRequestId.Invalidate();
 
-  bool bFoundPartialPath = false;
-  if (ComputePathCorridor(startPoly, endPoly, bFoundPartialPath).Failed() || bFoundPartialPath)
+  if (requestState != ezRecastPathRequestState::Finished || bFoundPartialPath)
   {
+    m_PathCorridor.Clear();
     m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
     /// \todo For now a partial path is considered an error
@@ -216,6 +203,12 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
     return EZ_FAILURE;
   }
 
+  ezRcPos rcStart = m_vPathStartPosition;
+  ezRcPos rcEnd = m_vTargetPosition;
+
+  m_pCorridor->reset(m_PathStartPoly, rcStart);
+  m_pCorridor->setCorridor(rcEnd, m_PathCorridor.GetData(), m_PathCorridor.GetCount());
+
   m_PathToTargetState = ezAgentPathFindingState::HasTargetAndValidPath;
 
   ezAgentSteeringEvent e;
@@ -225,6 +218,15 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
   return EZ_SUCCESS;
 }
 
+void ezRcAgentComponent::CancelPathRequest()
+{
+  if (m_PathRequestId.IsInvalidated())
+    return;
+
+  static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule()->CancelPathRequest(m_PathRequestId);
+  m_PathRequestId.Invalidate();
+}
+
 bool ezRcAgentComponent::HasReachedPosition(const ezVec3& pos, float fMaxDistance) const
 {
   ezVec3 vTargetPos = pos;
@@ -297,6 +299,14 @@ void ezRcAgentComponent::OnSimulationStarted()
   }
 }
 
+void ezRcAgentComponent::OnDeactivated()
+{
+  // a new path is requested when the component gets activated again
+  CancelPathRequest();
+
+  SUPER::OnDeactivated();
+}
+
 void ezRcAgentComponent::ApplySteering(const ezVec3& vDirection, float fSpeed)
 {
   // compute new rotation
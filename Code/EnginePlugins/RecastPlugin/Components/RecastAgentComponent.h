@@ -8,6 +8,7 @@
 #include <RecastPlugin/Components/RecastNavMeshComponent.h>
 #include <RecastPlugin/NavMeshBuilder/NavMeshBuilder.h>
 #include <RecastPlugin/RecastPluginDLL.h>
+#include <RecastPlugin/WorldModule/RecastWorldModule.h>
 
 class ezRecastWorldModule;
 class ezPhysicsWorldModuleInterface;
@@ -85,7 +86,7 @@ private:
 
 private:
   ezResult ComputePathToTarget();
-  ezResult ComputePathCorridor(dtPolyRef startPoly, dtPolyRef endPoly, bool& bFoundPartialPath);
+  void CancelPathRequest();
   void ComputeSteeringDirection(float fMaxDistance);
   void ApplySteering(const ezVec3& vDirection, float fSpeed);
   void SyncSteeringWithReality();
@@ -94,6 +95,9 @@ private:
   ezVec3 m_vTargetPosition;
   ezEnum<ezAgentPathFindingState> m_PathToTargetState;
   ezVec3 m_vCurrentPositionOnNavmesh;      /// \todo ??? keep update ?
+  ezRecastPathRequestId m_PathRequestId;   // the path search itself is done by the ezRecastWorldModule
+  dtPolyRef m_PathStartPoly = 0;
+  ezVec3 m_vPathStartPosition;
   ezUniquePtr<dtNavMeshQuery> m_pQuery;    // careful, dtNavMeshQuery is not moveble
   ezUniquePtr<dtPathCorridor> m_pCorridor; // careful, dtPathCorridor is not moveble
   dtQueryFilter m_QueryFilter;             /// \todo hard-coded filter
@@ -120,6 +124,7 @@ private:
   ezResult InitializeRecast();
   void UninitializeRecast();
   virtual void OnSimulationStarted() override;
+  virtual void OnDeactivated() override;
   void Update();
 
   bool m_bRecastInitialized = false;
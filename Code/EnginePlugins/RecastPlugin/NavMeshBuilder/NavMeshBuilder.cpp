@@ -2,6 +2,9 @@
 
 #include <Core/Utils/WorldGeoExtractionUtil.h>
 #include <Core/World/World.h>
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
@@ -28,6 +31,7 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezRecastConfig, ezNoBase, 1, ezRTTIDefaultAllocat
     EZ_MEMBER_PROPERTY("SampleErrorFactor", m_fDetailMeshSampleErrorFactor)->AddAttributes(new ezDefaultValueAttribute(1.0f)),
     EZ_MEMBER_PROPERTY("MaxSimplification", m_fMaxSimplificationError)->AddAttributes(new ezDefaultValueAttribute(1.3f)),
     EZ_MEMBER_PROPERTY("MaxEdgeLength", m_fMaxEdgeLength)->AddAttributes(new ezDefaultValueAttribute(4.0f)),
+    EZ_MEMBER_PROPERTY("TileSize", m_fTileSize)->AddAttributes(new ezDefaultValueAttribute(0.0f), new ezClampValueAttribute(0.0f, ezVariant())),
   }
   EZ_END_PROPERTIES;
 }
@@ -69,8 +73,6 @@ void ezRecastNavMeshBuilder::Clear()
   m_BoundingBox.SetInvalid();
   m_Vertices.Clear();
   m_Triangles.Clear();
-  m_TriangleAreaIDs.Clear();
-  m_pRecastContext = nullptr;
 }
 
 ezResult ezRecastNavMeshBuilder::ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::Geometry& out_worldGeo)
@@ -92,11 +94,10 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
   pg.SetStepWeighting(3, 0.2f);
 
   Clear();
+  m_Grid = TileGrid();
+  m_Tiles.Clear();
   out_NavMeshDesc.Clear();
 
-  ezUniquePtr<ezRcBuildContext> recastContext = EZ_DEFAULT_NEW(ezRcBuildContext);
-  m_pRecastContext = recastContext.Borrow();
-
   if (!pg.BeginNextStep("Triangulate Mesh"))
     return EZ_FAILURE;
 
@@ -113,23 +114,190 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
 
   ComputeBoundingBox();
 
+  EZ_SUCCEED_OR_RETURN(SetupTileGrid(config));
+  m_GridConfig = config;
+
   if (!pg.BeginNextStep("Build Poly Mesh"))
     return EZ_FAILURE;
 
-  out_NavMeshDesc.m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+  ezDynamicArray<ezUInt32> tilesToBuild;
+  tilesToBuild.SetCountUninitialized(m_Tiles.GetCount());
+  for (ezUInt32 i = 0; i < tilesToBuild.GetCount(); ++i)
+  {
+    tilesToBuild[i] = i;
+  }
 
-  if (BuildRecastPolyMesh(config, *out_NavMeshDesc.m_pNavMeshPolygons, progress).Failed())
+  if (BuildTiles(config, tilesToBuild, progress).Failed())
+  {
+    m_Tiles.Clear();
     return EZ_FAILURE;
+  }
 
   if (!pg.BeginNextStep("Build NavMesh"))
     return EZ_FAILURE;
 
-  if (BuildDetourNavMeshData(config, *out_NavMeshDesc.m_pNavMeshPolygons, out_NavMeshDesc.m_DetourNavmeshData).Failed())
+  FillOutDescriptor(out_NavMeshDesc);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshBuilder::RebuildTiles(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& geo,
+  ezArrayPtr<const ezBoundingBox> changedBounds, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress)
+{
+  EZ_LOG_BLOCK("ezRecastNavMeshBuilder::RebuildTiles");
+
+  // any change to the config affects all tiles
+  if (m_Tiles.IsEmpty() || m_GridConfig != config)
+  {
+    return Build(config, geo, out_NavMeshDesc, progress);
+  }
+
+  ezProgressRange pg("Updating NavMesh", 3, true, &progress);
+  pg.SetStepWeighting(0, 0.1f);
+  pg.SetStepWeighting(1, 0.7f);
+  pg.SetStepWeighting(2, 0.2f);
+
+  Clear();
+  out_NavMeshDesc.Clear();
+
+  if (!pg.BeginNextStep("Triangulate Mesh"))
     return EZ_FAILURE;
 
+  GenerateTriangleMeshFromDescription(geo);
+  ComputeBoundingBox();
+
+  // tiles can only be replaced within the existing grid, anything else requires new navmesh parameters
+  // the height is part of the grid as well, so that the new tiles are built with the same height range as the old ones
+  {
+    const ezVec3 vGridMax = GetTileBounds(m_Grid.m_uiTilesX - 1, m_Grid.m_uiTilesZ - 1).m_vMax;
+
+    if (m_Vertices.IsEmpty() || !ezBoundingBox(m_Grid.m_vOrigin, vGridMax).Contains(m_BoundingBox))
+    {
+      ezLog::Dev("The geometry does not fit into the existing navmesh tiles, building the entire navmesh.");
+      return Build(config, geo, out_NavMeshDesc, progress);
+    }
+  }
+
+  if (!pg.BeginNextStep("Build Poly Mesh"))
+    return EZ_FAILURE;
+
+  ezDynamicArray<ezUInt32> tilesToBuild;
+  {
+    ezDynamicArray<bool> isTileQueued;
+    isTileQueued.SetCount(m_Tiles.GetCount(), false);
+
+    for (const ezBoundingBox& box : changedBounds)
+    {
+      // convert from ez convention (Z up) to recast convention (Y up)
+      const ezVec3 vMin(box.m_vMin.x, box.m_vMin.z, box.m_vMin.y);
+      const ezVec3 vMax(box.m_vMax.x, box.m_vMax.z, box.m_vMax.y);
+
+      ezVec2U32 minTile, maxTile;
+      if (!GetTileRange(vMin, vMax, minTile, maxTile))
+        continue;
+
+      for (ezUInt32 z = minTile.y; z <= maxTile.y; ++z)
+      {
+        for (ezUInt32 x = minTile.x; x <= maxTile.x; ++x)
+        {
+          const ezUInt32 uiTileIdx = z * m_Grid.m_uiTilesX + x;
+
+          if (!isTileQueued[uiTileIdx])
+          {
+            isTileQueued[uiTileIdx] = true;
+            tilesToBuild.PushBack(uiTileIdx);
+          }
+        }
+      }
+    }
+  }
+
+  ezLog::Debug("Rebuilding {0} of {1} navmesh tiles", tilesToBuild.GetCount(), m_Tiles.GetCount());
+
+  if (BuildTiles(config, tilesToBuild, progress).Failed())
+  {
+    m_Tiles.Clear();
+    return EZ_FAILURE;
+  }
+
+  if (!pg.BeginNextStep("Build NavMesh"))
+    return EZ_FAILURE;
+
+  FillOutDescriptor(out_NavMeshDesc);
+
   return EZ_SUCCESS;
 }
 
+namespace
+{
+  struct GeometryHashes
+  {
+    ezHashTable<ezUInt64, ezBoundingBox> m_Triangles;
+    ezHashTable<ezUInt64, ezBoundingBox> m_Boxes;
+  };
+
+  void ComputeGeometryHashes(const ezWorldGeoExtractionUtil::Geometry& geo, GeometryHashes& out_Hashes)
+  {
+    out_Hashes.m_Triangles.Reserve(geo.m_Triangles.GetCount());
+    out_Hashes.m_Boxes.Reserve(geo.m_BoxShapes.GetCount());
+
+    for (const auto& tri : geo.m_Triangles)
+    {
+      ezVec3 vertices[3];
+      for (ezUInt32 i = 0; i < 3; ++i)
+      {
+        vertices[i] = geo.m_Vertices[tri.m_uiVertexIndices[i]].m_vPosition;
+      }
+
+      ezBoundingBox bounds;
+      bounds.SetFromPoints(vertices, 3);
+
+      out_Hashes.m_Triangles[ezHashingUtils::xxHash64(vertices, sizeof(vertices))] = bounds;
+    }
+
+    for (const auto& box : geo.m_BoxShapes)
+    {
+      const float values[] = {box.m_vPosition.x, box.m_vPosition.y, box.m_vPosition.z, box.m_qRotation.v.x, box.m_qRotation.v.y,
+        box.m_qRotation.v.z, box.m_qRotation.w, box.m_vHalfExtents.x, box.m_vHalfExtents.y, box.m_vHalfExtents.z};
+
+      ezBoundingBox bounds;
+      bounds.SetCenterAndHalfExtents(ezVec3::ZeroVector(), box.m_vHalfExtents);
+      bounds.TransformFromOrigin(ezTransform(box.m_vPosition, box.m_qRotation).GetAsMat4());
+
+      out_Hashes.m_Boxes[ezHashingUtils::xxHash64(values, sizeof(values))] = bounds;
+    }
+  }
+
+  void AddMissingBounds(const ezHashTable<ezUInt64, ezBoundingBox>& from, const ezHashTable<ezUInt64, ezBoundingBox>& in, ezDynamicArray<ezBoundingBox>& out_Bounds)
+  {
+    for (auto it = from.GetIterator(); it.IsValid(); ++it)
+    {
+      if (!in.Contains(it.Key()))
+      {
+        out_Bounds.PushBack(it.Value());
+      }
+    }
+  }
+} // namespace
+
+void ezRecastNavMeshBuilder::ComputeChangedBounds(
+  const ezWorldGeoExtractionUtil::Geometry& oldGeo, const ezWorldGeoExtractionUtil::Geometry& newGeo, ezDynamicArray<ezBoundingBox>& out_ChangedBounds)
+{
+  EZ_LOG_BLOCK("ezRecastNavMeshBuilder::ComputeChangedBounds");
+
+  out_ChangedBounds.Clear();
+
+  GeometryHashes oldHashes, newHashes;
+  ComputeGeometryHashes(oldGeo, oldHashes);
+  ComputeGeometryHashes(newGeo, newHashes);
+
+  // removed geometry affects the tiles where it was, added geometry the tiles where it is now
+  AddMissingBounds(oldHashes.m_Triangles, newHashes.m_Triangles, out_ChangedBounds);
+  AddMissingBounds(newHashes.m_Triangles, oldHashes.m_Triangles, out_ChangedBounds);
+  AddMissingBounds(oldHashes.m_Boxes, newHashes.m_Boxes, out_ChangedBounds);
+  AddMissingBounds(newHashes.m_Boxes, oldHashes.m_Boxes, out_ChangedBounds);
+}
+
 void ezRecastNavMeshBuilder::ReserveMemory(const ezWorldGeoExtractionUtil::Geometry& desc)
 {
   const ezUInt32 uiBoxes = desc.m_BoxShapes.GetCount();
@@ -140,7 +308,6 @@ void ezRecastNavMeshBuilder::ReserveMemory(const ezWorldGeoExtractionUtil::Geome
   const ezUInt32 uiVertices = uiBoxVertices + desc.m_Vertices.GetCount();
 
   m_Triangles.Reserve(uiTriangles);
-  m_TriangleAreaIDs.Reserve(uiTriangles);
   m_Vertices.Reserve(uiVertices);
 }
 
@@ -149,7 +316,6 @@ void ezRecastNavMeshBuilder::GenerateTriangleMeshFromDescription(const ezWorldGe
   EZ_LOG_BLOCK("ezRecastNavMeshBuilder::GenerateTriangleMesh");
 
   m_Triangles.Clear();
-  m_TriangleAreaIDs.Clear();
   m_Vertices.Clear();
 
   ReserveMemory(desc);
@@ -220,9 +386,6 @@ void ezRecastNavMeshBuilder::GenerateTriangleMeshFromDescription(const ezWorldGe
     }
   }
 
-  // initialize the IDs to zero
-  m_TriangleAreaIDs.SetCount(m_Triangles.GetCount());
-
   ezLog::Debug("Vertices: {0}, Triangles: {1}", m_Vertices.GetCount(), m_Triangles.GetCount());
 }
 
@@ -261,41 +424,34 @@ void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig&
   rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 }
 
-ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress)
+ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(
+  const rcConfig& cfg, ezArrayPtr<const Triangle> triangles, rcPolyMesh& out_PolyMesh, ezRcBuildContext* pContext) const
 {
-  ezProgressRange pgRange("Build Poly Mesh", 13, true, &progress);
-
-  rcConfig cfg;
-  FillOutConfig(cfg, config, m_BoundingBox);
+  if (triangles.IsEmpty())
+    return EZ_SUCCESS;
 
-  ezRcBuildContext* pContext = m_pRecastContext;
   const float* pVertices = &m_Vertices[0].x;
-  const ezInt32* pTriangles = &m_Triangles[0].m_VertexIdx[0];
+  const ezInt32* pTriangles = &triangles[0].m_VertexIdx[0];
+
+  // initialize the IDs to zero
+  ezDynamicArray<ezUInt8> triangleAreaIDs;
+  triangleAreaIDs.SetCount(triangles.GetCount());
 
   rcHeightfield* heightfield = rcAllocHeightfield();
   EZ_SCOPE_EXIT(rcFreeHeightField(heightfield));
 
-  if (!pgRange.BeginNextStep("Creating Heightfield"))
-    return EZ_FAILURE;
-
   if (!rcCreateHeightfield(pContext, *heightfield, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
   {
     pContext->log(RC_LOG_ERROR, "Could not create solid heightfield");
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Mark Walkable Area"))
-    return EZ_FAILURE;
-
   // TODO Instead of this, it should use area IDs and then clear the non-walkable triangles
   rcMarkWalkableTriangles(
-    pContext, cfg.walkableSlopeAngle, pVertices, m_Vertices.GetCount(), pTriangles, m_Triangles.GetCount(), m_TriangleAreaIDs.GetData());
-
-  if (!pgRange.BeginNextStep("Rasterize Triangles"))
-    return EZ_FAILURE;
+    pContext, cfg.walkableSlopeAngle, pVertices, m_Vertices.GetCount(), pTriangles, triangles.GetCount(), triangleAreaIDs.GetData());
 
   if (!rcRasterizeTriangles(
-        pContext, pVertices, m_Vertices.GetCount(), pTriangles, m_TriangleAreaIDs.GetData(), m_Triangles.GetCount(), *heightfield, cfg.walkableClimb))
+        pContext, pVertices, m_Vertices.GetCount(), pTriangles, triangleAreaIDs.GetData(), triangles.GetCount(), *heightfield, cfg.walkableClimb))
   {
     pContext->log(RC_LOG_ERROR, "Could not rasterize triangles");
     return EZ_FAILURE;
@@ -303,28 +459,16 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
 
   // Optional stuff
   {
-    if (!pgRange.BeginNextStep("Filter Low Hanging Obstacles"))
-      return EZ_FAILURE;
-
     // if (m_filterLowHangingObstacles)
     rcFilterLowHangingWalkableObstacles(pContext, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Ledge Spans"))
-      return EZ_FAILURE;
-
     // if (m_filterLedgeSpans)
     rcFilterLedgeSpans(pContext, cfg.walkableHeight, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Low Height Spans"))
-      return EZ_FAILURE;
-
     // if (m_filterWalkableLowHeightSpans)
     rcFilterWalkableLowHeightSpans(pContext, cfg.walkableHeight, *heightfield);
   }
 
-  if (!pgRange.BeginNextStep("Build Compact Heightfield"))
-    return EZ_FAILURE;
-
   rcCompactHeightfield* compactHeightfield = rcAllocCompactHeightfield();
   EZ_SCOPE_EXIT(rcFreeCompactHeightfield(compactHeightfield));
 
@@ -334,9 +478,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Erode Walkable Area"))
-    return EZ_FAILURE;
-
   if (!rcErodeWalkableArea(pContext, cfg.walkableRadius, *compactHeightfield))
   {
     pContext->log(RC_LOG_ERROR, "Could not erode with character radius");
@@ -357,9 +498,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   {
     // PARTITION_WATERSHED
     {
-      if (!pgRange.BeginNextStep("Build Distance Field"))
-        return EZ_FAILURE;
-
       // Prepare for region partitioning, by calculating distance field along the walkable surface.
       if (!rcBuildDistanceField(pContext, *compactHeightfield))
       {
@@ -367,11 +505,8 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
         return EZ_FAILURE;
       }
 
-      if (!pgRange.BeginNextStep("Build Regions"))
-        return EZ_FAILURE;
-
       // Partition the walkable surface into simple regions without holes.
-      if (!rcBuildRegions(pContext, *compactHeightfield, 0, cfg.minRegionArea, cfg.mergeRegionArea))
+      if (!rcBuildRegions(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
         pContext->log(RC_LOG_ERROR, "Could not build watershed regions.");
         return EZ_FAILURE;
@@ -382,7 +517,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     //{
     //  // Partition the walkable surface into simple regions without holes.
     //  // Monotone partitioning does not need distance field.
-    //  if (!rcBuildRegionsMonotone(pContext, *compactHeightfield, 0, cfg.minRegionArea, cfg.mergeRegionArea))
+    //  if (!rcBuildRegionsMonotone(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
     //  {
     //    pContext->log(RC_LOG_ERROR, "Could not build monotone regions.");
     //    return EZ_FAILURE;
@@ -392,7 +527,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     //// PARTITION_LAYERS
     //{
     //  // Partition the walkable surface into simple regions without holes.
-    //  if (!rcBuildLayerRegions(pContext, *compactHeightfield, 0, cfg.minRegionArea))
+    //  if (!rcBuildLayerRegions(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea))
     //  {
     //    pContext->log(RC_LOG_ERROR, "Could not build layer regions.");
     //    return EZ_FAILURE;
@@ -400,9 +535,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     //}
   }
 
-  if (!pgRange.BeginNextStep("Build Contours"))
-    return EZ_FAILURE;
-
   rcContourSet* contourSet = rcAllocContourSet();
   EZ_SCOPE_EXIT(rcFreeContourSet(contourSet));
 
@@ -412,8 +544,9 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Build Poly Mesh"))
-    return EZ_FAILURE;
+  // no walkable area in this tile
+  if (contourSet->nconts == 0)
+    return EZ_SUCCESS;
 
   if (!rcBuildPolyMesh(pContext, *contourSet, cfg.maxVertsPerPoly, out_PolyMesh))
   {
@@ -424,9 +557,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   //////////////////////////////////////////////////////////////////////////
   // Detour Navmesh
 
-  if (!pgRange.BeginNextStep("Set Area Flags"))
-    return EZ_FAILURE;
-
   // TODO modify area IDs and flags
 
   for (int i = 0; i < out_PolyMesh.npolys; ++i)
@@ -440,7 +570,200 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   return EZ_SUCCESS;
 }
 
-ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData)
+ezResult ezRecastNavMeshBuilder::SetupTileGrid(const ezRecastConfig& config)
+{
+  rcConfig cfg;
+  FillOutConfig(cfg, config, m_BoundingBox);
+
+  m_Grid.m_vOrigin = m_BoundingBox.m_vMin;
+  m_Grid.m_fMaxHeight = m_BoundingBox.m_vMax.y;
+  m_Grid.m_fCellSize = cfg.cs;
+  m_Grid.m_fTileSize = config.m_fTileSize;
+  if (config.m_fTileSize > 0.0f)
+  {
+    m_Grid.m_iBorderCells = cfg.walkableRadius + 3;
+    m_Grid.m_iTileCellsX = ezMath::Max(1, static_cast<ezInt32>(config.m_fTileSize / cfg.cs));
+    m_Grid.m_iTileCellsZ = m_Grid.m_iTileCellsX;
+  }
+  else
+  {
+    // a single tile that covers everything, there are no neighbors to match up with
+    m_Grid.m_iBorderCells = 0;
+    m_Grid.m_iTileCellsX = ezMath::Max(1, cfg.width);
+    m_Grid.m_iTileCellsZ = ezMath::Max(1, cfg.height);
+  }
+
+  m_Grid.m_uiTilesX = ezMath::Max(1, (cfg.width + m_Grid.m_iTileCellsX - 1) / m_Grid.m_iTileCellsX);
+  m_Grid.m_uiTilesZ = ezMath::Max(1, (cfg.height + m_Grid.m_iTileCellsZ - 1) / m_Grid.m_iTileCellsZ);
+
+  // a polygon reference has 22 bits for the tile and polygon index, the rest is used for the salt
+  const ezUInt32 uiNumTiles = m_Grid.m_uiTilesX * m_Grid.m_uiTilesZ;
+  const ezUInt32 uiTileBits = ezMath::Log2i(ezMath::PowerOfTwo_Ceil(uiNumTiles));
+
+  if (uiTileBits > 14)
+  {
+    ezLog::Error("The navmesh would need {0} tiles, which is more than supported. Increase the tile size.", uiNumTiles);
+    return EZ_FAILURE;
+  }
+
+  m_Grid.m_uiMaxTiles = 1u << uiTileBits;
+  m_Grid.m_uiMaxPolysPerTile = 1u << (22 - uiTileBits);
+
+  m_Tiles.SetCount(uiNumTiles);
+
+  ezLog::Debug("Navmesh tiles: {0} x {1}", m_Grid.m_uiTilesX, m_Grid.m_uiTilesZ);
+  return EZ_SUCCESS;
+}
+
+ezBoundingBox ezRecastNavMeshBuilder::GetTileBounds(ezUInt32 uiTileX, ezUInt32 uiTileZ) const
+{
+  const float fTileWidth = m_Grid.m_iTileCellsX * m_Grid.m_fCellSize;
+  const float fTileDepth = m_Grid.m_iTileCellsZ * m_Grid.m_fCellSize;
+
+  ezBoundingBox bounds;
+  bounds.m_vMin.Set(m_Grid.m_vOrigin.x + uiTileX * fTileWidth, m_Grid.m_vOrigin.y, m_Grid.m_vOrigin.z + uiTileZ * fTileDepth);
+  bounds.m_vMax.Set(m_Grid.m_vOrigin.x + (uiTileX + 1) * fTileWidth, m_Grid.m_fMaxHeight, m_Grid.m_vOrigin.z + (uiTileZ + 1) * fTileDepth);
+  return bounds;
+}
+
+bool ezRecastNavMeshBuilder::GetTileRange(const ezVec3& vMin, const ezVec3& vMax, ezVec2U32& out_MinTile, ezVec2U32& out_MaxTile) const
+{
+  // geometry also affects the neighboring tiles, if it lies within their border
+  const float fBorder = m_Grid.m_iBorderCells * m_Grid.m_fCellSize;
+  const float fTileWidth = m_Grid.m_iTileCellsX * m_Grid.m_fCellSize;
+  const float fTileDepth = m_Grid.m_iTileCellsZ * m_Grid.m_fCellSize;
+
+  const float fMinX = ezMath::Floor((vMin.x - fBorder - m_Grid.m_vOrigin.x) / fTileWidth);
+  const float fMinZ = ezMath::Floor((vMin.z - fBorder - m_Grid.m_vOrigin.z) / fTileDepth);
+  const float fMaxX = ezMath::Floor((vMax.x + fBorder - m_Grid.m_vOrigin.x) / fTileWidth);
+  const float fMaxZ = ezMath::Floor((vMax.z + fBorder - m_Grid.m_vOrigin.z) / fTileDepth);
+
+  if (fMaxX < 0.0f || fMaxZ < 0.0f || fMinX >= m_Grid.m_uiTilesX || fMinZ >= m_Grid.m_uiTilesZ)
+    return false;
+
+  out_MinTile.x = static_cast<ezUInt32>(ezMath::Max(fMinX, 0.0f));
+  out_MinTile.y = static_cast<ezUInt32>(ezMath::Max(fMinZ, 0.0f));
+  out_MaxTile.x = ezMath::Min(static_cast<ezUInt32>(fMaxX), m_Grid.m_uiTilesX - 1);
+  out_MaxTile.y = ezMath::Min(static_cast<ezUInt32>(fMaxZ), m_Grid.m_uiTilesZ - 1);
+  return true;
+}
+
+ezResult ezRecastNavMeshBuilder::BuildTiles(const ezRecastConfig& config, ezArrayPtr<const ezUInt32> tilesToBuild, ezProgress& progress)
+{
+  if (tilesToBuild.IsEmpty())
+    return EZ_SUCCESS;
+
+  // sort the triangles into all the tiles that they overlap
+  ezDynamicArray<ezDynamicArray<Triangle>> tileTriangles;
+  tileTriangles.SetCount(tilesToBuild.GetCount());
+
+  {
+    ezDynamicArray<ezInt32> tileToBuildIdx;
+    tileToBuildIdx.SetCount(m_Tiles.GetCount(), -1);
+
+    for (ezUInt32 i = 0; i < tilesToBuild.GetCount(); ++i)
+    {
+      tileToBuildIdx[tilesToBuild[i]] = i;
+    }
+
+    for (const Triangle& tri : m_Triangles)
+    {
+      const ezVec3& v0 = m_Vertices[tri.m_VertexIdx[0]];
+      const ezVec3& v1 = m_Vertices[tri.m_VertexIdx[1]];
+      const ezVec3& v2 = m_Vertices[tri.m_VertexIdx[2]];
+
+      ezVec2U32 minTile, maxTile;
+      if (!GetTileRange(v0.CompMin(v1).CompMin(v2), v0.CompMax(v1).CompMax(v2), minTile, maxTile))
+        continue;
+
+      for (ezUInt32 z = minTile.y; z <= maxTile.y; ++z)
+      {
+        for (ezUInt32 x = minTile.x; x <= maxTile.x; ++x)
+        {
+          const ezInt32 iBuildIdx = tileToBuildIdx[z * m_Grid.m_uiTilesX + x];
+
+          if (iBuildIdx >= 0)
+          {
+            tileTriangles[iBuildIdx].PushBack(tri);
+          }
+        }
+      }
+    }
+  }
+
+  struct BuildTilesData
+  {
+    ezRecastNavMeshBuilder* m_pBuilder = nullptr;
+    const ezRecastConfig* m_pConfig = nullptr;
+    ezArrayPtr<const ezUInt32> m_TilesToBuild;
+    const ezDynamicArray<ezDynamicArray<Triangle>>* m_pTileTriangles = nullptr;
+    const ezProgress* m_pProgress = nullptr;
+    ezAtomicInteger32 m_iNumFailed;
+  };
+
+  BuildTilesData data;
+  data.m_pBuilder = this;
+  data.m_pConfig = &config;
+  data.m_TilesToBuild = tilesToBuild;
+  data.m_pTileTriangles = &tileTriangles;
+  data.m_pProgress = &progress;
+
+  // the tiles are completely independent of each other
+  ezTaskSystem::ParallelForIndexed(
+    0, tilesToBuild.GetCount(),
+    [&data](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        if (data.m_pProgress->WasCanceled())
+        {
+          data.m_iNumFailed.Increment();
+          return;
+        }
+
+        const ezUInt32 uiTileIdx = data.m_TilesToBuild[i];
+        if (data.m_pBuilder->BuildTile(*data.m_pConfig, uiTileIdx, (*data.m_pTileTriangles)[i], data.m_pBuilder->m_Tiles[uiTileIdx]).Failed())
+        {
+          data.m_iNumFailed.Increment();
+        }
+      }
+    },
+    "BuildNavMeshTiles");
+
+  return data.m_iNumFailed == 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+ezResult ezRecastNavMeshBuilder::BuildTile(const ezRecastConfig& config, ezUInt32 uiTileIdx, ezArrayPtr<const Triangle> triangles, Tile& out_Tile) const
+{
+  const ezUInt32 uiTileX = uiTileIdx % m_Grid.m_uiTilesX;
+  const ezUInt32 uiTileZ = uiTileIdx / m_Grid.m_uiTilesX;
+
+  rcConfig cfg;
+  FillOutConfig(cfg, config, GetTileBounds(uiTileX, uiTileZ));
+
+  // the heightfield extends into the neighboring tiles, so that the polygons along the tile edges match up
+  cfg.borderSize = m_Grid.m_iBorderCells;
+  cfg.width = m_Grid.m_iTileCellsX + cfg.borderSize * 2;
+  cfg.height = m_Grid.m_iTileCellsZ + cfg.borderSize * 2;
+  cfg.bmin[0] -= cfg.borderSize * cfg.cs;
+  cfg.bmin[2] -= cfg.borderSize * cfg.cs;
+  cfg.bmax[0] += cfg.borderSize * cfg.cs;
+  cfg.bmax[2] += cfg.borderSize * cfg.cs;
+
+  out_Tile.m_pPolyMesh = EZ_DEFAULT_NEW(rcPolyMesh);
+  out_Tile.m_NavMeshData.Clear();
+
+  // tiles are built on different threads, so each one needs its own context
+  ezRcBuildContext context;
+  EZ_SUCCEED_OR_RETURN(BuildRecastPolyMesh(cfg, triangles, *out_Tile.m_pPolyMesh, &context));
+
+  if (out_Tile.m_pPolyMesh->npolys == 0)
+    return EZ_SUCCESS;
+
+  return BuildDetourNavMeshData(config, *out_Tile.m_pPolyMesh, uiTileX, uiTileZ, out_Tile.m_NavMeshData);
+}
+
+ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(
+  const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezUInt32 uiTileX, ezUInt32 uiTileZ, ezDataBuffer& NavmeshData)
 {
   dtNavMeshCreateParams params;
   ezMemoryUtils::ZeroFill(&params, 1);
@@ -455,6 +778,8 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   params.walkableHeight = config.m_fAgentHeight;
   params.walkableRadius = config.m_fAgentRadius;
   params.walkableClimb = config.m_fAgentClimbHeight;
+  params.tileX = uiTileX;
+  params.tileY = uiTileZ;
   rcVcopy(params.bmin, polyMesh.bmin);
   rcVcopy(params.bmax, polyMesh.bmax);
   params.cs = config.m_fCellSize;
@@ -477,9 +802,102 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   return EZ_SUCCESS;
 }
 
+void ezRecastNavMeshBuilder::FillOutDescriptor(ezRecastNavMeshResourceDescriptor& out_NavMeshDesc) const
+{
+  out_NavMeshDesc.Clear();
+
+  out_NavMeshDesc.m_vTileGridOrigin = m_Grid.m_vOrigin;
+  out_NavMeshDesc.m_fTileWidth = m_Grid.m_iTileCellsX * m_Grid.m_fCellSize;
+  out_NavMeshDesc.m_fTileHeight = m_Grid.m_iTileCellsZ * m_Grid.m_fCellSize;
+  out_NavMeshDesc.m_uiMaxTiles = m_Grid.m_uiMaxTiles;
+  out_NavMeshDesc.m_uiMaxPolysPerTile = m_Grid.m_uiMaxPolysPerTile;
+
+  for (const Tile& tile : m_Tiles)
+  {
+    if (!tile.m_NavMeshData.IsEmpty())
+    {
+      out_NavMeshDesc.m_DetourNavmeshTiles.PushBack(tile.m_NavMeshData);
+    }
+  }
+
+  out_NavMeshDesc.m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+  if (MergeTilePolyMeshes(*out_NavMeshDesc.m_pNavMeshPolygons).Failed())
+  {
+    EZ_DEFAULT_DELETE(out_NavMeshDesc.m_pNavMeshPolygons);
+  }
+}
+
+ezResult ezRecastNavMeshBuilder::MergeTilePolyMeshes(rcPolyMesh& out_PolyMesh) const
+{
+  ezHybridArray<rcPolyMesh*, 64> polyMeshes;
+  ezUInt32 uiNumVertices = 0;
+  ezUInt32 uiNumPolygons = 0;
+
+  for (const Tile& tile : m_Tiles)
+  {
+    if (tile.m_pPolyMesh != nullptr && tile.m_pPolyMesh->npolys > 0)
+    {
+      polyMeshes.PushBack(tile.m_pPolyMesh.Borrow());
+      uiNumVertices += tile.m_pPolyMesh->nverts;
+      uiNumPolygons += tile.m_pPolyMesh->npolys;
+    }
+  }
+
+  if (polyMeshes.IsEmpty())
+    return EZ_FAILURE;
+
+  // the merged mesh uses 16 bit indices
+  if (uiNumVertices >= RC_MESH_NULL_IDX || uiNumPolygons >= RC_MESH_NULL_IDX)
+  {
+    ezLog::Warning("The navmesh has too many polygons for visualization and points of interest.");
+    return EZ_FAILURE;
+  }
+
+  ezRcBuildContext context;
+  if (!rcMergePolyMeshes(&context, polyMeshes.GetData(), polyMeshes.GetCount(), out_PolyMesh))
+    return EZ_FAILURE;
+
+  // rcMergePolyMeshes only connects polygons across tile edges where the vertices match up exactly,
+  // the remaining edges between tiles must not be treated as contours
+  const ezInt32 iMaxNumVertInPoly = out_PolyMesh.nvp;
+  ezInt32 iMergedPoly = 0;
+
+  for (const rcPolyMesh* pMesh : polyMeshes)
+  {
+    for (ezInt32 i = 0; i < pMesh->npolys; ++i, ++iMergedPoly)
+    {
+      const ezUInt16* srcNeighborData = &pMesh->polys[i * (iMaxNumVertInPoly * 2) + iMaxNumVertInPoly];
+      ezUInt16* dstNeighborData = &out_PolyMesh.polys[iMergedPoly * (iMaxNumVertInPoly * 2) + iMaxNumVertInPoly];
+
+      for (ezInt32 j = 0; j < iMaxNumVertInPoly; ++j)
+      {
+        const bool bIsPortal = srcNeighborData[j] != 0xffff && (srcNeighborData[j] & 0x8000) != 0;
+
+        if (bIsPortal && dstNeighborData[j] == 0xffff)
+        {
+          dstNeighborData[j] = srcNeighborData[j];
+        }
+      }
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+bool ezRecastConfig::operator==(const ezRecastConfig& rhs) const
+{
+  return m_fAgentHeight == rhs.m_fAgentHeight && m_fAgentRadius == rhs.m_fAgentRadius && m_fAgentClimbHeight == rhs.m_fAgentClimbHeight &&
+         m_WalkableSlope == rhs.m_WalkableSlope && m_fCellSize == rhs.m_fCellSize && m_fCellHeight == rhs.m_fCellHeight &&
+         m_fMaxEdgeLength == rhs.m_fMaxEdgeLength && m_fMaxSimplificationError == rhs.m_fMaxSimplificationError &&
+         m_fMinRegionSize == rhs.m_fMinRegionSize && m_fRegionMergeSize == rhs.m_fRegionMergeSize &&
+         m_fDetailMeshSampleDistanceFactor == rhs.m_fDetailMeshSampleDistanceFactor &&
+         m_fDetailMeshSampleErrorFactor == rhs.m_fDetailMeshSampleErrorFactor && m_fTileSize == rhs.m_fTileSize;
+}
+
 ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(1);
+  stream.WriteVersion(2);
 
   stream << m_fAgentHeight;
   stream << m_fAgentRadius;
@@ -493,13 +911,14 @@ ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
   stream << m_fRegionMergeSize;
   stream << m_fDetailMeshSampleDistanceFactor;
   stream << m_fDetailMeshSampleErrorFactor;
+  stream << m_fTileSize;
 
   return EZ_SUCCESS;
 }
 
 ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
 {
-  stream.ReadVersion(1);
+  const ezTypeVersion version = stream.ReadVersion(2);
 
   stream >> m_fAgentHeight;
   stream >> m_fAgentRadius;
@@ -514,5 +933,10 @@ ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
   stream >> m_fDetailMeshSampleDistanceFactor;
   stream >> m_fDetailMeshSampleErrorFactor;
 
+  if (version >= 2)
+  {
+    stream >> m_fTileSize;
+  }
+
   return EZ_SUCCESS;
 }
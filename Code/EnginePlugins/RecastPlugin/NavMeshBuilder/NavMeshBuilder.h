@@ -6,6 +6,7 @@
 #include <RecastPlugin/RecastPluginDLL.h>
 
 class ezRcBuildContext;
+struct rcConfig;
 struct rcPolyMesh;
 struct rcPolyMeshDetail;
 class ezWorld;
@@ -29,6 +30,10 @@ struct EZ_RECASTPLUGIN_DLL ezRecastConfig
   float m_fRegionMergeSize = 20.0f;
   float m_fDetailMeshSampleDistanceFactor = 1.0f;
   float m_fDetailMeshSampleErrorFactor = 1.0f;
+  float m_fTileSize = 0.0f; ///< Size of one navmesh tile in world units. With zero the whole navmesh is built as one single tile.
+
+  bool operator==(const ezRecastConfig& rhs) const;
+  bool operator!=(const ezRecastConfig& rhs) const { return !(*this == rhs); }
 
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
@@ -46,19 +51,26 @@ public:
 
   static ezResult ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::Geometry& out_worldGeo);
 
+  /// \brief Builds the entire navmesh. All tiles are built in parallel.
   ezResult Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& worldGeo, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc,
     ezProgress& progress);
 
-private:
-  static void FillOutConfig(struct rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
+  /// \brief Only rebuilds the tiles that overlap any of the given bounding boxes and writes the updated navmesh into out_NavMeshDesc.
+  ///
+  /// The bounding boxes are in world space and should cover the old and the new bounds of all geometry that has changed since the last build.
+  /// The tiles that are not affected are taken from the previous Build() or RebuildTiles() call on this builder.
+  /// If there was no previous build with the same config, or the geometry now extends beyond the previous tile grid,
+  /// this falls back to a full Build().
+  ezResult RebuildTiles(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& worldGeo, ezArrayPtr<const ezBoundingBox> changedBounds,
+    ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress);
 
-  void Clear();
-  void ReserveMemory(const ezWorldGeoExtractionUtil::Geometry& desc);
-  void GenerateTriangleMeshFromDescription(const ezWorldGeoExtractionUtil::Geometry& desc);
-  void ComputeBoundingBox();
-  ezResult BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress);
-  static ezResult BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData);
+  /// \brief Computes the bounding boxes of all triangles and box shapes that only exist in one of the two geometries.
+  ///
+  /// The result can be passed to RebuildTiles(), when the previous geometry is still available.
+  static void ComputeChangedBounds(
+    const ezWorldGeoExtractionUtil::Geometry& oldGeo, const ezWorldGeoExtractionUtil::Geometry& newGeo, ezDynamicArray<ezBoundingBox>& out_ChangedBounds);
 
+private:
   struct Triangle
   {
     Triangle() {}
@@ -72,9 +84,50 @@ private:
     ezInt32 m_VertexIdx[3];
   };
 
+  struct Tile
+  {
+    ezUniquePtr<rcPolyMesh> m_pPolyMesh;
+    ezDataBuffer m_NavMeshData; ///< Empty, if the tile contains no walkable area
+  };
+
+  static void FillOutConfig(rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
+
+  void Clear();
+  void ReserveMemory(const ezWorldGeoExtractionUtil::Geometry& desc);
+  void GenerateTriangleMeshFromDescription(const ezWorldGeoExtractionUtil::Geometry& desc);
+  void ComputeBoundingBox();
+  ezResult SetupTileGrid(const ezRecastConfig& config);
+  ezBoundingBox GetTileBounds(ezUInt32 uiTileX, ezUInt32 uiTileZ) const;
+  bool GetTileRange(const ezVec3& vMin, const ezVec3& vMax, ezVec2U32& out_MinTile, ezVec2U32& out_MaxTile) const;
+  ezResult BuildTiles(const ezRecastConfig& config, ezArrayPtr<const ezUInt32> tilesToBuild, ezProgress& progress);
+  ezResult BuildTile(const ezRecastConfig& config, ezUInt32 uiTileIdx, ezArrayPtr<const Triangle> triangles, Tile& out_Tile) const;
+  ezResult BuildRecastPolyMesh(const rcConfig& cfg, ezArrayPtr<const Triangle> triangles, rcPolyMesh& out_PolyMesh, ezRcBuildContext* pContext) const;
+  static ezResult BuildDetourNavMeshData(
+    const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezUInt32 uiTileX, ezUInt32 uiTileZ, ezDataBuffer& NavmeshData);
+  void FillOutDescriptor(ezRecastNavMeshResourceDescriptor& out_NavMeshDesc) const;
+  ezResult MergeTilePolyMeshes(rcPolyMesh& out_PolyMesh) const;
+
   ezBoundingBox m_BoundingBox;
   ezDynamicArray<ezVec3> m_Vertices;
   ezDynamicArray<Triangle> m_Triangles;
-  ezDynamicArray<ezUInt8> m_TriangleAreaIDs;
-  ezRcBuildContext* m_pRecastContext = nullptr;
+
+  // the tile grid is kept after a build, so that RebuildTiles() can replace individual tiles
+  struct TileGrid
+  {
+    ezVec3 m_vOrigin = ezVec3::ZeroVector(); ///< In recast convention (Y up)
+    float m_fMaxHeight = 0.0f;               ///< The top of all tiles in recast convention, the bottom is the origin
+    ezInt32 m_iTileCellsX = 0;
+    ezInt32 m_iTileCellsZ = 0;
+    ezInt32 m_iBorderCells = 0;
+    ezUInt32 m_uiTilesX = 0;
+    ezUInt32 m_uiTilesZ = 0;
+    ezUInt32 m_uiMaxTiles = 0;
+    ezUInt32 m_uiMaxPolysPerTile = 0;
+    float m_fCellSize = 0.0f;
+    float m_fTileSize = 0.0f;
+  };
+
+  TileGrid m_Grid;
+  ezRecastConfig m_GridConfig; ///< The config of the last build, the tiles can only be reused with exactly the same one
+  ezDynamicArray<Tile> m_Tiles;
 };
@@ -29,7 +29,12 @@ ezRecastNavMeshResourceDescriptor::~ezRecastNavMeshResourceDescriptor()
 
 void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescriptor&& rhs)
 {
-  m_DetourNavmeshData = std::move(rhs.m_DetourNavmeshData);
+  m_DetourNavmeshTiles = std::move(rhs.m_DetourNavmeshTiles);
+  m_vTileGridOrigin = rhs.m_vTileGridOrigin;
+  m_fTileWidth = rhs.m_fTileWidth;
+  m_fTileHeight = rhs.m_fTileHeight;
+  m_uiMaxTiles = rhs.m_uiMaxTiles;
+  m_uiMaxPolysPerTile = rhs.m_uiMaxPolysPerTile;
 
   m_pNavMeshPolygons = rhs.m_pNavMeshPolygons;
   rhs.m_pNavMeshPolygons = nullptr;
@@ -37,7 +42,12 @@ void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescrip
 
 void ezRecastNavMeshResourceDescriptor::Clear()
 {
-  m_DetourNavmeshData.Clear();
+  m_DetourNavmeshTiles.Clear();
+  m_vTileGridOrigin.SetZero();
+  m_fTileWidth = 0.0f;
+  m_fTileHeight = 0.0f;
+  m_uiMaxTiles = 0;
+  m_uiMaxPolysPerTile = 0;
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
 }
 
@@ -45,8 +55,19 @@ void ezRecastNavMeshResourceDescriptor::Clear()
 
 ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(1);
-  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_DetourNavmeshData));
+  stream.WriteVersion(2);
+
+  stream << m_vTileGridOrigin;
+  stream << m_fTileWidth;
+  stream << m_fTileHeight;
+  stream << m_uiMaxTiles;
+  stream << m_uiMaxPolysPerTile;
+
+  stream << m_DetourNavmeshTiles.GetCount();
+  for (const ezDataBuffer& tile : m_DetourNavmeshTiles)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.WriteArray(tile));
+  }
 
   const bool hasPolygons = m_pNavMeshPolygons != nullptr;
   stream << hasPolygons;
@@ -88,8 +109,44 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
 {
   Clear();
 
-  const ezTypeVersion version = stream.ReadVersion(1);
-  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_DetourNavmeshData));
+  const ezTypeVersion version = stream.ReadVersion(2);
+
+  if (version >= 2)
+  {
+    stream >> m_vTileGridOrigin;
+    stream >> m_fTileWidth;
+    stream >> m_fTileHeight;
+    stream >> m_uiMaxTiles;
+    stream >> m_uiMaxPolysPerTile;
+
+    ezUInt32 uiNumTiles = 0;
+    stream >> uiNumTiles;
+    m_DetourNavmeshTiles.SetCount(uiNumTiles);
+    for (ezDataBuffer& tile : m_DetourNavmeshTiles)
+    {
+      EZ_SUCCEED_OR_RETURN(stream.ReadArray(tile));
+    }
+  }
+  else
+  {
+    // version 1 stored a single navmesh for the whole level, which is the same as a grid with only one tile
+    ezDataBuffer& tile = m_DetourNavmeshTiles.ExpandAndGetRef();
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(tile));
+
+    if (tile.GetCount() < sizeof(dtMeshHeader))
+    {
+      m_DetourNavmeshTiles.Clear();
+    }
+    else
+    {
+      const dtMeshHeader* pHeader = reinterpret_cast<const dtMeshHeader*>(tile.GetData());
+      m_vTileGridOrigin.Set(pHeader->bmin[0], pHeader->bmin[1], pHeader->bmin[2]);
+      m_fTileWidth = pHeader->bmax[0] - pHeader->bmin[0];
+      m_fTileHeight = pHeader->bmax[2] - pHeader->bmin[2];
+      m_uiMaxTiles = 1;
+      m_uiMaxPolysPerTile = pHeader->polyCount;
+    }
+  }
 
   bool hasPolygons = false;
   stream >> hasPolygons;
@@ -122,6 +179,7 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
     mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
     mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
     mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+    mesh.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
     mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
 
     stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
@@ -155,8 +213,8 @@ ezResourceLoadDesc ezRecastNavMeshResource::UnloadData(Unload WhatToUnload)
   res.m_uiQualityLevelsLoadable = 0;
   res.m_State = ezResourceState::Unloaded;
 
-  m_DetourNavmeshData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMesh);
+  m_DetourNavmeshTiles.Clear();
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
 
   return res;
@@ -194,7 +252,11 @@ ezResourceLoadDesc ezRecastNavMeshResource::UpdateContent(ezStreamReader* Stream
 void ezRecastNavMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
-  out_NewMemoryUsage.m_uiMemoryCPU += m_DetourNavmeshData.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU += m_DetourNavmeshTiles.GetHeapMemoryUsage();
+  for (const ezDataBuffer& tile : m_DetourNavmeshTiles)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += tile.GetHeapMemoryUsage();
+  }
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMesh != nullptr ? sizeof(dtNavMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMeshPolygons != nullptr ? sizeof(rcPolyMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
@@ -210,13 +272,34 @@ ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResour
   m_pNavMeshPolygons = descriptor.m_pNavMeshPolygons;
   descriptor.m_pNavMeshPolygons = nullptr;
 
-  m_DetourNavmeshData = std::move(descriptor.m_DetourNavmeshData);
+  m_DetourNavmeshTiles = std::move(descriptor.m_DetourNavmeshTiles);
 
   m_pNavMesh = EZ_DEFAULT_NEW(dtNavMesh);
 
+  dtNavMeshParams params;
+  params.orig[0] = descriptor.m_vTileGridOrigin.x;
+  params.orig[1] = descriptor.m_vTileGridOrigin.y;
+  params.orig[2] = descriptor.m_vTileGridOrigin.z;
+  params.tileWidth = descriptor.m_fTileWidth;
+  params.tileHeight = descriptor.m_fTileHeight;
+  params.maxTiles = ezMath::Max(1u, descriptor.m_uiMaxTiles);
+  params.maxPolys = ezMath::Max(1u, descriptor.m_uiMaxPolysPerTile);
+
+  if (dtStatusFailed(m_pNavMesh->init(&params)))
+  {
+    ezLog::Error("Could not initialize the Detour navmesh.");
+  }
+
   // the dtNavMesh does not need to free the data, the resource owns it
-  const int dtMeshFlags = 0;
-  m_pNavMesh->init(m_DetourNavmeshData.GetData(), m_DetourNavmeshData.GetCount(), dtMeshFlags);
+  const int dtTileFlags = 0;
+
+  for (ezDataBuffer& tile : m_DetourNavmeshTiles)
+  {
+    if (dtStatusFailed(m_pNavMesh->addTile(tile.GetData(), tile.GetCount(), dtTileFlags, 0, nullptr)))
+    {
+      ezLog::Error("Could not add a tile to the Detour navmesh.");
+    }
+  }
 
   return res;
 }
@@ -17,8 +17,15 @@ struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
   void operator=(ezRecastNavMeshResourceDescriptor&& rhs);
   void operator=(const ezRecastNavMeshResourceDescriptor& rhs) = delete;
 
-  /// \brief Data that was created by dtCreateNavMeshData() and will be used for dtNavMesh::init()
-  ezDataBuffer m_DetourNavmeshData;
+  /// \brief One buffer per tile that was created by dtCreateNavMeshData() and will be added with dtNavMesh::addTile()
+  ezDynamicArray<ezDataBuffer> m_DetourNavmeshTiles;
+
+  /// \brief The tile grid for dtNavMesh::init(), in recast convention (Y up)
+  ezVec3 m_vTileGridOrigin = ezVec3::ZeroVector();
+  float m_fTileWidth = 0.0f;
+  float m_fTileHeight = 0.0f;
+  ezUInt32 m_uiMaxTiles = 0;
+  ezUInt32 m_uiMaxPolysPerTile = 0;
 
   /// \brief Optional, if available the navmesh can be visualized at runtime
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
@@ -47,7 +54,7 @@ private:
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
-  ezDataBuffer m_DetourNavmeshData;
+  ezDynamicArray<ezDataBuffer> m_DetourNavmeshTiles;
   dtNavMesh* m_pNavMesh = nullptr;
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 };
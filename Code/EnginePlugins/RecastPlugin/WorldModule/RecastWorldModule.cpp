@@ -1,6 +1,7 @@
 #include <RecastPluginPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Recast/DetourCrowd.h>
 #include <RecastPlugin/Resources/RecastNavMeshResource.h>
 #include <RecastPlugin/WorldModule/RecastWorldModule.h>
@@ -11,6 +12,26 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezRecastWorldModule, 1, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+namespace
+{
+  // limits for the path searches
+  enum
+  {
+    MaxActivePathSearches = 32,
+    MaxPathSearchIterationsPerFrame = 256,
+    MaxPathSearchNodes = 2048,
+    MaxPathLength = 256,
+    MaxCachedPaths = 256,
+  };
+
+  EZ_ALWAYS_INLINE ezUInt64 GetPathCacheKey(dtPolyRef startPoly, dtPolyRef endPoly)
+  {
+    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(dtPolyRef) == sizeof(ezUInt32), "Path cache key needs to be adjusted for 64 bit polygon references");
+
+    return (static_cast<ezUInt64>(startPoly) << 32) | endPoly;
+  }
+} // namespace
+
 ezRecastWorldModule::ezRecastWorldModule(ezWorld* pWorld)
   : ezWorldModule(pWorld)
 {
@@ -31,6 +52,15 @@ void ezRecastWorldModule::Initialize()
     RegisterUpdateFunction(updateDesc);
   }
 
+  {
+    auto updateDesc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezRecastWorldModule::UpdatePathRequests, this);
+    updateDesc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    updateDesc.m_bOnlyUpdateWhenSimulating = true;
+    updateDesc.m_fPriority = -1.0f; // after UpdateNavMesh
+
+    RegisterUpdateFunction(updateDesc);
+  }
+
   ezResourceManager::GetResourceEvents().AddEventHandler(ezMakeDelegate(&ezRecastWorldModule::ResourceEventHandler, this));
 }
 
@@ -45,6 +75,7 @@ void ezRecastWorldModule::SetNavMeshResource(const ezRecastNavMeshResourceHandle
 {
   m_hNavMesh = hNavMesh;
   m_pDetourNavMesh = nullptr;
+  m_bNavMeshChanged = true;
   m_pNavMeshPointsOfInterest.Clear();
 }
 
@@ -58,9 +89,14 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
       return;
 
     m_pDetourNavMesh = pNavMesh->GetNavMesh();
+    m_bNavMeshChanged = true;
 
     m_pNavMeshPointsOfInterest = EZ_DEFAULT_NEW(ezNavMeshPointOfInterestGraph);
-    m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*pNavMesh->GetNavMeshPolygons());
+
+    if (pNavMesh->GetNavMeshPolygons() != nullptr)
+    {
+      m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*pNavMesh->GetNavMeshPolygons());
+    }
   }
 
   if (m_pNavMeshPointsOfInterest)
@@ -69,11 +105,246 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
   }
 }
 
+ezRecastPathRequestId ezRecastWorldModule::RequestPath(dtPolyRef startPoly, dtPolyRef endPoly, const ezVec3& vStartPos, const ezVec3& vEndPos)
+{
+  PathRequest request;
+  request.m_StartPoly = startPoly;
+  request.m_EndPoly = endPoly;
+  request.m_vStartPos = vStartPos;
+  request.m_vEndPos = vEndPos;
+  request.m_State = ezRecastPathRequestState::Pending;
+
+  const ezRecastPathRequestId requestId = m_PathRequests.Insert(std::move(request));
+  m_QueuedPathRequests.PushBack(requestId);
+
+  return requestId;
+}
+
+ezRecastPathRequestState::Enum ezRecastWorldModule::RetrievePathRequestResult(
+  ezRecastPathRequestId requestId, ezDynamicArray<dtPolyRef>& out_Path, bool& out_bPartialPath)
+{
+  PathRequest* pRequest = nullptr;
+  if (!m_PathRequests.TryGetValue(requestId, pRequest))
+    return ezRecastPathRequestState::Invalid;
+
+  const ezRecastPathRequestState::Enum state = pRequest->m_State;
+  if (state == ezRecastPathRequestState::Pending)
+    return state;
+
+  out_Path = std::move(pRequest->m_Path);
+  out_bPartialPath = pRequest->m_bPartialPath;
+
+  m_PathRequests.Remove(requestId);
+  return state;
+}
+
+void ezRecastWorldModule::CancelPathRequest(ezRecastPathRequestId requestId)
+{
+  PathRequest* pRequest = nullptr;
+  if (!m_PathRequests.TryGetValue(requestId, pRequest))
+    return;
+
+  if (pRequest->m_pQuery != nullptr)
+  {
+    m_FreePathQueries.PushBack(pRequest->m_pQuery);
+    m_ActivePathRequests.RemoveAndCopy(requestId);
+  }
+
+  // queued requests are skipped once they come up
+  m_PathRequests.Remove(requestId);
+}
+
+void ezRecastWorldModule::UpdatePathRequests(const UpdateContext& ctxt)
+{
+  if (m_bNavMeshChanged)
+  {
+    ResetPathRequests();
+    m_bNavMeshChanged = false;
+  }
+
+  if (m_pDetourNavMesh == nullptr)
+    return;
+
+  ++m_uiPathRequestFrame;
+
+  // answer queued requests from the cache or start new searches, as long as there are free slots
+  while (m_ActivePathRequests.GetCount() < MaxActivePathSearches && !m_QueuedPathRequests.IsEmpty())
+  {
+    const ezRecastPathRequestId requestId = m_QueuedPathRequests.PeekFront();
+    m_QueuedPathRequests.PopFront();
+
+    PathRequest* pRequest = nullptr;
+    if (!m_PathRequests.TryGetValue(requestId, pRequest))
+      continue;
+
+    CachedPath* pCachedPath = nullptr;
+    if (m_PathCache.TryGetValue(GetPathCacheKey(pRequest->m_StartPoly, pRequest->m_EndPoly), pCachedPath))
+    {
+      pCachedPath->m_uiLastUsedFrame = m_uiPathRequestFrame;
+
+      pRequest->m_Path = pCachedPath->m_Path;
+      pRequest->m_bPartialPath = pCachedPath->m_bPartialPath;
+      pRequest->m_State = ezRecastPathRequestState::Finished;
+      continue;
+    }
+
+    if (m_FreePathQueries.IsEmpty())
+    {
+      ezUniquePtr<dtNavMeshQuery>& pQuery = m_PathQueries.ExpandAndGetRef();
+      pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+      pQuery->init(m_pDetourNavMesh, MaxPathSearchNodes);
+
+      m_FreePathQueries.PushBack(pQuery.Borrow());
+    }
+
+    pRequest->m_pQuery = m_FreePathQueries.PeekBack();
+    m_FreePathQueries.PopBack();
+
+    m_ActivePathRequests.PushBack(requestId);
+  }
+
+  if (m_ActivePathRequests.IsEmpty())
+    return;
+
+  ezHybridArray<PathRequest*, MaxActivePathSearches> activeRequests;
+  for (const ezRecastPathRequestId& requestId : m_ActivePathRequests)
+  {
+    activeRequests.PushBack(&m_PathRequests[requestId]);
+  }
+
+  // every search has its own query object, which keeps the state of the search until the next frame
+  struct PathSearchData
+  {
+    const ezRecastWorldModule* m_pModule;
+    ezArrayPtr<PathRequest*> m_Requests;
+  };
+
+  PathSearchData data = {this, activeRequests};
+
+  ezTaskSystem::ParallelForIndexed(
+    0, activeRequests.GetCount(),
+    [&data](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        data.m_pModule->ContinuePathSearch(*data.m_Requests[i]);
+      }
+    },
+    "RecastPathSearch");
+
+  for (ezUInt32 i = m_ActivePathRequests.GetCount(); i > 0; --i)
+  {
+    PathRequest& request = *activeRequests[i - 1];
+
+    if (request.m_State == ezRecastPathRequestState::Pending)
+      continue;
+
+    m_FreePathQueries.PushBack(request.m_pQuery);
+    request.m_pQuery = nullptr;
+
+    if (request.m_State == ezRecastPathRequestState::Finished)
+    {
+      AddToPathCache(request);
+    }
+
+    m_ActivePathRequests.RemoveAtAndCopy(i - 1);
+  }
+}
+
+void ezRecastWorldModule::ContinuePathSearch(PathRequest& request) const
+{
+  dtNavMeshQuery* pQuery = request.m_pQuery;
+
+  dtStatus status = DT_IN_PROGRESS;
+
+  if (!request.m_bSearchStarted)
+  {
+    request.m_bSearchStarted = true;
+    status = pQuery->initSlicedFindPath(request.m_StartPoly, request.m_EndPoly, request.m_vStartPos, request.m_vEndPos, &m_PathQueryFilter);
+  }
+
+  if (dtStatusInProgress(status))
+  {
+    status = pQuery->updateSlicedFindPath(MaxPathSearchIterationsPerFrame, nullptr);
+  }
+
+  if (dtStatusInProgress(status))
+    return;
+
+  ezInt32 iPathLength = 0;
+
+  if (dtStatusSucceed(status))
+  {
+    request.m_Path.SetCountUninitialized(MaxPathLength);
+    status = pQuery->finalizeSlicedFindPath(request.m_Path.GetData(), &iPathLength, MaxPathLength);
+  }
+
+  if (dtStatusFailed(status) || iPathLength <= 0)
+  {
+    request.m_Path.Clear();
+    request.m_State = ezRecastPathRequestState::Failed;
+    return;
+  }
+
+  request.m_Path.SetCountUninitialized(iPathLength);
+
+  // if the path does not end in the target polygon, the target cannot be reached, but one can get close to it
+  request.m_bPartialPath = request.m_Path.PeekBack() != request.m_EndPoly;
+  request.m_State = ezRecastPathRequestState::Finished;
+}
+
+void ezRecastWorldModule::AddToPathCache(const PathRequest& request)
+{
+  const ezUInt64 uiKey = GetPathCacheKey(request.m_StartPoly, request.m_EndPoly);
+
+  if (m_PathCache.GetCount() >= MaxCachedPaths && !m_PathCache.Contains(uiKey))
+  {
+    // evict the path that was not used for the longest time
+    auto itOldest = m_PathCache.GetIterator();
+    for (auto it = m_PathCache.GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Value().m_uiLastUsedFrame < itOldest.Value().m_uiLastUsedFrame)
+      {
+        itOldest = it;
+      }
+    }
+
+    m_PathCache.Remove(itOldest);
+  }
+
+  CachedPath& cachedPath = m_PathCache[uiKey];
+  cachedPath.m_Path = request.m_Path;
+  cachedPath.m_bPartialPath = request.m_bPartialPath;
+  cachedPath.m_uiLastUsedFrame = m_uiPathRequestFrame;
+}
+
+void ezRecastWorldModule::ResetPathRequests()
+{
+  // the polygon references of all requests belong to the previous navmesh
+  for (auto it = m_PathRequests.GetIterator(); it.IsValid(); ++it)
+  {
+    PathRequest& request = it.Value();
+    request.m_pQuery = nullptr;
+
+    if (request.m_State == ezRecastPathRequestState::Pending)
+    {
+      request.m_Path.Clear();
+      request.m_State = ezRecastPathRequestState::Failed;
+    }
+  }
+
+  m_QueuedPathRequests.Clear();
+  m_ActivePathRequests.Clear();
+  m_FreePathQueries.Clear();
+  m_PathQueries.Clear();
+  m_PathCache.Clear();
+}
+
 void ezRecastWorldModule::ResourceEventHandler(const ezResourceEvent& e)
 {
   if (e.m_Type == ezResourceEvent::Type::ResourceContentUnloading && e.m_pResource->GetDynamicRTTI()->IsDerivedFrom<ezRecastNavMeshResource>())
   {
     // triggers a recreation in the next update
     m_pDetourNavMesh = nullptr;
+    m_bNavMeshChanged = true;
   }
 }
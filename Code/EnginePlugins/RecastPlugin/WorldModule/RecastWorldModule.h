@@ -4,7 +4,11 @@
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/WorldModule.h>
-#include <NavMeshBuilder/NavMeshPointsOfInterest.h>
+#include <Foundation/Containers/IdTable.h>
+#include <Foundation/Types/Id.h>
+#include <RecastPlugin/NavMeshBuilder/NavMeshPointsOfInterest.h>
+#include <Recast/DetourNavMeshQuery.h>
+#include <RecastPlugin/Utils/RcMath.h>
 
 class dtCrowd;
 class dtNavMesh;
@@ -12,6 +16,25 @@ struct ezResourceEvent;
 
 typedef ezTypedResourceHandle<class ezRecastNavMeshResource> ezRecastNavMeshResourceHandle;
 
+/// \brief Identifies a path request, see ezRecastWorldModule::RequestPath()
+typedef ezGenericId<24, 8> ezRecastPathRequestId;
+
+/// \brief The state of a path request, see ezRecastWorldModule::RetrievePathRequestResult()
+struct ezRecastPathRequestState
+{
+  typedef ezUInt8 StorageType;
+
+  enum Enum
+  {
+    Invalid,  ///< The request does not exist, either it was never made, was canceled or its result was already retrieved
+    Pending,  ///< The path search has not finished yet
+    Finished, ///< A path was found, though it may only lead close to the target
+    Failed,   ///< No path could be found
+
+    Default = Invalid
+  };
+};
+
 class EZ_RECASTPLUGIN_DLL ezRecastWorldModule : public ezWorldModule
 {
   EZ_DECLARE_WORLD_MODULE();
@@ -31,11 +54,57 @@ public:
   const ezNavMeshPointOfInterestGraph* GetNavMeshPointsOfInterestGraph() const { return m_pNavMeshPointsOfInterest.Borrow(); }
   ezNavMeshPointOfInterestGraph* AccessNavMeshPointsOfInterestGraph() const { return m_pNavMeshPointsOfInterest.Borrow(); }
 
+  /// \brief Queues a path search between the two navmesh polygons. The positions are in world space.
+  ///
+  /// The searches are time sliced over several frames and run in parallel on the worker threads. Poll for the result with
+  /// RetrievePathRequestResult(). Paths between the same pair of polygons are cached, so many agents going to the same place are cheap.
+  ezRecastPathRequestId RequestPath(dtPolyRef startPoly, dtPolyRef endPoly, const ezVec3& vStartPos, const ezVec3& vEndPos);
+
+  /// \brief Returns the state of the request. Once it is finished, the path is written to out_Path and the request is removed.
+  ezRecastPathRequestState::Enum RetrievePathRequestResult(ezRecastPathRequestId requestId, ezDynamicArray<dtPolyRef>& out_Path, bool& out_bPartialPath);
+
+  /// \brief Removes the request, its result will not be computed or will be discarded.
+  void CancelPathRequest(ezRecastPathRequestId requestId);
+
 private:
+  struct PathRequest
+  {
+    dtPolyRef m_StartPoly = 0;
+    dtPolyRef m_EndPoly = 0;
+    ezRcPos m_vStartPos;
+    ezRcPos m_vEndPos;
+    ezEnum<ezRecastPathRequestState> m_State;
+    bool m_bPartialPath = false;
+    bool m_bSearchStarted = false;
+    dtNavMeshQuery* m_pQuery = nullptr; ///< Only set while the search is in progress
+    ezDynamicArray<dtPolyRef> m_Path;
+  };
+
+  struct CachedPath
+  {
+    ezDynamicArray<dtPolyRef> m_Path;
+    bool m_bPartialPath = false;
+    ezUInt64 m_uiLastUsedFrame = 0;
+  };
+
   void UpdateNavMesh(const UpdateContext& ctxt);
+  void UpdatePathRequests(const UpdateContext& ctxt);
+  void ContinuePathSearch(PathRequest& request) const;
+  void AddToPathCache(const PathRequest& request);
+  void ResetPathRequests();
   void ResourceEventHandler(const ezResourceEvent& e);
 
   const dtNavMesh* m_pDetourNavMesh = nullptr;
   ezRecastNavMeshResourceHandle m_hNavMesh;
   ezUniquePtr<ezNavMeshPointOfInterestGraph> m_pNavMeshPointsOfInterest;
+
+  bool m_bNavMeshChanged = false;  ///< Set whenever the navmesh is unloaded or acquired, the queries and the cached paths are reset then
+  dtQueryFilter m_PathQueryFilter; /// \todo hard-coded filter
+  ezIdTable<ezRecastPathRequestId, PathRequest> m_PathRequests;
+  ezDeque<ezRecastPathRequestId> m_QueuedPathRequests;
+  ezDynamicArray<ezRecastPathRequestId> m_ActivePathRequests;
+  ezDynamicArray<ezUniquePtr<dtNavMeshQuery>> m_PathQueries; // careful, dtNavMeshQuery is not moveble
+  ezDynamicArray<dtNavMeshQuery*> m_FreePathQueries;
+  ezHashTable<ezUInt64, CachedPath> m_PathCache;
+  ezUInt64 m_uiPathRequestFrame = 0;
 };
@@ -130,23 +130,16 @@ ezResult ezShaderCompilerApplication::CompileShader(const char* szShaderFile)
   if (ExtractPermutationVarValues(szShaderFile).Failed())
     return EZ_FAILURE;
 
-  ezHybridArray<ezPermutationVar, 16> PermVars;
-
   const ezUInt32 uiMaxPerms = m_PermutationGenerator.GetPermutationCount();
 
   ezLog::Info("Shader has {0} permutations", uiMaxPerms);
 
-  for (ezUInt32 perm = 0; perm < uiMaxPerms; ++perm)
-  {
-    EZ_LOG_BLOCK("Compiling Permutation");
-
-    m_PermutationGenerator.GetPermutation(perm, PermVars);
-    ezShaderCompiler sc;
-    if (sc.CompileShaderPermutationForPlatforms(szShaderFile, PermVars, ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
-      return EZ_FAILURE;
-  }
+  if (m_ShaderCompiler.CompileShaderPermutationsForPlatforms(szShaderFile, m_PermutationGenerator, ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
+    return EZ_FAILURE;
 
-  ezLog::Success("Compiled Shader '{0}'", szShaderFile);
+  const ezShaderCompiler::Stats& stats = m_ShaderCompiler.GetStats();
+  ezLog::Success("Compiled Shader '{0}' ({1} of {2} stage sources compiled, preprocessing: {3}ms, compilation: {4}ms)", szShaderFile, stats.m_uiNumCompiledStages,
+    stats.m_uiNumStageSources, ezArgF(stats.m_PreprocessingTime.GetMilliseconds(), 1), ezArgF(stats.m_CompilationTime.GetMilliseconds(), 1));
   return EZ_SUCCESS;
 }
 
@@ -2,6 +2,7 @@
 
 #include <GameEngine/GameApplication/GameApplication.h>
 #include <RendererCore/ShaderCompiler/PermutationGenerator.h>
+#include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 
 class ezShaderCompilerApplication : public ezGameApplication
 {
@@ -27,6 +28,10 @@ private:
   virtual bool Run_ProcessApplicationInput() override { return true; }
 
   ezPermutationGenerator m_PermutationGenerator;
+
+  // shared by all shaders, so that common include files are only read and tokenized once
+  ezShaderCompiler m_ShaderCompiler;
+
   ezString m_sPlatforms;
   ezString m_sShaderFiles;
   ezMap<ezString, ezHybridArray<ezString, 4>> m_FixedPermVars;
@@ -87,6 +87,8 @@ ezCommandLineOptionEnum opt_Type("_TexConv", "-type", "The type of output to gen
 
 ezCommandLineOptionEnum opt_Compression("_TexConv", "-compression", "Compression strength for output format.", "Medium = 1 | High = 2 | None = 0", 1);
 
+ezCommandLineOptionEnum opt_CompressionQuality("_TexConv", "-compressionQuality", "Quality of the built-in block compressors. 'Fast' trades quality for speed.", "High = 1 | Fast = 0", 1);
+
 ezCommandLineOptionEnum opt_Usage("_TexConv", "-usage", "What type of data the image contains. Affects which final output format is used and how mipmaps are generated.", "Auto = 0 | Color = 1 | Linear = 2 | HDR = 3 | NormalMap = 4 | NormalMap_Inverted = 5 | BumpMap = 6", 0);
 
 ezCommandLineOptionEnum opt_Mipmaps("_TexConv", "-mipmaps", "Whether to generate mipmaps and with which algorithm.", "None = 0 |Linear = 1 | Kaisser = 2", 1);
@@ -347,6 +349,10 @@ ezResult ezTexConv::ParseCompressionMode()
   const ezInt32 value = opt_Compression.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
   m_Processor.m_Descriptor.m_CompressionMode = static_cast<ezTexConvCompressionMode::Enum>(value);
+
+  const ezInt32 quality = opt_CompressionQuality.GetOptionValue(ezCommandLineOption::LogMode::AlwaysIfSpecified);
+
+  m_Processor.m_Descriptor.m_CompressionQuality = static_cast<ezBlockCompressionQuality::Enum>(quality);
   return EZ_SUCCESS;
 }
 
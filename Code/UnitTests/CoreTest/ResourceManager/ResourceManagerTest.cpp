@@ -171,6 +171,16 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
 
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumResources);
 
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    const auto stats = ezResourceManager::GetResourceTypeLoadingStats(ezGetStaticRTTI<TestResource>());
+    EZ_TEST_INT(stats.m_uiQueueDepth, 0);
+    EZ_TEST_BOOL(stats.m_uiNumLoads >= uiNumResources);
+    EZ_TEST_BOOL(stats.m_MaxLoadLatency <= stats.m_TotalLoadLatency);
+
     hResources.Clear();
 
     ezUInt32 uiUnloaded = 0;
@@ -190,6 +200,67 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
   }
 }
 
+EZ_CREATE_SIMPLE_TEST(ResourceManager, ParallelLoading)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::AllowResourceTypeAcquireDuringUpdateContent<TestResource, TestResource>();
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  const ezInt32 iShortTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezInt32 iLongTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+  const ezInt32 iFileAccessTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::FileAccess);
+  ezTaskSystem::SetWorkerThreadCount(iShortTasks, iLongTasks, 4);
+  EZ_SCOPE_EXIT(ezTaskSystem::SetWorkerThreadCount(iShortTasks, iLongTasks, iFileAccessTasks));
+
+  EZ_TEST_INT(ezResourceManager::GetMaxParallelDataLoadTasks(), 4);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Main")
+  {
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+
+    const ezUInt32 uiNumResources = 200;
+
+    ezDynamicArray<TestResourceHandle> hResources;
+    hResources.Reserve(uiNumResources);
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.Format("NonBlockingLevel1-{}", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+    }
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      ezResourceManager::PreloadResource(hResources[i]);
+    }
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      ezResourceLock<TestResource> pTestResource(hResources[i], ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+
+      EZ_TEST_BOOL(pTestResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+
+      pTestResource->Test();
+    }
+
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumResources + 1);
+
+    hResources.Clear();
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    EZ_TEST_INT(ezResourceManager::GetResourceTypeLoadingStats(ezGetStaticRTTI<TestResource>()).m_uiQueueDepth, 0);
+
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+}
+
 EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
 {
   TestResourceTypeLoader TypeLoader;
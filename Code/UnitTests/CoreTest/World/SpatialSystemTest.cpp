@@ -1,6 +1,7 @@
 #include <CoreTestPCH.h>
 
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
 #include <Core/World/World.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
@@ -55,197 +56,310 @@ namespace
   }
   EZ_END_COMPONENT_TYPE;
   // clang-format on
-} // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
-{
-  ezWorldDesc worldDesc("Test");
-  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  void TestSpatialSystem(ezUniquePtr<ezSpatialSystem>&& pSpatialSystem)
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+    worldDesc.m_pSpatialSystem = std::move(pSpatialSystem);
 
-  ezWorld world(worldDesc);
-  EZ_LOCK(world.GetWriteMarker());
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
 
-  auto& rng = world.GetRandomNumberGenerator();
-  double range = 10000.0;
+    auto& rng = world.GetRandomNumberGenerator();
+    double range = 10000.0;
 
-  ezDynamicArray<ezGameObject*> objects;
-  objects.Reserve(1000);
+    ezDynamicArray<ezGameObject*> objects;
+    objects.Reserve(1000);
 
-  for (ezUInt32 i = 0; i < 1000; ++i)
-  {
-    float x = (float)rng.DoubleMinMax(-range, range);
-    float y = (float)rng.DoubleMinMax(-range, range);
-    float z = (float)rng.DoubleMinMax(-range, range);
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      float x = (float)rng.DoubleMinMax(-range, range);
+      float y = (float)rng.DoubleMinMax(-range, range);
+      float z = (float)rng.DoubleMinMax(-range, range);
 
-    ezGameObjectDesc desc;
-    desc.m_bDynamic = (i >= 500);
-    desc.m_LocalPosition = ezVec3(x, y, z);
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = (i >= 500);
+      desc.m_LocalPosition = ezVec3(x, y, z);
 
-    ezGameObject* pObject = nullptr;
-    world.CreateObject(desc, pObject);
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
 
-    objects.PushBack(pObject);
+      objects.PushBack(pObject);
 
-    TestBoundsComponent* pComponent = nullptr;
-    TestBoundsComponent::CreateComponent(pObject, pComponent);
-  }
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+    }
 
-  world.Update();
+    world.Update();
 
-  ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+    ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInSphere")
-  {
-    ezBoundingSphere testSphere(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInSphere")
+    {
+      ezBoundingSphere testSphere(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
 
-    ezDynamicArray<ezGameObject*> objectsInSphere;
-    ezHashSet<ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, objectsInSphere);
+      ezDynamicArray<ezGameObject*> objectsInSphere;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, objectsInSphere);
 
-    for (auto pObject : objectsInSphere)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
+
+      objectsInSphere.Clear();
+      uniqueObjects.Clear();
+
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, [&](ezGameObject* pObject) {
+        objectsInSphere.PushBack(pObject);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
 
-      EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsStatic());
+        return ezVisitorExecution::Continue;
+      });
+
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
     {
-      ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
-      if (testSphere.Overlaps(objSphere))
+      ezBoundingBox testBox;
+      testBox.SetCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
+
+      ezDynamicArray<ezGameObject*> objectsInBox;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, objectsInBox);
+
+      for (auto pObject : objectsInBox)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        ezBoundingBox objBox = pObject->GetGlobalBounds().GetBox();
+
+        EZ_TEST_BOOL(testBox.Overlaps(objBox));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
       }
-    }
 
-    objectsInSphere.Clear();
-    uniqueObjects.Clear();
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
+        if (testBox.Overlaps(objBox))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
 
-    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, [&](ezGameObject* pObject) {
-      objectsInSphere.PushBack(pObject);
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      objectsInBox.Clear();
+      uniqueObjects.Clear();
 
-      return ezVisitorExecution::Continue;
-    });
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, [&](ezGameObject* pObject) {
+        objectsInBox.PushBack(pObject);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
 
-    for (auto pObject : objectsInSphere)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+        return ezVisitorExecution::Continue;
+      });
+
+      for (auto pObject : objectsInBox)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
 
-      EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
-      EZ_TEST_BOOL(pObject->IsStatic());
+        EZ_TEST_BOOL(testBox.Overlaps(objSphere));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
+        if (testBox.Overlaps(objBox))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects")
     {
-      ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
-      if (testSphere.Overlaps(objSphere))
+      // Add enough objects for the culling to be distributed across several tasks
+      for (ezUInt32 i = 0; i < 10000; ++i)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        float x = (float)rng.DoubleMinMax(0.0, range);
+        float y = (float)rng.DoubleMinMax(-range * 0.5, range * 0.5);
+        float z = (float)rng.DoubleMinMax(-range * 0.5, range * 0.5);
+
+        ezGameObjectDesc desc;
+        desc.m_LocalPosition = ezVec3(x, y, z);
+
+        ezGameObject* pObject = nullptr;
+        world.CreateObject(desc, pObject);
+
+        TestBoundsComponent* pComponent = nullptr;
+        TestBoundsComponent::CreateComponent(pObject, pComponent);
       }
-    }
-  }
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
-  {
-    ezBoundingBox testBox;
-    testBox.SetCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
+      world.Update();
 
-    ezDynamicArray<ezGameObject*> objectsInBox;
-    ezHashSet<ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, objectsInBox);
+      ezFrustum frustums[4];
+      frustums[0].SetFrustum(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1), ezAngle::Degree(90.0f), ezAngle::Degree(90.0f), 0.1f, 10000.0f);
+      frustums[1].SetFrustum(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(0, 1, 0), ezVec3(0, 0, 1), ezAngle::Degree(60.0f), ezAngle::Degree(40.0f), 1.0f, 3000.0f);
+      frustums[2].SetFrustum(ezVec3(-5000.0f, 0.0f, 0.0f), ezVec3(1, 0, 0), ezVec3(0, 0, 1), ezAngle::Degree(30.0f), ezAngle::Degree(30.0f), 1.0f, 20000.0f);
+      frustums[3].SetFrustum(ezVec3(0.0f, 0.0f, 50000.0f), ezVec3(0, 0, 1), ezVec3(0, 1, 0), ezAngle::Degree(90.0f), ezAngle::Degree(90.0f), 1.0f, 100.0f);
 
-    for (auto pObject : objectsInBox)
-    {
-      ezBoundingBox objBox = pObject->GetGlobalBounds().GetBox();
+      ezDynamicArray<const ezGameObject*> visibleObjects[4];
+      world.GetSpatialSystem()->FindVisibleObjects(ezMakeArrayPtr(frustums), uiCategoryBitmask, ezMakeArrayPtr(visibleObjects));
 
-      EZ_TEST_BOOL(testBox.Overlaps(objBox));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsStatic());
+      for (ezUInt32 f = 0; f < EZ_ARRAY_SIZE(frustums); ++f)
+      {
+        ezHashSet<const ezGameObject*> uniqueObjects;
+
+        for (auto pObject : visibleObjects[f])
+        {
+          EZ_TEST_BOOL(frustums[f].GetObjectPosition(pObject->GetGlobalBounds().GetSphere()) != ezVolumePosition::Outside);
+          EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+          EZ_TEST_BOOL(pObject->IsStatic());
+        }
+
+        // Check for missing objects
+        for (auto it = world.GetObjects(); it.IsValid(); ++it)
+        {
+          if (frustums[f].GetObjectPosition(it->GetGlobalBounds().GetSphere()) == ezVolumePosition::Inside)
+          {
+            EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+          }
+        }
+
+        // Culling a single frustum must give the same result in the same order
+        ezDynamicArray<const ezGameObject*> singleVisibleObjects;
+        world.GetSpatialSystem()->FindVisibleObjects(frustums[f], uiCategoryBitmask, singleVisibleObjects);
+
+        EZ_TEST_BOOL(singleVisibleObjects == visibleObjects[f]);
+      }
+
+      EZ_TEST_BOOL(visibleObjects[0].GetCount() > 4000);
+      EZ_TEST_BOOL(visibleObjects[3].IsEmpty());
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Moving Objects")
     {
-      ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
-      if (testBox.Overlaps(objBox))
+      for (ezUInt32 i = 500; i < objects.GetCount(); ++i)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        float x = (float)rng.DoubleMinMax(-range, range);
+        float y = (float)rng.DoubleMinMax(-range, range);
+        float z = (float)rng.DoubleMinMax(-range, range);
+
+        objects[i]->SetLocalPosition(ezVec3(x, y, z));
       }
-    }
 
-    objectsInBox.Clear();
-    uniqueObjects.Clear();
+      world.Update();
 
-    world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, [&](ezGameObject* pObject) {
-      objectsInBox.PushBack(pObject);
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      ezBoundingSphere testSphere(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
+      ezUInt32 uiDynamicCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
 
-      return ezVisitorExecution::Continue;
-    });
+      ezDynamicArray<ezGameObject*> objectsInSphere;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiDynamicCategoryBitmask, objectsInSphere);
 
-    for (auto pObject : objectsInBox)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsDynamic());
+      }
 
-      EZ_TEST_BOOL(testBox.Overlaps(objSphere));
-      EZ_TEST_BOOL(pObject->IsStatic());
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsStatic() || uniqueObjects.Contains(it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    if (false)
     {
-      ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
-      if (testBox.Overlaps(objBox))
+      ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+      ezFileWriter fileWriter;
+      if (fileWriter.Open(":output/profiling.json") == EZ_SUCCESS)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        ezProfilingSystem::ProfilingData profilingData;
+        ezProfilingSystem::Capture(profilingData);
+        profilingData.Write(fileWriter).IgnoreResult();
+        ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
       }
     }
-  }
-
-  if (false)
-  {
-    ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
-    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
 
-    ezFileWriter fileWriter;
-    if (fileWriter.Open(":output/profiling.json") == EZ_SUCCESS)
+    // Test multiple categories for spatial data
+    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
     {
-      ezProfilingSystem::ProfilingData profilingData;
-      ezProfilingSystem::Capture(profilingData);
-      profilingData.Write(fileWriter).IgnoreResult();
-      ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
+      ezGameObject* pObject = objects[i];
+
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+      pComponent->m_SpecialCategory = s_SpecialTestCategory;
     }
-  }
 
-  // Test multiple categories for spatial data
-  for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
-  {
-    ezGameObject* pObject = objects[i];
+    world.Update();
 
-    TestBoundsComponent* pComponent = nullptr;
-    TestBoundsComponent::CreateComponent(pObject, pComponent);
-    pComponent->m_SpecialCategory = s_SpecialTestCategory;
-  }
+    ezDynamicArray<ezGameObjectHandle> allObjects;
+    allObjects.Reserve(world.GetObjectCount());
 
-  world.Update();
+    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    {
+      allObjects.PushBack(it->GetHandle());
+    }
 
-  ezDynamicArray<ezGameObjectHandle> allObjects;
-  allObjects.Reserve(world.GetObjectCount());
+    for (ezUInt32 i = allObjects.GetCount(); i-- > 0;)
+    {
+      world.DeleteObjectNow(allObjects[i]);
+    }
 
-  for (auto it = world.GetObjects(); it.IsValid(); ++it)
-  {
-    allObjects.PushBack(it->GetHandle());
+    world.Update();
   }
+} // namespace
 
-  for (ezUInt32 i = allObjects.GetCount(); i-- > 0;)
-  {
-    world.DeleteObjectNow(allObjects[i]);
-  }
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  // nullptr means the world creates its default spatial system
+  TestSpatialSystem(nullptr);
+}
 
-  world.Update();
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem_LooseOctree)
+{
+  TestSpatialSystem(EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_LooseOctree));
 }
@@ -0,0 +1,228 @@
+#include <CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Utilities/Stats.h>
+
+namespace
+{
+  // The declared types only serve as tokens for the data an update function accesses, any distinct types work.
+  const ezRTTI* GetDataA() { return ezGetStaticRTTI<ezVec3>(); }
+  const ezRTTI* GetDataB() { return ezGetStaticRTTI<ezQuat>(); }
+
+  enum
+  {
+    WriteA,
+    WriteB,
+    ReadAB,
+    Barrier,
+    ReadA1,
+    ReadA2,
+    AsyncFirst,
+    AsyncSecond,
+    FunctionCount
+  };
+
+  class UpdateGraphTestComponent;
+  class UpdateGraphTestComponentManager : public ezComponentManager<UpdateGraphTestComponent, ezBlockStorageType::FreeList>
+  {
+  public:
+    UpdateGraphTestComponentManager(ezWorld* pWorld)
+      : ezComponentManager<UpdateGraphTestComponent, ezBlockStorageType::FreeList>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto descWriteA = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateWriteA, this);
+      descWriteA.m_WritesTo.PushBack(GetDataA());
+      descWriteA.m_fPriority = 5.0f;
+
+      auto descWriteB = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateWriteB, this);
+      descWriteB.m_WritesTo.PushBack(GetDataB());
+      descWriteB.m_fPriority = 4.0f;
+
+      auto descReadAB = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateReadAB, this);
+      descReadAB.m_ReadsFrom.PushBack(GetDataA());
+      descReadAB.m_ReadsFrom.PushBack(GetDataB());
+      descReadAB.m_fPriority = 3.0f;
+
+      // no declaration, has to wait for everything before it and blocks everything after it
+      auto descBarrier = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateBarrier, this);
+      descBarrier.m_fPriority = 2.0f;
+
+      auto descReadA1 = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateReadA1, this);
+      descReadA1.m_ReadsFrom.PushBack(GetDataA());
+      descReadA1.m_fPriority = 1.0f;
+
+      auto descReadA2 = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateReadA2, this);
+      descReadA2.m_ReadsFrom.PushBack(GetDataA());
+
+      auto descAsyncFirst = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateAsyncFirst, this);
+      descAsyncFirst.m_Phase = ezComponentManagerBase::UpdateFunctionDesc::Phase::Async;
+
+      auto descAsyncSecond = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(UpdateGraphTestComponentManager::UpdateAsyncSecond, this);
+      descAsyncSecond.m_Phase = ezComponentManagerBase::UpdateFunctionDesc::Phase::Async;
+      descAsyncSecond.m_DependsOn.PushBack(ezMakeHashedString("UpdateGraphTestComponentManager::UpdateAsyncFirst"));
+      descAsyncSecond.m_fPriority = 1.0f; // would run first without the dependency
+
+      this->RegisterUpdateFunction(descAsyncSecond);
+      this->RegisterUpdateFunction(descAsyncFirst);
+      this->RegisterUpdateFunction(descReadA2);
+      this->RegisterUpdateFunction(descReadA1);
+      this->RegisterUpdateFunction(descBarrier);
+      this->RegisterUpdateFunction(descReadAB);
+      this->RegisterUpdateFunction(descWriteB);
+      this->RegisterUpdateFunction(descWriteA);
+    }
+
+    void UpdateWriteA(const ezWorldModule::UpdateContext& context)
+    {
+      // give the other independent function the chance to start concurrently
+      if (m_bWaitForWriteB)
+      {
+        const ezTime endTime = ezTime::Now() + ezTime::Seconds(2);
+        while (m_Started[WriteB] == 0 && ezTime::Now() < endTime)
+        {
+          ezThreadUtils::YieldTimeSlice();
+        }
+
+        m_bWriteBWasConcurrent = m_Started[WriteB] != 0;
+
+        // make sure this is the branch that finishes last
+        ezThreadUtils::Sleep(ezTime::Milliseconds(5));
+      }
+
+      Finish(WriteA);
+    }
+
+    void UpdateWriteB(const ezWorldModule::UpdateContext& context)
+    {
+      m_Started[WriteB] = 1;
+      Finish(WriteB);
+    }
+
+    void UpdateReadAB(const ezWorldModule::UpdateContext& context) { Finish(ReadAB); }
+
+    void UpdateBarrier(const ezWorldModule::UpdateContext& context)
+    {
+      m_bBarrierOnMainThread = ezThreadUtils::IsMainThread();
+      Finish(Barrier);
+    }
+
+    void UpdateReadA1(const ezWorldModule::UpdateContext& context) { Finish(ReadA1); }
+    void UpdateReadA2(const ezWorldModule::UpdateContext& context) { Finish(ReadA2); }
+    void UpdateAsyncFirst(const ezWorldModule::UpdateContext& context) { Finish(AsyncFirst); }
+    void UpdateAsyncSecond(const ezWorldModule::UpdateContext& context) { Finish(AsyncSecond); }
+
+    void Reset(bool bWaitForWriteB)
+    {
+      m_Counter = 0;
+      for (ezUInt32 i = 0; i < FunctionCount; ++i)
+      {
+        m_Started[i] = 0;
+        m_Finished[i] = 0;
+      }
+
+      m_bWaitForWriteB = bWaitForWriteB;
+      m_bWriteBWasConcurrent = false;
+      m_bBarrierOnMainThread = false;
+    }
+
+    void Finish(ezUInt32 uiFunction) { m_Finished[uiFunction] = m_Counter.Increment(); }
+
+    ezAtomicInteger32 m_Counter;
+    ezAtomicInteger32 m_Started[FunctionCount];
+    ezAtomicInteger32 m_Finished[FunctionCount];
+    bool m_bWaitForWriteB = false;
+    bool m_bWriteBWasConcurrent = false;
+    bool m_bBarrierOnMainThread = false;
+  };
+
+  class UpdateGraphTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(UpdateGraphTestComponent, ezComponent, UpdateGraphTestComponentManager);
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(UpdateGraphTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  void CheckOrder(const UpdateGraphTestComponentManager& manager)
+  {
+    for (ezUInt32 i = 0; i < FunctionCount; ++i)
+    {
+      EZ_TEST_BOOL(manager.m_Finished[i] != 0);
+    }
+
+    EZ_TEST_BOOL(manager.m_Finished[ReadAB] > manager.m_Finished[WriteA]);
+    EZ_TEST_BOOL(manager.m_Finished[ReadAB] > manager.m_Finished[WriteB]);
+    EZ_TEST_BOOL(manager.m_Finished[Barrier] > manager.m_Finished[ReadAB]);
+    EZ_TEST_BOOL(manager.m_Finished[ReadA1] > manager.m_Finished[Barrier]);
+    EZ_TEST_BOOL(manager.m_Finished[ReadA2] > manager.m_Finished[Barrier]);
+    EZ_TEST_BOOL(manager.m_Finished[AsyncSecond] > manager.m_Finished[AsyncFirst]);
+    EZ_TEST_BOOL(manager.m_bBarrierOnMainThread);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, UpdateFunctionGraph)
+{
+  ezCVarBool* pParallelCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("world_ParallelUpdateFunctions"));
+  if (!EZ_TEST_BOOL(pParallelCVar != nullptr))
+    return;
+
+  const bool bPrevParallel = *pParallelCVar;
+
+  ezWorldDesc worldDesc("UpdateGraph");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  UpdateGraphTestComponentManager* pManager = world.GetOrCreateComponentManager<UpdateGraphTestComponentManager>();
+
+  // async update functions are only called when there are components
+  ezGameObjectDesc desc;
+  ezGameObject* pObject = nullptr;
+  world.CreateObject(desc, pObject);
+
+  UpdateGraphTestComponent* pComponent = nullptr;
+  pManager->CreateComponent(pObject, pComponent);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sequential")
+  {
+    *pParallelCVar = false;
+
+    pManager->Reset(false);
+    world.Update();
+
+    CheckOrder(*pManager);
+
+    // without the dependency graph the registration order is kept exactly
+    for (ezUInt32 i = WriteA; i < ReadA2; ++i)
+    {
+      EZ_TEST_INT(pManager->m_Finished[i + 1], pManager->m_Finished[i] + 1);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel")
+  {
+    *pParallelCVar = true;
+
+    pManager->Reset(true);
+    world.Update();
+
+    CheckOrder(*pManager);
+    EZ_TEST_BOOL(pManager->m_bWriteBWasConcurrent);
+
+    ezStringBuilder sStatName;
+    sStatName.Format("World Update/{0}/Critical Path/Pre-Async", world.GetName());
+
+    // WriteA waits for WriteB, so it is the longer branch before ReadAB
+    ezStringBuilder sCriticalPath = ezStats::GetStat(sStatName).ConvertTo<ezString>();
+    EZ_TEST_BOOL(sCriticalPath.FindSubString("UpdateWriteA") != nullptr);
+    EZ_TEST_BOOL(sCriticalPath.FindSubString("UpdateReadAB") != nullptr);
+    EZ_TEST_BOOL(sCriticalPath.FindSubString("UpdateBarrier") != nullptr);
+    EZ_TEST_BOOL(sCriticalPath.FindSubString("UpdateWriteB") == nullptr);
+  }
+
+  *pParallelCVar = bPrevParallel;
+}
@@ -1,6 +1,10 @@
 #include <CoreTestPCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
 
@@ -115,6 +119,180 @@ namespace
     }
   }
 
+  /// Fills the spatial system with an open world like distribution: many small props, fewer buildings and huge terrain chunks.
+  void FillSpatialSystem(ezSpatialSystem& spatialSystem, ezUInt32 uiNumSmallObjects)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+    const float fWorldHalfSize = 4000.0f;
+
+    auto AddObject = [&](const ezVec3& vCenter, const ezVec3& vHalfExtents) {
+      ezSimdBBox box;
+      box.SetCenterAndHalfExtents(ezSimdConversion::ToVec3(vCenter), ezSimdConversion::ToVec3(vHalfExtents));
+
+      ezSimdBBoxSphere bounds(box);
+      bounds.m_BoxHalfExtents.SetW(ezSimdFloat::Zero());
+
+      spatialSystem.CreateSpatialData(bounds, nullptr, uiCategoryBitmask);
+    };
+
+    // terrain chunks, 1km in size
+    for (float y = -fWorldHalfSize; y < fWorldHalfSize; y += 1000.0f)
+    {
+      for (float x = -fWorldHalfSize; x < fWorldHalfSize; x += 1000.0f)
+      {
+        AddObject(ezVec3(x + 500.0f, y + 500.0f, 0.0f), ezVec3(500.0f, 500.0f, 100.0f));
+      }
+    }
+
+    // buildings
+    for (ezUInt32 i = 0; i < uiNumSmallObjects / 50; ++i)
+    {
+      ezVec3 vPos((float)rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize), (float)rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize), 0.0f);
+      float fSize = (float)rng.DoubleMinMax(10.0, 60.0);
+      AddObject(vPos, ezVec3(fSize, fSize, fSize * 0.5f));
+    }
+
+    // small props
+    for (ezUInt32 i = 0; i < uiNumSmallObjects; ++i)
+    {
+      ezVec3 vPos((float)rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize), (float)rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize),
+        (float)rng.DoubleMinMax(0.0, 50.0));
+      float fSize = (float)rng.DoubleMinMax(0.25, 4.0);
+      AddObject(vPos, ezVec3(fSize));
+    }
+  }
+
+  void MeasureSpatialSystemQueries(ezSpatialSystem& spatialSystem, const char* szName)
+  {
+    const ezUInt32 uiNumSmallObjects = 200000;
+    const ezUInt32 uiNumQueries = 100;
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    {
+      ezStopwatch sw;
+      FillSpatialSystem(spatialSystem, uiNumSmallObjects);
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: Inserting %u objects: %.2fms", szName, uiNumSmallObjects, sw.GetRunningTotal().GetMilliseconds());
+    }
+
+    ezRandom rng;
+    rng.Initialize(23);
+
+    {
+      ezDynamicArray<const ezGameObject*> visibleObjects;
+      ezUInt32 uiNumVisible = 0;
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+      {
+        ezVec3 vPos((float)rng.DoubleMinMax(-3000.0, 3000.0), (float)rng.DoubleMinMax(-3000.0, 3000.0), (float)rng.DoubleMinMax(2.0, 20.0));
+        ezAngle dir = ezAngle::Degree((float)rng.DoubleMinMax(0.0, 360.0));
+
+        ezFrustum frustum;
+        frustum.SetFrustum(vPos, ezVec3(ezMath::Cos(dir), ezMath::Sin(dir), 0.0f), ezVec3(0, 0, 1), ezAngle::Degree(90.0f), ezAngle::Degree(60.0f), 0.1f, 1000.0f);
+
+        visibleObjects.Clear();
+        spatialSystem.FindVisibleObjects(frustum, uiCategoryBitmask, visibleObjects);
+        uiNumVisible += visibleObjects.GetCount();
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %u frustum queries (%u objects visible on average): %.2fms", szName, uiNumQueries,
+        uiNumVisible / uiNumQueries, sw.GetRunningTotal().GetMilliseconds());
+    }
+
+    {
+      // Four shadow cascades, either culled one after the other or all at once.
+      ezFrustum cascades[4];
+      ezDynamicArray<const ezGameObject*> visibleObjects[4];
+      ezUInt32 uiNumVisible = 0;
+
+      ezTime separateTime;
+      ezTime combinedTime;
+
+      for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+      {
+        ezVec3 vPos((float)rng.DoubleMinMax(-3000.0, 3000.0), (float)rng.DoubleMinMax(-3000.0, 3000.0), (float)rng.DoubleMinMax(2.0, 20.0));
+        ezAngle dir = ezAngle::Degree((float)rng.DoubleMinMax(0.0, 360.0));
+        ezVec3 vDir(ezMath::Cos(dir), ezMath::Sin(dir), 0.0f);
+
+        const float fSplits[] = {0.1f, 50.0f, 150.0f, 400.0f, 1000.0f};
+        for (ezUInt32 c = 0; c < 4; ++c)
+        {
+          cascades[c].SetFrustum(vPos, vDir, ezVec3(0, 0, 1), ezAngle::Degree(90.0f), ezAngle::Degree(60.0f), fSplits[c], fSplits[c + 1]);
+        }
+
+        ezStopwatch sw;
+
+        for (ezUInt32 c = 0; c < 4; ++c)
+        {
+          visibleObjects[c].Clear();
+          spatialSystem.FindVisibleObjects(cascades[c], uiCategoryBitmask, visibleObjects[c]);
+        }
+
+        separateTime += sw.Checkpoint();
+
+        for (ezUInt32 c = 0; c < 4; ++c)
+        {
+          uiNumVisible += visibleObjects[c].GetCount();
+          visibleObjects[c].Clear();
+        }
+
+        sw.Checkpoint();
+
+        spatialSystem.FindVisibleObjects(ezMakeArrayPtr(cascades), uiCategoryBitmask, ezMakeArrayPtr(visibleObjects));
+
+        combinedTime += sw.Checkpoint();
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %u cascade queries (%u objects visible on average): %.2fms separate, %.2fms combined", szName,
+        uiNumQueries, uiNumVisible / uiNumQueries, separateTime.GetMilliseconds(), combinedTime.GetMilliseconds());
+    }
+
+    {
+      ezUInt32 uiNumFound = 0;
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumQueries * 10; ++i)
+      {
+        ezBoundingSphere sphere(
+          ezVec3((float)rng.DoubleMinMax(-3000.0, 3000.0), (float)rng.DoubleMinMax(-3000.0, 3000.0), 10.0f), (float)rng.DoubleMinMax(5.0, 50.0));
+
+        spatialSystem.FindObjectsInSphere(sphere, uiCategoryBitmask, [&](ezGameObject*) {
+          ++uiNumFound;
+          return ezVisitorExecution::Continue;
+        });
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %u sphere queries (%u objects found): %.2fms", szName, uiNumQueries * 10, uiNumFound,
+        sw.GetRunningTotal().GetMilliseconds());
+    }
+
+    {
+      ezUInt32 uiNumFound = 0;
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumQueries * 10; ++i)
+      {
+        ezBoundingBox box;
+        box.SetCenterAndHalfExtents(ezVec3((float)rng.DoubleMinMax(-3000.0, 3000.0), (float)rng.DoubleMinMax(-3000.0, 3000.0), 10.0f),
+          ezVec3((float)rng.DoubleMinMax(5.0, 50.0)));
+
+        spatialSystem.FindObjectsInBox(box, uiCategoryBitmask, [&](ezGameObject*) {
+          ++uiNumFound;
+          return ezVisitorExecution::Continue;
+        });
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %u box queries (%u objects found): %.2fms", szName, uiNumQueries * 10, uiNumFound,
+        sw.GetRunningTotal().GetMilliseconds());
+    }
+  }
+
 } // namespace
 
 
@@ -289,3 +467,18 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_SpatialSystem)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Regular Grid")
+  {
+    ezSpatialSystem_RegularGrid spatialSystem;
+    MeasureSpatialSystemQueries(spatialSystem, "Regular Grid");
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Loose Octree")
+  {
+    ezSpatialSystem_LooseOctree spatialSystem;
+    MeasureSpatialSystemQueries(spatialSystem, "Loose Octree");
+  }
+}
@@ -0,0 +1,183 @@
+#include <CoreTestPCH.h>
+
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+
+namespace
+{
+  class WorldReaderTestComponent;
+  typedef ezComponentManager<WorldReaderTestComponent, ezBlockStorageType::FreeList> WorldReaderTestComponentManager;
+
+  class WorldReaderTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(WorldReaderTestComponent, ezComponent, WorldReaderTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override
+    {
+      SUPER::SerializeComponent(stream);
+      auto& s = stream.GetStream();
+
+      s << m_iValue;
+      s << m_sText;
+      stream.WriteGameObjectHandle(m_hTarget);
+      stream.WriteComponentHandle(m_hOtherComponent);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& stream) override
+    {
+      SUPER::DeserializeComponent(stream);
+      auto& s = stream.GetStream();
+
+      s >> m_iValue;
+      s >> m_sText;
+      m_hTarget = stream.ReadGameObjectHandle();
+      stream.ReadComponentHandle(m_hOtherComponent);
+    }
+
+    virtual void Initialize() override { m_bInitialized = true; }
+
+    ezInt32 m_iValue = 0;
+    bool m_bInitialized = false;
+    ezString m_sText;
+    ezGameObjectHandle m_hTarget;
+    ezComponentHandle m_hOtherComponent;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(WorldReaderTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  void WriteTestPrefab(ezMemoryStreamStorage& storage)
+  {
+    ezWorldDesc worldDesc("Source");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    WorldReaderTestComponentManager* pManager = world.GetOrCreateComponentManager<WorldReaderTestComponentManager>();
+
+    ezGameObjectDesc desc;
+    desc.m_sName.Assign("Root");
+    desc.m_LocalPosition.Set(1, 0, 0);
+    ezGameObject* pRoot = nullptr;
+    world.CreateObject(desc, pRoot);
+
+    desc.m_sName.Assign("Child");
+    desc.m_hParent = pRoot->GetHandle();
+    desc.m_LocalPosition.Set(0, 2, 0);
+    ezGameObject* pChild = nullptr;
+    world.CreateObject(desc, pChild);
+
+    WorldReaderTestComponent* pChildComponent = nullptr;
+    pManager->CreateComponent(pChild, pChildComponent);
+    pChildComponent->m_iValue = 7;
+    pChildComponent->m_sText = "Child";
+    pChildComponent->m_hTarget = pRoot->GetHandle();
+
+    WorldReaderTestComponent* pRootComponent = nullptr;
+    pManager->CreateComponent(pRoot, pRootComponent);
+    pRootComponent->m_iValue = 42;
+    pRootComponent->m_sText = "Root";
+    pRootComponent->m_hTarget = pChild->GetHandle();
+    pRootComponent->m_hOtherComponent = pChildComponent->GetHandle();
+
+    ezMemoryStreamWriter writer(&storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteWorld(writer, world);
+  }
+
+  void CheckInstance(ezGameObject* pRoot, ezGameObject* pChild, const ezVec3& vExpectedRootPos)
+  {
+    EZ_TEST_VEC3(pRoot->GetGlobalPosition(), vExpectedRootPos, 0.0001f);
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), vExpectedRootPos + ezVec3(0, 2, 0), 0.0001f);
+    EZ_TEST_BOOL(pChild->GetParent() == pRoot);
+    EZ_TEST_STRING(pChild->GetName(), "Child");
+
+    WorldReaderTestComponent* pRootComponent = nullptr;
+    WorldReaderTestComponent* pChildComponent = nullptr;
+    if (!EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRootComponent) && pChild->TryGetComponentOfBaseType(pChildComponent)))
+      return;
+
+    EZ_TEST_INT(pRootComponent->m_iValue, 42);
+    EZ_TEST_STRING(pRootComponent->m_sText, "Root");
+    EZ_TEST_BOOL(pRootComponent->m_hTarget == pChild->GetHandle());
+    EZ_TEST_BOOL(pRootComponent->m_hOtherComponent == pChildComponent->GetHandle());
+
+    EZ_TEST_INT(pChildComponent->m_iValue, 7);
+    EZ_TEST_STRING(pChildComponent->m_sText, "Child");
+    EZ_TEST_BOOL(pChildComponent->m_hTarget == pRoot->GetHandle());
+    EZ_TEST_BOOL(pChildComponent->m_hOtherComponent.IsInvalidated());
+
+    EZ_TEST_BOOL(pRootComponent->m_bInitialized);
+    EZ_TEST_BOOL(pChildComponent->m_bInitialized);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, WorldReader)
+{
+  ezMemoryStreamStorage storage;
+  WriteTestPrefab(storage);
+
+  ezWorldReader worldReader;
+  {
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+  }
+
+  EZ_TEST_INT(worldReader.GetRootObjectCount(), 1);
+  EZ_TEST_INT(worldReader.GetChildObjectCount(), 1);
+
+  ezWorldDesc worldDesc("Target");
+  ezWorld world(worldDesc);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefab")
+  {
+    ezHybridArray<ezGameObject*, 8> rootObjects;
+    ezHybridArray<ezGameObject*, 8> childObjects;
+    worldReader.InstantiatePrefab(world, ezTransform(ezVec3(0, 0, 5)), ezGameObjectHandle(), &rootObjects, &childObjects, nullptr, false);
+
+    EZ_LOCK(world.GetWriteMarker());
+    world.Update();
+
+    if (EZ_TEST_INT(rootObjects.GetCount(), 1) && EZ_TEST_INT(childObjects.GetCount(), 1))
+    {
+      CheckInstance(rootObjects[0], childObjects[0], ezVec3(1, 0, 5));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiateMany")
+  {
+    ezDynamicArray<ezTransform> transforms;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      transforms.PushBack(ezTransform(ezVec3(0, 0, static_cast<float>(i))));
+    }
+
+    ezUInt16 uiTeamID = 3;
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+    worldReader.InstantiateMany(world, transforms, ezGameObjectHandle(), &rootObjects, &childObjects, &uiTeamID, false);
+
+    EZ_LOCK(world.GetWriteMarker());
+    world.Update();
+
+    if (EZ_TEST_INT(rootObjects.GetCount(), 100) && EZ_TEST_INT(childObjects.GetCount(), 100))
+    {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        CheckInstance(rootObjects[i], childObjects[i], ezVec3(1, 0, static_cast<float>(i)));
+        EZ_TEST_INT(rootObjects[i]->GetTeamID(), 3);
+      }
+    }
+
+    // instantiating a single copy afterwards still works
+    ezHybridArray<ezGameObject*, 8> singleRootObjects;
+    ezHybridArray<ezGameObject*, 8> singleChildObjects;
+    worldReader.InstantiatePrefab(world, ezTransform(ezVec3(0, 3, 0)), ezGameObjectHandle(), &singleRootObjects, &singleChildObjects, nullptr, false);
+    world.Update();
+
+    CheckInstance(singleRootObjects[0], singleChildObjects[0], ezVec3(1, 3, 0));
+  }
+}
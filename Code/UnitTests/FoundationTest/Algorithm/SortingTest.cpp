@@ -11,6 +11,15 @@ namespace
     // Comparision via operator. Sorting algorithm should prefer Less operator
     bool operator()(ezInt32 a, ezInt32 b) const { return a < b; }
   };
+
+  struct RadixSortElement
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiSecondaryKey;
+    ezUInt32 m_uiOriginalIndex;
+  };
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
@@ -52,4 +61,60 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    ezDynamicArray<RadixSortElement> elements;
+    for (ezUInt32 i = 0; i < 5000; ++i)
+    {
+      // few distinct keys spread over all bytes to get lots of duplicates
+      const ezUInt64 uiHigh = static_cast<ezUInt64>(rand() % 16);
+      const ezUInt64 uiLow = static_cast<ezUInt64>(rand() % 16);
+
+      auto& element = elements.ExpandAndGetRef();
+      element.m_uiKey = (uiHigh << 58) | (uiLow << 20) | (i % 3);
+      element.m_uiSecondaryKey = static_cast<ezUInt32>(rand() % 1000);
+      element.m_uiOriginalIndex = i;
+    }
+
+    ezDynamicArray<RadixSortElement> tempStorage;
+    tempStorage.SetCountUninitialized(elements.GetCount());
+
+    ezSorting::RadixSort(elements.GetArrayPtr(), tempStorage.GetArrayPtr(), [](const RadixSortElement& e) { return e.m_uiKey; });
+
+    for (ezUInt32 i = 1; i < elements.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(elements[i - 1].m_uiKey <= elements[i].m_uiKey);
+
+      // stable
+      if (elements[i - 1].m_uiKey == elements[i].m_uiKey)
+      {
+        EZ_TEST_BOOL(elements[i - 1].m_uiOriginalIndex < elements[i].m_uiOriginalIndex);
+      }
+    }
+
+    // Secondary key first, then primary key
+    ezSorting::RadixSort(elements.GetArrayPtr(), tempStorage.GetArrayPtr(), [](const RadixSortElement& e) { return e.m_uiSecondaryKey; });
+    ezSorting::RadixSort(elements.GetArrayPtr(), tempStorage.GetArrayPtr(), [](const RadixSortElement& e) { return e.m_uiKey; });
+
+    for (ezUInt32 i = 1; i < elements.GetCount(); ++i)
+    {
+      const RadixSortElement& a = elements[i - 1];
+      const RadixSortElement& b = elements[i];
+      EZ_TEST_BOOL(a.m_uiKey < b.m_uiKey || (a.m_uiKey == b.m_uiKey && a.m_uiSecondaryKey <= b.m_uiSecondaryKey));
+    }
+
+    // All keys equal, every pass is skipped
+    for (auto& element : elements)
+    {
+      element.m_uiKey = 42;
+    }
+
+    ezSorting::RadixSort(elements.GetArrayPtr(), tempStorage.GetArrayPtr(), [](const RadixSortElement& e) { return e.m_uiKey; });
+
+    for (ezUInt32 i = 1; i < elements.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(elements[i - 1].m_uiKey == elements[i].m_uiKey);
+    }
+  }
 }
@@ -5,6 +5,7 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(CodeUtils);
 
@@ -263,6 +264,49 @@ EZ_CREATE_SIMPLE_TEST(CodeUtils, Preprocessor)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Shared cache on multiple threads")
+  {
+    const char* szFiles[] = {"Preprocessor/Test1.txt", "Preprocessor/IncludeViaMacro.txt", "Preprocessor/PragmaOnce.txt"};
+
+    auto ProcessFile = [](const char* szFile, ezTokenizedFileCache& cache, ezStringBuilder& out_sOutput) -> ezResult {
+      Logger log;
+
+      ezPreprocessor pp;
+      pp.SetLogInterface(&log);
+      pp.SetFileLocatorFunction(FileLocator);
+      pp.SetCustomFileCache(&cache);
+      pp.AddCustomDefine("PP_OBJ").IgnoreResult();
+      pp.AddCustomDefine("PP_FUNC(a) a").IgnoreResult();
+
+      return pp.Process(szFile, out_sOutput);
+    };
+
+    ezStringBuilder sExpected[EZ_ARRAY_SIZE(szFiles)];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(szFiles); ++i)
+    {
+      ezTokenizedFileCache cache;
+      EZ_TEST_BOOL(ProcessFile(szFiles[i], cache, sExpected[i]).Succeeded());
+    }
+
+    // all preprocessors start with an empty cache, so many of them race to tokenize the same files
+    ezTokenizedFileCache sharedCache;
+    ezAtomicInteger32 iNumMismatches;
+
+    ezTaskSystem::ParallelForIndexed(0, 96, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      ezStringBuilder sOutput;
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const ezUInt32 uiFile = i % EZ_ARRAY_SIZE(szFiles);
+        if (ProcessFile(szFiles[uiFile], sharedCache, sOutput).Failed() || sOutput != sExpected[uiFile])
+        {
+          iNumMismatches.Increment();
+        }
+      }
+    });
+
+    EZ_TEST_INT(iNumMismatches, 0);
+  }
+
 
   ezFileSystem::RemoveDataDirectoryGroup("PreprocessorTest");
 }
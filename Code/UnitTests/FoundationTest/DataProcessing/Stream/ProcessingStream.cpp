@@ -5,6 +5,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamSoA.h>
 #include <Foundation/Reflection/Reflection.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(DataProcessing);
@@ -157,3 +158,77 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamSoA)
+{
+  ezProcessingStreamGroup Group;
+  ezProcessingStream* pStream = Group.AddStream("StreamSoA", ezProcessingStream::DataType::Float3SoA);
+
+  EZ_TEST_BOOL(pStream != nullptr);
+  EZ_TEST_BOOL(pStream->IsSoA());
+  EZ_TEST_INT(pStream->GetNumComponentArrays(), 3);
+
+  ezProcessingStreamSpawnerZeroInitialized* pSpawner = EZ_DEFAULT_NEW(ezProcessingStreamSpawnerZeroInitialized);
+  pSpawner->SetStreamName(pStream->GetName());
+  Group.AddProcessor(pSpawner);
+
+  Group.SetSize(10);
+  Group.InitializeElements(10);
+  Group.Process();
+
+  EZ_TEST_INT(Group.GetNumActiveElements(), 10);
+
+  // every component array is padded to a multiple of four elements and aligned to the stream alignment
+  EZ_TEST_BOOL(pStream->GetComponentArrayStride() >= 12 * sizeof(float));
+  EZ_TEST_BOOL(pStream->GetComponentArrayStride() % pStream->GetAlignment() == 0);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Zero Initialized")
+  {
+    ezProcessingStreamSoA3f data(pStream);
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      EZ_TEST_VEC3(data.Get(i), ezVec3::ZeroVector(), 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load / Store")
+  {
+    ezProcessingStreamSoA3f data(pStream);
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      data.Set(i, ezVec3((float)i, (float)i * 10.0f, (float)i * 100.0f));
+    }
+
+    EZ_TEST_INT(ezProcessingStreamSoA3f::GetPaddedCount(10), 12);
+
+    // the padding allows to always process full SIMD groups
+    for (ezUInt64 i = 0; i < ezProcessingStreamSoA3f::GetPaddedCount(Group.GetNumActiveElements()); i += 4)
+    {
+      ezSimdVec4f x, y, z;
+      data.Load(i, x, y, z);
+      data.Store(i, x + ezSimdVec4f(1.0f), y, z * ezSimdFloat(2.0f));
+    }
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      EZ_TEST_VEC3(data.Get(i), ezVec3((float)i + 1.0f, (float)i * 10.0f, (float)i * 200.0f), 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove Elements")
+  {
+    Group.RemoveElement(2);
+    Group.RemoveElement(5);
+    Group.Process();
+
+    EZ_TEST_INT(Group.GetNumActiveElements(), 8);
+
+    // removed elements are replaced by the last active ones, component by component
+    ezProcessingStreamSoA3f data(pStream);
+    EZ_TEST_VEC3(data.Get(5), ezVec3(10.0f, 90.0f, 1800.0f), 0.0f);
+    EZ_TEST_VEC3(data.Get(2), ezVec3(9.0f, 80.0f, 1600.0f), 0.0f);
+    EZ_TEST_VEC3(data.Get(7), ezVec3(8.0f, 70.0f, 1400.0f), 0.0f);
+  }
+}
@@ -148,6 +148,10 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
       EZ_TEST_FILES(sFileSrc, sFileDst, "Unpacked file should be identical");
     }
 
+    // entries that are stored uncompressed can be accessed directly in the mapped archive
+    EZ_TEST_BOOL(readers[1].GetMappedContent() != nullptr);
+    EZ_TEST_BOOL(readers[3].GetMappedContent() != nullptr);
+
     // mount a second time
     if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "Clear", "archive2", ezFileSystem::ReadOnly) == EZ_SUCCESS))
       return;
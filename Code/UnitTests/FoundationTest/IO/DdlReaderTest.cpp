@@ -331,4 +331,76 @@ string{\"s\\2\",\"bla\"}\n\
     ezOpenDdlReader doc;
     EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse Buffer")
+  {
+    // long strings and runs of whitespace cross the boundaries of the chunks in which a stream is read
+    ezStringBuilder sLongString;
+    for (ezUInt32 i = 0; i < 4000; ++i)
+    {
+      sLongString.AppendFormat("{0} abc, ", i);
+    }
+
+    ezStringBuilder sWhitespace;
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      sWhitespace.Append("  \t\r\n      ");
+    }
+
+    ezStringBuilder sTestData;
+    sTestData.Append("Node", sWhitespace.GetData(), "{", sWhitespace.GetData());
+    sTestData.Append("string{\"", sLongString.GetData(), "\\n\\\"", sLongString.GetData(), "\"}");
+    sTestData.Append(sWhitespace.GetData(), "double{0.1, 23.42, -1e-7, 1_000.5, 4.35e12}", sWhitespace.GetData());
+    sTestData.Append("float{0.1, -2.5}", sWhitespace.GetData(), "}");
+
+    ezStringBuilder sExpectedString = sLongString;
+    sExpectedString.Append("\n\"", sLongString.GetData());
+
+    for (ezUInt32 uiMode = 0; uiMode < 3; ++uiMode)
+    {
+      ezOpenDdlReader doc;
+
+      if (uiMode == 0)
+      {
+        StringStream stream(sTestData.GetData());
+        EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+      }
+      else if (uiMode == 1)
+      {
+        // one byte at a time, the runs are never longer than the buffered data
+        StringStream stream(sTestData.GetData(), 1);
+        EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+      }
+      else
+      {
+        EZ_TEST_BOOL(doc.ParseDocument(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sTestData.GetData()), sTestData.GetElementCount())).Succeeded());
+      }
+
+      const ezOpenDdlReaderElement* pNode = doc.GetRootElement()->GetFirstChild();
+      if (!EZ_TEST_BOOL(pNode != nullptr && pNode->GetNumChildObjects() == 3))
+        continue;
+
+      const ezOpenDdlReaderElement* pString = pNode->GetFirstChild();
+      EZ_TEST_INT(pString->GetNumPrimitives(), 1);
+      EZ_TEST_BOOL(pString->GetPrimitivesString()[0] == sExpectedString);
+
+      // numbers with few significant digits and small exponents are converted exactly
+      const ezOpenDdlReaderElement* pDoubles = pString->GetSibling();
+      if (EZ_TEST_INT(pDoubles->GetNumPrimitives(), 5))
+      {
+        EZ_TEST_BOOL(pDoubles->GetPrimitivesDouble()[0] == 0.1);
+        EZ_TEST_BOOL(pDoubles->GetPrimitivesDouble()[1] == 23.42);
+        EZ_TEST_BOOL(pDoubles->GetPrimitivesDouble()[2] == -1e-7);
+        EZ_TEST_BOOL(pDoubles->GetPrimitivesDouble()[3] == 1000.5);
+        EZ_TEST_BOOL(pDoubles->GetPrimitivesDouble()[4] == 4.35e12);
+      }
+
+      const ezOpenDdlReaderElement* pFloats = pDoubles->GetSibling();
+      if (EZ_TEST_INT(pFloats->GetNumPrimitives(), 2))
+      {
+        EZ_TEST_BOOL(pFloats->GetPrimitivesFloat()[0] == 0.1f);
+        EZ_TEST_BOOL(pFloats->GetPrimitivesFloat()[1] == -2.5f);
+      }
+    }
+  }
 }
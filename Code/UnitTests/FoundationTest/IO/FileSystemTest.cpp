@@ -149,6 +149,29 @@ Only concrete and clocks.\n\
     FileIn.Close();
   }
 
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read File (Mapped Content)")
+  {
+    ezFileReader FileIn;
+
+    EZ_TEST_BOOL(FileIn.Open("FileSystemTest.txt") == EZ_SUCCESS);
+
+    const void* pMappedContent = FileIn.GetMappedContent();
+    if (EZ_TEST_BOOL(pMappedContent != nullptr))
+    {
+      const char* szMappedContent = static_cast<const char*>(pMappedContent);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szMappedContent, sFileContent.GetData(), sFileContent.GetElementCount()));
+
+      // mapping again returns the same memory
+      EZ_TEST_BOOL(FileIn.GetMappedContent() == pMappedContent);
+    }
+
+    FileIn.Close();
+  }
+
+#endif
+
 #if EZ_DISABLED(EZ_PLATFORM_WINDOWS_UWP)
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read File (Absolute Path)")
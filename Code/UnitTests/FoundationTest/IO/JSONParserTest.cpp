@@ -81,6 +81,12 @@ public:
     ParseAll();
   }
 
+  void ParseBuffer(const char* szData)
+  {
+    SetInputBuffer(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szData), ezStringUtils::GetStringElementCount(szData)));
+    ParseAll();
+  }
+
   void Add(ParseResult pr) { m_Results.PushBack(pr); }
 
   virtual bool OnVariable(const char* szVarName) override
@@ -172,8 +178,14 @@ public:
 
   ezInt32 m_iExpectedParsingErrors;
 
+  ezUInt32 m_uiErrorLine = 0;
+  ezUInt32 m_uiErrorColumn = 0;
+
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override
   {
+    m_uiErrorLine = uiLine;
+    m_uiErrorColumn = uiColumn;
+
     --m_iExpectedParsingErrors;
 
     if (m_iExpectedParsingErrors >= 0)
@@ -664,4 +676,124 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     EZ_TEST_INT(reader.m_iExpectedParsingErrors, 0);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffered input")
+  {
+    // the stream is read in chunks of 16 KB, long strings and runs of whitespace cross the chunk boundaries
+    ezStringBuilder sLongString;
+    for (ezUInt32 i = 0; i < 4000; ++i)
+    {
+      sLongString.AppendFormat("{0} abc, ", i);
+    }
+
+    ezStringBuilder sWhitespace;
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      sWhitespace.Append("  \t\r\n      ");
+    }
+
+    ezStringBuilder sEscaped = sLongString;
+    sEscaped.Append("\\\"\n", sLongString.GetData());
+
+    ezStringBuilder sTestData;
+    sTestData.Append("{", sWhitespace.GetData(), "\"long\"", sWhitespace.GetData(), ":", sWhitespace.GetData());
+    sTestData.Append("\"", sLongString.GetData(), "\",\n");
+    sTestData.Append("\"escaped\" : \"", sLongString.GetData(), "\\\\\\\"\\n", sLongString.GetData(), "\",");
+    sTestData.Append("\"skip_var\" : \"", sLongString.GetData(), "\\\"\",");
+    sTestData.Append("\"numbers\" : [0.1, -2.5e-3, 1e22, 12345678901234567, .5, 3.0E+2]", sWhitespace.GetData(), "}");
+
+    for (ezUInt32 uiMode = 0; uiMode < 3; ++uiMode)
+    {
+      TestReader reader;
+
+      reader.Add(ParseResult(BeginObject));
+      reader.Add(ParseResult(Variable, "long"));
+      reader.Add(ParseResult(sLongString.GetData()));
+      reader.Add(ParseResult(Variable, "escaped"));
+      reader.Add(ParseResult(sEscaped.GetData()));
+      reader.Add(ParseResult(Variable, "skip_var"));
+      reader.Add(ParseResult(Variable, "numbers"));
+      reader.Add(ParseResult(BeginArray));
+      reader.Add(ParseResult(0.1));
+      reader.Add(ParseResult(-2.5e-3));
+      reader.Add(ParseResult(1e22));
+      reader.Add(ParseResult(12345678901234567.0));
+      reader.Add(ParseResult(0.5));
+      reader.Add(ParseResult(300.0));
+      reader.Add(ParseResult(EndArray));
+      reader.Add(ParseResult(EndObject));
+
+      if (uiMode == 0)
+      {
+        StringStream stream(sTestData.GetData());
+        reader.ParseStream(stream);
+      }
+      else if (uiMode == 1)
+      {
+        // one byte at a time, the runs are never longer than the buffered data
+        StringStream stream(sTestData.GetData(), 1);
+        reader.ParseStream(stream);
+      }
+      else
+      {
+        reader.ParseBuffer(sTestData.GetData());
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Error position after long runs")
+  {
+    ezStringBuilder sText;
+    for (ezUInt32 i = 0; i < 3000; ++i)
+    {
+      sText.Append("some text ");
+    }
+
+    ezStringBuilder sTestData;
+    sTestData.Append("{\"a\":\"", sText.GetData(), "\",");
+    for (ezUInt32 i = 0; i < 3000; ++i)
+    {
+      sTestData.Append("  \t\n  ");
+    }
+    sTestData.Append("  x }");
+
+    ezUInt32 uiLine[3] = {};
+    ezUInt32 uiColumn[3] = {};
+
+    for (ezUInt32 uiMode = 0; uiMode < 3; ++uiMode)
+    {
+      TestReader reader;
+      reader.Add(ParseResult(BeginObject));
+      reader.Add(ParseResult(Variable, "a"));
+      reader.Add(ParseResult(sText.GetData()));
+      reader.m_iExpectedParsingErrors = 1;
+
+      if (uiMode == 0)
+      {
+        StringStream stream(sTestData.GetData());
+        reader.ParseStream(stream);
+      }
+      else if (uiMode == 1)
+      {
+        StringStream stream(sTestData.GetData(), 1);
+        reader.ParseStream(stream);
+      }
+      else
+      {
+        reader.ParseBuffer(sTestData.GetData());
+      }
+
+      uiLine[uiMode] = reader.m_uiErrorLine;
+      uiColumn[uiMode] = reader.m_uiErrorColumn;
+    }
+
+    EZ_TEST_INT(uiLine[0], 3001);
+    EZ_TEST_INT(uiColumn[0], 6);
+
+    for (ezUInt32 uiMode = 1; uiMode < 3; ++uiMode)
+    {
+      EZ_TEST_INT(uiLine[uiMode], uiLine[0]);
+      EZ_TEST_INT(uiColumn[uiMode], uiColumn[0]);
+    }
+  }
 }
@@ -490,4 +490,38 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     EZ_TEST_BOOL(sCompare.IsEmpty());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse Buffer")
+  {
+    const char* szTestData = "{ \"a\" : 0.1, \"b\" : [23.42, -1e-7, 4.35e12, 7], \"c\" : \"text\", \"d\" : 1.25e300 }";
+
+    ezJSONReader reader;
+    EZ_TEST_BOOL(reader.Parse(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szTestData), ezStringUtils::GetStringElementCount(szTestData))).Succeeded());
+
+    const ezVariantDictionary& obj = reader.GetTopLevelObject();
+    EZ_TEST_INT(obj.GetCount(), 4);
+
+    ezVariant value;
+
+    // numbers with few significant digits and small exponents are converted exactly
+    EZ_TEST_BOOL(obj.TryGetValue("a", value) && value.Get<double>() == 0.1);
+
+    if (EZ_TEST_BOOL(obj.TryGetValue("b", value) && value.IsA<ezVariantArray>()))
+    {
+      const ezVariantArray& values = value.Get<ezVariantArray>();
+      if (EZ_TEST_INT(values.GetCount(), 4))
+      {
+        EZ_TEST_BOOL(values[0].Get<double>() == 23.42);
+        EZ_TEST_BOOL(values[1].Get<double>() == -1e-7);
+        EZ_TEST_BOOL(values[2].Get<double>() == 4.35e12);
+        EZ_TEST_BOOL(values[3].Get<double>() == 7.0);
+      }
+    }
+
+    EZ_TEST_BOOL(obj.TryGetValue("c", value) && value.Get<ezString>() == "text");
+
+    // large exponents go through the generic conversion
+    EZ_TEST_BOOL(obj.TryGetValue("d", value));
+    EZ_TEST_DOUBLE(value.Get<double>() / 1e300, 1.25, 0.0001);
+  }
 }
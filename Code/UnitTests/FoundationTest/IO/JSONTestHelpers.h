@@ -49,15 +49,17 @@ private:
 class StringStream : public ezStreamReader
 {
 public:
-  StringStream(const void* pData)
+  /// \brief uiMaxBytesPerRead allows to simulate streams that only deliver small pieces of data at a time.
+  StringStream(const void* pData, ezUInt64 uiMaxBytesPerRead = 0xFFFFFFFFFFFFFFFFllu)
   {
     m_pData = pData;
     m_uiLength = ezStringUtils::GetStringElementCount((const char*)pData);
+    m_uiMaxBytesPerRead = uiMaxBytesPerRead;
   }
 
   virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   {
-    uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiLength);
+    uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiLength, m_uiMaxBytesPerRead);
     m_uiLength -= uiBytesToRead;
 
     if (uiBytesToRead > 0)
@@ -72,4 +74,5 @@ public:
 private:
   const void* m_pData;
   ezUInt64 m_uiLength;
+  ezUInt64 m_uiMaxBytesPerRead;
 };
@@ -0,0 +1,286 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Math/Color16f.h>
+#include <Texture/Image/Conversions/BlockCompressConversions.h>
+#include <Texture/Image/Conversions/DXTConversions.h>
+
+namespace
+{
+  void MakeGradientBlock(ezUInt32 uiSeed, ezColorBaseUB* out_pBlock)
+  {
+    ezUInt32 uiRandom = uiSeed * 1664525 + 1013904223;
+    const ezUInt8 r0 = static_cast<ezUInt8>(uiRandom >> 8), g0 = static_cast<ezUInt8>(uiRandom >> 16), b0 = static_cast<ezUInt8>(uiRandom >> 24);
+
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      const ezUInt32 t = (i % 4 + i / 4) * 10;
+      out_pBlock[i] = ezColorBaseUB(static_cast<ezUInt8>(ezMath::Min<ezUInt32>(r0 / 2 + t, 255)), static_cast<ezUInt8>(ezMath::Min<ezUInt32>(g0 / 2 + t, 255)),
+        static_cast<ezUInt8>(ezMath::Min<ezUInt32>(b0 / 2 + t, 255)), static_cast<ezUInt8>(255 - t * 2));
+    }
+  }
+
+  double GetMeanSquaredError(const ezColorBaseUB* pBlockA, const ezColorBaseUB* pBlockB, ezUInt32 uiNumChannels)
+  {
+    double fError = 0.0;
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      for (ezUInt32 c = 0; c < uiNumChannels; ++c)
+      {
+        const double fDiff = static_cast<double>((&pBlockA[i].r)[c]) - static_cast<double>((&pBlockB[i].r)[c]);
+        fError += fDiff * fDiff;
+      }
+    }
+    return fError / (16.0 * uiNumChannels);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Image, BlockCompression)
+{
+  const ezBlockCompressionQuality::Enum qualities[] = {ezBlockCompressionQuality::Fast, ezBlockCompressionQuality::High};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "BC1")
+  {
+    for (ezBlockCompressionQuality::Enum quality : qualities)
+    {
+      ezColorBaseUB source[16];
+      ezColorBaseUB decoded[16];
+      ezUInt8 block[8];
+
+      // a single color is matched within the precision of the interpolated color
+      for (ezUInt32 v = 0; v < 256; v += 5)
+      {
+        for (ezUInt32 i = 0; i < 16; ++i)
+          source[i] = ezColorBaseUB(static_cast<ezUInt8>(v), static_cast<ezUInt8>(255 - v), static_cast<ezUInt8>(v / 2), 255);
+
+        ezCompressBlockBC1(source, block, false, quality);
+        ezDecompressBlockBC1(block, decoded, false);
+
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          EZ_TEST_INT_MSG(ezMath::Abs(decoded[i].r - source[i].r) <= 2 ? 1 : 0, 1, "Value %u", v);
+          EZ_TEST_INT_MSG(ezMath::Abs(decoded[i].g - source[i].g) <= 1 ? 1 : 0, 1, "Value %u", v);
+          EZ_TEST_INT(decoded[i].a, 255);
+        }
+      }
+
+      for (ezUInt32 uiSeed = 0; uiSeed < 64; ++uiSeed)
+      {
+        MakeGradientBlock(uiSeed, source);
+        for (ezUInt32 i = 0; i < 16; ++i)
+          source[i].a = 255;
+
+        ezCompressBlockBC1(source, block, false, quality);
+        ezDecompressBlockBC1(block, decoded, false);
+
+        // a gradient over 7 levels has to be approximated by the 4 palette entries
+        EZ_TEST_BOOL(GetMeanSquaredError(source, decoded, 3) < 60.0);
+      }
+
+      // transparent pixels use the three color mode
+      MakeGradientBlock(7, source);
+      for (ezUInt32 i = 0; i < 16; ++i)
+        source[i].a = (i % 3 == 0) ? 0 : 255;
+
+      ezCompressBlockBC1(source, block, false, quality);
+      ezDecompressBlockBC1(block, decoded, false);
+
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        EZ_TEST_INT(decoded[i].a, source[i].a);
+      }
+
+      // fully transparent
+      for (ezUInt32 i = 0; i < 16; ++i)
+        source[i].a = 0;
+
+      ezCompressBlockBC1(source, block, false, quality);
+      ezDecompressBlockBC1(block, decoded, false);
+
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        EZ_TEST_INT(decoded[i].a, 0);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "BC3")
+  {
+    for (ezBlockCompressionQuality::Enum quality : qualities)
+    {
+      for (ezUInt32 uiSeed = 0; uiSeed < 64; ++uiSeed)
+      {
+        ezColorBaseUB source[16];
+        MakeGradientBlock(uiSeed, source);
+
+        ezUInt8 block[16];
+        ezCompressBlockBC3(source, block, quality);
+
+        ezColorBaseUB decoded[16];
+        ezDecompressBlockBC1(block + 8, decoded, true);
+        ezDecompressBlockBC4(block, &decoded[0].a, 4, 0);
+
+        EZ_TEST_BOOL(GetMeanSquaredError(source, decoded, 3) < 60.0);
+
+        // the alpha channel has 8 interpolated values, so the 7 levels of the gradient are all close to one of them
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          EZ_TEST_BOOL(ezMath::Abs(decoded[i].a - source[i].a) <= 10);
+        }
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "BC6H")
+  {
+    for (ezBlockCompressionQuality::Enum quality : qualities)
+    {
+      for (ezUInt32 uiSeed = 0; uiSeed < 64; ++uiSeed)
+      {
+        ezColorBaseUB ldr[16];
+        MakeGradientBlock(uiSeed, ldr);
+
+        const float fScale = 0.25f + uiSeed * 0.5f;
+
+        ezColorLinear16f source[16];
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          source[i] = ezColor(ldr[i].r / 255.0f * fScale, ldr[i].g / 255.0f * fScale, ldr[i].b / 255.0f * fScale, 1.0f);
+        }
+
+        ezUInt8 block[16];
+        ezCompressBlockBC6(source, block, quality);
+
+        ezColorLinear16f decoded[16];
+        ezDecompressBlockBC6(block, decoded, false);
+
+        // the endpoints are interpolated in a roughly logarithmic space, so linear gradients can only be approximated
+        float fRelativeError = 0.0f;
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          for (ezUInt32 c = 0; c < 3; ++c)
+          {
+            const float fSource = source[i].GetData()[c];
+            const float fDecoded = decoded[i].GetData()[c];
+            fRelativeError += ezMath::Abs(fDecoded - fSource) / ezMath::Max(fSource, 0.01f);
+          }
+        }
+
+        EZ_TEST_BOOL(fRelativeError / 48.0f < (quality == ezBlockCompressionQuality::High ? 0.1f : 0.2f));
+      }
+
+      // an edge between two colors of very different brightness needs two regions
+      if (quality == ezBlockCompressionQuality::High)
+      {
+        ezColorLinear16f source[16];
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          const float t = (i / 4) * 0.1f;
+          source[i] = (i % 4 < 2) ? ezColor(4.0f + t, 2.0f, 0.5f, 1.0f) : ezColor(0.05f, 0.1f + t, 0.3f, 1.0f);
+        }
+
+        ezUInt8 block[16];
+        ezCompressBlockBC6(source, block, quality);
+
+        ezColorLinear16f decoded[16];
+        ezDecompressBlockBC6(block, decoded, false);
+
+        EZ_TEST_INT(block[0] & 0x1F, 0x1E); // mode 10
+
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          for (ezUInt32 c = 0; c < 3; ++c)
+          {
+            const float fSource = source[i].GetData()[c];
+            const float fDecoded = decoded[i].GetData()[c];
+            EZ_TEST_FLOAT(fDecoded, fSource, 0.3f * fSource);
+          }
+        }
+      }
+
+      // negative values and NaN are stored as zero
+      ezColorLinear16f special[16];
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        special[i] = ezColor(-1.0f, ezMath::NaN<float>(), 0.5f, 1.0f);
+      }
+
+      ezUInt8 block[16];
+      ezCompressBlockBC6(special, block, quality);
+
+      ezColorLinear16f decoded[16];
+      ezDecompressBlockBC6(block, decoded, false);
+
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        EZ_TEST_FLOAT(decoded[i].r, 0.0f, 0.0f);
+        EZ_TEST_FLOAT(decoded[i].g, 0.0f, 0.0f);
+        EZ_TEST_FLOAT(decoded[i].b, 0.5f, 0.01f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "BC7")
+  {
+    for (ezBlockCompressionQuality::Enum quality : qualities)
+    {
+      for (ezUInt32 uiSeed = 0; uiSeed < 64; ++uiSeed)
+      {
+        ezColorBaseUB source[16];
+        MakeGradientBlock(uiSeed, source);
+
+        ezUInt8 block[16];
+        ezCompressBlockBC7(source, block, quality);
+
+        ezColorBaseUB decoded[16];
+        ezDecompressBlockBC7(block, decoded);
+
+        EZ_TEST_BOOL(GetMeanSquaredError(source, decoded, 4) < 4.0);
+      }
+
+      // blocks with an edge need one of the two subset modes, opaque blocks use mode 1, transparent ones mode 7
+      for (ezUInt8 uiAlpha : {ezUInt8(255), ezUInt8(128)})
+      {
+        if (quality == ezBlockCompressionQuality::Fast)
+          break;
+
+        ezColorBaseUB source[16];
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          const ezUInt8 t = static_cast<ezUInt8>(i * 4);
+          source[i] = (i % 4 < 2) ? ezColorBaseUB(200 + t / 2, 20, 40, uiAlpha) : ezColorBaseUB(10, 100 + t, 220, uiAlpha);
+        }
+
+        ezUInt8 block[16];
+        ezCompressBlockBC7(source, block, quality);
+
+        ezColorBaseUB decoded[16];
+        ezDecompressBlockBC7(block, decoded);
+
+        if (uiAlpha == 255)
+          EZ_TEST_INT(block[0] & 0x03, 0x02);
+        else
+          EZ_TEST_INT(block[0], 0x80);
+        EZ_TEST_BOOL(GetMeanSquaredError(source, decoded, 4) < 8.0);
+      }
+
+      // alpha that doesn't follow the color uses mode 5
+      if (quality == ezBlockCompressionQuality::High)
+      {
+        ezColorBaseUB source[16];
+        for (ezUInt32 i = 0; i < 16; ++i)
+        {
+          source[i] = ezColorBaseUB(static_cast<ezUInt8>(i * 16), static_cast<ezUInt8>(i * 8), 64, static_cast<ezUInt8>((i * 7 % 16) * 17));
+        }
+
+        ezUInt8 block[16];
+        ezCompressBlockBC7(source, block, quality);
+
+        ezColorBaseUB decoded[16];
+        ezDecompressBlockBC7(block, decoded);
+
+        EZ_TEST_INT(block[0], 0x20);
+        EZ_TEST_BOOL(GetMeanSquaredError(source, decoded, 4) < 300.0);
+      }
+    }
+  }
+}
@@ -203,11 +203,18 @@ private:
 
     ezFileSystem::AddDataDirectory(">eztest/", "ImageComparisonDataDir", "imgout", ezFileSystem::AllowWrites).IgnoreResult();
 
+#if EZ_DISABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+    // without DirectXTex the block compressed formats are encoded by the built-in compressors, which produce slightly different images
+    ezTestFramework::GetInstance()->SetImageReferenceOverrideFolderName("Images_Reference_NativeCompression");
+#endif
+
     return EZ_SUCCESS;
   }
 
   virtual ezResult DeInitializeTest() override
   {
+    ezTestFramework::GetInstance()->SetImageReferenceOverrideFolderName("");
+
     ezFileSystem::RemoveDataDirectoryGroup("ImageConversionTest");
     ezFileSystem::RemoveDataDirectoryGroup("ImageComparisonDataDir");
 
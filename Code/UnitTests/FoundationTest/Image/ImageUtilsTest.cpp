@@ -3,8 +3,86 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Texture/Image/ImageFilter.h>
 #include <Texture/Image/ImageUtils.h>
 
+namespace
+{
+  void MakeRandomFloatImage(ezUInt32 uiWidth, ezUInt32 uiHeight, ezUInt32 uiDepth, ezImage& out_image)
+  {
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    header.SetWidth(uiWidth);
+    header.SetHeight(uiHeight);
+    header.SetDepth(uiDepth);
+    out_image.ResetAndAlloc(header);
+
+    ezUInt32 uiRandom = 42;
+    for (ezColor& color : out_image.GetBlobPtr<ezColor>())
+    {
+      float channels[4];
+      for (float& channel : channels)
+      {
+        uiRandom = uiRandom * 1664525 + 1013904223;
+        channel = (uiRandom >> 8) / static_cast<float>(1 << 24);
+      }
+      color = ezColor(channels[0], channels[1], channels[2], channels[3]);
+    }
+  }
+
+  /// Filters one pixel after the other along one axis, to verify the optimized implementation against.
+  void ScaleAxisReference(const ezImage& source, ezImage& target, ezUInt32 uiAxis, ezUInt32 uiNewSize, const ezImageFilter& filter,
+    ezImageAddressMode::Enum addressMode, const ezColor& borderColor)
+  {
+    const ezUInt32 sourceSize[3] = {source.GetWidth(), source.GetHeight(), source.GetDepth()};
+    ezUInt32 targetSize[3] = {sourceSize[0], sourceSize[1], sourceSize[2]};
+    targetSize[uiAxis] = uiNewSize;
+
+    ezImageHeader header = source.GetHeader();
+    header.SetWidth(targetSize[0]);
+    header.SetHeight(targetSize[1]);
+    header.SetDepth(targetSize[2]);
+    target.ResetAndAlloc(header);
+
+    ezImageFilterWeights weights(filter, sourceSize[uiAxis], uiNewSize);
+
+    for (ezUInt32 z = 0; z < targetSize[2]; ++z)
+    {
+      for (ezUInt32 y = 0; y < targetSize[1]; ++y)
+      {
+        for (ezUInt32 x = 0; x < targetSize[0]; ++x)
+        {
+          ezUInt32 coords[3] = {x, y, z};
+          const ezUInt32 uiDstSample = coords[uiAxis];
+          const ezInt32 iFirstSourceSample = weights.GetFirstSourceSampleIndex(uiDstSample);
+
+          ezColor total(0, 0, 0, 0);
+          for (ezUInt32 i = 0; i < weights.GetNumWeights(); ++i)
+          {
+            bool bUseBorderColor = false;
+            coords[uiAxis] = ezImageUtils::GetSampleIndex(sourceSize[uiAxis], iFirstSourceSample + i, addressMode, bUseBorderColor);
+
+            const ezColor sample = bUseBorderColor ? borderColor : *source.GetPixelPointer<ezColor>(0, 0, 0, coords[0], coords[1], coords[2]);
+            total += sample * static_cast<float>(weights.GetWeight(uiDstSample, i));
+          }
+
+          *target.GetPixelPointer<ezColor>(0, 0, 0, x, y, z) = total;
+        }
+      }
+    }
+  }
+
+  float ComputeCoverage(const ezImageView& image, float fAlphaThreshold)
+  {
+    ezUInt32 uiCovered = 0;
+    for (const ezColor& color : image.GetBlobPtr<ezColor>())
+    {
+      uiCovered += color.a >= fAlphaThreshold ? 1 : 0;
+    }
+    return uiCovered / static_cast<float>(image.GetBlobPtr<ezColor>().GetCount());
+  }
+} // namespace
+
 
 EZ_CREATE_SIMPLE_TEST(Image, ImageUtils)
 {
@@ -116,5 +194,76 @@ EZ_CREATE_SIMPLE_TEST(Image, ImageUtils)
     EZ_TEST_INT(uiError, 1433);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scale3D")
+  {
+    ezImage source;
+    MakeRandomFloatImage(13, 11, 6, source);
+
+    const ezColor borderColor(0.2f, 0.4f, 0.6f, 0.8f);
+    ezImageFilterSincWithKaiserWindow filter;
+
+    const ezUInt32 targetSizes[][3] = {{5, 4, 3}, {20, 15, 9}, {13, 7, 6}};
+
+    for (const auto& targetSize : targetSizes)
+    {
+      ezImage scaled;
+      EZ_TEST_BOOL(ezImageUtils::Scale3D(source, scaled, targetSize[0], targetSize[1], targetSize[2], &filter, ezImageAddressMode::Repeat,
+        ezImageAddressMode::Mirror, ezImageAddressMode::ClampBorder, borderColor)
+                     .Succeeded());
+
+      ezImage expectedX, expectedY, expected;
+      ScaleAxisReference(source, expectedX, 0, targetSize[0], filter, ezImageAddressMode::Repeat, borderColor);
+      ScaleAxisReference(expectedX, expectedY, 1, targetSize[1], filter, ezImageAddressMode::Mirror, borderColor);
+      ScaleAxisReference(expectedY, expected, 2, targetSize[2], filter, ezImageAddressMode::ClampBorder, borderColor);
+
+      EZ_TEST_INT(scaled.GetWidth(), targetSize[0]);
+      EZ_TEST_INT(scaled.GetHeight(), targetSize[1]);
+      EZ_TEST_INT(scaled.GetDepth(), targetSize[2]);
+
+      auto scaledPixels = scaled.GetBlobPtr<ezColor>();
+      auto expectedPixels = expected.GetBlobPtr<ezColor>();
+      for (ezUInt32 i = 0; i < scaledPixels.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(scaledPixels[i].IsEqualRGBA(expectedPixels[i], 0.0001f));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GenerateMipMaps")
+  {
+    ezImage source;
+    MakeRandomFloatImage(64, 32, 1, source);
+
+    ezImageUtils::MipMapOptions options;
+    options.m_renormalizeNormals = true;
+    options.m_preserveCoverage = true;
+    options.m_alphaThreshold = 0.5f;
+    options.m_addressModeU = ezImageAddressMode::Repeat;
+
+    const float fSourceCoverage = ComputeCoverage(source, options.m_alphaThreshold);
+
+    ezImage mipMaps;
+    ezImageUtils::GenerateMipMaps(source, mipMaps, options);
+
+    EZ_TEST_INT(mipMaps.GetNumMipLevels(), 7);
+
+    for (ezUInt32 uiMipLevel = 1; uiMipLevel < mipMaps.GetNumMipLevels(); ++uiMipLevel)
+    {
+      const ezImageView mipMap = mipMaps.GetSubImageView(uiMipLevel);
+
+      for (const ezColor& color : mipMap.GetBlobPtr<ezColor>())
+      {
+        const ezVec3 vNormal(color.r * 2.0f - 1.0f, color.g * 2.0f - 1.0f, color.b * 2.0f - 1.0f);
+        EZ_TEST_FLOAT(vNormal.GetLength(), 1.0f, 0.001f);
+      }
+
+      // the coverage can only be matched up to the number of pixels in the level
+      if (mipMap.GetWidth() * mipMap.GetHeight() >= 64)
+      {
+        EZ_TEST_FLOAT(ComputeCoverage(mipMap, options.m_alphaThreshold), fSourceCoverage, 0.05f);
+      }
+    }
+  }
+
   ezFileSystem::RemoveDataDirectoryGroup("ImageTest");
 }
@@ -1,8 +1,11 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
 
 struct EZ_ALIGN(NonAlignedVector, EZ_ALIGNMENT_MINIMUM)
 {
@@ -75,6 +78,72 @@ void TestAlignmentHelper(size_t uiExpectedAlignment)
   EZ_TEST_BOOL(stats.m_uiNumAllocations - stats.m_uiNumDeallocations == 0);
 }
 
+class ezDeallocateOnOtherThread : public ezThread
+{
+public:
+  ezDeallocateOnOtherThread(ezAllocatorBase* pAllocator, ezArrayPtr<void*> blocks)
+    : m_pAllocator(pAllocator)
+    , m_Blocks(blocks)
+  {
+  }
+
+  virtual ezUInt32 Run() override
+  {
+    for (void* pBlock : m_Blocks)
+    {
+      m_pAllocator->Deallocate(pBlock);
+    }
+
+    return 0;
+  }
+
+  ezAllocatorBase* m_pAllocator;
+  ezArrayPtr<void*> m_Blocks;
+};
+
+class ezAllocateOnOtherThread : public ezThread
+{
+public:
+  ezAllocateOnOtherThread(ezAllocatorBase* pAllocator, ezArrayPtr<void*> blocks)
+    : m_pAllocator(pAllocator)
+    , m_Blocks(blocks)
+  {
+  }
+
+  virtual ezUInt32 Run() override
+  {
+    for (ezUInt32 i = 0; i < m_Blocks.GetCount(); ++i)
+    {
+      m_Blocks[i] = m_pAllocator->Allocate(16 + i % 64, 8);
+    }
+
+    return 0;
+  }
+
+  ezAllocatorBase* m_pAllocator;
+  ezArrayPtr<void*> m_Blocks;
+};
+
+class ezUseFrameAllocatorOnOtherThread : public ezThread
+{
+public:
+  virtual ezUInt32 Run() override
+  {
+    m_pAllocator = ezFrameAllocator::GetThreadAllocator();
+    m_pData = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt32, 1000);
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      m_pData[i] = i;
+    }
+
+    return 0;
+  }
+
+  ezAllocatorBase* m_pAllocator = nullptr;
+  ezUInt32* m_pData = nullptr;
+};
+
 EZ_CREATE_SIMPLE_TEST_GROUP(Memory);
 
 EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
@@ -160,6 +229,256 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
     EZ_TEST_BOOL(stats.m_uiAllocationSize == 0);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ThreadCachingAllocator")
+  {
+    typedef ezMemoryPolicies::ezThreadCachingAllocation Policy;
+
+    for (ezUInt32 uiSize = 1; uiSize <= Policy::MaxSmallSize; ++uiSize)
+    {
+      const ezUInt32 uiSizeClass = Policy::GetSizeClass(uiSize);
+      EZ_TEST_BOOL(uiSizeClass < Policy::NumSizeClasses);
+      EZ_TEST_BOOL(Policy::GetSizeClassBlockSize(uiSizeClass) >= uiSize);
+      EZ_TEST_BOOL(uiSizeClass == 0 || Policy::GetSizeClassBlockSize(uiSizeClass - 1) < uiSize);
+      EZ_TEST_BOOL(Policy::GetSizeClassBlockSize(uiSizeClass) % 16 == 0);
+    }
+
+    ezThreadCachingAllocator allocator("TestThreadCachingAllocator");
+
+    size_t sizes[] = {1, 8, 16, 17, 100, 128, 129, 1000, 4096, 8192, 8193, 100000};
+    void* allocs[EZ_ARRAY_SIZE(sizes)][64];
+
+    for (size_t i = 0; i < EZ_ARRAY_SIZE(sizes); i++)
+    {
+      for (ezUInt32 j = 0; j < EZ_ARRAY_SIZE(allocs[i]); ++j)
+      {
+        allocs[i][j] = allocator.Allocate(sizes[i], 16, nullptr);
+        EZ_TEST_BOOL(ezMemoryUtils::IsAligned(allocs[i][j], 16));
+        ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(allocs[i][j]), static_cast<ezUInt8>(i * 64 + j), sizes[i]);
+      }
+    }
+
+    for (size_t i = 0; i < EZ_ARRAY_SIZE(sizes); i++)
+    {
+      for (ezUInt32 j = 0; j < EZ_ARRAY_SIZE(allocs[i]); ++j)
+      {
+        const ezUInt8* pBytes = static_cast<const ezUInt8*>(allocs[i][j]);
+        EZ_TEST_BOOL(pBytes[0] == static_cast<ezUInt8>(i * 64 + j) && pBytes[sizes[i] - 1] == static_cast<ezUInt8>(i * 64 + j));
+      }
+    }
+
+    // deallocate half of the blocks on another thread, they end up in that thread's cache
+    ezDeallocateOnOtherThread otherThread(&allocator, ezArrayPtr<void*>(&allocs[0][0], EZ_ARRAY_SIZE(sizes) * 32));
+    otherThread.Start();
+    otherThread.Join();
+
+    for (size_t i = EZ_ARRAY_SIZE(sizes) / 2; i < EZ_ARRAY_SIZE(sizes); i++)
+    {
+      for (ezUInt32 j = 0; j < EZ_ARRAY_SIZE(allocs[i]); ++j)
+      {
+        allocator.Deallocate(allocs[i][j]);
+      }
+    }
+
+    EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations - allocator.GetStats().m_uiNumDeallocations, 0);
+
+    // more blocks than fit into the first span region
+    {
+      ezDynamicArray<void*> blocks;
+      blocks.SetCount(Policy::MinSpanRegionSize / 64 * 2);
+
+      for (void*& pBlock : blocks)
+      {
+        pBlock = allocator.Allocate(64, 16, nullptr);
+        EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pBlock, 16));
+      }
+
+      ezDeallocateOnOtherThread otherThread(&allocator, blocks.GetArrayPtr().GetSubArray(0, blocks.GetCount() / 2));
+      otherThread.Start();
+      otherThread.Join();
+
+      // the exited thread gave its cache back, so these blocks are reused
+      for (ezUInt32 i = 0; i < blocks.GetCount() / 2; ++i)
+      {
+        blocks[i] = allocator.Allocate(64, 16, nullptr);
+      }
+
+      for (void* pBlock : blocks)
+      {
+        allocator.Deallocate(pBlock);
+      }
+    }
+
+    // more allocators than a thread has cache slots
+    for (ezUInt32 i = 0; i < 2 * Policy::MaxThreadCachesPerThread; ++i)
+    {
+      ezThreadCachingAllocator tempAllocator("TestThreadCachingAllocatorTemp");
+      tempAllocator.Deallocate(tempAllocator.Allocate(32, 16, nullptr));
+    }
+
+    EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations - allocator.GetStats().m_uiNumDeallocations, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MemoryTracker")
+  {
+    ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::All> allocator("TestTrackedAllocator");
+
+    const ezUInt32 uiNumThreads = 4;
+    const ezUInt32 uiBlocksPerThread = 1000;
+    ezDynamicArray<void*> blocks;
+    blocks.SetCount(uiNumThreads * uiBlocksPerThread);
+
+    {
+      ezDynamicArray<ezUniquePtr<ezAllocateOnOtherThread>> threads;
+      for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+      {
+        threads.PushBack(EZ_DEFAULT_NEW(ezAllocateOnOtherThread, &allocator, blocks.GetArrayPtr().GetSubArray(i * uiBlocksPerThread, uiBlocksPerThread)));
+        threads.PeekBack()->Start();
+      }
+
+      for (auto& pThread : threads)
+      {
+        pThread->Join();
+      }
+    }
+
+    size_t uiExpectedSize = 0;
+    for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+    {
+      const size_t uiSize = 16 + (i % uiBlocksPerThread) % 64;
+      EZ_TEST_INT(allocator.AllocatedSize(blocks[i]), uiSize);
+      uiExpectedSize += uiSize;
+    }
+
+    ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, uiNumThreads * uiBlocksPerThread);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 0);
+    EZ_TEST_INT(stats.m_uiAllocationSize, uiExpectedSize);
+
+    // deallocate on other threads than the allocating ones
+    {
+      ezDeallocateOnOtherThread otherThread(&allocator, blocks.GetArrayPtr().GetSubArray(0, blocks.GetCount() / 2));
+      otherThread.Start();
+      otherThread.Join();
+    }
+
+    for (ezUInt32 i = blocks.GetCount() / 2; i < blocks.GetCount(); ++i)
+    {
+      allocator.Deallocate(blocks[i]);
+    }
+
+    stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumDeallocations, uiNumThreads * uiBlocksPerThread);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+
+    // only every 4th allocation gets a stack trace
+    const ezUInt32 uiPrevSampleRate = ezMemoryTracker::GetStackTraceSampleRate();
+    ezMemoryTracker::SetStackTraceSampleRate(4);
+    EZ_TEST_INT(ezMemoryTracker::GetStackTraceSampleRate(), 4);
+
+    void* sampledBlocks[64];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(sampledBlocks); ++i)
+    {
+      sampledBlocks[i] = allocator.Allocate(32, 8);
+    }
+
+    ezUInt32 uiNumStackTraces = 0;
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(sampledBlocks); ++i)
+    {
+      if (ezMemoryTracker::GetAllocationInfo(allocator.GetId(), sampledBlocks[i]).GetStackTrace().GetPtr() != nullptr)
+        ++uiNumStackTraces;
+
+      allocator.Deallocate(sampledBlocks[i]);
+    }
+
+    ezMemoryTracker::SetStackTraceSampleRate(uiPrevSampleRate);
+
+    // platforms without stack trace support never record any
+    EZ_TEST_BOOL(uiNumStackTraces == EZ_ARRAY_SIZE(sampledBlocks) / 4 || uiNumStackTraces == 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FrameAllocator Thread Lanes")
+  {
+    ezFrameAllocator::Reset();
+
+    ezAllocatorBase* pAllocator = ezFrameAllocator::GetThreadAllocator();
+    EZ_TEST_BOOL(pAllocator != ezFrameAllocator::GetCurrentAllocator());
+    EZ_TEST_BOOL(pAllocator == ezFrameAllocator::GetThreadAllocator());
+
+    ezUInt8* pSmall = EZ_NEW_RAW_BUFFER(pAllocator, ezUInt8, 3);
+    ezUInt8* pLarge = EZ_NEW_RAW_BUFFER(pAllocator, ezUInt8, 1024 * 1024);
+    AlignedVector* pAligned = EZ_NEW(pAllocator, AlignedVector);
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pSmall, 16));
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pLarge, 16));
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pAligned, 16));
+    ezMemoryUtils::ZeroFill(pLarge, 1024 * 1024);
+
+    ezConstructionCounter* pCounter = EZ_NEW(pAllocator, ezConstructionCounter);
+    ezConstructionCounter* pDeletedCounter = EZ_NEW(pAllocator, ezConstructionCounter);
+    EZ_TEST_BOOL(ezConstructionCounter::HasConstructed(2));
+
+    EZ_DELETE(pAllocator, pDeletedCounter);
+    EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(1));
+
+    ezUseFrameAllocatorOnOtherThread threads[4];
+    for (auto& thread : threads)
+    {
+      thread.Start();
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Join();
+
+      // threads that already exited may give their lane to one of the later threads
+      EZ_TEST_BOOL(threads[i].m_pAllocator != pAllocator);
+    }
+
+    // lanes of exited threads are reused instead of creating new ones
+    const ezUInt32 uiNumLanes = ezFrameAllocator::GetNumThreadLanes();
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      ezUseFrameAllocatorOnOtherThread thread;
+      thread.Start();
+      thread.Join();
+
+      EZ_TEST_BOOL(thread.m_pAllocator != pAllocator);
+      EZ_TEST_INT(ezFrameAllocator::GetNumThreadLanes(), uiNumLanes);
+    }
+
+    for (auto& thread : threads)
+    {
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        EZ_TEST_INT(thread.m_pData[i], i);
+      }
+    }
+
+    ezUInt64 uiTotalUsage = 0;
+    for (ezUInt32 i = 0; i < ezFrameAllocator::GetNumThreadLanes(); ++i)
+    {
+      uiTotalUsage += ezFrameAllocator::GetThreadLaneStats(i).m_uiCurrentUsage;
+    }
+    EZ_TEST_BOOL(uiTotalUsage >= 1024 * 1024 + 4 * 1000 * sizeof(ezUInt32));
+
+    // the memory stays valid for the next frame
+    ezFrameAllocator::Swap();
+    EZ_TEST_BOOL(pCounter->m_valid);
+    EZ_TEST_BOOL(ezFrameAllocator::GetThreadAllocator() != pAllocator);
+
+    ezFrameAllocator::Swap();
+    EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(1));
+    EZ_TEST_BOOL(ezFrameAllocator::GetThreadAllocator() == pAllocator);
+
+    ezUInt64 uiPeakUsage = 0;
+    for (ezUInt32 i = 0; i < ezFrameAllocator::GetNumThreadLanes(); ++i)
+    {
+      uiPeakUsage = ezMath::Max(uiPeakUsage, ezFrameAllocator::GetThreadLaneStats(i).m_uiPeakUsage);
+    }
+    EZ_TEST_BOOL(uiPeakUsage >= 1024 * 1024);
+
+    ezFrameAllocator::Reset();
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "StackAllocator")
   {
     ezStackAllocator<> allocator("TestStackAllocator", ezFoundation::GetAlignedAllocator());
@@ -0,0 +1,89 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <FoundationTest/Performance/PerformanceTestHelpers.h>
+
+namespace
+{
+  enum
+  {
+#if EZ_ENABLED(EZ_PERFORMANCE_TEST_UNOPTIMIZED)
+    NumAllocsPerThread = 2000,
+    MaxThreads = 8,
+#else
+    NumAllocsPerThread = 500000,
+    MaxThreads = 32,
+#endif
+    NumLiveBlocks = 256,
+  };
+
+  double MeasureAllocationsPerSecond(ezUInt32 uiNumThreads, ezAllocatorBase* pAllocator)
+  {
+    const ezTime tDuration = PerformanceTestThreads::Run(uiNumThreads, [pAllocator](ezUInt32 uiThreadIndex) {
+      void* liveBlocks[NumLiveBlocks] = {};
+      ezUInt32 uiRandom = 12345 + uiThreadIndex;
+
+      // keep a window of live blocks with varying sizes, like containers and strings do
+      for (ezUInt32 i = 0; i < NumAllocsPerThread; ++i)
+      {
+        uiRandom = uiRandom * 1664525 + 1013904223;
+        const size_t uiSize = 16 + ((uiRandom >> 16) & 511);
+
+        // tracked allocators don't accept nullptr
+        void*& pBlock = liveBlocks[i % NumLiveBlocks];
+        if (pBlock != nullptr)
+          pAllocator->Deallocate(pBlock);
+        pBlock = pAllocator->Allocate(uiSize, 8);
+      }
+
+      for (void* pBlock : liveBlocks)
+      {
+        if (pBlock != nullptr)
+          pAllocator->Deallocate(pBlock);
+      }
+    });
+
+    return (double)(uiNumThreads * NumAllocsPerThread) / tDuration.GetSeconds();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Allocator)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Allocations per Second")
+  {
+    // no tracking, so only the allocation policies are compared
+    ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::None> heapAllocator("PerfHeap");
+    ezAllocator<ezMemoryPolicies::ezThreadCachingAllocation, ezMemoryTrackingFlags::None> threadCachingAllocator("PerfThreadCaching");
+
+    for (ezUInt32 uiNumThreads = 1; uiNumThreads <= MaxThreads; uiNumThreads *= 2)
+    {
+      const double fHeap = MeasureAllocationsPerSecond(uiNumThreads, &heapAllocator);
+      const double fThreadCaching = MeasureAllocationsPerSecond(uiNumThreads, &threadCachingAllocator);
+
+      ezLog::Info("[test]{0} Threads: ezHeapAllocation {1} M allocs/s, ezThreadCachingAllocation {2} M allocs/s", uiNumThreads,
+        ezArgF(fHeap / 1000000.0, 2), ezArgF(fThreadCaching / 1000000.0, 2));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tracked Allocations per Second")
+  {
+    ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator | ezMemoryTrackingFlags::EnableAllocationTracking>
+      trackedAllocator("PerfTracked");
+    ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::All> stackTracedAllocator("PerfStackTraced");
+
+    const ezUInt32 uiPrevSampleRate = ezMemoryTracker::GetStackTraceSampleRate();
+
+    for (ezUInt32 uiNumThreads = 1; uiNumThreads <= MaxThreads; uiNumThreads *= 2)
+    {
+      const double fTracked = MeasureAllocationsPerSecond(uiNumThreads, &trackedAllocator);
+
+      ezMemoryTracker::SetStackTraceSampleRate(64);
+      const double fSampled = MeasureAllocationsPerSecond(uiNumThreads, &stackTracedAllocator);
+      ezMemoryTracker::SetStackTraceSampleRate(uiPrevSampleRate);
+
+      ezLog::Info("[test]{0} Threads: tracked {1} M allocs/s, tracked with 1 in 64 stack traces {2} M allocs/s", uiNumThreads,
+        ezArgF(fTracked / 1000000.0, 2), ezArgF(fSampled / 1000000.0, 2));
+    }
+  }
+}
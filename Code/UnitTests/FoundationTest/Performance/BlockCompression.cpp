@@ -0,0 +1,89 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+#include <Texture/Image/Image.h>
+#include <FoundationTest/Performance/PerformanceTestHelpers.h>
+#include <Texture/Image/ImageConversion.h>
+
+namespace
+{
+  enum
+  {
+    // large enough to keep all worker threads busy, small enough for the high quality modes in unoptimized builds
+#if EZ_ENABLED(EZ_PERFORMANCE_TEST_UNOPTIMIZED)
+    CompressionImageSize = 64,
+#else
+    CompressionImageSize = 256,
+#endif
+  };
+
+  void MakeCompressionTestImage(ezImageFormat::Enum format, bool bWithAlpha, ezImage& out_image)
+  {
+    ezImageHeader header;
+    header.SetWidth(CompressionImageSize);
+    header.SetHeight(CompressionImageSize);
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    out_image.ResetAndAlloc(header);
+
+    for (ezUInt32 y = 0; y < CompressionImageSize; ++y)
+    {
+      ezColor* pPixel = out_image.GetPixelPointer<ezColor>(0, 0, 0, 0, y);
+      for (ezUInt32 x = 0; x < CompressionImageSize; ++x)
+      {
+        // smooth gradients with some high frequency detail, like typical textures
+        const float fx = static_cast<float>(x) / CompressionImageSize;
+        const float fy = static_cast<float>(y) / CompressionImageSize;
+        const float fDetail = ((x * 7 + y * 13) % 17) / 64.0f;
+        const float fAlpha = bWithAlpha ? ezMath::Min(1.0f, fx + fDetail) : 1.0f;
+        pPixel[x] = ezColor(fx, fy, ezMath::Min(1.0f, 1.0f - fx * fy + fDetail), fAlpha);
+      }
+    }
+
+    EZ_TEST_BOOL(out_image.Convert(format).Succeeded());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, BlockCompression)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Megapixels per Second")
+  {
+    struct Conversion
+    {
+      ezImageFormat::Enum m_SourceFormat;
+      ezImageFormat::Enum m_TargetFormat;
+      bool m_bWithAlpha; // BC1 encodes all pixels that aren't fully opaque as transparent, which would skip most of the work
+    };
+
+    const Conversion conversions[] = {
+      {ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC1_UNORM, false},
+      {ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC3_UNORM, true},
+      {ezImageFormat::R16G16B16A16_FLOAT, ezImageFormat::BC6H_UF16, false},
+      {ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC7_UNORM, true},
+    };
+
+    const double fMegaPixels = CompressionImageSize * CompressionImageSize / 1000000.0;
+
+    for (const Conversion& conversion : conversions)
+    {
+      ezImage source;
+      MakeCompressionTestImage(conversion.m_SourceFormat, conversion.m_bWithAlpha, source);
+
+      const ezBlockCompressionQuality::Enum qualities[] = {ezBlockCompressionQuality::Fast, ezBlockCompressionQuality::High};
+
+      double fResults[EZ_ARRAY_SIZE(qualities)];
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(qualities); ++i)
+      {
+        ezImage target;
+        ezTime t0 = ezTime::Now();
+        EZ_TEST_BOOL(ezImageConversion::Convert(source, target, conversion.m_TargetFormat, qualities[i]).Succeeded());
+        ezTime t1 = ezTime::Now();
+
+        fResults[i] = fMegaPixels / (t1 - t0).GetSeconds();
+      }
+
+      ezLog::Info("[test]{0}: fast {1} MP/s, high quality {2} MP/s", ezImageFormat::GetName(conversion.m_TargetFormat), ezArgF(fResults[0], 2),
+        ezArgF(fResults[1], 2));
+    }
+  }
+}
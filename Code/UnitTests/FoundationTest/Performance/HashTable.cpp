@@ -0,0 +1,124 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/SwissHashTable.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <FoundationTest/Performance/PerformanceTestHelpers.h>
+
+namespace
+{
+  enum
+  {
+#if EZ_ENABLED(EZ_PERFORMANCE_TEST_UNOPTIMIZED)
+    NumSamples = 1,
+    NumKeys = 1024 * 4,
+#else
+    NumSamples = 16,
+    NumKeys = 1024 * 256,
+#endif
+  };
+
+  template <typename Table, typename Key>
+  void MeasureHashTable(const char* szTableName, const ezDynamicArray<Key>& keys, const ezDynamicArray<Key>& missingKeys)
+  {
+    ezTime tInsert, tLookupHit, tLookupMiss, tErase;
+
+    // the results are checked, so that the compiler can't skip any of the measured work
+    ezUInt64 uiValueSum = 0;
+    ezUInt32 uiNumMissesFound = 0;
+    ezUInt32 uiNumRemoved = 0;
+
+    for (ezUInt32 n = 0; n < NumSamples; ++n)
+    {
+      Table table;
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        table.Insert(keys[i], i);
+      }
+
+      ezTime t1 = ezTime::Now();
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        uiValueSum += *table.GetValue(keys[i]);
+      }
+
+      ezTime t2 = ezTime::Now();
+      for (ezUInt32 i = 0; i < missingKeys.GetCount(); ++i)
+      {
+        uiNumMissesFound += table.Contains(missingKeys[i]) ? 1 : 0;
+      }
+
+      ezTime t3 = ezTime::Now();
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        uiNumRemoved += table.Remove(keys[i]) ? 1 : 0;
+      }
+
+      ezTime t4 = ezTime::Now();
+
+      EZ_TEST_BOOL(table.IsEmpty());
+
+      tInsert += t1 - t0;
+      tLookupHit += t2 - t1;
+      tLookupMiss += t3 - t2;
+      tErase += t4 - t3;
+    }
+
+    const ezUInt64 uiNumKeys = keys.GetCount();
+    EZ_TEST_BOOL(uiValueSum == NumSamples * (uiNumKeys * (uiNumKeys - 1) / 2));
+    EZ_TEST_INT(uiNumMissesFound, 0);
+    EZ_TEST_INT(uiNumRemoved, NumSamples * keys.GetCount());
+
+    const double fNumOps = static_cast<double>(NumSamples) * keys.GetCount();
+
+    ezLog::Info("[test]{0} Insert: {1}ns, Lookup Hit: {2}ns, Lookup Miss: {3}ns, Erase: {4}ns", szTableName,
+      ezArgF(tInsert.GetNanoseconds() / fNumOps, 2), ezArgF(tLookupHit.GetNanoseconds() / fNumOps, 2),
+      ezArgF(tLookupMiss.GetNanoseconds() / fNumOps, 2), ezArgF(tErase.GetNanoseconds() / fNumOps, 2));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashTable)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezUInt32 Keys")
+  {
+    ezDynamicArray<ezUInt32> keys;
+    ezDynamicArray<ezUInt32> missingKeys;
+    keys.Reserve(NumKeys);
+    missingKeys.Reserve(NumKeys);
+
+    for (ezUInt32 i = 0; i < NumKeys; ++i)
+    {
+      keys.PushBack(i * 2);
+      missingKeys.PushBack(i * 2 + 1);
+    }
+
+    MeasureHashTable<ezHashTable<ezUInt32, ezUInt32>>("ezHashTable<ezUInt32, ezUInt32>", keys, missingKeys);
+    MeasureHashTable<ezSwissHashTable<ezUInt32, ezUInt32>>("ezSwissHashTable<ezUInt32, ezUInt32>", keys, missingKeys);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezString Keys")
+  {
+    ezDynamicArray<ezString> keys;
+    ezDynamicArray<ezString> missingKeys;
+    keys.Reserve(NumKeys);
+    missingKeys.Reserve(NumKeys);
+
+    ezStringBuilder sTemp;
+    for (ezUInt32 i = 0; i < NumKeys; ++i)
+    {
+      sTemp.Format("Key_{0}", i);
+      keys.PushBack(sTemp);
+
+      sTemp.Format("Missing_{0}", i);
+      missingKeys.PushBack(sTemp);
+    }
+
+    MeasureHashTable<ezHashTable<ezString, ezUInt32>>("ezHashTable<ezString, ezUInt32>", keys, missingKeys);
+    MeasureHashTable<ezSwissHashTable<ezString, ezUInt32>>("ezSwissHashTable<ezString, ezUInt32>", keys, missingKeys);
+  }
+}
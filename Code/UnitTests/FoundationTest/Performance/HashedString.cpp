@@ -0,0 +1,99 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <FoundationTest/Performance/PerformanceTestHelpers.h>
+
+namespace
+{
+  enum
+  {
+#if EZ_ENABLED(EZ_PERFORMANCE_TEST_UNOPTIMIZED)
+    NumStrings = 1000,
+    NumAssignsPerThread = 100000,
+#else
+    NumStrings = 1000,
+    NumAssignsPerThread = 1000000,
+#endif
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashedString)
+{
+  ezDynamicArray<ezString> strings;
+  ezDynamicArray<ezHashedString> keepAlive;
+
+  {
+    ezStringBuilder tmp;
+    for (ezUInt32 i = 0; i < NumStrings; ++i)
+    {
+      tmp.Format("PerfHashedString_{0}", i);
+      strings.PushBack(tmp);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Add New Strings")
+  {
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < NumStrings; ++i)
+    {
+      keepAlive.ExpandAndGetRef().Assign(strings[i]);
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    ezLog::Info("[test]Add New Strings: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / NumStrings, 2));
+  }
+
+  // every assign has to find the string that was added above
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Assign Existing Strings")
+  {
+    ezHashedString hs;
+    ezUInt32 uiNumMismatches = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < NumAssignsPerThread; ++i)
+    {
+      hs.Assign(strings[i % NumStrings]);
+      uiNumMismatches += hs != keepAlive[i % NumStrings] ? 1 : 0;
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+
+    ezLog::Info("[test]Assign Existing Strings: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / NumAssignsPerThread, 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multi-threaded Throughput")
+  {
+    for (ezUInt32 uiNumThreads = 1; uiNumThreads <= 8; uiNumThreads *= 2)
+    {
+      ezAtomicInteger32 iNumMismatches;
+
+      const ezTime tDuration = PerformanceTestThreads::Run(uiNumThreads, [&strings, &keepAlive, &iNumMismatches](ezUInt32 uiThreadIndex) {
+        ezHashedString hs;
+        ezInt32 iThreadMismatches = 0;
+
+        for (ezUInt32 i = 0; i < NumAssignsPerThread; ++i)
+        {
+          const ezUInt32 uiIndex = (i + uiThreadIndex * 97) % NumStrings;
+          hs.Assign(strings[uiIndex]);
+          iThreadMismatches += hs != keepAlive[uiIndex] ? 1 : 0;
+        }
+
+        iNumMismatches.Add(iThreadMismatches);
+      });
+
+      EZ_TEST_INT(iNumMismatches, 0);
+
+      // assigns per microsecond, over all threads
+      const double fAssignsPerMicrosecond = (double)(uiNumThreads * NumAssignsPerThread) / tDuration.GetMicroseconds();
+
+      ezLog::Info("[test]Assign Existing Strings, {0} Threads: {1} per us", uiNumThreads, ezArgF(fAssignsPerMicrosecond, 2));
+    }
+  }
+}
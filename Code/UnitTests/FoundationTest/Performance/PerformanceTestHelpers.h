@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/UniquePtr.h>
+
+// Unoptimized builds run the performance tests with much smaller counts. EZ_COMPILE_FOR_DEBUG is only set for MSVC,
+// GCC and Clang tell through __OPTIMIZE__ whether they optimize.
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG) || (EZ_DISABLED(EZ_COMPILER_MSVC) && !defined(__OPTIMIZE__))
+#  define EZ_PERFORMANCE_TEST_UNOPTIMIZED EZ_ON
+#else
+#  define EZ_PERFORMANCE_TEST_UNOPTIMIZED EZ_OFF
+#endif
+
+/// \brief Runs the same function on several threads at once, for measuring how well something scales with contention.
+class PerformanceTestThreads
+{
+public:
+  typedef ezDelegate<void(ezUInt32 uiThreadIndex)> ThreadFunction;
+  typedef ezDelegate<void()> WhileRunningFunction;
+
+  /// \brief Starts uiNumThreads threads that all call func with their index and returns the time until the last one finished.
+  ///
+  /// If whileRunning is valid, it is called over and over on the calling thread until all threads have finished.
+  static ezTime Run(ezUInt32 uiNumThreads, const ThreadFunction& func, const WhileRunningFunction& whileRunning = WhileRunningFunction())
+  {
+    ezDynamicArray<ezUniquePtr<Thread>> threads;
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(Thread, i, func));
+    }
+
+    ezTime t0 = ezTime::Now();
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    if (whileRunning.IsValid())
+    {
+      bool bRunning = true;
+      while (bRunning)
+      {
+        whileRunning();
+
+        bRunning = false;
+        for (auto& pThread : threads)
+        {
+          bRunning |= pThread->GetThreadStatus() != ezThread::Finished;
+        }
+      }
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return ezTime::Now() - t0;
+  }
+
+private:
+  class Thread : public ezThread
+  {
+  public:
+    Thread(ezUInt32 uiIndex, const ThreadFunction& func)
+      : ezThread("Performance Test Thread")
+      , m_uiIndex(uiIndex)
+      , m_Func(func)
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      m_Func(m_uiIndex);
+      return 0;
+    }
+
+    ezUInt32 m_uiIndex;
+    ThreadFunction m_Func;
+  };
+};
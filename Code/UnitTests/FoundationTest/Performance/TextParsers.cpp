@@ -0,0 +1,124 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/IO/OpenDdlReader.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+#include <FoundationTest/IO/JSONTestHelpers.h>
+#include <FoundationTest/Performance/PerformanceTestHelpers.h>
+
+namespace
+{
+  enum
+  {
+#if EZ_ENABLED(EZ_PERFORMANCE_TEST_UNOPTIMIZED)
+    NumObjects = 100,
+#else
+    NumObjects = 1000 * 20,
+#endif
+  };
+
+  // similar to the documents that the editor writes
+  void MakeJSONDocument(ezStringBuilder& out_sDocument)
+  {
+    out_sDocument = "{\n  \"Objects\" :\n  [\n";
+
+    for (ezUInt32 i = 0; i < NumObjects; ++i)
+    {
+      out_sDocument.AppendFormat("    {\n      \"Guid\" : \"{ {0}-7f3c-4a2b-9e41-{1} }\",\n      \"Type\" : \"ezGameObject\",\n      \"Name\" : \"Object {2}\",\n",
+        ezArgU(i * 7919, 8, true, 16), ezArgU(i * 104729, 12, true, 16), i);
+      out_sDocument.AppendFormat("      \"Position\" : [{0}, {1}, {2}],\n      \"Rotation\" : [0, 0, 0.70710677, 0.70710677],\n", ezArgF(i * 0.25, 2),
+        ezArgF(i * -1.5, 3), ezArgF(i * 0.125, 4));
+      out_sDocument.Append("      \"Active\" : true,\n      \"Parent\" : null\n    },\n");
+    }
+
+    out_sDocument.Append("  ]\n}\n");
+  }
+
+  void MakeDDLDocument(ezStringBuilder& out_sDocument)
+  {
+    for (ezUInt32 i = 0; i < NumObjects; ++i)
+    {
+      out_sDocument.AppendFormat("o\n{\n\tUuid %%id{u4{{0},{1}}}\n\tstring %%t{\"ezGameObject\"}\n\tp\n\t{\n\t\tstring %%Name{\"Object {2}\"}\n", i * 7919,
+        i * 104729, i);
+      out_sDocument.AppendFormat("\t\tVec3 %%Position{float{{0},{1},{2}}}\n\t\tQuat %%Rotation{float{0,0,0.70710677,0.70710677}}\n", ezArgF(i * 0.25, 2),
+        ezArgF(i * -1.5, 3), ezArgF(i * 0.125, 4));
+      out_sDocument.Append("\t\tbool %Active{true}\n\t}\n}\n");
+    }
+  }
+
+  ezArrayPtr<const ezUInt8> GetBytes(const ezStringBuilder& sDocument)
+  {
+    return ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sDocument.GetData()), sDocument.GetElementCount());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, TextParsers)
+{
+  // 'single bytes' reads the stream one byte per call, which is how the parsers worked before they buffered their input
+  const char* szModes[] = {"single bytes", "stream", "in place"};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "JSON")
+  {
+    ezStringBuilder sDocument;
+    MakeJSONDocument(sDocument);
+
+    const double fMegaBytes = sDocument.GetElementCount() / (1024.0 * 1024.0);
+
+    for (ezUInt32 uiMode = 0; uiMode < EZ_ARRAY_SIZE(szModes); ++uiMode)
+    {
+      ezJSONReader reader;
+
+      ezTime t0 = ezTime::Now();
+
+      if (uiMode < 2)
+      {
+        StringStream stream(sDocument.GetData(), uiMode == 0 ? 1 : 0xFFFFFFFFFFFFFFFFllu);
+        EZ_TEST_BOOL(reader.Parse(stream).Succeeded());
+      }
+      else
+      {
+        EZ_TEST_BOOL(reader.Parse(GetBytes(sDocument)).Succeeded());
+      }
+
+      ezTime t1 = ezTime::Now();
+
+      ezVariant objects;
+      EZ_TEST_BOOL(reader.GetTopLevelObject().TryGetValue("Objects", objects) && objects.Get<ezVariantArray>().GetCount() == NumObjects);
+
+      ezLog::Info("[test]JSON {0}: {1} MB/s", szModes[uiMode], ezArgF(fMegaBytes / (t1 - t0).GetSeconds(), 2));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OpenDDL")
+  {
+    ezStringBuilder sDocument;
+    MakeDDLDocument(sDocument);
+
+    const double fMegaBytes = sDocument.GetElementCount() / (1024.0 * 1024.0);
+
+    for (ezUInt32 uiMode = 0; uiMode < EZ_ARRAY_SIZE(szModes); ++uiMode)
+    {
+      ezOpenDdlReader reader;
+
+      ezTime t0 = ezTime::Now();
+
+      if (uiMode < 2)
+      {
+        StringStream stream(sDocument.GetData(), uiMode == 0 ? 1 : 0xFFFFFFFFFFFFFFFFllu);
+        EZ_TEST_BOOL(reader.ParseDocument(stream).Succeeded());
+      }
+      else
+      {
+        EZ_TEST_BOOL(reader.ParseDocument(GetBytes(sDocument)).Succeeded());
+      }
+
+      ezTime t1 = ezTime::Now();
+
+      EZ_TEST_INT(reader.GetRootElement()->GetNumChildObjects(), NumObjects);
+
+      ezLog::Info("[test]OpenDDL {0}: {1} MB/s", szModes[uiMode], ezArgF(fMegaBytes / (t1 - t0).GetSeconds(), 2));
+    }
+  }
+}
@@ -1,6 +1,51 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <FoundationTest/Performance/PerformanceTestHelpers.h>
+
+namespace
+{
+  enum
+  {
+    NumStressThreads = 4,
+    NumSharedStrings = 512,
+    NumStressIterations = 20000,
+  };
+
+  void RunHashedStringStress(ezUInt32 uiThreadIndex, const ezDynamicArray<ezString>& sharedStrings, ezAtomicInteger32& inout_iErrors)
+  {
+    ezHashedString strings[8];
+    ezStringBuilder sUnique;
+
+    for (ezUInt32 i = 0; i < NumStressIterations; ++i)
+    {
+      const ezString& sShared = sharedStrings[(i * 7 + uiThreadIndex * 131) % NumSharedStrings];
+
+      ezHashedString& hs = strings[i % EZ_ARRAY_SIZE(strings)];
+      hs.Assign(sShared);
+
+      if (hs.GetString() != sShared)
+        inout_iErrors.Increment();
+
+      // strings that only this thread creates, those get added and removed concurrently to the lookups above
+      if (i % 16 == 0)
+      {
+        sUnique.Format("Thread{0}_Unique{1}", uiThreadIndex, i);
+
+        ezHashedString hsUnique;
+        hsUnique.Assign(sUnique);
+
+        if (hsUnique.GetString() != sUnique)
+          inout_iErrors.Increment();
+
+        ezHashedString hsCopy = hsUnique;
+        if (hsCopy != hsUnique)
+          inout_iErrors.Increment();
+      }
+    }
+  }
+} // namespace
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -201,4 +246,58 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_INT(ezHashedString::ClearUnusedStrings(), 0);
   }
 #endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multi-threaded")
+  {
+    ezDynamicArray<ezString> sharedStrings;
+
+    ezStringBuilder tmp;
+    for (ezUInt32 i = 0; i < NumSharedStrings; ++i)
+    {
+      tmp.Format("SharedHashedString_{0}", i);
+      sharedStrings.PushBack(tmp);
+    }
+
+    // keep half of the shared strings alive, the other half may get removed while the threads use them
+    ezDynamicArray<ezHashedString> keepAlive;
+    for (ezUInt32 i = 0; i < NumSharedStrings; i += 2)
+    {
+      keepAlive.ExpandAndGetRef().Assign(sharedStrings[i]);
+    }
+
+    ezAtomicInteger32 iStressErrors;
+
+    auto stress = [&sharedStrings, &iStressErrors](ezUInt32 uiThreadIndex) { RunHashedStringStress(uiThreadIndex, sharedStrings, iStressErrors); };
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    // unused strings are removed all the time, while the threads look up and add strings
+    PerformanceTestThreads::Run(NumStressThreads, stress, []() { ezHashedString::ClearUnusedStrings(); });
+#else
+    PerformanceTestThreads::Run(NumStressThreads, stress);
+#endif
+
+    EZ_TEST_INT(iStressErrors, 0);
+
+    for (ezUInt32 i = 0; i < keepAlive.GetCount(); ++i)
+    {
+      EZ_TEST_STRING(keepAlive[i].GetData(), sharedStrings[i * 2].GetData());
+
+      ezHashedString hs;
+      hs.Assign(sharedStrings[i * 2]);
+      EZ_TEST_BOOL(hs == keepAlive[i]);
+    }
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    // nothing but the kept alive strings are referenced anymore
+    keepAlive.Clear();
+    ezHashedString::ClearUnusedStrings();
+    EZ_TEST_INT(ezHashedString::ClearUnusedStrings(), 0);
+
+    ezHashedString hs;
+    hs.Assign(sharedStrings[0]);
+    EZ_TEST_STRING(hs.GetData(), sharedStrings[0].GetData());
+    hs.Clear();
+    EZ_TEST_INT(ezHashedString::ClearUnusedStrings(), 1);
+#endif
+  }
 }
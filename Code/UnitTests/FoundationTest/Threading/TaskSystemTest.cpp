@@ -66,6 +66,27 @@ private:
   }
 };
 
+class ezSpawningTestTask final : public ezTask
+{
+public:
+  ezSpawningTestTask()
+  {
+    ConfigureTask("ezSpawningTestTask", ezTaskNesting::Maybe);
+  }
+
+  ezUInt32 m_uiNumChildren = 100;
+  ezSharedPtr<ezTestTask> m_pChild;
+
+private:
+  virtual void Execute() override
+  {
+    // the child invocations end up in the local deque of this worker thread, the other workers have to steal them
+    m_pChild->SetMultiplicity(m_uiNumChildren);
+    ezTaskGroupID childGroup = ezTaskSystem::StartSingleTask(m_pChild, ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::WaitForGroup(childGroup);
+  }
+};
+
 class TaskCallbacks
 {
 public:
@@ -550,6 +571,63 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Nested Tasks / Work Stealing")
+  {
+    const ezUInt32 uiNumTasks = 16;
+    ezSharedPtr<ezSpawningTestTask> t[uiNumTasks];
+    ezTaskGroupID tg = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+    for (ezUInt32 i = 0; i < uiNumTasks; ++i)
+    {
+      t[i] = EZ_DEFAULT_NEW(ezSpawningTestTask);
+      t[i]->m_uiNumChildren = 50 + i * 10;
+      t[i]->m_pChild = EZ_DEFAULT_NEW(ezTestTask);
+      t[i]->m_pChild->m_uiIterations = 1;
+
+      ezTaskSystem::AddTaskToGroup(tg, t[i]);
+    }
+
+    ezTaskSystem::StartTaskGroup(tg);
+    ezTaskSystem::WaitForGroup(tg);
+
+    for (ezUInt32 i = 0; i < uiNumTasks; ++i)
+    {
+      EZ_TEST_BOOL(t[i]->IsTaskFinished());
+      EZ_TEST_BOOL(t[i]->m_pChild->IsTaskFinished());
+      EZ_TEST_BOOL(t[i]->m_pChild->IsMultiplicityDone());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Canceling Tasks with Multiplicity")
+  {
+    ezAtomicInteger32 iTasksFinished = 0;
+    TaskCallbacks callbacks;
+    callbacks.m_pInt = &iTasksFinished;
+
+    ezSharedPtr<ezTestTask> t = EZ_DEFAULT_NEW(ezTestTask);
+    t->ConfigureTask("Task", ezTaskNesting::Never, ezMakeDelegate(&TaskCallbacks::TaskFinished, &callbacks));
+    t->m_uiIterations = 10;
+    t->SetMultiplicity(500);
+
+    ezTaskGroupID tg = ezTaskSystem::StartSingleTask(t, ezTaskPriority::LateNextFrame);
+
+    ezTaskSystem::CancelTask(t, ezOnTaskRunning::WaitTillFinished).IgnoreResult();
+
+    EZ_TEST_BOOL(t->IsTaskFinished());
+
+    ezTaskSystem::WaitForGroup(tg);
+    EZ_TEST_BOOL(ezTaskSystem::IsTaskGroupFinished(tg));
+    EZ_TEST_INT(iTasksFinished, 1);
+
+    // the task can be reused right away, the stale queue entries from the canceled run must not execute it
+    t->SetMultiplicity(10);
+    tg = ezTaskSystem::StartSingleTask(t, ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::WaitForGroup(tg);
+
+    EZ_TEST_BOOL(t->IsTaskFinished());
+    EZ_TEST_INT(iTasksFinished, 2);
+  }
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 
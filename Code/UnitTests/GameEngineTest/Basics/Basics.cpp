@@ -1,12 +1,20 @@
 #include <GameEngineTestPCH.h>
 
 #include "Basics.h"
+#include <Core/Graphics/Geometry.h>
 #include <Foundation/Basics/Platform/Win/IncludeWindows.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/ConsoleWriter.h>
 #include <Foundation/Strings/StringConversion.h>
 #include <Foundation/System/Process.h>
+#include <GameEngine/Animation/Skeletal/AnimatedMeshComponent.h>
+#include <GameEngine/Animation/Skeletal/SimpleAnimationComponent.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
 #include <RendererCore/Components/SkyBoxComponent.h>
+#include <RendererCore/Lights/DirectionalLightComponent.h>
+#include <RendererCore/Meshes/MeshResource.h>
 #include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/Textures/TextureCubeResource.h>
 
@@ -158,6 +166,7 @@ void ezGameEngineTestBasics::SetupSubTests()
   AddSubTest("Skybox", SubTests::Skybox);
   AddSubTest("Debug Rendering", SubTests::DebugRendering);
   AddSubTest("Load Scene", SubTests::LoadScene);
+  AddSubTest("Animated Meshes", SubTests::AnimatedMeshes);
 }
 
 ezResult ezGameEngineTestBasics::InitializeSubTest(ezInt32 iIdentifier)
@@ -190,6 +199,12 @@ ezResult ezGameEngineTestBasics::InitializeSubTest(ezInt32 iIdentifier)
     return EZ_SUCCESS;
   }
 
+  if (iIdentifier == SubTests::AnimatedMeshes)
+  {
+    m_pOwnApplication->SubTestAnimatedMeshesSetup();
+    return EZ_SUCCESS;
+  }
+
   return EZ_FAILURE;
 }
 
@@ -209,6 +224,9 @@ ezTestAppRun ezGameEngineTestBasics::RunSubTest(ezInt32 iIdentifier, ezUInt32 ui
   if (iIdentifier == SubTests::LoadScene)
     return m_pOwnApplication->SubTestLoadSceneExec(m_iFrame);
 
+  if (iIdentifier == SubTests::AnimatedMeshes)
+    return m_pOwnApplication->SubTestAnimatedMeshesExec(m_iFrame);
+
   EZ_ASSERT_NOT_IMPLEMENTED;
   return ezTestAppRun::Quit;
 }
@@ -483,3 +501,159 @@ ezTestAppRun ezGameEngineTestApplication_Basics::SubTestLoadSceneExec(ezInt32 iC
 
   return ezTestAppRun::Continue;
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezGameEngineTestApplication_Basics::SubTestAnimatedMeshesSetup()
+{
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  m_pWorld->Clear();
+
+  ezHashedString sRootJoint, sTopJoint;
+  sRootJoint.Assign("Root");
+  sTopJoint.Assign("Top");
+
+  // a skeleton with two joints on top of each other
+  ezSkeletonResourceHandle hSkeleton = ezResourceManager::GetExistingResource<ezSkeletonResource>("AnimatedMeshesSkeleton");
+  if (!hSkeleton.IsValid())
+  {
+    ezSkeletonBuilder builder;
+    const ezUInt32 uiRootJoint = builder.AddJoint("Root", ezTransform::IdentityTransform());
+    builder.AddJoint("Top", ezTransform(ezVec3(0, 0, 1)), uiRootJoint);
+
+    ezSkeletonResourceDescriptor desc;
+    builder.BuildSkeleton(desc.m_Skeleton);
+
+    hSkeleton = ezResourceManager::CreateResource<ezSkeletonResource>("AnimatedMeshesSkeleton", std::move(desc), "AnimatedMeshesSkeleton");
+  }
+
+  // the top joint bends back and forth
+  ezAnimationClipResourceHandle hClip = ezResourceManager::GetExistingResource<ezAnimationClipResource>("AnimatedMeshesClip");
+  if (!hClip.IsValid())
+  {
+    ezAnimationClipResourceDescriptor desc;
+    desc.SetDuration(ezTime::Seconds(1.0));
+
+    const auto jointInfo = desc.CreateJoint(sTopJoint, 1, 3, 1);
+    desc.AllocateJointTransforms();
+
+    auto positions = desc.GetPositionKeyframes(jointInfo);
+    positions[0].m_fTimeInSec = 0.0f;
+    positions[0].m_Value.Set(0, 0, 1);
+
+    auto rotations = desc.GetRotationKeyframes(jointInfo);
+    for (ezUInt32 i = 0; i < rotations.GetCount(); ++i)
+    {
+      rotations[i].m_fTimeInSec = i * 0.5f;
+      rotations[i].m_Value.SetFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::Degree(i == 1 ? 60.0f : 0.0f));
+    }
+
+    auto scales = desc.GetScaleKeyframes(jointInfo);
+    scales[0].m_fTimeInSec = 0.0f;
+    scales[0].m_Value.Set(1.0f);
+
+    hClip = ezResourceManager::CreateResource<ezAnimationClipResource>("AnimatedMeshesClip", std::move(desc), "AnimatedMeshesClip");
+  }
+
+  // one box per joint, each vertex uses the joint of its box
+  ezMeshResourceHandle hMesh = ezResourceManager::GetExistingResource<ezMeshResource>("AnimatedMeshesMesh");
+  if (!hMesh.IsValid())
+  {
+    ezMat4 mBottom, mTop;
+    mBottom.SetTranslationMatrix(ezVec3(0, 0, 0.5f));
+    mTop.SetTranslationMatrix(ezVec3(0, 0, 1.5f));
+
+    ezGeometry geom;
+    geom.AddBox(ezVec3(0.5f, 0.5f, 1.0f), ezColor::White, mBottom, 0);
+    geom.AddBox(ezVec3(0.5f, 0.5f, 1.0f), ezColor::White, mTop, 1);
+    geom.TriangulatePolygons();
+    geom.ComputeTangents();
+
+    ezMeshResourceDescriptor desc;
+    desc.SetMaterial(0, "Materials/BaseMaterials/TestBricks.ezMaterial");
+
+    desc.MeshBufferDesc().AddCommonStreams();
+    desc.MeshBufferDesc().AddStream(ezGALVertexAttributeSemantic::BoneIndices0, ezGALResourceFormat::RGBAUShort);
+    desc.MeshBufferDesc().AddStream(ezGALVertexAttributeSemantic::BoneWeights0, ezGALResourceFormat::XYZWFloat);
+    desc.MeshBufferDesc().AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+
+    desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+    desc.ComputeBounds();
+
+    desc.m_hDefaultSkeleton = hSkeleton;
+
+    auto& rootBone = desc.m_Bones[sRootJoint];
+    rootBone.m_GlobalInverseBindPoseMatrix.SetIdentity();
+    rootBone.m_uiBoneIndex = 0;
+
+    auto& topBone = desc.m_Bones[sTopJoint];
+    topBone.m_GlobalInverseBindPoseMatrix.SetTranslationMatrix(ezVec3(0, 0, -1));
+    topBone.m_uiBoneIndex = 1;
+
+    hMesh = ezResourceManager::CreateResource<ezMeshResource>("AnimatedMeshesMesh", std::move(desc), "AnimatedMeshesMesh");
+  }
+
+  // many instances of the same animated mesh, all at a different point in the animation
+  {
+    ezInt32 dim = 5;
+
+    for (ezInt32 y = -dim; y <= dim; ++y)
+    {
+      for (ezInt32 x = 0; x <= 2 * dim; ++x)
+      {
+        ezGameObjectDesc go;
+        go.m_LocalPosition.Set(5.0f + x * 2.0f, y * 2.0f, -1.0f);
+
+        ezGameObject* pObject;
+        m_pWorld->CreateObject(go, pObject);
+
+        ezAnimatedMeshComponent* pMesh;
+        m_pWorld->GetOrCreateComponentManager<ezAnimatedMeshComponentManager>()->CreateComponent(pObject, pMesh);
+        pMesh->SetMesh(hMesh);
+
+        ezSimpleAnimationComponent* pAnimation;
+        m_pWorld->GetOrCreateComponentManager<ezSimpleAnimationComponentManager>()->CreateComponent(pObject, pAnimation);
+        pAnimation->SetAnimationClip(hClip);
+        pAnimation->m_AnimationMode = ezPropertyAnimMode::Loop;
+        pAnimation->m_fSpeed = 0.5f + ((x + y + 2 * dim) % 4) * 0.25f;
+      }
+    }
+  }
+
+  // the shadow cascades are additional views that render the same meshes
+  {
+    ezGameObjectDesc go;
+    go.m_LocalRotation.SetFromAxisAndAngle(ezVec3(0, 1, 0), ezAngle::Degree(60));
+
+    ezGameObject* pObject;
+    m_pWorld->CreateObject(go, pObject);
+
+    ezDirectionalLightComponent* pLight;
+    m_pWorld->GetOrCreateComponentManager<ezDirectionalLightComponentManager>()->CreateComponent(pObject, pLight);
+    pLight->SetCastShadows(true);
+    pLight->SetNumCascades(4);
+  }
+}
+
+ezTestAppRun ezGameEngineTestApplication_Basics::SubTestAnimatedMeshesExec(ezInt32 iCurFrame)
+{
+  {
+    auto pCamera = ezDynamicCast<ezGameState*>(GetActiveGameState())->GetMainCamera();
+    pCamera->SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 100.0f, 0.1f, 100.0f);
+    ezVec3 pos(0, 0, 2);
+    pCamera->LookAt(pos, pos + ezVec3(1, 0, -0.3f), ezVec3(0, 0, 1));
+  }
+
+  ezResourceManager::ForceNoFallbackAcquisition(3);
+
+  if (Run() == ezApplication::Execution::Quit)
+    return ezTestAppRun::Quit;
+
+  // the meshes are posed differently in every frame, so there is no reference image
+  // this runs the animation update and the extraction of all views over several frames, which must not assert or crash
+  if (iCurFrame < 10)
+    return ezTestAppRun::Continue;
+
+  return ezTestAppRun::Quit;
+}
@@ -20,6 +20,9 @@ public:
 
   void SubTestLoadSceneSetup();
   ezTestAppRun SubTestLoadSceneExec(ezInt32 iCurFrame);
+
+  void SubTestAnimatedMeshesSetup();
+  ezTestAppRun SubTestAnimatedMeshesExec(ezInt32 iCurFrame);
 };
 
 class ezGameEngineTestBasics : public ezGameEngineTest
@@ -37,6 +40,7 @@ private:
     Skybox,
     DebugRendering,
     LoadScene,
+    AnimatedMeshes,
   };
 
   virtual void SetupSubTests() override;
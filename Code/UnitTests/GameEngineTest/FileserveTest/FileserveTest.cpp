@@ -0,0 +1,270 @@
+#include <GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
+#  include <FileservePlugin/Client/FileserveClient.h>
+#  include <FileservePlugin/Fileserver/Fileserver.h>
+#  include <Foundation/Configuration/Startup.h>
+#  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/IO/FileSystem/FileSystem.h>
+#  include <Foundation/IO/OSFile.h>
+#  include <Foundation/Logging/Log.h>
+#  include <Foundation/Threading/Thread.h>
+#  include <Foundation/Threading/ThreadUtils.h>
+#  include <Foundation/Time/Time.h>
+#  include <Foundation/Utilities/CommandLineOptions.h>
+
+ezCommandLineOptionBool opt_NetworkTests("_GameEngineTest", "-networkTests", "Enables tests that open network ports, e.g. the fileserve benchmark.", false);
+
+namespace
+{
+  enum
+  {
+    NumFiles = 200,
+    ServerPort = 1043,
+  };
+
+  class FileserverTestThread : public ezThread
+  {
+  public:
+    FileserverTestThread(ezFileserver* pServer)
+      : ezThread("Fileserver Test Thread")
+      , m_pServer(pServer)
+    {
+    }
+
+    volatile bool m_bStop = false;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        if (!m_pServer->UpdateServer())
+          ezThreadUtils::YieldTimeSlice();
+      }
+
+      return 0;
+    }
+
+    ezFileserver* m_pServer = nullptr;
+  };
+
+  // mostly text-like data that compresses well, similar to scenes and materials, and some random data, similar to compressed textures
+  void MakeFileContent(ezUInt32 uiFile, ezDynamicArray<ezUInt8>& out_Content)
+  {
+    static const char* s_szWords[] = {"ezGameObject", "Position", "Rotation", "Material", "Mesh", "{ ", " }", "\n", "0.5", "1.0", "true", "false"};
+
+    ezUInt32 uiSeed = uiFile * 2654435761u + 1;
+    auto Next = [&uiSeed]() {
+      uiSeed = uiSeed * 1664525u + 1013904223u;
+      return uiSeed >> 8;
+    };
+
+    const ezUInt32 uiSize = 1024 + Next() % (127 * 1024);
+    const bool bRandom = (uiFile % 10) == 0;
+
+    out_Content.Clear();
+    out_Content.Reserve(uiSize);
+
+    while (out_Content.GetCount() < uiSize)
+    {
+      if (bRandom)
+      {
+        out_Content.PushBack(static_cast<ezUInt8>(Next()));
+        continue;
+      }
+
+      const char* szWord = s_szWords[Next() % EZ_ARRAY_SIZE(s_szWords)];
+      while (*szWord != '\0' && out_Content.GetCount() < uiSize)
+      {
+        out_Content.PushBack(static_cast<ezUInt8>(*szWord++));
+      }
+    }
+  }
+
+  void DeleteFileserveCache(const char* szRootName)
+  {
+#  if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    ezDataDirectoryType* pDataDir = ezFileSystem::FindDataDirectoryWithRoot(szRootName);
+    if (pDataDir == nullptr)
+      return;
+
+    ezStringBuilder sCacheFolder = pDataDir->GetRedirectedDataDirectoryPath().GetData();
+    sCacheFolder.Trim(nullptr, "/");
+
+    ezStringBuilder sMetaFolder = ezOSFile::GetUserDataFolder("ezFileserve/Meta");
+    sMetaFolder.AppendPath(sCacheFolder.GetFileName());
+
+    ezOSFile::DeleteFolder(sCacheFolder).IgnoreResult();
+    ezOSFile::DeleteFolder(sMetaFolder).IgnoreResult();
+#  endif
+  }
+} // namespace
+
+/// \brief Measures the throughput of a fileserve client and server that talk over the loopback device.
+///
+/// The test opens a TCP port, so it only runs when network tests are enabled with '-networkTests'.
+class ezFileserveTest : public ezTestBaseClass
+{
+public:
+  virtual const char* GetTestName() const override { return "Fileserve"; }
+
+private:
+  enum SubTest
+  {
+    Throughput,
+  };
+
+  virtual std::string IsTestAvailable() const override
+  {
+    if (!opt_NetworkTests.GetOptionValue(ezCommandLineOption::LogMode::Never))
+      return "Needs network access, enable it with '-networkTests'.";
+
+    return {};
+  }
+
+  virtual void SetupSubTests() override { AddSubTest("Throughput", SubTest::Throughput); }
+
+  virtual ezResult InitializeTest() override
+  {
+    ezStartup::StartupCoreSystems();
+    return EZ_SUCCESS;
+  }
+
+  virtual ezResult DeInitializeTest() override
+  {
+    ezStartup::ShutdownCoreSystems();
+    return EZ_SUCCESS;
+  }
+
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+};
+
+static ezFileserveTest s_FileserveTest;
+
+ezTestAppRun ezFileserveTest::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  if (ezFileserveClient::GetSingleton() != nullptr)
+  {
+    ezLog::Info("A fileserve client is already active, skipping the fileserve benchmark.");
+    return ezTestAppRun::Quit;
+  }
+
+  ezStringBuilder sServerFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sServerFolder.AppendPath("FileserveTest");
+
+  ezDynamicArray<ezString> files;
+  ezUInt64 uiTotalBytes = 0;
+
+  {
+    ezDynamicArray<ezUInt8> content;
+    ezStringBuilder sPath;
+
+    for (ezUInt32 i = 0; i < NumFiles; ++i)
+    {
+      sPath.Format("Files/File{0}.txt", i);
+      files.PushBack(sPath);
+
+      sPath.Format("{0}/Files/File{1}.txt", sServerFolder, i);
+      MakeFileContent(i, content);
+      uiTotalBytes += content.GetCount();
+
+      ezOSFile file;
+      if (!EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded()))
+        return ezTestAppRun::Quit;
+
+      EZ_TEST_BOOL(file.Write(content.GetData(), content.GetCount()).Succeeded());
+    }
+  }
+
+  // the server resolves the data directory of the client through this special directory
+  ezFileSystem::SetSpecialDirectory("fileservetest", sServerFolder);
+
+  ezFileserver server;
+  server.SetPort(ServerPort);
+  server.StartServer();
+
+  FileserverTestThread serverThread(&server);
+  serverThread.Start();
+
+  // the server switches the client off, as usually both must not run in the same process
+  ezFileserveClient::EnableFileserveClient();
+
+  const double fMegaBytes = uiTotalBytes / (1024.0 * 1024.0);
+
+  const char* szPhases[] = {"per file, empty cache", "per file, cached", "prefetch, empty cache", "prefetch, cached"};
+
+  ezStringBuilder sAddress;
+  sAddress.Format("localhost:{0}", (ezUInt32)ServerPort);
+
+  for (ezUInt32 uiPhase = 0; uiPhase < EZ_ARRAY_SIZE(szPhases); ++uiPhase)
+  {
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, szPhases[uiPhase])
+    {
+      const bool bPrefetch = uiPhase >= 2;
+      const bool bEmptyCache = (uiPhase % 2) == 0;
+
+      // a new client for each phase, so that only the cache on disk carries over
+      ezFileserveClient client;
+      client.AddServerAddressToTry(sAddress);
+
+      if (!EZ_TEST_BOOL(client.EnsureConnected(ezTime::Seconds(10)).Succeeded()))
+        break;
+
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(">fileservetest/", "FileserveTest", "fstest").Succeeded());
+
+      if (bEmptyCache)
+      {
+        DeleteFileserveCache("fstest");
+      }
+
+      ezTime t0 = ezTime::Now();
+
+      if (bPrefetch)
+      {
+        EZ_TEST_BOOL(client.PrefetchFiles(files).Succeeded());
+      }
+
+      ezDynamicArray<ezUInt8> expected, content;
+      ezStringBuilder sPath;
+
+      for (ezUInt32 i = 0; i < NumFiles; ++i)
+      {
+        MakeFileContent(i, expected);
+        content.SetCountUninitialized(expected.GetCount());
+
+        sPath.Format(":fstest/{0}", files[i]);
+
+        ezFileReader file;
+        if (!EZ_TEST_BOOL_MSG(file.Open(sPath).Succeeded(), "'%s' could not be opened", sPath.GetData()))
+          continue;
+
+        EZ_TEST_INT(file.GetFileSize(), expected.GetCount());
+        EZ_TEST_INT(file.ReadBytes(content.GetData(), content.GetCount()), expected.GetCount());
+        EZ_TEST_BOOL(content == expected);
+      }
+
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Fileserve {0}: {1} MB/s", szPhases[uiPhase], ezArgF(fMegaBytes / (t1 - t0).GetSeconds(), 2));
+
+      if (uiPhase + 1 == EZ_ARRAY_SIZE(szPhases))
+      {
+        DeleteFileserveCache("fstest");
+      }
+
+      ezFileSystem::RemoveDataDirectoryGroup("FileserveTest");
+    }
+  }
+
+  serverThread.m_bStop = true;
+  serverThread.Join();
+  server.StopServer();
+
+  ezFileSystem::SetSpecialDirectory("fileservetest", nullptr);
+
+  return ezTestAppRun::Quit;
+}
+
+#endif
@@ -0,0 +1,227 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Time/Time.h>
+#include <ProcGenPlugin/VM/ExpressionByteCode.h>
+#include <ProcGenPlugin/VM/ExpressionCompiler.h>
+#include <ProcGenPlugin/VM/ExpressionVM.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ProcGen);
+
+namespace ExpressionVMTestDetail
+{
+  using NodeType = ezExpressionAST::NodeType;
+
+  // Same operations as the ProcGen graph nodes generate them
+  static ezExpressionAST::Node* CreateRemap(ezExpressionAST& ast, ezExpressionAST::Node* pInput, float fMin, float fMax)
+  {
+    auto pValue = ast.CreateBinaryOperator(NodeType::Multiply, pInput, ast.CreateConstant(fMax - fMin));
+    return ast.CreateBinaryOperator(NodeType::Add, pValue, ast.CreateConstant(fMin));
+  }
+
+  static ezExpressionAST::Node* CreateRange(ezExpressionAST& ast, ezExpressionAST::Node* pInput, float fMin, float fMax, float fFade)
+  {
+    auto pLowerValue = ast.CreateBinaryOperator(NodeType::Subtract, pInput, ast.CreateConstant(fMin));
+    pLowerValue = ast.CreateBinaryOperator(NodeType::Divide, pLowerValue, ast.CreateConstant((fMax - fMin) * fFade));
+
+    auto pUpperValue = ast.CreateBinaryOperator(NodeType::Subtract, ast.CreateConstant(fMax), pInput);
+    pUpperValue = ast.CreateBinaryOperator(NodeType::Divide, pUpperValue, ast.CreateConstant((fMax - fMin) * fFade));
+
+    auto pValue = ast.CreateBinaryOperator(NodeType::Min, pLowerValue, pUpperValue);
+    pValue = ast.CreateBinaryOperator(NodeType::Max, ast.CreateConstant(0.0f), pValue);
+    return ast.CreateBinaryOperator(NodeType::Min, ast.CreateConstant(1.0f), pValue);
+  }
+
+  static ezExpressionAST::Node* CreateRandom(ezExpressionAST& ast, float fSeed)
+  {
+    auto pSeed = ast.CreateBinaryOperator(NodeType::Add, ast.CreateInput(ezProcGenInternal::ExpressionInputs::s_sPointIndex), ast.CreateConstant(fSeed));
+
+    auto pFunctionCall = ast.CreateFunctionCall(ezMakeHashedString("Random"));
+    pFunctionCall->m_Arguments.PushBack(pSeed);
+    return pFunctionCall;
+  }
+
+  static void CreatePlacementAST(ezExpressionAST& ast, bool bWithNoise)
+  {
+    auto pPosX = ast.CreateInput(ezProcGenInternal::ExpressionInputs::s_sPositionX);
+    auto pPosY = ast.CreateInput(ezProcGenInternal::ExpressionInputs::s_sPositionY);
+    auto pPosZ = ast.CreateInput(ezProcGenInternal::ExpressionInputs::s_sPositionZ);
+    auto pNormalZ = ast.CreateInput(ezProcGenInternal::ExpressionInputs::s_sNormalZ);
+
+    auto pHeight = CreateRange(ast, pPosZ, 2.0f, 10.0f, 0.2f);
+    auto pSlope = CreateRange(ast, ast.CreateUnaryOperator(NodeType::ACos, pNormalZ), 0.0f, 0.5f, 0.5f);
+    ezExpressionAST::Node* pDensity = ast.CreateBinaryOperator(NodeType::Multiply, pHeight, pSlope);
+
+    if (bWithNoise)
+    {
+      auto pNoise = ast.CreateFunctionCall(ezMakeHashedString("PerlinNoise"));
+      pNoise->m_Arguments.PushBack(ast.CreateBinaryOperator(NodeType::Add, ast.CreateBinaryOperator(NodeType::Divide, pPosX, ast.CreateConstant(4.0f)), ast.CreateConstant(0.5f)));
+      pNoise->m_Arguments.PushBack(ast.CreateBinaryOperator(NodeType::Divide, pPosY, ast.CreateConstant(4.0f)));
+      pNoise->m_Arguments.PushBack(ast.CreateBinaryOperator(NodeType::Divide, pPosZ, ast.CreateConstant(4.0f)));
+      pNoise->m_Arguments.PushBack(ast.CreateConstant(3.0f));
+
+      pDensity = ast.CreateBinaryOperator(NodeType::Multiply, pDensity, pNoise);
+    }
+
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezProcGenInternal::ExpressionOutputs::s_sDensity, pDensity));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezProcGenInternal::ExpressionOutputs::s_sScale, CreateRemap(ast, CreateRandom(ast, 11.0f), 0.5f, 1.5f)));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezProcGenInternal::ExpressionOutputs::s_sColorIndex, CreateRemap(ast, CreateRandom(ast, 11.0f), 0.0f, 4.0f)));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezProcGenInternal::ExpressionOutputs::s_sObjectIndex, CreateRemap(ast, CreateRandom(ast, 17.0f), 0.0f, 3.0f)));
+  }
+
+  static float EvaluateRange(float x, float fMin, float fMax, float fFade)
+  {
+    const float fLower = (x - fMin) / ((fMax - fMin) * fFade);
+    const float fUpper = (fMax - x) / ((fMax - fMin) * fFade);
+    return ezMath::Clamp(ezMath::Min(fLower, fUpper), 0.0f, 1.0f);
+  }
+
+  struct PointData
+  {
+    ezDynamicArray<float> m_PosX;
+    ezDynamicArray<float> m_PosY;
+    ezDynamicArray<float> m_PosZ;
+    ezDynamicArray<float> m_NormalZ;
+    ezDynamicArray<float> m_PointIndex;
+
+    ezDynamicArray<float> m_Density;
+    ezDynamicArray<float> m_Scale;
+    ezDynamicArray<float> m_ColorIndex;
+    ezDynamicArray<float> m_ObjectIndex;
+
+    void Init(ezUInt32 uiNumPoints)
+    {
+      for (auto pArray : {&m_PosX, &m_PosY, &m_PosZ, &m_NormalZ, &m_PointIndex, &m_Density, &m_Scale, &m_ColorIndex, &m_ObjectIndex})
+      {
+        pArray->SetCount(uiNumPoints);
+      }
+
+      for (ezUInt32 i = 0; i < uiNumPoints; ++i)
+      {
+        m_PosX[i] = (i % 1000) * 0.1f;
+        m_PosY[i] = (i / 1000) * 0.1f;
+        m_PosZ[i] = (i % 97) * 0.125f;
+        m_NormalZ[i] = 1.0f - (i % 53) / 64.0f;
+        m_PointIndex[i] = static_cast<float>(i);
+      }
+    }
+
+    ezResult Execute(ezExpressionVM& vm, const ezExpressionByteCode& byteCode)
+    {
+      ezExpression::Stream inputs[] = {
+        ezExpression::MakeStream<float>(m_PosX, 0, ezProcGenInternal::ExpressionInputs::s_sPositionX),
+        ezExpression::MakeStream<float>(m_PosY, 0, ezProcGenInternal::ExpressionInputs::s_sPositionY),
+        ezExpression::MakeStream<float>(m_PosZ, 0, ezProcGenInternal::ExpressionInputs::s_sPositionZ),
+        ezExpression::MakeStream<float>(m_NormalZ, 0, ezProcGenInternal::ExpressionInputs::s_sNormalZ),
+        ezExpression::MakeStream<float>(m_PointIndex, 0, ezProcGenInternal::ExpressionInputs::s_sPointIndex),
+      };
+
+      ezExpression::Stream outputs[] = {
+        ezExpression::MakeStream<float>(m_Density, 0, ezProcGenInternal::ExpressionOutputs::s_sDensity),
+        ezExpression::MakeStream<float>(m_Scale, 0, ezProcGenInternal::ExpressionOutputs::s_sScale),
+        ezExpression::MakeStream<float>(m_ColorIndex, 0, ezProcGenInternal::ExpressionOutputs::s_sColorIndex),
+        ezExpression::MakeStream<float>(m_ObjectIndex, 0, ezProcGenInternal::ExpressionOutputs::s_sObjectIndex),
+      };
+
+      return vm.Execute(byteCode, ezMakeArrayPtr(inputs), ezMakeArrayPtr(outputs), m_PosX.GetCount());
+    }
+  };
+} // namespace ExpressionVMTestDetail
+
+EZ_CREATE_SIMPLE_TEST(ProcGen, ExpressionVM)
+{
+  using namespace ExpressionVMTestDetail;
+
+  ezExpressionVM vm;
+  vm.RegisterDefaultFunctions();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Optimizations")
+  {
+    ezExpressionAST ast;
+    CreatePlacementAST(ast, false);
+
+    ezExpressionByteCode byteCode;
+    ezExpressionCompiler compiler;
+    EZ_TEST_BOOL(compiler.Compile(ast, byteCode).Succeeded());
+
+    ezStringBuilder sDisassembly;
+    byteCode.Disassemble(sDisassembly);
+
+    // The two Random calls with seed 11 are merged, remaps and fades become MulAdds, the fade limits a Clamp
+    ezUInt32 uiNumRandomCalls = 0;
+    for (const char* szCall = sDisassembly.FindSubString("Call Random"); szCall != nullptr; szCall = sDisassembly.FindSubString("Call Random", szCall + 1))
+    {
+      ++uiNumRandomCalls;
+    }
+
+    EZ_TEST_INT(uiNumRandomCalls, 2);
+    EZ_TEST_BOOL(sDisassembly.FindSubString("MulAdd_CRC") != nullptr);
+    EZ_TEST_BOOL(sDisassembly.FindSubString("Clamp_RCC") != nullptr);
+    EZ_TEST_BOOL(sDisassembly.FindSubString("Mov_C") == nullptr);
+    EZ_TEST_INT(byteCode.GetFunctions().GetCount(), 1);
+
+    // Odd count to test the padding of the last batch
+    PointData data;
+    data.Init(3001);
+    EZ_TEST_BOOL(data.Execute(vm, byteCode).Succeeded());
+
+    for (ezUInt32 i = 0; i < data.m_PosX.GetCount(); ++i)
+    {
+      const float fHeight = EvaluateRange(data.m_PosZ[i], 2.0f, 10.0f, 0.2f);
+      const float fSlope = EvaluateRange(ezMath::ACos(data.m_NormalZ[i]).GetRadian(), 0.0f, 0.5f, 0.5f);
+
+      EZ_TEST_FLOAT(data.m_Density[i], fHeight * fSlope, 0.001f);
+      EZ_TEST_FLOAT(data.m_ColorIndex[i], (data.m_Scale[i] - 0.5f) * 4.0f, 0.0001f);
+      EZ_TEST_BOOL(data.m_ObjectIndex[i] >= 0.0f && data.m_ObjectIndex[i] <= 3.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    // Compares against the same graph compiled without folding, subexpression elimination and fusing
+    PointData data, unoptimizedData;
+    data.Init(1024 * 1024);
+    unoptimizedData.Init(data.m_PosX.GetCount());
+
+    for (bool bWithNoise : {false, true})
+    {
+      ezExpressionAST ast, unoptimizedAst;
+      CreatePlacementAST(ast, bWithNoise);
+      CreatePlacementAST(unoptimizedAst, bWithNoise);
+
+      ezExpressionByteCode byteCode, unoptimizedByteCode;
+      ezExpressionCompiler compiler;
+      EZ_TEST_BOOL(compiler.Compile(ast, byteCode).Succeeded());
+      EZ_TEST_BOOL(compiler.Compile(unoptimizedAst, unoptimizedByteCode, false).Succeeded());
+
+      // Less than half of the instructions are left, see the "Optimizations" block for what is removed
+      EZ_TEST_INT(unoptimizedByteCode.GetNumInstructions(), bWithNoise ? 65 : 52);
+      EZ_TEST_INT(byteCode.GetNumInstructions(), bWithNoise ? 32 : 24);
+      EZ_TEST_INT(byteCode.GetNumTempRegisters(), bWithNoise ? 5 : 3);
+      EZ_TEST_BOOL(byteCode.GetNumTempRegisters() <= unoptimizedByteCode.GetNumTempRegisters());
+
+      ezTime t0 = ezTime::Now();
+      EZ_TEST_BOOL(unoptimizedData.Execute(vm, unoptimizedByteCode).Succeeded());
+      ezTime t1 = ezTime::Now();
+      EZ_TEST_BOOL(data.Execute(vm, byteCode).Succeeded());
+      ezTime t2 = ezTime::Now();
+
+      ezUInt32 uiNumMismatches = 0;
+      for (ezUInt32 i = 0; i < data.m_PosX.GetCount(); ++i)
+      {
+        const bool bEqual = ezMath::IsEqual(data.m_Density[i], unoptimizedData.m_Density[i], 0.001f) &&
+                            ezMath::IsEqual(data.m_Scale[i], unoptimizedData.m_Scale[i], 0.0001f) &&
+                            ezMath::IsEqual(data.m_ColorIndex[i], unoptimizedData.m_ColorIndex[i], 0.0001f) &&
+                            ezMath::IsEqual(data.m_ObjectIndex[i], unoptimizedData.m_ObjectIndex[i], 0.0001f);
+
+        uiNumMismatches += bEqual ? 0 : 1;
+      }
+
+      EZ_TEST_INT(uiNumMismatches, 0);
+
+      ezLog::Info("[test]Placement{0}: {1} instructions, {2} temp registers, {3} M points/s (unoptimized: {4} instructions, {5} temp registers, {6} M points/s)",
+        bWithNoise ? " with noise" : "", byteCode.GetNumInstructions(), byteCode.GetNumTempRegisters(),
+        ezArgF(data.m_PosX.GetCount() / (t2 - t1).GetSeconds() / 1000000.0, 2), unoptimizedByteCode.GetNumInstructions(),
+        unoptimizedByteCode.GetNumTempRegisters(), ezArgF(data.m_PosX.GetCount() / (t1 - t0).GetSeconds() / 1000000.0, 2));
+    }
+  }
+}
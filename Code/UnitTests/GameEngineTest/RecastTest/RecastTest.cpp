@@ -0,0 +1,384 @@
+#include <GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_RECAST_SUPPORT
+
+#  include <Core/ResourceManager/ResourceManager.h>
+#  include <Foundation/Utilities/Progress.h>
+#  include <Recast/DetourNavMeshQuery.h>
+#  include <RecastPlugin/NavMeshBuilder/NavMeshBuilder.h>
+#  include <RecastPlugin/Resources/RecastNavMeshResource.h>
+#  include <RecastPlugin/Utils/RcMath.h>
+#  include <RecastPlugin/WorldModule/RecastWorldModule.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Recast);
+
+namespace RecastTestDetail
+{
+  static void AddQuad(ezWorldGeoExtractionUtil::Geometry& geo, const ezVec3& vMin, const ezVec3& vMax)
+  {
+    const ezUInt32 uiFirstVertex = geo.m_Vertices.GetCount();
+
+    geo.m_Vertices.ExpandAndGetRef().m_vPosition.Set(vMin.x, vMin.y, vMin.z);
+    geo.m_Vertices.ExpandAndGetRef().m_vPosition.Set(vMax.x, vMin.y, vMin.z);
+    geo.m_Vertices.ExpandAndGetRef().m_vPosition.Set(vMax.x, vMax.y, vMin.z);
+    geo.m_Vertices.ExpandAndGetRef().m_vPosition.Set(vMin.x, vMax.y, vMin.z);
+
+    auto& t0 = geo.m_Triangles.ExpandAndGetRef();
+    t0.m_uiVertexIndices[0] = uiFirstVertex + 0;
+    t0.m_uiVertexIndices[1] = uiFirstVertex + 1;
+    t0.m_uiVertexIndices[2] = uiFirstVertex + 2;
+
+    auto& t1 = geo.m_Triangles.ExpandAndGetRef();
+    t1.m_uiVertexIndices[0] = uiFirstVertex + 0;
+    t1.m_uiVertexIndices[1] = uiFirstVertex + 2;
+    t1.m_uiVertexIndices[2] = uiFirstVertex + 3;
+  }
+
+  // a large floor with a pillar and a small island that cannot be reached from the floor
+  static void CreateLevelGeometry(ezWorldGeoExtractionUtil::Geometry& geo)
+  {
+    AddQuad(geo, ezVec3(-20, -20, 0), ezVec3(20, 20, 0));
+    AddQuad(geo, ezVec3(30, 2, 0), ezVec3(38, 8, 0));
+
+    auto& pillar = geo.m_BoxShapes.ExpandAndGetRef();
+    pillar.m_vPosition.Set(10, 10, 2);
+    pillar.m_qRotation.SetIdentity();
+    pillar.m_vHalfExtents.Set(1, 1, 2);
+  }
+
+  static dtPolyRef FindPoly(const dtNavMeshQuery& query, const ezVec3& vPosition)
+  {
+    ezRcPos rcPos = vPosition;
+    ezRcPos vExtents = ezVec3(0.5f, 0.5f, 1.0f);
+    ezRcPos resultPos;
+    dtQueryFilter filter;
+
+    dtPolyRef poly = 0;
+    query.findNearestPoly(rcPos, vExtents, &filter, &poly, resultPos);
+    return poly;
+  }
+
+  static bool HasSameTiles(const ezRecastNavMeshResourceDescriptor& lhs, const ezRecastNavMeshResourceDescriptor& rhs)
+  {
+    return lhs.m_DetourNavmeshTiles == rhs.m_DetourNavmeshTiles && lhs.m_vTileGridOrigin == rhs.m_vTileGridOrigin &&
+           lhs.m_uiMaxTiles == rhs.m_uiMaxTiles;
+  }
+} // namespace RecastTestDetail
+
+EZ_CREATE_SIMPLE_TEST(Recast, PathRequests)
+{
+  using namespace RecastTestDetail;
+
+  ezRecastConfig config;
+  config.m_fTileSize = 10.0f;
+
+  ezWorldGeoExtractionUtil::Geometry geo;
+  CreateLevelGeometry(geo);
+
+  ezRecastNavMeshResourceDescriptor desc;
+  ezProgress progress;
+  ezRecastNavMeshBuilder builder;
+  if (!EZ_TEST_BOOL(builder.Build(config, geo, desc, progress).Succeeded()))
+    return;
+
+  ezRecastNavMeshResourceHandle hNavMesh = ezResourceManager::CreateResource<ezRecastNavMeshResource>("RecastTest_PathRequests", std::move(desc));
+
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  ezRecastWorldModule* pModule = world.GetOrCreateModule<ezRecastWorldModule>();
+  pModule->SetNavMeshResource(hNavMesh);
+
+  // the navmesh is picked up in the first update
+  world.Update();
+
+  const dtNavMesh* pNavMesh = pModule->GetDetourNavMesh();
+  if (!EZ_TEST_BOOL(pNavMesh != nullptr))
+    return;
+
+  dtNavMeshQuery query;
+  query.init(pNavMesh, 512);
+
+  struct Request
+  {
+    dtPolyRef m_StartPoly;
+    dtPolyRef m_EndPoly;
+    ezVec3 m_vStart;
+    ezVec3 m_vEnd;
+    ezRecastPathRequestId m_Id;
+    ezDynamicArray<dtPolyRef> m_Path;
+    bool m_bPartialPath;
+  };
+
+  // many more requests than there are concurrent path searches
+  ezDynamicArray<Request> requests;
+  for (ezInt32 i = 0; i < 10; ++i)
+  {
+    for (ezInt32 j = 0; j < 10; ++j)
+    {
+      Request& request = requests.ExpandAndGetRef();
+      request.m_vStart.Set(-18.0f, -18.0f + i * 4.0f, 0.0f);
+      request.m_vEnd.Set(18.0f - j * 4.0f, 18.0f, 0.0f);
+      request.m_StartPoly = FindPoly(query, request.m_vStart);
+      request.m_EndPoly = FindPoly(query, request.m_vEnd);
+      request.m_bPartialPath = true;
+
+      EZ_TEST_BOOL(request.m_StartPoly != 0);
+      EZ_TEST_BOOL(request.m_EndPoly != 0);
+    }
+  }
+
+  auto PollRequests = [&](bool bStorePath) -> ezUInt32 {
+    ezUInt32 uiPending = 0;
+    ezDynamicArray<dtPolyRef> path;
+
+    for (Request& request : requests)
+    {
+      bool bPartialPath = true;
+      const ezRecastPathRequestState::Enum state = pModule->RetrievePathRequestResult(request.m_Id, path, bPartialPath);
+
+      if (state == ezRecastPathRequestState::Pending)
+      {
+        ++uiPending;
+        continue;
+      }
+
+      if (state == ezRecastPathRequestState::Invalid)
+        continue;
+
+      EZ_TEST_INT(state, ezRecastPathRequestState::Finished);
+      EZ_TEST_BOOL(!bPartialPath);
+
+      if (bStorePath)
+      {
+        request.m_Path = path;
+        request.m_bPartialPath = bPartialPath;
+      }
+      else
+      {
+        EZ_TEST_BOOL(path == request.m_Path);
+      }
+    }
+
+    return uiPending;
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sliced Search")
+  {
+    for (Request& request : requests)
+    {
+      request.m_Id = pModule->RequestPath(request.m_StartPoly, request.m_EndPoly, request.m_vStart, request.m_vEnd);
+    }
+
+    world.Update();
+
+    // only a limited number of searches runs at a time, the rest is queued
+    EZ_TEST_BOOL(PollRequests(true) > 0);
+
+    ezUInt32 uiFrames = 1;
+    while (PollRequests(true) > 0 && uiFrames < 100)
+    {
+      world.Update();
+      ++uiFrames;
+    }
+
+    EZ_TEST_BOOL(uiFrames < 100);
+
+    for (const Request& request : requests)
+    {
+      EZ_TEST_BOOL(!request.m_bPartialPath);
+
+      if (EZ_TEST_BOOL(!request.m_Path.IsEmpty()))
+      {
+        EZ_TEST_BOOL(request.m_Path[0] == request.m_StartPoly);
+        EZ_TEST_BOOL(request.m_Path.PeekBack() == request.m_EndPoly);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Path Cache")
+  {
+    for (Request& request : requests)
+    {
+      request.m_Id = pModule->RequestPath(request.m_StartPoly, request.m_EndPoly, request.m_vStart, request.m_vEnd);
+    }
+
+    // cached paths do not need a search slot, so all requests are answered in the same frame
+    world.Update();
+
+    EZ_TEST_INT(PollRequests(false), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Partial Path")
+  {
+    const ezVec3 vStart(0, 0, 0);
+    const ezVec3 vEnd(34, 5, 0);
+    const dtPolyRef startPoly = FindPoly(query, vStart);
+    const dtPolyRef endPoly = FindPoly(query, vEnd);
+
+    EZ_TEST_BOOL(startPoly != 0);
+    EZ_TEST_BOOL(endPoly != 0);
+
+    const ezRecastPathRequestId requestId = pModule->RequestPath(startPoly, endPoly, vStart, vEnd);
+
+    ezDynamicArray<dtPolyRef> path;
+    bool bPartialPath = false;
+    ezRecastPathRequestState::Enum state = ezRecastPathRequestState::Pending;
+
+    for (ezUInt32 uiFrames = 0; state == ezRecastPathRequestState::Pending && uiFrames < 100; ++uiFrames)
+    {
+      world.Update();
+      state = pModule->RetrievePathRequestResult(requestId, path, bPartialPath);
+    }
+
+    // the island cannot be reached, but the path leads as close to it as possible
+    EZ_TEST_INT(state, ezRecastPathRequestState::Finished);
+    EZ_TEST_BOOL(bPartialPath);
+    EZ_TEST_BOOL(!path.IsEmpty() && path[0] == startPoly && path.PeekBack() != endPoly);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cancel")
+  {
+    const ezRecastPathRequestId requestId = pModule->RequestPath(requests[0].m_StartPoly, requests[0].m_EndPoly, requests[0].m_vStart, requests[0].m_vEnd);
+    pModule->CancelPathRequest(requestId);
+
+    world.Update();
+
+    ezDynamicArray<dtPolyRef> path;
+    bool bPartialPath = false;
+    EZ_TEST_INT(pModule->RetrievePathRequestResult(requestId, path, bPartialPath), ezRecastPathRequestState::Invalid);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Recast, RebuildTiles)
+{
+  using namespace RecastTestDetail;
+
+  ezRecastConfig config;
+  config.m_fTileSize = 10.0f;
+
+  ezWorldGeoExtractionUtil::Geometry oldGeo;
+  CreateLevelGeometry(oldGeo);
+
+  // the same level with an obstacle in one corner, which is lower than the pillar, so the height of the navmesh stays the same
+  ezWorldGeoExtractionUtil::Geometry newGeo;
+  CreateLevelGeometry(newGeo);
+
+  auto& box = newGeo.m_BoxShapes.ExpandAndGetRef();
+  box.m_vPosition.Set(-15, -15, 1);
+  box.m_qRotation.SetIdentity();
+  box.m_vHalfExtents.Set(2, 2, 1);
+
+  ezProgress progress;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ComputeChangedBounds")
+  {
+    ezDynamicArray<ezBoundingBox> changedBounds;
+
+    ezRecastNavMeshBuilder::ComputeChangedBounds(oldGeo, oldGeo, changedBounds);
+    EZ_TEST_BOOL(changedBounds.IsEmpty());
+
+    ezRecastNavMeshBuilder::ComputeChangedBounds(oldGeo, newGeo, changedBounds);
+    if (EZ_TEST_BOOL(changedBounds.GetCount() == 1))
+    {
+      EZ_TEST_VEC3(changedBounds[0].m_vMin, ezVec3(-17, -17, 0), 0.001f);
+      EZ_TEST_VEC3(changedBounds[0].m_vMax, ezVec3(-13, -13, 2), 0.001f);
+    }
+
+    // removed geometry counts as well
+    ezRecastNavMeshBuilder::ComputeChangedBounds(newGeo, oldGeo, changedBounds);
+    EZ_TEST_INT(changedBounds.GetCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Changed Geometry")
+  {
+    ezRecastNavMeshResourceDescriptor expectedDesc;
+    ezRecastNavMeshBuilder expectedBuilder;
+    EZ_TEST_BOOL(expectedBuilder.Build(config, newGeo, expectedDesc, progress).Succeeded());
+
+    ezRecastNavMeshResourceDescriptor oldDesc;
+    ezRecastNavMeshBuilder builder;
+    EZ_TEST_BOOL(builder.Build(config, oldGeo, oldDesc, progress).Succeeded());
+    EZ_TEST_BOOL(!HasSameTiles(oldDesc, expectedDesc));
+
+    ezDynamicArray<ezBoundingBox> changedBounds;
+    ezRecastNavMeshBuilder::ComputeChangedBounds(oldGeo, newGeo, changedBounds);
+
+    ezRecastNavMeshResourceDescriptor desc;
+    EZ_TEST_BOOL(builder.RebuildTiles(config, newGeo, changedBounds, desc, progress).Succeeded());
+    EZ_TEST_BOOL(HasSameTiles(desc, expectedDesc));
+
+    // and back again
+    ezRecastNavMeshBuilder::ComputeChangedBounds(newGeo, oldGeo, changedBounds);
+    EZ_TEST_BOOL(builder.RebuildTiles(config, oldGeo, changedBounds, desc, progress).Succeeded());
+    EZ_TEST_BOOL(HasSameTiles(desc, oldDesc));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Taller Geometry")
+  {
+    // higher than anything before, which does not fit into the height of the existing tiles
+    ezWorldGeoExtractionUtil::Geometry tallGeo;
+    CreateLevelGeometry(tallGeo);
+
+    auto& tower = tallGeo.m_BoxShapes.ExpandAndGetRef();
+    tower.m_vPosition.Set(-15, 15, 5);
+    tower.m_qRotation.SetIdentity();
+    tower.m_vHalfExtents.Set(1, 1, 5);
+
+    ezRecastNavMeshResourceDescriptor expectedDesc;
+    ezRecastNavMeshBuilder expectedBuilder;
+    EZ_TEST_BOOL(expectedBuilder.Build(config, tallGeo, expectedDesc, progress).Succeeded());
+
+    ezRecastNavMeshResourceDescriptor desc;
+    ezRecastNavMeshBuilder builder;
+    EZ_TEST_BOOL(builder.Build(config, oldGeo, desc, progress).Succeeded());
+
+    ezDynamicArray<ezBoundingBox> changedBounds;
+    ezRecastNavMeshBuilder::ComputeChangedBounds(oldGeo, tallGeo, changedBounds);
+
+    EZ_TEST_BOOL(builder.RebuildTiles(config, tallGeo, changedBounds, desc, progress).Succeeded());
+    EZ_TEST_BOOL(HasSameTiles(desc, expectedDesc));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Changed Config")
+  {
+    ezRecastConfig otherConfig = config;
+    otherConfig.m_fAgentRadius = 1.0f;
+
+    ezRecastNavMeshResourceDescriptor expectedDesc;
+    ezRecastNavMeshBuilder expectedBuilder;
+    EZ_TEST_BOOL(expectedBuilder.Build(otherConfig, oldGeo, expectedDesc, progress).Succeeded());
+
+    ezRecastNavMeshResourceDescriptor desc;
+    ezRecastNavMeshBuilder builder;
+    EZ_TEST_BOOL(builder.Build(config, oldGeo, desc, progress).Succeeded());
+
+    // nothing changed in the geometry, but every tile depends on the config
+    EZ_TEST_BOOL(builder.RebuildTiles(otherConfig, oldGeo, ezArrayPtr<const ezBoundingBox>(), desc, progress).Succeeded());
+    EZ_TEST_BOOL(HasSameTiles(desc, expectedDesc));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Single Tile")
+  {
+    ezRecastConfig singleTileConfig = config;
+    singleTileConfig.m_fTileSize = 0.0f;
+
+    ezRecastNavMeshResourceDescriptor expectedDesc;
+    ezRecastNavMeshBuilder expectedBuilder;
+    EZ_TEST_BOOL(expectedBuilder.Build(singleTileConfig, newGeo, expectedDesc, progress).Succeeded());
+    EZ_TEST_INT(expectedDesc.m_DetourNavmeshTiles.GetCount(), 1);
+
+    ezRecastNavMeshResourceDescriptor desc;
+    ezRecastNavMeshBuilder builder;
+    EZ_TEST_BOOL(builder.Build(singleTileConfig, oldGeo, desc, progress).Succeeded());
+
+    ezDynamicArray<ezBoundingBox> changedBounds;
+    ezRecastNavMeshBuilder::ComputeChangedBounds(oldGeo, newGeo, changedBounds);
+
+    EZ_TEST_BOOL(builder.RebuildTiles(singleTileConfig, newGeo, changedBounds, desc, progress).Succeeded());
+    EZ_TEST_BOOL(HasSameTiles(desc, expectedDesc));
+  }
+}
+
+#endif
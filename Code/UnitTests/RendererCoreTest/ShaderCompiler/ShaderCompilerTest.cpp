@@ -0,0 +1,269 @@
+#include <RendererCoreTestPCH.h>
+
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Time/Timestamp.h>
+#include <RendererCore/Shader/ShaderPermutationBinary.h>
+#include <RendererCore/ShaderCompiler/ShaderCompiler.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+/// \brief Platform compiler that doesn't need any graphics API, it only records how many stage sources it was given.
+///
+/// Sources that contain COMPILE_ERROR fail to compile.
+class ezShaderCompilerTestStub : public ezShaderProgramCompiler
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezShaderCompilerTestStub, ezShaderProgramCompiler);
+
+public:
+  virtual void GetSupportedPlatforms(ezHybridArray<ezString, 4>& Platforms) override { Platforms.PushBack("STUBTEST"); }
+
+  virtual ezResult Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog) override
+  {
+    for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+    {
+      if (!inout_Data.m_StageBinary[stage].GetByteCode().IsEmpty() || ezStringUtils::IsNullOrEmpty(inout_Data.m_szShaderSource[stage]))
+        continue;
+
+      s_iNumCompiledStages.Increment();
+
+      if (ezStringUtils::FindSubString(inout_Data.m_szShaderSource[stage], "COMPILE_ERROR") != nullptr)
+      {
+        ezLog::Error(pLog, "Stage {0} contains a compile error", ezGALShaderStage::Names[stage]);
+        return EZ_FAILURE;
+      }
+
+      // any non-empty byte code marks the stage as compiled
+      inout_Data.m_StageBinary[stage].GetByteCode().PushBack(static_cast<ezUInt8>(stage));
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual bool IsThreadSafe() const override { return true; }
+
+  static ezAtomicInteger32 s_iNumCompiledStages;
+};
+
+ezAtomicInteger32 ezShaderCompilerTestStub::s_iNumCompiledStages;
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezShaderCompilerTestStub, 1, ezRTTIDefaultAllocator<ezShaderCompilerTestStub>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  void WriteShaderCompilerTestFile(const char* szFile, const char* szContent)
+  {
+    ezFileWriter file;
+    if (EZ_TEST_BOOL(file.Open(szFile).Succeeded()))
+    {
+      file.WriteBytes(szContent, ezStringUtils::GetStringElementCount(szContent)).IgnoreResult();
+    }
+  }
+
+  ezResult ReadPermutationBinary(const char* szShader, bool bVertexVariant, bool bPixelVariant, ezShaderPermutationBinary& out_Binary)
+  {
+    // same order as in the [PERMUTATIONS] section
+    ezHybridArray<ezPermutationVar, 16> permutationVars;
+    permutationVars.ExpandAndGetRef().m_sName.Assign("TEST_VERTEX_VARIANT");
+    permutationVars.PeekBack().m_sValue.Assign(bVertexVariant ? "TRUE" : "FALSE");
+    permutationVars.ExpandAndGetRef().m_sName.Assign("TEST_PIXEL_VARIANT");
+    permutationVars.PeekBack().m_sValue.Assign(bPixelVariant ? "TRUE" : "FALSE");
+
+    ezStringBuilder sPath;
+    sPath.Format(":shadercompilertest/ShaderCache/STUBTEST/ShaderCompilerTest/{0}_{1}.ezPermutation", szShader,
+      ezArgU(ezShaderHelper::CalculateHash(permutationVars), 8, true, 16, true));
+
+    ezFileReader file;
+    EZ_SUCCEED_OR_RETURN(file.Open(sPath));
+
+    bool bOldVersion = false;
+    return out_Binary.Read(file, bOldVersion);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ShaderCompiler);
+
+EZ_CREATE_SIMPLE_TEST(ShaderCompiler, Permutations)
+{
+  ezStringBuilder sOutputDir = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputDir.AppendPath("ShaderCompilerTest");
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+  // start without any cached stage binaries
+  ezOSFile::DeleteFolder(sOutputDir).IgnoreResult();
+#else
+  // the folder of a previous run cannot be deleted, so use a new one
+  sOutputDir.AppendFormat("_{0}", ezTimestamp::CurrentTimestamp().GetInt64(ezSIUnitOfTime::Microsecond));
+#endif
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutputDir).Succeeded());
+
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputDir, "ShaderCompilerTest").Succeeded());
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputDir, "ShaderCompilerTest", "shadercompilertest", ezFileSystem::AllowWrites).Succeeded());
+
+  const ezString sPrevPlatform = ezShaderManager::GetActivePlatform();
+  const ezString sPrevCacheDirectory = ezShaderManager::GetCacheDirectory();
+  const bool bPrevRuntimeCompilation = ezShaderManager::IsRuntimeCompilationEnabled();
+  ezShaderManager::Configure("STUBTEST", false, ":shadercompilertest/ShaderCache");
+
+  WriteShaderCompilerTestFile(":shadercompilertest/ShaderCompilerTest/Common.h", "#define COMMON_VALUE 42\n");
+
+  // the vertex shader only depends on one of the variables, so each of its sources is shared by two permutations
+  WriteShaderCompilerTestFile(":shadercompilertest/ShaderCompilerTest/Test.ezShader", "\
+[PLATFORMS]\n\
+ALL\n\
+\n\
+[PERMUTATIONS]\n\
+TEST_VERTEX_VARIANT\n\
+TEST_PIXEL_VARIANT\n\
+\n\
+[RENDERSTATE]\n\
+\n\
+[SHADER]\n\
+#include \"Common.h\"\n\
+\n\
+[VERTEXSHADER]\n\
+int main() { return COMMON_VALUE + TEST_VERTEX_VARIANT; }\n\
+\n\
+[PIXELSHADER]\n\
+int main() { return COMMON_VALUE + TEST_VERTEX_VARIANT + TEST_PIXEL_VARIANT; }\n\
+");
+
+  // variables that the shader does not use must not result in additional permutations
+  ezPermutationGenerator permutations;
+  for (const char* szVar : {"TEST_VERTEX_VARIANT", "TEST_PIXEL_VARIANT", "TEST_UNUSED"})
+  {
+    ezHashedString sName;
+    sName.Assign(szVar);
+
+    permutations.AddPermutation(sName, ezMakeHashedString("TRUE"));
+    permutations.AddPermutation(sName, ezMakeHashedString("FALSE"));
+  }
+
+  ezShaderCompiler compiler;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deduplication")
+  {
+    ezShaderCompilerTestStub::s_iNumCompiledStages = 0;
+
+    EZ_TEST_BOOL(compiler.CompileShaderPermutationsForPlatforms("ShaderCompilerTest/Test.ezShader", permutations, ezLog::GetThreadLocalLogSystem(), "STUBTEST").Succeeded());
+
+    const ezShaderCompiler::Stats& stats = compiler.GetStats();
+    EZ_TEST_INT(stats.m_uiNumPermutations, 4);
+    EZ_TEST_INT(stats.m_uiNumStageSources, 8);
+    EZ_TEST_INT(stats.m_uiNumCompiledStages, 6);
+    EZ_TEST_INT(ezShaderCompilerTestStub::s_iNumCompiledStages, 6);
+
+    ezShaderPermutationBinary binaries[2][2];
+    for (ezUInt32 uiVertex = 0; uiVertex < 2; ++uiVertex)
+    {
+      for (ezUInt32 uiPixel = 0; uiPixel < 2; ++uiPixel)
+      {
+        if (!EZ_TEST_BOOL(ReadPermutationBinary("Test", uiVertex == 1, uiPixel == 1, binaries[uiVertex][uiPixel]).Succeeded()))
+          return;
+
+        EZ_TEST_BOOL(binaries[uiVertex][uiPixel].m_uiShaderStageHashes[ezGALShaderStage::VertexShader] != 0);
+        EZ_TEST_BOOL(binaries[uiVertex][uiPixel].m_uiShaderStageHashes[ezGALShaderStage::PixelShader] != 0);
+
+        // the include is recorded for every permutation, even though it was only read from disk once
+        const auto& dependencies = binaries[uiVertex][uiPixel].m_DependencyFile.GetFileDependencies();
+        EZ_TEST_BOOL(dependencies.Contains("ShaderCompilerTest/Common.h"));
+      }
+    }
+
+    for (ezUInt32 uiVertex = 0; uiVertex < 2; ++uiVertex)
+    {
+      EZ_TEST_INT(binaries[uiVertex][0].m_uiShaderStageHashes[ezGALShaderStage::VertexShader], binaries[uiVertex][1].m_uiShaderStageHashes[ezGALShaderStage::VertexShader]);
+    }
+
+    EZ_TEST_BOOL(binaries[0][0].m_uiShaderStageHashes[ezGALShaderStage::VertexShader] != binaries[1][0].m_uiShaderStageHashes[ezGALShaderStage::VertexShader]);
+    EZ_TEST_BOOL(binaries[0][1].m_uiShaderStageHashes[ezGALShaderStage::PixelShader] != binaries[1][1].m_uiShaderStageHashes[ezGALShaderStage::PixelShader]);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cached stage binaries")
+  {
+    ezShaderCompilerTestStub::s_iNumCompiledStages = 0;
+
+    EZ_TEST_BOOL(compiler.CompileShaderPermutationsForPlatforms("ShaderCompilerTest/Test.ezShader", permutations, ezLog::GetThreadLocalLogSystem(), "STUBTEST").Succeeded());
+
+    EZ_TEST_INT(compiler.GetStats().m_uiNumStageSources, 8);
+    EZ_TEST_INT(compiler.GetStats().m_uiNumCompiledStages, 0);
+    EZ_TEST_INT(ezShaderCompilerTestStub::s_iNumCompiledStages, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Single permutation")
+  {
+    ezHybridArray<ezPermutationVar, 16> permutationVars;
+    permutationVars.ExpandAndGetRef().m_sName.Assign("TEST_PIXEL_VARIANT");
+    permutationVars.PeekBack().m_sValue.Assign("TRUE");
+    permutationVars.ExpandAndGetRef().m_sName.Assign("TEST_VERTEX_VARIANT");
+    permutationVars.PeekBack().m_sValue.Assign("FALSE");
+
+    EZ_TEST_BOOL(compiler.CompileShaderPermutationForPlatforms("ShaderCompilerTest/Test.ezShader", permutationVars, ezLog::GetThreadLocalLogSystem(), "STUBTEST").Succeeded());
+
+    EZ_TEST_INT(compiler.GetStats().m_uiNumPermutations, 1);
+    EZ_TEST_INT(compiler.GetStats().m_uiNumStageSources, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Failing stage")
+  {
+    // one pixel shader variant fails, the vertex shaders it shares with the other permutations compile fine
+    WriteShaderCompilerTestFile(":shadercompilertest/ShaderCompilerTest/Failing.ezShader", "\
+[PLATFORMS]\n\
+ALL\n\
+\n\
+[PERMUTATIONS]\n\
+TEST_VERTEX_VARIANT\n\
+TEST_PIXEL_VARIANT\n\
+\n\
+[RENDERSTATE]\n\
+\n\
+[VERTEXSHADER]\n\
+int main() { return TEST_VERTEX_VARIANT; }\n\
+\n\
+[PIXELSHADER]\n\
+#if TEST_PIXEL_VARIANT\n\
+COMPILE_ERROR\n\
+#endif\n\
+int main() { return TEST_VERTEX_VARIANT; }\n\
+");
+
+    ezShaderCompilerTestStub::s_iNumCompiledStages = 0;
+
+    // the errors of the compile jobs are forwarded to the log that was passed in, once per broken stage source
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("contains a compile error", ezLogMsgType::ErrorMsg, 2);
+
+    EZ_TEST_BOOL(compiler.CompileShaderPermutationsForPlatforms("ShaderCompilerTest/Failing.ezShader", permutations, ezLog::GetThreadLocalLogSystem(), "STUBTEST").Failed());
+
+    EZ_TEST_INT(compiler.GetStats().m_uiNumPermutations, 4);
+    EZ_TEST_INT(compiler.GetStats().m_uiNumCompiledStages, 6);
+    EZ_TEST_INT(ezShaderCompilerTestStub::s_iNumCompiledStages, 6);
+
+    ezStringBuilder sStageFile;
+    for (ezUInt32 uiVertex = 0; uiVertex < 2; ++uiVertex)
+    {
+      ezShaderPermutationBinary binary;
+      EZ_TEST_BOOL(ReadPermutationBinary("Failing", uiVertex == 1, true, binary).Failed());
+
+      // the permutations without the broken pixel shader are written, even if their vertex shader is shared with a failed one
+      if (!EZ_TEST_BOOL(ReadPermutationBinary("Failing", uiVertex == 1, false, binary).Succeeded()))
+        continue;
+
+      sStageFile.Format(":shadercompilertest/ShaderCache/STUBTEST/{0}_{1}.ezShaderStage", ezGALShaderStage::Names[ezGALShaderStage::VertexShader],
+        ezArgU(binary.m_uiShaderStageHashes[ezGALShaderStage::VertexShader], 8, true, 16, true));
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(sStageFile));
+    }
+  }
+
+  ezShaderManager::Configure(sPrevPlatform.GetData(), bPrevRuntimeCompilation, sPrevCacheDirectory.GetData());
+  ezFileSystem::RemoveDataDirectoryGroup("ShaderCompilerTest");
+}